@@ -1,6 +1,7 @@
 // Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
 #define NOGDI
 
+#include <algorithm>
 #include <iostream>
 
 #include <App/Miami/Client/Context.hpp>
@@ -10,6 +11,60 @@
 
 namespace Miami::App::Client
 {
+namespace
+{
+std::string ValueToString (const Richard::AnyDataContainer &value)
+{
+    std::string result;
+    switch (value.GetType ())
+    {
+        case Richard::DataType::INT8:
+            result += std::to_string (*reinterpret_cast <const int8_t *> (value.GetDataStartPointer ()));
+            break;
+
+        case Richard::DataType::INT16:
+            result += std::to_string (*reinterpret_cast <const int16_t *> (value.GetDataStartPointer ()));
+            break;
+
+        case Richard::DataType::INT32:
+            result += std::to_string (*reinterpret_cast <const int32_t *> (value.GetDataStartPointer ()));
+            break;
+
+        case Richard::DataType::INT64:
+            result += std::to_string (*reinterpret_cast <const int64_t *> (value.GetDataStartPointer ()));
+            break;
+
+        case Richard::DataType::SHORT_STRING:
+        case Richard::DataType::STRING:
+        case Richard::DataType::LONG_STRING:
+        case Richard::DataType::HUGE_STRING:
+        case Richard::DataType::BLOB_16KB:
+        {
+            const char *valuePointer = reinterpret_cast <const char *> (value.GetDataStartPointer ());
+            const char *end = valuePointer + Richard::GetDataTypeSize (value.GetType ());
+
+            while (valuePointer != end && *valuePointer)
+            {
+                result += *valuePointer;
+                ++valuePointer;
+            }
+
+            break;
+        }
+
+        case Richard::DataType::VARCHAR:
+        case Richard::DataType::VARBINARY:
+        {
+            const char *valuePointer = reinterpret_cast <const char *> (value.GetDataStartPointer ());
+            result.append (valuePointer, value.GetDataSize ());
+            break;
+        }
+    }
+
+    return result;
+}
+}
+
 Context::Context ()
     : multithreadingContext_ (1), // We don't really need Disco, so minimum worker thread count specified.
       socketClient_ (&multithreadingContext_),
@@ -130,7 +185,10 @@ void Context::RegisterMessages ()
                     AddDelayedOutput (
                         "Received response to query " + std::to_string (message.queryId_) +
                         ". Column name is " + message.name_ + ", data type is " +
-                        Richard::GetDataTypeName (message.dataType_) + "\n");
+                        Richard::GetDataTypeName (message.dataType_) + ", max value size is " +
+                        std::to_string (message.maxSize_) +
+                        (message.dictionaryEncoded_ ? ", dictionary encoded" : "") +
+                        (message.compressed_ ? ", compressed" : "") + "\n");
                 });
         });
 
@@ -143,13 +201,24 @@ void Context::RegisterMessages ()
                 [this] (const Messaging::IndexInfoResponse &message, Hotline::SocketSession *session)
                 {
                     std::string output = "Received response to query " + std::to_string (message.queryId_) +
-                                         ". Index name is " + message.name_ + ", base columns are:\n";
+                                         ". Index name is " + message.name_ + ", type is " +
+                                         Richard::GetIndexTypeName (message.type_) +
+                                         (message.unique_ ? ", unique" : "") + ", base columns are:\n";
 
                     for (Messaging::ResourceId id : message.columns_)
                     {
                         output += " - " + std::to_string (id) + "\n";
                     }
 
+                    if (!message.includedColumns_.empty ())
+                    {
+                        output += "Included columns are:\n";
+                        for (Messaging::ResourceId id : message.includedColumns_)
+                        {
+                            output += " - " + std::to_string (id) + "\n";
+                        }
+                    }
+
                     AddDelayedOutput (output);
                 });
         });
@@ -166,54 +235,168 @@ void Context::RegisterMessages ()
                                          ". Value type is " + Richard::GetDataTypeName (message.value_.GetType ()) +
                                          ", value is \"";
 
-                    switch (message.value_.GetType ())
+                    output += ValueToString (message.value_);
+                    output += "\".\n";
+                    AddDelayedOutput (output);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketClient_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::AGGREGATE_RESPONSE),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::AggregateResponse::CreateParserWithCallback (
+                [this] (const Messaging::AggregateResponse &message, Hotline::SocketSession */*session*/)
+                {
+                    std::string output = "Received response to query " + std::to_string (message.queryId_) +
+                                         ". Groups count is " + std::to_string (message.groupsCount_) + ".\n";
+
+                    const std::size_t aggregatesCount =
+                        message.groupsCount_ > 0u ? message.results_.size () / message.groupsCount_ : 0u;
+
+                    for (uint64_t groupIndex = 0; groupIndex < message.groupsCount_; ++groupIndex)
                     {
-                        case Richard::DataType::INT8:
-                            output += std::to_string (*reinterpret_cast <const int8_t *> (
-                                message.value_.GetDataStartPointer ()));
-                            break;
-
-                        case Richard::DataType::INT16:
-                            output += std::to_string (*reinterpret_cast <const int16_t *> (
-                                message.value_.GetDataStartPointer ()));
-                            break;
-
-                        case Richard::DataType::INT32:
-                            output += std::to_string (*reinterpret_cast <const int32_t *> (
-                                message.value_.GetDataStartPointer ()));
-                            break;
-
-                        case Richard::DataType::INT64:
-                            output += std::to_string (*reinterpret_cast <const int64_t *> (
-                                message.value_.GetDataStartPointer ()));
-                            break;
-
-                        case Richard::DataType::SHORT_STRING:
-                        case Richard::DataType::STRING:
-                        case Richard::DataType::LONG_STRING:
-                        case Richard::DataType::HUGE_STRING:
-                        case Richard::DataType::BLOB_16KB:
+                        output += " - Group " + std::to_string (groupIndex) + ", key is:";
+                        for (std::size_t columnIndex = 0; columnIndex < message.groupColumns_.size (); ++columnIndex)
+                        {
+                            const uint64_t keyIndex = groupIndex * message.groupColumns_.size () + columnIndex;
+                            output += " " + std::to_string (message.groupColumns_[columnIndex]) + "=";
+
+                            auto iterator = std::find_if (
+                                message.keys_.begin (), message.keys_.end (),
+                                [keyIndex] (const auto &indexValuePair)
+                                {
+                                    return indexValuePair.first == keyIndex;
+                                });
+
+                            output += iterator == message.keys_.end () ? "null" : ValueToString (iterator->second);
+                        }
+
+                        output += "\n";
+                        for (std::size_t index = 0; index < aggregatesCount; ++index)
                         {
-                            const char *valuePointer = reinterpret_cast <const char *> (
-                                message.value_.GetDataStartPointer ());
-                            const char *end = valuePointer + Richard::GetDataTypeSize (message.value_.GetType ());
+                            const Messaging::AggregateResultValue &value =
+                                message.results_[groupIndex * aggregatesCount + index];
+
+                            output += "   - Aggregate " + std::to_string (index) + ": value " +
+                                      std::to_string (value.value_) + ", count " + std::to_string (value.count_) +
+                                      ".\n";
+                        }
+                    }
+
+                    AddDelayedOutput (output);
+                });
+        });
 
-                            while (valuePointer != end && *valuePointer)
+    assert (result == Hotline::ResultCode::OK);
+    result = socketClient_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::GET_TABLE_STATISTICS_RESPONSE),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::TableStatisticsResponse::CreateParserWithCallback (
+                [this] (const Messaging::TableStatisticsResponse &message, Hotline::SocketSession */*session*/)
+                {
+                    std::string output = "Received response to query " + std::to_string (message.queryId_) +
+                                         ". Rows count is " + std::to_string (message.rowCount_) +
+                                         ", changes since refresh count is " +
+                                         std::to_string (message.changesSinceRefresh_) + ".\n";
+
+                    for (std::size_t index = 0; index < message.columns_.size (); ++index)
+                    {
+                        const Messaging::ColumnStatisticsHeader &column = message.columns_[index];
+                        output += " - Column " + std::to_string (column.columnId_) + ": nulls count " +
+                                  std::to_string (column.nullCount_) + ", distinct values count " +
+                                  std::to_string (column.distinctCount_) + ", histogram depth " +
+                                  std::to_string (column.histogramDepth_) + ".\n   - Limits:";
+
+                        for (const auto &indexValuePair : message.limits_)
+                        {
+                            if (indexValuePair.first / 2u == index)
                             {
-                                output += *valuePointer;
-                                ++valuePointer;
+                                output += " " + ValueToString (indexValuePair.second);
                             }
+                        }
 
-                            break;
+                        output += "\n   - Histogram bounds:";
+                        for (const auto &indexValuePair : message.histogramBounds_)
+                        {
+                            if (indexValuePair.first == index)
+                            {
+                                output += " " + ValueToString (indexValuePair.second);
+                            }
                         }
+
+                        output += "\n";
                     }
 
-                    output += "\".\n";
                     AddDelayedOutput (output);
                 });
         });
 
     assert (result == Hotline::ResultCode::OK);
+    result = socketClient_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::QUERY_RESULT_RESPONSE),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::QueryResultResponse::CreateParserWithCallback (
+                [this] (const Messaging::QueryResultResponse &message, Hotline::SocketSession */*session*/)
+                {
+                    if (message.isLast_)
+                    {
+                        AddDelayedOutput ("Query " + std::to_string (message.queryId_) + " is finished.\n");
+                        return;
+                    }
+
+                    std::string output = "Received output of query " + std::to_string (message.queryId_) +
+                                         ". Rows count is " + std::to_string (message.rowsCount_) + ".\n";
+
+                    auto iterator = message.values_.begin ();
+                    for (uint64_t rowIndex = 0; rowIndex < message.rowsCount_; ++rowIndex)
+                    {
+                        output += " -";
+                        for (uint64_t columnIndex = 0; columnIndex < message.columnsCount_; ++columnIndex)
+                        {
+                            // Values are sent in order of their indices, so they could be matched in one pass.
+                            if (iterator != message.values_.end () &&
+                                iterator->first == rowIndex * message.columnsCount_ + columnIndex)
+                            {
+                                output += " " + ValueToString (iterator->second);
+                                ++iterator;
+                            }
+                            else
+                            {
+                                output += " null";
+                            }
+                        }
+
+                        output += "\n";
+                    }
+
+                    AddDelayedOutput (output);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketClient_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::REPLICATION_STATUS_RESPONSE),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ReplicationStatusResponse::CreateParserWithCallback (
+                [this] (const Messaging::ReplicationStatusResponse &message, Hotline::SocketSession */*session*/)
+                {
+                    AddDelayedOutput (
+                        "Received response to query " + std::to_string (message.queryId_) + ". Server is " +
+                        (message.isReplica_ ? "replica" : "primary") +
+                        (message.resyncNeeded_ ? ", that needs resync from new backup" : "") + ", last sequence is " +
+                        std::to_string (message.lastSequence_) + ", applied sequence is " +
+                        std::to_string (message.appliedSequence_) + ", lag is " +
+                        std::to_string (message.lagMutations_) + " mutations and " +
+                        std::to_string (message.lagMilliseconds_) + " ms.\n");
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
 }
 
 void Context::AddDelayedOutput (const std::string &element)
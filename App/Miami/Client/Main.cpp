@@ -167,7 +167,7 @@ void PrintMessageIndices ()
     std::cout << "Supported messages:" << std::endl;
     auto message = static_cast <Miami::App::Messaging::Message> (0u);
 
-    while (message <= Miami::App::Messaging::Message::REMOVE_TABLE_REQUEST)
+    while (message <= Miami::App::Messaging::Message::CLOSE_TABLE_EDIT_ACCESS_REQUEST)
     {
         std::cout << "  " << static_cast<uint64_t> (message) << ". " <<
                   Miami::App::Messaging::GetMessageName (message) << std::endl;
@@ -200,12 +200,8 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
     };
 
     // TODO: Temporary adhok implementation.
-    auto inputTableUpdateValue = [inputDataType] ()
+    auto inputValue = [inputDataType] ()
     {
-        Miami::App::Messaging::ResourceId columnId;
-        std::cout << "Input column id: ";
-        std::cin >> columnId;
-
         std::cout << "Input data type index: ";
         Miami::Richard::DataType dataType = inputDataType ();
         Miami::Richard::AnyDataContainer container (dataType);
@@ -257,9 +253,27 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
                         std::min (static_cast<uint32_t>(value.size ()), Miami::Richard::GetDataTypeSize (dataType)));
             }
                 break;
+
+            case Miami::Richard::DataType::VARCHAR:
+            case Miami::Richard::DataType::VARBINARY:
+            {
+                std::string value;
+                std::cin >> value;
+                container.ResizeData (static_cast<uint32_t>(value.size ()));
+                memcpy (container.GetDataStartPointer (), &value[0], value.size ());
+            }
+                break;
         }
 
-        return std::make_pair (columnId, Miami::Richard::AnyDataContainer (std::move (container)));
+        return container;
+    };
+
+    auto inputTableUpdateValue = [inputValue] ()
+    {
+        Miami::App::Messaging::ResourceId columnId;
+        std::cout << "Input column id: ";
+        std::cin >> columnId;
+        return std::make_pair (columnId, inputValue ());
     };
 
     switch (messageType)
@@ -268,9 +282,12 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
         case Miami::App::Messaging::Message::GET_TABLE_WRITE_ACCESS_REQUEST:
         case Miami::App::Messaging::Message::CLOSE_TABLE_READ_ACCESS_REQUEST:
         case Miami::App::Messaging::Message::CLOSE_TABLE_WRITE_ACCESS_REQUEST:
+        case Miami::App::Messaging::Message::GET_TABLE_EDIT_ACCESS_REQUEST:
+        case Miami::App::Messaging::Message::CLOSE_TABLE_EDIT_ACCESS_REQUEST:
         case Miami::App::Messaging::Message::GET_TABLE_NAME_REQUEST:
         case Miami::App::Messaging::Message::GET_COLUMNS_IDS_REQUEST:
         case Miami::App::Messaging::Message::GET_INDICES_IDS_REQUEST:
+        case Miami::App::Messaging::Message::GET_TABLE_STATISTICS_REQUEST:
         {
             Miami::App::Messaging::TableOperationRequest request {};
 
@@ -288,6 +305,7 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
         case Miami::App::Messaging::Message::CREATE_EDIT_CURSOR_REQUEST:
         case Miami::App::Messaging::Message::REMOVE_COLUMN_REQUEST:
         case Miami::App::Messaging::Message::REMOVE_INDEX_REQUEST:
+        case Miami::App::Messaging::Message::CREATE_SNAPSHOT_CURSOR_REQUEST:
         {
             Miami::App::Messaging::TablePartOperationRequest request {};
 
@@ -331,6 +349,23 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
             std::cout << "Input column data type index: ";
             request.dataType_ = inputDataType ();
 
+            if (Miami::Richard::IsVariableSizeDataType (request.dataType_))
+            {
+                std::cout << "Input column max value size (0 for default): ";
+                std::cin >> request.maxSize_;
+            }
+
+            if (Miami::Richard::IsIntegerDataType (request.dataType_))
+            {
+                std::cout << "Is column compressed (0 or 1): ";
+                std::cin >> request.compressed_;
+            }
+            else
+            {
+                std::cout << "Is column dictionary encoded (0 or 1): ";
+                std::cin >> request.dictionaryEncoded_;
+            }
+
             request.Write (messageType, session);
             return true;
         }
@@ -345,6 +380,14 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
             std::cout << "Input index name: ";
             std::cin >> request.name_;
 
+            uint64_t rawType = 0;
+            std::cout << "Input index type index (0 - ordered, 1 - hash): ";
+            std::cin >> rawType;
+            request.type_ = static_cast <Miami::Richard::IndexType> (rawType);
+
+            std::cout << "Is index unique (0 or 1): ";
+            std::cin >> request.unique_;
+
             uint64_t baseColumnsCount;
             std::cout << "Input base columns count: ";
             std::cin >> baseColumnsCount;
@@ -357,6 +400,18 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
                 request.columns_.emplace_back (columnId);
             }
 
+            uint64_t includedColumnsCount;
+            std::cout << "Input included columns count (only for ordered indices): ";
+            std::cin >> includedColumnsCount;
+
+            while (includedColumnsCount--)
+            {
+                Miami::App::Messaging::ResourceId columnId;
+                std::cout << "Input column id: ";
+                std::cin >> columnId;
+                request.includedColumns_.emplace_back (columnId);
+            }
+
             request.Write (messageType, session);
             return true;
         }
@@ -380,6 +435,111 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
             request.Write (messageType, session);
             return true;
         }
+        case Miami::App::Messaging::Message::ADD_ROWS_REQUEST:
+        {
+            Miami::App::Messaging::AddRowsRequest request {};
+
+            request.queryId_ = nextQueryId;
+            std::cout << "Input table id: ";
+            std::cin >> request.tableId_;
+
+            uint64_t columnsCount;
+            std::cout << "Input columns count: ";
+            std::cin >> columnsCount;
+            request.columns_.resize (columnsCount);
+
+            for (std::size_t index = 0; index < columnsCount; ++index)
+            {
+                std::cout << "Input column id: ";
+                std::cin >> request.columns_[index];
+            }
+
+            std::cout << "Input rows count: ";
+            std::cin >> request.rowsCount_;
+
+            for (uint64_t index = 0; index < request.rowsCount_ * columnsCount; ++index)
+            {
+                char isNull;
+                std::cout << "Is value " << index % columnsCount << " of row " << index / columnsCount <<
+                          " null (y/n)? ";
+                std::cin >> isNull;
+
+                if (isNull != 'y')
+                {
+                    request.values_.emplace_back (index, inputValue ());
+                }
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
+        case Miami::App::Messaging::Message::CREATE_LOOKUP_READ_CURSOR_REQUEST:
+        case Miami::App::Messaging::Message::CREATE_LOOKUP_EDIT_CURSOR_REQUEST:
+        {
+            Miami::App::Messaging::CreateLookupCursorRequest request {};
+
+            request.queryId_ = nextQueryId;
+            std::cout << "Input table id: ";
+            std::cin >> request.tableId_;
+
+            std::cout << "Input index id: ";
+            std::cin >> request.indexId_;
+
+            uint64_t valuesCount;
+            std::cout << "Input key values count: ";
+            std::cin >> valuesCount;
+
+            while (valuesCount--)
+            {
+                request.values_.emplace_back (inputTableUpdateValue ());
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
+        case Miami::App::Messaging::Message::CREATE_FILTERED_READ_CURSOR_REQUEST:
+        case Miami::App::Messaging::Message::CREATE_FILTERED_EDIT_CURSOR_REQUEST:
+        {
+            Miami::App::Messaging::CreateFilteredCursorRequest request {};
+
+            request.queryId_ = nextQueryId;
+            std::cout << "Input table id: ";
+            std::cin >> request.tableId_;
+
+            std::cout << "Input index id: ";
+            std::cin >> request.indexId_;
+
+            uint64_t nodesCount;
+            std::cout << "Input predicate nodes count (nodes are read in postfix order): ";
+            std::cin >> nodesCount;
+
+            for (uint64_t nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex)
+            {
+                uint64_t rawOperation = ~0;
+                std::cout << "Input operation index (0-5 comparisons, 6-7 null checks, 8 AND, 9 OR, 10 NOT): ";
+                std::cin >> rawOperation;
+
+                Miami::App::Messaging::PredicateNodeHeader header {
+                    static_cast <Miami::Richard::PredicateOperation> (rawOperation), 0u};
+
+                if (header.operation_ <= Miami::Richard::PredicateOperation::GREATER_OR_EQUAL)
+                {
+                    auto value = inputTableUpdateValue ();
+                    header.columnId_ = value.first;
+                    request.values_.emplace_back (nodeIndex, std::move (value.second));
+                }
+                else if (header.operation_ <= Miami::Richard::PredicateOperation::IS_NOT_NULL)
+                {
+                    std::cout << "Input column id: ";
+                    std::cin >> header.columnId_;
+                }
+
+                request.nodes_.emplace_back (header);
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
         case Miami::App::Messaging::Message::CURSOR_ADVANCE_REQUEST:
         {
             Miami::App::Messaging::CursorAdvanceRequest request {};
@@ -496,6 +656,17 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
             request.Write (messageType, session);
             return true;
         }
+        case Miami::App::Messaging::Message::BACKUP_REQUEST:
+        {
+            Miami::App::Messaging::BackupRequest request {};
+            request.queryId_ = nextQueryId;
+
+            std::cout << "Input backup file path on server: ";
+            std::cin >> request.path_;
+
+            request.Write (messageType, session);
+            return true;
+        }
         case Miami::App::Messaging::Message::REMOVE_TABLE_REQUEST:
         {
             Miami::App::Messaging::TableOperationRequest request {};
@@ -507,6 +678,321 @@ bool InputAndSendRequest (uint64_t nextQueryId, Miami::Hotline::SocketSession *s
             request.Write (messageType, session);
             return true;
         }
+        case Miami::App::Messaging::Message::BEGIN_TRANSACTION_REQUEST:
+        {
+            Miami::App::Messaging::BeginTransactionRequest request {};
+            request.queryId_ = nextQueryId;
+
+            std::size_t tablesCount;
+            std::cout << "Input tables count: ";
+            std::cin >> tablesCount;
+
+            request.tables_.resize (tablesCount);
+            for (std::size_t index = 0; index < tablesCount; ++index)
+            {
+                std::cout << "Input table id: ";
+                std::cin >> request.tables_[index];
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
+        case Miami::App::Messaging::Message::COMMIT_TRANSACTION_REQUEST:
+        case Miami::App::Messaging::Message::ROLLBACK_TRANSACTION_REQUEST:
+        case Miami::App::Messaging::Message::REPLICATION_STATUS_REQUEST:
+        {
+            Miami::App::Messaging::ConduitVoidActionRequest request {};
+            request.queryId_ = nextQueryId;
+            request.Write (messageType, session);
+            return true;
+        }
+        case Miami::App::Messaging::Message::AGGREGATE_REQUEST:
+        {
+            Miami::App::Messaging::AggregateRequest request {};
+
+            request.queryId_ = nextQueryId;
+            std::cout << "Input table id: ";
+            std::cin >> request.tableId_;
+
+            uint64_t groupColumnsCount;
+            std::cout << "Input group columns count: ";
+            std::cin >> groupColumnsCount;
+
+            request.groupColumns_.resize (groupColumnsCount);
+            for (std::size_t index = 0; index < groupColumnsCount; ++index)
+            {
+                std::cout << "Input group column id: ";
+                std::cin >> request.groupColumns_[index];
+            }
+
+            uint64_t aggregatesCount;
+            std::cout << "Input aggregates count: ";
+            std::cin >> aggregatesCount;
+
+            while (aggregatesCount--)
+            {
+                uint64_t rawFunction = ~0;
+                std::cout << "Input function index (0 count rows, 1 count, 2 sum, 3 min, 4 max, 5 avg): ";
+                std::cin >> rawFunction;
+
+                Miami::App::Messaging::AggregateHeader header {
+                    static_cast <Miami::Richard::AggregateFunction> (rawFunction), 0u};
+
+                if (header.function_ != Miami::Richard::AggregateFunction::COUNT_ROWS)
+                {
+                    std::cout << "Input column id: ";
+                    std::cin >> header.columnId_;
+                }
+
+                request.aggregates_.emplace_back (header);
+            }
+
+            uint64_t useRange = 0u;
+            std::cout << "Input 1 to limit aggregation to ordered index range or 0 to aggregate all rows: ";
+            std::cin >> useRange;
+
+            if (useRange)
+            {
+                std::cout << "Input index id: ";
+                std::cin >> request.indexId_;
+
+                // Bound without values is treated as absent bound.
+                uint64_t valuesCount;
+                std::cout << "Input inclusive lower bound values count: ";
+                std::cin >> valuesCount;
+                request.hasLowerBound_ = valuesCount > 0u;
+
+                while (valuesCount--)
+                {
+                    request.lowerBound_.emplace_back (inputTableUpdateValue ());
+                }
+
+                std::cout << "Input exclusive upper bound values count: ";
+                std::cin >> valuesCount;
+                request.hasUpperBound_ = valuesCount > 0u;
+
+                while (valuesCount--)
+                {
+                    request.upperBound_.emplace_back (inputTableUpdateValue ());
+                }
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
+        case Miami::App::Messaging::Message::EXECUTE_QUERY_REQUEST:
+        {
+            Miami::App::Messaging::ExecuteQueryRequest request {};
+
+            request.queryId_ = nextQueryId;
+            std::cout << "Input table id: ";
+            std::cin >> request.tableId_;
+
+            uint64_t count;
+            std::cout << "Input aggregates count, 0 to select projection: ";
+            std::cin >> count;
+
+            if (count > 0u)
+            {
+                while (count--)
+                {
+                    uint64_t rawFunction = ~0;
+                    std::cout << "Input function index (0 count rows, 1 count, 2 sum, 3 min, 4 max, 5 avg): ";
+                    std::cin >> rawFunction;
+
+                    Miami::App::Messaging::AggregateHeader header {
+                        static_cast <Miami::Richard::AggregateFunction> (rawFunction), 0u};
+
+                    if (header.function_ != Miami::Richard::AggregateFunction::COUNT_ROWS)
+                    {
+                        std::cout << "Input column id: ";
+                        std::cin >> header.columnId_;
+                    }
+
+                    request.aggregates_.emplace_back (header);
+                }
+
+                std::cout << "Input group columns count: ";
+                std::cin >> count;
+                request.groupColumns_.resize (count);
+
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    std::cout << "Input group column id: ";
+                    std::cin >> request.groupColumns_[index];
+                }
+            }
+            else
+            {
+                std::cout << "Input projection columns count: ";
+                std::cin >> count;
+                request.projection_.resize (count);
+
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    std::cout << "Input projection column id: ";
+                    std::cin >> request.projection_[index];
+                }
+            }
+
+            std::cout << "Input predicate nodes count (nodes are read in postfix order): ";
+            std::cin >> count;
+
+            for (uint64_t nodeIndex = 0; nodeIndex < count; ++nodeIndex)
+            {
+                uint64_t rawOperation = ~0;
+                std::cout << "Input operation index (0-5 comparisons, 6-7 null checks, 8 AND, 9 OR, 10 NOT): ";
+                std::cin >> rawOperation;
+
+                Miami::App::Messaging::PredicateNodeHeader header {
+                    static_cast <Miami::Richard::PredicateOperation> (rawOperation), 0u};
+
+                if (header.operation_ <= Miami::Richard::PredicateOperation::GREATER_OR_EQUAL)
+                {
+                    auto value = inputTableUpdateValue ();
+                    header.columnId_ = value.first;
+                    request.values_.emplace_back (nodeIndex, std::move (value.second));
+                }
+                else if (header.operation_ <= Miami::Richard::PredicateOperation::IS_NOT_NULL)
+                {
+                    std::cout << "Input column id: ";
+                    std::cin >> header.columnId_;
+                }
+
+                request.nodes_.emplace_back (header);
+            }
+
+            std::cout << "Input sort keys count: ";
+            std::cin >> count;
+
+            while (count--)
+            {
+                Miami::App::Messaging::QueryOrderHeader header {};
+                std::cout << "Input output column index: ";
+                std::cin >> header.outputColumn_;
+
+                std::cout << "Input 1 to sort in descending order or 0 to sort in ascending order: ";
+                std::cin >> header.descending_;
+                request.order_.emplace_back (header);
+            }
+
+            std::cout << "Input offset: ";
+            std::cin >> request.offset_;
+
+            std::cout << "Input limit: ";
+            std::cin >> request.limit_;
+
+            uint64_t useRange = 0u;
+            std::cout << "Input 1 to select ordered index range or 0 to select all rows: ";
+            std::cin >> useRange;
+
+            if (useRange)
+            {
+                std::cout << "Input index id: ";
+                std::cin >> request.indexId_;
+
+                // Bound without values is treated as absent bound.
+                uint64_t valuesCount;
+                std::cout << "Input inclusive lower bound values count: ";
+                std::cin >> valuesCount;
+                request.hasLowerBound_ = valuesCount > 0u;
+
+                while (valuesCount--)
+                {
+                    request.lowerBound_.emplace_back (inputTableUpdateValue ());
+                }
+
+                std::cout << "Input exclusive upper bound values count: ";
+                std::cin >> valuesCount;
+                request.hasUpperBound_ = valuesCount > 0u;
+
+                while (valuesCount--)
+                {
+                    request.upperBound_.emplace_back (inputTableUpdateValue ());
+                }
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
+        case Miami::App::Messaging::Message::JOIN_REQUEST:
+        {
+            Miami::App::Messaging::JoinRequest request {};
+            request.queryId_ = nextQueryId;
+
+            std::cout << "Input left table id: ";
+            std::cin >> request.leftTableId_;
+
+            std::cout << "Input right table id: ";
+            std::cin >> request.rightTableId_;
+
+            std::cout << "Input limit: ";
+            std::cin >> request.limit_;
+
+            // Both inputs are described the same way, so they are read by one loop.
+            for (const char *side : {"left", "right"})
+            {
+                const bool isLeft = side[0] == 'l';
+                std::vector <Miami::App::Messaging::ResourceId> &keyColumns =
+                    isLeft ? request.leftKeyColumns_ : request.rightKeyColumns_;
+                std::vector <Miami::App::Messaging::ResourceId> &projection =
+                    isLeft ? request.leftProjection_ : request.rightProjection_;
+                std::vector <Miami::App::Messaging::PredicateNodeHeader> &nodes =
+                    isLeft ? request.leftNodes_ : request.rightNodes_;
+                auto &values = isLeft ? request.leftValues_ : request.rightValues_;
+
+                uint64_t count;
+                std::cout << "Input " << side << " key columns count: ";
+                std::cin >> count;
+                keyColumns.resize (count);
+
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    std::cout << "Input " << side << " key column id: ";
+                    std::cin >> keyColumns[index];
+                }
+
+                std::cout << "Input " << side << " projection columns count: ";
+                std::cin >> count;
+                projection.resize (count);
+
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    std::cout << "Input " << side << " projection column id: ";
+                    std::cin >> projection[index];
+                }
+
+                std::cout << "Input " << side << " predicate nodes count (nodes are read in postfix order): ";
+                std::cin >> count;
+
+                for (uint64_t nodeIndex = 0; nodeIndex < count; ++nodeIndex)
+                {
+                    uint64_t rawOperation = ~0;
+                    std::cout << "Input operation index (0-5 comparisons, 6-7 null checks, 8 AND, 9 OR, 10 NOT): ";
+                    std::cin >> rawOperation;
+
+                    Miami::App::Messaging::PredicateNodeHeader header {
+                        static_cast <Miami::Richard::PredicateOperation> (rawOperation), 0u};
+
+                    if (header.operation_ <= Miami::Richard::PredicateOperation::GREATER_OR_EQUAL)
+                    {
+                        auto value = inputTableUpdateValue ();
+                        header.columnId_ = value.first;
+                        values.emplace_back (nodeIndex, std::move (value.second));
+                    }
+                    else if (header.operation_ <= Miami::Richard::PredicateOperation::IS_NOT_NULL)
+                    {
+                        std::cout << "Input column id: ";
+                        std::cin >> header.columnId_;
+                    }
+
+                    nodes.emplace_back (header);
+                }
+            }
+
+            request.Write (messageType, session);
+            return true;
+        }
 
         default:
             std::cout << "Given message type is not a request type!" << std::endl;
@@ -0,0 +1,365 @@
+// Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
+#define NOGDI
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
+
+#include <App/Miami/Loader/Context.hpp>
+#include <App/Miami/Messaging/Message.hpp>
+#include <App/Miami/Sharding/Connection.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Richard/Conduit.hpp>
+
+namespace Miami::App::Loader
+{
+namespace
+{
+using Sharding::Connection;
+using Sharding::Response;
+
+std::shared_ptr <Disco::SafeLockGuard> CaptureGuard (const Disco::AnyLockPointer &lock)
+{
+    std::promise <std::shared_ptr <Disco::SafeLockGuard>> captured;
+    Disco::After (
+        lock,
+        [&captured] (std::shared_ptr <Disco::SafeLockGuard> guard)
+        {
+            captured.set_value (guard);
+        });
+
+    return captured.get_future ().get ();
+}
+
+/// Lock groups require at least two locks, so single lock is captured on its own.
+std::vector <std::shared_ptr <Disco::SafeLockGuard>> CaptureGuards (const std::vector <Disco::AnyLockPointer> &locks)
+{
+    if (locks.size () < 2u)
+    {
+        return locks.empty () ? std::vector <std::shared_ptr <Disco::SafeLockGuard>> () :
+               std::vector <std::shared_ptr <Disco::SafeLockGuard>> {CaptureGuard (locks[0])};
+    }
+
+    std::promise <std::vector <std::shared_ptr <Disco::SafeLockGuard>>> captured;
+    Disco::After (
+        locks,
+        [&captured] (std::vector <std::shared_ptr <Disco::SafeLockGuard>> guards)
+        {
+            captured.set_value (guards);
+        });
+
+    return captured.get_future ().get ();
+}
+
+std::vector <Richard::DataType> GetColumnTypes (const LoadTask &task)
+{
+    std::vector <Richard::DataType> types;
+    for (const Richard::ColumnInfo &column : task.columns_)
+    {
+        types.emplace_back (column.dataType_);
+    }
+
+    return types;
+}
+
+/// Index columns are validated by command line parser, so they are always found.
+std::vector <Richard::AnyDataId> ResolveIndexColumns (const LoadTask &task, const IndexDescription &index,
+                                                      const std::vector <Richard::AnyDataId> &columnIds)
+{
+    std::vector <Richard::AnyDataId> ids;
+    for (const std::string &name : index.columns_)
+    {
+        auto iterator = std::find_if (task.columns_.begin (), task.columns_.end (),
+                                      [&name] (const Richard::ColumnInfo &column)
+                                      {
+                                          return column.name_ == name;
+                                      });
+
+        assert (iterator != task.columns_.end ());
+        ids.emplace_back (columnIds[iterator - task.columns_.begin ()]);
+    }
+
+    return ids;
+}
+
+double SecondsSince (std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration <double> (std::chrono::steady_clock::now () - start).count ();
+}
+}
+
+Context::Context (uint32_t workerThreads)
+    : multithreadingContext_ (workerThreads)
+{
+    Evan::Logger::Get ().Log (
+        Evan::LogLevel::INFO,
+        "Loader context initialized with " + std::to_string (workerThreads) + " worker threads.");
+}
+
+ResultCode Context::LoadToServer (const std::string &host, const std::string &service, const LoadTask &task)
+{
+    Connection connection (&multithreadingContext_);
+    if (!connection.Connect (host, service))
+    {
+        return ResultCode::UNABLE_TO_CONNECT;
+    }
+
+    Messaging::ConduitVoidActionRequest conduitRequest {};
+    Messaging::AddTableRequest addTableRequest {};
+    addTableRequest.tableName_ = task.tableName_;
+    Messaging::TableOperationRequest tableRequest {};
+
+    // Conduit write access is needed only to add table, so it is replaced by read access right after.
+    if (!connection.Execute (Messaging::Message::GET_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest,
+                             "get conduit write access") ||
+        !connection.Execute (Messaging::Message::ADD_TABLE_REQUEST, addTableRequest, "add table",
+                             &tableRequest.tableId_) ||
+        !connection.Execute (Messaging::Message::CLOSE_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest,
+                             "close conduit write access") ||
+        !connection.Execute (Messaging::Message::GET_CONDUIT_READ_ACCESS_REQUEST, conduitRequest,
+                             "get conduit read access") ||
+        !connection.Execute (Messaging::Message::GET_TABLE_WRITE_ACCESS_REQUEST, tableRequest,
+                             "get table write access"))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    std::vector <Richard::AnyDataId> columnIds (task.columns_.size ());
+    for (std::size_t index = 0u; index < task.columns_.size (); ++index)
+    {
+        const Richard::ColumnInfo &column = task.columns_[index];
+        Messaging::AddColumnRequest request {};
+        request.tableId_ = tableRequest.tableId_;
+        request.dataType_ = column.dataType_;
+        request.maxSize_ = column.maxSize_;
+        request.dictionaryEncoded_ = column.dictionaryEncoded_;
+        request.compressed_ = column.compressed_;
+        request.name_ = column.name_;
+
+        if (!connection.Execute (Messaging::Message::ADD_COLUMN_REQUEST, request,
+                                 "add column \"" + column.name_ + "\"", &columnIds[index]))
+        {
+            return ResultCode::SERVER_REJECTED_REQUEST;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now ();
+    std::deque <std::future <Response>> inFlight;
+    uint64_t rowsCount = 0u;
+    bool rejected = false;
+
+    const bool read = ReadInput (
+        task.format_, task.inputPath_, GetColumnTypes (task), &multithreadingContext_,
+        [&] (Richard::QueryBatch &batch)
+        {
+            for (std::size_t firstRow = 0u; firstRow < batch.GetRowsCount () && !rejected;
+                 firstRow += ROWS_PER_REQUEST)
+            {
+                Messaging::AddRowsRequest request {};
+                request.tableId_ = tableRequest.tableId_;
+                request.rowsCount_ = std::min (ROWS_PER_REQUEST, batch.GetRowsCount () - firstRow);
+                request.columns_ = columnIds;
+
+                const std::size_t firstValue = firstRow * batch.columnsCount_;
+                for (std::size_t index = 0u; index < request.rowsCount_ * batch.columnsCount_; ++index)
+                {
+                    if (!batch.nulls_[firstValue + index])
+                    {
+                        request.values_.emplace_back (index, std::move (batch.values_[firstValue + index]));
+                    }
+                }
+
+                if (inFlight.size () == REQUESTS_IN_FLIGHT)
+                {
+                    rejected = !Connection::Wait (inFlight.front (), "add rows");
+                    inFlight.pop_front ();
+                }
+
+                inFlight.emplace_back (connection.Send (Messaging::Message::ADD_ROWS_REQUEST, request));
+                rowsCount += request.rowsCount_;
+            }
+
+            return !rejected;
+        });
+
+    while (!inFlight.empty ())
+    {
+        rejected |= !Connection::Wait (inFlight.front (), "add rows");
+        inFlight.pop_front ();
+    }
+
+    if (rejected)
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    if (!read)
+    {
+        return ResultCode::UNABLE_TO_READ_INPUT;
+    }
+
+    ReportLoaded (rowsCount, SecondsSince (start));
+    const auto indicesStart = std::chrono::steady_clock::now ();
+
+    for (const IndexDescription &index : task.indices_)
+    {
+        Messaging::AddIndexRequest request {};
+        request.tableId_ = tableRequest.tableId_;
+        request.type_ = index.type_;
+        request.unique_ = index.unique_;
+        request.name_ = index.name_;
+        request.columns_ = ResolveIndexColumns (task, index, columnIds);
+
+        if (!connection.Execute (Messaging::Message::ADD_INDEX_REQUEST, request,
+                                 "add index \"" + index.name_ + "\""))
+        {
+            return ResultCode::SERVER_REJECTED_REQUEST;
+        }
+    }
+
+    Evan::Logger::Get ().Log (
+        Evan::LogLevel::INFO, "Built " + std::to_string (task.indices_.size ()) + " indices in " +
+                              std::to_string (SecondsSince (indicesStart)) + " seconds.");
+
+    if (!connection.Execute (Messaging::Message::CLOSE_TABLE_WRITE_ACCESS_REQUEST, tableRequest,
+                             "close table write access") ||
+        !connection.Execute (Messaging::Message::CLOSE_CONDUIT_READ_ACCESS_REQUEST, conduitRequest,
+                             "close conduit read access"))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode Context::LoadToBackup (const std::string &path, const LoadTask &task)
+{
+    Richard::Conduit conduit (&multithreadingContext_);
+    auto conduitGuard = CaptureGuard (Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Write ()));
+
+    Richard::AnyDataId tableId;
+    Richard::Table *table = nullptr;
+    Richard::ResultCode result = conduit.AddTable (conduitGuard, task.tableName_, tableId);
+
+    if (result == Richard::ResultCode::OK)
+    {
+        result = conduit.GetTable (conduitGuard, tableId, table);
+    }
+
+    if (result != Richard::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Unable to add table, caught Richard error " +
+                                   std::to_string (static_cast <uint32_t> (result)) + "!");
+        return ResultCode::DATABASE_ERROR;
+    }
+
+    {
+        auto tableGuard = CaptureGuard (Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        std::vector <Richard::AnyDataId> columnIds (task.columns_.size ());
+
+        for (std::size_t index = 0u; index < task.columns_.size () && result == Richard::ResultCode::OK; ++index)
+        {
+            result = table->AddColumn (tableGuard, task.columns_[index], columnIds[index]);
+        }
+
+        const auto start = std::chrono::steady_clock::now ();
+        uint64_t rowsCount = 0u;
+
+        const bool read = result == Richard::ResultCode::OK && ReadInput (
+            task.format_, task.inputPath_, GetColumnTypes (task), &multithreadingContext_,
+            [&] (Richard::QueryBatch &batch)
+            {
+                for (std::size_t row = 0u; row < batch.GetRowsCount () && result == Richard::ResultCode::OK; ++row)
+                {
+                    Richard::Table::Row values;
+                    for (std::size_t column = 0u; column < batch.columnsCount_; ++column)
+                    {
+                        const std::size_t index = row * batch.columnsCount_ + column;
+                        if (!batch.nulls_[index])
+                        {
+                            values.emplace (columnIds[column], std::move (batch.values_[index]));
+                        }
+                    }
+
+                    result = table->InsertRow (tableGuard, values);
+                    ++rowsCount;
+                }
+
+                return result == Richard::ResultCode::OK;
+            });
+
+        if (result == Richard::ResultCode::OK && !read)
+        {
+            return ResultCode::UNABLE_TO_READ_INPUT;
+        }
+
+        if (result == Richard::ResultCode::OK)
+        {
+            ReportLoaded (rowsCount, SecondsSince (start));
+        }
+
+        const auto indicesStart = std::chrono::steady_clock::now ();
+        for (std::size_t index = 0u; index < task.indices_.size () && result == Richard::ResultCode::OK; ++index)
+        {
+            const IndexDescription &description = task.indices_[index];
+            Richard::AnyDataId indexId;
+
+            result = table->AddIndex (
+                tableGuard, {0u, description.name_, ResolveIndexColumns (task, description, columnIds),
+                             description.type_, description.unique_}, indexId);
+        }
+
+        if (result == Richard::ResultCode::OK)
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::INFO, "Built " + std::to_string (task.indices_.size ()) + " indices in " +
+                                      std::to_string (SecondsSince (indicesStart)) + " seconds.");
+        }
+    }
+
+    std::vector <Richard::AnyDataId> tableIds;
+    std::vector <Disco::AnyLockPointer> locks;
+    Richard::ConduitBackup *rawBackup = nullptr;
+
+    if (result == Richard::ResultCode::OK)
+    {
+        result = conduit.PrepareBackup (conduitGuard, tableIds, locks);
+    }
+
+    if (result == Richard::ResultCode::OK)
+    {
+        result = conduit.BeginBackup (conduitGuard, tableIds, CaptureGuards (locks), rawBackup);
+    }
+
+    if (result == Richard::ResultCode::OK)
+    {
+        std::unique_ptr <Richard::ConduitBackup> backup (rawBackup);
+        result = backup->WriteToFile (path, &multithreadingContext_);
+    }
+
+    if (result != Richard::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Unable to load table into backup, caught Richard error " +
+                                   std::to_string (static_cast <uint32_t> (result)) + "!");
+        return ResultCode::DATABASE_ERROR;
+    }
+
+    Evan::Logger::Get ().Log (Evan::LogLevel::INFO, "Written backup \"" + path + "\".");
+    return ResultCode::OK;
+}
+
+void Context::ReportLoaded (uint64_t rowsCount, double seconds) const
+{
+    Evan::Logger::Get ().Log (
+        Evan::LogLevel::INFO, "Loaded " + std::to_string (rowsCount) + " rows in " + std::to_string (seconds) +
+                              " seconds (" + std::to_string (seconds > 0.0 ? rowsCount / seconds : 0.0) +
+                              " rows/s).");
+}
+}
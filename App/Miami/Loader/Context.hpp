@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Index.hpp>
+
+#include <App/Miami/Loader/Input.hpp>
+
+namespace Miami::App::Loader
+{
+enum class ResultCode
+{
+    OK = 0,
+    UNABLE_TO_CONNECT,
+    UNABLE_TO_READ_INPUT,
+    SERVER_REJECTED_REQUEST,
+    DATABASE_ERROR,
+};
+
+/// Index, that is added after all rows are loaded. Columns are referenced by names.
+struct IndexDescription
+{
+    std::string name_;
+    Richard::IndexType type_;
+    bool unique_;
+    std::vector <std::string> columns_;
+};
+
+/// New table with given columns is created, filled with rows from input file and then indexed.
+/// Input fields are mapped to columns by position.
+struct LoadTask
+{
+    InputFormat format_;
+    std::string inputPath_;
+    std::string tableName_;
+    std::vector <Richard::ColumnInfo> columns_;
+    std::vector <IndexDescription> indices_;
+};
+
+class Context final
+{
+public:
+    /// Sent ADD_ROWS_REQUEST contains at most this count of rows.
+    static constexpr std::size_t ROWS_PER_REQUEST = 1024u;
+
+    /// Count of ADD_ROWS_REQUEST messages, that could be sent before responses to previous ones are received.
+    static constexpr std::size_t REQUESTS_IN_FLIGHT = 16u;
+
+    explicit Context (uint32_t workerThreads);
+
+    /// Loads table to running server. Input is parsed while previous batches are inserted by server.
+    free_call ResultCode LoadToServer (const std::string &host, const std::string &service, const LoadTask &task);
+
+    /// Loads table into local conduit and writes it as backup file, that could be restored by server on start.
+    free_call ResultCode LoadToBackup (const std::string &path, const LoadTask &task);
+
+private:
+    void ReportLoaded (uint64_t rowsCount, double seconds) const;
+
+    Disco::Context multithreadingContext_;
+};
+}
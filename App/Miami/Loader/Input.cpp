@@ -0,0 +1,514 @@
+// Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
+#define NOGDI
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include <App/Miami/Loader/Input.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Evan/Logger.hpp>
+
+namespace Miami::App::Loader
+{
+namespace
+{
+using FileHandle = std::unique_ptr <FILE, decltype (&std::fclose)>;
+
+/// Output of one parsing task. Error is empty if chunk is parsed successfully.
+struct ParsedChunk
+{
+    Richard::QueryBatch batch_;
+    std::size_t linesCount_ = 0u;
+    std::size_t errorLine_ = 0u;
+    std::string error_;
+};
+
+std::size_t GetWaveSize (Disco::Context *workers)
+{
+    return workers ? workers->GetWorkersCount () + 1u : 1u;
+}
+
+template <typename Integer>
+bool ParseInteger (const char *begin, const char *end, Richard::AnyDataContainer &output)
+{
+    Integer value;
+    std::from_chars_result result = std::from_chars (begin, end, value);
+
+    if (result.ec != std::errc () || result.ptr != end)
+    {
+        return false;
+    }
+
+    *static_cast <Integer *> (output.GetDataStartPointer ()) = value;
+    return true;
+}
+
+bool ParseTextValue (Richard::DataType dataType, const char *begin, const char *end,
+                     Richard::AnyDataContainer &output, std::string &error)
+{
+    output = Richard::AnyDataContainer (dataType);
+    const auto size = static_cast <std::size_t> (end - begin);
+
+    switch (dataType)
+    {
+        case Richard::DataType::INT8:
+        case Richard::DataType::INT16:
+        case Richard::DataType::INT32:
+        case Richard::DataType::INT64:
+        {
+            const bool parsed =
+                dataType == Richard::DataType::INT8 ? ParseInteger <int8_t> (begin, end, output) :
+                dataType == Richard::DataType::INT16 ? ParseInteger <int16_t> (begin, end, output) :
+                dataType == Richard::DataType::INT32 ? ParseInteger <int32_t> (begin, end, output) :
+                ParseInteger <int64_t> (begin, end, output);
+
+            if (!parsed)
+            {
+                error = "\"" + std::string (begin, end) + "\" is not a valid " +
+                        Richard::GetDataTypeName (dataType) + " value";
+            }
+
+            return parsed;
+        }
+
+        case Richard::DataType::SHORT_STRING:
+        case Richard::DataType::STRING:
+        case Richard::DataType::LONG_STRING:
+        case Richard::DataType::HUGE_STRING:
+        case Richard::DataType::BLOB_16KB:
+            if (size > Richard::GetDataTypeSize (dataType))
+            {
+                error = "value of size " + std::to_string (size) + " does not fit into " +
+                        Richard::GetDataTypeName (dataType);
+                return false;
+            }
+
+            std::memcpy (output.GetDataStartPointer (), begin, size);
+            return true;
+
+        case Richard::DataType::VARCHAR:
+        case Richard::DataType::VARBINARY:
+            if (size > Richard::MAX_VARIABLE_DATA_SIZE)
+            {
+                error = "value of size " + std::to_string (size) + " exceeds variable size limit";
+                return false;
+            }
+
+            output.ResizeData (static_cast <uint32_t> (size));
+            std::memcpy (output.GetDataStartPointer (), begin, size);
+            return true;
+    }
+
+    error = "unknown data type";
+    return false;
+}
+
+bool ParseCsvLine (const char *begin, const char *end, const std::vector <Richard::DataType> &columnTypes,
+                   Richard::QueryBatch &output, std::string &error)
+{
+    std::string unquoted;
+    const char *cursor = begin;
+
+    for (std::size_t column = 0u; column < columnTypes.size (); ++column)
+    {
+        if (column > 0u)
+        {
+            if (cursor == end)
+            {
+                error = "expected " + std::to_string (columnTypes.size ()) + " fields, but found only " +
+                        std::to_string (column);
+                return false;
+            }
+
+            assert (*cursor == ',');
+            ++cursor;
+        }
+
+        Richard::AnyDataContainer &value = output.values_.emplace_back ();
+        if (cursor != end && *cursor == '"')
+        {
+            unquoted.clear ();
+            ++cursor;
+
+            while (true)
+            {
+                if (cursor == end)
+                {
+                    error = "quoted field is not terminated";
+                    return false;
+                }
+
+                if (*cursor == '"')
+                {
+                    ++cursor;
+                    if (cursor == end || *cursor != '"')
+                    {
+                        break;
+                    }
+                }
+
+                unquoted += *cursor;
+                ++cursor;
+            }
+
+            if (cursor != end && *cursor != ',')
+            {
+                error = "unexpected characters after quoted field";
+                return false;
+            }
+
+            // Quoted empty field is an empty value, not null.
+            output.nulls_.emplace_back (0u);
+            if (!ParseTextValue (columnTypes[column], unquoted.data (), unquoted.data () + unquoted.size (),
+                                 value, error))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const char *fieldEnd = std::find (cursor, end, ',');
+            output.nulls_.emplace_back (fieldEnd == cursor);
+
+            if (fieldEnd != cursor && !ParseTextValue (columnTypes[column], cursor, fieldEnd, value, error))
+            {
+                return false;
+            }
+
+            cursor = fieldEnd;
+        }
+    }
+
+    if (cursor != end)
+    {
+        error = "found more than " + std::to_string (columnTypes.size ()) + " fields";
+        return false;
+    }
+
+    return true;
+}
+
+void ParseCsvChunk (const char *begin, const char *end, const std::vector <Richard::DataType> &columnTypes,
+                    ParsedChunk &output)
+{
+    output.batch_.columnsCount_ = columnTypes.size ();
+    while (begin != end)
+    {
+        const char *lineEnd = std::find (begin, end, '\n');
+        const char *next = lineEnd == end ? end : lineEnd + 1;
+
+        if (lineEnd != begin && *(lineEnd - 1) == '\r')
+        {
+            --lineEnd;
+        }
+
+        if (lineEnd != begin && !ParseCsvLine (begin, lineEnd, columnTypes, output.batch_, output.error_))
+        {
+            output.errorLine_ = output.linesCount_;
+            return;
+        }
+
+        ++output.linesCount_;
+        begin = next;
+    }
+}
+
+/// Reads values from columnar block and checks that they are not out of block bounds.
+class BlockReader final
+{
+public:
+    explicit BlockReader (const std::vector <uint8_t> &block)
+        : block_ (block),
+          position_ (0u)
+    {
+    }
+
+    bool Read (void *output, std::size_t size)
+    {
+        if (block_.size () - position_ < size)
+        {
+            return false;
+        }
+
+        std::memcpy (output, block_.data () + position_, size);
+        position_ += size;
+        return true;
+    }
+
+    bool IsFinished () const
+    {
+        return position_ == block_.size ();
+    }
+
+private:
+    const std::vector <uint8_t> &block_;
+    std::size_t position_;
+};
+
+void ParseColumnarBlock (const std::vector <uint8_t> &block, const std::vector <Richard::DataType> &columnTypes,
+                         ParsedChunk &output)
+{
+    BlockReader reader (block);
+    uint64_t rowsCount;
+
+    // Every row has at least a null flag per column, so rows count is checked before allocation.
+    if (!reader.Read (&rowsCount, sizeof (rowsCount)) || rowsCount > block.size ())
+    {
+        output.error_ = "rows count is missing or malformed";
+        return;
+    }
+
+    const std::size_t columnsCount = columnTypes.size ();
+    output.batch_.columnsCount_ = columnsCount;
+    output.batch_.values_.resize (rowsCount * columnsCount);
+    output.batch_.nulls_.resize (rowsCount * columnsCount);
+    std::vector <uint8_t> nulls (rowsCount);
+
+    for (std::size_t column = 0u; column < columnsCount; ++column)
+    {
+        const Richard::DataType dataType = columnTypes[column];
+        if (!reader.Read (nulls.data (), nulls.size ()))
+        {
+            output.error_ = "null flags of column " + std::to_string (column) + " are truncated";
+            return;
+        }
+
+        for (std::size_t row = 0u; row < rowsCount; ++row)
+        {
+            const std::size_t index = row * columnsCount + column;
+            output.batch_.nulls_[index] = nulls[row] != 0u;
+
+            if (nulls[row])
+            {
+                continue;
+            }
+
+            Richard::AnyDataContainer &value = output.batch_.values_[index];
+            value = Richard::AnyDataContainer (dataType);
+            uint32_t size = Richard::GetDataTypeSize (dataType);
+
+            if (Richard::IsVariableSizeDataType (dataType))
+            {
+                if (!reader.Read (&size, sizeof (size)) || size > Richard::MAX_VARIABLE_DATA_SIZE)
+                {
+                    output.error_ = "size of value in row " + std::to_string (row) + " of column " +
+                                    std::to_string (column) + " is missing or too big";
+                    return;
+                }
+
+                value.ResizeData (size);
+            }
+
+            if (!reader.Read (value.GetDataStartPointer (), size))
+            {
+                output.error_ = "value in row " + std::to_string (row) + " of column " + std::to_string (column) +
+                                " is truncated";
+                return;
+            }
+        }
+    }
+
+    if (!reader.IsFinished ())
+    {
+        output.error_ = "block has unexpected data after last column";
+    }
+}
+
+bool ReadCsv (FILE *file, bool skipHeader, const std::vector <Richard::DataType> &columnTypes,
+              Disco::Context *workers, const Richard::QueryConsumer &consumer)
+{
+    const std::size_t waveSize = GetWaveSize (workers);
+    std::vector <char> buffer;
+    std::vector <ParsedChunk> chunks;
+    std::size_t linesProcessed = 0u;
+    bool finished = false;
+
+    while (!finished)
+    {
+        const std::size_t oldSize = buffer.size ();
+        buffer.resize (oldSize + waveSize * CSV_CHUNK_SIZE);
+
+        const std::size_t read = std::fread (buffer.data () + oldSize, 1u, buffer.size () - oldSize, file);
+        buffer.resize (oldSize + read);
+        finished = read == 0u;
+
+        // Only complete lines are parsed, the last incomplete line is left for the next wave.
+        std::size_t parseEnd = buffer.size ();
+        if (!finished)
+        {
+            auto lastLineBreak = std::find (buffer.rbegin (), buffer.rend (), '\n');
+            if (lastLineBreak == buffer.rend ())
+            {
+                continue;
+            }
+
+            parseEnd = static_cast <std::size_t> (buffer.rend () - lastLineBreak);
+        }
+
+        std::size_t parseBegin = 0u;
+        if (skipHeader && parseEnd > 0u)
+        {
+            parseBegin = static_cast <std::size_t> (
+                std::find (buffer.data (), buffer.data () + parseEnd, '\n') - buffer.data ());
+            parseBegin = std::min (parseBegin + 1u, parseEnd);
+            skipHeader = false;
+            ++linesProcessed;
+        }
+
+        // Chunks are split at line breaks near equal intervals, so every chunk contains only complete lines.
+        std::vector <std::size_t> bounds {parseBegin};
+        for (std::size_t index = 1u; index < waveSize; ++index)
+        {
+            std::size_t bound = std::max (parseBegin + (parseEnd - parseBegin) * index / waveSize, bounds.back ());
+            bound = static_cast <std::size_t> (
+                std::find (buffer.data () + bound, buffer.data () + parseEnd, '\n') - buffer.data ());
+            bounds.emplace_back (std::min (bound + 1u, parseEnd));
+        }
+
+        bounds.emplace_back (parseEnd);
+        chunks.clear ();
+        chunks.resize (waveSize);
+
+        Disco::ParallelFor (workers, waveSize,
+                            [&buffer, &bounds, &chunks, &columnTypes] (std::size_t index)
+                            {
+                                ParseCsvChunk (buffer.data () + bounds[index], buffer.data () + bounds[index + 1u],
+                                               columnTypes, chunks[index]);
+                            });
+
+        for (ParsedChunk &chunk : chunks)
+        {
+            if (!chunk.error_.empty ())
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR, "Unable to parse CSV line " +
+                                           std::to_string (linesProcessed + chunk.errorLine_ + 1u) + ": " +
+                                           chunk.error_ + "!");
+                return false;
+            }
+
+            linesProcessed += chunk.linesCount_;
+            if (chunk.batch_.GetRowsCount () > 0u && !consumer (chunk.batch_))
+            {
+                return false;
+            }
+        }
+
+        buffer.erase (buffer.begin (), buffer.begin () + parseEnd);
+    }
+
+    if (std::ferror (file))
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught error while reading CSV input!");
+        return false;
+    }
+
+    return true;
+}
+
+bool ReadColumnar (FILE *file, const std::vector <Richard::DataType> &columnTypes, Disco::Context *workers,
+                   const Richard::QueryConsumer &consumer)
+{
+    uint64_t signature;
+    if (std::fread (&signature, sizeof (signature), 1u, file) != 1u || signature != COLUMNAR_SIGNATURE)
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Columnar input signature is missing or malformed!");
+        return false;
+    }
+
+    const std::size_t waveSize = GetWaveSize (workers);
+    std::vector <std::vector <uint8_t>> blocks;
+    std::vector <ParsedChunk> chunks;
+    std::size_t blocksProcessed = 0u;
+    bool finished = false;
+
+    while (!finished)
+    {
+        blocks.clear ();
+        while (blocks.size () < waveSize)
+        {
+            uint64_t size;
+            if (std::fread (&size, sizeof (size), 1u, file) != 1u)
+            {
+                finished = true;
+                break;
+            }
+
+            std::vector <uint8_t> &block = blocks.emplace_back ();
+            block.resize (size);
+
+            if (std::fread (block.data (), 1u, size, file) != size)
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR, "Columnar input block " + std::to_string (blocksProcessed + blocks.size ()) +
+                                           " is truncated!");
+                return false;
+            }
+        }
+
+        chunks.clear ();
+        chunks.resize (blocks.size ());
+        Disco::ParallelFor (workers, blocks.size (),
+                            [&blocks, &chunks, &columnTypes] (std::size_t index)
+                            {
+                                ParseColumnarBlock (blocks[index], columnTypes, chunks[index]);
+                            });
+
+        for (ParsedChunk &chunk : chunks)
+        {
+            ++blocksProcessed;
+            if (!chunk.error_.empty ())
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR, "Unable to parse columnar input block " +
+                                           std::to_string (blocksProcessed) + ": " + chunk.error_ + "!");
+                return false;
+            }
+
+            if (chunk.batch_.GetRowsCount () > 0u && !consumer (chunk.batch_))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (std::ferror (file))
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught error while reading columnar input!");
+        return false;
+    }
+
+    return true;
+}
+}
+
+bool ReadInput (InputFormat format, const std::string &path, const std::vector <Richard::DataType> &columnTypes,
+                Disco::Context *workers, const Richard::QueryConsumer &consumer)
+{
+    FileHandle file (std::fopen (path.c_str (), "rb"), &std::fclose);
+    if (!file)
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to open input file \"" + path + "\"!");
+        return false;
+    }
+
+    switch (format)
+    {
+        case InputFormat::CSV:
+        case InputFormat::CSV_WITH_HEADER:
+            return ReadCsv (file.get (), format == InputFormat::CSV_WITH_HEADER, columnTypes, workers, consumer);
+
+        case InputFormat::COLUMNAR:
+            return ReadColumnar (file.get (), columnTypes, workers, consumer);
+    }
+
+    assert (false);
+    return false;
+}
+}
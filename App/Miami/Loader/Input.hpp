@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Query.hpp>
+
+namespace Miami::App::Loader
+{
+enum class InputFormat
+{
+    /// Comma separated values without header, one row per line. Empty unquoted field is null and empty lines are
+    /// skipped. Quoted fields could contain commas and doubled quotes, but not line breaks.
+    CSV = 0,
+
+    /// Same as ::CSV, but first line is a header and it is skipped.
+    CSV_WITH_HEADER,
+
+    /// Signature ::COLUMNAR_SIGNATURE followed by independent blocks of rows. Block starts with uint64 size of
+    /// the rest of the block and uint64 rows count. Then columns follow one after another: null flag byte for
+    /// every row and then values of non null rows. Fixed size values are stored as is, variable size values are
+    /// prefixed by uint32 size. All numbers are stored in native byte order.
+    COLUMNAR
+};
+
+constexpr uint64_t COLUMNAR_SIGNATURE = 0x4C4F43494D41494Du;
+
+/// Size of CSV text parsed by one task.
+constexpr std::size_t CSV_CHUNK_SIZE = 4u * 1024u * 1024u;
+
+/// Reads input file in waves of chunks for CSV and blocks for columnar input. Chunks of one wave are parsed by
+/// workers in parallel and passed to consumer in input order, so memory usage is bounded by wave size.
+/// Errors are logged with positions in input. Returns false if input is malformed or consumer stopped reading.
+free_call bool ReadInput (InputFormat format, const std::string &path,
+                          const std::vector <Richard::DataType> &columnTypes, Disco::Context *workers,
+                          const Richard::QueryConsumer &consumer);
+}
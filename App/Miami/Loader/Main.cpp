@@ -0,0 +1,276 @@
+// Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
+#define NOGDI
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <memory>
+
+#include <App/Miami/Loader/Context.hpp>
+
+#include <Miami/Evan/GlobalLogger.hpp>
+#include <Miami/Evan/Logger.hpp>
+
+enum class ExitCode
+{
+    OK = 0,
+    INCORRECT_ARGUMENTS,
+    UNABLE_TO_SETUP_LOGGING,
+    LOADER_ERROR,
+};
+
+#define Exit(Code) return static_cast<int>(Code)
+
+enum class Destination
+{
+    SERVER = 0,
+    BACKUP,
+};
+
+struct CommandLineArguments
+{
+    std::string logFileName_;
+    uint32_t workerThreads_;
+    Destination destination_;
+
+    /// Host and service for server destination, backup file name for backup destination.
+    std::vector <std::string> destinationArguments_;
+    Miami::App::Loader::LoadTask task_;
+};
+
+bool ParseCommandLineArguments (int argc, char **argv, CommandLineArguments &output);
+
+bool ParseColumns (const std::string &text, std::vector <Miami::Richard::ColumnInfo> &output);
+
+bool ParseIndex (const std::string &text, const std::vector <Miami::Richard::ColumnInfo> &columns,
+                 Miami::App::Loader::IndexDescription &output);
+
+std::vector <std::string> Split (const std::string &text, char separator);
+
+bool SetupLogging (const CommandLineArguments &arguments);
+
+int main (int argc, char **argv)
+{
+    CommandLineArguments arguments;
+    if (!ParseCommandLineArguments (argc, argv, arguments))
+    {
+        Exit (ExitCode::INCORRECT_ARGUMENTS);
+    }
+
+    if (!SetupLogging (arguments))
+    {
+        Exit (ExitCode::UNABLE_TO_SETUP_LOGGING);
+    }
+
+    auto loaderContext = std::make_unique <Miami::App::Loader::Context> (arguments.workerThreads_);
+    Miami::App::Loader::ResultCode result;
+
+    if (arguments.destination_ == Destination::SERVER)
+    {
+        result = loaderContext->LoadToServer (
+            arguments.destinationArguments_[0], arguments.destinationArguments_[1], arguments.task_);
+    }
+    else
+    {
+        result = loaderContext->LoadToBackup (arguments.destinationArguments_[0], arguments.task_);
+    }
+
+    if (result == Miami::App::Loader::ResultCode::OK)
+    {
+        Exit (ExitCode::OK);
+    }
+    else
+    {
+        printf ("Loader execution resulted in error with code %d!", static_cast <int> (result));
+        Exit (ExitCode::LOADER_ERROR);
+    }
+}
+
+bool ParseCommandLineArguments (int argc, char **argv, CommandLineArguments &output)
+{
+    const std::size_t firstIndexArgument = argc > 7 && std::strcmp (argv[7], "server") == 0 ? 10u : 9u;
+    if (argc < 9 || static_cast <std::size_t> (argc) < firstIndexArgument)
+    {
+        printf ("Expected command line: <executable> <log_file_name> <worker_threads> <csv|csv_header|columnar> "
+                "<input_file> <table_name> <column_name:type[,column_name:type...]> "
+                "server <host> <service> | backup <backup_file_name> "
+                "[<index_name:ordered|hash|unique_ordered|unique_hash:column_name[+column_name...]>...]");
+        return false;
+    }
+
+    output.logFileName_ = argv[1];
+    int workerThreads = atoi (argv[2]);
+
+    if (workerThreads < 1)
+    {
+        printf ("Worker threads count must be positive non-zero 32-bit integer!");
+        return false;
+    }
+
+    output.workerThreads_ = static_cast <uint32_t> (workerThreads);
+    const std::string format = argv[3];
+
+    if (format == "csv")
+    {
+        output.task_.format_ = Miami::App::Loader::InputFormat::CSV;
+    }
+    else if (format == "csv_header")
+    {
+        output.task_.format_ = Miami::App::Loader::InputFormat::CSV_WITH_HEADER;
+    }
+    else if (format == "columnar")
+    {
+        output.task_.format_ = Miami::App::Loader::InputFormat::COLUMNAR;
+    }
+    else
+    {
+        printf ("Input format must be csv, csv_header or columnar!");
+        return false;
+    }
+
+    output.task_.inputPath_ = argv[4];
+    output.task_.tableName_ = argv[5];
+
+    if (!ParseColumns (argv[6], output.task_.columns_))
+    {
+        return false;
+    }
+
+    if (std::strcmp (argv[7], "server") == 0)
+    {
+        output.destination_ = Destination::SERVER;
+    }
+    else if (std::strcmp (argv[7], "backup") == 0)
+    {
+        output.destination_ = Destination::BACKUP;
+    }
+    else
+    {
+        printf ("Destination must be server or backup!");
+        return false;
+    }
+
+    output.destinationArguments_.assign (argv + 8, argv + firstIndexArgument);
+    for (int index = static_cast <int> (firstIndexArgument); index < argc; ++index)
+    {
+        if (!ParseIndex (argv[index], output.task_.columns_, output.task_.indices_.emplace_back ()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ParseColumns (const std::string &text, std::vector <Miami::Richard::ColumnInfo> &output)
+{
+    for (const std::string &column : Split (text, ','))
+    {
+        std::vector <std::string> parts = Split (column, ':');
+        if (parts.size () != 2u || parts[0].empty ())
+        {
+            printf ("Column \"%s\" must be described as name:type!", column.c_str ());
+            return false;
+        }
+
+        auto dataType = Miami::Richard::DataType::INT8;
+        while (parts[1] != Miami::Richard::GetDataTypeName (dataType))
+        {
+            if (dataType == Miami::Richard::DataType::VARBINARY)
+            {
+                printf ("Column \"%s\" has unknown type!", column.c_str ());
+                return false;
+            }
+
+            dataType = static_cast <Miami::Richard::DataType> (static_cast <int> (dataType) + 1);
+        }
+
+        output.push_back ({0u, dataType, parts[0]});
+    }
+
+    return true;
+}
+
+bool ParseIndex (const std::string &text, const std::vector <Miami::Richard::ColumnInfo> &columns,
+                 Miami::App::Loader::IndexDescription &output)
+{
+    std::vector <std::string> parts = Split (text, ':');
+    if (parts.size () != 3u || parts[0].empty ())
+    {
+        printf ("Index \"%s\" must be described as name:type:columns!", text.c_str ());
+        return false;
+    }
+
+    output.name_ = parts[0];
+    output.unique_ = parts[1].rfind ("unique_", 0u) == 0u;
+    const std::string type = output.unique_ ? parts[1].substr (7u) : parts[1];
+
+    if (type == "ordered")
+    {
+        output.type_ = Miami::Richard::IndexType::ORDERED;
+    }
+    else if (type == "hash")
+    {
+        output.type_ = Miami::Richard::IndexType::HASH;
+    }
+    else
+    {
+        printf ("Index \"%s\" has unknown type!", text.c_str ());
+        return false;
+    }
+
+    output.columns_ = Split (parts[2], '+');
+    for (const std::string &name : output.columns_)
+    {
+        if (std::none_of (columns.begin (), columns.end (),
+                          [&name] (const Miami::Richard::ColumnInfo &column)
+                          {
+                              return column.name_ == name;
+                          }))
+        {
+            printf ("Index \"%s\" refers to unknown column \"%s\"!", text.c_str (), name.c_str ());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector <std::string> Split (const std::string &text, char separator)
+{
+    std::vector <std::string> parts;
+    std::size_t begin = 0u;
+
+    while (true)
+    {
+        std::size_t end = text.find (separator, begin);
+        parts.emplace_back (text.substr (begin, end - begin));
+
+        if (end == std::string::npos)
+        {
+            return parts;
+        }
+
+        begin = end + 1u;
+    }
+}
+
+bool SetupLogging (const CommandLineArguments &arguments)
+{
+    Miami::Evan::GlobalLogger::Instance ().AddOutput (
+        std::make_shared <std::ostream> (std::cout.rdbuf ()), Miami::Evan::LogLevel::INFO);
+
+    auto fileSharedStream = std::make_shared <std::ofstream> (arguments.logFileName_);
+    if (*fileSharedStream)
+    {
+        Miami::Evan::GlobalLogger::Instance ().AddOutput (fileSharedStream, Miami::Evan::LogLevel::VERBOSE);
+        return true;
+    }
+    else
+    {
+        printf ("Unable to setup log output to file %s!", arguments.logFileName_.c_str ());
+        return false;
+    }
+}
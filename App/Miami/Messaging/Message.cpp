@@ -1,3 +1,5 @@
+#include <deque>
+
 #include <App/Miami/Messaging/Message.hpp>
 
 namespace Miami::App::Messaging
@@ -10,7 +12,10 @@ namespace Utils
 {
 thread_local std::vector <Hotline::MemoryRegion> sharedRegionsMap;
 
-thread_local std::vector <Richard::DataType> dataTypesCache;
+// Deques are used, because mapped regions point to cache elements, so they must not be moved by insertions.
+thread_local std::deque <Richard::DataType> dataTypesCache;
+
+thread_local std::deque <uint32_t> dataSizesCache;
 
 template <typename Type, std::enable_if_t <std::is_pod_v <Type>, bool> = true>
 void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *session)
@@ -22,7 +27,9 @@ void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *
 
 #define START_WRITE_MAPPING          \
     assert (session);                \
-    Utils::sharedRegionsMap.clear()
+    Utils::sharedRegionsMap.clear(); \
+    Utils::dataTypesCache.clear ();  \
+    Utils::dataSizesCache.clear ()
 
 #define MAP_POD_WRITE(fieldName) \
     static_assert(std::is_pod_v<std::decay_t<decltype (fieldName)>>);                             \
@@ -39,26 +46,31 @@ void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *
             Hotline::MemoryRegion {&fieldName[0], sizeof (fieldName[0]) * fieldName ## Size});               \
     }
 
+// Variable size values are written with size prefix, fixed size values are written as is.
 #define MAP_ONE_TABLE_VALUE_INTERNAL(variable)                                                            \
     Richard::DataType type = variable.GetType ();                                                         \
     Utils::dataTypesCache.push_back (type);                                                               \
     MAP_POD_WRITE(Utils::dataTypesCache.back ());                                                         \
                                                                                                           \
+    if (Richard::IsVariableSizeDataType (type))                                                           \
+    {                                                                                                     \
+        Utils::dataSizesCache.push_back (variable.GetDataSize ());                                        \
+        MAP_POD_WRITE(Utils::dataSizesCache.back ());                                                     \
+    }                                                                                                     \
+                                                                                                          \
     const void *data = variable.GetDataStartPointer ();                                                   \
     assert (data);                                                                                        \
-    Utils::sharedRegionsMap.emplace_back (Hotline::MemoryRegion {data, Richard::GetDataTypeSize (type)})
+                                                                                                          \
+    if (variable.GetDataSize () > 0u)                                                                     \
+    {                                                                                                     \
+        Utils::sharedRegionsMap.emplace_back (Hotline::MemoryRegion {data, variable.GetDataSize ()});     \
+    }
 
-// TODO: Works correctly only if there is only one table value in message.
-#define MAP_ONE_TABLE_VALUE(field)              \
-    Utils::dataTypesCache.clear ();             \
-    Utils::dataTypesCache.reserve (1);          \
-    MAP_ONE_TABLE_VALUE_INTERNAL(field)
+#define MAP_ONE_TABLE_VALUE(field) MAP_ONE_TABLE_VALUE_INTERNAL(field)
 
 #define MAP_TABLE_VALUES_WRITE(fieldName)                                                                     \
     std::size_t fieldName ## Size = fieldName.size();                                                         \
     MAP_POD_WRITE(fieldName ## Size);                                                                         \
-    Utils::dataTypesCache.clear ();                                                                           \
-    Utils::dataTypesCache.reserve (fieldName.size ());                                                        \
                                                                                                               \
     for (const auto &columnValuePair : fieldName)                                                             \
     {                                                                                                         \
@@ -149,7 +161,9 @@ void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *
         READ_POD_VECTOR_CONTENT (fieldPath)                                                      \
         skipLabelName: ;
 
-#define REQUEST_AND_READ_TABLE_VALUE(valuePath, typeReaderStep, contentReaderStep)               \
+// Size of variable size value is read on separate step. Empty variable size
+// values have no content, so size reader step falls through content reader step.
+#define REQUEST_AND_READ_TABLE_VALUE(valuePath, typeReaderStep, sizeReaderStep, contentReaderStep) \
         NEXT_STEP;                                                                               \
         return {sizeof (Richard::DataType), true};                                               \
                                                                                                  \
@@ -158,16 +172,42 @@ void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *
         valuePath = Richard::AnyDataContainer (                                                  \
             *reinterpret_cast<const Richard::DataType *>(&chunk[0]));                            \
                                                                                                  \
+        if (Richard::IsVariableSizeDataType (valuePath.GetType ()))                              \
+        {                                                                                        \
+            NEXT_STEP;                                                                           \
+            return {sizeof (uint32_t), true};                                                    \
+        }                                                                                        \
+        else                                                                                     \
+        {                                                                                        \
+            step = contentReaderStep;                                                            \
+            return {valuePath.GetDataSize (), true};                                             \
+        }                                                                                        \
+                                                                                                 \
+    case sizeReaderStep:                                                                         \
+        VALIDATE_CHUNK_SIZE(sizeof (uint32_t));                                                  \
+        if (*reinterpret_cast<const uint32_t *>(&chunk[0]) > Richard::MAX_VARIABLE_DATA_SIZE)    \
+        {                                                                                        \
+            return {0, false};                                                                   \
+        }                                                                                        \
+                                                                                                 \
+        valuePath.ResizeData (*reinterpret_cast<const uint32_t *>(&chunk[0]));                   \
         NEXT_STEP;                                                                               \
-        return {Richard::GetDataTypeSize (valuePath.GetType ()), true};                          \
+                                                                                                 \
+        if (valuePath.GetDataSize () > 0u)                                                       \
+        {                                                                                        \
+            return {valuePath.GetDataSize (), true};                                             \
+        }                                                                                        \
+                                                                                                 \
+        [[fallthrough]];                                                                         \
                                                                                                  \
     case contentReaderStep:                                                                      \
-        VALIDATE_CHUNK_SIZE(Richard::GetDataTypeSize (valuePath.GetType ()));                    \
+        if (valuePath.GetDataSize () > 0u)                                                       \
         {                                                                                        \
+            VALIDATE_CHUNK_SIZE(valuePath.GetDataSize ());                                       \
             void *data = valuePath.GetDataStartPointer ();                                       \
             if (data)                                                                            \
             {                                                                                    \
-                memcpy (data, &chunk[0], Richard::GetDataTypeSize (valuePath.GetType ()));       \
+                memcpy (data, &chunk[0], valuePath.GetDataSize ());                              \
             }                                                                                    \
             else                                                                                 \
             {                                                                                    \
@@ -176,7 +216,7 @@ void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *
         }
 
 #define REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(fieldPath, counterPath, \
-            countReaderStep, idReaderStep, typeReaderStep, dataReaderStep, \
+            countReaderStep, idReaderStep, typeReaderStep, sizeReaderStep, dataReaderStep, \
             allReadLabelName, readNextLabelName)                                                           \
         NEXT_STEP;                                                                                         \
         return {sizeof (std::size_t), true};                                                               \
@@ -198,7 +238,8 @@ void WritePODMessage (Type *value, Message messageType, Hotline::SocketSession *
                                                                                                            \
     case idReaderStep:                                                                                     \
         READ_POD(fieldPath[counterPath].first);                                                            \
-        REQUEST_AND_READ_TABLE_VALUE(fieldPath[counterPath].second, typeReaderStep, dataReaderStep);       \
+        REQUEST_AND_READ_TABLE_VALUE(fieldPath[counterPath].second, typeReaderStep, sizeReaderStep,        \
+                                     dataReaderStep);                                                      \
         ++counterPath;                                                                                     \
                                                                                                            \
         if (counterPath < fieldPath.size ())                                                               \
@@ -323,6 +364,75 @@ const char *GetMessageName (Message message)
 
         case Message::REMOVE_TABLE_REQUEST:
             return "REMOVE_TABLE_REQUEST";
+
+        case Message::CREATE_SNAPSHOT_CURSOR_REQUEST:
+            return "CREATE_SNAPSHOT_CURSOR_REQUEST";
+
+        case Message::BEGIN_TRANSACTION_REQUEST:
+            return "BEGIN_TRANSACTION_REQUEST";
+
+        case Message::COMMIT_TRANSACTION_REQUEST:
+            return "COMMIT_TRANSACTION_REQUEST";
+
+        case Message::ROLLBACK_TRANSACTION_REQUEST:
+            return "ROLLBACK_TRANSACTION_REQUEST";
+
+        case Message::CREATE_LOOKUP_READ_CURSOR_REQUEST:
+            return "CREATE_LOOKUP_READ_CURSOR_REQUEST";
+
+        case Message::CREATE_LOOKUP_EDIT_CURSOR_REQUEST:
+            return "CREATE_LOOKUP_EDIT_CURSOR_REQUEST";
+
+        case Message::CREATE_FILTERED_READ_CURSOR_REQUEST:
+            return "CREATE_FILTERED_READ_CURSOR_REQUEST";
+
+        case Message::CREATE_FILTERED_EDIT_CURSOR_REQUEST:
+            return "CREATE_FILTERED_EDIT_CURSOR_REQUEST";
+
+        case Message::AGGREGATE_REQUEST:
+            return "AGGREGATE_REQUEST";
+
+        case Message::AGGREGATE_RESPONSE:
+            return "AGGREGATE_RESPONSE";
+
+        case Message::GET_TABLE_STATISTICS_REQUEST:
+            return "GET_TABLE_STATISTICS_REQUEST";
+
+        case Message::GET_TABLE_STATISTICS_RESPONSE:
+            return "GET_TABLE_STATISTICS_RESPONSE";
+
+        case Message::EXECUTE_QUERY_REQUEST:
+            return "EXECUTE_QUERY_REQUEST";
+
+        case Message::QUERY_RESULT_RESPONSE:
+            return "QUERY_RESULT_RESPONSE";
+
+        case Message::JOIN_REQUEST:
+            return "JOIN_REQUEST";
+
+        case Message::BACKUP_REQUEST:
+            return "BACKUP_REQUEST";
+
+        case Message::ADD_ROWS_REQUEST:
+            return "ADD_ROWS_REQUEST";
+
+        case Message::REPLICATION_PULL_REQUEST:
+            return "REPLICATION_PULL_REQUEST";
+
+        case Message::REPLICATION_BATCH_RESPONSE:
+            return "REPLICATION_BATCH_RESPONSE";
+
+        case Message::REPLICATION_STATUS_REQUEST:
+            return "REPLICATION_STATUS_REQUEST";
+
+        case Message::REPLICATION_STATUS_RESPONSE:
+            return "REPLICATION_STATUS_RESPONSE";
+
+        case Message::GET_TABLE_EDIT_ACCESS_REQUEST:
+            return "GET_TABLE_EDIT_ACCESS_REQUEST";
+
+        case Message::CLOSE_TABLE_EDIT_ACCESS_REQUEST:
+            return "CLOSE_TABLE_EDIT_ACCESS_REQUEST";
     }
 
     assert (false);
@@ -416,6 +526,111 @@ const char *GetOperationResultName (OperationResult operationResult)
 
         case OperationResult::DUPLICATE_COLUMN_VALUES_IN_INSERTION_REQUEST:
             return "DUPLICATE_COLUMN_VALUES_IN_INSERTION_REQUEST";
+
+        case OperationResult::TRANSACTION_ALREADY_STARTED:
+            return "TRANSACTION_ALREADY_STARTED";
+
+        case OperationResult::TRANSACTION_NOT_STARTED:
+            return "TRANSACTION_NOT_STARTED";
+
+        case OperationResult::TABLE_ACCESS_OWNED_BY_TRANSACTION:
+            return "TABLE_ACCESS_OWNED_BY_TRANSACTION";
+
+        case OperationResult::TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE:
+            return "TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE";
+
+        case OperationResult::TRANSACTION_TABLES_MUST_BE_UNIQUE:
+            return "TRANSACTION_TABLES_MUST_BE_UNIQUE";
+
+        case OperationResult::TABLE_IS_NOT_COVERED_BY_TRANSACTION:
+            return "TABLE_IS_NOT_COVERED_BY_TRANSACTION";
+
+        case OperationResult::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION:
+            return "INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION";
+
+        case OperationResult::LOOKUP_KEY_COLUMN_IS_NOT_INDEXED:
+            return "LOOKUP_KEY_COLUMN_IS_NOT_INDEXED";
+
+        case OperationResult::LOOKUP_KEY_VALUE_TYPE_MISMATCH:
+            return "LOOKUP_KEY_VALUE_TYPE_MISMATCH";
+
+        case OperationResult::UNIQUE_INDEX_CONSTRAINT_VIOLATED:
+            return "UNIQUE_INDEX_CONSTRAINT_VIOLATED";
+
+        case OperationResult::PREDICATE_IS_MALFORMED:
+            return "PREDICATE_IS_MALFORMED";
+
+        case OperationResult::PREDICATE_VALUE_TYPE_MISMATCH:
+            return "PREDICATE_VALUE_TYPE_MISMATCH";
+
+        case OperationResult::COLUMN_MAX_SIZE_IS_TOO_BIG:
+            return "COLUMN_MAX_SIZE_IS_TOO_BIG";
+
+        case OperationResult::NEW_COLUMN_VALUE_IS_TOO_BIG:
+            return "NEW_COLUMN_VALUE_IS_TOO_BIG";
+
+        case OperationResult::DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE:
+            return "DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE";
+
+        case OperationResult::COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE:
+            return "COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE";
+
+        case OperationResult::AGGREGATE_FUNCTION_IS_UNKNOWN:
+            return "AGGREGATE_FUNCTION_IS_UNKNOWN";
+
+        case OperationResult::AGGREGATE_COLUMN_MUST_BE_INTEGER:
+            return "AGGREGATE_COLUMN_MUST_BE_INTEGER";
+
+        case OperationResult::INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX:
+            return "INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX";
+
+        case OperationResult::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN:
+            return "QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN";
+
+        case OperationResult::QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE:
+            return "QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE";
+
+        case OperationResult::JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN:
+            return "JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN";
+
+        case OperationResult::JOIN_KEY_COLUMNS_COUNT_MISMATCH:
+            return "JOIN_KEY_COLUMNS_COUNT_MISMATCH";
+
+        case OperationResult::JOIN_KEY_COLUMN_TYPES_MISMATCH:
+            return "JOIN_KEY_COLUMN_TYPES_MISMATCH";
+
+        case OperationResult::BACKUP_MUST_COVER_ALL_TABLES:
+            return "BACKUP_MUST_COVER_ALL_TABLES";
+
+        case OperationResult::BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL:
+            return "BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL";
+
+        case OperationResult::BACKUP_FILE_WRITE_FAILED:
+            return "BACKUP_FILE_WRITE_FAILED";
+
+        case OperationResult::ROWS_BATCH_IS_MALFORMED:
+            return "ROWS_BATCH_IS_MALFORMED";
+
+        case OperationResult::SERVER_IS_READ_ONLY_REPLICA:
+            return "SERVER_IS_READ_ONLY_REPLICA";
+
+        case OperationResult::REPLICATION_IS_NOT_ENABLED:
+            return "REPLICATION_IS_NOT_ENABLED";
+
+        case OperationResult::REPLICATION_SEQUENCE_IS_AHEAD:
+            return "REPLICATION_SEQUENCE_IS_AHEAD";
+
+        case OperationResult::REPLICATION_RESYNC_IS_NEEDED:
+            return "REPLICATION_RESYNC_IS_NEEDED";
+
+        case OperationResult::TABLE_EDIT_ACCESS_REQUIRED:
+            return "TABLE_EDIT_ACCESS_REQUIRED";
+
+        case OperationResult::TABLE_WRITE_OR_EDIT_ACCESS_REQUIRED:
+            return "TABLE_WRITE_OR_EDIT_ACCESS_REQUIRED";
+
+        case OperationResult::ALREADY_HAS_EDIT_ACCESS:
+            return "ALREADY_HAS_EDIT_ACCESS";
     }
 
     assert (false);
@@ -579,6 +794,9 @@ Hotline::MessageParser ColumnInfoResponse::CreateParserWithCallback (
         START = 0,
         READ_QUERY_ID,
         READ_DATA_TYPE,
+        READ_MAX_SIZE,
+        READ_DICTIONARY_ENCODED,
+        READ_COMPRESSED,
         READ_NAME_SIZE,
         READ_NAME_CONTENT
     };
@@ -603,6 +821,21 @@ Hotline::MessageParser ColumnInfoResponse::CreateParserWithCallback (
 
             case READ_DATA_TYPE:
             READ_POD (result.dataType_);
+                NEXT_STEP;
+                REQUEST_POD (result.maxSize_);
+
+            case READ_MAX_SIZE:
+            READ_POD (result.maxSize_);
+                NEXT_STEP;
+                REQUEST_POD (result.dictionaryEncoded_);
+
+            case READ_DICTIONARY_ENCODED:
+            READ_POD (result.dictionaryEncoded_);
+                NEXT_STEP;
+                REQUEST_POD (result.compressed_);
+
+            case READ_COMPRESSED:
+            READ_POD (result.compressed_);
                 REQUEST_AND_READ_POD_VECTOR(result.name_, READ_NAME_SIZE,
                                             READ_NAME_CONTENT, ColumnInfoResponse_NAME_READ_SKIP_LABEL);
 
@@ -623,6 +856,9 @@ void ColumnInfoResponse::Write (Message messageType, Hotline::SocketSession *ses
     START_WRITE_MAPPING;
     MAP_POD_WRITE(queryId_);
     MAP_POD_WRITE(dataType_);
+    MAP_POD_WRITE(maxSize_);
+    MAP_POD_WRITE(dictionaryEncoded_);
+    MAP_POD_WRITE(compressed_);
     MAP_POD_VECTOR_WRITE(name_);
     END_WRITE_MAPPING;
 }
@@ -635,10 +871,14 @@ Hotline::MessageParser IndexInfoResponse::CreateParserWithCallback (
     {
         START = 0,
         READ_QUERY_ID,
+        READ_TYPE,
+        READ_UNIQUE,
         READ_NAME_SIZE,
         READ_NAME_CONTENT,
         READ_COLUMNS_COUNT,
-        READ_COLUMNS
+        READ_COLUMNS,
+        READ_INCLUDED_COLUMNS_COUNT,
+        READ_INCLUDED_COLUMNS
     };
 
     return [finishCallback (std::move (callback)),
@@ -656,12 +896,25 @@ Hotline::MessageParser IndexInfoResponse::CreateParserWithCallback (
 
             case READ_QUERY_ID:
             READ_POD (result.queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result.type_);
+
+            case READ_TYPE:
+            READ_POD (result.type_);
+                NEXT_STEP;
+                REQUEST_POD (result.unique_);
+
+            case READ_UNIQUE:
+            READ_POD (result.unique_);
                 REQUEST_AND_READ_POD_VECTOR(result.name_, READ_NAME_SIZE,
                                             READ_NAME_CONTENT, IndexInfoResponse_NAME_READ_SKIP_LABEL);
 
                 REQUEST_AND_READ_POD_VECTOR(result.columns_, READ_COLUMNS_COUNT,
                                             READ_COLUMNS, IndexInfoResponse_COLUMNS_READ_SKIP_LABEL);
 
+                REQUEST_AND_READ_POD_VECTOR(result.includedColumns_, READ_INCLUDED_COLUMNS_COUNT,
+                                            READ_INCLUDED_COLUMNS, IndexInfoResponse_INCLUDED_COLUMNS_READ_SKIP_LABEL);
+
                 if (finishCallback)
                 {
                     finishCallback (result, session);
@@ -678,8 +931,11 @@ void IndexInfoResponse::Write (Message messageType, Hotline::SocketSession *sess
 {
     START_WRITE_MAPPING;
     MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(type_);
+    MAP_POD_WRITE(unique_);
     MAP_POD_VECTOR_WRITE(name_);
     MAP_POD_VECTOR_WRITE(columns_);
+    MAP_POD_VECTOR_WRITE(includedColumns_);
     END_WRITE_MAPPING;
 }
 
@@ -750,6 +1006,9 @@ Hotline::MessageParser AddColumnRequest::CreateParserWithCallback (
         READ_QUERY_ID,
         READ_TABLE_ID,
         READ_DATA_TYPE,
+        READ_MAX_SIZE,
+        READ_DICTIONARY_ENCODED,
+        READ_COMPRESSED,
         READ_NAME_SIZE,
         READ_NAME_CONTENT
     };
@@ -779,6 +1038,21 @@ Hotline::MessageParser AddColumnRequest::CreateParserWithCallback (
 
             case READ_DATA_TYPE:
             READ_POD (result.dataType_);
+                NEXT_STEP;
+                REQUEST_POD (result.maxSize_);
+
+            case READ_MAX_SIZE:
+            READ_POD (result.maxSize_);
+                NEXT_STEP;
+                REQUEST_POD (result.dictionaryEncoded_);
+
+            case READ_DICTIONARY_ENCODED:
+            READ_POD (result.dictionaryEncoded_);
+                NEXT_STEP;
+                REQUEST_POD (result.compressed_);
+
+            case READ_COMPRESSED:
+            READ_POD (result.compressed_);
                 REQUEST_AND_READ_POD_VECTOR(result.name_, READ_NAME_SIZE,
                                             READ_NAME_CONTENT, AddColumnRequest_NAME_READ_SKIP_LABEL);
 
@@ -800,6 +1074,9 @@ void AddColumnRequest::Write (Message messageType, Hotline::SocketSession *sessi
     MAP_POD_WRITE(queryId_);
     MAP_POD_WRITE(tableId_);
     MAP_POD_WRITE(dataType_);
+    MAP_POD_WRITE(maxSize_);
+    MAP_POD_WRITE(dictionaryEncoded_);
+    MAP_POD_WRITE(compressed_);
     MAP_POD_VECTOR_WRITE(name_);
     END_WRITE_MAPPING;
 }
@@ -813,10 +1090,14 @@ Hotline::MessageParser AddIndexRequest::CreateParserWithCallback (
         START = 0,
         READ_QUERY_ID,
         READ_TABLE_ID,
+        READ_TYPE,
+        READ_UNIQUE,
         READ_NAME_SIZE,
         READ_NAME_CONTENT,
         READ_COLUMNS_COUNT,
-        READ_COLUMNS
+        READ_COLUMNS,
+        READ_INCLUDED_COLUMNS_COUNT,
+        READ_INCLUDED_COLUMNS
     };
 
     return [finishCallback (std::move (callback)),
@@ -839,12 +1120,25 @@ Hotline::MessageParser AddIndexRequest::CreateParserWithCallback (
 
             case READ_TABLE_ID:
             READ_POD (result.tableId_);
+                NEXT_STEP;
+                REQUEST_POD (result.type_);
+
+            case READ_TYPE:
+            READ_POD (result.type_);
+                NEXT_STEP;
+                REQUEST_POD (result.unique_);
+
+            case READ_UNIQUE:
+            READ_POD (result.unique_);
                 REQUEST_AND_READ_POD_VECTOR(result.name_, READ_NAME_SIZE,
                                             READ_NAME_CONTENT, AddIndexRequest_NAME_READ_SKIP_LABEL);
 
                 REQUEST_AND_READ_POD_VECTOR(result.columns_, READ_COLUMNS_COUNT,
                                             READ_COLUMNS, AddIndexRequest_COLUMNS_READ_SKIP_LABEL);
 
+                REQUEST_AND_READ_POD_VECTOR(result.includedColumns_, READ_INCLUDED_COLUMNS_COUNT,
+                                            READ_INCLUDED_COLUMNS, AddIndexRequest_INCLUDED_COLUMNS_READ_SKIP_LABEL);
+
                 if (finishCallback)
                 {
                     finishCallback (result, session);
@@ -862,8 +1156,11 @@ void AddIndexRequest::Write (Message messageType, Hotline::SocketSession *sessio
     START_WRITE_MAPPING;
     MAP_POD_WRITE(queryId_);
     MAP_POD_WRITE(tableId_);
+    MAP_POD_WRITE(type_);
+    MAP_POD_WRITE(unique_);
     MAP_POD_VECTOR_WRITE(name_);
     MAP_POD_VECTOR_WRITE(columns_);
+    MAP_POD_VECTOR_WRITE(includedColumns_);
     END_WRITE_MAPPING;
 }
 
@@ -879,6 +1176,7 @@ AddRowRequest::CreateParserWithCallback (std::function <void (AddRowRequest &, H
         READ_VALUES_COUNT,
         READ_COLUMN_ID,
         READ_DATA_TYPE,
+        READ_DATA_SIZE,
         READ_DATA
     };
 
@@ -906,8 +1204,8 @@ AddRowRequest::CreateParserWithCallback (std::function <void (AddRowRequest &, H
             case READ_TABLE_ID:
             READ_POD (result->tableId_);
                 REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
-                    result->values_, valuesRead, READ_VALUES_COUNT, READ_COLUMN_ID, READ_DATA_TYPE, READ_DATA,
-                    CreateParserWithCallback_AllValuesRead, CreateParserWithCallback_ReadNextColumnId);
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_COLUMN_ID, READ_DATA_TYPE, READ_DATA_SIZE,
+                    READ_DATA, CreateParserWithCallback_AllValuesRead, CreateParserWithCallback_ReadNextColumnId);
 
                 if (finishCallback)
                 {
@@ -930,6 +1228,154 @@ void AddRowRequest::Write (Message messageType, Hotline::SocketSession *session)
     END_WRITE_MAPPING;
 }
 
+Hotline::MessageParser CreateLookupCursorRequest::CreateParserWithCallback (
+    std::function <void (CreateLookupCursorRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_TABLE_ID,
+        READ_INDEX_ID,
+        READ_VALUES_COUNT,
+        READ_COLUMN_ID,
+        READ_DATA_TYPE,
+        READ_DATA_SIZE,
+        READ_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <CreateLookupCursorRequest> ()),
+        valuesRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->tableId_);
+
+            case READ_TABLE_ID:
+            READ_POD (result->tableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->indexId_);
+
+            case READ_INDEX_ID:
+            READ_POD (result->indexId_);
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_COLUMN_ID, READ_DATA_TYPE, READ_DATA_SIZE,
+                    READ_DATA, CreateParserWithCallback_AllValuesRead, CreateParserWithCallback_ReadNextColumnId);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void CreateLookupCursorRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(tableId_);
+    MAP_POD_WRITE(indexId_);
+    MAP_TABLE_VALUES_WRITE(values_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser CreateFilteredCursorRequest::CreateParserWithCallback (
+    std::function <void (CreateFilteredCursorRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_TABLE_ID,
+        READ_INDEX_ID,
+        READ_NODES_COUNT,
+        READ_NODES,
+        READ_VALUES_COUNT,
+        READ_NODE_INDEX,
+        READ_DATA_TYPE,
+        READ_DATA_SIZE,
+        READ_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <CreateFilteredCursorRequest> ()),
+        valuesRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->tableId_);
+
+            case READ_TABLE_ID:
+            READ_POD (result->tableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->indexId_);
+
+            case READ_INDEX_ID:
+            READ_POD (result->indexId_);
+                REQUEST_AND_READ_POD_VECTOR(result->nodes_, READ_NODES_COUNT,
+                                            READ_NODES, CreateFilteredCursorRequest_NODES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_NODE_INDEX, READ_DATA_TYPE, READ_DATA_SIZE,
+                    READ_DATA, CreateParserWithCallback_AllValuesRead, CreateParserWithCallback_ReadNextNodeIndex);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void CreateFilteredCursorRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(tableId_);
+    MAP_POD_WRITE(indexId_);
+    MAP_POD_VECTOR_WRITE(nodes_);
+    MAP_TABLE_VALUES_WRITE(values_);
+    END_WRITE_MAPPING;
+}
+
 Hotline::MessageParser CursorAdvanceRequest::CreateParserWithCallback (
     std::function <void (CursorAdvanceRequest &, Hotline::SocketSession *)> &&callback)
 {
@@ -963,6 +1409,7 @@ Hotline::MessageParser CursorGetResponse::CreateParserWithCallback (
         START = 0,
         READ_QUERY_ID,
         READ_DATA_TYPE,
+        READ_DATA_SIZE,
         READ_DATA
     };
 
@@ -983,7 +1430,7 @@ Hotline::MessageParser CursorGetResponse::CreateParserWithCallback (
 
             case READ_QUERY_ID:
             READ_POD (result->queryId_);
-                REQUEST_AND_READ_TABLE_VALUE(result->value_, READ_DATA_TYPE, READ_DATA);
+                REQUEST_AND_READ_TABLE_VALUE(result->value_, READ_DATA_TYPE, READ_DATA_SIZE, READ_DATA);
 
                 if (finishCallback)
                 {
@@ -1017,6 +1464,7 @@ Hotline::MessageParser CursorUpdateRequest::CreateParserWithCallback (
         READ_VALUES_COUNT,
         READ_COLUMN_ID,
         READ_DATA_TYPE,
+        READ_DATA_SIZE,
         READ_DATA
     };
 
@@ -1044,8 +1492,8 @@ Hotline::MessageParser CursorUpdateRequest::CreateParserWithCallback (
             case READ_CURSOR_ID:
             READ_POD (result->cursorId_);
                 REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
-                    result->values_, valuesRead, READ_VALUES_COUNT, READ_COLUMN_ID, READ_DATA_TYPE, READ_DATA,
-                    CreateParserWithCallback_AllValuesRead, CreateParserWithCallback_ReadNextColumnId);
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_COLUMN_ID, READ_DATA_TYPE, READ_DATA_SIZE,
+                    READ_DATA, CreateParserWithCallback_AllValuesRead, CreateParserWithCallback_ReadNextColumnId);
 
                 if (finishCallback)
                 {
@@ -1141,4 +1589,916 @@ void AddTableRequest::Write (Message messageType, Hotline::SocketSession *sessio
     MAP_POD_VECTOR_WRITE(tableName_);
     END_WRITE_MAPPING;
 }
+
+Hotline::MessageParser BeginTransactionRequest::CreateParserWithCallback (
+    std::function <void (BeginTransactionRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_TABLES_COUNT,
+        READ_TABLES
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+        result (BeginTransactionRequest {})]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result.queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result.queryId_);
+                REQUEST_AND_READ_POD_VECTOR(result.tables_, READ_TABLES_COUNT,
+                                            READ_TABLES, BeginTransactionRequest_TABLES_READ_SKIP_LABEL);
+
+                if (finishCallback)
+                {
+                    finishCallback (result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void BeginTransactionRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_VECTOR_WRITE(tables_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser AggregateRequest::CreateParserWithCallback (
+    std::function <void (AggregateRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_TABLE_ID,
+        READ_INDEX_ID,
+        READ_HAS_LOWER_BOUND,
+        READ_HAS_UPPER_BOUND,
+        READ_GROUP_COLUMNS_COUNT,
+        READ_GROUP_COLUMNS,
+        READ_AGGREGATES_COUNT,
+        READ_AGGREGATES,
+        READ_NODES_COUNT,
+        READ_NODES,
+        READ_VALUES_COUNT,
+        READ_VALUE_NODE_INDEX,
+        READ_VALUE_DATA_TYPE,
+        READ_VALUE_DATA_SIZE,
+        READ_VALUE_DATA,
+        READ_LOWER_BOUND_COUNT,
+        READ_LOWER_BOUND_COLUMN_ID,
+        READ_LOWER_BOUND_DATA_TYPE,
+        READ_LOWER_BOUND_DATA_SIZE,
+        READ_LOWER_BOUND_DATA,
+        READ_UPPER_BOUND_COUNT,
+        READ_UPPER_BOUND_COLUMN_ID,
+        READ_UPPER_BOUND_DATA_TYPE,
+        READ_UPPER_BOUND_DATA_SIZE,
+        READ_UPPER_BOUND_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <AggregateRequest> ()),
+        valuesRead (std::size_t (0u)),
+        lowerBoundRead (std::size_t (0u)),
+        upperBoundRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->tableId_);
+
+            case READ_TABLE_ID:
+            READ_POD (result->tableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->indexId_);
+
+            case READ_INDEX_ID:
+            READ_POD (result->indexId_);
+                NEXT_STEP;
+                REQUEST_POD (result->hasLowerBound_);
+
+            case READ_HAS_LOWER_BOUND:
+            READ_POD (result->hasLowerBound_);
+                NEXT_STEP;
+                REQUEST_POD (result->hasUpperBound_);
+
+            case READ_HAS_UPPER_BOUND:
+            READ_POD (result->hasUpperBound_);
+                REQUEST_AND_READ_POD_VECTOR(result->groupColumns_, READ_GROUP_COLUMNS_COUNT,
+                                            READ_GROUP_COLUMNS, AggregateRequest_GROUP_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->aggregates_, READ_AGGREGATES_COUNT,
+                                            READ_AGGREGATES, AggregateRequest_AGGREGATES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->nodes_, READ_NODES_COUNT,
+                                            READ_NODES, AggregateRequest_NODES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_VALUE_NODE_INDEX, READ_VALUE_DATA_TYPE,
+                    READ_VALUE_DATA_SIZE, READ_VALUE_DATA, AggregateRequest_AllValuesRead,
+                    AggregateRequest_ReadNextNodeIndex);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->lowerBound_, lowerBoundRead, READ_LOWER_BOUND_COUNT, READ_LOWER_BOUND_COLUMN_ID,
+                    READ_LOWER_BOUND_DATA_TYPE, READ_LOWER_BOUND_DATA_SIZE, READ_LOWER_BOUND_DATA,
+                    AggregateRequest_AllLowerBoundRead, AggregateRequest_ReadNextLowerBoundColumnId);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->upperBound_, upperBoundRead, READ_UPPER_BOUND_COUNT, READ_UPPER_BOUND_COLUMN_ID,
+                    READ_UPPER_BOUND_DATA_TYPE, READ_UPPER_BOUND_DATA_SIZE, READ_UPPER_BOUND_DATA,
+                    AggregateRequest_AllUpperBoundRead, AggregateRequest_ReadNextUpperBoundColumnId);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void AggregateRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(tableId_);
+    MAP_POD_WRITE(indexId_);
+    MAP_POD_WRITE(hasLowerBound_);
+    MAP_POD_WRITE(hasUpperBound_);
+    MAP_POD_VECTOR_WRITE(groupColumns_);
+    MAP_POD_VECTOR_WRITE(aggregates_);
+    MAP_POD_VECTOR_WRITE(nodes_);
+    MAP_TABLE_VALUES_WRITE(values_);
+    MAP_TABLE_VALUES_WRITE(lowerBound_);
+    MAP_TABLE_VALUES_WRITE(upperBound_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser AggregateResponse::CreateParserWithCallback (
+    std::function <void (AggregateResponse &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_GROUPS_COUNT,
+        READ_GROUP_COLUMNS_COUNT,
+        READ_GROUP_COLUMNS,
+        READ_RESULTS_COUNT,
+        READ_RESULTS,
+        READ_KEYS_COUNT,
+        READ_KEY_INDEX,
+        READ_KEY_DATA_TYPE,
+        READ_KEY_DATA_SIZE,
+        READ_KEY_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <AggregateResponse> ()),
+        keysRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->groupsCount_);
+
+            case READ_GROUPS_COUNT:
+            READ_POD (result->groupsCount_);
+                REQUEST_AND_READ_POD_VECTOR(result->groupColumns_, READ_GROUP_COLUMNS_COUNT,
+                                            READ_GROUP_COLUMNS, AggregateResponse_GROUP_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->results_, READ_RESULTS_COUNT,
+                                            READ_RESULTS, AggregateResponse_RESULTS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->keys_, keysRead, READ_KEYS_COUNT, READ_KEY_INDEX, READ_KEY_DATA_TYPE, READ_KEY_DATA_SIZE,
+                    READ_KEY_DATA, AggregateResponse_AllKeysRead, AggregateResponse_ReadNextKeyIndex);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void AggregateResponse::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(groupsCount_);
+    MAP_POD_VECTOR_WRITE(groupColumns_);
+    MAP_POD_VECTOR_WRITE(results_);
+    MAP_TABLE_VALUES_WRITE(keys_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser TableStatisticsResponse::CreateParserWithCallback (
+    std::function <void (TableStatisticsResponse &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_ROW_COUNT,
+        READ_CHANGES_SINCE_REFRESH,
+        READ_COLUMNS_COUNT,
+        READ_COLUMNS,
+        READ_LIMITS_COUNT,
+        READ_LIMIT_INDEX,
+        READ_LIMIT_DATA_TYPE,
+        READ_LIMIT_DATA_SIZE,
+        READ_LIMIT_DATA,
+        READ_BOUNDS_COUNT,
+        READ_BOUND_INDEX,
+        READ_BOUND_DATA_TYPE,
+        READ_BOUND_DATA_SIZE,
+        READ_BOUND_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <TableStatisticsResponse> ()),
+        limitsRead (std::size_t (0u)),
+        boundsRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->rowCount_);
+
+            case READ_ROW_COUNT:
+            READ_POD (result->rowCount_);
+                NEXT_STEP;
+                REQUEST_POD (result->changesSinceRefresh_);
+
+            case READ_CHANGES_SINCE_REFRESH:
+            READ_POD (result->changesSinceRefresh_);
+                REQUEST_AND_READ_POD_VECTOR(result->columns_, READ_COLUMNS_COUNT,
+                                            READ_COLUMNS, TableStatisticsResponse_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->limits_, limitsRead, READ_LIMITS_COUNT, READ_LIMIT_INDEX, READ_LIMIT_DATA_TYPE,
+                    READ_LIMIT_DATA_SIZE, READ_LIMIT_DATA, TableStatisticsResponse_AllLimitsRead,
+                    TableStatisticsResponse_ReadNextLimitIndex);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->histogramBounds_, boundsRead, READ_BOUNDS_COUNT, READ_BOUND_INDEX, READ_BOUND_DATA_TYPE,
+                    READ_BOUND_DATA_SIZE, READ_BOUND_DATA, TableStatisticsResponse_AllBoundsRead,
+                    TableStatisticsResponse_ReadNextBoundIndex);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void TableStatisticsResponse::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(rowCount_);
+    MAP_POD_WRITE(changesSinceRefresh_);
+    MAP_POD_VECTOR_WRITE(columns_);
+    MAP_TABLE_VALUES_WRITE(limits_);
+    MAP_TABLE_VALUES_WRITE(histogramBounds_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser ExecuteQueryRequest::CreateParserWithCallback (
+    std::function <void (ExecuteQueryRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_TABLE_ID,
+        READ_INDEX_ID,
+        READ_HAS_LOWER_BOUND,
+        READ_HAS_UPPER_BOUND,
+        READ_PROJECTION_COUNT,
+        READ_PROJECTION,
+        READ_GROUP_COLUMNS_COUNT,
+        READ_GROUP_COLUMNS,
+        READ_AGGREGATES_COUNT,
+        READ_AGGREGATES,
+        READ_ORDER_COUNT,
+        READ_ORDER,
+        READ_OFFSET,
+        READ_LIMIT,
+        READ_NODES_COUNT,
+        READ_NODES,
+        READ_VALUES_COUNT,
+        READ_VALUE_NODE_INDEX,
+        READ_VALUE_DATA_TYPE,
+        READ_VALUE_DATA_SIZE,
+        READ_VALUE_DATA,
+        READ_LOWER_BOUND_COUNT,
+        READ_LOWER_BOUND_COLUMN_ID,
+        READ_LOWER_BOUND_DATA_TYPE,
+        READ_LOWER_BOUND_DATA_SIZE,
+        READ_LOWER_BOUND_DATA,
+        READ_UPPER_BOUND_COUNT,
+        READ_UPPER_BOUND_COLUMN_ID,
+        READ_UPPER_BOUND_DATA_TYPE,
+        READ_UPPER_BOUND_DATA_SIZE,
+        READ_UPPER_BOUND_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <ExecuteQueryRequest> ()),
+        valuesRead (std::size_t (0u)),
+        lowerBoundRead (std::size_t (0u)),
+        upperBoundRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->tableId_);
+
+            case READ_TABLE_ID:
+            READ_POD (result->tableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->indexId_);
+
+            case READ_INDEX_ID:
+            READ_POD (result->indexId_);
+                NEXT_STEP;
+                REQUEST_POD (result->hasLowerBound_);
+
+            case READ_HAS_LOWER_BOUND:
+            READ_POD (result->hasLowerBound_);
+                NEXT_STEP;
+                REQUEST_POD (result->hasUpperBound_);
+
+            case READ_HAS_UPPER_BOUND:
+            READ_POD (result->hasUpperBound_);
+                REQUEST_AND_READ_POD_VECTOR(result->projection_, READ_PROJECTION_COUNT,
+                                            READ_PROJECTION, ExecuteQueryRequest_PROJECTION_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->groupColumns_, READ_GROUP_COLUMNS_COUNT,
+                                            READ_GROUP_COLUMNS, ExecuteQueryRequest_GROUP_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->aggregates_, READ_AGGREGATES_COUNT,
+                                            READ_AGGREGATES, ExecuteQueryRequest_AGGREGATES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->order_, READ_ORDER_COUNT,
+                                            READ_ORDER, ExecuteQueryRequest_ORDER_READ_SKIP_LABEL);
+                NEXT_STEP;
+                REQUEST_POD (result->offset_);
+
+            case READ_OFFSET:
+            READ_POD (result->offset_);
+                NEXT_STEP;
+                REQUEST_POD (result->limit_);
+
+            case READ_LIMIT:
+            READ_POD (result->limit_);
+                REQUEST_AND_READ_POD_VECTOR(result->nodes_, READ_NODES_COUNT,
+                                            READ_NODES, ExecuteQueryRequest_NODES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_VALUE_NODE_INDEX, READ_VALUE_DATA_TYPE,
+                    READ_VALUE_DATA_SIZE, READ_VALUE_DATA, ExecuteQueryRequest_AllValuesRead,
+                    ExecuteQueryRequest_ReadNextNodeIndex);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->lowerBound_, lowerBoundRead, READ_LOWER_BOUND_COUNT, READ_LOWER_BOUND_COLUMN_ID,
+                    READ_LOWER_BOUND_DATA_TYPE, READ_LOWER_BOUND_DATA_SIZE, READ_LOWER_BOUND_DATA,
+                    ExecuteQueryRequest_AllLowerBoundRead, ExecuteQueryRequest_ReadNextLowerBoundColumnId);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->upperBound_, upperBoundRead, READ_UPPER_BOUND_COUNT, READ_UPPER_BOUND_COLUMN_ID,
+                    READ_UPPER_BOUND_DATA_TYPE, READ_UPPER_BOUND_DATA_SIZE, READ_UPPER_BOUND_DATA,
+                    ExecuteQueryRequest_AllUpperBoundRead, ExecuteQueryRequest_ReadNextUpperBoundColumnId);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void ExecuteQueryRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(tableId_);
+    MAP_POD_WRITE(indexId_);
+    MAP_POD_WRITE(hasLowerBound_);
+    MAP_POD_WRITE(hasUpperBound_);
+    MAP_POD_VECTOR_WRITE(projection_);
+    MAP_POD_VECTOR_WRITE(groupColumns_);
+    MAP_POD_VECTOR_WRITE(aggregates_);
+    MAP_POD_VECTOR_WRITE(order_);
+    MAP_POD_WRITE(offset_);
+    MAP_POD_WRITE(limit_);
+    MAP_POD_VECTOR_WRITE(nodes_);
+    MAP_TABLE_VALUES_WRITE(values_);
+    MAP_TABLE_VALUES_WRITE(lowerBound_);
+    MAP_TABLE_VALUES_WRITE(upperBound_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser QueryResultResponse::CreateParserWithCallback (
+    std::function <void (QueryResultResponse &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_IS_LAST,
+        READ_COLUMNS_COUNT,
+        READ_ROWS_COUNT,
+        READ_VALUES_COUNT,
+        READ_VALUE_INDEX,
+        READ_VALUE_DATA_TYPE,
+        READ_VALUE_DATA_SIZE,
+        READ_VALUE_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <QueryResultResponse> ()),
+        valuesRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->isLast_);
+
+            case READ_IS_LAST:
+            READ_POD (result->isLast_);
+                NEXT_STEP;
+                REQUEST_POD (result->columnsCount_);
+
+            case READ_COLUMNS_COUNT:
+            READ_POD (result->columnsCount_);
+                NEXT_STEP;
+                REQUEST_POD (result->rowsCount_);
+
+            case READ_ROWS_COUNT:
+            READ_POD (result->rowsCount_);
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_VALUE_INDEX, READ_VALUE_DATA_TYPE,
+                    READ_VALUE_DATA_SIZE, READ_VALUE_DATA, QueryResultResponse_AllValuesRead,
+                    QueryResultResponse_ReadNextValueIndex);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void QueryResultResponse::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(isLast_);
+    MAP_POD_WRITE(columnsCount_);
+    MAP_POD_WRITE(rowsCount_);
+    MAP_TABLE_VALUES_WRITE(values_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser JoinRequest::CreateParserWithCallback (
+    std::function <void (JoinRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_LEFT_TABLE_ID,
+        READ_RIGHT_TABLE_ID,
+        READ_LIMIT,
+        READ_LEFT_KEY_COLUMNS_COUNT,
+        READ_LEFT_KEY_COLUMNS,
+        READ_RIGHT_KEY_COLUMNS_COUNT,
+        READ_RIGHT_KEY_COLUMNS,
+        READ_LEFT_PROJECTION_COUNT,
+        READ_LEFT_PROJECTION,
+        READ_RIGHT_PROJECTION_COUNT,
+        READ_RIGHT_PROJECTION,
+        READ_LEFT_NODES_COUNT,
+        READ_LEFT_NODES,
+        READ_RIGHT_NODES_COUNT,
+        READ_RIGHT_NODES,
+        READ_LEFT_VALUES_COUNT,
+        READ_LEFT_VALUE_NODE_INDEX,
+        READ_LEFT_VALUE_DATA_TYPE,
+        READ_LEFT_VALUE_DATA_SIZE,
+        READ_LEFT_VALUE_DATA,
+        READ_RIGHT_VALUES_COUNT,
+        READ_RIGHT_VALUE_NODE_INDEX,
+        READ_RIGHT_VALUE_DATA_TYPE,
+        READ_RIGHT_VALUE_DATA_SIZE,
+        READ_RIGHT_VALUE_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <JoinRequest> ()),
+        leftValuesRead (std::size_t (0u)),
+        rightValuesRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->leftTableId_);
+
+            case READ_LEFT_TABLE_ID:
+            READ_POD (result->leftTableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->rightTableId_);
+
+            case READ_RIGHT_TABLE_ID:
+            READ_POD (result->rightTableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->limit_);
+
+            case READ_LIMIT:
+            READ_POD (result->limit_);
+                REQUEST_AND_READ_POD_VECTOR(result->leftKeyColumns_, READ_LEFT_KEY_COLUMNS_COUNT,
+                                            READ_LEFT_KEY_COLUMNS, JoinRequest_LEFT_KEY_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->rightKeyColumns_, READ_RIGHT_KEY_COLUMNS_COUNT,
+                                            READ_RIGHT_KEY_COLUMNS, JoinRequest_RIGHT_KEY_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->leftProjection_, READ_LEFT_PROJECTION_COUNT,
+                                            READ_LEFT_PROJECTION, JoinRequest_LEFT_PROJECTION_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->rightProjection_, READ_RIGHT_PROJECTION_COUNT,
+                                            READ_RIGHT_PROJECTION, JoinRequest_RIGHT_PROJECTION_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->leftNodes_, READ_LEFT_NODES_COUNT,
+                                            READ_LEFT_NODES, JoinRequest_LEFT_NODES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_POD_VECTOR(result->rightNodes_, READ_RIGHT_NODES_COUNT,
+                                            READ_RIGHT_NODES, JoinRequest_RIGHT_NODES_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->leftValues_, leftValuesRead, READ_LEFT_VALUES_COUNT, READ_LEFT_VALUE_NODE_INDEX,
+                    READ_LEFT_VALUE_DATA_TYPE, READ_LEFT_VALUE_DATA_SIZE, READ_LEFT_VALUE_DATA,
+                    JoinRequest_AllLeftValuesRead, JoinRequest_ReadNextLeftNodeIndex);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->rightValues_, rightValuesRead, READ_RIGHT_VALUES_COUNT, READ_RIGHT_VALUE_NODE_INDEX,
+                    READ_RIGHT_VALUE_DATA_TYPE, READ_RIGHT_VALUE_DATA_SIZE, READ_RIGHT_VALUE_DATA,
+                    JoinRequest_AllRightValuesRead, JoinRequest_ReadNextRightNodeIndex);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void JoinRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(leftTableId_);
+    MAP_POD_WRITE(rightTableId_);
+    MAP_POD_WRITE(limit_);
+    MAP_POD_VECTOR_WRITE(leftKeyColumns_);
+    MAP_POD_VECTOR_WRITE(rightKeyColumns_);
+    MAP_POD_VECTOR_WRITE(leftProjection_);
+    MAP_POD_VECTOR_WRITE(rightProjection_);
+    MAP_POD_VECTOR_WRITE(leftNodes_);
+    MAP_POD_VECTOR_WRITE(rightNodes_);
+    MAP_TABLE_VALUES_WRITE(leftValues_);
+    MAP_TABLE_VALUES_WRITE(rightValues_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser BackupRequest::CreateParserWithCallback (
+    std::function <void (BackupRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_PATH_SIZE,
+        READ_PATH_CONTENT
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+        result (BackupRequest {})]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result.queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result.queryId_);
+                REQUEST_AND_READ_POD_VECTOR(result.path_, READ_PATH_SIZE,
+                                            READ_PATH_CONTENT, BackupRequest_PATH_READ_SKIP_LABEL);
+
+                if (finishCallback)
+                {
+                    finishCallback (result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void BackupRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_VECTOR_WRITE(path_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser AddRowsRequest::CreateParserWithCallback (
+    std::function <void (AddRowsRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_TABLE_ID,
+        READ_ROWS_COUNT,
+        READ_COLUMNS_COUNT,
+        READ_COLUMNS,
+        READ_VALUES_COUNT,
+        READ_VALUE_INDEX,
+        READ_VALUE_DATA_TYPE,
+        READ_VALUE_DATA_SIZE,
+        READ_VALUE_DATA
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+
+        // TODO: Adhok, because AnyDataContainer is not copyable.
+        result (std::make_shared <AddRowsRequest> ()),
+        valuesRead (std::size_t (0u))]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result->queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result->queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result->tableId_);
+
+            case READ_TABLE_ID:
+            READ_POD (result->tableId_);
+                NEXT_STEP;
+                REQUEST_POD (result->rowsCount_);
+
+            case READ_ROWS_COUNT:
+            READ_POD (result->rowsCount_);
+                REQUEST_AND_READ_POD_VECTOR(result->columns_, READ_COLUMNS_COUNT,
+                                            READ_COLUMNS, AddRowsRequest_COLUMNS_READ_SKIP_LABEL);
+
+                REQUEST_AND_READ_TABLE_MAPPED_VALUE_VECTOR(
+                    result->values_, valuesRead, READ_VALUES_COUNT, READ_VALUE_INDEX, READ_VALUE_DATA_TYPE,
+                    READ_VALUE_DATA_SIZE, READ_VALUE_DATA, AddRowsRequest_AllValuesRead,
+                    AddRowsRequest_ReadNextValueIndex);
+
+                if (finishCallback)
+                {
+                    finishCallback (*result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void AddRowsRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(tableId_);
+    MAP_POD_WRITE(rowsCount_);
+    MAP_POD_VECTOR_WRITE(columns_);
+    MAP_TABLE_VALUES_WRITE(values_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser ReplicationPullRequest::CreateParserWithCallback (
+    std::function <void (ReplicationPullRequest &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    return CREATE_POD_PARSER(ReplicationPullRequest);
+}
+
+void ReplicationPullRequest::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    Utils::WritePODMessage (this, messageType, session);
+}
+
+Hotline::MessageParser ReplicationBatchResponse::CreateParserWithCallback (
+    std::function <void (ReplicationBatchResponse &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    enum Step : uint8_t
+    {
+        START = 0,
+        READ_QUERY_ID,
+        READ_LAST_SEQUENCE,
+        READ_MUTATIONS_SIZE,
+        READ_MUTATIONS_CONTENT
+    };
+
+    return [finishCallback (std::move (callback)),
+        step (Step::START),
+        result (ReplicationBatchResponse {})]
+
+        (const std::vector <uint8_t> &chunk,
+         Hotline::SocketSession *session) mutable -> Hotline::MessageParserStatus
+    {
+        switch (step)
+        {
+            case START:
+                NEXT_STEP;
+                REQUEST_POD (result.queryId_);
+
+            case READ_QUERY_ID:
+            READ_POD (result.queryId_);
+                NEXT_STEP;
+                REQUEST_POD (result.lastSequence_);
+
+            case READ_LAST_SEQUENCE:
+            READ_POD (result.lastSequence_);
+                REQUEST_AND_READ_POD_VECTOR(result.mutations_, READ_MUTATIONS_SIZE,
+                                            READ_MUTATIONS_CONTENT, ReplicationBatchResponse_DATA_READ_SKIP_LABEL);
+
+                if (finishCallback)
+                {
+                    finishCallback (result, session);
+                }
+
+                return {0, true};
+
+            CATCH_UNKNOWN_STEP;
+        }
+    };
+}
+
+void ReplicationBatchResponse::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    START_WRITE_MAPPING;
+    MAP_POD_WRITE(queryId_);
+    MAP_POD_WRITE(lastSequence_);
+    MAP_POD_VECTOR_WRITE(mutations_);
+    END_WRITE_MAPPING;
+}
+
+Hotline::MessageParser ReplicationStatusResponse::CreateParserWithCallback (
+    std::function <void (ReplicationStatusResponse &, Hotline::SocketSession *)> &&callback)
+{
+    assert (callback);
+    return CREATE_POD_PARSER(ReplicationStatusResponse);
+}
+
+void ReplicationStatusResponse::Write (Message messageType, Hotline::SocketSession *session) const
+{
+    Utils::WritePODMessage (this, messageType, session);
 }
+}
\ No newline at end of file
@@ -4,7 +4,10 @@
 
 #include <Miami/Hotline/Message.hpp>
 
+#include <Miami/Richard/Aggregation.hpp>
 #include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Index.hpp>
+#include <Miami/Richard/Predicate.hpp>
 
 #include <Miami/Hotline/SocketSession.hpp>
 
@@ -84,6 +87,52 @@ enum class Message
     ADD_TABLE_REQUEST, // -> CREATE_OPERATION_RESULT_RESPONSE ||
     //                       VOID_OPERATION_RESULT_RESPONSE
     REMOVE_TABLE_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+
+    CREATE_SNAPSHOT_CURSOR_REQUEST, // -> CREATE_OPERATION_RESULT_RESPONSE ||
+    //                                    VOID_OPERATION_RESULT_RESPONSE
+
+    BEGIN_TRANSACTION_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+    COMMIT_TRANSACTION_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+    ROLLBACK_TRANSACTION_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+
+    CREATE_LOOKUP_READ_CURSOR_REQUEST, // -> CREATE_OPERATION_RESULT_RESPONSE ||
+    //                                       VOID_OPERATION_RESULT_RESPONSE
+    CREATE_LOOKUP_EDIT_CURSOR_REQUEST, // -> CREATE_OPERATION_RESULT_RESPONSE ||
+    //                                       VOID_OPERATION_RESULT_RESPONSE
+
+    CREATE_FILTERED_READ_CURSOR_REQUEST, // -> CREATE_OPERATION_RESULT_RESPONSE ||
+    //                                         VOID_OPERATION_RESULT_RESPONSE
+    CREATE_FILTERED_EDIT_CURSOR_REQUEST, // -> CREATE_OPERATION_RESULT_RESPONSE ||
+    //                                         VOID_OPERATION_RESULT_RESPONSE
+
+    AGGREGATE_REQUEST, // -> AGGREGATE_RESPONSE ||
+    //                        VOID_OPERATION_RESULT_RESPONSE
+    AGGREGATE_RESPONSE,
+
+    GET_TABLE_STATISTICS_REQUEST, // -> GET_TABLE_STATISTICS_RESPONSE ||
+    //                                  VOID_OPERATION_RESULT_RESPONSE
+    GET_TABLE_STATISTICS_RESPONSE,
+
+    EXECUTE_QUERY_REQUEST, // -> QUERY_RESULT_RESPONSE* ||
+    //                             VOID_OPERATION_RESULT_RESPONSE
+    QUERY_RESULT_RESPONSE,
+
+    JOIN_REQUEST, // -> QUERY_RESULT_RESPONSE* ||
+    //                    VOID_OPERATION_RESULT_RESPONSE
+
+    BACKUP_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+
+    ADD_ROWS_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+
+    REPLICATION_PULL_REQUEST, // -> REPLICATION_BATCH_RESPONSE ||
+    //                              VOID_OPERATION_RESULT_RESPONSE
+    REPLICATION_BATCH_RESPONSE,
+
+    REPLICATION_STATUS_REQUEST, // -> REPLICATION_STATUS_RESPONSE
+    REPLICATION_STATUS_RESPONSE,
+
+    GET_TABLE_EDIT_ACCESS_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
+    CLOSE_TABLE_EDIT_ACCESS_REQUEST, // -> VOID_OPERATION_RESULT_RESPONSE
 };
 
 const char *GetMessageName (Message message);
@@ -121,7 +170,42 @@ enum class OperationResult
     INDEX_REMOVAL_BLOCKED_BY_DEPENDANT_CURSORS,
     TABLE_REMOVAL_BLOCKED,
     NEW_COLUMN_VALUE_TYPE_MISMATCH,
-    DUPLICATE_COLUMN_VALUES_IN_INSERTION_REQUEST
+    DUPLICATE_COLUMN_VALUES_IN_INSERTION_REQUEST,
+    TRANSACTION_ALREADY_STARTED,
+    TRANSACTION_NOT_STARTED,
+    TABLE_ACCESS_OWNED_BY_TRANSACTION,
+    TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE,
+    TRANSACTION_TABLES_MUST_BE_UNIQUE,
+    TABLE_IS_NOT_COVERED_BY_TRANSACTION,
+    INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION,
+    LOOKUP_KEY_COLUMN_IS_NOT_INDEXED,
+    LOOKUP_KEY_VALUE_TYPE_MISMATCH,
+    UNIQUE_INDEX_CONSTRAINT_VIOLATED,
+    PREDICATE_IS_MALFORMED,
+    PREDICATE_VALUE_TYPE_MISMATCH,
+    COLUMN_MAX_SIZE_IS_TOO_BIG,
+    NEW_COLUMN_VALUE_IS_TOO_BIG,
+    DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE,
+    COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE,
+    AGGREGATE_FUNCTION_IS_UNKNOWN,
+    AGGREGATE_COLUMN_MUST_BE_INTEGER,
+    INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX,
+    QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN,
+    QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE,
+    JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN,
+    JOIN_KEY_COLUMNS_COUNT_MISMATCH,
+    JOIN_KEY_COLUMN_TYPES_MISMATCH,
+    BACKUP_MUST_COVER_ALL_TABLES,
+    BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL,
+    BACKUP_FILE_WRITE_FAILED,
+    ROWS_BATCH_IS_MALFORMED,
+    SERVER_IS_READ_ONLY_REPLICA,
+    REPLICATION_IS_NOT_ENABLED,
+    REPLICATION_SEQUENCE_IS_AHEAD,
+    REPLICATION_RESYNC_IS_NEEDED,
+    TABLE_EDIT_ACCESS_REQUIRED,
+    TABLE_WRITE_OR_EDIT_ACCESS_REQUIRED,
+    ALREADY_HAS_EDIT_ACCESS
 };
 
 const char *GetOperationResultName (OperationResult operationResult);
@@ -145,10 +229,13 @@ static_assert (std::is_pod_v <VoidOperationResultResponse>);
 /// - GET_TABLE_WRITE_ACCESS_REQUEST.
 /// - CLOSE_TABLE_READ_ACCESS_REQUEST.
 /// - CLOSE_TABLE_WRITE_ACCESS_REQUEST.
+/// - GET_TABLE_EDIT_ACCESS_REQUEST.
+/// - CLOSE_TABLE_EDIT_ACCESS_REQUEST.
 /// - GET_TABLE_NAME_REQUEST.
 /// - GET_COLUMNS_IDS_REQUEST.
 /// - GET_INDICES_IDS_REQUEST.
 /// - REMOVE_TABLE_REQUEST.
+/// - GET_TABLE_STATISTICS_REQUEST.
 struct TableOperationRequest
 {
     static Hotline::MessageParser CreateParserWithCallback (
@@ -181,6 +268,7 @@ struct GetTableNameResponse
 /// - CREATE_EDIT_CURSOR_REQUEST.
 /// - REMOVE_COLUMN_REQUEST.
 /// - REMOVE_INDEX_REQUEST.
+/// - CREATE_SNAPSHOT_CURSOR_REQUEST.
 struct TablePartOperationRequest
 {
     static Hotline::MessageParser CreateParserWithCallback (
@@ -228,6 +316,9 @@ struct ColumnInfoResponse
 
     QueryId queryId_;
     Richard::DataType dataType_;
+    uint32_t maxSize_;
+    bool dictionaryEncoded_;
+    bool compressed_;
     std::string name_;
 
     void Write (Message messageType, Hotline::SocketSession *session) const;
@@ -240,8 +331,11 @@ struct IndexInfoResponse
         std::function <void (IndexInfoResponse &, Hotline::SocketSession *)> &&callback);
 
     QueryId queryId_;
+    Richard::IndexType type_;
+    bool unique_;
     std::string name_;
     std::vector <ResourceId> columns_;
+    std::vector <ResourceId> includedColumns_;
 
     void Write (Message messageType, Hotline::SocketSession *session) const;
 };
@@ -268,6 +362,9 @@ struct AddColumnRequest
     QueryId queryId_;
     ResourceId tableId_;
     Richard::DataType dataType_;
+    uint32_t maxSize_;
+    bool dictionaryEncoded_;
+    bool compressed_;
     std::string name_;
 
     void Write (Message messageType, Hotline::SocketSession *session) const;
@@ -281,8 +378,11 @@ struct AddIndexRequest
 
     QueryId queryId_;
     ResourceId tableId_;
+    Richard::IndexType type_;
+    bool unique_;
     std::string name_;
     std::vector <ResourceId> columns_;
+    std::vector <ResourceId> includedColumns_;
 
     void Write (Message messageType, Hotline::SocketSession *session) const;
 };
@@ -300,6 +400,50 @@ struct AddRowRequest
     void Write (Message messageType, Hotline::SocketSession *session) const;
 };
 
+/// For messages:
+/// - CREATE_LOOKUP_READ_CURSOR_REQUEST.
+/// - CREATE_LOOKUP_EDIT_CURSOR_REQUEST.
+struct CreateLookupCursorRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (CreateLookupCursorRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    ResourceId tableId_;
+    ResourceId indexId_;
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> values_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// Predicate node without value: values are sent separately, because they are not POD.
+struct PredicateNodeHeader
+{
+    Richard::PredicateOperation operation_;
+    ResourceId columnId_;
+};
+
+/// For messages:
+/// - CREATE_FILTERED_READ_CURSOR_REQUEST.
+/// - CREATE_FILTERED_EDIT_CURSOR_REQUEST.
+struct CreateFilteredCursorRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (CreateFilteredCursorRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    ResourceId tableId_;
+    ResourceId indexId_;
+
+    /// Predicate nodes in postfix notation.
+    std::vector <PredicateNodeHeader> nodes_;
+
+    /// Values of comparison nodes, mapped by node indices.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> values_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
 /// For message CURSOR_ADVANCE_REQUEST.
 struct CursorAdvanceRequest
 {
@@ -369,6 +513,9 @@ struct CursorVoidActionRequest
 /// - CLOSE_CONDUIT_READ_ACCESS_REQUEST.
 /// - CLOSE_CONDUIT_WRITE_ACCESS_REQUEST.
 /// - GET_TABLE_IDS_REQUEST.
+/// - COMMIT_TRANSACTION_REQUEST.
+/// - ROLLBACK_TRANSACTION_REQUEST.
+/// - REPLICATION_STATUS_REQUEST.
 struct ConduitVoidActionRequest
 {
     static Hotline::MessageParser CreateParserWithCallback (
@@ -391,5 +538,287 @@ struct AddTableRequest
     void Write (Message messageType, Hotline::SocketSession *session) const;
 };
 
-// TODO: Add message, that allows to capture multiple read/write guards.
+/// For message BEGIN_TRANSACTION_REQUEST. Write guards of all given tables are captured at once.
+struct BeginTransactionRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (BeginTransactionRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    std::vector <ResourceId> tables_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// Aggregate description for aggregation request.
+struct AggregateHeader
+{
+    Richard::AggregateFunction function_;
+    ResourceId columnId_;
+};
+
+/// For message AGGREGATE_REQUEST.
+struct AggregateRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (AggregateRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    ResourceId tableId_;
+
+    /// Used only if request has at least one bound.
+    ResourceId indexId_;
+    bool hasLowerBound_;
+    bool hasUpperBound_;
+
+    std::vector <ResourceId> groupColumns_;
+    std::vector <AggregateHeader> aggregates_;
+
+    /// Predicate nodes in postfix notation, request without nodes aggregates all rows.
+    std::vector <PredicateNodeHeader> nodes_;
+
+    /// Values of comparison nodes, mapped by node indices.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> values_;
+
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> lowerBound_;
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> upperBound_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// Aggregate value and count of aggregated values, see Richard::AggregateResult.
+struct AggregateResultValue
+{
+    uint64_t count_;
+    int64_t value_;
+};
+
+/// For message AGGREGATE_RESPONSE.
+struct AggregateResponse
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (AggregateResponse &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    uint64_t groupsCount_;
+    std::vector <ResourceId> groupColumns_;
+
+    /// Results of all aggregates of first group, then results of second group and so on.
+    std::vector <AggregateResultValue> results_;
+
+    /// Non null values of group columns, mapped by group index multiplied by
+    /// group columns count plus index of column in group columns list.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> keys_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// Exact and estimated counters of one column, see Richard::ColumnStatistics.
+struct ColumnStatisticsHeader
+{
+    ResourceId columnId_;
+    uint64_t nullCount_;
+    uint64_t distinctCount_;
+    uint64_t histogramDepth_;
+    uint64_t histogramBoundsCount_;
+};
+
+/// For message GET_TABLE_STATISTICS_RESPONSE.
+struct TableStatisticsResponse
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (TableStatisticsResponse &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    uint64_t rowCount_;
+    uint64_t changesSinceRefresh_;
+    std::vector <ColumnStatisticsHeader> columns_;
+
+    /// Minimum and maximum of column, mapped by column index multiplied by two, plus one for maximum.
+    /// Absent for columns without values.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> limits_;
+
+    /// Histogram bounds of all columns one after another, mapped by column index.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> histogramBounds_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// Sort key of query output, see Richard::QueryOrder.
+struct QueryOrderHeader
+{
+    uint32_t outputColumn_;
+    bool descending_;
+};
+
+/// For message EXECUTE_QUERY_REQUEST, see Richard::QueryPlan.
+struct ExecuteQueryRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (ExecuteQueryRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    ResourceId tableId_;
+
+    /// Used only if request has at least one bound.
+    ResourceId indexId_;
+    bool hasLowerBound_;
+    bool hasUpperBound_;
+
+    /// Used only if there are no group columns and aggregates.
+    std::vector <ResourceId> projection_;
+    std::vector <ResourceId> groupColumns_;
+    std::vector <AggregateHeader> aggregates_;
+    std::vector <QueryOrderHeader> order_;
+
+    uint64_t offset_;
+    uint64_t limit_;
+
+    /// Predicate nodes in postfix notation, request without nodes selects all rows.
+    std::vector <PredicateNodeHeader> nodes_;
+
+    /// Values of comparison nodes, mapped by node indices.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> values_;
+
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> lowerBound_;
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> upperBound_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// For message QUERY_RESULT_RESPONSE. Query output is streamed in several responses,
+/// last response of query is marked by ::isLast_ and could contain no rows.
+struct QueryResultResponse
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (QueryResultResponse &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    bool isLast_;
+    uint64_t columnsCount_;
+    uint64_t rowsCount_;
+
+    /// Non null output values, mapped by row index multiplied by columns count plus column index.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> values_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// For message JOIN_REQUEST, see Richard::JoinPlan. Session must not have access to joined tables,
+/// because their read guards are captured together by the join itself. Output is sent like query output.
+struct JoinRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (JoinRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    ResourceId leftTableId_;
+    ResourceId rightTableId_;
+    uint64_t limit_;
+
+    std::vector <ResourceId> leftKeyColumns_;
+    std::vector <ResourceId> rightKeyColumns_;
+    std::vector <ResourceId> leftProjection_;
+    std::vector <ResourceId> rightProjection_;
+
+    /// Predicates of inputs in postfix notation, input without nodes is not filtered.
+    std::vector <PredicateNodeHeader> leftNodes_;
+    std::vector <PredicateNodeHeader> rightNodes_;
+
+    /// Values of comparison nodes, mapped by node indices.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> leftValues_;
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> rightValues_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// For message BACKUP_REQUEST. Session must have conduit access and must not have access to any table, because
+/// read guards of all tables are captured together to create consistent image. Path is resolved by server.
+struct BackupRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (BackupRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    std::string path_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// For message ADD_ROWS_REQUEST. Inserts batch of rows, that share the same column list, under one table guard.
+/// Insertion stops at the first failed row, rows before it stay inserted unless table is covered by transaction.
+struct AddRowsRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (AddRowsRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    ResourceId tableId_;
+    uint64_t rowsCount_;
+    std::vector <ResourceId> columns_;
+
+    /// Non null values, mapped by row index multiplied by columns count plus column index in ascending order.
+    std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> values_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+/// For message REPLICATION_PULL_REQUEST. Sent by replica server to primary one. Requests mutations, that follow
+/// given sequence, see Richard::MutationLog::Read. Primary answers with empty batch if replica is up to date and
+/// with REPLICATION_RESYNC_IS_NEEDED if requested mutations were already trimmed from its log.
+struct ReplicationPullRequest
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (ReplicationPullRequest &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    uint64_t afterSequence_;
+    uint64_t maxBatchSize_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+static_assert (std::is_pod_v <ReplicationPullRequest>);
+
+/// For message REPLICATION_BATCH_RESPONSE.
+struct ReplicationBatchResponse
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (ReplicationBatchResponse &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+
+    /// Sequence of the last mutation, logged by primary, when batch was read.
+    uint64_t lastSequence_;
+
+    /// Encoded mutation log records, see Richard::MutationLog::Decode.
+    std::vector <uint8_t> mutations_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+/// For message REPLICATION_STATUS_RESPONSE. Server without replication reports zeros.
+struct ReplicationStatusResponse
+{
+    static Hotline::MessageParser CreateParserWithCallback (
+        std::function <void (ReplicationStatusResponse &, Hotline::SocketSession *)> &&callback);
+
+    QueryId queryId_;
+    bool isReplica_;
+
+    /// For replica: primary has already trimmed mutations, that replica has not applied, so replica stopped
+    /// pulling and must be restored from new backup. Its sequences and lag are not updated anymore.
+    bool resyncNeeded_;
+
+    /// For replica: the last primary sequence, that is known to replica.
+    uint64_t lastSequence_;
+    uint64_t appliedSequence_;
+    uint64_t lagMutations_;
+
+    /// Time since the last applied mutation was logged by primary, zero if replica is up to date.
+    uint64_t lagMilliseconds_;
+
+    void Write (Message messageType, Hotline::SocketSession *session) const;
+};
+
+static_assert (std::is_pod_v <ReplicationStatusResponse>);
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 // Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
 #define NOGDI
 
+#include <chrono>
+#include <future>
+
 #include <App/Miami/Server/Context.hpp>
 #include <App/Miami/Server/Processing.hpp>
 
@@ -10,18 +13,108 @@
 
 namespace Miami::App::Server
 {
-Context::Context (uint32_t workerThreads)
+/// Limit of encoded mutations size in one pulled batch.
+static const uint32_t REPLICATION_BATCH_SIZE = 1024u * 1024u;
+
+/// Delay before next pull, if replica has already caught up with primary.
+static const int64_t REPLICATION_IDLE_DELAY_MS = 10;
+
+/// Delay before next pull or reconnect after replication error.
+static const int64_t REPLICATION_RETRY_DELAY_MS = 1000;
+
+static int64_t GetSteadyMilliseconds ()
+{
+    return std::chrono::duration_cast <std::chrono::milliseconds> (
+        std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+Context::ReplicaState::ReplicaState (Disco::Context *multithreadingContext, Richard::Conduit *conduit)
+    : primaryHost_ (),
+      primaryService_ (),
+      client_ (multithreadingContext),
+      applier_ (conduit),
+      primaryLastSequence_ (0u),
+      awaitingBatch_ (false),
+      applying_ (false),
+      resyncNeeded_ (false),
+      nextAttemptTime_ (0),
+      nextQueryId_ (0u)
+{
+}
+
+Context::Context (uint32_t workerThreads, bool keepMutationLog, std::size_t maxMutationLogSize)
     : alive_ (true),
       multithreadingContext_ (workerThreads),
-      databaseConduit_ (&multithreadingContext_),
-      socketServer_ (&multithreadingContext_)
+      mutationLog_ (keepMutationLog ? new Richard::MutationLog (maxMutationLogSize) : nullptr),
+      databaseConduit_ (&multithreadingContext_, mutationLog_.get ()),
+      socketServer_ (&multithreadingContext_),
+      replica_ (),
+      replication_ ()
 {
+    replication_.mutationLog_ = mutationLog_.get ();
     Evan::Logger::Get ().Log (
         Evan::LogLevel::INFO,
         "Server context initialized with " + std::to_string (workerThreads) + " worker threads.");
     RegisterMessages ();
 }
 
+ResultCode Context::Restore (const std::string &path)
+{
+    std::promise <Richard::ResultCode> promise;
+    Disco::After (
+        &databaseConduit_.ReadWriteGuard ().Write (),
+        [this, &path, &promise] (auto guard)
+        {
+            promise.set_value (databaseConduit_.RestoreBackup (guard, path, &multithreadingContext_));
+        });
+
+    Richard::ResultCode result = promise.get_future ().get ();
+    if (result != Richard::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Caught Richard error during backup \"" + path + "\" restore " +
+                                   std::to_string (static_cast <uint32_t> (result)) + "!");
+        return ResultCode::UNABLE_TO_RESTORE_BACKUP;
+    }
+
+    Evan::Logger::Get ().Log (Evan::LogLevel::INFO, "Restored tables from backup \"" + path + "\".");
+    return ResultCode::OK;
+}
+
+ResultCode Context::FollowPrimary (const std::string &host, const std::string &service)
+{
+    if (mutationLog_ || replica_)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Server is already primary or replica, therefore it can not follow " + host + ":" +
+                                   service + "!");
+        assert (false);
+        return ResultCode::UNABLE_TO_CONNECT_TO_PRIMARY;
+    }
+
+    replica_ = std::make_unique <ReplicaState> (&multithreadingContext_, &databaseConduit_);
+    replica_->primaryHost_ = host;
+    replica_->primaryService_ = service;
+
+    Hotline::ResultCode socketResult = replica_->client_.Start (host, service);
+    if (socketResult != Hotline::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Caught Hotline error during connection to primary " + host + ":" + service + " " +
+                                   std::to_string (static_cast <uint32_t> (socketResult)) + "!");
+        replica_.reset ();
+        return ResultCode::UNABLE_TO_CONNECT_TO_PRIMARY;
+    }
+
+    replication_.applier_ = &replica_->applier_;
+    replication_.primaryLastSequence_ = &replica_->primaryLastSequence_;
+    replication_.resyncNeeded_ = &replica_->resyncNeeded_;
+    RegisterReplicaMessages ();
+
+    Evan::Logger::Get ().Log (Evan::LogLevel::INFO, "Following primary " + host + ":" + service + ".");
+    return ResultCode::OK;
+}
+
 ResultCode Context::Execute (uint16_t port)
 {
     Hotline::ResultCode socketResult = socketServer_.Start (port, false);
@@ -46,6 +139,11 @@ ResultCode Context::Execute (uint16_t port)
                                        std::to_string (static_cast <uint32_t> (socketResult)) + "!");
             alive_ = false;
         }
+
+        if (replica_)
+        {
+            StepReplica ();
+        }
     }
 
     Evan::Logger::Get ().Log (
@@ -78,7 +176,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetTableReadAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -97,7 +195,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetTableWriteAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -116,7 +214,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCloseTableReadAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -135,7 +233,45 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCloseTableWriteAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::GET_TABLE_EDIT_ACCESS_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::TableOperationRequest::CreateParserWithCallback (
+                [this] (const Messaging::TableOperationRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " edit access request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessGetTableEditAccessRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::CLOSE_TABLE_EDIT_ACCESS_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::TableOperationRequest::CreateParserWithCallback (
+                [this] (const Messaging::TableOperationRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " edit access close request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCloseTableEditAccessRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -154,7 +290,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetTableNameRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -173,7 +309,7 @@ void Context::RegisterMessages ()
                         " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCreateReadCursorRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -192,7 +328,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetColumnsIdsRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -211,7 +347,7 @@ void Context::RegisterMessages ()
                         " info request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetColumnInfoRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -230,7 +366,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetIndicesIdsRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -249,7 +385,7 @@ void Context::RegisterMessages ()
                         " info request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetIndexInfoRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -268,7 +404,7 @@ void Context::RegisterMessages ()
                         "\" request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessSetTableNameRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -287,7 +423,7 @@ void Context::RegisterMessages ()
                         " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCreateEditCursorRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -307,7 +443,7 @@ void Context::RegisterMessages ()
                         " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessAddColumnRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -327,7 +463,7 @@ void Context::RegisterMessages ()
                         ".");
 
                     ProcessRemoveColumnRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -347,7 +483,7 @@ void Context::RegisterMessages ()
                         "\" request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessAddIndexRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -367,7 +503,7 @@ void Context::RegisterMessages ()
                         ".");
 
                     ProcessRemoveIndexRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -387,7 +523,26 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessAddRowRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::ADD_ROWS_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::AddRowsRequest::CreateParserWithCallback (
+                [this] (Messaging::AddRowsRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) + " add " +
+                        std::to_string (message.rowsCount_) + " rows request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessAddRowsRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -406,7 +561,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCursorAdvanceRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -425,7 +580,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCursorGetRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -445,7 +600,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCursorUpdateRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -464,7 +619,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCursorDeleteRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -483,7 +638,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCloseCursorRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -501,7 +656,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetConduitReadAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -519,7 +674,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetConduitWriteAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -537,7 +692,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCloseConduitReadAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -555,7 +710,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessCloseConduitWriteAccessRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -573,7 +728,7 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessGetTableIdsRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -591,7 +746,7 @@ void Context::RegisterMessages ()
                         "\" request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessAddTableRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
                 });
         });
 
@@ -610,10 +765,431 @@ void Context::RegisterMessages ()
                         std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
 
                     ProcessRemoveTableRequest (
-                        {&multithreadingContext_, &databaseConduit_, session}, message);
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::CREATE_SNAPSHOT_CURSOR_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::TablePartOperationRequest::CreateParserWithCallback (
+                [this] (const Messaging::TablePartOperationRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " snapshot cursor creation from index " + std::to_string (message.partId_) +
+                        " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCreateSnapshotCursorRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::BEGIN_TRANSACTION_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::BeginTransactionRequest::CreateParserWithCallback (
+                [this] (const Messaging::BeginTransactionRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received transaction begin request for " + std::to_string (message.tables_.size ()) +
+                        " tables from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessBeginTransactionRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::COMMIT_TRANSACTION_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ConduitVoidActionRequest::CreateParserWithCallback (
+                [this] (const Messaging::ConduitVoidActionRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received transaction commit request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCommitTransactionRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::ROLLBACK_TRANSACTION_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ConduitVoidActionRequest::CreateParserWithCallback (
+                [this] (const Messaging::ConduitVoidActionRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received transaction rollback request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessRollbackTransactionRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::CREATE_LOOKUP_READ_CURSOR_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::CreateLookupCursorRequest::CreateParserWithCallback (
+                [this] (Messaging::CreateLookupCursorRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " read lookup cursor creation from index " + std::to_string (message.indexId_) +
+                        " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCreateLookupReadCursorRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::CREATE_LOOKUP_EDIT_CURSOR_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::CreateLookupCursorRequest::CreateParserWithCallback (
+                [this] (Messaging::CreateLookupCursorRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " edit lookup cursor creation from index " + std::to_string (message.indexId_) +
+                        " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCreateLookupEditCursorRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::CREATE_FILTERED_READ_CURSOR_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::CreateFilteredCursorRequest::CreateParserWithCallback (
+                [this] (Messaging::CreateFilteredCursorRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " read filtered cursor creation from index " + std::to_string (message.indexId_) +
+                        " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCreateFilteredReadCursorRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::CREATE_FILTERED_EDIT_CURSOR_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::CreateFilteredCursorRequest::CreateParserWithCallback (
+                [this] (Messaging::CreateFilteredCursorRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " edit filtered cursor creation from index " + std::to_string (message.indexId_) +
+                        " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessCreateFilteredEditCursorRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::AGGREGATE_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::AggregateRequest::CreateParserWithCallback (
+                [this] (Messaging::AggregateRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) + " aggregation request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessAggregateRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::GET_TABLE_STATISTICS_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::TableOperationRequest::CreateParserWithCallback (
+                [this] (const Messaging::TableOperationRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) +
+                        " statistics request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessGetTableStatisticsRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::EXECUTE_QUERY_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ExecuteQueryRequest::CreateParserWithCallback (
+                [this] (Messaging::ExecuteQueryRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received table " + std::to_string (message.tableId_) + " query request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessExecuteQueryRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::JOIN_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::JoinRequest::CreateParserWithCallback (
+                [this] (Messaging::JoinRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received tables " + std::to_string (message.leftTableId_) + " and " +
+                        std::to_string (message.rightTableId_) + " join request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessJoinRequest ({&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::BACKUP_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::BackupRequest::CreateParserWithCallback (
+                [this] (Messaging::BackupRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received backup to \"" + message.path_ + "\" request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessBackupRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::REPLICATION_PULL_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ReplicationPullRequest::CreateParserWithCallback (
+                [this] (const Messaging::ReplicationPullRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received replication pull after " + std::to_string (message.afterSequence_) +
+                        " request from session " + std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessReplicationPullRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = socketServer_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::REPLICATION_STATUS_REQUEST),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ConduitVoidActionRequest::CreateParserWithCallback (
+                [this] (const Messaging::ConduitVoidActionRequest &message, Hotline::SocketSession *session)
+                {
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::VERBOSE,
+                        "Received replication status request from session " +
+                        std::to_string (reinterpret_cast <ptrdiff_t> (session)) + ".");
+
+                    ProcessReplicationStatusRequest (
+                        {&multithreadingContext_, &databaseConduit_, session, &replication_}, message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+}
+
+void Context::RegisterReplicaMessages ()
+{
+    Hotline::ResultCode result;
+    result = replica_->client_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::REPLICATION_BATCH_RESPONSE),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::ReplicationBatchResponse::CreateParserWithCallback (
+                [this] (Messaging::ReplicationBatchResponse &message, Hotline::SocketSession *)
+                {
+                    OnReplicationBatch (message);
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+    result = replica_->client_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (Messaging::Message::VOID_OPERATION_RESULT_RESPONSE),
+        [this] () -> Hotline::MessageParser
+        {
+            return Messaging::VoidOperationResultResponse::CreateParserWithCallback (
+                [this] (const Messaging::VoidOperationResultResponse &message, Hotline::SocketSession *)
+                {
+                    // Trimmed mutations will never be sent again, so retries are useless.
+                    if (message.result_ == Messaging::OperationResult::REPLICATION_RESYNC_IS_NEEDED)
+                    {
+                        if (!replica_->resyncNeeded_.exchange (true))
+                        {
+                            Evan::Logger::Get ().Log (
+                                Evan::LogLevel::ERROR,
+                                "Primary has trimmed mutations, that are not applied by replica yet! Replication "
+                                "is stopped, replica must be restored from new backup of primary.");
+                        }
+
+                        replica_->awaitingBatch_ = false;
+                        return;
+                    }
+
+                    Evan::Logger::Get ().Log (
+                        Evan::LogLevel::ERROR,
+                        std::string ("Primary rejected replication pull: ") +
+                        Messaging::GetOperationResultName (message.result_) + "!");
+
+                    replica_->nextAttemptTime_ = GetSteadyMilliseconds () + REPLICATION_RETRY_DELAY_MS;
+                    replica_->awaitingBatch_ = false;
                 });
         });
 
     assert (result == Hotline::ResultCode::OK);
 }
+
+void Context::StepReplica ()
+{
+    Hotline::ResultCode socketResult = replica_->client_.CoreContext ().DoStep ();
+    if (socketResult != Hotline::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Caught Hotline error during replica client step " +
+                                   std::to_string (static_cast <uint32_t> (socketResult)) + "!");
+    }
+
+    if (replica_->resyncNeeded_)
+    {
+        return;
+    }
+
+    int64_t now = GetSteadyMilliseconds ();
+    Hotline::SocketSession *session = replica_->client_.GetSession ();
+
+    if (!session)
+    {
+        // Pull request, sent through lost connection, will never be answered.
+        replica_->awaitingBatch_ = false;
+        if (now < replica_->nextAttemptTime_)
+        {
+            return;
+        }
+
+        socketResult = replica_->client_.Start (replica_->primaryHost_, replica_->primaryService_);
+        if (socketResult != Hotline::ResultCode::OK)
+        {
+            replica_->nextAttemptTime_ = now + REPLICATION_RETRY_DELAY_MS;
+            return;
+        }
+
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::INFO,
+            "Reconnected to primary " + replica_->primaryHost_ + ":" + replica_->primaryService_ + ".");
+        session = replica_->client_.GetSession ();
+    }
+
+    if (replica_->awaitingBatch_ || replica_->applying_ || now < replica_->nextAttemptTime_)
+    {
+        return;
+    }
+
+    replica_->awaitingBatch_ = true;
+    Messaging::ReplicationPullRequest {
+        replica_->nextQueryId_++, replica_->applier_.GetAppliedSequence (), REPLICATION_BATCH_SIZE}.Write (
+        Messaging::Message::REPLICATION_PULL_REQUEST, session);
+}
+
+void Context::OnReplicationBatch (Messaging::ReplicationBatchResponse &message)
+{
+    std::vector <Richard::Mutation> mutations;
+    Richard::ResultCode result = Richard::MutationLog::Decode (message.mutations_, mutations);
+    replica_->primaryLastSequence_ = message.lastSequence_;
+
+    if (result != Richard::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Caught Richard error during replication batch decoding " +
+                                   std::to_string (static_cast <uint32_t> (result)) + "!");
+
+        replica_->nextAttemptTime_ = GetSteadyMilliseconds () + REPLICATION_RETRY_DELAY_MS;
+        replica_->awaitingBatch_ = false;
+        return;
+    }
+
+    if (mutations.empty ())
+    {
+        replica_->nextAttemptTime_ = GetSteadyMilliseconds () + REPLICATION_IDLE_DELAY_MS;
+        replica_->awaitingBatch_ = false;
+        return;
+    }
+
+    // Flags are changed in this order, so step never sees both of them cleared before batch is applied.
+    replica_->applying_ = true;
+    replica_->awaitingBatch_ = false;
+
+    replica_->applier_.Apply (
+        mutations,
+        [this] (Richard::ResultCode applyResult)
+        {
+            if (applyResult != Richard::ResultCode::OK)
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR, "Caught Richard error during replication batch apply " +
+                                           std::to_string (static_cast <uint32_t> (applyResult)) + "!");
+                replica_->nextAttemptTime_ = GetSteadyMilliseconds () + REPLICATION_RETRY_DELAY_MS;
+            }
+
+            replica_->applying_ = false;
+        });
+}
 }
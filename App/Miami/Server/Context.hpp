@@ -1,38 +1,89 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <string>
 
 #include <Miami/Annotations.hpp>
 
 #include <Miami/Disco/Context.hpp>
 
 #include <Miami/Richard/Conduit.hpp>
+#include <Miami/Richard/Replication.hpp>
 
+#include <Miami/Hotline/SocketClient.hpp>
 #include <Miami/Hotline/SocketServer.hpp>
 
+#include <App/Miami/Server/Processing.hpp>
+
 namespace Miami::App::Server
 {
 enum class ResultCode
 {
     OK = 0,
     UNABLE_TO_START_SOCKET_SERVER,
+    UNABLE_TO_RESTORE_BACKUP,
+    UNABLE_TO_CONNECT_TO_PRIMARY,
 };
 
 class Context final
 {
 public:
-    explicit Context (uint32_t workerThreads);
+    /// If mutation log is kept, server acts as primary: replicas could pull its changes since start. Log records
+    /// are trimmed after their total size exceeds given limit, even if some replicas have not applied them yet.
+    explicit Context (uint32_t workerThreads, bool keepMutationLog = false,
+                      std::size_t maxMutationLogSize = Richard::MutationLog::DEFAULT_MAX_RECORDS_SIZE);
+
+    /// Loads tables from backup file, written by BACKUP_REQUEST. Must be called before ::Execute.
+    free_call ResultCode Restore (const std::string &path);
+
+    /// Makes server read only replica of given primary. Replica must be restored from the same backup, from which
+    /// primary was started. Must be called before ::Execute.
+    free_call ResultCode FollowPrimary (const std::string &host, const std::string &service);
 
     free_call ResultCode Execute (uint16_t port);
 
     void RequestAbort ();
 
 private:
+    /// Connection to primary and state of mutations pulling. Only one batch is pulled or applied at once.
+    struct ReplicaState
+    {
+        explicit ReplicaState (Disco::Context *multithreadingContext, Richard::Conduit *conduit);
+
+        std::string primaryHost_;
+        std::string primaryService_;
+        Hotline::SocketClient client_;
+        Richard::MutationApplier applier_;
+
+        std::atomic <uint64_t> primaryLastSequence_;
+        std::atomic <bool> awaitingBatch_;
+        std::atomic <bool> applying_;
+
+        /// Set when primary has trimmed mutations, that are not applied yet. Pulling is stopped forever then.
+        std::atomic <bool> resyncNeeded_;
+
+        /// Milliseconds of steady clock, before which next pull or reconnect is not attempted.
+        std::atomic <int64_t> nextAttemptTime_;
+        uint64_t nextQueryId_;
+    };
+
     void RegisterMessages ();
 
+    void RegisterReplicaMessages ();
+
+    /// Called on every server step. Reconnects to primary and sends next pull request, if it is time to do it.
+    void StepReplica ();
+
+    void OnReplicationBatch (Messaging::ReplicationBatchResponse &message);
+
     std::atomic <bool> alive_;
     Disco::Context multithreadingContext_;
+    std::unique_ptr <Richard::MutationLog> mutationLog_;
     Richard::Conduit databaseConduit_;
     Hotline::SocketServer socketServer_;
+
+    std::unique_ptr <ReplicaState> replica_;
+    ReplicationContext replication_;
 };
 }
@@ -27,6 +27,14 @@ struct CommandLineArguments
     uint16_t port_;
     uint32_t workerThreads_;
     std::string logFileName_;
+    std::string backupFileName_;
+
+    /// Primary keeps mutation log, so replicas could follow it.
+    bool primary_;
+
+    /// Primary address for replica, empty otherwise.
+    std::string primaryHost_;
+    std::string primaryService_;
 };
 
 static std::unique_ptr<Miami::App::Server::Context> serverContext = nullptr;
@@ -53,8 +61,24 @@ int main (int argc, char **argv)
         Exit (ExitCode::UNABLE_TO_SETUP_LOGGING);
     }
 
-    serverContext = std::make_unique<Miami::App::Server::Context>(arguments.workerThreads_);
-    Miami::App::Server::ResultCode result = serverContext->Execute(arguments.port_);
+    serverContext = std::make_unique<Miami::App::Server::Context>(arguments.workerThreads_, arguments.primary_);
+    Miami::App::Server::ResultCode result = Miami::App::Server::ResultCode::OK;
+
+    if (!arguments.backupFileName_.empty ())
+    {
+        result = serverContext->Restore (arguments.backupFileName_);
+    }
+
+    if (result == Miami::App::Server::ResultCode::OK && !arguments.primaryHost_.empty ())
+    {
+        result = serverContext->FollowPrimary (arguments.primaryHost_, arguments.primaryService_);
+    }
+
+    if (result == Miami::App::Server::ResultCode::OK)
+    {
+        result = serverContext->Execute (arguments.port_);
+    }
+
     serverContext.reset();
 
     if (result == Miami::App::Server::ResultCode::OK)
@@ -78,9 +102,10 @@ void ProcessSignal (int signal)
 
 bool ParseCommandLineArguments (int argc, char **argv, CommandLineArguments &output)
 {
-    if (argc != 4)
+    if (argc < 4)
     {
-        printf ("Expected command line: <executable> <server_port> <worker_threads> <log_file_name>");
+        printf ("Expected command line: <executable> <server_port> <worker_threads> <log_file_name> "
+                "[<backup_file_name>] [--primary | --replica-of <primary_host>:<primary_port>]");
         return false;
     }
     else
@@ -102,6 +127,49 @@ bool ParseCommandLineArguments (int argc, char **argv, CommandLineArguments &out
         output.port_ = static_cast<uint16_t>(port);
         output.workerThreads_ = static_cast<uint32_t>(workerThreads);
         output.logFileName_ = argv[3];
+        output.backupFileName_ = "";
+        output.primary_ = false;
+        output.primaryHost_ = "";
+        output.primaryService_ = "";
+
+        for (int index = 4; index < argc; ++index)
+        {
+            std::string argument = argv[index];
+            if (argument == "--primary")
+            {
+                output.primary_ = true;
+            }
+            else if (argument == "--replica-of")
+            {
+                std::string address = index + 1 < argc ? argv[++index] : "";
+                std::size_t separator = address.rfind (':');
+
+                if (separator == std::string::npos || separator == 0u || separator + 1u == address.size ())
+                {
+                    printf ("Primary address must be given as <primary_host>:<primary_port>!");
+                    return false;
+                }
+
+                output.primaryHost_ = address.substr (0u, separator);
+                output.primaryService_ = address.substr (separator + 1u);
+            }
+            else if (output.backupFileName_.empty () && argument.rfind ("--", 0u) != 0u)
+            {
+                output.backupFileName_ = argument;
+            }
+            else
+            {
+                printf ("Unexpected command line argument \"%s\"!", argument.c_str ());
+                return false;
+            }
+        }
+
+        if (output.primary_ && !output.primaryHost_.empty ())
+        {
+            printf ("Server can not be primary and replica at once!");
+            return false;
+        }
+
         return true;
     }
 }
@@ -1,12 +1,16 @@
 // Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
 #define NOGDI
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 
 #include <App/Miami/Server/Processing.hpp>
 
 #include <Miami/Evan/Logger.hpp>
 
+#include <Miami/Richard/Join.hpp>
+
 namespace Miami::App::Server
 {
 using namespace Messaging;
@@ -116,11 +120,101 @@ OperationResult MapDatabaseResultToOperationResult (Richard::ResultCode result)
         case Richard::ResultCode::NEW_COLUMN_VALUE_TYPE_MISMATCH:
             return OperationResult::NEW_COLUMN_VALUE_TYPE_MISMATCH;
 
+        case Richard::ResultCode::TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE:
+            return OperationResult::TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE;
+
+        case Richard::ResultCode::TRANSACTION_TABLES_MUST_BE_UNIQUE:
+            return OperationResult::TRANSACTION_TABLES_MUST_BE_UNIQUE;
+
+        case Richard::ResultCode::TABLE_IS_NOT_COVERED_BY_TRANSACTION:
+            return OperationResult::TABLE_IS_NOT_COVERED_BY_TRANSACTION;
+
+        case Richard::ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION:
+            return OperationResult::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION;
+
+        case Richard::ResultCode::LOOKUP_KEY_COLUMN_IS_NOT_INDEXED:
+            return OperationResult::LOOKUP_KEY_COLUMN_IS_NOT_INDEXED;
+
+        case Richard::ResultCode::LOOKUP_KEY_VALUE_TYPE_MISMATCH:
+            return OperationResult::LOOKUP_KEY_VALUE_TYPE_MISMATCH;
+
+        case Richard::ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED:
+            return OperationResult::UNIQUE_INDEX_CONSTRAINT_VIOLATED;
+
+        case Richard::ResultCode::PREDICATE_IS_MALFORMED:
+            return OperationResult::PREDICATE_IS_MALFORMED;
+
+        case Richard::ResultCode::PREDICATE_VALUE_TYPE_MISMATCH:
+            return OperationResult::PREDICATE_VALUE_TYPE_MISMATCH;
+
+        case Richard::ResultCode::COLUMN_MAX_SIZE_IS_TOO_BIG:
+            return OperationResult::COLUMN_MAX_SIZE_IS_TOO_BIG;
+
+        case Richard::ResultCode::NEW_COLUMN_VALUE_IS_TOO_BIG:
+            return OperationResult::NEW_COLUMN_VALUE_IS_TOO_BIG;
+
+        case Richard::ResultCode::DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE:
+            return OperationResult::DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE;
+
+        case Richard::ResultCode::COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE:
+            return OperationResult::COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE;
+
+        case Richard::ResultCode::AGGREGATE_FUNCTION_IS_UNKNOWN:
+            return OperationResult::AGGREGATE_FUNCTION_IS_UNKNOWN;
+
+        case Richard::ResultCode::AGGREGATE_COLUMN_MUST_BE_INTEGER:
+            return OperationResult::AGGREGATE_COLUMN_MUST_BE_INTEGER;
+
+        case Richard::ResultCode::INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX:
+            return OperationResult::INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX;
+
+        case Richard::ResultCode::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN:
+            return OperationResult::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN;
+
+        case Richard::ResultCode::QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE:
+            return OperationResult::QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE;
+
+        case Richard::ResultCode::JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN:
+            return OperationResult::JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN;
+
+        case Richard::ResultCode::JOIN_KEY_COLUMNS_COUNT_MISMATCH:
+            return OperationResult::JOIN_KEY_COLUMNS_COUNT_MISMATCH;
+
+        case Richard::ResultCode::JOIN_KEY_COLUMN_TYPES_MISMATCH:
+            return OperationResult::JOIN_KEY_COLUMN_TYPES_MISMATCH;
+
+        case Richard::ResultCode::BACKUP_MUST_COVER_ALL_TABLES:
+            return OperationResult::BACKUP_MUST_COVER_ALL_TABLES;
+
+        case Richard::ResultCode::BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL:
+            return OperationResult::BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL;
+
+        case Richard::ResultCode::BACKUP_FILE_WRITE_FAILED:
+            return OperationResult::BACKUP_FILE_WRITE_FAILED;
+
+        case Richard::ResultCode::REPLICATION_SEQUENCE_IS_AHEAD:
+            return OperationResult::REPLICATION_SEQUENCE_IS_AHEAD;
+
+        case Richard::ResultCode::REPLICATION_RESYNC_IS_NEEDED:
+            return OperationResult::REPLICATION_RESYNC_IS_NEEDED;
+
         default:
             return OperationResult::INTERNAL_ERROR;
     }
 }
 
+/// Replica changes its data only by applying primary mutations, so every write access is rejected.
+bool EnsureWritableServer (const ProcessingContext &context, QueryId id)
+{
+    if (context.replication_ && context.replication_->applier_)
+    {
+        SendVoidResult (context, id, OperationResult::SERVER_IS_READ_ONLY_REPLICA);
+        return false;
+    }
+
+    return true;
+}
+
 /// SessionExtension::TableAccess without write access flag.
 struct PureTableAccess
 {
@@ -128,65 +222,67 @@ struct PureTableAccess
     Richard::Table *table_;
 };
 
-PureTableAccess GetTableReadOrWriteAccess (const SessionExtension *extension, Richard::AnyDataId id)
+const SessionExtension::TableAccess *FindTableAccess (const SessionExtension *extension, Richard::AnyDataId id)
 {
     if (extension == nullptr)
     {
-        return {nullptr, nullptr};
+        return nullptr;
     }
 
     auto iterator = extension->tableAccesses_.find (id);
     if (iterator == extension->tableAccesses_.end () || !iterator->second.guard_)
     {
-        return {nullptr, nullptr};
+        return nullptr;
     }
     else
     {
-        return {iterator->second.guard_, iterator->second.tableWeakPointer_};
+        return &iterator->second;
     }
 }
 
+/// Any access allows cursor movement and reads through cursor, because cursors were already created
+/// by operations that checked access type.
+PureTableAccess GetTableAnyAccess (const SessionExtension *extension, Richard::AnyDataId id)
+{
+    const SessionExtension::TableAccess *access = FindTableAccess (extension, id);
+    return access ? PureTableAccess {access->guard_, access->tableWeakPointer_} : PureTableAccess {nullptr, nullptr};
+}
+
+PureTableAccess GetTableReadOrWriteAccess (const SessionExtension *extension, Richard::AnyDataId id)
+{
+    const SessionExtension::TableAccess *access = FindTableAccess (extension, id);
+    return access && !access->isEditAccess_ ?
+           PureTableAccess {access->guard_, access->tableWeakPointer_} : PureTableAccess {nullptr, nullptr};
+}
+
 PureTableAccess GetTableWriteAccess (const SessionExtension *extension, Richard::AnyDataId id)
 {
-    // TODO: Rewrite with less duplication.
-    if (extension == nullptr)
-    {
-        return {nullptr, nullptr};
-    }
+    const SessionExtension::TableAccess *access = FindTableAccess (extension, id);
+    return access && access->isWriteAccess_ ?
+           PureTableAccess {access->guard_, access->tableWeakPointer_} : PureTableAccess {nullptr, nullptr};
+}
 
-    auto iterator = extension->tableAccesses_.find (id);
-    if (iterator == extension->tableAccesses_.end () || !iterator->second.isWriteAccess_ || !iterator->second.guard_)
-    {
-        return {nullptr, nullptr};
-    }
-    else
-    {
-        return {iterator->second.guard_, iterator->second.tableWeakPointer_};
-    }
+PureTableAccess GetTableWriteOrEditAccess (const SessionExtension *extension, Richard::AnyDataId id)
+{
+    const SessionExtension::TableAccess *access = FindTableAccess (extension, id);
+    return access && (access->isWriteAccess_ || access->isEditAccess_) ?
+           PureTableAccess {access->guard_, access->tableWeakPointer_} : PureTableAccess {nullptr, nullptr};
 }
 
 bool EnsureNoTableAccess (const ProcessingContext &context, const SessionExtension *extension,
                           QueryId queryId, ResourceId tableId)
 {
+    const SessionExtension::TableAccess *access = FindTableAccess (extension, tableId);
+    if (access == nullptr)
     {
-        PureTableAccess tableWriteAccess = GetTableWriteAccess (extension, tableId);
-        if (tableWriteAccess.guard_ != nullptr)
-        {
-            SendVoidResult (context, queryId, OperationResult::ALREADY_HAS_WRITE_ACCESS);
-            return false;
-        }
-    }
-
-    {
-        PureTableAccess tableReadOrWriteAccess = GetTableWriteAccess (extension, tableId);
-        if (tableReadOrWriteAccess.guard_ != nullptr)
-        {
-            SendVoidResult (context, queryId, OperationResult::ALREADY_HAS_READ_ACCESS);
-            return false;
-        }
+        return true;
     }
 
-    return true;
+    SendVoidResult (context, queryId,
+                    access->isWriteAccess_ ? OperationResult::ALREADY_HAS_WRITE_ACCESS :
+                    access->isEditAccess_ ? OperationResult::ALREADY_HAS_EDIT_ACCESS :
+                    OperationResult::ALREADY_HAS_READ_ACCESS);
+    return false;
 }
 
 bool GetTable (const ProcessingContext &context, const SessionExtension *extension,
@@ -226,6 +322,36 @@ bool EnsureTableWriteAccess (const ProcessingContext &context, const SessionExte
     }
 }
 
+bool EnsureTableWriteOrEditAccess (const ProcessingContext &context, const SessionExtension *extension,
+                                   QueryId queryId, ResourceId tableId, PureTableAccess &tableAccess)
+{
+    tableAccess = GetTableWriteOrEditAccess (extension, tableId);
+    if (tableAccess.guard_ == nullptr)
+    {
+        SendVoidResult (context, queryId, OperationResult::TABLE_WRITE_OR_EDIT_ACCESS_REQUIRED);
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+bool EnsureTableAnyAccess (const ProcessingContext &context, const SessionExtension *extension,
+                           QueryId queryId, ResourceId tableId, PureTableAccess &tableAccess)
+{
+    tableAccess = GetTableAnyAccess (extension, tableId);
+    if (tableAccess.guard_ == nullptr)
+    {
+        SendVoidResult (context, queryId, OperationResult::TABLE_READ_OR_WRITE_ACCESS_REQUIRED);
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
 bool EnsureTableReadOrWriteAccess (const ProcessingContext &context, const SessionExtension *extension,
                                    QueryId queryId, ResourceId tableId, PureTableAccess &tableAccess)
 {
@@ -295,10 +421,129 @@ TransitCursorData <Richard::TableReadCursor> GetReadOrEditCursor (
     }
 }
 
+Richard::TableSnapshotCursor *GetSnapshotCursor (const SessionExtension *extension, ResourceId cursorId)
+{
+    if (!extension)
+    {
+        return nullptr;
+    }
+
+    auto iterator = extension->snapshotCursors_.find (cursorId);
+    return iterator == extension->snapshotCursors_.end () ? nullptr : iterator->second.get ();
+}
+
+/// Changes current row of edit cursor under table edit access. Edit access holds only table intent guard, therefore
+/// lock of cursor current row is captured first. Other writer could move cursor to another row while lock is being
+/// captured: in this case lock of new current row is requested and operation is repeated.
+void ExecuteUnderCurrentRowLock (
+    const ProcessingContext &context, QueryId queryId, ResourceId cursorId,
+    Richard::TableEditCursor *cursor, const PureTableAccess &tableAccess,
+    std::function <Richard::ResultCode (Richard::TableEditCursor *cursor,
+                                        const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                        const std::shared_ptr <Disco::SafeLockGuard> &rowGuard)> operation)
+{
+    assert (context.session_);
+    assert (cursor);
+
+    Disco::Lock *rowLock = nullptr;
+    Richard::ResultCode result = cursor->GetCurrentRowLock (tableAccess.guard_, rowLock);
+
+    if (result != Richard::ResultCode::OK)
+    {
+        SendVoidResult (context, queryId, MapDatabaseResultToOperationResult (result));
+        return;
+    }
+
+    assert (rowLock);
+    Disco::After (
+        {Disco::AnyLockPointer (&context.session_->Data ().ReadWriteGuard ().Read ()),
+         Disco::AnyLockPointer (rowLock)},
+        // Intent guard is captured to keep table and its row locks alive until row lock is captured.
+        [context, queryId, cursorId, intentGuard (tableAccess.guard_), operation] (auto guards)
+        {
+            assert (guards.size () == 2u);
+            const SessionExtension *extension = nullptr;
+
+            if (!ExtractConstSessionExtension (context, queryId, guards[0], extension))
+            {
+                return;
+            }
+
+            // Cursor and table access could be closed while row lock was being captured.
+            TransitCursorData <Richard::TableEditCursor> cursorData = GetEditCursor (context, extension, cursorId);
+            if (!cursorData.cursor_)
+            {
+                SendVoidResult (context, queryId, Messaging::OperationResult::CURSOR_WITH_GIVEN_ID_NOT_FOUND);
+                return;
+            }
+
+            PureTableAccess tableAccess {};
+            if (!EnsureTableWriteOrEditAccess (context, extension, queryId, cursorData.sourceTableId_, tableAccess))
+            {
+                return;
+            }
+
+            Richard::ResultCode result = operation (cursorData.cursor_, tableAccess.guard_, guards[1]);
+            if (result == Richard::ResultCode::ROW_LOCK_DOES_NOT_COVER_CURRENT_ROW)
+            {
+                ExecuteUnderCurrentRowLock (context, queryId, cursorId, cursorData.cursor_, tableAccess, operation);
+            }
+            else
+            {
+                SendVoidResult (context, queryId, MapDatabaseResultToOperationResult (result));
+            }
+        });
+}
+
+bool IsCoveredByTransaction (const SessionExtension *extension, ResourceId tableId)
+{
+    return extension && extension->transaction_ &&
+           extension->transaction_->GetTableWriteGuard (tableId) != nullptr;
+}
+
+/// Finishes transaction by commit or rollback and releases transaction table accesses.
+void FinishTransaction (const ProcessingContext &context, QueryId queryId, bool commit)
+{
+    assert (context.session_);
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        [context, queryId, commit] (auto guard)
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, queryId, guard, extension))
+            {
+                assert (extension);
+                if (!extension->transaction_)
+                {
+                    SendVoidResult (context, queryId, OperationResult::TRANSACTION_NOT_STARTED);
+                    return;
+                }
+
+                Richard::ResultCode result = Richard::ResultCode::OK;
+                if (commit)
+                {
+                    result = extension->transaction_->Commit ();
+                }
+                else
+                {
+                    extension->transaction_->Rollback ();
+                }
+
+                for (Richard::AnyDataId tableId : extension->transaction_->GetTableIds ())
+                {
+                    extension->tableAccesses_.erase (tableId);
+                }
+
+                extension->transaction_.reset ();
+                SendVoidResult (context, queryId, MapDatabaseResultToOperationResult (result));
+            }
+        });
+}
+
 bool UnwrapRowValues (
     const ProcessingContext &context, QueryId queryId,
     std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> &values,
-    std::unordered_map <Richard::AnyDataId, Richard::AnyDataContainer> &valuesMap)
+    Richard::Table::Row &valuesMap)
 {
     for (auto &idValuePair : values)
     {
@@ -316,6 +561,34 @@ bool UnwrapRowValues (
 
     return true;
 }
+
+bool UnwrapPredicate (const ProcessingContext &context, QueryId queryId,
+                      const std::vector <PredicateNodeHeader> &headers,
+                      std::vector <std::pair <ResourceId, Richard::AnyDataContainer>> &values,
+                      Richard::Predicate &output)
+{
+    std::vector <Richard::PredicateNode> nodes;
+    nodes.reserve (headers.size ());
+
+    for (const PredicateNodeHeader &header : headers)
+    {
+        nodes.emplace_back (Richard::PredicateNode {header.operation_, header.columnId_});
+    }
+
+    for (auto &indexValuePair : values)
+    {
+        if (indexValuePair.first >= nodes.size ())
+        {
+            SendVoidResult (context, queryId, Messaging::OperationResult::PREDICATE_IS_MALFORMED);
+            return false;
+        }
+
+        nodes[indexValuePair.first].value_ = std::move (indexValuePair.second);
+    }
+
+    output = Richard::Predicate (std::move (nodes));
+    return true;
+}
 }
 
 // TODO: Use ifs with pointer asserts? Like not only assertb (table), but also with if (table) for steel stability.
@@ -381,6 +654,11 @@ void ProcessGetTableWriteAccessRequest (const ProcessingContext &context,
     using namespace Details;
     assert (context.session_);
 
+    if (!EnsureWritableServer (context, message.queryId_))
+    {
+        return;
+    }
+
     Disco::After (
         &context.session_->Data ().ReadWriteGuard ().Read (),
         [context, request (message)] (auto guard)
@@ -446,7 +724,7 @@ void ProcessCloseTableReadAccessRequest (const ProcessingContext &context,
                 auto iterator = extension->tableAccesses_.find (request.tableId_);
 
                 if (iterator == extension->tableAccesses_.end () ||
-                    (iterator->second.guard_ && iterator->second.isWriteAccess_))
+                    (iterator->second.guard_ && (iterator->second.isWriteAccess_ || iterator->second.isEditAccess_)))
                 {
                     SendVoidResult (context, request.queryId_, OperationResult::TABLE_READ_ACCESS_REQUIRED);
                 }
@@ -480,6 +758,102 @@ void ProcessCloseTableWriteAccessRequest (const ProcessingContext &context,
                 {
                     SendVoidResult (context, request.queryId_, OperationResult::TABLE_WRITE_ACCESS_REQUIRED);
                 }
+                else if (extension->transaction_ &&
+                         extension->transaction_->GetTableWriteGuard (request.tableId_) != nullptr)
+                {
+                    SendVoidResult (context, request.queryId_, OperationResult::TABLE_ACCESS_OWNED_BY_TRANSACTION);
+                }
+                else
+                {
+                    extension->tableAccesses_.erase (iterator);
+                    SendVoidResult (context, request.queryId_, OperationResult::OK);
+                }
+            }
+        });
+}
+
+void ProcessGetTableEditAccessRequest (const ProcessingContext &context,
+                                       const TableOperationRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    if (!EnsureWritableServer (context, message.queryId_))
+    {
+        return;
+    }
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        [context, request (message)] (auto guard)
+        {
+            const SessionExtension *extension = nullptr;
+            if (ExtractConstSessionExtension (context, request.queryId_, guard, extension))
+            {
+                if (!EnsureNoTableAccess (context, extension, request.queryId_, request.tableId_))
+                {
+                    return;
+                }
+
+                if (extension == nullptr || (extension->conduitReadGuard_ == nullptr &&
+                                             extension->conduitWriteGuard_ == nullptr))
+                {
+                    SendVoidResult (context, request.queryId_,
+                                    OperationResult::CONDUIT_READ_OR_WRITE_ACCESS_REQUIRED);
+                }
+                else
+                {
+                    assert (context.databaseConduit_);
+                    Richard::Table *table = nullptr;
+
+                    if (GetTable (context, extension, request.queryId_, request.tableId_, table))
+                    {
+                        assert (table);
+                        // Intent guard is shared with other editing sessions: rows are protected by
+                        // row locks, that are captured for every update or delete separately.
+                        Disco::After (
+                            {Disco::AnyLockPointer (&context.session_->Data ().ReadWriteGuard ().Write ()),
+                             Disco::AnyLockPointer (&table->ReadWriteGuard ().Intent ())},
+                            [context, request, table] (auto guards)
+                            {
+                                assert (guards.size () == 2u);
+                                SessionExtension *extension = nullptr;
+
+                                if (ExtractSessionExtension (context, request.queryId_, guards[0], extension))
+                                {
+                                    assert (extension);
+                                    extension->tableAccesses_[table->GetId ()] =
+                                        {guards[1], table, false, true};
+                                    SendVoidResult (context, request.queryId_, OperationResult::OK);
+                                }
+                            });
+                    }
+                }
+            }
+        });
+}
+
+void ProcessCloseTableEditAccessRequest (const ProcessingContext &context,
+                                         const TableOperationRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        [context, request (message)] (auto guard)
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, request.queryId_, guard, extension))
+            {
+                assert (extension);
+                auto iterator = extension->tableAccesses_.find (request.tableId_);
+
+                if (iterator == extension->tableAccesses_.end () ||
+                    (iterator->second.guard_ && !iterator->second.isEditAccess_))
+                {
+                    SendVoidResult (context, request.queryId_, OperationResult::TABLE_EDIT_ACCESS_REQUIRED);
+                }
                 else
                 {
                     extension->tableAccesses_.erase (iterator);
@@ -643,6 +1017,9 @@ void ProcessGetColumnInfoRequest (const ProcessingContext &context,
                     if (result == Richard::ResultCode::OK)
                     {
                         response.dataType_ = info.dataType_;
+                        response.maxSize_ = info.maxSize_;
+                        response.dictionaryEncoded_ = info.dictionaryEncoded_;
+                        response.compressed_ = info.compressed_;
                         response.name_ = info.name_;
                         response.Write (Messaging::Message::GET_COLUMN_INFO_RESPONSE, context.session_);
                     }
@@ -720,7 +1097,10 @@ void ProcessGetIndexInfoRequest (const ProcessingContext &context,
                     if (result == Richard::ResultCode::OK)
                     {
                         response.name_ = info.name_;
+                        response.type_ = info.type_;
+                        response.unique_ = info.unique_;
                         response.columns_ = info.columns_;
+                        response.includedColumns_ = info.includedColumns_;
                         response.Write (Messaging::Message::GET_INDEX_INFO_RESPONSE, context.session_);
                     }
                     else
@@ -772,7 +1152,7 @@ void ProcessCreateEditCursorRequest (const ProcessingContext &context,
                 assert (extension);
                 PureTableAccess tableAccess {};
 
-                if (EnsureTableWriteAccess (context, extension, request.queryId_, request.tableId_, tableAccess))
+                if (EnsureTableWriteOrEditAccess (context, extension, request.queryId_, request.tableId_, tableAccess))
                 {
                     assert (tableAccess.table_);
                     CreateOperationResultResponse response {};
@@ -828,7 +1208,10 @@ void ProcessAddColumnRequest (const ProcessingContext &context,
                     response.queryId_ = request.queryId_;
 
                     Richard::ResultCode result = tableAccess.table_->AddColumn (
-                        tableAccess.guard_, {0u, request.dataType_, request.name_}, response.resourceId_);
+                        tableAccess.guard_,
+                        {0u, request.dataType_, request.name_, request.maxSize_,
+                         request.dictionaryEncoded_, request.compressed_},
+                        response.resourceId_);
 
                     if (result == Richard::ResultCode::OK)
                     {
@@ -890,7 +1273,9 @@ void ProcessAddIndexRequest (const ProcessingContext &context,
                     response.queryId_ = request.queryId_;
 
                     Richard::ResultCode result = tableAccess.table_->AddIndex (
-                        tableAccess.guard_, {0u, request.name_, request.columns_}, response.resourceId_);
+                        tableAccess.guard_,
+                        {0u, request.name_, request.columns_, request.type_, request.unique_, request.includedColumns_},
+                        response.resourceId_);
 
                     if (result == Richard::ResultCode::OK)
                     {
@@ -945,18 +1330,100 @@ void ProcessAddRowRequest (const ProcessingContext &context, AddRowRequest &mess
             if (ExtractConstSessionExtension (context, request->queryId_, guard, extension))
             {
                 PureTableAccess tableAccess {};
-                if (EnsureTableWriteAccess (context, extension, request->queryId_, request->tableId_, tableAccess))
+                if (EnsureTableWriteOrEditAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
                 {
                     assert (tableAccess.table_);
-                    std::unordered_map <Richard::AnyDataId, Richard::AnyDataContainer> valuesMap;
+                    Richard::Table::Row valuesMap;
 
                     if (UnwrapRowValues (context, request->queryId_, request->values_, valuesMap))
                     {
-                        Richard::ResultCode result = tableAccess.table_->InsertRow (tableAccess.guard_, valuesMap);
-                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
-                    }
-                }
+                        Richard::ResultCode result;
+                        if (IsCoveredByTransaction (extension, request->tableId_))
+                        {
+                            result = extension->transaction_->InsertRow (request->tableId_, valuesMap);
+                        }
+                        else
+                        {
+                            result = tableAccess.table_->InsertRow (tableAccess.guard_, valuesMap);
+                        }
+
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                }
+            }
+        });
+}
+
+void ProcessAddRowsRequest (const ProcessingContext &context, AddRowsRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <AddRowsRequest> (std::move (message)))] (auto guard) mutable
+        {
+            const SessionExtension *extension = nullptr;
+            PureTableAccess tableAccess {};
+
+            if (!ExtractConstSessionExtension (context, request->queryId_, guard, extension) ||
+                !EnsureTableWriteOrEditAccess (context, extension, request->queryId_, request->tableId_, tableAccess))
+            {
+                return;
+            }
+
+            assert (tableAccess.table_);
+            const uint64_t columnsCount = request->columns_.size ();
+
+            for (std::size_t index = 0; index < columnsCount; ++index)
+            {
+                if (std::find (request->columns_.begin () + index + 1, request->columns_.end (),
+                               request->columns_[index]) != request->columns_.end ())
+                {
+                    SendVoidResult (context, request->queryId_,
+                                    OperationResult::DUPLICATE_COLUMN_VALUES_IN_INSERTION_REQUEST);
+                    return;
+                }
+            }
+
+            // Values are checked before insertion, so malformed batch never leaves table partially updated.
+            for (std::size_t index = 0; index < request->values_.size (); ++index)
+            {
+                if (columnsCount == 0u || request->values_[index].first / columnsCount >= request->rowsCount_ ||
+                    (index > 0 && request->values_[index - 1].first >= request->values_[index].first))
+                {
+                    SendVoidResult (context, request->queryId_, OperationResult::ROWS_BATCH_IS_MALFORMED);
+                    return;
+                }
+            }
+
+            const bool transactional = IsCoveredByTransaction (extension, request->tableId_);
+            Richard::ResultCode result = Richard::ResultCode::OK;
+            auto value = request->values_.begin ();
+
+            for (uint64_t row = 0; row < request->rowsCount_ && result == Richard::ResultCode::OK; ++row)
+            {
+                Richard::Table::Row valuesMap;
+                while (value != request->values_.end () && value->first / columnsCount == row)
+                {
+                    valuesMap.emplace (request->columns_[value->first % columnsCount], std::move (value->second));
+                    ++value;
+                }
+
+                if (transactional)
+                {
+                    result = extension->transaction_->InsertRow (request->tableId_, valuesMap);
+                }
+                else
+                {
+                    result = tableAccess.table_->InsertRow (tableAccess.guard_, valuesMap);
+                }
             }
+
+            SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
         });
 }
 
@@ -975,6 +1442,14 @@ void ProcessCursorAdvanceRequest (const ProcessingContext &context,
             const SessionExtension *extension = nullptr;
             if (ExtractConstSessionExtension (context, request.queryId_, guard, extension))
             {
+                Richard::TableSnapshotCursor *snapshotCursor = GetSnapshotCursor (extension, request.cursorId_);
+                if (snapshotCursor)
+                {
+                    Richard::ResultCode result = snapshotCursor->Advance (request.step_);
+                    SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                    return;
+                }
+
                 TransitCursorData <Richard::TableReadCursor> cursorData =
                     GetReadOrEditCursor (context, extension, request.cursorId_);
 
@@ -986,7 +1461,7 @@ void ProcessCursorAdvanceRequest (const ProcessingContext &context,
                 }
 
                 PureTableAccess tableAccess {};
-                if (EnsureTableReadOrWriteAccess (
+                if (EnsureTableAnyAccess (
                     context, extension, request.queryId_, cursorData.sourceTableId_, tableAccess))
                 {
                     Richard::ResultCode result = cursorData.cursor_->Advance (tableAccess.guard_, request.step_);
@@ -1011,6 +1486,31 @@ void ProcessCursorGetRequest (const ProcessingContext &context,
             const SessionExtension *extension = nullptr;
             if (ExtractConstSessionExtension (context, request.queryId_, guard, extension))
             {
+                Richard::TableSnapshotCursor *snapshotCursor = GetSnapshotCursor (extension, request.cursorId_);
+                if (snapshotCursor)
+                {
+                    CursorGetResponse response {};
+                    response.queryId_ = request.queryId_;
+
+                    bool isNull = true;
+                    Richard::ResultCode result = snapshotCursor->Get (request.columnId_, response.value_, isNull);
+
+                    if (result != Richard::ResultCode::OK)
+                    {
+                        SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                    else if (isNull)
+                    {
+                        SendVoidResult (context, request.queryId_, Messaging::OperationResult::NULL_COLUMN_VALUE);
+                    }
+                    else
+                    {
+                        response.Write (Messaging::Message::CURSOR_GET_RESPONSE, context.session_);
+                    }
+
+                    return;
+                }
+
                 TransitCursorData <Richard::TableReadCursor> cursorData =
                     GetReadOrEditCursor (context, extension, request.cursorId_);
 
@@ -1022,7 +1522,7 @@ void ProcessCursorGetRequest (const ProcessingContext &context,
                 }
 
                 PureTableAccess tableAccess {};
-                if (EnsureTableReadOrWriteAccess (
+                if (EnsureTableAnyAccess (
                     context, extension, request.queryId_, cursorData.sourceTableId_, tableAccess))
                 {
                     CursorGetResponse response {};
@@ -1080,15 +1580,39 @@ void ProcessCursorUpdateRequest (const ProcessingContext &context,
                 }
 
                 PureTableAccess tableAccess {};
-                if (EnsureTableWriteAccess (
+                if (EnsureTableWriteOrEditAccess (
                     context, extension, request->queryId_, cursorData.sourceTableId_, tableAccess))
                 {
-                    std::unordered_map <Richard::AnyDataId, Richard::AnyDataContainer> valuesMap;
-                    if (UnwrapRowValues (context, request->queryId_, request->values_, valuesMap))
+                    auto valuesMap = std::make_shared <Richard::Table::Row> ();
+                    if (!UnwrapRowValues (context, request->queryId_, request->values_, *valuesMap))
                     {
-                        Richard::ResultCode result = cursorData.cursor_->Update (tableAccess.guard_, valuesMap);
-                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                        return;
+                    }
+
+                    if (Disco::IsIntentCaptured (tableAccess.guard_, tableAccess.table_->ReadWriteGuard ()))
+                    {
+                        ExecuteUnderCurrentRowLock (
+                            context, request->queryId_, request->cursorId_, cursorData.cursor_, tableAccess,
+                            [valuesMap] (Richard::TableEditCursor *cursor,
+                                         const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                         const std::shared_ptr <Disco::SafeLockGuard> &rowGuard)
+                            {
+                                return cursor->Update (intentGuard, rowGuard, *valuesMap);
+                            });
+                        return;
+                    }
+
+                    Richard::ResultCode result;
+                    if (IsCoveredByTransaction (extension, cursorData.sourceTableId_))
+                    {
+                        result = extension->transaction_->UpdateCurrent (cursorData.cursor_, *valuesMap);
                     }
+                    else
+                    {
+                        result = cursorData.cursor_->Update (tableAccess.guard_, *valuesMap);
+                    }
+
+                    SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
                 }
             }
         });
@@ -1120,10 +1644,32 @@ void ProcessCursorDeleteRequest (const ProcessingContext &context,
                 }
 
                 PureTableAccess tableAccess {};
-                if (EnsureTableWriteAccess (
+                if (EnsureTableWriteOrEditAccess (
                     context, extension, request.queryId_, cursorData.sourceTableId_, tableAccess))
                 {
-                    Richard::ResultCode result = cursorData.cursor_->DeleteCurrent (tableAccess.guard_);
+                    if (Disco::IsIntentCaptured (tableAccess.guard_, tableAccess.table_->ReadWriteGuard ()))
+                    {
+                        ExecuteUnderCurrentRowLock (
+                            context, request.queryId_, request.cursorId_, cursorData.cursor_, tableAccess,
+                            [] (Richard::TableEditCursor *cursor,
+                                const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                const std::shared_ptr <Disco::SafeLockGuard> &rowGuard)
+                            {
+                                return cursor->DeleteCurrent (intentGuard, rowGuard);
+                            });
+                        return;
+                    }
+
+                    Richard::ResultCode result;
+                    if (IsCoveredByTransaction (extension, cursorData.sourceTableId_))
+                    {
+                        result = extension->transaction_->DeleteCurrent (cursorData.cursor_);
+                    }
+                    else
+                    {
+                        result = cursorData.cursor_->DeleteCurrent (tableAccess.guard_);
+                    }
+
                     SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
                 }
             }
@@ -1168,6 +1714,16 @@ void ProcessCloseCursorRequest (const ProcessingContext &context,
                     }
                 }
 
+                {
+                    auto iterator = extension->snapshotCursors_.find (request.cursorId_);
+                    if (iterator != extension->snapshotCursors_.end ())
+                    {
+                        extension->snapshotCursors_.erase (iterator);
+                        SendVoidResult (context, request.queryId_, Messaging::OperationResult::OK);
+                        return;
+                    }
+                }
+
                 SendVoidResult (context, request.queryId_,
                                 Messaging::OperationResult::CURSOR_WITH_GIVEN_ID_NOT_FOUND);
             }
@@ -1224,6 +1780,11 @@ void ProcessGetConduitWriteAccessRequest (const ProcessingContext &context,
     using namespace Details;
     assert (context.session_);
 
+    if (!EnsureWritableServer (context, message.queryId_))
+    {
+        return;
+    }
+
     Disco::After (
         &context.session_->Data ().ReadWriteGuard ().Read (),
         [context, request (message)] (auto guard)
@@ -1438,4 +1999,963 @@ void ProcessRemoveTableRequest (const ProcessingContext &context,
             }
         });
 }
-}
\ No newline at end of file
+
+void ProcessCreateSnapshotCursorRequest (const ProcessingContext &context,
+                                         const TablePartOperationRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        [context, request (message)] (auto guard)
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, request.queryId_, guard, extension))
+            {
+                assert (extension);
+                PureTableAccess tableAccess {};
+
+                if (EnsureTableReadOrWriteAccess (
+                    context, extension, request.queryId_, request.tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    CreateOperationResultResponse response {};
+                    response.queryId_ = request.queryId_;
+
+                    Richard::TableSnapshotCursor *cursor = nullptr;
+                    Richard::ResultCode result = tableAccess.table_->CreateSnapshotCursor (
+                        tableAccess.guard_, request.partId_, cursor);
+
+                    if (result == Richard::ResultCode::OK)
+                    {
+                        assert (cursor);
+                        Richard::AnyDataId cursorId = extension->nextCursorId_++;
+                        auto emplaceResult = extension->snapshotCursors_.emplace (
+                            cursorId, std::unique_ptr <Richard::TableSnapshotCursor> (cursor));
+                        assert (emplaceResult.second);
+
+                        response.resourceId_ = cursorId;
+                        response.Write (Messaging::Message::CREATE_OPERATION_RESULT_RESPONSE,
+                                        context.session_);
+                    }
+                    else
+                    {
+                        SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                }
+            }
+        });
+}
+
+void ProcessBeginTransactionRequest (const ProcessingContext &context,
+                                     const BeginTransactionRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    if (!EnsureWritableServer (context, message.queryId_))
+    {
+        return;
+    }
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        [context, request (message)] (auto guard)
+        {
+            const SessionExtension *extension = nullptr;
+            if (ExtractConstSessionExtension (context, request.queryId_, guard, extension))
+            {
+                if (extension == nullptr || (extension->conduitReadGuard_ == nullptr &&
+                                             extension->conduitWriteGuard_ == nullptr))
+                {
+                    SendVoidResult (context, request.queryId_,
+                                    OperationResult::CONDUIT_READ_OR_WRITE_ACCESS_REQUIRED);
+                    return;
+                }
+
+                if (extension->transaction_)
+                {
+                    SendVoidResult (context, request.queryId_, OperationResult::TRANSACTION_ALREADY_STARTED);
+                    return;
+                }
+
+                for (ResourceId tableId : request.tables_)
+                {
+                    if (!EnsureNoTableAccess (context, extension, request.queryId_, tableId))
+                    {
+                        return;
+                    }
+                }
+
+                assert (context.databaseConduit_);
+                std::vector <Disco::AnyLockPointer> locks
+                    {Disco::AnyLockPointer (&context.session_->Data ().ReadWriteGuard ().Write ())};
+
+                Richard::ResultCode result = context.databaseConduit_->PrepareTransaction (
+                    extension->conduitReadGuard_ == nullptr ?
+                    extension->conduitWriteGuard_ : extension->conduitReadGuard_,
+                    request.tables_, locks);
+
+                if (result != Richard::ResultCode::OK)
+                {
+                    SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                    return;
+                }
+
+                // All table write guards are captured by one lock group, therefore
+                // transactions with intersecting tables are not able to deadlock each other.
+                Disco::After (
+                    locks,
+                    [context, request] (auto guards)
+                    {
+                        assert (guards.size () == request.tables_.size () + 1u);
+                        SessionExtension *extension = nullptr;
+
+                        if (ExtractSessionExtension (context, request.queryId_, guards[0], extension))
+                        {
+                            assert (extension);
+                            if (extension->transaction_)
+                            {
+                                SendVoidResult (context, request.queryId_,
+                                                OperationResult::TRANSACTION_ALREADY_STARTED);
+                                return;
+                            }
+
+                            if (extension->conduitReadGuard_ == nullptr && extension->conduitWriteGuard_ == nullptr)
+                            {
+                                SendVoidResult (context, request.queryId_,
+                                                OperationResult::CONDUIT_READ_OR_WRITE_ACCESS_REQUIRED);
+                                return;
+                            }
+
+                            // Other request of this session could open table access while guards were captured,
+                            // and transaction must not silently replace it.
+                            for (ResourceId tableId : request.tables_)
+                            {
+                                if (!EnsureNoTableAccess (context, extension, request.queryId_, tableId))
+                                {
+                                    return;
+                                }
+                            }
+
+                            std::vector <std::shared_ptr <Disco::SafeLockGuard>> tableGuards (
+                                guards.begin () + 1, guards.end ());
+                            Richard::Transaction *transaction = nullptr;
+
+                            Richard::ResultCode result = context.databaseConduit_->BeginTransaction (
+                                extension->conduitReadGuard_ == nullptr ?
+                                extension->conduitWriteGuard_ : extension->conduitReadGuard_,
+                                request.tables_, tableGuards, transaction);
+
+                            if (result != Richard::ResultCode::OK)
+                            {
+                                SendVoidResult (context, request.queryId_,
+                                                MapDatabaseResultToOperationResult (result));
+                                return;
+                            }
+
+                            assert (transaction);
+                            extension->transaction_.reset (transaction);
+
+                            for (std::size_t index = 0; index < request.tables_.size (); ++index)
+                            {
+                                Richard::Table *table = nullptr;
+                                context.databaseConduit_->GetTable (
+                                    extension->conduitReadGuard_ == nullptr ?
+                                    extension->conduitWriteGuard_ : extension->conduitReadGuard_,
+                                    request.tables_[index], table);
+
+                                assert (table);
+                                extension->tableAccesses_[request.tables_[index]] = {tableGuards[index], table, true};
+                            }
+
+                            SendVoidResult (context, request.queryId_, OperationResult::OK);
+                        }
+                    });
+            }
+        });
+}
+
+void ProcessCommitTransactionRequest (const ProcessingContext &context,
+                                      const ConduitVoidActionRequest &message)
+{
+    Details::FinishTransaction (context, message.queryId_, true);
+}
+
+void ProcessRollbackTransactionRequest (const ProcessingContext &context,
+                                        const ConduitVoidActionRequest &message)
+{
+    Details::FinishTransaction (context, message.queryId_, false);
+}
+
+void ProcessCreateLookupReadCursorRequest (const ProcessingContext &context,
+                                           CreateLookupCursorRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <CreateLookupCursorRequest> (std::move (message)))] (auto guard) mutable
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, request->queryId_, guard, extension))
+            {
+                assert (extension);
+                PureTableAccess tableAccess {};
+
+                if (EnsureTableReadOrWriteAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::Table::Row key;
+
+                    if (!UnwrapRowValues (context, request->queryId_, request->values_, key))
+                    {
+                        return;
+                    }
+
+                    CreateOperationResultResponse response {};
+                    response.queryId_ = request->queryId_;
+
+                    Richard::TableReadCursor *cursor = nullptr;
+                    Richard::ResultCode result = tableAccess.table_->CreateLookupCursor (
+                        tableAccess.guard_, request->indexId_, key, cursor);
+
+                    if (result == Richard::ResultCode::OK)
+                    {
+                        assert (cursor);
+                        Richard::AnyDataId cursorId = extension->nextCursorId_++;
+                        SessionExtension::CursorData <Richard::TableReadCursor> cursorData {};
+                        cursorData.cursor_.reset (cursor);
+                        cursorData.sourceTableId_ = request->tableId_;
+
+                        auto emplaceResult = extension->readCursors_.emplace (cursorId, std::move (cursorData));
+                        assert (emplaceResult.second);
+
+                        response.resourceId_ = cursorId;
+                        response.Write (Messaging::Message::CREATE_OPERATION_RESULT_RESPONSE,
+                                        context.session_);
+                    }
+                    else
+                    {
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                }
+            }
+        });
+}
+
+void ProcessCreateLookupEditCursorRequest (const ProcessingContext &context,
+                                           CreateLookupCursorRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <CreateLookupCursorRequest> (std::move (message)))] (auto guard) mutable
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, request->queryId_, guard, extension))
+            {
+                assert (extension);
+                PureTableAccess tableAccess {};
+
+                if (EnsureTableWriteOrEditAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::Table::Row key;
+
+                    if (!UnwrapRowValues (context, request->queryId_, request->values_, key))
+                    {
+                        return;
+                    }
+
+                    CreateOperationResultResponse response {};
+                    response.queryId_ = request->queryId_;
+
+                    Richard::TableEditCursor *cursor = nullptr;
+                    Richard::ResultCode result = tableAccess.table_->CreateLookupEditCursor (
+                        tableAccess.guard_, request->indexId_, key, cursor);
+
+                    if (result == Richard::ResultCode::OK)
+                    {
+                        assert (cursor);
+                        Richard::AnyDataId cursorId = extension->nextCursorId_++;
+                        SessionExtension::CursorData <Richard::TableEditCursor> cursorData {};
+                        cursorData.cursor_.reset (cursor);
+                        cursorData.sourceTableId_ = request->tableId_;
+
+                        auto emplaceResult = extension->editCursors_.emplace (cursorId, std::move (cursorData));
+                        assert (emplaceResult.second);
+
+                        response.resourceId_ = cursorId;
+                        response.Write (Messaging::Message::CREATE_OPERATION_RESULT_RESPONSE,
+                                        context.session_);
+                    }
+                    else
+                    {
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                }
+            }
+        });
+}
+
+void ProcessCreateFilteredReadCursorRequest (const ProcessingContext &context,
+                                             CreateFilteredCursorRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <CreateFilteredCursorRequest> (std::move (message)))] (auto guard) mutable
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, request->queryId_, guard, extension))
+            {
+                assert (extension);
+                PureTableAccess tableAccess {};
+
+                if (EnsureTableReadOrWriteAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::Predicate predicate;
+                    if (!UnwrapPredicate (context, request->queryId_, request->nodes_, request->values_, predicate))
+                    {
+                        return;
+                    }
+
+                    CreateOperationResultResponse response {};
+                    response.queryId_ = request->queryId_;
+
+                    Richard::TableReadCursor *cursor = nullptr;
+                    Richard::ResultCode result = tableAccess.table_->CreateFilteredReadCursor (
+                        tableAccess.guard_, request->indexId_, predicate, cursor);
+
+                    if (result == Richard::ResultCode::OK)
+                    {
+                        assert (cursor);
+                        Richard::AnyDataId cursorId = extension->nextCursorId_++;
+                        SessionExtension::CursorData <Richard::TableReadCursor> cursorData {};
+                        cursorData.cursor_.reset (cursor);
+                        cursorData.sourceTableId_ = request->tableId_;
+
+                        auto emplaceResult = extension->readCursors_.emplace (cursorId, std::move (cursorData));
+                        assert (emplaceResult.second);
+
+                        response.resourceId_ = cursorId;
+                        response.Write (Messaging::Message::CREATE_OPERATION_RESULT_RESPONSE,
+                                        context.session_);
+                    }
+                    else
+                    {
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                }
+            }
+        });
+}
+
+void ProcessCreateFilteredEditCursorRequest (const ProcessingContext &context,
+                                             CreateFilteredCursorRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <CreateFilteredCursorRequest> (std::move (message)))] (auto guard) mutable
+        {
+            SessionExtension *extension = nullptr;
+            if (ExtractSessionExtension (context, request->queryId_, guard, extension))
+            {
+                assert (extension);
+                PureTableAccess tableAccess {};
+
+                if (EnsureTableWriteOrEditAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::Predicate predicate;
+                    if (!UnwrapPredicate (context, request->queryId_, request->nodes_, request->values_, predicate))
+                    {
+                        return;
+                    }
+
+                    CreateOperationResultResponse response {};
+                    response.queryId_ = request->queryId_;
+
+                    Richard::TableEditCursor *cursor = nullptr;
+                    Richard::ResultCode result = tableAccess.table_->CreateFilteredEditCursor (
+                        tableAccess.guard_, request->indexId_, predicate, cursor);
+
+                    if (result == Richard::ResultCode::OK)
+                    {
+                        assert (cursor);
+                        Richard::AnyDataId cursorId = extension->nextCursorId_++;
+                        SessionExtension::CursorData <Richard::TableEditCursor> cursorData {};
+                        cursorData.cursor_.reset (cursor);
+                        cursorData.sourceTableId_ = request->tableId_;
+
+                        auto emplaceResult = extension->editCursors_.emplace (cursorId, std::move (cursorData));
+                        assert (emplaceResult.second);
+
+                        response.resourceId_ = cursorId;
+                        response.Write (Messaging::Message::CREATE_OPERATION_RESULT_RESPONSE,
+                                        context.session_);
+                    }
+                    else
+                    {
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                    }
+                }
+            }
+        });
+}
+
+void ProcessAggregateRequest (const ProcessingContext &context, AggregateRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <AggregateRequest> (std::move (message)))] (auto guard) mutable
+        {
+            const SessionExtension *extension = nullptr;
+            if (ExtractConstSessionExtension (context, request->queryId_, guard, extension))
+            {
+                PureTableAccess tableAccess {};
+                if (EnsureTableReadOrWriteAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::AggregationQuery query;
+                    query.groupColumns_ = request->groupColumns_;
+                    query.indexId_ = request->indexId_;
+                    query.hasLowerBound_ = request->hasLowerBound_;
+                    query.hasUpperBound_ = request->hasUpperBound_;
+
+                    for (const AggregateHeader &header : request->aggregates_)
+                    {
+                        query.aggregates_.emplace_back (Richard::AggregateInfo {header.function_, header.columnId_});
+                    }
+
+                    if (!UnwrapPredicate (context, request->queryId_, request->nodes_, request->values_,
+                                          query.predicate_) ||
+                        !UnwrapRowValues (context, request->queryId_, request->lowerBound_, query.lowerBound_) ||
+                        !UnwrapRowValues (context, request->queryId_, request->upperBound_, query.upperBound_))
+                    {
+                        return;
+                    }
+
+                    std::vector <Richard::AggregateGroup> groups;
+                    Richard::ResultCode result = tableAccess.table_->Aggregate (tableAccess.guard_, query, groups);
+
+                    if (result != Richard::ResultCode::OK)
+                    {
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                        return;
+                    }
+
+                    AggregateResponse response {};
+                    response.queryId_ = request->queryId_;
+                    response.groupsCount_ = groups.size ();
+                    response.groupColumns_ = request->groupColumns_;
+
+                    for (std::size_t groupIndex = 0; groupIndex < groups.size (); ++groupIndex)
+                    {
+                        Richard::AggregateGroup &group = groups[groupIndex];
+                        for (const Richard::AggregateResult &aggregateResult : group.results_)
+                        {
+                            response.results_.emplace_back (
+                                AggregateResultValue {aggregateResult.count_, aggregateResult.value_});
+                        }
+
+                        for (std::size_t columnIndex = 0; columnIndex < request->groupColumns_.size (); ++columnIndex)
+                        {
+                            auto iterator = group.key_.find (request->groupColumns_[columnIndex]);
+                            if (iterator != group.key_.end ())
+                            {
+                                response.keys_.emplace_back (
+                                    groupIndex * request->groupColumns_.size () + columnIndex,
+                                    std::move (iterator->second));
+                            }
+                        }
+                    }
+
+                    response.Write (Messaging::Message::AGGREGATE_RESPONSE, context.session_);
+                }
+            }
+        });
+}
+
+void ProcessGetTableStatisticsRequest (const ProcessingContext &context, const TableOperationRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        [context, request (message)] (auto guard)
+        {
+            const SessionExtension *extension = nullptr;
+            if (ExtractConstSessionExtension (context, request.queryId_, guard, extension))
+            {
+                PureTableAccess tableAccess {};
+                if (EnsureTableReadOrWriteAccess (
+                    context, extension, request.queryId_, request.tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::TableStatistics statistics;
+                    Richard::ResultCode result = tableAccess.table_->GetStatistics (tableAccess.guard_, statistics);
+
+                    if (result != Richard::ResultCode::OK)
+                    {
+                        SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                        return;
+                    }
+
+                    TableStatisticsResponse response {};
+                    response.queryId_ = request.queryId_;
+                    response.rowCount_ = statistics.rowCount_;
+                    response.changesSinceRefresh_ = statistics.changesSinceRefresh_;
+
+                    for (std::size_t index = 0; index < statistics.columns_.size (); ++index)
+                    {
+                        Richard::ColumnStatistics &column = statistics.columns_[index];
+                        response.columns_.emplace_back (ColumnStatisticsHeader {
+                            column.columnId_, column.nullCount_, column.distinctCount_, column.histogramDepth_,
+                            column.histogramBounds_.size ()});
+
+                        if (column.hasLimits_)
+                        {
+                            response.limits_.emplace_back (index * 2u, std::move (column.min_));
+                            response.limits_.emplace_back (index * 2u + 1u, std::move (column.max_));
+                        }
+
+                        for (Richard::AnyDataContainer &bound : column.histogramBounds_)
+                        {
+                            response.histogramBounds_.emplace_back (index, std::move (bound));
+                        }
+                    }
+
+                    response.Write (Messaging::Message::GET_TABLE_STATISTICS_RESPONSE, context.session_);
+                }
+            }
+        });
+}
+
+void ProcessExecuteQueryRequest (const ProcessingContext &context, ExecuteQueryRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <ExecuteQueryRequest> (std::move (message)))] (auto guard) mutable
+        {
+            const SessionExtension *extension = nullptr;
+            if (ExtractConstSessionExtension (context, request->queryId_, guard, extension))
+            {
+                PureTableAccess tableAccess {};
+                if (EnsureTableReadOrWriteAccess (
+                    context, extension, request->queryId_, request->tableId_, tableAccess))
+                {
+                    assert (tableAccess.table_);
+                    Richard::QueryPlan plan;
+                    plan.indexId_ = request->indexId_;
+                    plan.hasLowerBound_ = request->hasLowerBound_;
+                    plan.hasUpperBound_ = request->hasUpperBound_;
+                    plan.projection_ = request->projection_;
+                    plan.groupColumns_ = request->groupColumns_;
+                    plan.offset_ = request->offset_;
+                    plan.limit_ = request->limit_;
+
+                    for (const AggregateHeader &header : request->aggregates_)
+                    {
+                        plan.aggregates_.emplace_back (Richard::AggregateInfo {header.function_, header.columnId_});
+                    }
+
+                    for (const QueryOrderHeader &header : request->order_)
+                    {
+                        plan.order_.emplace_back (Richard::QueryOrder {header.outputColumn_, header.descending_});
+                    }
+
+                    if (!UnwrapPredicate (context, request->queryId_, request->nodes_, request->values_,
+                                          plan.filter_) ||
+                        !UnwrapRowValues (context, request->queryId_, request->lowerBound_, plan.lowerBound_) ||
+                        !UnwrapRowValues (context, request->queryId_, request->upperBound_, plan.upperBound_))
+                    {
+                        return;
+                    }
+
+                    // Batches are sent as soon as they are produced, so client starts receiving
+                    // output of streamed plans before whole table is scanned.
+                    Richard::ResultCode result = tableAccess.table_->ExecuteQuery (
+                        tableAccess.guard_, plan, context.multithreadingContext_,
+                        [&context, &request] (Richard::QueryBatch &batch)
+                        {
+                            QueryResultResponse response {};
+                            response.queryId_ = request->queryId_;
+                            response.isLast_ = false;
+                            response.columnsCount_ = batch.columnsCount_;
+                            response.rowsCount_ = batch.GetRowsCount ();
+
+                            for (std::size_t index = 0; index < batch.values_.size (); ++index)
+                            {
+                                if (!batch.nulls_[index])
+                                {
+                                    response.values_.emplace_back (index, std::move (batch.values_[index]));
+                                }
+                            }
+
+                            response.Write (Messaging::Message::QUERY_RESULT_RESPONSE, context.session_);
+                            return true;
+                        });
+
+                    if (result != Richard::ResultCode::OK)
+                    {
+                        SendVoidResult (context, request->queryId_, MapDatabaseResultToOperationResult (result));
+                        return;
+                    }
+
+                    QueryResultResponse response {};
+                    response.queryId_ = request->queryId_;
+                    response.isLast_ = true;
+                    response.columnsCount_ = 0u;
+                    response.rowsCount_ = 0u;
+                    response.Write (Messaging::Message::QUERY_RESULT_RESPONSE, context.session_);
+                }
+            }
+        });
+}
+
+void ProcessJoinRequest (const ProcessingContext &context, JoinRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        // Request is captured using shared pointer because std::function requires all captures to be copyable,
+        // but it's impossible to copy this request because of Richard::AnyDataContainer.
+        [context, request (std::make_shared <JoinRequest> (std::move (message)))] (auto guard) mutable
+        {
+            const SessionExtension *extension = nullptr;
+            if (!ExtractConstSessionExtension (context, request->queryId_, guard, extension) ||
+                !EnsureNoTableAccess (context, extension, request->queryId_, request->leftTableId_) ||
+                !EnsureNoTableAccess (context, extension, request->queryId_, request->rightTableId_))
+            {
+                return;
+            }
+
+            if (extension == nullptr || (extension->conduitReadGuard_ == nullptr &&
+                                         extension->conduitWriteGuard_ == nullptr))
+            {
+                SendVoidResult (context, request->queryId_, OperationResult::CONDUIT_READ_OR_WRITE_ACCESS_REQUIRED);
+                return;
+            }
+
+            auto plan = std::make_shared <Richard::JoinPlan> ();
+            plan->left_.keyColumns_ = request->leftKeyColumns_;
+            plan->left_.projection_ = request->leftProjection_;
+            plan->right_.keyColumns_ = request->rightKeyColumns_;
+            plan->right_.projection_ = request->rightProjection_;
+            plan->limit_ = request->limit_;
+
+            Richard::Table *left = nullptr;
+            Richard::Table *right = nullptr;
+
+            if (!UnwrapPredicate (context, request->queryId_, request->leftNodes_, request->leftValues_,
+                                  plan->left_.filter_) ||
+                !UnwrapPredicate (context, request->queryId_, request->rightNodes_, request->rightValues_,
+                                  plan->right_.filter_) ||
+                !GetTable (context, extension, request->queryId_, request->leftTableId_, left) ||
+                !GetTable (context, extension, request->queryId_, request->rightTableId_, right))
+            {
+                return;
+            }
+
+            // Read guards of both tables are captured by one lock group, so join never holds one table while
+            // waiting for another. Self join captures table guard only once, because it's impossible to
+            // capture the same lock twice in one group.
+            std::vector <Disco::AnyLockPointer> locks
+                {Disco::AnyLockPointer (&context.session_->Data ().ReadWriteGuard ().Read ()),
+                 Disco::AnyLockPointer (&left->ReadWriteGuard ().Read ())};
+
+            if (left != right)
+            {
+                locks.emplace_back (&right->ReadWriteGuard ().Read ());
+            }
+
+            Disco::After (
+                locks,
+                [context, queryId (request->queryId_), plan, left, right] (auto guards)
+                {
+                    const SessionExtension *extension = nullptr;
+                    if (!ExtractConstSessionExtension (context, queryId, guards[0], extension))
+                    {
+                        return;
+                    }
+
+                    Richard::ResultCode result = Richard::HashJoin::Execute (
+                        left, guards[1], right, guards.back (), *plan, context.multithreadingContext_,
+                        [&context, queryId] (Richard::QueryBatch &batch)
+                        {
+                            QueryResultResponse response {};
+                            response.queryId_ = queryId;
+                            response.isLast_ = false;
+                            response.columnsCount_ = batch.columnsCount_;
+                            response.rowsCount_ = batch.GetRowsCount ();
+
+                            for (std::size_t index = 0; index < batch.values_.size (); ++index)
+                            {
+                                if (!batch.nulls_[index])
+                                {
+                                    response.values_.emplace_back (index, std::move (batch.values_[index]));
+                                }
+                            }
+
+                            response.Write (Messaging::Message::QUERY_RESULT_RESPONSE, context.session_);
+                            return true;
+                        });
+
+                    if (result != Richard::ResultCode::OK)
+                    {
+                        SendVoidResult (context, queryId, MapDatabaseResultToOperationResult (result));
+                        return;
+                    }
+
+                    QueryResultResponse response {};
+                    response.queryId_ = queryId;
+                    response.isLast_ = true;
+                    response.columnsCount_ = 0u;
+                    response.rowsCount_ = 0u;
+                    response.Write (Messaging::Message::QUERY_RESULT_RESPONSE, context.session_);
+                });
+        });
+}
+
+void ProcessBackupRequest (const ProcessingContext &context, const BackupRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Read (),
+        [context, request (message)] (auto guard)
+        {
+            const SessionExtension *extension = nullptr;
+            if (!ExtractConstSessionExtension (context, request.queryId_, guard, extension))
+            {
+                return;
+            }
+
+            if (extension == nullptr || (extension->conduitReadGuard_ == nullptr &&
+                                         extension->conduitWriteGuard_ == nullptr))
+            {
+                SendVoidResult (context, request.queryId_, OperationResult::CONDUIT_READ_OR_WRITE_ACCESS_REQUIRED);
+                return;
+            }
+
+            assert (context.databaseConduit_);
+            std::vector <Richard::AnyDataId> tableIds;
+            std::vector <Disco::AnyLockPointer> locks
+                {Disco::AnyLockPointer (&context.session_->Data ().ReadWriteGuard ().Read ())};
+
+            Richard::ResultCode result = context.databaseConduit_->PrepareBackup (
+                extension->conduitReadGuard_ == nullptr ?
+                extension->conduitWriteGuard_ : extension->conduitReadGuard_,
+                tableIds, locks);
+
+            if (result != Richard::ResultCode::OK)
+            {
+                SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                return;
+            }
+
+            for (Richard::AnyDataId tableId : tableIds)
+            {
+                if (!EnsureNoTableAccess (context, extension, request.queryId_, tableId))
+                {
+                    return;
+                }
+            }
+
+            auto begin = [context, request, tableIds] (std::vector <std::shared_ptr <Disco::SafeLockGuard>> guards)
+            {
+                assert (guards.size () == tableIds.size () + 1u);
+                const SessionExtension *extension = nullptr;
+
+                if (!ExtractConstSessionExtension (context, request.queryId_, guards[0], extension))
+                {
+                    return;
+                }
+
+                if (extension == nullptr || (extension->conduitReadGuard_ == nullptr &&
+                                             extension->conduitWriteGuard_ == nullptr))
+                {
+                    SendVoidResult (context, request.queryId_,
+                                    OperationResult::CONDUIT_READ_OR_WRITE_ACCESS_REQUIRED);
+                    return;
+                }
+
+                std::vector <std::shared_ptr <Disco::SafeLockGuard>> tableGuards (
+                    guards.begin () + 1, guards.end ());
+                Richard::ConduitBackup *rawBackup = nullptr;
+
+                Richard::ResultCode result = context.databaseConduit_->BeginBackup (
+                    extension->conduitReadGuard_ == nullptr ?
+                    extension->conduitWriteGuard_ : extension->conduitReadGuard_,
+                    tableIds, tableGuards, rawBackup);
+
+                if (result != Richard::ResultCode::OK)
+                {
+                    SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+                    return;
+                }
+
+                // Writers are released before image is written. Session guard is still held,
+                // so conduit access, that prevents table removal, could not be released meanwhile.
+                assert (rawBackup);
+                std::unique_ptr <Richard::ConduitBackup> backup (rawBackup);
+                tableGuards.clear ();
+                guards.resize (1u);
+
+                result = backup->WriteToFile (request.path_, context.multithreadingContext_);
+                SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+            };
+
+            // Read guards of all tables are captured by one lock group, so image is consistent across tables.
+            // Lock group requires at least two locks, so backup of empty conduit is created right away.
+            if (tableIds.empty ())
+            {
+                begin ({guard});
+            }
+            else
+            {
+                Disco::After (locks, begin);
+            }
+        });
+}
+
+ReplicaSessionEntry::~ReplicaSessionEntry ()
+{
+    if (mutationLog_)
+    {
+        mutationLog_->UnregisterReplica (replicaId_);
+    }
+}
+
+void ProcessReplicationPullRequest (const ProcessingContext &context, const ReplicationPullRequest &message)
+{
+    using namespace Details;
+    assert (context.session_);
+
+    // Replicas could not be chained, because applied mutations are not logged again.
+    if (!context.replication_ || !context.replication_->mutationLog_)
+    {
+        SendVoidResult (context, message.queryId_, OperationResult::REPLICATION_IS_NOT_ENABLED);
+        return;
+    }
+
+    Disco::After (
+        &context.session_->Data ().ReadWriteGuard ().Write (),
+        [context, request (message)] (auto guard)
+        {
+            Richard::MutationLog *mutationLog = context.replication_->mutationLog_;
+            ReplicaSessionEntry *entry = nullptr;
+            Hotline::ResultCode entryResult =
+                context.session_->Data ().GetEntryForWrite <ReplicaSessionEntry> (guard, entry);
+
+            if (entryResult != Hotline::ResultCode::OK)
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR, "Caught error with code " +
+                                           std::to_string (static_cast <uint64_t> (entryResult)) +
+                                           " during replica session entry extraction!");
+                SendVoidResult (context, request.queryId_, OperationResult::INTERNAL_ERROR);
+                return;
+            }
+
+            if (!entry->mutationLog_)
+            {
+                entry->mutationLog_ = mutationLog;
+                entry->replicaId_ = mutationLog->RegisterReplica ();
+            }
+
+            // Replica pulls mutations after the last applied one, so all previous mutations could be trimmed.
+            mutationLog->Acknowledge (entry->replicaId_, request.afterSequence_);
+            ReplicationBatchResponse response {request.queryId_, 0u, {}};
+            Richard::ResultCode result = mutationLog->Read (
+                request.afterSequence_, request.maxBatchSize_, response.mutations_);
+
+            if (result == Richard::ResultCode::OK)
+            {
+                // Requested after read, so it is never less than the last sequence in batch.
+                response.lastSequence_ = mutationLog->GetLastSequence ();
+                response.Write (Message::REPLICATION_BATCH_RESPONSE, context.session_);
+            }
+            else
+            {
+                SendVoidResult (context, request.queryId_, MapDatabaseResultToOperationResult (result));
+            }
+        });
+}
+
+void ProcessReplicationStatusRequest (const ProcessingContext &context, const ConduitVoidActionRequest &message)
+{
+    assert (context.session_);
+    ReplicationStatusResponse response {message.queryId_, false, false, 0u, 0u, 0u, 0u};
+
+    if (context.replication_ && context.replication_->applier_)
+    {
+        assert (context.replication_->primaryLastSequence_);
+        assert (context.replication_->resyncNeeded_);
+        response.isReplica_ = true;
+        response.resyncNeeded_ = context.replication_->resyncNeeded_->load ();
+        response.lastSequence_ = context.replication_->primaryLastSequence_->load ();
+        response.appliedSequence_ = context.replication_->applier_->GetAppliedSequence ();
+
+        if (response.lastSequence_ > response.appliedSequence_)
+        {
+            response.lagMutations_ = response.lastSequence_ - response.appliedSequence_;
+            int64_t now = std::chrono::duration_cast <std::chrono::milliseconds> (
+                std::chrono::system_clock::now ().time_since_epoch ()).count ();
+            int64_t appliedTimestamp = context.replication_->applier_->GetAppliedTimestamp ();
+
+            // Clocks of primary and replica could differ a bit, so negative lag is reported as zero.
+            if (appliedTimestamp > 0 && now > appliedTimestamp)
+            {
+                response.lagMilliseconds_ = static_cast <uint64_t> (now - appliedTimestamp);
+            }
+        }
+    }
+    else if (context.replication_ && context.replication_->mutationLog_)
+    {
+        response.lastSequence_ = context.replication_->mutationLog_->GetLastSequence ();
+        response.appliedSequence_ = response.lastSequence_;
+    }
+
+    response.Write (Message::REPLICATION_STATUS_RESPONSE, context.session_);
+}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
@@ -8,17 +9,33 @@
 #include <Miami/Disco/Disco.hpp>
 
 #include <Miami/Richard/Conduit.hpp>
+#include <Miami/Richard/Replication.hpp>
 #include <Miami/Richard/Table.hpp>
+#include <Miami/Richard/Transaction.hpp>
 
 #include <Miami/Hotline/SocketSession.hpp>
 
 namespace Miami::App::Server
 {
+/// Replication role of server. Primary has mutation log, replica has applier and rejects every write access.
+struct ReplicationContext final
+{
+    Richard::MutationLog *mutationLog_ = nullptr;
+    const Richard::MutationApplier *applier_ = nullptr;
+
+    /// For replica: the last sequence of primary log, received with the last batch.
+    const std::atomic <uint64_t> *primaryLastSequence_ = nullptr;
+
+    /// For replica: set when primary reports, that replica must be resynchronized.
+    const std::atomic <bool> *resyncNeeded_ = nullptr;
+};
+
 struct ProcessingContext final
 {
     Disco::Context *multithreadingContext_;
     Richard::Conduit *databaseConduit_;
     Hotline::SocketSession *session_;
+    const ReplicationContext *replication_;
 };
 
 struct SessionExtension final
@@ -26,11 +43,14 @@ struct SessionExtension final
     /// Precalculated ISO CRC-64 hash of "Miami::App::Server::SessionExtension".
     static constexpr uint64_t TYPE_ID = 0x3a6ee1b969ccb95f;
 
+    /// Edit access captures table intent guard instead of write guard, so sessions, that edit different rows of
+    /// the same table, do not block each other. Rows are changed under row locks, that are captured per operation.
     struct TableAccess
     {
         std::shared_ptr <Disco::SafeLockGuard> guard_ = nullptr;
         Richard::Table *tableWeakPointer_ = nullptr;
         bool isWriteAccess_ = false;
+        bool isEditAccess_ = false;
     };
 
     template <typename Cursor>
@@ -47,6 +67,25 @@ struct SessionExtension final
     Richard::AnyDataId nextCursorId_ = 0;
     std::unordered_map <Richard::AnyDataId, CursorData <Richard::TableReadCursor>> readCursors_ {};
     std::unordered_map <Richard::AnyDataId, CursorData <Richard::TableEditCursor>> editCursors_ {};
+
+    /// Snapshot cursors do not depend on table accesses, so they could be used after access closing.
+    std::unordered_map <Richard::AnyDataId, std::unique_ptr <Richard::TableSnapshotCursor>> snapshotCursors_ {};
+
+    /// Only one transaction per session is allowed. Its table write guards are stored in table accesses.
+    std::unique_ptr <Richard::Transaction> transaction_ = nullptr;
+};
+
+/// Added to session of replica on its first pull request. Mutation log keeps records, that replica has not applied
+/// yet, until session is destroyed.
+struct ReplicaSessionEntry final
+{
+    /// Precalculated ISO CRC-64 hash of "Miami::App::Server::ReplicaSessionEntry".
+    static constexpr uint64_t TYPE_ID = 0x7b41c61be4f98535;
+
+    ~ReplicaSessionEntry ();
+
+    Richard::MutationLog *mutationLog_ = nullptr;
+    uint64_t replicaId_ = 0u;
 };
 
 void ProcessGetTableReadAccessRequest (const ProcessingContext &context,
@@ -61,6 +100,12 @@ void ProcessCloseTableReadAccessRequest (const ProcessingContext &context,
 void ProcessCloseTableWriteAccessRequest (const ProcessingContext &context,
                                           const Messaging::TableOperationRequest &message);
 
+void ProcessGetTableEditAccessRequest (const ProcessingContext &context,
+                                       const Messaging::TableOperationRequest &message);
+
+void ProcessCloseTableEditAccessRequest (const ProcessingContext &context,
+                                         const Messaging::TableOperationRequest &message);
+
 void ProcessGetTableNameRequest (const ProcessingContext &context,
                                  const Messaging::TableOperationRequest &message);
 
@@ -100,6 +145,8 @@ void ProcessRemoveIndexRequest (const ProcessingContext &context,
 void ProcessAddRowRequest (const ProcessingContext &context,
                            Messaging::AddRowRequest &message);
 
+void ProcessAddRowsRequest (const ProcessingContext &context, Messaging::AddRowsRequest &message);
+
 void ProcessCursorAdvanceRequest (const ProcessingContext &context,
                                   const Messaging::CursorAdvanceRequest &message);
 
@@ -135,4 +182,46 @@ void ProcessAddTableRequest (const ProcessingContext &context,
 
 void ProcessRemoveTableRequest (const ProcessingContext &context,
                                 const Messaging::TableOperationRequest &message);
+
+void ProcessCreateSnapshotCursorRequest (const ProcessingContext &context,
+                                         const Messaging::TablePartOperationRequest &message);
+
+void ProcessCreateLookupReadCursorRequest (const ProcessingContext &context,
+                                           Messaging::CreateLookupCursorRequest &message);
+
+void ProcessCreateLookupEditCursorRequest (const ProcessingContext &context,
+                                           Messaging::CreateLookupCursorRequest &message);
+
+void ProcessCreateFilteredReadCursorRequest (const ProcessingContext &context,
+                                             Messaging::CreateFilteredCursorRequest &message);
+
+void ProcessCreateFilteredEditCursorRequest (const ProcessingContext &context,
+                                             Messaging::CreateFilteredCursorRequest &message);
+
+void ProcessBeginTransactionRequest (const ProcessingContext &context,
+                                     const Messaging::BeginTransactionRequest &message);
+
+void ProcessCommitTransactionRequest (const ProcessingContext &context,
+                                      const Messaging::ConduitVoidActionRequest &message);
+
+void ProcessRollbackTransactionRequest (const ProcessingContext &context,
+                                        const Messaging::ConduitVoidActionRequest &message);
+
+void ProcessAggregateRequest (const ProcessingContext &context, Messaging::AggregateRequest &message);
+
+void ProcessGetTableStatisticsRequest (const ProcessingContext &context,
+                                       const Messaging::TableOperationRequest &message);
+
+void ProcessExecuteQueryRequest (const ProcessingContext &context, Messaging::ExecuteQueryRequest &message);
+
+void ProcessJoinRequest (const ProcessingContext &context, Messaging::JoinRequest &message);
+
+void ProcessBackupRequest (const ProcessingContext &context, const Messaging::BackupRequest &message);
+
+/// Answered right away, because mutation log is read under its own mutex and session data is not used.
+void ProcessReplicationPullRequest (const ProcessingContext &context,
+                                   const Messaging::ReplicationPullRequest &message);
+
+void ProcessReplicationStatusRequest (const ProcessingContext &context,
+                                     const Messaging::ConduitVoidActionRequest &message);
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+// Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
+#define NOGDI
+
+#include <App/Miami/Sharding/Connection.hpp>
+
+#include <Miami/Evan/Logger.hpp>
+
+namespace Miami::App::Sharding
+{
+Connection::Connection (Disco::Context *multithreadingContext)
+    : client_ (multithreadingContext),
+      ioThread_ (),
+      running_ (true),
+      pendingGuard_ (),
+      pending_ (),
+      nextQueryId_ (0u)
+{
+    RegisterResponse <Messaging::VoidOperationResultResponse> (
+        Messaging::Message::VOID_OPERATION_RESULT_RESPONSE,
+        [] (const Messaging::VoidOperationResultResponse &message, Response &response)
+        {
+            response.result_ = message.result_;
+            return true;
+        });
+
+    RegisterResponse <Messaging::CreateOperationResultResponse> (
+        Messaging::Message::CREATE_OPERATION_RESULT_RESPONSE,
+        [] (const Messaging::CreateOperationResultResponse &message, Response &response)
+        {
+            response.resourceId_ = message.resourceId_;
+            return true;
+        });
+
+    RegisterResponse <Messaging::IdsResponse> (
+        Messaging::Message::RESOURCE_IDS_RESPONSE,
+        [] (Messaging::IdsResponse &message, Response &response)
+        {
+            response.ids_ = std::move (message.ids_);
+            return true;
+        });
+
+    RegisterResponse <Messaging::GetTableNameResponse> (
+        Messaging::Message::GET_TABLE_NAME_RESPONSE,
+        [] (Messaging::GetTableNameResponse &message, Response &response)
+        {
+            response.name_ = std::move (message.tableName_);
+            return true;
+        });
+
+    RegisterResponse <Messaging::ColumnInfoResponse> (
+        Messaging::Message::GET_COLUMN_INFO_RESPONSE,
+        [] (Messaging::ColumnInfoResponse &message, Response &response)
+        {
+            response.column_.dataType_ = message.dataType_;
+            response.column_.maxSize_ = message.maxSize_;
+            response.column_.dictionaryEncoded_ = message.dictionaryEncoded_;
+            response.column_.compressed_ = message.compressed_;
+            response.column_.name_ = std::move (message.name_);
+            return true;
+        });
+
+    RegisterResponse <Messaging::ReplicationStatusResponse> (
+        Messaging::Message::REPLICATION_STATUS_RESPONSE,
+        [] (const Messaging::ReplicationStatusResponse &message, Response &response)
+        {
+            response.replicationStatus_ = message;
+            return true;
+        });
+
+    RegisterResponse <Messaging::QueryResultResponse> (
+        Messaging::Message::QUERY_RESULT_RESPONSE,
+        [] (Messaging::QueryResultResponse &message, Response &response)
+        {
+            if (message.columnsCount_ > 0u)
+            {
+                Richard::QueryBatch &rows = response.rows_;
+                const std::size_t firstValue = rows.values_.size ();
+
+                rows.columnsCount_ = message.columnsCount_;
+                rows.values_.resize (firstValue + message.rowsCount_ * message.columnsCount_);
+                rows.nulls_.resize (rows.values_.size (), 1u);
+
+                for (auto &indexValuePair : message.values_)
+                {
+                    rows.values_[firstValue + indexValuePair.first] = std::move (indexValuePair.second);
+                    rows.nulls_[firstValue + indexValuePair.first] = 0u;
+                }
+            }
+
+            return message.isLast_;
+        });
+}
+
+Connection::~Connection ()
+{
+    running_ = false;
+    if (ioThread_.joinable ())
+    {
+        ioThread_.join ();
+    }
+}
+
+bool Connection::Connect (const std::string &host, const std::string &service)
+{
+    Hotline::ResultCode result = client_.Start (host, service);
+    if (result != Hotline::ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Caught Hotline error during socket client connect " +
+                                   std::to_string (static_cast <uint32_t> (result)) + "!");
+        return false;
+    }
+
+    ioThread_ = std::thread (
+        [this] ()
+        {
+            while (running_)
+            {
+                Hotline::ResultCode result = client_.CoreContext ().DoStep ();
+                if (result != Hotline::ResultCode::OK || !client_.CoreContext ().HasAnySession ())
+                {
+                    Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Connection to server is lost!");
+                    running_ = false;
+                }
+            }
+
+            // Nobody is going to answer pending requests, so they are failed right away.
+            std::unique_lock <std::mutex> lock (pendingGuard_);
+            for (auto &idPendingPair : pending_)
+            {
+                idPendingPair.second.promise_.set_value ({Messaging::OperationResult::INTERNAL_ERROR});
+            }
+
+            pending_.clear ();
+        });
+
+    return true;
+}
+
+bool Connection::Wait (std::future <Response> &response, const std::string &action,
+                       Messaging::ResourceId *outputResourceId)
+{
+    Response result;
+    if (!Wait (response, action, result))
+    {
+        return false;
+    }
+
+    if (outputResourceId)
+    {
+        *outputResourceId = result.resourceId_;
+    }
+
+    return true;
+}
+
+bool Connection::Wait (std::future <Response> &response, const std::string &action, Response &output)
+{
+    output = response.get ();
+    if (output.result_ != Messaging::OperationResult::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Unable to " + action + ", server responded with " +
+                                   Messaging::GetOperationResultName (output.result_) + "!");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename Message, typename Handler>
+void Connection::RegisterResponse (Messaging::Message messageType, Handler handler)
+{
+    Hotline::ResultCode result = client_.CoreContext ().RegisterFactory (
+        static_cast <Hotline::MessageTypeId> (messageType),
+        [this, handler] () -> Hotline::MessageParser
+        {
+            return Message::CreateParserWithCallback (
+                [this, handler] (Message &message, Hotline::SocketSession *)
+                {
+                    std::unique_lock <std::mutex> lock (pendingGuard_);
+                    auto iterator = pending_.find (message.queryId_);
+
+                    if (iterator != pending_.end () && handler (message, iterator->second.response_))
+                    {
+                        iterator->second.promise_.set_value (std::move (iterator->second.response_));
+                        pending_.erase (iterator);
+                    }
+                });
+        });
+
+    assert (result == Hotline::ResultCode::OK);
+}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Query.hpp>
+
+#include <Miami/Hotline/SocketClient.hpp>
+
+#include <App/Miami/Messaging/Message.hpp>
+
+namespace Miami::App::Sharding
+{
+/// Result of request. Fields, except result itself, are filled only by responses, that carry them.
+struct Response
+{
+    Messaging::OperationResult result_ = Messaging::OperationResult::OK;
+
+    /// From CREATE_OPERATION_RESULT_RESPONSE.
+    Messaging::ResourceId resourceId_ = 0u;
+
+    /// From RESOURCE_IDS_RESPONSE.
+    std::vector <Messaging::ResourceId> ids_ {};
+
+    /// Table name from GET_TABLE_NAME_RESPONSE or column info from GET_COLUMN_INFO_RESPONSE.
+    std::string name_ {};
+    Richard::ColumnInfo column_ {};
+
+    /// Rows of all QUERY_RESULT_RESPONSE messages of query.
+    Richard::QueryBatch rows_ {};
+
+    /// From REPLICATION_STATUS_RESPONSE.
+    Messaging::ReplicationStatusResponse replicationStatus_ {};
+};
+
+/// Sends requests to server and waits for their responses, that are received by separate IO thread.
+class Connection final
+{
+public:
+    explicit Connection (Disco::Context *multithreadingContext);
+
+    Connection (const Connection &another) = delete;
+
+    Connection (Connection &&another) = delete;
+
+    ~Connection ();
+
+    free_call bool Connect (const std::string &host, const std::string &service);
+
+    /// Request query id is assigned by connection. Request is written before return, so it could be changed and
+    /// sent again right after.
+    template <typename Request>
+    std::future <Response> Send (Messaging::Message messageType, Request &request)
+    {
+        std::future <Response> response;
+        {
+            std::unique_lock <std::mutex> lock (pendingGuard_);
+            request.queryId_ = nextQueryId_++;
+
+            std::promise <Response> &promise = pending_[request.queryId_].promise_;
+            response = promise.get_future ();
+
+            if (!running_)
+            {
+                promise.set_value ({Messaging::OperationResult::INTERNAL_ERROR});
+                pending_.erase (request.queryId_);
+                return response;
+            }
+        }
+
+        request.Write (messageType, client_.GetSession ());
+        return response;
+    }
+
+    /// Waits for response and logs it, if it is not successful.
+    free_call static bool Wait (std::future <Response> &response, const std::string &action,
+                                Messaging::ResourceId *outputResourceId = nullptr);
+
+    free_call static bool Wait (std::future <Response> &response, const std::string &action, Response &output);
+
+    template <typename Request>
+    free_call bool Execute (Messaging::Message messageType, Request &request, const std::string &action,
+                            Messaging::ResourceId *outputResourceId = nullptr)
+    {
+        std::future <Response> response = Send (messageType, request);
+        return Wait (response, action, outputResourceId);
+    }
+
+    template <typename Request>
+    free_call bool Execute (Messaging::Message messageType, Request &request, const std::string &action,
+                            Response &output)
+    {
+        std::future <Response> response = Send (messageType, request);
+        return Wait (response, action, output);
+    }
+
+private:
+    /// Response is accumulated here, if it consists of several messages.
+    struct Pending
+    {
+        std::promise <Response> promise_;
+        Response response_;
+    };
+
+    /// Handler fills response of pending request and returns true, if it is the last message of response.
+    template <typename Message, typename Handler>
+    void RegisterResponse (Messaging::Message messageType, Handler handler);
+
+    Hotline::SocketClient client_;
+    std::thread ioThread_;
+    std::atomic <bool> running_;
+
+    std::mutex pendingGuard_;
+    std::unordered_map <Messaging::QueryId, Pending> pending_;
+    Messaging::QueryId nextQueryId_;
+};
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace Miami::App::Sharding
+{
+enum class ResultCode
+{
+    OK = 0,
+    UNABLE_TO_CONNECT,
+    SERVER_REJECTED_REQUEST,
+
+    SHARD_WITH_GIVEN_INDEX_NOT_FOUND,
+    SHARD_RANGE_BOUNDS_COUNT_MISMATCH,
+    SHARD_RANGE_BOUNDS_MUST_BE_ASCENDING,
+    SHARD_RANGE_BOUND_TYPE_MISMATCH,
+
+    TABLE_IS_NOT_IN_SHARD_MAP,
+    TABLE_IS_ALREADY_IN_SHARD_MAP,
+    TABLE_IS_NOT_OPENED,
+    TABLE_IS_ALREADY_OPENED,
+    TABLE_NOT_FOUND_ON_SHARD,
+    TABLE_HAS_NO_SHARD_KEY,
+
+    /// Sharded table has different columns on different shards.
+    SHARD_SCHEMA_MISMATCH,
+    SHARD_KEY_VALUE_TYPE_MISMATCH,
+
+    /// Count of columns in inserted rows is not equal to count of given column ids.
+    COLUMNS_COUNT_MISMATCH,
+    SHARDED_AGGREGATION_IS_NOT_SUPPORTED,
+};
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cassert>
+
+#include <Miami/Richard/KeyHashTable.hpp>
+
+#include <App/Miami/Sharding/ShardMap.hpp>
+
+namespace Miami::App::Sharding
+{
+const char *GetShardingTypeName (ShardingType shardingType)
+{
+    switch (shardingType)
+    {
+        case ShardingType::SINGLE:
+            return "single";
+        case ShardingType::HASH:
+            return "hash";
+        case ShardingType::RANGE:
+            return "range";
+    }
+
+    return "unknown";
+}
+
+std::size_t ShardMap::AddShard (const std::string &host, const std::string &service)
+{
+    shards_.emplace_back (ShardAddress {host, service});
+    return shards_.size () - 1u;
+}
+
+std::size_t ShardMap::GetShardsCount () const
+{
+    return shards_.size ();
+}
+
+const ShardAddress &ShardMap::GetShard (std::size_t index) const
+{
+    assert (index < shards_.size ());
+    return shards_[index];
+}
+
+ResultCode ShardMap::AddTable (const std::string &name, ShardedTableInfo &info)
+{
+    if (tables_.count (name) > 0u)
+    {
+        return ResultCode::TABLE_IS_ALREADY_IN_SHARD_MAP;
+    }
+
+    if (shards_.empty () || (info.type_ == ShardingType::SINGLE && info.shard_ >= shards_.size ()))
+    {
+        return ResultCode::SHARD_WITH_GIVEN_INDEX_NOT_FOUND;
+    }
+
+    if (info.type_ == ShardingType::RANGE)
+    {
+        if (info.rangeBounds_.size () + 1u != shards_.size ())
+        {
+            return ResultCode::SHARD_RANGE_BOUNDS_COUNT_MISMATCH;
+        }
+
+        for (std::size_t index = 0u; index < info.rangeBounds_.size (); ++index)
+        {
+            if (info.rangeBounds_[index].GetType () != info.keyColumn_.dataType_)
+            {
+                return ResultCode::SHARD_RANGE_BOUND_TYPE_MISMATCH;
+            }
+
+            if (index > 0u && info.rangeBounds_[index] <= info.rangeBounds_[index - 1u])
+            {
+                return ResultCode::SHARD_RANGE_BOUNDS_MUST_BE_ASCENDING;
+            }
+        }
+    }
+
+    tables_.emplace (name, std::move (info));
+    return ResultCode::OK;
+}
+
+const ShardedTableInfo *ShardMap::FindTable (const std::string &name) const
+{
+    auto iterator = tables_.find (name);
+    return iterator != tables_.end () ? &iterator->second : nullptr;
+}
+
+ResultCode ShardMap::GetTableShards (const std::string &name, std::vector <std::size_t> &output) const
+{
+    const ShardedTableInfo *info = FindTable (name);
+    if (info == nullptr)
+    {
+        return ResultCode::TABLE_IS_NOT_IN_SHARD_MAP;
+    }
+
+    output.clear ();
+    if (info->type_ == ShardingType::SINGLE)
+    {
+        output.emplace_back (info->shard_);
+    }
+    else
+    {
+        for (std::size_t index = 0u; index < shards_.size (); ++index)
+        {
+            output.emplace_back (index);
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode ShardMap::FindShard (const std::string &name, const Richard::AnyDataContainer *key,
+                                std::size_t &output) const
+{
+    const ShardedTableInfo *info = FindTable (name);
+    if (info == nullptr)
+    {
+        return ResultCode::TABLE_IS_NOT_IN_SHARD_MAP;
+    }
+
+    if (info->type_ == ShardingType::SINGLE)
+    {
+        output = info->shard_;
+        return ResultCode::OK;
+    }
+
+    if (key == nullptr)
+    {
+        output = 0u;
+        return ResultCode::OK;
+    }
+
+    if (key->GetType () != info->keyColumn_.dataType_)
+    {
+        return ResultCode::SHARD_KEY_VALUE_TYPE_MISMATCH;
+    }
+
+    if (info->type_ == ShardingType::HASH)
+    {
+        // The same hash as in hash partitioned tables. Unlike std::hash, it does not depend on standard library,
+        // so clients, built by different compilers, route keys equally.
+        const auto *begin = static_cast <const uint8_t *> (key->GetDataStartPointer ());
+        Richard::KeyHashTable::Key bytes (begin, begin + key->GetDataSize ());
+        output = static_cast <std::size_t> (Richard::KeyHashTable::Hash (bytes) % shards_.size ());
+    }
+    else
+    {
+        output = static_cast <std::size_t> (
+            std::upper_bound (info->rangeBounds_.begin (), info->rangeBounds_.end (), *key) -
+            info->rangeBounds_.begin ());
+    }
+
+    return ResultCode::OK;
+}
+}
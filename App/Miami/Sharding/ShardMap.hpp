@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Data.hpp>
+
+#include <App/Miami/Sharding/ResultCode.hpp>
+
+namespace Miami::App::Sharding
+{
+struct ShardAddress
+{
+    std::string host_;
+    std::string service_;
+};
+
+enum class ShardingType
+{
+    /// Whole table is stored by one shard.
+    SINGLE = 0,
+
+    /// Rows are distributed by hash of key value, like Richard::PartitioningType::HASH.
+    /// Rows with null key are stored in the first shard.
+    HASH,
+
+    /// Every shard stores continuous range of key values, like Richard::PartitioningType::RANGE.
+    /// Rows with null key are stored in the first shard.
+    RANGE
+};
+
+const char *GetShardingTypeName (ShardingType shardingType);
+
+struct ShardedTableInfo
+{
+    ShardingType type_ = ShardingType::SINGLE;
+
+    /// Used only by single shard tables.
+    std::size_t shard_ = 0u;
+
+    /// Used by hash and range tables. Key column is added to table on every shard before other columns.
+    Richard::ColumnInfo keyColumn_ {};
+
+    /// Used only by range tables. Shard with index i stores keys, that are not less than bound i - 1 and less
+    /// than bound i, therefore there is one bound less than shards. Bounds must be strictly ascending.
+    std::vector <Richard::AnyDataContainer> rangeBounds_ {};
+};
+
+/// Describes servers of sharded database and placement of tables across them. Every client must use the same
+/// map, otherwise rows are routed to wrong shards. Tables must be added after all shards.
+class ShardMap final
+{
+public:
+    ShardMap () = default;
+
+    ShardMap (const ShardMap &another) = delete;
+
+    ShardMap (ShardMap &&another) = default;
+
+    ~ShardMap () = default;
+
+    /// Returns index of added shard.
+    std::size_t AddShard (const std::string &host, const std::string &service);
+
+    free_call std::size_t GetShardsCount () const;
+
+    free_call const ShardAddress &GetShard (std::size_t index) const;
+
+    free_call ResultCode AddTable (const std::string &name, moved_in ShardedTableInfo &info);
+
+    /// Returns null if table is not in map.
+    free_call const ShardedTableInfo *FindTable (const std::string &name) const;
+
+    /// Collects indices of shards, that store rows of given table, in ascending order.
+    free_call ResultCode GetTableShards (const std::string &name, std::vector <std::size_t> &output) const;
+
+    /// Finds shard, to which row with given key belongs. Null pointer means null key. Key type must be equal
+    /// to key column type, single shard tables accept any key.
+    free_call ResultCode FindShard (const std::string &name, const Richard::AnyDataContainer *key,
+                                    std::size_t &output) const;
+
+private:
+    std::vector <ShardAddress> shards_;
+    std::unordered_map <std::string, ShardedTableInfo> tables_;
+};
+}
@@ -0,0 +1,762 @@
+// Not only we don't need GDI, but it also has ERROR macro that breaks Evan's LogLevel.
+#define NOGDI
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+#include <App/Miami/Sharding/ShardedClient.hpp>
+
+#include <Miami/Evan/Logger.hpp>
+
+namespace Miami::App::Sharding
+{
+namespace
+{
+/// Null values are less than any other values, like in Richard::QueryOrder.
+int CompareValues (const Richard::QueryBatch &first, std::size_t firstIndex,
+                   const Richard::QueryBatch &second, std::size_t secondIndex)
+{
+    if (first.nulls_[firstIndex] || second.nulls_[secondIndex])
+    {
+        return static_cast <int> (!first.nulls_[firstIndex]) - static_cast <int> (!second.nulls_[secondIndex]);
+    }
+
+    const Richard::AnyDataContainer &firstValue = first.values_[firstIndex];
+    const Richard::AnyDataContainer &secondValue = second.values_[secondIndex];
+    return firstValue < secondValue ? -1 : (secondValue < firstValue ? 1 : 0);
+}
+
+int CompareRows (const std::vector <Messaging::QueryOrderHeader> &order,
+                 const Richard::QueryBatch &first, std::size_t firstRow,
+                 const Richard::QueryBatch &second, std::size_t secondRow)
+{
+    for (const Messaging::QueryOrderHeader &key : order)
+    {
+        int comparison = CompareValues (first, firstRow * first.columnsCount_ + key.outputColumn_,
+                                        second, secondRow * second.columnsCount_ + key.outputColumn_);
+        if (comparison != 0)
+        {
+            return key.descending_ ? -comparison : comparison;
+        }
+    }
+
+    return 0;
+}
+
+/// Every shard output is already sorted, so the least current row of all outputs is taken at every step.
+/// Rows with equal sort keys are taken from shards with lesser index first.
+void MergeSorted (const std::vector <Messaging::QueryOrderHeader> &order, std::vector <Response> &shardOutputs,
+                  uint64_t offset, uint64_t limit, Richard::QueryBatch &output)
+{
+    std::vector <std::size_t> nextRows (shardOutputs.size (), 0u);
+    while (limit > 0u)
+    {
+        std::size_t selected = shardOutputs.size ();
+        for (std::size_t shard = 0u; shard < shardOutputs.size (); ++shard)
+        {
+            const Richard::QueryBatch &rows = shardOutputs[shard].rows_;
+            if (nextRows[shard] < rows.GetRowsCount () &&
+                (selected == shardOutputs.size () ||
+                 CompareRows (order, rows, nextRows[shard],
+                              shardOutputs[selected].rows_, nextRows[selected]) < 0))
+            {
+                selected = shard;
+            }
+        }
+
+        if (selected == shardOutputs.size ())
+        {
+            return;
+        }
+
+        if (offset > 0u)
+        {
+            --offset;
+        }
+        else
+        {
+            shardOutputs[selected].rows_.MoveRowsTo (nextRows[selected], 1u, output);
+            --limit;
+        }
+
+        ++nextRows[selected];
+    }
+}
+
+void Concatenate (std::vector <Response> &shardOutputs, uint64_t offset, uint64_t limit,
+                  Richard::QueryBatch &output)
+{
+    for (Response &shardOutput : shardOutputs)
+    {
+        const std::size_t rowsCount = shardOutput.rows_.GetRowsCount ();
+        const std::size_t skipped = static_cast <std::size_t> (std::min <uint64_t> (offset, rowsCount));
+        const std::size_t taken = static_cast <std::size_t> (std::min <uint64_t> (limit, rowsCount - skipped));
+
+        shardOutput.rows_.MoveRowsTo (skipped, taken, output);
+        offset -= skipped;
+        limit -= taken;
+    }
+}
+}
+
+ShardedClient::ShardedClient (Disco::Context *multithreadingContext, ShardMap &shardMap)
+    : multithreadingContext_ (multithreadingContext),
+      shardMap_ (std::move (shardMap)),
+      connections_ (),
+      tables_ ()
+{
+    assert (multithreadingContext_);
+}
+
+ResultCode ShardedClient::Connect ()
+{
+    connections_.clear ();
+    for (std::size_t index = 0u; index < shardMap_.GetShardsCount (); ++index)
+    {
+        const ShardAddress &address = shardMap_.GetShard (index);
+        connections_.emplace_back (std::make_unique <Connection> (multithreadingContext_));
+
+        if (!connections_.back ()->Connect (address.host_, address.service_))
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR, "Unable to connect to shard " + std::to_string (index) + " at " +
+                                       address.host_ + ":" + address.service_ + "!");
+            connections_.clear ();
+            return ResultCode::UNABLE_TO_CONNECT;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+template <typename Request, typename Prepare>
+bool ShardedClient::ExecuteOnShards (const std::vector <std::size_t> &shards, Messaging::Message messageType,
+                                     Request &request, Prepare prepare, const std::string &action,
+                                     std::vector <Response> *outputs)
+{
+    std::vector <std::future <Response>> responses;
+    for (std::size_t position = 0u; position < shards.size (); ++position)
+    {
+        assert (shards[position] < connections_.size ());
+        prepare (position, request);
+        responses.emplace_back (connections_[shards[position]]->Send (messageType, request));
+    }
+
+    if (outputs)
+    {
+        outputs->clear ();
+        outputs->resize (shards.size ());
+    }
+
+    bool succeeded = true;
+    for (std::size_t position = 0u; position < shards.size (); ++position)
+    {
+        Response response;
+        succeeded &= Connection::Wait (responses[position], action + " on shard " +
+                                                            std::to_string (shards[position]), response);
+
+        if (outputs)
+        {
+            (*outputs)[position] = std::move (response);
+        }
+    }
+
+    return succeeded;
+}
+
+const ShardMap &ShardedClient::GetShardMap () const
+{
+    return shardMap_;
+}
+
+ResultCode ShardedClient::CreateTable (const std::string &name, const std::vector <Richard::ColumnInfo> &columns,
+                                       std::vector <Richard::AnyDataId> &outputColumnIds)
+{
+    if (connections_.size () != shardMap_.GetShardsCount ())
+    {
+        return ResultCode::UNABLE_TO_CONNECT;
+    }
+
+    const ShardedTableInfo *info = shardMap_.FindTable (name);
+    if (info == nullptr)
+    {
+        return ResultCode::TABLE_IS_NOT_IN_SHARD_MAP;
+    }
+
+    if (tables_.count (name) > 0u)
+    {
+        return ResultCode::TABLE_IS_ALREADY_OPENED;
+    }
+
+    OpenedTable table;
+    ResultCode result = shardMap_.GetTableShards (name, table.shards_);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    Messaging::ConduitVoidActionRequest conduitRequest {};
+    Messaging::AddTableRequest addTableRequest {};
+    addTableRequest.tableName_ = name;
+    std::vector <Response> responses;
+
+    auto keepRequest = [] (std::size_t, auto &)
+    {
+    };
+
+    // Conduit write access is needed only to add table, so it is released right after.
+    if (!ExecuteOnShards (table.shards_, Messaging::Message::GET_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest,
+                          keepRequest, "get conduit write access"))
+    {
+        ExecuteOnShards (table.shards_, Messaging::Message::CLOSE_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest,
+                         keepRequest, "close conduit write access");
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    const bool added = ExecuteOnShards (table.shards_, Messaging::Message::ADD_TABLE_REQUEST, addTableRequest,
+                                        keepRequest, "add table \"" + name + "\"", &responses);
+
+    if (!ExecuteOnShards (table.shards_, Messaging::Message::CLOSE_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest,
+                          keepRequest, "close conduit write access") || !added)
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    for (const Response &response : responses)
+    {
+        table.tableIds_.emplace_back (response.resourceId_);
+    }
+
+    if (!AccessTable (table, true))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    std::vector <Richard::ColumnInfo> addedColumns;
+    if (info->type_ != ShardingType::SINGLE)
+    {
+        addedColumns.emplace_back (info->keyColumn_);
+    }
+
+    addedColumns.insert (addedColumns.end (), columns.begin (), columns.end ());
+    std::vector <Richard::AnyDataId> addedIds;
+    result = ResultCode::OK;
+
+    for (const Richard::ColumnInfo &column : addedColumns)
+    {
+        Messaging::AddColumnRequest request {};
+        request.dataType_ = column.dataType_;
+        request.maxSize_ = column.maxSize_;
+        request.dictionaryEncoded_ = column.dictionaryEncoded_;
+        request.compressed_ = column.compressed_;
+        request.name_ = column.name_;
+
+        if (!ExecuteOnShards (
+            table.shards_, Messaging::Message::ADD_COLUMN_REQUEST, request,
+            [&table] (std::size_t position, Messaging::AddColumnRequest &request)
+            {
+                request.tableId_ = table.tableIds_[position];
+            },
+            "add column \"" + column.name_ + "\"", &responses))
+        {
+            result = ResultCode::SERVER_REJECTED_REQUEST;
+            break;
+        }
+
+        for (const Response &response : responses)
+        {
+            if (response.resourceId_ != responses.front ().resourceId_)
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR, "Column \"" + column.name_ + "\" of table \"" + name +
+                                           "\" received different ids on different shards!");
+                result = ResultCode::SHARD_SCHEMA_MISMATCH;
+            }
+        }
+
+        addedIds.emplace_back (responses.front ().resourceId_);
+    }
+
+    if (!ReleaseTable (table, true) && result == ResultCode::OK)
+    {
+        result = ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (info->type_ != ShardingType::SINGLE)
+    {
+        table.hasKeyColumn_ = true;
+        table.keyColumnId_ = addedIds.front ();
+        addedIds.erase (addedIds.begin ());
+    }
+
+    outputColumnIds = std::move (addedIds);
+    tables_.emplace (name, std::move (table));
+    return ResultCode::OK;
+}
+
+ResultCode ShardedClient::OpenTable (const std::string &name, std::vector <Richard::ColumnInfo> &outputColumns)
+{
+    if (connections_.size () != shardMap_.GetShardsCount ())
+    {
+        return ResultCode::UNABLE_TO_CONNECT;
+    }
+
+    const ShardedTableInfo *info = shardMap_.FindTable (name);
+    if (info == nullptr)
+    {
+        return ResultCode::TABLE_IS_NOT_IN_SHARD_MAP;
+    }
+
+    if (tables_.count (name) > 0u)
+    {
+        return ResultCode::TABLE_IS_ALREADY_OPENED;
+    }
+
+    OpenedTable table;
+    ResultCode result = shardMap_.GetTableShards (name, table.shards_);
+
+    for (std::size_t index = 0u; index < table.shards_.size () && result == ResultCode::OK; ++index)
+    {
+        table.tableIds_.emplace_back ();
+        result = FindTableOnShard (table.shards_[index], name, table.tableIds_.back ());
+    }
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (!AccessTable (table, false))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    auto setTableId = [&table] (std::size_t position, auto &request)
+    {
+        request.tableId_ = table.tableIds_[position];
+    };
+
+    Messaging::TableOperationRequest tableRequest {};
+    std::vector <Response> responses;
+    std::vector <Richard::ColumnInfo> columns;
+
+    if (!ExecuteOnShards (table.shards_, Messaging::Message::GET_COLUMNS_IDS_REQUEST, tableRequest, setTableId,
+                          "get columns ids", &responses))
+    {
+        result = ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    for (Response &response : responses)
+    {
+        std::sort (response.ids_.begin (), response.ids_.end ());
+        if (response.ids_ != responses.front ().ids_)
+        {
+            result = ResultCode::SHARD_SCHEMA_MISMATCH;
+        }
+    }
+
+    const std::vector <Messaging::ResourceId> columnIds =
+        result == ResultCode::OK ? std::move (responses.front ().ids_) : std::vector <Messaging::ResourceId> {};
+
+    for (Messaging::ResourceId columnId : columnIds)
+    {
+        Messaging::TablePartOperationRequest request {};
+        request.partId_ = columnId;
+
+        if (!ExecuteOnShards (table.shards_, Messaging::Message::GET_COLUMN_INFO_REQUEST, request, setTableId,
+                              "get column info", &responses))
+        {
+            result = ResultCode::SERVER_REJECTED_REQUEST;
+            break;
+        }
+
+        for (const Response &response : responses)
+        {
+            const Richard::ColumnInfo &first = responses.front ().column_;
+            if (response.column_.name_ != first.name_ || response.column_.dataType_ != first.dataType_)
+            {
+                result = ResultCode::SHARD_SCHEMA_MISMATCH;
+            }
+        }
+
+        columns.emplace_back (responses.front ().column_);
+        columns.back ().id_ = columnId;
+    }
+
+    if (!ReleaseTable (table, false) && result == ResultCode::OK)
+    {
+        result = ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    if (result == ResultCode::OK && info->type_ != ShardingType::SINGLE)
+    {
+        auto keyColumn = std::find_if (columns.begin (), columns.end (),
+                                       [info] (const Richard::ColumnInfo &column)
+                                       {
+                                           return column.name_ == info->keyColumn_.name_ &&
+                                                  column.dataType_ == info->keyColumn_.dataType_;
+                                       });
+
+        if (keyColumn == columns.end ())
+        {
+            result = ResultCode::SHARD_SCHEMA_MISMATCH;
+        }
+        else
+        {
+            table.hasKeyColumn_ = true;
+            table.keyColumnId_ = keyColumn->id_;
+        }
+    }
+
+    if (result != ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Unable to open sharded table \"" + name + "\", result code " +
+                                   std::to_string (static_cast <uint32_t> (result)) + ".");
+        return result;
+    }
+
+    outputColumns = std::move (columns);
+    tables_.emplace (name, std::move (table));
+    return ResultCode::OK;
+}
+
+ResultCode ShardedClient::GetKeyColumnId (const std::string &name, Richard::AnyDataId &output) const
+{
+    const OpenedTable *table = nullptr;
+    ResultCode result = FindOpenedTable (name, table);
+
+    if (result == ResultCode::OK)
+    {
+        if (!table->hasKeyColumn_)
+        {
+            return ResultCode::TABLE_HAS_NO_SHARD_KEY;
+        }
+
+        output = table->keyColumnId_;
+    }
+
+    return result;
+}
+
+ResultCode ShardedClient::InsertRows (const std::string &name, const std::vector <Richard::AnyDataId> &columns,
+                                      Richard::QueryBatch &rows)
+{
+    const OpenedTable *table = nullptr;
+    ResultCode result = FindOpenedTable (name, table);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (rows.columnsCount_ != columns.size ())
+    {
+        return ResultCode::COLUMNS_COUNT_MISMATCH;
+    }
+
+    const std::size_t keyPosition = table->hasKeyColumn_ ?
+                                    std::find (columns.begin (), columns.end (), table->keyColumnId_) -
+                                    columns.begin () : columns.size ();
+
+    // Rows are split by shard positions in table shards vector, not by shard indices.
+    std::vector <Richard::QueryBatch> shardRows (table->shards_.size ());
+    for (Richard::QueryBatch &batch : shardRows)
+    {
+        batch.columnsCount_ = rows.columnsCount_;
+    }
+
+    for (std::size_t row = 0u; row < rows.GetRowsCount (); ++row)
+    {
+        const std::size_t keyIndex = row * rows.columnsCount_ + keyPosition;
+        const Richard::AnyDataContainer *key =
+            keyPosition < columns.size () && !rows.nulls_[keyIndex] ? &rows.values_[keyIndex] : nullptr;
+
+        std::size_t shard;
+        result = shardMap_.FindShard (name, key, shard);
+
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        const std::size_t position =
+            std::lower_bound (table->shards_.begin (), table->shards_.end (), shard) - table->shards_.begin ();
+        assert (position < table->shards_.size () && table->shards_[position] == shard);
+        rows.MoveRowsTo (row, 1u, shardRows[position]);
+    }
+
+    if (!AccessTable (*table, true))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    std::deque <std::future <Response>> inFlight;
+    std::vector <std::size_t> firstRows (table->shards_.size (), 0u);
+    bool rejected = false;
+    bool sent = true;
+
+    // Batches are sent to shards by turns, so all shards insert rows at once.
+    while (sent && !rejected)
+    {
+        sent = false;
+        for (std::size_t position = 0u; position < table->shards_.size () && !rejected; ++position)
+        {
+            Richard::QueryBatch &batch = shardRows[position];
+            if (firstRows[position] >= batch.GetRowsCount ())
+            {
+                continue;
+            }
+
+            Messaging::AddRowsRequest request {};
+            request.tableId_ = table->tableIds_[position];
+            request.rowsCount_ = std::min (ROWS_PER_REQUEST, batch.GetRowsCount () - firstRows[position]);
+            request.columns_ = columns;
+
+            const std::size_t firstValue = firstRows[position] * batch.columnsCount_;
+            for (std::size_t index = 0u; index < request.rowsCount_ * batch.columnsCount_; ++index)
+            {
+                if (!batch.nulls_[firstValue + index])
+                {
+                    request.values_.emplace_back (index, std::move (batch.values_[firstValue + index]));
+                }
+            }
+
+            if (inFlight.size () == REQUESTS_IN_FLIGHT * table->shards_.size ())
+            {
+                rejected = !Connection::Wait (inFlight.front (), "add rows");
+                inFlight.pop_front ();
+            }
+
+            inFlight.emplace_back (
+                connections_[table->shards_[position]]->Send (Messaging::Message::ADD_ROWS_REQUEST, request));
+            firstRows[position] += request.rowsCount_;
+            sent = true;
+        }
+    }
+
+    while (!inFlight.empty ())
+    {
+        rejected |= !Connection::Wait (inFlight.front (), "add rows");
+        inFlight.pop_front ();
+    }
+
+    if (!ReleaseTable (*table, true) || rejected)
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode ShardedClient::Scan (const std::string &name, Messaging::ExecuteQueryRequest &query,
+                                Richard::QueryBatch &output)
+{
+    if (!query.groupColumns_.empty () || !query.aggregates_.empty ())
+    {
+        return ResultCode::SHARDED_AGGREGATION_IS_NOT_SUPPORTED;
+    }
+
+    const OpenedTable *table = nullptr;
+    ResultCode result = FindOpenedTable (name, table);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (!AccessTable (*table, false))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    // Any shard could produce all rows of merged output, therefore every shard skips nothing.
+    const uint64_t offset = query.offset_;
+    const uint64_t limit = query.limit_;
+    query.offset_ = 0u;
+    query.limit_ = limit > std::numeric_limits <uint64_t>::max () - offset ?
+                   std::numeric_limits <uint64_t>::max () : offset + limit;
+
+    std::vector <Response> shardOutputs;
+    const bool executed = ExecuteOnShards (
+        table->shards_, Messaging::Message::EXECUTE_QUERY_REQUEST, query,
+        [table] (std::size_t position, Messaging::ExecuteQueryRequest &request)
+        {
+            request.tableId_ = table->tableIds_[position];
+        },
+        "execute query on table \"" + name + "\"", &shardOutputs);
+
+    query.offset_ = offset;
+    query.limit_ = limit;
+
+    if (!ReleaseTable (*table, false) || !executed)
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    output = Richard::QueryBatch {};
+    for (const Response &shardOutput : shardOutputs)
+    {
+        output.columnsCount_ = std::max (output.columnsCount_, shardOutput.rows_.columnsCount_);
+    }
+
+    if (query.order_.empty ())
+    {
+        Concatenate (shardOutputs, offset, limit, output);
+    }
+    else
+    {
+        MergeSorted (query.order_, shardOutputs, offset, limit, output);
+    }
+
+    return ResultCode::OK;
+}
+
+bool ShardedClient::AccessTable (const OpenedTable &table, bool write)
+{
+    Messaging::ConduitVoidActionRequest conduitRequest {};
+    Messaging::TableOperationRequest tableRequest {};
+
+    if (!ExecuteOnShards (table.shards_, Messaging::Message::GET_CONDUIT_READ_ACCESS_REQUEST, conduitRequest,
+                          [] (std::size_t, Messaging::ConduitVoidActionRequest &)
+                          {
+                          },
+                          "get conduit read access") ||
+        !ExecuteOnShards (table.shards_, write ? Messaging::Message::GET_TABLE_WRITE_ACCESS_REQUEST :
+                                         Messaging::Message::GET_TABLE_READ_ACCESS_REQUEST, tableRequest,
+                          [&table] (std::size_t position, Messaging::TableOperationRequest &request)
+                          {
+                              request.tableId_ = table.tableIds_[position];
+                          },
+                          write ? "get table write access" : "get table read access"))
+    {
+        ReleaseTable (table, write);
+        return false;
+    }
+
+    return true;
+}
+
+bool ShardedClient::ReleaseTable (const OpenedTable &table, bool write)
+{
+    std::vector <std::future <Response>> responses;
+    for (std::size_t position = 0u; position < table.shards_.size (); ++position)
+    {
+        Messaging::TableOperationRequest request {};
+        request.tableId_ = table.tableIds_[position];
+        responses.emplace_back (connections_[table.shards_[position]]->Send (
+            write ? Messaging::Message::CLOSE_TABLE_WRITE_ACCESS_REQUEST :
+            Messaging::Message::CLOSE_TABLE_READ_ACCESS_REQUEST, request));
+    }
+
+    // Access could be captured only on some shards, so errors are not logged.
+    bool released = true;
+    for (std::future <Response> &response : responses)
+    {
+        released &= response.get ().result_ == Messaging::OperationResult::OK;
+    }
+
+    responses.clear ();
+    for (std::size_t shard : table.shards_)
+    {
+        Messaging::ConduitVoidActionRequest request {};
+        responses.emplace_back (
+            connections_[shard]->Send (Messaging::Message::CLOSE_CONDUIT_READ_ACCESS_REQUEST, request));
+    }
+
+    for (std::future <Response> &response : responses)
+    {
+        released &= response.get ().result_ == Messaging::OperationResult::OK;
+    }
+
+    return released;
+}
+
+ResultCode ShardedClient::FindTableOnShard (std::size_t shard, const std::string &name,
+                                            Messaging::ResourceId &output)
+{
+    Connection &connection = *connections_[shard];
+    Messaging::ConduitVoidActionRequest conduitRequest {};
+    Response tableIds;
+
+    if (!connection.Execute (Messaging::Message::GET_CONDUIT_READ_ACCESS_REQUEST, conduitRequest,
+                             "get conduit read access"))
+    {
+        return ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    ResultCode result = connection.Execute (Messaging::Message::GET_TABLE_IDS_REQUEST, conduitRequest,
+                                            "get table ids", tableIds) ?
+                        ResultCode::TABLE_NOT_FOUND_ON_SHARD : ResultCode::SERVER_REJECTED_REQUEST;
+
+    // Table name could be read only under table access, so tables are checked one by one.
+    for (std::size_t index = 0u; index < tableIds.ids_.size () && result == ResultCode::TABLE_NOT_FOUND_ON_SHARD;
+         ++index)
+    {
+        Messaging::TableOperationRequest request {};
+        request.tableId_ = tableIds.ids_[index];
+        Response tableName;
+
+        if (!connection.Execute (Messaging::Message::GET_TABLE_READ_ACCESS_REQUEST, request,
+                                 "get table read access"))
+        {
+            result = ResultCode::SERVER_REJECTED_REQUEST;
+            break;
+        }
+
+        if (!connection.Execute (Messaging::Message::GET_TABLE_NAME_REQUEST, request, "get table name", tableName))
+        {
+            result = ResultCode::SERVER_REJECTED_REQUEST;
+        }
+        else if (tableName.name_ == name)
+        {
+            output = request.tableId_;
+            result = ResultCode::OK;
+        }
+
+        if (!connection.Execute (Messaging::Message::CLOSE_TABLE_READ_ACCESS_REQUEST, request,
+                                 "close table read access"))
+        {
+            result = ResultCode::SERVER_REJECTED_REQUEST;
+        }
+    }
+
+    if (!connection.Execute (Messaging::Message::CLOSE_CONDUIT_READ_ACCESS_REQUEST, conduitRequest,
+                             "close conduit read access"))
+    {
+        result = ResultCode::SERVER_REJECTED_REQUEST;
+    }
+
+    if (result == ResultCode::TABLE_NOT_FOUND_ON_SHARD)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR, "Table \"" + name + "\" is not found on shard " + std::to_string (shard) + "!");
+    }
+
+    return result;
+}
+
+ResultCode ShardedClient::FindOpenedTable (const std::string &name, const OpenedTable *&output) const
+{
+    if (connections_.size () != shardMap_.GetShardsCount ())
+    {
+        return ResultCode::UNABLE_TO_CONNECT;
+    }
+
+    auto iterator = tables_.find (name);
+    if (iterator == tables_.end ())
+    {
+        return shardMap_.FindTable (name) ? ResultCode::TABLE_IS_NOT_OPENED : ResultCode::TABLE_IS_NOT_IN_SHARD_MAP;
+    }
+
+    output = &iterator->second;
+    return ResultCode::OK;
+}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Query.hpp>
+
+#include <App/Miami/Messaging/Message.hpp>
+#include <App/Miami/Sharding/Connection.hpp>
+#include <App/Miami/Sharding/ResultCode.hpp>
+#include <App/Miami/Sharding/ShardMap.hpp>
+
+namespace Miami::App::Sharding
+{
+/// Routes requests for tables of shard map to servers. Every shard is accessed through its own connection.
+/// Request for several shards is sent to all of them before waiting for any response, so shards process it in
+/// parallel. Tables are created with the same columns in the same order on every shard, therefore column ids are
+/// equal on all shards, but table ids are not. Methods must not be called concurrently.
+class ShardedClient final
+{
+public:
+    /// Sent ADD_ROWS_REQUEST contains at most this count of rows.
+    static constexpr std::size_t ROWS_PER_REQUEST = 1024u;
+
+    /// Count of ADD_ROWS_REQUEST messages per shard, that could be sent before previous ones are answered.
+    static constexpr std::size_t REQUESTS_IN_FLIGHT = 16u;
+
+    ShardedClient (Disco::Context *multithreadingContext, moved_in ShardMap &shardMap);
+
+    ShardedClient (const ShardedClient &another) = delete;
+
+    ShardedClient (ShardedClient &&another) = delete;
+
+    ~ShardedClient () = default;
+
+    free_call ResultCode Connect ();
+
+    free_call const ShardMap &GetShardMap () const;
+
+    /// Creates table on all its shards. Key column of hash and range tables is added before given columns,
+    /// output contains ids of given columns only.
+    free_call ResultCode CreateTable (const std::string &name, const std::vector <Richard::ColumnInfo> &columns,
+                                      std::vector <Richard::AnyDataId> &outputColumnIds);
+
+    /// Finds table, that was created by another client, on all its shards and checks that its columns are equal.
+    /// Output contains all columns, including key column.
+    free_call ResultCode OpenTable (const std::string &name, std::vector <Richard::ColumnInfo> &outputColumns);
+
+    free_call ResultCode GetKeyColumnId (const std::string &name, Richard::AnyDataId &output) const;
+
+    /// Routes rows by key column value. Row without key value has null key. Rows are inserted by batches, that
+    /// are not reverted on failure, so some rows could stay inserted if error is returned.
+    free_call ResultCode InsertRows (const std::string &name, const std::vector <Richard::AnyDataId> &columns,
+                                     moved_in Richard::QueryBatch &rows);
+
+    /// Executes query on every shard of table and merges outputs into one batch. Sorted outputs are merged by
+    /// query order, other outputs are concatenated in order of shards. Offset and limit are applied after merge.
+    /// Aggregated queries are not supported, because partial aggregates of some functions could not be merged.
+    /// Query table id is ignored.
+    free_call ResultCode Scan (const std::string &name, Messaging::ExecuteQueryRequest &query,
+                               Richard::QueryBatch &output);
+
+private:
+    struct OpenedTable
+    {
+        std::vector <std::size_t> shards_;
+
+        /// Ids of table on shards, in order of ::shards_.
+        std::vector <Messaging::ResourceId> tableIds_;
+
+        bool hasKeyColumn_ = false;
+        Richard::AnyDataId keyColumnId_ = 0u;
+    };
+
+    /// Sends request to all given shards and then waits for all responses. Prepare callback receives position
+    /// of shard in given vector and adjusts request for it. Outputs, if given, are placed in the same order.
+    template <typename Request, typename Prepare>
+    bool ExecuteOnShards (const std::vector <std::size_t> &shards, Messaging::Message messageType, Request &request,
+                          Prepare prepare, const std::string &action, std::vector <Response> *outputs = nullptr);
+
+    /// Captures conduit read access and table access on all shards of table. Access is released on failure.
+    free_call bool AccessTable (const OpenedTable &table, bool write);
+
+    /// Releases access, captured by ::AccessTable, even if it was captured only on some shards.
+    /// Returns false if any shard rejected release.
+    bool ReleaseTable (const OpenedTable &table, bool write);
+
+    free_call ResultCode FindTableOnShard (std::size_t shard, const std::string &name,
+                                           Messaging::ResourceId &output);
+
+    free_call ResultCode FindOpenedTable (const std::string &name, const OpenedTable *&output) const;
+
+    Disco::Context *multithreadingContext_;
+    ShardMap shardMap_;
+    std::vector <std::unique_ptr <Connection>> connections_;
+    std::unordered_map <std::string, OpenedTable> tables_;
+};
+}
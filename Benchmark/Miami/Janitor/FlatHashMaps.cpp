@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+#include <Miami/Janitor/FlatHashSet.hpp>
+
+using namespace Miami::Janitor;
+
+// Keys are generated from fixed seed, so every run and every container measures the same sequence of operations.
+static constexpr uint64_t KEYS_SEED = 0x4D69616D69u;
+
+static std::vector <uint64_t> GenerateKeys (std::size_t count, uint64_t seed = KEYS_SEED)
+{
+    std::mt19937_64 generator (seed);
+    std::vector <uint64_t> keys (count);
+
+    for (uint64_t &key : keys)
+    {
+        key = generator ();
+    }
+
+    return keys;
+}
+
+/// Lookups visit keys in order, that differs from insertion order, so they are not helped by insertion locality.
+static std::vector <uint64_t> Shuffled (std::vector <uint64_t> keys)
+{
+    std::shuffle (keys.begin (), keys.end (), std::mt19937_64 (KEYS_SEED + 1u));
+    return keys;
+}
+
+template <typename Map>
+static void FindExisting (benchmark::State &state)
+{
+    const std::vector <uint64_t> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    const std::vector <uint64_t> lookups = Shuffled (keys);
+    Map map;
+
+    for (uint64_t key : keys)
+    {
+        map.emplace (key, key);
+    }
+
+    for (auto _ : state)
+    {
+        for (uint64_t key : lookups)
+        {
+            benchmark::DoNotOptimize (map.find (key));
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * lookups.size ()));
+}
+
+template <typename Map>
+static void FindMissing (benchmark::State &state)
+{
+    const std::vector <uint64_t> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    const std::vector <uint64_t> lookups = GenerateKeys (keys.size (), KEYS_SEED + 2u);
+    Map map;
+
+    for (uint64_t key : keys)
+    {
+        map.emplace (key, key);
+    }
+
+    for (auto _ : state)
+    {
+        for (uint64_t key : lookups)
+        {
+            benchmark::DoNotOptimize (map.find (key));
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * lookups.size ()));
+}
+
+template <typename Map>
+static void InsertWithoutReserve (benchmark::State &state)
+{
+    const std::vector <uint64_t> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    for (auto _ : state)
+    {
+        Map map;
+        for (uint64_t key : keys)
+        {
+            map.emplace (key, key);
+        }
+
+        benchmark::DoNotOptimize (map.size ());
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * keys.size ()));
+}
+
+/// Erases and reinserts every key, like row id maps of tables with insert and delete churn.
+template <typename Map>
+static void EraseAndInsert (benchmark::State &state)
+{
+    const std::vector <uint64_t> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    const std::vector <uint64_t> churn = Shuffled (keys);
+    Map map;
+
+    for (uint64_t key : keys)
+    {
+        map.emplace (key, key);
+    }
+
+    for (auto _ : state)
+    {
+        for (uint64_t key : churn)
+        {
+            map.erase (key);
+            map.emplace (key, key);
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * churn.size ()));
+}
+
+template <typename Set>
+static void SetContains (benchmark::State &state)
+{
+    const std::vector <uint64_t> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    const std::vector <uint64_t> lookups = Shuffled (keys);
+    Set set;
+
+    for (uint64_t key : keys)
+    {
+        set.emplace (key);
+    }
+
+    for (auto _ : state)
+    {
+        for (uint64_t key : lookups)
+        {
+            benchmark::DoNotOptimize (set.count (key));
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * lookups.size ()));
+}
+
+struct StringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator () (std::string_view string) const
+    {
+        return std::hash <std::string_view> () (string);
+    }
+};
+
+/// Lookup by names, like conduit tables and session entries, without constructing std::string for every lookup.
+static void FindByStringView (benchmark::State &state)
+{
+    const std::vector <uint64_t> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    FlatHashMap <std::string, uint64_t, StringHash, std::equal_to <>> map;
+    std::vector <std::string> names;
+
+    for (uint64_t key : keys)
+    {
+        names.emplace_back ("table_" + std::to_string (key));
+        map.emplace (names.back (), key);
+    }
+
+    for (auto _ : state)
+    {
+        for (const std::string &name : names)
+        {
+            benchmark::DoNotOptimize (map.find (std::string_view (name)));
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * names.size ()));
+}
+
+#define MIAMI_MAP_BENCHMARK(Function)                                                                                 \
+    BENCHMARK_TEMPLATE (Function, FlatHashMap <uint64_t, uint64_t>)->RangeMultiplier (16)->Range (64, 1 << 20);       \
+    BENCHMARK_TEMPLATE (Function, std::unordered_map <uint64_t, uint64_t>)->RangeMultiplier (16)->Range (64, 1 << 20)
+
+MIAMI_MAP_BENCHMARK (FindExisting);
+MIAMI_MAP_BENCHMARK (FindMissing);
+MIAMI_MAP_BENCHMARK (InsertWithoutReserve);
+MIAMI_MAP_BENCHMARK (EraseAndInsert);
+
+BENCHMARK_TEMPLATE (SetContains, FlatHashSet <uint64_t>)->RangeMultiplier (16)->Range (64, 1 << 20);
+BENCHMARK_TEMPLATE (SetContains, std::unordered_set <uint64_t>)->RangeMultiplier (16)->Range (64, 1 << 20);
+BENCHMARK (FindByStringView)->RangeMultiplier (16)->Range (64, 1 << 16);
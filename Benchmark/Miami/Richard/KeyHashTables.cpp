@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Miami/Richard/KeyHashTable.hpp>
+
+using namespace Miami::Richard;
+
+// Keys are generated from fixed seed, so every run measures the same sequence of operations.
+static constexpr uint64_t KEYS_SEED = 0x526963686172u;
+
+/// Normalized keys of one not null INT64 column, like keys of hash indices: null flag followed by value bytes.
+static std::vector <KeyHashTable::Key> GenerateKeys (std::size_t count, uint64_t seed = KEYS_SEED)
+{
+    std::mt19937_64 generator (seed);
+    std::vector <KeyHashTable::Key> keys (count);
+
+    for (KeyHashTable::Key &key : keys)
+    {
+        const uint64_t value = generator ();
+        key.resize (1u + sizeof (value));
+        key[0] = 0u;
+        memcpy (&key[1], &value, sizeof (value));
+    }
+
+    return keys;
+}
+
+static void KeyTableInsert (benchmark::State &state)
+{
+    const std::vector <KeyHashTable::Key> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    for (auto _ : state)
+    {
+        KeyHashTable table;
+        for (std::size_t index = 0u; index < keys.size (); ++index)
+        {
+            table.Insert (keys[index], index);
+        }
+
+        benchmark::DoNotOptimize (table.GetKeyCount ());
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * keys.size ()));
+}
+
+static void KeyTableFindExisting (benchmark::State &state)
+{
+    const std::vector <KeyHashTable::Key> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    KeyHashTable table;
+
+    for (std::size_t index = 0u; index < keys.size (); ++index)
+    {
+        table.Insert (keys[index], index);
+    }
+
+    for (auto _ : state)
+    {
+        for (const KeyHashTable::Key &key : keys)
+        {
+            benchmark::DoNotOptimize (table.Find (key));
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * keys.size ()));
+}
+
+static void KeyTableFindMissing (benchmark::State &state)
+{
+    const std::vector <KeyHashTable::Key> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    const std::vector <KeyHashTable::Key> lookups = GenerateKeys (keys.size (), KEYS_SEED + 1u);
+    KeyHashTable table;
+
+    for (std::size_t index = 0u; index < keys.size (); ++index)
+    {
+        table.Insert (keys[index], index);
+    }
+
+    for (auto _ : state)
+    {
+        for (const KeyHashTable::Key &key : lookups)
+        {
+            benchmark::DoNotOptimize (table.Find (key));
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * lookups.size ()));
+}
+
+/// Erases and reinserts rows, like hash index of table with update churn.
+static void KeyTableEraseAndInsert (benchmark::State &state)
+{
+    const std::vector <KeyHashTable::Key> keys = GenerateKeys (static_cast <std::size_t> (state.range (0)));
+    KeyHashTable table;
+
+    for (std::size_t index = 0u; index < keys.size (); ++index)
+    {
+        table.Insert (keys[index], index);
+    }
+
+    for (auto _ : state)
+    {
+        for (std::size_t index = 0u; index < keys.size (); ++index)
+        {
+            table.Erase (keys[index], index);
+            table.Insert (keys[index], index);
+        }
+    }
+
+    state.SetItemsProcessed (static_cast <int64_t> (state.iterations () * keys.size ()));
+}
+
+BENCHMARK (KeyTableInsert)->RangeMultiplier (16)->Range (64, 1 << 20);
+BENCHMARK (KeyTableFindExisting)->RangeMultiplier (16)->Range (64, 1 << 20);
+BENCHMARK (KeyTableFindMissing)->RangeMultiplier (16)->Range (64, 1 << 20);
+BENCHMARK (KeyTableEraseAndInsert)->RangeMultiplier (16)->Range (64, 1 << 20);
@@ -81,6 +81,21 @@ void TaskPool::Push (std::function <void ()> task)
     tasksAvailable_.notify_one ();
 }
 
+bool TaskPool::TryPush (std::function <void ()> &task)
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    if (IncreaseIndex (end_) == begin_)
+    {
+        return false;
+    }
+
+    content_[end_] = std::move (task);
+    end_ = IncreaseIndex (end_);
+    lock.unlock ();
+    tasksAvailable_.notify_one ();
+    return true;
+}
+
 std::function <void ()> TaskPool::Pop (const std::chrono::milliseconds &timeout)
 {
     std::unique_lock <std::mutex> lock (guard_);
@@ -152,6 +167,11 @@ TaskPool &Context::Tasks ()
     return taskPool_;
 }
 
+uint32_t Context::GetWorkersCount () const
+{
+    return static_cast <uint32_t> (workers_.size ());
+}
+
 KernelModeGuard &Context::KernelMode ()
 {
     return kernelModeGuard_;
@@ -63,6 +63,9 @@ public:
 
     void Push (std::function <void ()> task);
 
+    /// Returns false instead of waiting if there is no free space.
+    bool TryPush (std::function <void ()> &task);
+
     std::function <void ()> Pop (const std::chrono::milliseconds &timeout);
 
 private:
@@ -88,6 +91,8 @@ public:
 
     free_call TaskPool &Tasks ();
 
+    free_call uint32_t GetWorkersCount () const;
+
     free_call KernelModeGuard &KernelMode ();
 
     free_call bool IsShuttingDown () const;
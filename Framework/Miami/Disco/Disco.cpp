@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <Miami/Disco/Disco.hpp>
 
@@ -46,6 +48,69 @@ void After (const std::vector <AnyLockPointer> &locks, MultipleLockGroup::NextLa
     }
 }
 
+void ParallelFor (Context *context, std::size_t count, const std::function <void (std::size_t)> &function)
+{
+    // Helpers could start after all indices are done, so state outlives this call and
+    // function is accessed only by threads, that managed to take index for execution.
+    struct State
+    {
+        std::atomic <std::size_t> next_ {0u};
+        std::size_t finished_ = 0u;
+        std::mutex guard_;
+        std::condition_variable allFinished_;
+        const std::function <void (std::size_t)> *function_ = nullptr;
+        std::size_t count_ = 0u;
+    };
+
+    auto state = std::make_shared <State> ();
+    state->function_ = &function;
+    state->count_ = count;
+
+    auto execute = [] (State &state)
+    {
+        std::size_t executed = 0u;
+        for (std::size_t index = state.next_++; index < state.count_; index = state.next_++)
+        {
+            (*state.function_) (index);
+            ++executed;
+        }
+
+        if (executed > 0u)
+        {
+            std::unique_lock <std::mutex> lock (state.guard_);
+            state.finished_ += executed;
+            if (state.finished_ == state.count_)
+            {
+                state.allFinished_.notify_all ();
+            }
+        }
+    };
+
+    const std::size_t helpersCount = context && count > 1u ?
+                                     std::min <std::size_t> (count - 1u, context->GetWorkersCount ()) : 0u;
+
+    for (std::size_t helperIndex = 0u; helperIndex < helpersCount; ++helperIndex)
+    {
+        std::function <void ()> helper = [state, execute]
+        {
+            execute (*state);
+        };
+
+        if (!context->Tasks ().TryPush (helper))
+        {
+            break;
+        }
+    }
+
+    execute (*state);
+    std::unique_lock <std::mutex> lock (state->guard_);
+    state->allFinished_.wait (lock,
+                              [&state]
+                              {
+                                  return state->finished_ == state->count_;
+                              });
+}
+
 bool IsReadOrWriteCaptured (
     const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard, const ReadWriteGuard &guard)
 {
@@ -57,4 +122,9 @@ bool IsWriteCaptured (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
 {
     return writeGuard != nullptr && writeGuard->Is (&guard.Write ());
 }
+
+bool IsIntentCaptured (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard, const ReadWriteGuard &guard)
+{
+    return intentGuard != nullptr && intentGuard->Is (&guard.Intent ());
+}
 }
\ No newline at end of file
@@ -14,12 +14,19 @@ void After (const AnyLockPointer &lock, OneLockGroup::NextLambda next,
 void After (const std::vector <AnyLockPointer> &locks, MultipleLockGroup::NextLambda next,
             MultipleLockGroup::CancelLambda cancel = nullptr);
 
+/// Calls function for every index from zero to count exclusively. Calling thread executes indices too and helper
+/// tasks are pushed only while task pool has free space, so it is safe to call it from context worker.
+void ParallelFor (Context *context, std::size_t count, const std::function <void (std::size_t)> &function);
+
 bool IsReadOrWriteCaptured (
     const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard, const ReadWriteGuard &guard);
 
 bool IsWriteCaptured (
     const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, const ReadWriteGuard &guard);
 
+bool IsIntentCaptured (
+    const std::shared_ptr <Disco::SafeLockGuard> &intentGuard, const ReadWriteGuard &guard);
+
 template <typename Lock>
 void After (Lock *lock, OneLockGroup::NextLambda next,
             OneLockGroup::CancelLambda cancel = nullptr)
@@ -145,7 +145,7 @@ bool ReadLock::TryLock ()
 bool ReadLock::TryLock (KernelModeGuard::RAII &kernelModeGuard)
 {
     assert(kernelModeGuard.IsValid ());
-    if (owner_ && !owner_->anyWriter_)
+    if (owner_ && !owner_->anyWriter_ && owner_->intentsCount_ == 0)
     {
         ++owner_->readersCount_;
         return true;
@@ -187,10 +187,11 @@ void ReadLock::Unlock (bool silently, KernelModeGuard::RAII &kernelModeGuard)
             //       Find way to somehow mix readers and writers without given priority to either of them.
             InformGroupsAboutUnblock (kernelModeGuard);
 
-            // If there is no readers left, we should inform write lock dependant groups too.
+            // If there is no readers left, we should inform write and intent lock dependant groups too.
             if (owner_->readersCount_ == 0)
             {
                 owner_->Write ().InformGroupsAboutUnblock (kernelModeGuard);
+                owner_->Intent ().InformGroupsAboutUnblock (kernelModeGuard);
             }
         }
     }
@@ -204,7 +205,7 @@ bool WriteLock::TryLock ()
 bool WriteLock::TryLock (KernelModeGuard::RAII &kernelModeGuard)
 {
     assert(kernelModeGuard.IsValid ());
-    if (owner_ && !owner_->anyWriter_ && owner_->readersCount_ == 0)
+    if (owner_ && !owner_->anyWriter_ && owner_->readersCount_ == 0 && owner_->intentsCount_ == 0)
     {
         owner_->anyWriter_ = true;
         return true;
@@ -243,8 +244,61 @@ void WriteLock::Unlock (bool silently, KernelModeGuard::RAII &kernelModeGuard)
         if (!silently)
         {
             InformGroupsAboutUnblock (kernelModeGuard);
-            // We should inform read lock dependant groups about unblock too.
+            // We should inform read and intent lock dependant groups about unblock too.
+            owner_->Read ().InformGroupsAboutUnblock (kernelModeGuard);
+            owner_->Intent ().InformGroupsAboutUnblock (kernelModeGuard);
+        }
+    }
+}
+
+bool IntentLock::TryLock ()
+{
+    TRY_CALL_WITH_KERNEL_MODE(TryLock) OTHERWISE(false)
+}
+
+bool IntentLock::TryLock (KernelModeGuard::RAII &kernelModeGuard)
+{
+    assert(kernelModeGuard.IsValid ());
+    if (owner_ && !owner_->anyWriter_ && owner_->readersCount_ == 0)
+    {
+        ++owner_->intentsCount_;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void IntentLock::Unlock ()
+{
+    TRY_CALL_WITH_KERNEL_MODE(Unlock)
+}
+
+void IntentLock::Unlock (KernelModeGuard::RAII &kernelModeGuard)
+{
+    Unlock (false, kernelModeGuard);
+}
+
+IntentLock::IntentLock (ReadWriteGuard *owner, Context *context)
+    : BaseLock (context),
+      owner_ (owner)
+{
+    assert(owner);
+}
+
+void IntentLock::Unlock (bool silently, KernelModeGuard::RAII &kernelModeGuard)
+{
+    assert(kernelModeGuard.IsValid ());
+    if (owner_)
+    {
+        assert(owner_->intentsCount_ > 0);
+        --owner_->intentsCount_;
+
+        if (!silently && owner_->intentsCount_ == 0)
+        {
             owner_->Read ().InformGroupsAboutUnblock (kernelModeGuard);
+            owner_->Write ().InformGroupsAboutUnblock (kernelModeGuard);
         }
     }
 }
@@ -252,7 +306,9 @@ void WriteLock::Unlock (bool silently, KernelModeGuard::RAII &kernelModeGuard)
 ReadWriteGuard::ReadWriteGuard (Context *context)
     : read_ (this, context),
       write_ (this, context),
+      intent_ (this, context),
       readersCount_ (0),
+      intentsCount_ (0),
       anyWriter_ (false)
 {
 
@@ -268,6 +324,11 @@ WriteLock &ReadWriteGuard::Write ()
     return write_;
 }
 
+IntentLock &ReadWriteGuard::Intent ()
+{
+    return intent_;
+}
+
 const ReadLock &ReadWriteGuard::Read () const
 {
     return read_;
@@ -277,4 +338,9 @@ const WriteLock &ReadWriteGuard::Write () const
 {
     return write_;
 }
+
+const IntentLock &ReadWriteGuard::Intent () const
+{
+    return intent_;
+}
 }
\ No newline at end of file
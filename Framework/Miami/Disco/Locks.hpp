@@ -2,12 +2,13 @@
 
 #include <cstdint>
 #include <vector>
-#include <unordered_set>
 
 #include <Miami/Disco/Annotations.hpp>
 #include <Miami/Disco/Context.hpp>
 #include <Miami/Disco/Variants.hpp>
 
+#include <Miami/Janitor/FlatHashSet.hpp>
+
 namespace Miami::Disco
 {
 // TODO: Think about copy and move constructors.
@@ -38,8 +39,7 @@ private:
     // TODO: Use FlatHashSet?
     std::vector <AnyLockGroupPointer> dependantGroups_;
 
-    // TODO: Use FlatHashSet?
-    std::unordered_set<SafeLockGuard *> dependantGuards_;
+    Janitor::FlatHashSet <SafeLockGuard *> dependantGuards_;
 };
 
 class Lock final : public BaseLock
@@ -96,6 +96,41 @@ private:
     friend class ReadWriteGuard;
 
     friend class WriteLock;
+
+    friend class IntentLock;
+};
+
+/// Intent to change separate parts of guarded object, for example rows of a table. Intent locks are compatible
+/// with each other, but not with read and write locks, so intent holders must coordinate through finer locks.
+class IntentLock final : public BaseLock
+{
+public:
+    static constexpr LockType LOCK_TYPE = LockType::INTENT_LOCK;
+
+    kernel_call bool TryLock ();
+
+    bool TryLock (KernelModeGuard::RAII &kernelModeGuard);
+
+    kernel_call void Unlock ();
+
+    void Unlock (KernelModeGuard::RAII &kernelModeGuard);
+
+    IntentLock &operator = (const IntentLock &another) = delete;
+
+private:
+    explicit IntentLock (ReadWriteGuard *owner, Context *context);
+
+    void Unlock (bool silently, KernelModeGuard::RAII &kernelModeGuard);
+
+    ReadWriteGuard *owner_;
+
+    friend class AnyLockPointer;
+
+    friend class ReadWriteGuard;
+
+    friend class ReadLock;
+
+    friend class WriteLock;
 };
 
 class WriteLock final : public BaseLock
@@ -125,6 +160,8 @@ private:
     friend class ReadWriteGuard;
 
     friend class ReadLock;
+
+    friend class IntentLock;
 };
 
 class ReadWriteGuard final
@@ -136,21 +173,29 @@ public:
 
     WriteLock &Write ();
 
+    IntentLock &Intent ();
+
     const ReadLock &Read () const;
 
     const WriteLock &Write () const;
 
+    const IntentLock &Intent () const;
+
     ReadWriteGuard &operator = (const ReadWriteGuard &another) = delete;
 
 private:
     ReadLock read_;
     WriteLock write_;
+    IntentLock intent_;
 
     uint32_t readersCount_;
+    uint32_t intentsCount_;
     bool anyWriter_;
 
     friend class ReadLock;
 
     friend class WriteLock;
+
+    friend class IntentLock;
 };
 }
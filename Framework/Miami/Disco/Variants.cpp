@@ -21,18 +21,19 @@ assert(!group_);
 return Default;
 
 // TODO: Instead of using switch, create static array?
-#define CALL_LOCK_METHOD(MethodName, Default, ...)                                                    \
-if (lock_)                                                                                            \
-{                                                                                                     \
-    switch (lockType_)                                                                                \
-    {                                                                                                 \
-        case LockType::LOCK: return static_cast<Lock *> (lock_)->MethodName (__VA_ARGS__);            \
-        case LockType::READ_LOCK: return static_cast<ReadLock *> (lock_)->MethodName (__VA_ARGS__);   \
-        case LockType::WRITE_LOCK: return static_cast<WriteLock *> (lock_)->MethodName (__VA_ARGS__); \
-    }                                                                                                 \
-}                                                                                                     \
-                                                                                                      \
-assert(!lock_);                                                                                       \
+#define CALL_LOCK_METHOD(MethodName, Default, ...)                                                      \
+if (lock_)                                                                                              \
+{                                                                                                       \
+    switch (lockType_)                                                                                  \
+    {                                                                                                   \
+        case LockType::LOCK: return static_cast<Lock *> (lock_)->MethodName (__VA_ARGS__);              \
+        case LockType::READ_LOCK: return static_cast<ReadLock *> (lock_)->MethodName (__VA_ARGS__);     \
+        case LockType::WRITE_LOCK: return static_cast<WriteLock *> (lock_)->MethodName (__VA_ARGS__);   \
+        case LockType::INTENT_LOCK: return static_cast<IntentLock *> (lock_)->MethodName (__VA_ARGS__); \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+assert(!lock_);                                                                                         \
 return Default;
 
 bool AnyLockGroupPointer::operator == (const AnyLockGroupPointer &other) const
@@ -12,13 +12,16 @@ class ReadLock;
 
 class WriteLock;
 
+class IntentLock;
+
 class SafeLockGuard;
 
 enum class LockType
 {
     LOCK = 0,
     READ_LOCK,
-    WRITE_LOCK
+    WRITE_LOCK,
+    INTENT_LOCK
 };
 
 enum class LockGroupType
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <cstdint>
-#include <unordered_map>
 #include <memory>
 
 #include <Miami/Annotations.hpp>
 
 #include <Miami/Disco/Disco.hpp>
 
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+
 #include <Miami/Hotline/ResultCode.hpp>
 
 namespace Miami::Hotline
@@ -34,8 +37,7 @@ private:
     free_call bool CheckWriteGuard (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard) const;
 
     Disco::ReadWriteGuard guard_;
-    // TODO: Use flat hash map.
-    std::unordered_map <EntryTypeId, std::shared_ptr <void>> entries_;
+    Janitor::FlatHashMap <EntryTypeId, std::shared_ptr <void>> entries_;
 };
 
 template <typename Entry>
@@ -54,6 +54,7 @@ ResultCode SocketClient::Start (const std::string &host, const std::string &serv
         Evan::Logger::Get ().Log (
             Evan::LogLevel::ERROR,
             "Unable to connect to endpoint due to io error: " + error.message () + ".");
+        delete socketSession;
         return ResultCode::SOCKET_IO_ERROR;
     }
 
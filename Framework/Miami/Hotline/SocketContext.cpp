@@ -10,9 +10,9 @@
 namespace Miami::Hotline
 {
 SocketContext::SocketContext ()
-    : sessions_ (),
-      parserFactories_ (),
-      asioContext_ ()
+    : asioContext_ (),
+      sessions_ (),
+      parserFactories_ ()
 {
 }
 
@@ -2,12 +2,13 @@
 
 #include <vector>
 #include <memory>
-#include <unordered_map>
 
 #include <boost/asio/io_context.hpp>
 
 #include <Miami/Annotations.hpp>
 
+#include <Miami/Janitor/FlatHashMap.hpp>
+
 #include <Miami/Hotline/Message.hpp>
 #include <Miami/Hotline/ResultCode.hpp>
 #include <Miami/Hotline/SocketSession.hpp>
@@ -32,12 +33,12 @@ private:
 
     free_call ResultCode AddSession (moved_in SocketSession *session);
 
-    std::vector <std::unique_ptr <SocketSession>> sessions_;
-
-    // TODO: Use flat hash map.
-    std::unordered_map <MessageTypeId, MessageParserFactory> parserFactories_;
+    /// Declared first, because sockets of sessions must be destroyed before context, that owns their services.
     boost::asio::io_context asioContext_;
 
+    std::vector <std::unique_ptr <SocketSession>> sessions_;
+    Janitor::FlatHashMap <MessageTypeId, MessageParserFactory> parserFactories_;
+
     friend class SocketSession;
 
     friend class SocketServer;
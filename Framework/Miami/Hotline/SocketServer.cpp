@@ -34,6 +34,16 @@ ResultCode SocketServer::Start (uint16_t port, bool useIPv6)
         return ResultCode::SOCKET_IO_ERROR;
     }
 
+    // Otherwise restarted server is unable to bind its port while connections of previous run are in TIME_WAIT.
+    acceptor_.set_option (boost::asio::ip::tcp::acceptor::reuse_address (true), error);
+    if (error)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR,
+            "Unable to set acceptor address reuse option due to io error: " + error.message () + ".");
+        return ResultCode::SOCKET_IO_ERROR;
+    }
+
     acceptor_.bind (endpoint, error);
     if (error)
     {
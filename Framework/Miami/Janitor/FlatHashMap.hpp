@@ -0,0 +1,117 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Janitor/FlatHashTable.hpp>
+
+namespace Miami::Janitor
+{
+namespace Details
+{
+struct MapKeyOf final
+{
+    template <typename Pair>
+    free_call static const typename Pair::first_type &Get (const Pair &pair)
+    {
+        return pair.first;
+    }
+};
+}
+
+/// Drop-in replacement for std::unordered_map, that stores elements in flat array. Unlike std map, references
+/// to elements are invalidated by insertions.
+template <typename Key, typename Value, typename Hash = std::hash <Key>, typename Equal = std::equal_to <Key>>
+class FlatHashMap final :
+    public Details::FlatHashTable <Key, std::pair <const Key, Value>, Details::MapKeyOf, Hash, Equal>
+{
+private:
+    using Base = Details::FlatHashTable <Key, std::pair <const Key, Value>, Details::MapKeyOf, Hash, Equal>;
+
+public:
+    using mapped_type = Value;
+    using typename Base::value_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    template <typename LookupKey>
+    using KeyArgument = typename Base::template KeyArgument <LookupKey>;
+
+    FlatHashMap () = default;
+
+    FlatHashMap (std::initializer_list <value_type> elements)
+    {
+        this->reserve (elements.size ());
+        for (const value_type &element : elements)
+        {
+            this->insert (element);
+        }
+    }
+
+    /// Unlike emplace, does not construct value if key is already present.
+    template <typename... Arguments>
+    std::pair <iterator, bool> try_emplace (const Key &key, Arguments &&... arguments)
+    {
+        return TryEmplace (key, std::forward <Arguments> (arguments)...);
+    }
+
+    template <typename... Arguments>
+    std::pair <iterator, bool> try_emplace (Key &&key, Arguments &&... arguments)
+    {
+        return TryEmplace (std::move (key), std::forward <Arguments> (arguments)...);
+    }
+
+    Value &operator [] (const Key &key)
+    {
+        return try_emplace (key).first->second;
+    }
+
+    Value &operator [] (Key &&key)
+    {
+        return try_emplace (std::move (key)).first->second;
+    }
+
+    template <typename LookupKey = Key>
+    free_call Value &at (const KeyArgument <LookupKey> &key)
+    {
+        auto iterator = this->find (key);
+        if (iterator == this->end ())
+        {
+            throw std::out_of_range ("FlatHashMap::at: there is no such key.");
+        }
+
+        return iterator->second;
+    }
+
+    template <typename LookupKey = Key>
+    free_call const Value &at (const KeyArgument <LookupKey> &key) const
+    {
+        auto iterator = this->find (key);
+        if (iterator == this->end ())
+        {
+            throw std::out_of_range ("FlatHashMap::at: there is no such key.");
+        }
+
+        return iterator->second;
+    }
+
+private:
+    template <typename KeyReference, typename... Arguments>
+    std::pair <iterator, bool> TryEmplace (KeyReference &&key, Arguments &&... arguments)
+    {
+        auto [index, inserted] = this->FindOrPrepareInsert (key);
+        if (inserted)
+        {
+            new (this->GetSlot (index)) value_type (std::piecewise_construct,
+                                                    std::forward_as_tuple (std::forward <KeyReference> (key)),
+                                                    std::forward_as_tuple (std::forward <Arguments> (arguments)...));
+        }
+
+        return {this->GetIterator (index), inserted};
+    }
+};
+}
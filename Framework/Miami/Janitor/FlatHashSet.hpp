@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Janitor/FlatHashTable.hpp>
+
+namespace Miami::Janitor
+{
+namespace Details
+{
+struct SetKeyOf final
+{
+    template <typename Key>
+    free_call static const Key &Get (const Key &key)
+    {
+        return key;
+    }
+};
+}
+
+/// Drop-in replacement for std::unordered_set, that stores keys in flat array. Keys must not be changed through
+/// iterators, because it breaks their placement.
+template <typename Key, typename Hash = std::hash <Key>, typename Equal = std::equal_to <Key>>
+class FlatHashSet final : public Details::FlatHashTable <Key, Key, Details::SetKeyOf, Hash, Equal>
+{
+public:
+    FlatHashSet () = default;
+
+    FlatHashSet (std::initializer_list <Key> keys)
+    {
+        this->reserve (keys.size ());
+        for (const Key &key : keys)
+        {
+            this->insert (key);
+        }
+    }
+};
+}
@@ -0,0 +1,728 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <Miami/Annotations.hpp>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIAMI_JANITOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Miami::Janitor::Details
+{
+/// Control bytes of full slots store 7 bits of hash, therefore special control bytes are always negative.
+constexpr int8_t CONTROL_EMPTY = -128;
+constexpr int8_t CONTROL_DELETED = -2;
+
+/// Stored after last slot, so iterators stop without knowing table capacity.
+constexpr int8_t CONTROL_SENTINEL = -1;
+
+/// Count of slots, that are checked by one probing step.
+constexpr std::size_t GROUP_SIZE = 16u;
+
+/// Bit i of match mask is set if slot i of the group matches.
+using MatchMask = uint32_t;
+
+free_call inline uint32_t GetLowestMatch (MatchMask mask)
+{
+    assert (mask != 0u);
+#if defined (__GNUC__) || defined (__clang__)
+    return static_cast <uint32_t> (__builtin_ctz (mask));
+#else
+    uint32_t index = 0u;
+    while ((mask & 1u) == 0u)
+    {
+        mask >>= 1u;
+        ++index;
+    }
+
+    return index;
+#endif
+}
+
+/// Std hashes of integers are usually identity functions, so hashes are mixed before splitting into group index
+/// and control byte.
+free_call inline uint64_t MixHash (std::size_t hash)
+{
+    const uint64_t mixed = static_cast <uint64_t> (hash) * 0x9E3779B97F4A7C15ull;
+    return mixed ^ (mixed >> 32u);
+}
+
+free_call inline int8_t GetControlHash (uint64_t mixedHash)
+{
+    return static_cast <int8_t> (mixedHash >> 57u);
+}
+
+/// View of 16 control bytes, that checks all of them at once if SSE2 is available.
+class Group final
+{
+public:
+    explicit Group (const int8_t *controls)
+#ifdef MIAMI_JANITOR_SSE2
+        : controls_ (_mm_loadu_si128 (reinterpret_cast <const __m128i *> (controls)))
+#else
+        : controls_ (controls)
+#endif
+    {
+    }
+
+    free_call MatchMask Match (int8_t controlHash) const
+    {
+#ifdef MIAMI_JANITOR_SSE2
+        return static_cast <MatchMask> (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_set1_epi8 (controlHash), controls_)));
+#else
+        return MatchPortable ([controlHash] (int8_t control)
+                              { return control == controlHash; });
+#endif
+    }
+
+    free_call MatchMask MatchEmpty () const
+    {
+        return Match (CONTROL_EMPTY);
+    }
+
+    /// Matches empty and deleted slots: both of them are negative, unlike full ones.
+    free_call MatchMask MatchFree () const
+    {
+#ifdef MIAMI_JANITOR_SSE2
+        return static_cast <MatchMask> (_mm_movemask_epi8 (controls_));
+#else
+        return MatchPortable ([] (int8_t control)
+                              { return control < 0; });
+#endif
+    }
+
+private:
+#ifdef MIAMI_JANITOR_SSE2
+    __m128i controls_;
+#else
+    template <typename Predicate>
+    free_call MatchMask MatchPortable (const Predicate &predicate) const
+    {
+        MatchMask mask = 0u;
+        for (std::size_t index = 0u; index < GROUP_SIZE; ++index)
+        {
+            if (predicate (controls_[index]))
+            {
+                mask |= MatchMask (1u) << index;
+            }
+        }
+
+        return mask;
+    }
+
+    const int8_t *controls_;
+#endif
+};
+
+/// Heterogeneous lookup is enabled only for transparent hash and equal functors, like in std containers.
+template <typename Hash, typename Equal, typename = void>
+struct IsTransparent : std::false_type
+{
+};
+
+template <typename Hash, typename Equal>
+struct IsTransparent <Hash, Equal,
+                      std::void_t <typename Hash::is_transparent, typename Equal::is_transparent>> : std::true_type
+{
+};
+
+/// Selected lookup key type must stay deducible, therefore alias of selector member is used instead of conditional.
+template <bool Transparent>
+struct KeyArgumentSelector
+{
+    template <typename LookupKey, typename Key>
+    using Type = Key;
+};
+
+template <>
+struct KeyArgumentSelector <true>
+{
+    template <typename LookupKey, typename Key>
+    using Type = LookupKey;
+};
+
+/// Open addressing hash table, that stores elements in one flat array. Slots are probed by groups: control byte
+/// of each slot stores 7 bits of element hash, so most mismatches are rejected without touching elements.
+/// Element pointers are invalidated by insertions, that trigger rehash.
+template <typename Key, typename Element, typename KeyOf, typename Hash, typename Equal>
+class FlatHashTable
+{
+public:
+    template <bool IsConst>
+    class IteratorBase final
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Element;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t <IsConst, const Element &, Element &>;
+        using pointer = std::conditional_t <IsConst, const Element *, Element *>;
+
+        IteratorBase () = default;
+
+        /// Mutable iterators are implicitly converted into constant ones.
+        template <bool OtherIsConst, typename = std::enable_if_t <IsConst && !OtherIsConst>>
+        IteratorBase (const IteratorBase <OtherIsConst> &other)
+            : control_ (other.control_),
+              slot_ (other.slot_)
+        {
+        }
+
+        free_call reference operator * () const
+        {
+            return *slot_;
+        }
+
+        free_call pointer operator -> () const
+        {
+            return slot_;
+        }
+
+        IteratorBase &operator ++ ()
+        {
+            ++control_;
+            ++slot_;
+            SkipFree ();
+            return *this;
+        }
+
+        IteratorBase operator ++ (int)
+        {
+            IteratorBase previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        free_call bool operator == (const IteratorBase &other) const
+        {
+            return control_ == other.control_;
+        }
+
+        free_call bool operator != (const IteratorBase &other) const
+        {
+            return control_ != other.control_;
+        }
+
+    private:
+        IteratorBase (const int8_t *control, pointer slot)
+            : control_ (control),
+              slot_ (slot)
+        {
+        }
+
+        void SkipFree ()
+        {
+            while (*control_ < CONTROL_SENTINEL)
+            {
+                ++control_;
+                ++slot_;
+            }
+        }
+
+        const int8_t *control_ = nullptr;
+        pointer slot_ = nullptr;
+
+        friend class IteratorBase <!IsConst>;
+
+        friend class FlatHashTable;
+    };
+
+    using key_type = Key;
+    using value_type = Element;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+    using iterator = IteratorBase <false>;
+    using const_iterator = IteratorBase <true>;
+
+    template <typename LookupKey>
+    using KeyArgument =
+        typename KeyArgumentSelector <IsTransparent <Hash, Equal>::value>::template Type <LookupKey, Key>;
+
+    FlatHashTable ()
+        : controls_ (GetEmptyControls ()),
+          slots_ (nullptr),
+          capacity_ (0u),
+          size_ (0u),
+          growthLeft_ (0u),
+          hash_ (),
+          equal_ ()
+    {
+    }
+
+    FlatHashTable (const FlatHashTable &other)
+        : FlatHashTable ()
+    {
+        hash_ = other.hash_;
+        equal_ = other.equal_;
+
+        if (other.size_ > 0u)
+        {
+            // Same capacity and same slots: elements are copied without rehashing.
+            Allocate (other.capacity_);
+            std::memcpy (controls_, other.controls_, capacity_ + 1u);
+
+            for (std::size_t index = 0u; index < capacity_; ++index)
+            {
+                if (controls_[index] >= 0)
+                {
+                    new (slots_ + index) Element (other.slots_[index]);
+                }
+            }
+
+            size_ = other.size_;
+            growthLeft_ = other.growthLeft_;
+        }
+    }
+
+    FlatHashTable (FlatHashTable &&other) noexcept
+        : FlatHashTable ()
+    {
+        swap (other);
+    }
+
+    ~FlatHashTable ()
+    {
+        DestroyAndDeallocate ();
+    }
+
+    FlatHashTable &operator = (const FlatHashTable &other)
+    {
+        if (this != &other)
+        {
+            FlatHashTable copy (other);
+            swap (copy);
+        }
+
+        return *this;
+    }
+
+    FlatHashTable &operator = (FlatHashTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            FlatHashTable moved (std::move (other));
+            swap (moved);
+        }
+
+        return *this;
+    }
+
+    free_call iterator begin ()
+    {
+        iterator first (controls_, slots_);
+        first.SkipFree ();
+        return first;
+    }
+
+    free_call const_iterator begin () const
+    {
+        const_iterator first (controls_, slots_);
+        first.SkipFree ();
+        return first;
+    }
+
+    free_call const_iterator cbegin () const
+    {
+        return begin ();
+    }
+
+    free_call iterator end ()
+    {
+        return iterator (controls_ + capacity_, slots_ + capacity_);
+    }
+
+    free_call const_iterator end () const
+    {
+        return const_iterator (controls_ + capacity_, slots_ + capacity_);
+    }
+
+    free_call const_iterator cend () const
+    {
+        return end ();
+    }
+
+    free_call bool empty () const
+    {
+        return size_ == 0u;
+    }
+
+    free_call std::size_t size () const
+    {
+        return size_;
+    }
+
+    /// Returns count of slots, including free ones.
+    free_call std::size_t capacity () const
+    {
+        return capacity_;
+    }
+
+    void clear ()
+    {
+        if (capacity_ > 0u)
+        {
+            DestroyElements ();
+            ResetControls ();
+        }
+    }
+
+    /// Allocates enough slots to insert given count of elements without rehash.
+    void reserve (std::size_t count)
+    {
+        if (count > size_ + growthLeft_)
+        {
+            Rehash (GetCapacityFor (count));
+        }
+    }
+
+    void swap (FlatHashTable &other) noexcept
+    {
+        std::swap (controls_, other.controls_);
+        std::swap (slots_, other.slots_);
+        std::swap (capacity_, other.capacity_);
+        std::swap (size_, other.size_);
+        std::swap (growthLeft_, other.growthLeft_);
+        std::swap (hash_, other.hash_);
+        std::swap (equal_, other.equal_);
+    }
+
+    template <typename LookupKey = Key>
+    free_call iterator find (const KeyArgument <LookupKey> &key)
+    {
+        const std::size_t index = FindIndex (key);
+        return index == capacity_ ? end () : GetIterator (index);
+    }
+
+    template <typename LookupKey = Key>
+    free_call const_iterator find (const KeyArgument <LookupKey> &key) const
+    {
+        const std::size_t index = FindIndex (key);
+        return index == capacity_ ? end () : const_iterator (controls_ + index, slots_ + index);
+    }
+
+    template <typename LookupKey = Key>
+    free_call std::size_t count (const KeyArgument <LookupKey> &key) const
+    {
+        return FindIndex (key) == capacity_ ? 0u : 1u;
+    }
+
+    template <typename LookupKey = Key>
+    free_call bool contains (const KeyArgument <LookupKey> &key) const
+    {
+        return FindIndex (key) != capacity_;
+    }
+
+    template <typename LookupKey = Key>
+    std::size_t erase (const KeyArgument <LookupKey> &key)
+    {
+        const std::size_t index = FindIndex (key);
+        if (index == capacity_)
+        {
+            return 0u;
+        }
+
+        EraseAt (index);
+        return 1u;
+    }
+
+    /// Returns iterator to the next element. Erasure never moves other elements.
+    iterator erase (const_iterator position)
+    {
+        assert (position != end ());
+        const std::size_t index = static_cast <std::size_t> (position.control_ - controls_);
+        EraseAt (index);
+
+        iterator next = GetIterator (index);
+        next.SkipFree ();
+        return next;
+    }
+
+    iterator erase (iterator position)
+    {
+        return erase (const_iterator (position));
+    }
+
+    template <typename... Arguments>
+    std::pair <iterator, bool> emplace (Arguments &&... arguments)
+    {
+        // Key could be extracted only from constructed element, so element is constructed before lookup.
+        Element element (std::forward <Arguments> (arguments)...);
+        auto [index, inserted] = FindOrPrepareInsert (KeyOf::Get (element));
+
+        if (inserted)
+        {
+            new (slots_ + index) Element (std::move (element));
+        }
+
+        return {GetIterator (index), inserted};
+    }
+
+    std::pair <iterator, bool> insert (const Element &element)
+    {
+        auto [index, inserted] = FindOrPrepareInsert (KeyOf::Get (element));
+        if (inserted)
+        {
+            new (slots_ + index) Element (element);
+        }
+
+        return {GetIterator (index), inserted};
+    }
+
+    std::pair <iterator, bool> insert (Element &&element)
+    {
+        auto [index, inserted] = FindOrPrepareInsert (KeyOf::Get (element));
+        if (inserted)
+        {
+            new (slots_ + index) Element (std::move (element));
+        }
+
+        return {GetIterator (index), inserted};
+    }
+
+protected:
+    /// Finds slot with given key or reserves free slot for it. Caller must construct element in reserved slot.
+    template <typename LookupKey>
+    std::pair <std::size_t, bool> FindOrPrepareInsert (const LookupKey &key)
+    {
+        const uint64_t hash = MixHash (hash_ (key));
+        const std::size_t found = FindIndex (key, hash);
+
+        if (found != capacity_)
+        {
+            return {found, false};
+        }
+
+        if (growthLeft_ == 0u)
+        {
+            // If a lot of slots are occupied by deleted elements, table is cleaned up without growth.
+            Rehash (size_ * 2u < GetUsableCapacity (capacity_) ? capacity_ : GetCapacityFor (size_ + 1u));
+        }
+
+        const std::size_t index = FindFreeIndex (hash);
+        if (controls_[index] == CONTROL_EMPTY)
+        {
+            --growthLeft_;
+        }
+
+        controls_[index] = GetControlHash (hash);
+        ++size_;
+        return {index, true};
+    }
+
+    free_call Element *GetSlot (std::size_t index)
+    {
+        return slots_ + index;
+    }
+
+    free_call iterator GetIterator (std::size_t index)
+    {
+        return iterator (controls_ + index, slots_ + index);
+    }
+
+private:
+    free_call static int8_t *GetEmptyControls ()
+    {
+        // Table without allocated slots still needs sentinel for iterators.
+        alignas (GROUP_SIZE) static int8_t emptyControls[1u] {CONTROL_SENTINEL};
+        return emptyControls;
+    }
+
+    /// Tables are filled up to 7/8 of capacity, because group probing stays fast on such loads.
+    free_call static std::size_t GetUsableCapacity (std::size_t capacity)
+    {
+        return capacity - capacity / 8u;
+    }
+
+    free_call static std::size_t GetCapacityFor (std::size_t count)
+    {
+        std::size_t capacity = GROUP_SIZE;
+        while (GetUsableCapacity (capacity) < count)
+        {
+            capacity *= 2u;
+        }
+
+        return capacity;
+    }
+
+    template <typename LookupKey>
+    free_call std::size_t FindIndex (const LookupKey &key) const
+    {
+        return capacity_ == 0u ? capacity_ : FindIndex (key, MixHash (hash_ (key)));
+    }
+
+    /// Returns capacity if there is no such key.
+    template <typename LookupKey>
+    free_call std::size_t FindIndex (const LookupKey &key, uint64_t hash) const
+    {
+        if (capacity_ == 0u)
+        {
+            return capacity_;
+        }
+
+        const int8_t controlHash = GetControlHash (hash);
+        const std::size_t groupMask = capacity_ / GROUP_SIZE - 1u;
+        std::size_t groupIndex = static_cast <std::size_t> (hash) & groupMask;
+
+        // Triangular probing visits every group, because group count is a power of two.
+        for (std::size_t step = 1u; ; ++step)
+        {
+            const std::size_t groupStart = groupIndex * GROUP_SIZE;
+            const Group group (controls_ + groupStart);
+
+            for (MatchMask mask = group.Match (controlHash); mask != 0u; mask &= mask - 1u)
+            {
+                const std::size_t index = groupStart + GetLowestMatch (mask);
+                if (equal_ (KeyOf::Get (slots_[index]), key))
+                {
+                    return index;
+                }
+            }
+
+            if (group.MatchEmpty () != 0u || step > groupMask)
+            {
+                return capacity_;
+            }
+
+            groupIndex = (groupIndex + step) & groupMask;
+        }
+    }
+
+    free_call std::size_t FindFreeIndex (uint64_t hash) const
+    {
+        const std::size_t groupMask = capacity_ / GROUP_SIZE - 1u;
+        std::size_t groupIndex = static_cast <std::size_t> (hash) & groupMask;
+
+        for (std::size_t step = 1u; ; ++step)
+        {
+            const std::size_t groupStart = groupIndex * GROUP_SIZE;
+            const MatchMask mask = Group (controls_ + groupStart).MatchFree ();
+
+            if (mask != 0u)
+            {
+                return groupStart + GetLowestMatch (mask);
+            }
+
+            assert (step <= groupMask);
+            groupIndex = (groupIndex + step) & groupMask;
+        }
+    }
+
+    void EraseAt (std::size_t index)
+    {
+        assert (index < capacity_ && controls_[index] >= 0);
+        slots_[index].~Element ();
+        --size_;
+
+        // Probing stops on empty slots, so slot could become empty only if its group already has empty slots.
+        const std::size_t groupStart = index - index % GROUP_SIZE;
+        if (Group (controls_ + groupStart).MatchEmpty () != 0u)
+        {
+            controls_[index] = CONTROL_EMPTY;
+            ++growthLeft_;
+        }
+        else
+        {
+            controls_[index] = CONTROL_DELETED;
+        }
+    }
+
+    void Rehash (std::size_t newCapacity)
+    {
+        assert (newCapacity >= GROUP_SIZE && GetUsableCapacity (newCapacity) >= size_);
+        int8_t *oldControls = controls_;
+        Element *oldSlots = slots_;
+        const std::size_t oldCapacity = capacity_;
+
+        Allocate (newCapacity);
+        const std::size_t size = size_;
+        ResetControls ();
+
+        for (std::size_t oldIndex = 0u; oldIndex < oldCapacity; ++oldIndex)
+        {
+            if (oldControls[oldIndex] >= 0)
+            {
+                const uint64_t hash = MixHash (hash_ (KeyOf::Get (oldSlots[oldIndex])));
+                const std::size_t index = FindFreeIndex (hash);
+
+                controls_[index] = GetControlHash (hash);
+                new (slots_ + index) Element (std::move (oldSlots[oldIndex]));
+                oldSlots[oldIndex].~Element ();
+            }
+        }
+
+        size_ = size;
+        growthLeft_ -= size;
+
+        if (oldCapacity > 0u)
+        {
+            delete[] oldControls;
+            std::allocator <Element> ().deallocate (oldSlots, oldCapacity);
+        }
+    }
+
+    void Allocate (std::size_t capacity)
+    {
+        controls_ = new int8_t[capacity + 1u];
+        slots_ = std::allocator <Element> ().allocate (capacity);
+        capacity_ = capacity;
+    }
+
+    void ResetControls ()
+    {
+        std::memset (controls_, static_cast <uint8_t> (CONTROL_EMPTY), capacity_);
+        controls_[capacity_] = CONTROL_SENTINEL;
+        size_ = 0u;
+        growthLeft_ = GetUsableCapacity (capacity_);
+    }
+
+    void DestroyElements ()
+    {
+        if constexpr (!std::is_trivially_destructible_v <Element>)
+        {
+            for (std::size_t index = 0u; index < capacity_; ++index)
+            {
+                if (controls_[index] >= 0)
+                {
+                    slots_[index].~Element ();
+                }
+            }
+        }
+    }
+
+    void DestroyAndDeallocate ()
+    {
+        if (capacity_ > 0u)
+        {
+            DestroyElements ();
+            delete[] controls_;
+            std::allocator <Element> ().deallocate (slots_, capacity_);
+
+            controls_ = GetEmptyControls ();
+            slots_ = nullptr;
+            capacity_ = 0u;
+            size_ = 0u;
+            growthLeft_ = 0u;
+        }
+    }
+
+    int8_t *controls_;
+    Element *slots_;
+    std::size_t capacity_;
+    std::size_t size_;
+    std::size_t growthLeft_;
+
+    Hash hash_;
+    Equal equal_;
+};
+}
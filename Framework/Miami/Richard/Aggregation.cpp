@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include <Miami/Richard/Aggregation.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+bool RequiresValues (AggregateFunction function)
+{
+    return function >= AggregateFunction::SUM;
+}
+
+/// Adds value to result. Used for grouped aggregation, where every row could belong to different group.
+void Accumulate (AggregateFunction function, int64_t value, AggregateResult &result)
+{
+    switch (function)
+    {
+        case AggregateFunction::COUNT_ROWS:
+        case AggregateFunction::COUNT:
+            break;
+
+        case AggregateFunction::SUM:
+        case AggregateFunction::AVG:
+            result.value_ = static_cast <int64_t> (static_cast <uint64_t> (result.value_) +
+                                                   static_cast <uint64_t> (value));
+            break;
+
+        case AggregateFunction::MIN:
+            result.value_ = result.count_ == 0u ? value : std::min (result.value_, value);
+            break;
+
+        case AggregateFunction::MAX:
+            result.value_ = result.count_ == 0u ? value : std::max (result.value_, value);
+            break;
+    }
+
+    ++result.count_;
+}
+
+/// Aggregation kernels for batches, which rows belong to one group. Kernels are branchless, so
+/// compiler is able to vectorize them. Valid flags are results of predicate masked by presence.
+uint64_t CountValid (const uint8_t *valid, std::size_t count)
+{
+    uint64_t result = 0u;
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        result += valid[index];
+    }
+
+    return result;
+}
+
+void AggregateBatch (AggregateFunction function, const int64_t *values, const uint8_t *valid,
+                     std::size_t count, AggregateResult &result)
+{
+    const uint64_t validCount = CountValid (valid, count);
+    switch (function)
+    {
+        case AggregateFunction::COUNT_ROWS:
+        case AggregateFunction::COUNT:
+            break;
+
+        case AggregateFunction::SUM:
+        case AggregateFunction::AVG:
+        {
+            uint64_t sum = static_cast <uint64_t> (result.value_);
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                sum += static_cast <uint64_t> (values[index]) & (0u - static_cast <uint64_t> (valid[index]));
+            }
+
+            result.value_ = static_cast <int64_t> (sum);
+            break;
+        }
+
+        case AggregateFunction::MIN:
+        {
+            int64_t minimum = std::numeric_limits <int64_t>::max ();
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                minimum = std::min (minimum, valid[index] ? values[index] : std::numeric_limits <int64_t>::max ());
+            }
+
+            if (validCount > 0u)
+            {
+                result.value_ = result.count_ == 0u ? minimum : std::min (result.value_, minimum);
+            }
+
+            break;
+        }
+
+        case AggregateFunction::MAX:
+        {
+            int64_t maximum = std::numeric_limits <int64_t>::min ();
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                maximum = std::max (maximum, valid[index] ? values[index] : std::numeric_limits <int64_t>::min ());
+            }
+
+            if (validCount > 0u)
+            {
+                result.value_ = result.count_ == 0u ? maximum : std::max (result.value_, maximum);
+            }
+
+            break;
+        }
+    }
+
+    result.count_ += validCount;
+}
+}
+
+const char *GetAggregateFunctionName (AggregateFunction function)
+{
+    switch (function)
+    {
+        case AggregateFunction::COUNT_ROWS:
+            return "count rows";
+
+        case AggregateFunction::COUNT:
+            return "count";
+
+        case AggregateFunction::SUM:
+            return "sum";
+
+        case AggregateFunction::MIN:
+            return "min";
+
+        case AggregateFunction::MAX:
+            return "max";
+
+        case AggregateFunction::AVG:
+            return "avg";
+    }
+
+    assert (false);
+    return "UNKNOWN";
+}
+
+ResultCode Aggregator::Validate (const Table *table, const AggregationQuery &query)
+{
+    assert (table);
+    for (AnyDataId columnId : query.groupColumns_)
+    {
+        if (table->columns_.count (columnId) == 0)
+        {
+            return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+        }
+    }
+
+    for (const AggregateInfo &aggregate : query.aggregates_)
+    {
+        if (aggregate.function_ > AggregateFunction::AVG)
+        {
+            return ResultCode::AGGREGATE_FUNCTION_IS_UNKNOWN;
+        }
+
+        if (aggregate.function_ == AggregateFunction::COUNT_ROWS)
+        {
+            continue;
+        }
+
+        auto iterator = table->columns_.find (aggregate.columnId_);
+        if (iterator == table->columns_.end ())
+        {
+            return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        if (RequiresValues (aggregate.function_) &&
+            !IsIntegerDataType (iterator->second.GetColumnInfo ().dataType_))
+        {
+            return ResultCode::AGGREGATE_COLUMN_MUST_BE_INTEGER;
+        }
+    }
+
+    return query.predicate_.GetNodes ().empty () ? ResultCode::OK : query.predicate_.Validate (table);
+}
+
+Aggregator::Aggregator (const Table *table, const AggregationQuery &query)
+    : table_ (table),
+      query_ (query),
+      groupColumns_ (),
+      aggregateColumns_ (),
+      groups_ (),
+      groupIndices_ (),
+      keyBuffer_ (),
+      valueBuffer_ (),
+      predicateStack_ ()
+{
+    assert (table_);
+    for (AnyDataId columnId : query_.groupColumns_)
+    {
+        groupColumns_.emplace_back (&table_->columns_.at (columnId));
+    }
+
+    for (const AggregateInfo &aggregate : query_.aggregates_)
+    {
+        aggregateColumns_.emplace_back (aggregate.function_ == AggregateFunction::COUNT_ROWS ?
+                                        nullptr : &table_->columns_.at (aggregate.columnId_));
+    }
+
+    // Aggregation without grouping returns result even if there are no rows.
+    if (groupColumns_.empty ())
+    {
+        groups_.emplace_back ().results_.resize (query_.aggregates_.size ());
+    }
+}
+
+void Aggregator::Process (const AnyDataId *rows, std::size_t count)
+{
+    assert (count <= BATCH_SIZE);
+    uint8_t mask[BATCH_SIZE];
+
+    if (query_.predicate_.GetNodes ().empty ())
+    {
+        memset (mask, 1, count);
+    }
+    else
+    {
+        query_.predicate_.Evaluate (table_, rows, count, predicateStack_, mask);
+    }
+
+    uint32_t groups[BATCH_SIZE];
+    if (!groupColumns_.empty ())
+    {
+        FindGroups (rows, count, mask, groups);
+    }
+
+    int64_t values[BATCH_SIZE];
+    uint8_t valid[BATCH_SIZE];
+
+    for (std::size_t aggregateIndex = 0; aggregateIndex < aggregateColumns_.size (); ++aggregateIndex)
+    {
+        const AggregateFunction function = query_.aggregates_[aggregateIndex].function_;
+        if (aggregateColumns_[aggregateIndex])
+        {
+            Gather (aggregateColumns_[aggregateIndex], rows, count, RequiresValues (function), values, valid);
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                valid[index] &= mask[index];
+            }
+        }
+        else
+        {
+            memset (values, 0, count * sizeof (int64_t));
+            memcpy (valid, mask, count);
+        }
+
+        if (groupColumns_.empty ())
+        {
+            AggregateBatch (function, values, valid, count, groups_.front ().results_[aggregateIndex]);
+        }
+        else
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                if (valid[index])
+                {
+                    Accumulate (function, values[index], groups_[groups[index]].results_[aggregateIndex]);
+                }
+            }
+        }
+    }
+}
+
+void Aggregator::Finish (std::vector <AggregateGroup> &output)
+{
+    output = std::move (groups_);
+    groups_.clear ();
+    groupIndices_.clear ();
+}
+
+void Aggregator::Gather (const Column *column, const AnyDataId *rows, std::size_t count, bool withValues,
+                         int64_t *values, uint8_t *present)
+{
+    if (column->GetCompressedValues ())
+    {
+        column->GetCompressedValues ()->Gather (rows, count, values, present);
+        return;
+    }
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const AnyDataContainer *value = column->GetValue (rows[index], valueBuffer_);
+        present[index] = value != nullptr;
+        values[index] = value && withValues ? ReadIntegerValue (*value) : 0;
+    }
+}
+
+void Aggregator::FindGroups (const AnyDataId *rows, std::size_t count, const uint8_t *mask, uint32_t *output)
+{
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        if (!mask[index])
+        {
+            continue;
+        }
+
+        // Key is a concatenation of null flag, size and raw bytes of every group column value.
+        keyBuffer_.clear ();
+        for (const Column *column : groupColumns_)
+        {
+            const AnyDataContainer *value = column->GetValue (rows[index], valueBuffer_);
+            keyBuffer_.push_back (value ? '\1' : '\0');
+
+            if (value)
+            {
+                uint32_t size = value->GetDataSize ();
+                keyBuffer_.append (reinterpret_cast <const char *> (&size), sizeof (size));
+                keyBuffer_.append (static_cast <const char *> (value->GetDataStartPointer ()), size);
+            }
+        }
+
+        auto result = groupIndices_.emplace (keyBuffer_, static_cast <uint32_t> (groups_.size ()));
+        if (result.second)
+        {
+            AggregateGroup &group = groups_.emplace_back ();
+            group.results_.resize (query_.aggregates_.size ());
+
+            for (std::size_t columnIndex = 0; columnIndex < groupColumns_.size (); ++columnIndex)
+            {
+                const AnyDataContainer *value = groupColumns_[columnIndex]->GetValue (rows[index], valueBuffer_);
+                if (value)
+                {
+                    group.key_.emplace (query_.groupColumns_[columnIndex], AnyDataContainer (*value));
+                }
+            }
+        }
+
+        output[index] = result.first->second;
+    }
+}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Predicate.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+
+namespace Miami::Richard
+{
+class Column;
+
+class Table;
+
+enum class AggregateFunction : uint8_t
+{
+    /// Counts rows, column is ignored.
+    COUNT_ROWS = 0,
+
+    /// Counts non null values of column.
+    COUNT,
+
+    // Functions below are supported only by integer columns. Null values are skipped.
+    SUM,
+    MIN,
+    MAX,
+    AVG
+};
+
+const char *GetAggregateFunctionName (AggregateFunction function);
+
+struct AggregateInfo
+{
+    AggregateFunction function_;
+    AnyDataId columnId_ = 0;
+};
+
+/// Count of aggregated values and aggregate value. For AVG value is a sum, so average is value divided
+/// by count, because results in this form could be merged. MIN, MAX and AVG are null if count is zero.
+/// Sums are calculated with overflow wrapping.
+struct AggregateResult
+{
+    uint64_t count_ = 0u;
+    int64_t value_ = 0;
+};
+
+struct AggregateGroup
+{
+    /// Values of group columns. Null values are absent.
+    Janitor::FlatHashMap <AnyDataId, AnyDataContainer> key_;
+    std::vector <AggregateResult> results_;
+};
+
+struct AggregationQuery
+{
+    /// Rows are grouped by values of these columns. Nulls are grouped together.
+    /// If there are no group columns, result always contains exactly one group.
+    std::vector <AnyDataId> groupColumns_;
+    std::vector <AggregateInfo> aggregates_;
+
+    /// Predicate without nodes matches all rows.
+    Predicate predicate_;
+
+    /// Aggregation could be limited to rows, which keys in given ordered index are not less than lower
+    /// bound and less than upper bound. Key columns, that are absent in bound, are treated as nulls.
+    bool hasLowerBound_ = false;
+    bool hasUpperBound_ = false;
+    AnyDataId indexId_ = 0;
+    Janitor::FlatHashMap <AnyDataId, AnyDataContainer> lowerBound_;
+    Janitor::FlatHashMap <AnyDataId, AnyDataContainer> upperBound_;
+};
+
+/// Accumulates aggregates over batches of rows. Values of each batch are gathered into plain arrays,
+/// so aggregates without grouping are calculated by branchless loops, that compiler is able to vectorize.
+class Aggregator final
+{
+public:
+    /// Maximum count of rows, that are processed by one ::Process call.
+    static constexpr std::size_t BATCH_SIZE = Predicate::BATCH_SIZE;
+
+    /// Checks that query is compatible with given table. Index range is checked by table.
+    free_call static ResultCode Validate (const Table *table, const AggregationQuery &query);
+
+    /// Query must be validated and must outlive aggregator.
+    Aggregator (const Table *table, const AggregationQuery &query);
+
+    void Process (const AnyDataId *rows, std::size_t count);
+
+    void Finish (std::vector <AggregateGroup> &output);
+
+private:
+    /// Gathers integer values of given column. If ::withValues is false, only presence is gathered.
+    void Gather (const Column *column, const AnyDataId *rows, std::size_t count, bool withValues,
+                 int64_t *values, uint8_t *present);
+
+    /// Writes indices of groups for rows, that passed mask. Creates new groups if needed.
+    void FindGroups (const AnyDataId *rows, std::size_t count, const uint8_t *mask, uint32_t *output);
+
+    const Table *table_;
+    const AggregationQuery &query_;
+
+    std::vector <const Column *> groupColumns_;
+    std::vector <const Column *> aggregateColumns_;
+
+    std::vector <AggregateGroup> groups_;
+    std::unordered_map <std::string, uint32_t> groupIndices_;
+    std::string keyBuffer_;
+    AnyDataContainer valueBuffer_;
+    Predicate::EvaluationStack predicateStack_;
+};
+}
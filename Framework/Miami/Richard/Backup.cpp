@@ -0,0 +1,486 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <functional>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Richard/Backup.hpp>
+#include <Miami/Richard/Encoding.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+using namespace Encoding;
+
+namespace
+{
+using FileHandle = std::unique_ptr <std::FILE, int (*) (std::FILE *)>;
+
+void ForEach (Disco::Context *workers, std::size_t count, const std::function <void (std::size_t)> &function)
+{
+    if (workers && count > 1u)
+    {
+        Disco::ParallelFor (workers, count, function);
+    }
+    else
+    {
+        for (std::size_t index = 0u; index < count; ++index)
+        {
+            function (index);
+        }
+    }
+}
+
+std::size_t GetWaveSize (Disco::Context *workers)
+{
+    return workers ? workers->GetWorkersCount () + 1u : 1u;
+}
+}
+
+ConduitBackup::~ConduitBackup ()
+{
+    for (const TableImage &image : tables_)
+    {
+        image.table_->CloseSnapshot (image.version_);
+    }
+}
+
+ResultCode ConduitBackup::WriteToFile (const std::string &path, Disco::Context *workers) const
+{
+    const std::string temporaryPath = path + ".partial";
+    FileHandle file (std::fopen (temporaryPath.c_str (), "wb"), &std::fclose);
+
+    if (!file)
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to open backup file \"" + temporaryPath + "\"!");
+        return ResultCode::BACKUP_FILE_WRITE_FAILED;
+    }
+
+    auto write = [&file] (const void *data, std::size_t size)
+    {
+        return size == 0u || std::fwrite (data, size, 1u, file.get ()) == 1u;
+    };
+
+    const uint64_t tablesCount = tables_.size ();
+    ResultCode result = write (&SIGNATURE, sizeof (SIGNATURE)) &&
+                        write (&FORMAT_VERSION, sizeof (FORMAT_VERSION)) &&
+                        write (&nextTableId_, sizeof (nextTableId_)) &&
+                        write (&tablesCount, sizeof (tablesCount)) ?
+                        ResultCode::OK : ResultCode::BACKUP_FILE_WRITE_FAILED;
+
+    const std::size_t waveSize = GetWaveSize (workers);
+    std::vector <std::vector <uint8_t>> encoded;
+    std::vector <ResultCode> results;
+
+    for (std::size_t firstTable = 0u; firstTable < tables_.size () && result == ResultCode::OK; firstTable += waveSize)
+    {
+        const std::size_t count = std::min (waveSize, tables_.size () - firstTable);
+        encoded.assign (count, {});
+        results.assign (count, ResultCode::OK);
+
+        ForEach (workers, count,
+                 [this, &encoded, &results, firstTable] (std::size_t index)
+                 {
+                     results[index] = EncodeTable (tables_[firstTable + index], encoded[index]);
+                 });
+
+        for (std::size_t index = 0u; index < count && result == ResultCode::OK; ++index)
+        {
+            const uint64_t size = encoded[index].size ();
+            if (results[index] != ResultCode::OK)
+            {
+                result = results[index];
+            }
+            else if (!write (&size, sizeof (size)) || !write (encoded[index].data (), encoded[index].size ()))
+            {
+                result = ResultCode::BACKUP_FILE_WRITE_FAILED;
+            }
+        }
+    }
+
+    // Close flushes buffered data, so its errors are write errors too.
+    if (std::fclose (file.release ()) != 0 && result == ResultCode::OK)
+    {
+        result = ResultCode::BACKUP_FILE_WRITE_FAILED;
+    }
+
+    if (result == ResultCode::OK && std::rename (temporaryPath.c_str (), path.c_str ()) != 0)
+    {
+        result = ResultCode::BACKUP_FILE_WRITE_FAILED;
+    }
+
+    if (result != ResultCode::OK)
+    {
+        std::remove (temporaryPath.c_str ());
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to write backup file \"" + path + "\", error " +
+                                                         std::to_string (static_cast <uint64_t> (result)) + "!");
+    }
+
+    return result;
+}
+
+ConduitBackup::ConduitBackup (const std::vector <Table *> &tables, AnyDataId nextTableId)
+    : tables_ (),
+      nextTableId_ (nextTableId)
+{
+    tables_.reserve (tables.size ());
+    for (Table *table : tables)
+    {
+        assert (table);
+        TableImage &image = tables_.emplace_back (
+            TableImage {table, table->OpenSnapshot (), table->name_, {}, {}, table->rows_,
+                        table->nextColumnId_, table->nextIndexId_, table->nextRowId_});
+
+        for (const auto &idColumnPair : table->columns_)
+        {
+            image.columns_.emplace_back (idColumnPair.second.GetColumnInfo ());
+        }
+
+        for (const auto &idIndexPair : table->indices_)
+        {
+            image.indices_.emplace_back (idIndexPair.second->GetIndexInfo ());
+        }
+
+        // Hash map order is not stable, but equal conduits should produce equal files.
+        std::sort (image.columns_.begin (), image.columns_.end (),
+                   [] (const ColumnInfo &first, const ColumnInfo &second)
+                   {
+                       return first.id_ < second.id_;
+                   });
+
+        std::sort (image.indices_.begin (), image.indices_.end (),
+                   [] (const IndexInfo &first, const IndexInfo &second)
+                   {
+                       return first.id_ < second.id_;
+                   });
+    }
+}
+
+ResultCode ConduitBackup::EncodeTable (const TableImage &image, std::vector <uint8_t> &output)
+{
+    AppendPod (image.table_->GetId (), output);
+    AppendString (image.name_, output);
+    AppendPod (image.nextColumnId_, output);
+    AppendPod (image.nextIndexId_, output);
+    AppendPod (image.nextRowId_, output);
+
+    AppendPod (static_cast <uint32_t> (image.columns_.size ()), output);
+    for (const ColumnInfo &info : image.columns_)
+    {
+        AppendColumnInfo (info, output);
+    }
+
+    AppendPod (static_cast <uint32_t> (image.indices_.size ()), output);
+    for (const IndexInfo &info : image.indices_)
+    {
+        AppendIndexInfo (info, output);
+    }
+
+    AppendPod (static_cast <uint64_t> (image.rows_.GetSize ()), output);
+    std::vector <AnyDataId> batch;
+    std::vector <const Column *> columns (image.columns_.size ());
+    AnyDataContainer value;
+
+    auto encodeBatch = [&image, &output, &batch, &columns, &value] ()
+    {
+        // Writers change columns under this mutex, so values are read in batches to lock it less often.
+        Table *table = image.table_;
+        std::unique_lock <std::mutex> lock (table->snapshotsGuard_);
+
+        // Column pointers are found again for every batch, because adding columns moves them.
+        for (std::size_t index = 0u; index < image.columns_.size (); ++index)
+        {
+            auto iterator = table->columns_.find (image.columns_[index].id_);
+            if (iterator == table->columns_.end ())
+            {
+                return false;
+            }
+
+            columns[index] = &iterator->second;
+        }
+
+        for (AnyDataId rowId : batch)
+        {
+            AppendPod (rowId, output);
+            for (const Column *column : columns)
+            {
+                bool isNull;
+                Table::ReadSnapshotValue (*column, rowId, image.version_, value, isNull);
+                AppendPod (static_cast <uint8_t> (isNull), output);
+
+                if (!isNull)
+                {
+                    if (IsVariableSizeDataType (column->GetColumnInfo ().dataType_))
+                    {
+                        AppendPod (static_cast <uint32_t> (value.GetDataSize ()), output);
+                    }
+
+                    const auto *data = static_cast <const uint8_t *> (value.GetDataStartPointer ());
+                    output.insert (output.end (), data, data + value.GetDataSize ());
+                }
+            }
+        }
+
+        batch.clear ();
+        return true;
+    };
+
+    batch.reserve (READ_BATCH_SIZE);
+    for (AnyDataId rowId : image.rows_)
+    {
+        batch.emplace_back (rowId);
+        if (batch.size () == READ_BATCH_SIZE && !encodeBatch ())
+        {
+            return ResultCode::BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL;
+        }
+    }
+
+    return batch.empty () || encodeBatch () ? ResultCode::OK : ResultCode::BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL;
+}
+
+ResultCode ConduitBackup::ReadFromFile (const std::string &path, Disco::Context *tablesContext,
+                                        Disco::Context *workers,
+                                        Janitor::FlatHashMap <AnyDataId, std::unique_ptr <Table>> &output,
+                                        AnyDataId &outputNextTableId)
+{
+    FileHandle file (std::fopen (path.c_str (), "rb"), &std::fclose);
+    if (!file)
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to open backup file \"" + path + "\"!");
+        return ResultCode::BACKUP_FILE_READ_FAILED;
+    }
+
+    // Sizes of encoded tables are checked against file size, so malformed file never causes huge allocations.
+    if (std::fseek (file.get (), 0, SEEK_END) != 0)
+    {
+        return ResultCode::BACKUP_FILE_READ_FAILED;
+    }
+
+    const long fileSize = std::ftell (file.get ());
+    if (fileSize < 0 || std::fseek (file.get (), 0, SEEK_SET) != 0)
+    {
+        return ResultCode::BACKUP_FILE_READ_FAILED;
+    }
+
+    uint64_t bytesLeft = static_cast <uint64_t> (fileSize);
+    auto read = [&file, &bytesLeft] (void *data, uint64_t size)
+    {
+        if (size > bytesLeft || (size > 0u && std::fread (data, size, 1u, file.get ()) != 1u))
+        {
+            return false;
+        }
+
+        bytesLeft -= size;
+        return true;
+    };
+
+    uint64_t signature;
+    uint32_t formatVersion;
+    uint64_t tablesCount;
+
+    if (!read (&signature, sizeof (signature)) || !read (&formatVersion, sizeof (formatVersion)) ||
+        !read (&outputNextTableId, sizeof (outputNextTableId)) || !read (&tablesCount, sizeof (tablesCount)) ||
+        signature != SIGNATURE || formatVersion != FORMAT_VERSION)
+    {
+        return ResultCode::BACKUP_FILE_IS_MALFORMED;
+    }
+
+    const std::size_t waveSize = GetWaveSize (workers);
+    std::vector <std::vector <uint8_t>> encoded;
+    std::vector <std::unique_ptr <Table>> decoded;
+    std::vector <ResultCode> results;
+
+    for (uint64_t firstTable = 0u; firstTable < tablesCount; firstTable += waveSize)
+    {
+        const auto count = static_cast <std::size_t> (std::min <uint64_t> (waveSize, tablesCount - firstTable));
+        encoded.resize (count);
+        decoded.clear ();
+        decoded.resize (count);
+        results.assign (count, ResultCode::OK);
+
+        for (std::vector <uint8_t> &table : encoded)
+        {
+            uint64_t size;
+            if (!read (&size, sizeof (size)) || size > bytesLeft)
+            {
+                return ResultCode::BACKUP_FILE_IS_MALFORMED;
+            }
+
+            table.resize (size);
+            if (!read (table.data (), size))
+            {
+                return ResultCode::BACKUP_FILE_READ_FAILED;
+            }
+        }
+
+        ForEach (workers, count,
+                 [&encoded, &decoded, &results, tablesContext] (std::size_t index)
+                 {
+                     results[index] = DecodeTable (encoded[index], tablesContext, decoded[index]);
+                 });
+
+        for (std::size_t index = 0u; index < count; ++index)
+        {
+            if (results[index] != ResultCode::OK)
+            {
+                return results[index];
+            }
+
+            const AnyDataId tableId = decoded[index]->GetId ();
+            if (tableId >= outputNextTableId || !output.emplace (tableId, std::move (decoded[index])).second)
+            {
+                return ResultCode::BACKUP_FILE_IS_MALFORMED;
+            }
+        }
+    }
+
+    return bytesLeft == 0u ? ResultCode::OK : ResultCode::BACKUP_FILE_IS_MALFORMED;
+}
+
+ResultCode ConduitBackup::DecodeTable (const std::vector <uint8_t> &input, Disco::Context *tablesContext,
+                                       std::unique_ptr <Table> &output)
+{
+    ByteReader reader (input);
+    AnyDataId tableId;
+    std::string name;
+    AnyDataId nextColumnId;
+    AnyDataId nextIndexId;
+    AnyDataId nextRowId;
+    uint32_t columnsCount;
+
+    if (!reader.Read (tableId) || !reader.ReadString (name) || !reader.Read (nextColumnId) ||
+        !reader.Read (nextIndexId) || !reader.Read (nextRowId) || !reader.Read (columnsCount))
+    {
+        return ResultCode::BACKUP_FILE_IS_MALFORMED;
+    }
+
+    auto table = std::make_unique <Table> (tablesContext, tableId, std::move (name));
+    std::vector <ColumnInfo> columns;
+
+    for (uint32_t index = 0u; index < columnsCount; ++index)
+    {
+        ColumnInfo info;
+        if (!reader.ReadColumnInfo (info) || info.id_ >= nextColumnId)
+        {
+            return ResultCode::BACKUP_FILE_IS_MALFORMED;
+        }
+
+        // Columns, that could not be added by table, would break column storage invariants.
+        if ((info.dictionaryEncoded_ && IsIntegerDataType (info.dataType_)) ||
+            (info.compressed_ && !IsIntegerDataType (info.dataType_)) || (info.dictionaryEncoded_ && info.compressed_) ||
+            !table->columns_.emplace (info.id_, Column (info)).second)
+        {
+            return ResultCode::BACKUP_FILE_IS_MALFORMED;
+        }
+
+        columns.emplace_back (std::move (info));
+    }
+
+    uint32_t indicesCount;
+    if (!reader.Read (indicesCount))
+    {
+        return ResultCode::BACKUP_FILE_IS_MALFORMED;
+    }
+
+    std::vector <IndexInfo> indices (indicesCount);
+    for (IndexInfo &info : indices)
+    {
+        if (!reader.ReadIndexInfo (info) || info.id_ >= nextIndexId || info.name_.empty () ||
+            info.columns_.empty () || (!info.includedColumns_.empty () && info.type_ != IndexType::ORDERED))
+        {
+            return ResultCode::BACKUP_FILE_IS_MALFORMED;
+        }
+    }
+
+    uint64_t rowsCount;
+    if (!reader.Read (rowsCount))
+    {
+        return ResultCode::BACKUP_FILE_IS_MALFORMED;
+    }
+
+    // Indices do not exist yet, so insertions only fill columns.
+    for (uint64_t rowIndex = 0u; rowIndex < rowsCount; ++rowIndex)
+    {
+        AnyDataId rowId;
+        if (!reader.Read (rowId) || rowId >= nextRowId || table->rows_.Contains (rowId))
+        {
+            return ResultCode::BACKUP_FILE_IS_MALFORMED;
+        }
+
+        Table::Row row;
+        for (const ColumnInfo &info : columns)
+        {
+            uint8_t isNull;
+            if (!reader.Read (isNull))
+            {
+                return ResultCode::BACKUP_FILE_IS_MALFORMED;
+            }
+
+            if (!isNull)
+            {
+                AnyDataContainer value (info.dataType_);
+                uint32_t size = value.GetDataSize ();
+
+                if (IsVariableSizeDataType (info.dataType_))
+                {
+                    if (!reader.Read (size) || size > MAX_VARIABLE_DATA_SIZE)
+                    {
+                        return ResultCode::BACKUP_FILE_IS_MALFORMED;
+                    }
+
+                    value.ResizeData (size);
+                }
+
+                if (!reader.ReadBytes (value.GetDataStartPointer (), size))
+                {
+                    return ResultCode::BACKUP_FILE_IS_MALFORMED;
+                }
+
+                row.emplace (info.id_, std::move (value));
+            }
+        }
+
+        if (table->InsertRowWithId (rowId, row) != ResultCode::OK)
+        {
+            return ResultCode::BACKUP_FILE_IS_MALFORMED;
+        }
+    }
+
+    if (!reader.IsFinished ())
+    {
+        return ResultCode::BACKUP_FILE_IS_MALFORMED;
+    }
+
+    // Indices are built from all rows at once: ordered ones are sorted once instead of insertion after insertion.
+    for (IndexInfo &info : indices)
+    {
+        for (const std::vector <AnyDataId> *indexColumns : {&info.columns_, &info.includedColumns_})
+        {
+            for (AnyDataId columnId : *indexColumns)
+            {
+                if (table->columns_.count (columnId) == 0)
+                {
+                    return ResultCode::BACKUP_FILE_IS_MALFORMED;
+                }
+            }
+        }
+
+        const AnyDataId indexId = info.id_;
+        auto result = table->indices_.emplace (indexId, std::make_unique <Index> (table.get (), std::move (info)));
+
+        if (!result.second || (result.first->second->GetIndexInfo ().unique_ && result.first->second->HasDuplicates ()))
+        {
+            return ResultCode::BACKUP_FILE_IS_MALFORMED;
+        }
+    }
+
+    table->nextColumnId_ = nextColumnId;
+    table->nextIndexId_ = nextIndexId;
+    table->nextRowId_ = nextRowId;
+    output = std::move (table);
+    return ResultCode::OK;
+}
+}
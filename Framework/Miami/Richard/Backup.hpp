@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Index.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+#include <Miami/Richard/RowSet.hpp>
+
+namespace Miami::Richard
+{
+class Table;
+
+/// Point-in-time image of all conduit tables, created by Conduit::BeginBackup. Only schemas and row sets are
+/// copied during creation, row values are read later through table snapshots, therefore tables are writable
+/// while image is written. Tables could not be removed until backup is destroyed.
+class ConduitBackup final
+{
+public:
+    /// Backup files start with this signature, followed by ::FORMAT_VERSION.
+    static constexpr uint64_t SIGNATURE = 0x4B4142494D41494Du;
+    static constexpr uint32_t FORMAT_VERSION = 1u;
+
+    /// Count of rows, which values are read from table snapshot under one lock.
+    static constexpr std::size_t READ_BATCH_SIZE = 1024u;
+
+    ConduitBackup (const ConduitBackup &another) = delete;
+
+    ConduitBackup (ConduitBackup &&another) = delete;
+
+    /// Closes table snapshots.
+    ~ConduitBackup ();
+
+    /// Encodes tables and writes them to given file. Tables are encoded by workers in parallel, one table per
+    /// task, and encoded tables are written by calling thread in waves, so memory usage is bounded by wave size.
+    /// Image is written to temporary file first and renamed only after success, so old backup is never broken.
+    free_call ResultCode WriteToFile (const std::string &path, Disco::Context *workers) const;
+
+private:
+    struct TableImage
+    {
+        Table *table_;
+        uint64_t version_;
+        std::string name_;
+        std::vector <ColumnInfo> columns_;
+        std::vector <IndexInfo> indices_;
+        RowSet rows_;
+
+        AnyDataId nextColumnId_;
+        AnyDataId nextIndexId_;
+        AnyDataId nextRowId_;
+    };
+
+    /// Must be called under read or write guards of all given tables.
+    ConduitBackup (const std::vector <Table *> &tables, AnyDataId nextTableId);
+
+    free_call static ResultCode EncodeTable (const TableImage &image, std::vector <uint8_t> &output);
+
+    /// Reads tables from file, written by ::WriteToFile. Tables are decoded by workers in parallel and their
+    /// indices are rebuilt after all rows are inserted, so restore does not pay for index maintenance.
+    free_call static ResultCode ReadFromFile (const std::string &path, Disco::Context *tablesContext,
+                                              Disco::Context *workers,
+                                              Janitor::FlatHashMap <AnyDataId, std::unique_ptr <Table>> &output,
+                                              AnyDataId &outputNextTableId);
+
+    free_call static ResultCode DecodeTable (const std::vector <uint8_t> &input, Disco::Context *tablesContext,
+                                             std::unique_ptr <Table> &output);
+
+    std::vector <TableImage> tables_;
+    AnyDataId nextTableId_;
+
+    friend class Conduit;
+};
+}
@@ -1,10 +1,95 @@
+#include <cassert>
+
 #include <Miami/Richard/Column.hpp>
 
 namespace Miami::Richard
 {
+ColumnDictionary::ColumnDictionary ()
+    : entries_ (),
+      freeCodes_ (),
+      codes_ ()
+{
+}
+
+ColumnDictionary::Code ColumnDictionary::Acquire (AnyDataContainer &value)
+{
+    auto iterator = codes_.find (GetBytes (value));
+    if (iterator != codes_.end ())
+    {
+        ++entries_[iterator->second].usages_;
+        return iterator->second;
+    }
+
+    Code code;
+    if (freeCodes_.empty ())
+    {
+        code = static_cast <Code> (entries_.size ());
+        entries_.emplace_back ();
+    }
+    else
+    {
+        code = freeCodes_.back ();
+        freeCodes_.pop_back ();
+    }
+
+    Entry &entry = entries_[code];
+    entry.value_ = std::make_unique <AnyDataContainer> (std::move (value));
+    entry.usages_ = 1u;
+    codes_.emplace (GetBytes (*entry.value_), code);
+    return code;
+}
+
+void ColumnDictionary::Release (Code code)
+{
+    assert (code < entries_.size ());
+    Entry &entry = entries_[code];
+    assert (entry.value_ && entry.usages_ > 0u);
+
+    if (--entry.usages_ == 0u)
+    {
+        codes_.erase (GetBytes (*entry.value_));
+        entry.value_.reset ();
+        freeCodes_.emplace_back (code);
+    }
+}
+
+const AnyDataContainer &ColumnDictionary::Get (Code code) const
+{
+    assert (code < entries_.size () && entries_[code].value_);
+    return *entries_[code].value_;
+}
+
+bool ColumnDictionary::Find (const AnyDataContainer &value, Code &output) const
+{
+    auto iterator = codes_.find (GetBytes (value));
+    if (iterator == codes_.end ())
+    {
+        return false;
+    }
+
+    output = iterator->second;
+    return true;
+}
+
+std::size_t ColumnDictionary::GetSize () const
+{
+    return codes_.size ();
+}
+
+std::string_view ColumnDictionary::GetBytes (const AnyDataContainer &value)
+{
+    // All values of one column have the same type, so it's enough to compare raw bytes.
+    return std::string_view (static_cast <const char *> (value.GetDataStartPointer ()), value.GetDataSize ());
+}
+
 Column::Column (ColumnInfo info)
     : info_ (std::move (info)),
-      values_ ()
+      values_ (),
+      codes_ (),
+      dictionary_ (info_.dictionaryEncoded_ ? std::make_unique <ColumnDictionary> () : nullptr),
+      compressedValues_ (info_.compressed_ ? std::make_unique <CompressedIntegerStorage> () : nullptr),
+      history_ (),
+      sketch_ ()
 {
 
 }
@@ -13,4 +98,135 @@ const ColumnInfo &Column::GetColumnInfo () const
 {
     return info_;
 }
-}
\ No newline at end of file
+
+const ColumnDictionary *Column::GetDictionary () const
+{
+    return dictionary_.get ();
+}
+
+const CompressedIntegerStorage *Column::GetCompressedValues () const
+{
+    return compressedValues_.get ();
+}
+
+std::size_t Column::GetValuesCount () const
+{
+    if (compressedValues_)
+    {
+        return compressedValues_->GetValuesCount ();
+    }
+
+    return dictionary_ ? codes_.size () : values_.size ();
+}
+
+const AnyDataContainer *Column::GetValue (AnyDataId rowId, AnyDataContainer &buffer) const
+{
+    if (compressedValues_)
+    {
+        int64_t value;
+        if (!compressedValues_->Get (rowId, value))
+        {
+            return nullptr;
+        }
+
+        WriteIntegerValue (info_.dataType_, value, buffer);
+        return &buffer;
+    }
+    else if (dictionary_)
+    {
+        auto iterator = codes_.find (rowId);
+        return iterator == codes_.end () ? nullptr : &dictionary_->Get (iterator->second);
+    }
+    else
+    {
+        auto iterator = values_.find (rowId);
+        return iterator == values_.end () ? nullptr : &iterator->second;
+    }
+}
+
+bool Column::HasValue (AnyDataId rowId) const
+{
+    if (compressedValues_)
+    {
+        return compressedValues_->Has (rowId);
+    }
+
+    return dictionary_ ? codes_.count (rowId) > 0 : values_.count (rowId) > 0;
+}
+
+void Column::SetValue (AnyDataId rowId, AnyDataContainer &value)
+{
+    sketch_.Add (value);
+    if (compressedValues_)
+    {
+        compressedValues_->Set (rowId, ReadIntegerValue (value));
+    }
+    else if (dictionary_)
+    {
+        // New value is acquired before old value release, so unchanged value is never removed from dictionary.
+        ColumnDictionary::Code code = dictionary_->Acquire (value);
+        auto result = codes_.emplace (rowId, code);
+
+        if (!result.second)
+        {
+            dictionary_->Release (result.first->second);
+            result.first->second = code;
+        }
+    }
+    else
+    {
+        values_[rowId] = std::move (value);
+    }
+}
+
+bool Column::ExtractValue (AnyDataId rowId, AnyDataContainer &output)
+{
+    if (compressedValues_)
+    {
+        return GetValue (rowId, output) != nullptr;
+    }
+    else if (dictionary_)
+    {
+        auto iterator = codes_.find (rowId);
+        if (iterator == codes_.end ())
+        {
+            return false;
+        }
+
+        output.CopyFrom (dictionary_->Get (iterator->second));
+        return true;
+    }
+    else
+    {
+        auto iterator = values_.find (rowId);
+        if (iterator == values_.end ())
+        {
+            return false;
+        }
+
+        output = std::move (iterator->second);
+        return true;
+    }
+}
+
+void Column::EraseValue (AnyDataId rowId)
+{
+    if (compressedValues_)
+    {
+        compressedValues_->Erase (rowId);
+    }
+    else if (dictionary_)
+    {
+        auto iterator = codes_.find (rowId);
+        if (iterator != codes_.end ())
+        {
+            dictionary_->Release (iterator->second);
+            codes_.erase (iterator);
+        }
+    }
+    else
+    {
+        values_.erase (rowId);
+    }
+}
+}
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/CompressedIntegerStorage.hpp>
 #include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Statistics.hpp>
 
 namespace Miami::Richard
 {
@@ -12,6 +19,61 @@ struct ColumnInfo
     AnyDataId id_;
     DataType dataType_;
     std::string name_;
+
+    /// Maximum size of values for variable size types. Zero means ::MAX_VARIABLE_DATA_SIZE.
+    /// For fixed size types it is always equal to type size.
+    uint32_t maxSize_ = 0u;
+
+    /// Encoded columns store each distinct value only once and rows refer to values by codes.
+    /// Useful for columns with big values and low cardinality. Not supported by integer types.
+    bool dictionaryEncoded_ = false;
+
+    /// Compressed columns store values in blocks with lightweight integer encodings. Supported only by integer types.
+    bool compressed_ = false;
+};
+
+/// Value of column cell, that was replaced or removed while some table snapshots were alive.
+struct ColumnValueVersion
+{
+    /// Table version, starting from which this value is no longer actual.
+    uint64_t supersededAt_;
+    bool isNull_;
+    AnyDataContainer value_;
+};
+
+/// Distinct values of encoded column. Values are reference counted and are removed when they are
+/// no longer used by any row. Codes of removed values are reused. Addresses of values are stable.
+class ColumnDictionary final
+{
+public:
+    using Code = uint32_t;
+
+    ColumnDictionary ();
+
+    /// Returns code of given value, adding it to dictionary if needed, and increments its usage count.
+    free_call Code Acquire (moved_in AnyDataContainer &value);
+
+    /// Decrements usage count of value with given code.
+    void Release (Code code);
+
+    free_call const AnyDataContainer &Get (Code code) const;
+
+    free_call bool Find (const AnyDataContainer &value, Code &output) const;
+
+    free_call std::size_t GetSize () const;
+
+private:
+    struct Entry
+    {
+        std::unique_ptr <AnyDataContainer> value_;
+        uint32_t usages_;
+    };
+
+    static std::string_view GetBytes (const AnyDataContainer &value);
+
+    std::vector <Entry> entries_;
+    std::vector <Code> freeCodes_;
+    std::unordered_map <std::string_view, Code> codes_;
 };
 
 class Column final
@@ -21,7 +83,31 @@ public:
 
     const ColumnInfo &GetColumnInfo () const;
 
+    /// Returns nullptr if column is not encoded.
+    const ColumnDictionary *GetDictionary () const;
+
+    /// Returns nullptr if column is not compressed.
+    const CompressedIntegerStorage *GetCompressedValues () const;
+
+    /// Returns count of non null values.
+    free_call std::size_t GetValuesCount () const;
+
 private:
+    /// Returns nullptr for null values. Values of encoded columns are stored in dictionary,
+    /// therefore equal values of encoded column always have equal addresses. Values of compressed
+    /// columns are decoded into given buffer, so returned pointer is valid only while buffer is alive.
+    free_call const AnyDataContainer *GetValue (AnyDataId rowId, AnyDataContainer &buffer) const;
+
+    free_call bool HasValue (AnyDataId rowId) const;
+
+    void SetValue (AnyDataId rowId, moved_in AnyDataContainer &value);
+
+    /// Moves value out of column or copies it if column is encoded. Value in column
+    /// must be overwritten or erased after that. Returns false if value is null.
+    free_call bool ExtractValue (AnyDataId rowId, AnyDataContainer &output);
+
+    void EraseValue (AnyDataId rowId);
+
     ColumnInfo info_;
 
     // TODO: Add associated header file and its management.
@@ -29,8 +115,30 @@ private:
     // TODO: Temporary solution. Will be replaced with something like memory mapped files later.
     std::unordered_map <AnyDataId, AnyDataContainer> values_;
 
+    /// Used instead of ::values_ by encoded columns.
+    std::unordered_map <AnyDataId, ColumnDictionary::Code> codes_;
+    std::unique_ptr <ColumnDictionary> dictionary_;
+
+    /// Used instead of ::values_ by compressed columns.
+    std::unique_ptr <CompressedIntegerStorage> compressedValues_;
+
+    /// Old cell values, that are still visible to alive snapshots. Versions of each row are
+    /// sorted by ::supersededAt_, because they are always appended with current table version.
+    std::unordered_map <AnyDataId, std::vector <ColumnValueVersion>> history_;
+
+    /// Every written value is added to sketch, table rebuilds it when it becomes too stale.
+    ColumnSketch sketch_;
+
     // It's easier to implement value read/write process with good performance
     // inside table to manage all columns for required rows at once.
     friend class Table;
+
+    friend class Predicate;
+
+    friend class Aggregator;
+
+    friend class QueryExecutor;
+
+    friend class HashJoin;
 };
-}
\ No newline at end of file
+}
@@ -0,0 +1,537 @@
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstring>
+
+#include <Miami/Richard/CompressedIntegerStorage.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+uint8_t GetBitWidth (uint64_t value)
+{
+    uint8_t width = 0u;
+    while (value != 0u)
+    {
+        ++width;
+        value >>= 1u;
+    }
+
+    return width;
+}
+
+std::size_t GetPackedWordsCount (std::size_t count, uint8_t bitWidth)
+{
+    return (count * bitWidth + 63u) / 64u;
+}
+
+// Arithmetic is done on unsigned values, because differences of signed values could overflow.
+int64_t AddOffset (int64_t base, uint64_t offset)
+{
+    return static_cast <int64_t> (static_cast <uint64_t> (base) + offset);
+}
+
+uint64_t GetOffset (int64_t value, int64_t base)
+{
+    return static_cast <uint64_t> (value) - static_cast <uint64_t> (base);
+}
+
+void Pack (const uint64_t *values, std::size_t count, uint8_t bitWidth, std::vector <uint64_t> &output)
+{
+    output.assign (GetPackedWordsCount (count, bitWidth), 0u);
+    if (bitWidth == 0u)
+    {
+        return;
+    }
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const std::size_t bit = index * bitWidth;
+        const std::size_t word = bit / 64u;
+        const uint32_t shift = bit % 64u;
+
+        output[word] |= values[index] << shift;
+        if (shift + bitWidth > 64u)
+        {
+            output[word + 1u] |= values[index] >> (64u - shift);
+        }
+    }
+}
+
+uint64_t Unpack (const std::vector <uint64_t> &packed, std::size_t index, uint8_t bitWidth)
+{
+    if (bitWidth == 0u)
+    {
+        return 0u;
+    }
+
+    const std::size_t bit = index * bitWidth;
+    const std::size_t word = bit / 64u;
+    const uint32_t shift = bit % 64u;
+    uint64_t value = packed[word] >> shift;
+
+    if (shift + bitWidth > 64u)
+    {
+        value |= packed[word + 1u] << (64u - shift);
+    }
+
+    return bitWidth == 64u ? value : value & ((uint64_t (1u) << bitWidth) - 1u);
+}
+
+template <DataType dataType>
+int64_t ReadIntegerAs (const AnyDataContainer &value)
+{
+    return *static_cast <const typename DataTypeToCxxType <dataType>::Type *> (value.GetDataStartPointer ());
+}
+
+template <DataType dataType>
+void WriteIntegerAs (int64_t value, AnyDataContainer &output)
+{
+    *static_cast <typename DataTypeToCxxType <dataType>::Type *> (output.GetDataStartPointer ()) =
+        static_cast <typename DataTypeToCxxType <dataType>::Type> (value);
+}
+}
+
+int64_t ReadIntegerValue (const AnyDataContainer &value)
+{
+    switch (value.GetType ())
+    {
+        case DataType::INT8:
+            return ReadIntegerAs <DataType::INT8> (value);
+
+        case DataType::INT16:
+            return ReadIntegerAs <DataType::INT16> (value);
+
+        case DataType::INT32:
+            return ReadIntegerAs <DataType::INT32> (value);
+
+        case DataType::INT64:
+            return ReadIntegerAs <DataType::INT64> (value);
+
+        default:
+            assert (false);
+            return 0;
+    }
+}
+
+void WriteIntegerValue (DataType dataType, int64_t value, AnyDataContainer &output)
+{
+    if (output.GetType () != dataType)
+    {
+        output = AnyDataContainer (dataType);
+    }
+
+    switch (dataType)
+    {
+        case DataType::INT8:
+            WriteIntegerAs <DataType::INT8> (value, output);
+            break;
+
+        case DataType::INT16:
+            WriteIntegerAs <DataType::INT16> (value, output);
+            break;
+
+        case DataType::INT32:
+            WriteIntegerAs <DataType::INT32> (value, output);
+            break;
+
+        case DataType::INT64:
+            WriteIntegerAs <DataType::INT64> (value, output);
+            break;
+
+        default:
+            assert (false);
+            break;
+    }
+}
+
+CompressedIntegerStorage::CompressedIntegerStorage ()
+    : blocks_ (),
+      hasHotBlock_ (false),
+      hotBlockIndex_ (0u),
+      hotPresence_ {},
+      hotValues_ {},
+      valuesCount_ (0u)
+{
+}
+
+bool CompressedIntegerStorage::Get (AnyDataId rowId, int64_t &output) const
+{
+    const uint64_t blockIndex = rowId / BLOCK_SIZE;
+    const auto slot = static_cast <uint32_t> (rowId % BLOCK_SIZE);
+
+    if (hasHotBlock_ && hotBlockIndex_ == blockIndex)
+    {
+        output = hotValues_[slot];
+        return IsPresent (hotPresence_, slot);
+    }
+
+    const Block *block = FindBlock (blockIndex);
+    if (!block || !IsPresent (block->presence_, slot))
+    {
+        return false;
+    }
+
+    output = DecodeAt (*block, GetRank (block->presence_, slot));
+    return true;
+}
+
+bool CompressedIntegerStorage::Has (AnyDataId rowId) const
+{
+    const uint64_t blockIndex = rowId / BLOCK_SIZE;
+    const auto slot = static_cast <uint32_t> (rowId % BLOCK_SIZE);
+
+    if (hasHotBlock_ && hotBlockIndex_ == blockIndex)
+    {
+        return IsPresent (hotPresence_, slot);
+    }
+
+    const Block *block = FindBlock (blockIndex);
+    return block && IsPresent (block->presence_, slot);
+}
+
+void CompressedIntegerStorage::Set (AnyDataId rowId, int64_t value)
+{
+    const uint64_t blockIndex = rowId / BLOCK_SIZE;
+    const auto slot = static_cast <uint32_t> (rowId % BLOCK_SIZE);
+
+    if (!hasHotBlock_ || hotBlockIndex_ != blockIndex)
+    {
+        SwitchHotBlock (blockIndex);
+    }
+
+    valuesCount_ += !IsPresent (hotPresence_, slot);
+    hotPresence_[slot / 64u] |= uint64_t (1u) << (slot % 64u);
+    hotValues_[slot] = value;
+}
+
+void CompressedIntegerStorage::Erase (AnyDataId rowId)
+{
+    const uint64_t blockIndex = rowId / BLOCK_SIZE;
+    const auto slot = static_cast <uint32_t> (rowId % BLOCK_SIZE);
+
+    if (!hasHotBlock_ || hotBlockIndex_ != blockIndex)
+    {
+        const Block *block = FindBlock (blockIndex);
+        if (!block || !IsPresent (block->presence_, slot))
+        {
+            return;
+        }
+
+        SwitchHotBlock (blockIndex);
+    }
+
+    valuesCount_ -= IsPresent (hotPresence_, slot);
+    hotPresence_[slot / 64u] &= ~(uint64_t (1u) << (slot % 64u));
+    hotValues_[slot] = 0;
+}
+
+void CompressedIntegerStorage::Gather (const AnyDataId *rows, std::size_t count,
+                                       int64_t *values, uint8_t *present) const
+{
+    // Rows are usually grouped by blocks, so whole block is decoded once instead of decoding every value separately.
+    int64_t decoded[BLOCK_SIZE];
+    const Block *decodedBlock = nullptr;
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const uint64_t blockIndex = rows[index] / BLOCK_SIZE;
+        const auto slot = static_cast <uint32_t> (rows[index] % BLOCK_SIZE);
+        values[index] = 0;
+
+        if (hasHotBlock_ && hotBlockIndex_ == blockIndex)
+        {
+            present[index] = IsPresent (hotPresence_, slot);
+            values[index] = hotValues_[slot];
+            continue;
+        }
+
+        const Block *block = FindBlock (blockIndex);
+        present[index] = block && IsPresent (block->presence_, slot);
+
+        if (!present[index])
+        {
+            continue;
+        }
+
+        const uint32_t rank = GetRank (block->presence_, slot);
+        if (block->encoding_ == Encoding::FRAME_OF_REFERENCE)
+        {
+            // Frame of reference values are accessed directly, there is no need to decode whole block.
+            values[index] = DecodeAt (*block, rank);
+        }
+        else
+        {
+            if (block != decodedBlock)
+            {
+                DecodeAll (*block, decoded);
+                decodedBlock = block;
+            }
+
+            values[index] = decoded[rank];
+        }
+    }
+}
+
+std::size_t CompressedIntegerStorage::GetValuesCount () const
+{
+    return valuesCount_;
+}
+
+std::size_t CompressedIntegerStorage::GetEncodedSize () const
+{
+    std::size_t size = hasHotBlock_ ? sizeof (hotPresence_) + sizeof (hotValues_) : 0u;
+    for (const auto &indexBlockPair : blocks_)
+    {
+        size += sizeof (Block) + indexBlockPair.second.packed_.size () * sizeof (uint64_t) +
+                indexBlockPair.second.runEnds_.size ();
+    }
+
+    return size;
+}
+
+bool CompressedIntegerStorage::GetBlockEncoding (uint64_t blockIndex, Encoding &output) const
+{
+    const Block *block = FindBlock (blockIndex);
+    if (!block)
+    {
+        return false;
+    }
+
+    output = block->encoding_;
+    return true;
+}
+
+uint32_t CompressedIntegerStorage::GetRank (const uint64_t *presence, uint32_t slot)
+{
+    uint32_t rank = 0u;
+    for (uint32_t word = 0u; word < slot / 64u; ++word)
+    {
+        rank += static_cast <uint32_t> (std::bitset <64> (presence[word]).count ());
+    }
+
+    const uint64_t mask = (uint64_t (1u) << (slot % 64u)) - 1u;
+    return rank + static_cast <uint32_t> (std::bitset <64> (presence[slot / 64u] & mask).count ());
+}
+
+bool CompressedIntegerStorage::IsPresent (const uint64_t *presence, uint32_t slot)
+{
+    return (presence[slot / 64u] >> (slot % 64u)) & 1u;
+}
+
+int64_t CompressedIntegerStorage::DecodeAt (const Block &block, uint32_t rank)
+{
+    switch (block.encoding_)
+    {
+        case Encoding::FRAME_OF_REFERENCE:
+            return AddOffset (block.base_, Unpack (block.packed_, rank, block.bitWidth_));
+
+        case Encoding::DELTA:
+        {
+            int64_t value = block.base_;
+            for (uint32_t index = 0u; index < rank; ++index)
+            {
+                value = AddOffset (AddOffset (value, static_cast <uint64_t> (block.step_)),
+                                   Unpack (block.packed_, index, block.bitWidth_));
+            }
+
+            return value;
+        }
+
+        case Encoding::RUN_LENGTH:
+        {
+            auto run = std::upper_bound (block.runEnds_.begin (), block.runEnds_.end (), rank);
+            assert (run != block.runEnds_.end ());
+            return AddOffset (block.base_, Unpack (block.packed_, run - block.runEnds_.begin (), block.bitWidth_));
+        }
+    }
+
+    assert (false);
+    return 0;
+}
+
+uint32_t CompressedIntegerStorage::DecodeAll (const Block &block, int64_t *output)
+{
+    uint32_t count = 0u;
+    for (uint64_t word : block.presence_)
+    {
+        count += static_cast <uint32_t> (std::bitset <64> (word).count ());
+    }
+
+    switch (block.encoding_)
+    {
+        case Encoding::FRAME_OF_REFERENCE:
+            for (uint32_t index = 0u; index < count; ++index)
+            {
+                output[index] = AddOffset (block.base_, Unpack (block.packed_, index, block.bitWidth_));
+            }
+
+            break;
+
+        case Encoding::DELTA:
+            if (count > 0u)
+            {
+                output[0u] = block.base_;
+            }
+
+            for (uint32_t index = 1u; index < count; ++index)
+            {
+                output[index] = AddOffset (AddOffset (output[index - 1u], static_cast <uint64_t> (block.step_)),
+                                           Unpack (block.packed_, index - 1u, block.bitWidth_));
+            }
+
+            break;
+
+        case Encoding::RUN_LENGTH:
+        {
+            uint32_t begin = 0u;
+            for (std::size_t run = 0u; run < block.runEnds_.size (); ++run)
+            {
+                const int64_t value = AddOffset (block.base_, Unpack (block.packed_, run, block.bitWidth_));
+                std::fill (output + begin, output + block.runEnds_[run], value);
+                begin = block.runEnds_[run];
+            }
+
+            break;
+        }
+    }
+
+    return count;
+}
+
+void CompressedIntegerStorage::Encode (const int64_t *values, uint32_t count, Block &output)
+{
+    assert (count > 0u && count <= BLOCK_SIZE);
+    const auto [minimum, maximum] = std::minmax_element (values, values + count);
+    const uint8_t valuesWidth = GetBitWidth (GetOffset (*maximum, *minimum));
+
+    int64_t minimumStep = 0;
+    uint64_t maximumStepOffset = 0u;
+    uint32_t runsCount = 1u;
+
+    for (uint32_t index = 1u; index < count; ++index)
+    {
+        const auto step = static_cast <int64_t> (GetOffset (values[index], values[index - 1u]));
+        minimumStep = index == 1u ? step : std::min (minimumStep, step);
+        runsCount += values[index] != values[index - 1u];
+    }
+
+    for (uint32_t index = 1u; index < count; ++index)
+    {
+        const auto step = static_cast <int64_t> (GetOffset (values[index], values[index - 1u]));
+        maximumStepOffset = std::max (maximumStepOffset, GetOffset (step, minimumStep));
+    }
+
+    const uint8_t stepsWidth = GetBitWidth (maximumStepOffset);
+    const std::size_t frameOfReferenceSize = GetPackedWordsCount (count, valuesWidth) * sizeof (uint64_t);
+    const std::size_t deltaSize = GetPackedWordsCount (count - 1u, stepsWidth) * sizeof (uint64_t);
+    const std::size_t runLengthSize = GetPackedWordsCount (runsCount, valuesWidth) * sizeof (uint64_t) + runsCount;
+
+    uint64_t offsets[BLOCK_SIZE];
+    output.runEnds_.clear ();
+    output.step_ = 0;
+
+    // Frame of reference is preferred on ties, because it has constant time access to any value.
+    if (frameOfReferenceSize <= deltaSize && frameOfReferenceSize <= runLengthSize)
+    {
+        output.encoding_ = Encoding::FRAME_OF_REFERENCE;
+        output.bitWidth_ = valuesWidth;
+        output.base_ = *minimum;
+
+        for (uint32_t index = 0u; index < count; ++index)
+        {
+            offsets[index] = GetOffset (values[index], *minimum);
+        }
+
+        Pack (offsets, count, valuesWidth, output.packed_);
+    }
+    else if (deltaSize <= runLengthSize)
+    {
+        output.encoding_ = Encoding::DELTA;
+        output.bitWidth_ = stepsWidth;
+        output.base_ = values[0u];
+        output.step_ = minimumStep;
+
+        for (uint32_t index = 1u; index < count; ++index)
+        {
+            offsets[index - 1u] = GetOffset (
+                static_cast <int64_t> (GetOffset (values[index], values[index - 1u])), minimumStep);
+        }
+
+        Pack (offsets, count - 1u, stepsWidth, output.packed_);
+    }
+    else
+    {
+        output.encoding_ = Encoding::RUN_LENGTH;
+        output.bitWidth_ = valuesWidth;
+        output.base_ = *minimum;
+        output.runEnds_.reserve (runsCount);
+
+        uint32_t run = 0u;
+        for (uint32_t index = 0u; index < count; ++index)
+        {
+            if (index + 1u == count || values[index + 1u] != values[index])
+            {
+                offsets[run++] = GetOffset (values[index], *minimum);
+                output.runEnds_.emplace_back (static_cast <uint8_t> (index + 1u));
+            }
+        }
+
+        Pack (offsets, runsCount, valuesWidth, output.packed_);
+    }
+}
+
+const CompressedIntegerStorage::Block *CompressedIntegerStorage::FindBlock (uint64_t blockIndex) const
+{
+    auto iterator = blocks_.find (blockIndex);
+    return iterator == blocks_.end () ? nullptr : &iterator->second;
+}
+
+void CompressedIntegerStorage::SwitchHotBlock (uint64_t blockIndex)
+{
+    int64_t compacted[BLOCK_SIZE];
+    if (hasHotBlock_)
+    {
+        uint32_t count = 0u;
+        for (uint32_t slot = 0u; slot < BLOCK_SIZE; ++slot)
+        {
+            if (IsPresent (hotPresence_, slot))
+            {
+                compacted[count++] = hotValues_[slot];
+            }
+        }
+
+        // Blocks without values are not stored.
+        if (count > 0u)
+        {
+            Block &block = blocks_[hotBlockIndex_];
+            memcpy (block.presence_, hotPresence_, sizeof (hotPresence_));
+            Encode (compacted, count, block);
+        }
+    }
+
+    hasHotBlock_ = true;
+    hotBlockIndex_ = blockIndex;
+    memset (hotPresence_, 0, sizeof (hotPresence_));
+    memset (hotValues_, 0, sizeof (hotValues_));
+
+    auto iterator = blocks_.find (blockIndex);
+    if (iterator != blocks_.end ())
+    {
+        DecodeAll (iterator->second, compacted);
+        memcpy (hotPresence_, iterator->second.presence_, sizeof (hotPresence_));
+
+        uint32_t rank = 0u;
+        for (uint32_t slot = 0u; slot < BLOCK_SIZE; ++slot)
+        {
+            if (IsPresent (hotPresence_, slot))
+            {
+                hotValues_[slot] = compacted[rank++];
+            }
+        }
+
+        blocks_.erase (iterator);
+    }
+}
+}
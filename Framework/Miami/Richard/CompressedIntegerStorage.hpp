@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/Data.hpp>
+
+namespace Miami::Richard
+{
+/// Reads value of any integer type as 64 bit integer.
+int64_t ReadIntegerValue (const AnyDataContainer &value);
+
+/// Writes value to given container, changing its type to given integer type if needed.
+void WriteIntegerValue (DataType dataType, int64_t value, AnyDataContainer &output);
+
+/// Storage for values of compressed integer columns. Rows are grouped into blocks by their ids and every block is
+/// encoded by the most compact of supported encodings. Nulls are not stored: block has presence bitmap and blocks
+/// without values are not stored at all, so sparse columns cost almost nothing. Last written block is kept decoded,
+/// therefore sequential inserts do not reencode block on every row.
+class CompressedIntegerStorage final
+{
+public:
+    static constexpr uint32_t BLOCK_SIZE = 128u;
+
+    enum class Encoding : uint8_t
+    {
+        /// Values are stored as bit packed offsets from minimal value.
+        FRAME_OF_REFERENCE = 0,
+
+        /// First value is stored as is, differences between neighbour values are stored like frame of reference.
+        DELTA,
+
+        /// Runs of equal values are stored as bit packed values and run end positions.
+        RUN_LENGTH
+    };
+
+    CompressedIntegerStorage ();
+
+    /// Returns false if value is null.
+    free_call bool Get (AnyDataId rowId, int64_t &output) const;
+
+    free_call bool Has (AnyDataId rowId) const;
+
+    void Set (AnyDataId rowId, int64_t value);
+
+    void Erase (AnyDataId rowId);
+
+    /// Decodes values of given rows. Presence of value is written as 0 or 1, null values are written as zeros.
+    void Gather (const AnyDataId *rows, std::size_t count, int64_t *values, uint8_t *present) const;
+
+    /// Returns count of non null values.
+    free_call std::size_t GetValuesCount () const;
+
+    /// Returns count of bytes, used by values and metadata of all blocks.
+    free_call std::size_t GetEncodedSize () const;
+
+    /// Returns false if there is no encoded block with given index. Block, that is being written, is not encoded.
+    free_call bool GetBlockEncoding (uint64_t blockIndex, Encoding &output) const;
+
+private:
+    static constexpr uint32_t PRESENCE_WORDS = BLOCK_SIZE / 64u;
+
+    struct Block
+    {
+        uint64_t presence_[PRESENCE_WORDS];
+        Encoding encoding_;
+        uint8_t bitWidth_;
+
+        /// Minimal value for frame of reference and run length, first value for delta.
+        int64_t base_;
+
+        /// Minimal difference between neighbour values for delta.
+        int64_t step_;
+
+        std::vector <uint64_t> packed_;
+
+        /// Exclusive ends of runs in present values sequence. Used only by run length.
+        std::vector <uint8_t> runEnds_;
+    };
+
+    static uint32_t GetRank (const uint64_t *presence, uint32_t slot);
+
+    static bool IsPresent (const uint64_t *presence, uint32_t slot);
+
+    static int64_t DecodeAt (const Block &block, uint32_t rank);
+
+    /// Writes present values to output in slot order, returns their count.
+    static uint32_t DecodeAll (const Block &block, int64_t *output);
+
+    static void Encode (const int64_t *values, uint32_t count, Block &output);
+
+    free_call const Block *FindBlock (uint64_t blockIndex) const;
+
+    /// Encodes block, that is being written, and decodes block with given index in its place.
+    void SwitchHotBlock (uint64_t blockIndex);
+
+    std::unordered_map <uint64_t, Block> blocks_;
+
+    bool hasHotBlock_;
+    uint64_t hotBlockIndex_;
+    uint64_t hotPresence_[PRESENCE_WORDS];
+    int64_t hotValues_[BLOCK_SIZE];
+    std::size_t valuesCount_;
+};
+}
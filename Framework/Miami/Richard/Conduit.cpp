@@ -1,15 +1,19 @@
+#include <algorithm>
 #include <cassert>
 
 #include <Miami/Evan/Logger.hpp>
 
 #include <Miami/Richard/Conduit.hpp>
+#include <Miami/Richard/Encoding.hpp>
+#include <Miami/Richard/Replication.hpp>
 
 namespace Miami::Richard
 {
-Conduit::Conduit (Disco::Context *multithreadingContext)
+Conduit::Conduit (Disco::Context *multithreadingContext, MutationLog *mutationLog)
     : guard_ (multithreadingContext),
       tables_ (),
-      nextTableId_ (0)
+      nextTableId_ (0),
+      mutationLog_ (mutationLog)
 {
 }
 
@@ -85,6 +89,14 @@ ResultCode Conduit::AddTable (const std::shared_ptr <Disco::SafeLockGuard> &writ
 
         if (result.second)
         {
+            if (mutationLog_)
+            {
+                std::vector <uint8_t> payload;
+                Encoding::AppendString (name, payload);
+                mutationLog_->Append (MutationType::ADD_TABLE, tableId, tableId, payload);
+                result.first->second->mutationLog_ = mutationLog_;
+            }
+
             return ResultCode::OK;
         }
         else
@@ -118,6 +130,11 @@ ResultCode Conduit::RemoveTable (const std::shared_ptr <Disco::SafeLockGuard> &w
         if (!iterator->second || iterator->second->IsSafeToRemove (tableWriteGuard))
         {
             tables_.erase (iterator);
+            if (mutationLog_)
+            {
+                mutationLog_->Append (MutationType::REMOVE_TABLE, tableId, tableId, {});
+            }
+
             return ResultCode::OK;
         }
         else
@@ -127,6 +144,200 @@ ResultCode Conduit::RemoveTable (const std::shared_ptr <Disco::SafeLockGuard> &w
     }
 }
 
+ResultCode Conduit::PrepareTransaction (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                        const std::vector <AnyDataId> &tableIds,
+                                        std::vector <Disco::AnyLockPointer> &outputLocks)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (tableIds.empty ())
+    {
+        return ResultCode::TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE;
+    }
+
+    std::vector <Disco::AnyLockPointer> locks;
+    locks.reserve (tableIds.size ());
+
+    for (auto iterator = tableIds.begin (); iterator != tableIds.end (); ++iterator)
+    {
+        // Capturing the same lock twice in one lock group leads to deadlock.
+        if (std::find (tableIds.begin (), iterator, *iterator) != iterator)
+        {
+            return ResultCode::TRANSACTION_TABLES_MUST_BE_UNIQUE;
+        }
+
+        auto tableIterator = tables_.find (*iterator);
+        if (tableIterator == tables_.end ())
+        {
+            return ResultCode::TABLE_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        locks.emplace_back (&tableIterator->second->ReadWriteGuard ().Write ());
+    }
+
+    outputLocks.insert (outputLocks.end (), locks.begin (), locks.end ());
+    return ResultCode::OK;
+}
+
+ResultCode Conduit::BeginTransaction (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                      const std::vector <AnyDataId> &tableIds,
+                                      const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &tableWriteGuards,
+                                      Transaction *&output)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (tableIds.size () != tableWriteGuards.size ())
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                  "Unable to begin transaction: tables count is not equal to guards count!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    std::vector <Transaction::TableData> tables;
+    tables.reserve (tableIds.size ());
+
+    for (std::size_t index = 0; index < tableIds.size (); ++index)
+    {
+        auto tableIterator = tables_.find (tableIds[index]);
+        if (tableIterator == tables_.end ())
+        {
+            return ResultCode::TABLE_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        if (!Disco::IsWriteCaptured (tableWriteGuards[index], tableIterator->second->ReadWriteGuard ()))
+        {
+            Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                      "Unable to begin transaction: given guard is not write guard of table " +
+                                      std::to_string (tableIds[index]) + "!");
+            assert (false);
+            return ResultCode::INVARIANTS_VIOLATED;
+        }
+
+        tables.emplace_back (Transaction::TableData {tableIterator->second.get (), tableWriteGuards[index]});
+    }
+
+    output = new Transaction (std::move (tables));
+    return ResultCode::OK;
+}
+
+ResultCode Conduit::PrepareBackup (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                   std::vector <AnyDataId> &outputTableIds,
+                                   std::vector <Disco::AnyLockPointer> &outputLocks)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    std::vector <AnyDataId> tableIds;
+    tableIds.reserve (tables_.size ());
+
+    for (const auto &idTablePair : tables_)
+    {
+        tableIds.emplace_back (idTablePair.first);
+    }
+
+    std::sort (tableIds.begin (), tableIds.end ());
+    for (AnyDataId tableId : tableIds)
+    {
+        outputLocks.emplace_back (&tables_.at (tableId)->ReadWriteGuard ().Read ());
+    }
+
+    outputTableIds.insert (outputTableIds.end (), tableIds.begin (), tableIds.end ());
+    return ResultCode::OK;
+}
+
+ResultCode Conduit::BeginBackup (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                 const std::vector <AnyDataId> &tableIds,
+                                 const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &tableGuards,
+                                 ConduitBackup *&output)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (tableIds.size () != tableGuards.size ())
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                  "Unable to begin backup: tables count is not equal to guards count!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    // Tables could be added after preparation, if conduit guard was released in between.
+    if (tableIds.size () != tables_.size ())
+    {
+        return ResultCode::BACKUP_MUST_COVER_ALL_TABLES;
+    }
+
+    std::vector <Table *> tables;
+    tables.reserve (tableIds.size ());
+
+    for (std::size_t index = 0; index < tableIds.size (); ++index)
+    {
+        auto tableIterator = tables_.find (tableIds[index]);
+        if (tableIterator == tables_.end ())
+        {
+            return ResultCode::BACKUP_MUST_COVER_ALL_TABLES;
+        }
+
+        if (!Disco::IsReadOrWriteCaptured (tableGuards[index], tableIterator->second->ReadWriteGuard ()))
+        {
+            Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                      "Unable to begin backup: given guard is not read or write guard of table " +
+                                      std::to_string (tableIds[index]) + "!");
+            assert (false);
+            return ResultCode::INVARIANTS_VIOLATED;
+        }
+
+        tables.emplace_back (tableIterator->second.get ());
+    }
+
+    output = new ConduitBackup (tables, nextTableId_);
+    return ResultCode::OK;
+}
+
+ResultCode Conduit::RestoreBackup (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
+                                   const std::string &path, Disco::Context *workers)
+{
+    if (!CheckWriteGuard (writeGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (!tables_.empty ())
+    {
+        return ResultCode::BACKUP_RESTORE_REQUIRES_EMPTY_CONDUIT;
+    }
+
+    Janitor::FlatHashMap <AnyDataId, std::unique_ptr <Table>> tables;
+    AnyDataId nextTableId = 0;
+
+    ResultCode result = ConduitBackup::ReadFromFile (path, guard_.Write ().GetContext (), workers,
+                                                     tables, nextTableId);
+    if (result == ResultCode::OK)
+    {
+        // Restored tables are not logged, because replicas are started from the same backup.
+        for (auto &idTablePair : tables)
+        {
+            idTablePair.second->mutationLog_ = mutationLog_;
+        }
+
+        tables_ = std::move (tables);
+        nextTableId_ = nextTableId;
+    }
+
+    return result;
+}
+
 bool Conduit::CheckReadOrWriteGuard (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard) const
 {
     if (Disco::IsReadOrWriteCaptured (readOrWriteGuard, guard_))
@@ -1,21 +1,29 @@
 #pragma once
 
-#include <unordered_map>
+#include <memory>
+#include <string>
 
 #include <Miami/Annotations.hpp>
 
 #include <Miami/Disco/Disco.hpp>
 
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Backup.hpp>
 #include <Miami/Richard/Data.hpp>
 #include <Miami/Richard/Table.hpp>
+#include <Miami/Richard/Transaction.hpp>
 
 namespace Miami::Richard
 {
+class MutationLog;
+
 // TODO: Add tests for whole Richard library. Don't have time now because of tight deadline.
 class Conduit final
 {
 public:
-    explicit Conduit (Disco::Context *multithreadingContext);
+    /// If mutation log is given, successful changes of conduit and its tables are appended to it.
+    explicit Conduit (Disco::Context *multithreadingContext, MutationLog *mutationLog = nullptr);
 
     free_call Disco::ReadWriteGuard &ReadWriteGuard ();
 
@@ -32,6 +40,35 @@ public:
                                       const std::shared_ptr <Disco::SafeLockGuard> &tableWriteGuard,
                                       AnyDataId tableId);
 
+    /// Collects write locks of given tables. They should be captured together by one lock group, for example
+    /// by Disco::After with locks vector, and passed to ::BeginTransaction in the same order.
+    free_call ResultCode PrepareTransaction (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                             const std::vector <AnyDataId> &tableIds,
+                                             std::vector <Disco::AnyLockPointer> &outputLocks);
+
+    free_call ResultCode BeginTransaction (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                           const std::vector <AnyDataId> &tableIds,
+                                           const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &tableWriteGuards,
+                                           Transaction *&output);
+
+    /// Collects ids and read locks of all tables. Locks should be captured together by one lock group
+    /// and passed to ::BeginBackup in the same order, see ::PrepareTransaction.
+    free_call ResultCode PrepareBackup (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                        std::vector <AnyDataId> &outputTableIds,
+                                        std::vector <Disco::AnyLockPointer> &outputLocks);
+
+    /// Captures consistent image of all tables. Table guards could be released right after this call,
+    /// so writers are blocked only while schemas and row sets are copied.
+    free_call ResultCode BeginBackup (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                      const std::vector <AnyDataId> &tableIds,
+                                      const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &tableGuards,
+                                      ConduitBackup *&output);
+
+    /// Loads all tables from backup file, written by ConduitBackup::WriteToFile. Table, column, index and row
+    /// ids are preserved. Conduit must be empty. If workers context is given, tables are loaded in parallel.
+    free_call ResultCode RestoreBackup (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
+                                        const std::string &path, Disco::Context *workers);
+
 private:
     free_call bool CheckReadOrWriteGuard (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard) const;
 
@@ -40,7 +77,10 @@ private:
     Disco::ReadWriteGuard guard_;
 
     // TODO: Unique pointer because moving structures with Disco locks is unsafe for now.
-    std::unordered_map <AnyDataId, std::unique_ptr <Table>> tables_;
+    Janitor::FlatHashMap <AnyDataId, std::unique_ptr <Table>> tables_;
     AnyDataId nextTableId_;
+    MutationLog *mutationLog_;
+
+    friend class MutationApplier;
 };
 }
\ No newline at end of file
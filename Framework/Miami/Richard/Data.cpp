@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstring>
+
 #include <Miami/Richard/Data.hpp>
 
 namespace Miami::Richard
@@ -32,12 +35,140 @@ const char *GetDataTypeName (DataType dataType)
 
         case DataType::BLOB_16KB:
             return "blob_16kb";
+
+        case DataType::VARCHAR:
+            return "varchar";
+
+        case DataType::VARBINARY:
+            return "varbinary";
     }
 
     assert (false);
     return "UNKNOWN";
 }
 
+VariableData::VariableData () noexcept
+    : size_ (0u),
+      inline_ {}
+{
+}
+
+VariableData::VariableData (const VariableData &other)
+    : VariableData ()
+{
+    *this = other;
+}
+
+VariableData::VariableData (VariableData &&other) noexcept
+    : VariableData ()
+{
+    *this = std::move (other);
+}
+
+VariableData::~VariableData ()
+{
+    Release ();
+}
+
+VariableData &VariableData::operator = (const VariableData &other)
+{
+    if (this != &other)
+    {
+        Resize (other.size_);
+        memcpy (GetData (), other.GetData (), size_);
+    }
+
+    return *this;
+}
+
+VariableData &VariableData::operator = (VariableData &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release ();
+        size_ = other.size_;
+
+        if (other.IsInline ())
+        {
+            memcpy (inline_, other.inline_, size_);
+        }
+        else
+        {
+            // External buffer is transferred, so moves never allocate.
+            external_ = other.external_;
+            other.size_ = 0u;
+        }
+    }
+
+    return *this;
+}
+
+uint32_t VariableData::GetSize () const
+{
+    return size_;
+}
+
+void VariableData::Resize (uint32_t size)
+{
+    Release ();
+    size_ = size;
+
+    if (IsInline ())
+    {
+        memset (inline_, 0, INLINE_CAPACITY);
+    }
+    else
+    {
+        external_ = new uint8_t[size_] ();
+    }
+}
+
+uint8_t *VariableData::GetData ()
+{
+    return IsInline () ? inline_ : external_;
+}
+
+const uint8_t *VariableData::GetData () const
+{
+    return IsInline () ? inline_ : external_;
+}
+
+int VariableData::Compare (const VariableData &another) const
+{
+    int result = memcmp (GetData (), another.GetData (), std::min (size_, another.size_));
+    if (result != 0)
+    {
+        return result;
+    }
+
+    return size_ < another.size_ ? -1 : (size_ > another.size_ ? 1 : 0);
+}
+
+bool VariableData::operator == (const VariableData &another) const
+{
+    return size_ == another.size_ && memcmp (GetData (), another.GetData (), size_) == 0;
+}
+
+bool VariableData::operator < (const VariableData &another) const
+{
+    return Compare (another) < 0;
+}
+
+void VariableData::Release ()
+{
+    if (!IsInline ())
+    {
+        delete[] external_;
+    }
+
+    size_ = 0u;
+}
+
+bool VariableData::IsInline () const
+{
+    return size_ <= INLINE_CAPACITY;
+}
+
 AnyDataContainer::AnyDataContainer ()
     : container_ ()
 {
@@ -56,6 +187,11 @@ AnyDataContainer::AnyDataContainer (const AnyDataContainer &other)
     CopyFrom (other);
 }
 
+AnyDataContainer::AnyDataContainer (AnyDataContainer &&other) noexcept
+    : container_ (std::move (other.container_))
+{
+}
+
 DataType AnyDataContainer::GetType () const
 {
     return static_cast<DataType>(container_.index ());
@@ -84,12 +220,55 @@ const void *AnyDataContainer::GetDataStartPointer () const
                        }, container_);
 }
 
+uint32_t AnyDataContainer::GetDataSize () const
+{
+    if (auto *varchar = std::get_if <DataContainer <DataType::VARCHAR>> (&container_))
+    {
+        return varchar->value_.GetSize ();
+    }
+    else if (auto *varbinary = std::get_if <DataContainer <DataType::VARBINARY>> (&container_))
+    {
+        return varbinary->value_.GetSize ();
+    }
+    else
+    {
+        return GetDataTypeSize (GetType ());
+    }
+}
+
+void AnyDataContainer::ResizeData (uint32_t size)
+{
+    if (auto *varchar = std::get_if <DataContainer <DataType::VARCHAR>> (&container_))
+    {
+        varchar->value_.Resize (size);
+    }
+    else if (auto *varbinary = std::get_if <DataContainer <DataType::VARBINARY>> (&container_))
+    {
+        varbinary->value_.Resize (size);
+    }
+    else
+    {
+        // Only variable size values could be resized.
+        assert (false);
+    }
+}
+
 void AnyDataContainer::CopyFrom (const AnyDataContainer &other)
 {
-    ConstructContainerFromType (other.GetType ());
+    // Storage of fixed size value could be reused if types are equal and storage was not moved out.
+    if (GetType () != other.GetType () || IsVariableSizeDataType (GetType ()) || !GetDataStartPointer ())
+    {
+        ConstructContainerFromType (other.GetType ());
+    }
+
+    if (IsVariableSizeDataType (GetType ()))
+    {
+        ResizeData (other.GetDataSize ());
+    }
+
     if (GetDataStartPointer () && other.GetDataStartPointer ())
     {
-        memcpy (GetDataStartPointer (), other.GetDataStartPointer (), GetDataTypeSize (GetType ()));
+        memcpy (GetDataStartPointer (), other.GetDataStartPointer (), GetDataSize ());
     }
     else
     {
@@ -175,6 +354,14 @@ void AnyDataContainer::ConstructContainerFromType (DataType dataType)
             container_ = DataContainer <DataType::BLOB_16KB> ();
             break;
 
+        case DataType::VARCHAR:
+            container_ = DataContainer <DataType::VARCHAR> ();
+            break;
+
+        case DataType::VARBINARY:
+            container_ = DataContainer <DataType::VARBINARY> ();
+            break;
+
         default:
             assert (false);
             // TODO: Log error.
@@ -8,6 +8,8 @@
 
 #include <Miami/Annotations.hpp>
 
+#include <Miami/Richard/SlabPool.hpp>
+
 namespace Miami::Richard
 {
 using AnyDataId = uint64_t;
@@ -22,11 +24,27 @@ enum class DataType
     STRING,
     LONG_STRING,
     HUGE_STRING,
-    BLOB_16KB
+    BLOB_16KB,
+    VARCHAR,
+    VARBINARY
 };
 
+/// Upper limit for sizes of variable size values. Columns could set lower limits.
+constexpr uint32_t MAX_VARIABLE_DATA_SIZE = 16384u;
+
 const char *GetDataTypeName (DataType dataType);
 
+constexpr bool IsIntegerDataType (DataType dataType)
+{
+    return dataType <= DataType::INT64;
+}
+
+constexpr bool IsVariableSizeDataType (DataType dataType)
+{
+    return dataType == DataType::VARCHAR || dataType == DataType::VARBINARY;
+}
+
+/// Returns 0 for variable size types, their sizes could be received only from values.
 constexpr uint32_t GetDataTypeSize (DataType dataType)
 {
     switch (dataType)
@@ -57,12 +75,64 @@ constexpr uint32_t GetDataTypeSize (DataType dataType)
 
         case DataType::BLOB_16KB:
             return 16384u;
+
+        case DataType::VARCHAR:
+        case DataType::VARBINARY:
+            return 0u;
     }
 
     assert (false);
     return 0;
 }
 
+/// Byte sequence of variable size. Short sequences are stored inline, longer ones
+/// are stored in separate buffers of exact size, so there is no space wasted on padding.
+class VariableData final
+{
+public:
+    static constexpr uint32_t INLINE_CAPACITY = 16u;
+
+    VariableData () noexcept;
+
+    VariableData (const VariableData &other);
+
+    VariableData (VariableData &&other) noexcept;
+
+    ~VariableData ();
+
+    VariableData &operator = (const VariableData &other);
+
+    VariableData &operator = (VariableData &&other) noexcept;
+
+    uint32_t GetSize () const;
+
+    /// Changes size of the sequence. Content is not preserved, new sequence is filled with zeros.
+    void Resize (uint32_t size);
+
+    uint8_t *GetData ();
+
+    const uint8_t *GetData () const;
+
+    /// Returns sign of lexicographical byte comparison result.
+    int Compare (const VariableData &another) const;
+
+    bool operator == (const VariableData &another) const;
+
+    bool operator < (const VariableData &another) const;
+
+private:
+    void Release ();
+
+    bool IsInline () const;
+
+    uint32_t size_;
+    union
+    {
+        uint8_t inline_[INLINE_CAPACITY];
+        uint8_t *external_;
+    };
+};
+
 template <DataType dataType>
 struct DataTypeToCxxType
 {
@@ -93,46 +163,58 @@ struct DataTypeToCxxType <DataType::INT64>
     using Type = int64_t;
 };
 
+template <>
+struct DataTypeToCxxType <DataType::VARCHAR>
+{
+    using Type = VariableData;
+};
+
+template <>
+struct DataTypeToCxxType <DataType::VARBINARY>
+{
+    using Type = VariableData;
+};
+
 template <DataType dataType>
 struct IsSmallDataType
 {
     static constexpr bool answer = GetDataTypeSize (dataType) <= GetDataTypeSize (DataType::SHORT_STRING);
 };
 
-template <DataType dataType, bool = IsSmallDataType <dataType>::answer>
+template <DataType dataType, bool = IsSmallDataType <dataType>::answer, bool = IsVariableSizeDataType (dataType)>
 struct DataContainer;
 
 template <DataType dataType>
-struct DataContainer <dataType, true>
+struct DataContainer <dataType, true, false>
 {
     typename DataTypeToCxxType <dataType>::Type value_ {};
 
-    bool operator == (const DataContainer <dataType, true> &another) const
+    bool operator == (const DataContainer <dataType, true, false> &another) const
     {
         return value_ == another.value_;
     }
 
-    bool operator != (const DataContainer <dataType, true> &another) const
+    bool operator != (const DataContainer <dataType, true, false> &another) const
     {
         return !(another == *this);
     }
 
-    bool operator < (const DataContainer <dataType, true> &another) const
+    bool operator < (const DataContainer <dataType, true, false> &another) const
     {
         return value_ < another.value_;
     }
 
-    bool operator > (const DataContainer <dataType, true> &another) const
+    bool operator > (const DataContainer <dataType, true, false> &another) const
     {
         return another < *this;
     }
 
-    bool operator <= (const DataContainer <dataType, true> &another) const
+    bool operator <= (const DataContainer <dataType, true, false> &another) const
     {
         return !(another < *this);
     }
 
-    bool operator >= (const DataContainer <dataType, true> &another) const
+    bool operator >= (const DataContainer <dataType, true, false> &another) const
     {
         return !(*this < another);
     }
@@ -149,12 +231,13 @@ struct DataContainer <dataType, true>
 };
 
 template <DataType dataType>
-struct DataContainer <dataType, false>
+struct DataContainer <dataType, false, false>
 {
-    std::unique_ptr <typename DataTypeToCxxType <dataType>::Type>
-        value_ {new typename DataTypeToCxxType <dataType>::Type ()};
+    // Big values are allocated from slab pools, because their allocations are frequent and have the same sizes.
+    SlabUniquePointer <typename DataTypeToCxxType <dataType>::Type>
+        value_ {MakeSlabUnique <typename DataTypeToCxxType <dataType>::Type> ()};
 
-    bool operator == (const DataContainer <dataType, false> &another) const
+    bool operator == (const DataContainer <dataType, false, false> &another) const
     {
         if (value_ == nullptr)
         {
@@ -170,12 +253,12 @@ struct DataContainer <dataType, false>
         }
     }
 
-    bool operator != (const DataContainer <dataType, false> &another) const
+    bool operator != (const DataContainer <dataType, false, false> &another) const
     {
         return !(another == *this);
     }
 
-    bool operator < (const DataContainer <dataType, false> &another) const
+    bool operator < (const DataContainer <dataType, false, false> &another) const
     {
         if (value_ == nullptr)
         {
@@ -191,17 +274,17 @@ struct DataContainer <dataType, false>
         }
     }
 
-    bool operator > (const DataContainer <dataType, false> &another) const
+    bool operator > (const DataContainer <dataType, false, false> &another) const
     {
         return another < *this;
     }
 
-    bool operator <= (const DataContainer <dataType, false> &another) const
+    bool operator <= (const DataContainer <dataType, false, false> &another) const
     {
         return !(another < *this);
     }
 
-    bool operator >= (const DataContainer <dataType, false> &another) const
+    bool operator >= (const DataContainer <dataType, false, false> &another) const
     {
         return !(*this < another);
     }
@@ -217,6 +300,53 @@ struct DataContainer <dataType, false>
     }
 };
 
+/// Variable size types are small: their data start pointer points to the sequence content, not to the container.
+template <DataType dataType>
+struct DataContainer <dataType, true, true>
+{
+    VariableData value_ {};
+
+    bool operator == (const DataContainer <dataType, true, true> &another) const
+    {
+        return value_ == another.value_;
+    }
+
+    bool operator != (const DataContainer <dataType, true, true> &another) const
+    {
+        return !(another == *this);
+    }
+
+    bool operator < (const DataContainer <dataType, true, true> &another) const
+    {
+        return value_ < another.value_;
+    }
+
+    bool operator > (const DataContainer <dataType, true, true> &another) const
+    {
+        return another < *this;
+    }
+
+    bool operator <= (const DataContainer <dataType, true, true> &another) const
+    {
+        return !(another < *this);
+    }
+
+    bool operator >= (const DataContainer <dataType, true, true> &another) const
+    {
+        return !(*this < another);
+    }
+
+    uint8_t *GetData ()
+    {
+        return value_.GetData ();
+    }
+
+    const uint8_t *GetData () const
+    {
+        return value_.GetData ();
+    }
+};
+
 // TODO: For now, all data types are PODs. Add static asserts, so there always will be only POD types.
 class AnyDataContainer final
 {
@@ -230,7 +360,9 @@ public:
         DataContainer <DataType::STRING>,
         DataContainer <DataType::LONG_STRING>,
         DataContainer <DataType::HUGE_STRING>,
-        DataContainer <DataType::BLOB_16KB>>;
+        DataContainer <DataType::BLOB_16KB>,
+        DataContainer <DataType::VARCHAR>,
+        DataContainer <DataType::VARBINARY>>;
 
     AnyDataContainer ();
 
@@ -252,6 +384,9 @@ public:
     //       Can not delete now, because it breaks shitty serialization implementation in client.
     AnyDataContainer (const AnyDataContainer &other);
 
+    /// Transfers value storage without reallocation.
+    AnyDataContainer (AnyDataContainer &&other) noexcept;
+
     DataType GetType () const;
 
     Container &Get ();
@@ -262,6 +397,12 @@ public:
 
     const void *GetDataStartPointer () const;
 
+    /// Returns size of data, that starts at ::GetDataStartPointer.
+    uint32_t GetDataSize () const;
+
+    /// Changes size of variable size value. Content is not preserved.
+    void ResizeData (uint32_t size);
+
     void CopyFrom (const AnyDataContainer &other);
 
     bool operator == (const AnyDataContainer &another) const;
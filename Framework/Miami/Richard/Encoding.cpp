@@ -0,0 +1,164 @@
+#include <cstring>
+
+#include <Miami/Richard/Encoding.hpp>
+
+namespace Miami::Richard::Encoding
+{
+void AppendString (const std::string &value, std::vector <uint8_t> &output)
+{
+    AppendPod (static_cast <uint32_t> (value.size ()), output);
+    output.insert (output.end (), value.begin (), value.end ());
+}
+
+void AppendIds (const std::vector <AnyDataId> &ids, std::vector <uint8_t> &output)
+{
+    AppendPod (static_cast <uint32_t> (ids.size ()), output);
+    for (AnyDataId id : ids)
+    {
+        AppendPod (id, output);
+    }
+}
+
+void AppendValue (const AnyDataContainer &value, std::vector <uint8_t> &output)
+{
+    AppendPod (static_cast <uint8_t> (value.GetType ()), output);
+    if (IsVariableSizeDataType (value.GetType ()))
+    {
+        AppendPod (static_cast <uint32_t> (value.GetDataSize ()), output);
+    }
+
+    const auto *data = static_cast <const uint8_t *> (value.GetDataStartPointer ());
+    output.insert (output.end (), data, data + value.GetDataSize ());
+}
+
+void AppendColumnInfo (const ColumnInfo &info, std::vector <uint8_t> &output)
+{
+    AppendPod (info.id_, output);
+    AppendPod (static_cast <uint8_t> (info.dataType_), output);
+    AppendString (info.name_, output);
+    AppendPod (info.maxSize_, output);
+    AppendPod (static_cast <uint8_t> (info.dictionaryEncoded_), output);
+    AppendPod (static_cast <uint8_t> (info.compressed_), output);
+}
+
+void AppendIndexInfo (const IndexInfo &info, std::vector <uint8_t> &output)
+{
+    AppendPod (info.id_, output);
+    AppendString (info.name_, output);
+    AppendPod (static_cast <uint8_t> (info.type_), output);
+    AppendPod (static_cast <uint8_t> (info.unique_), output);
+    AppendIds (info.columns_, output);
+    AppendIds (info.includedColumns_, output);
+}
+
+ByteReader::ByteReader (const std::vector <uint8_t> &input)
+    : input_ (input),
+      position_ (0u)
+{
+}
+
+bool ByteReader::ReadBytes (void *output, std::size_t size)
+{
+    if (input_.size () - position_ < size)
+    {
+        return false;
+    }
+
+    if (size > 0u)
+    {
+        memcpy (output, input_.data () + position_, size);
+        position_ += size;
+    }
+
+    return true;
+}
+
+bool ByteReader::ReadString (std::string &output)
+{
+    uint32_t size;
+    if (!Read (size) || input_.size () - position_ < size)
+    {
+        return false;
+    }
+
+    output.assign (reinterpret_cast <const char *> (input_.data () + position_), size);
+    position_ += size;
+    return true;
+}
+
+bool ByteReader::ReadIds (std::vector <AnyDataId> &output)
+{
+    uint32_t count;
+    if (!Read (count) || (input_.size () - position_) / sizeof (AnyDataId) < count)
+    {
+        return false;
+    }
+
+    output.resize (count);
+    return ReadBytes (output.data (), count * sizeof (AnyDataId));
+}
+
+bool ByteReader::ReadValue (AnyDataContainer &output)
+{
+    uint8_t type;
+    if (!Read (type) || type > static_cast <uint8_t> (DataType::VARBINARY))
+    {
+        return false;
+    }
+
+    output = AnyDataContainer (static_cast <DataType> (type));
+    uint32_t size = output.GetDataSize ();
+
+    if (IsVariableSizeDataType (output.GetType ()))
+    {
+        if (!Read (size) || size > MAX_VARIABLE_DATA_SIZE)
+        {
+            return false;
+        }
+
+        output.ResizeData (size);
+    }
+
+    return ReadBytes (output.GetDataStartPointer (), size);
+}
+
+bool ByteReader::ReadColumnInfo (ColumnInfo &output)
+{
+    uint8_t dataType;
+    uint8_t dictionaryEncoded;
+    uint8_t compressed;
+
+    if (!Read (output.id_) || !Read (dataType) || !ReadString (output.name_) || !Read (output.maxSize_) ||
+        !Read (dictionaryEncoded) || !Read (compressed) || dataType > static_cast <uint8_t> (DataType::VARBINARY))
+    {
+        return false;
+    }
+
+    output.dataType_ = static_cast <DataType> (dataType);
+    output.dictionaryEncoded_ = dictionaryEncoded;
+    output.compressed_ = compressed;
+    return true;
+}
+
+bool ByteReader::ReadIndexInfo (IndexInfo &output)
+{
+    uint8_t type;
+    uint8_t unique;
+
+    if (!Read (output.id_) || !ReadString (output.name_) || !Read (type) || !Read (unique) ||
+        !ReadIds (output.columns_) || !ReadIds (output.includedColumns_) ||
+        type > static_cast <uint8_t> (IndexType::HASH))
+    {
+        return false;
+    }
+
+    output.type_ = static_cast <IndexType> (type);
+    output.unique_ = unique;
+    return true;
+}
+
+bool ByteReader::IsFinished () const
+{
+    return position_ == input_.size ();
+}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Index.hpp>
+
+/// Binary encoding of schemas and values, shared by backups and replication. Values are written in host byte order.
+namespace Miami::Richard::Encoding
+{
+template <typename Type>
+void AppendPod (const Type &value, std::vector <uint8_t> &output)
+{
+    const auto *bytes = reinterpret_cast <const uint8_t *> (&value);
+    output.insert (output.end (), bytes, bytes + sizeof (Type));
+}
+
+void AppendString (const std::string &value, std::vector <uint8_t> &output);
+
+void AppendIds (const std::vector <AnyDataId> &ids, std::vector <uint8_t> &output);
+
+/// Type is written before value, so value could be read without schema. Variable size values have size prefix.
+void AppendValue (const AnyDataContainer &value, std::vector <uint8_t> &output);
+
+void AppendColumnInfo (const ColumnInfo &info, std::vector <uint8_t> &output);
+
+void AppendIndexInfo (const IndexInfo &info, std::vector <uint8_t> &output);
+
+/// Reads encoded data. Every read checks bounds, so malformed input is never read out of range.
+class ByteReader final
+{
+public:
+    explicit ByteReader (const std::vector <uint8_t> &input);
+
+    template <typename Type>
+    free_call bool Read (Type &output)
+    {
+        return ReadBytes (&output, sizeof (Type));
+    }
+
+    free_call bool ReadBytes (void *output, std::size_t size);
+
+    free_call bool ReadString (std::string &output);
+
+    free_call bool ReadIds (std::vector <AnyDataId> &output);
+
+    /// Reads value, written by Encoding::AppendValue.
+    free_call bool ReadValue (AnyDataContainer &output);
+
+    /// Checks only encoding itself, for example enum ranges. Schema rules are checked by readers.
+    free_call bool ReadColumnInfo (ColumnInfo &output);
+
+    free_call bool ReadIndexInfo (IndexInfo &output);
+
+    free_call bool IsFinished () const;
+
+private:
+    const std::vector <uint8_t> &input_;
+    std::size_t position_;
+};
+}
\ No newline at end of file
@@ -9,6 +9,21 @@
 
 namespace Miami::Richard
 {
+const char *GetIndexTypeName (IndexType indexType)
+{
+    switch (indexType)
+    {
+        case IndexType::ORDERED:
+            return "ordered";
+
+        case IndexType::HASH:
+            return "hash";
+    }
+
+    assert (false);
+    return "UNKNOWN";
+}
+
 IndexCursor::~IndexCursor ()
 {
     assert (sourceIndex_);
@@ -23,30 +38,32 @@ ResultCode IndexCursor::Advance (int64_t step)
     assert (sourceIndex_);
     if (sourceIndex_)
     {
+        Synchronize ();
         AssertPosition ();
         if (step < 0)
         {
-            if (-step > position_)
+            // Step is negated after increment, because negation of minimal step overflows.
+            if (static_cast <uint64_t> (-(step + 1)) >= position_)
             {
-                position_ = 0;
+                SetPosition (0u);
                 return ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN;
             }
             else
             {
-                position_ += step;
+                SetPosition (position_ + step);
                 return ResultCode::OK;
             }
         }
         else
         {
-            position_ += step;
-            if (position_ > sourceIndex_->order_.size ())
+            if (position_ + step > GetSequence ().size ())
             {
-                position_ = sourceIndex_->order_.size ();
+                SetPosition (GetSequence ().size ());
                 return ResultCode::CURSOR_ADVANCE_STOPPED_AT_END;
             }
             else
             {
+                SetPosition (position_ + step);
                 return ResultCode::OK;
             }
         }
@@ -62,10 +79,11 @@ ResultCode IndexCursor::GetCurrent (AnyDataId &output) const
     assert (sourceIndex_);
     if (sourceIndex_)
     {
+        Synchronize ();
         AssertPosition ();
-        if (position_ < sourceIndex_->order_.size ())
+        if (position_ < GetSequence ().size ())
         {
-            output = sourceIndex_->order_[position_];
+            output = GetSequence ()[position_];
             return ResultCode::OK;
         }
         else
@@ -79,33 +97,145 @@ ResultCode IndexCursor::GetCurrent (AnyDataId &output) const
     }
 }
 
+bool IndexCursor::GetCoveredValue (AnyDataId columnId, const AnyDataContainer *&output) const
+{
+    if (!sourceIndex_ || isLookup_)
+    {
+        return false;
+    }
+
+    Synchronize ();
+    if (position_ >= sourceIndex_->order_.size ())
+    {
+        return false;
+    }
+
+    return sourceIndex_->GetCoveredValue (position_, columnId, output);
+}
+
 IndexCursor::IndexCursor (Index *sourceIndex, uint64_t position)
-    : sourceIndex_ (sourceIndex),
-      position_ (position)
+    : position_ (position),
+      orderVersion_ (sourceIndex->orderVersion_),
+      anchorRowId_ (0u),
+      hasAnchor_ (false),
+      sourceIndex_ (sourceIndex),
+      isLookup_ (false),
+      lookupKey_ (),
+      lookupResult_ ()
 {
     assert (sourceIndex);
     AssertPosition ();
+    SetPosition (position);
+}
+
+IndexCursor::IndexCursor (Index *sourceIndex, KeyHashTable::Key lookupKey, std::vector <AnyDataId> lookupResult)
+    : position_ (0),
+      orderVersion_ (sourceIndex->orderVersion_),
+      anchorRowId_ (0u),
+      hasAnchor_ (false),
+      sourceIndex_ (sourceIndex),
+      isLookup_ (true),
+      lookupKey_ (std::move (lookupKey)),
+      lookupResult_ (std::move (lookupResult))
+{
+    assert (sourceIndex);
 }
 
 void IndexCursor::AssertPosition () const
 {
-    assert (position_ <= sourceIndex_->order_.size ());
+    assert (position_ <= GetSequence ().size ());
+}
+
+void IndexCursor::Synchronize () const
+{
+    if (isLookup_ || !sourceIndex_ || orderVersion_ == sourceIndex_->orderVersion_)
+    {
+        return;
+    }
+
+    const std::deque <Index::OrderShift> &shifts = sourceIndex_->orderShifts_;
+    const uint64_t missedShifts = sourceIndex_->orderVersion_ - orderVersion_;
+    const std::vector <AnyDataId> &order = sourceIndex_->order_;
+
+    if (missedShifts > shifts.size ())
+    {
+        // Shifts are lost, so cursor returns to its row. If the row was deleted, cursor keeps its position.
+        const std::size_t anchorPosition =
+            hasAnchor_ ? sourceIndex_->FindOrderPosition (anchorRowId_) : order.size ();
+
+        position_ = anchorPosition < order.size () ? anchorPosition : std::min <uint64_t> (position_, order.size ());
+    }
+    else
+    {
+        for (auto iterator = shifts.end () - missedShifts; iterator != shifts.end (); ++iterator)
+        {
+            if (iterator->isInsertion_ && position_ >= iterator->position_)
+            {
+                ++position_;
+            }
+            else if (!iterator->isInsertion_ && position_ > iterator->position_)
+            {
+                --position_;
+            }
+        }
+    }
+
+    orderVersion_ = sourceIndex_->orderVersion_;
+    SetPosition (position_);
+}
+
+void IndexCursor::SetPosition (uint64_t position) const
+{
+    position_ = position;
+    if (!isLookup_ && sourceIndex_)
+    {
+        assert (orderVersion_ == sourceIndex_->orderVersion_);
+        hasAnchor_ = position_ < sourceIndex_->order_.size ();
+        anchorRowId_ = hasAnchor_ ? sourceIndex_->order_[position_] : 0u;
+    }
+}
+
+const std::vector <AnyDataId> &IndexCursor::GetSequence () const
+{
+    return isLookup_ ? lookupResult_ : sourceIndex_->order_;
 }
 
 Index::Index (Table *table, IndexInfo info)
     : info_ (std::move (info)),
       order_ (),
+      coveredColumns_ (),
+      coveredValues_ (),
+      coveredNulls_ (),
+      hashTable_ (),
+      rowKeys_ (),
+      orderShifts_ (),
+      orderVersion_ (0u),
+      sharedOrder_ (),
+      sharedOrderVersion_ (0u),
       cursorManagementGuard_ (),
-      managedCursors_ (),
+      orderCursors_ (),
+      lookupCursors_ (),
+      lookupRowCursors_ (),
       table_ (table)
 {
     assert (!info_.columns_.empty ());
     assert (!info_.name_.empty ());
     assert (table_);
 
-    if (table_)
+    if (table_ && info_.type_ == IndexType::HASH)
+    {
+        rowKeys_.reserve (table_->rows_.GetSize ());
+        for (AnyDataId rowId : table_->rows_)
+        {
+            KeyHashTable::Key key;
+            BuildRowKey (rowId, key);
+            hashTable_.Insert (key, rowId);
+            rowKeys_.emplace (rowId, std::move (key));
+        }
+    }
+    else if (table_)
     {
-        order_.reserve (table_->rows_.size ());
+        order_.reserve (table_->rows_.GetSize ());
         for (AnyDataId rowId : table_->rows_)
         {
             order_.emplace_back (rowId);
@@ -116,6 +246,26 @@ Index::Index (Table *table, IndexInfo info)
                    {
                        return IsRowLess (firstRow, secondRow);
                    });
+
+        if (!info_.includedColumns_.empty ())
+        {
+            coveredColumns_ = info_.columns_;
+            for (AnyDataId columnId : info_.includedColumns_)
+            {
+                if (std::find (coveredColumns_.begin (), coveredColumns_.end (), columnId) == coveredColumns_.end ())
+                {
+                    coveredColumns_.emplace_back (columnId);
+                }
+            }
+
+            coveredValues_.resize (order_.size () * coveredColumns_.size ());
+            coveredNulls_.resize (coveredValues_.size ());
+
+            for (std::size_t position = 0u; position < order_.size (); ++position)
+            {
+                UpdateCoveredValues (position, order_[position]);
+            }
+        }
     }
     else
     {
@@ -132,11 +282,6 @@ Index::Index (Table *table, IndexInfo info)
     }
 }
 
-Index::Index (const std::pair <Table *, IndexInfo> &initializer)
-    : Index (initializer.first, initializer.second)
-{
-}
-
 Index::~Index ()
 {
     // We don't lock cursor management guard here, because index destruction could only be initiated
@@ -144,7 +289,7 @@ Index::~Index ()
     assert (IsSafeToRemoveInternal ());
 
     // If removal was unsafe, we must nullify all active cursors.
-    for (IndexCursor *cursor : managedCursors_)
+    for (IndexCursor *cursor : orderCursors_)
     {
         assert (cursor);
         if (cursor)
@@ -152,6 +297,18 @@ Index::~Index ()
             cursor->sourceIndex_ = nullptr;
         }
     }
+
+    for (const auto &keyCursorsPair : lookupCursors_)
+    {
+        for (IndexCursor *cursor : keyCursorsPair.second)
+        {
+            assert (cursor);
+            if (cursor)
+            {
+                cursor->sourceIndex_ = nullptr;
+            }
+        }
+    }
 }
 
 ResultCode Index::OnInsert (AnyDataId insertedRowId)
@@ -159,68 +316,187 @@ ResultCode Index::OnInsert (AnyDataId insertedRowId)
     // We don't lock cursor management guard here, because deletion callback could only be called by
     // thread with table write access. I hope, this uncheckable from here invariant won't be broken.
 
-    auto iterator = std::lower_bound (order_.begin (), order_.end (), insertedRowId,
+    if (info_.type_ == IndexType::HASH)
+    {
+        KeyHashTable::Key key;
+        BuildRowKey (insertedRowId, key);
+
+        if (!rowKeys_.emplace (insertedRowId, key).second)
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Caught attempt to inform index \"" + info_.name_ + "\" about insertion of item \"" +
+                std::to_string (insertedRowId) + ", but there is already item with such id in hash table!");
+            assert (false);
+
+            // As fallback behaviour, treat such inserts as updates.
+            return OnUpdate (insertedRowId, order_.size ());
+        }
+
+        hashTable_.Insert (key, insertedRowId);
+        UpdateLookupCursors (insertedRowId, &key);
+        return ResultCode::OK;
+    }
+
+    ResultCode result = AddToOrder (insertedRowId);
+    if (HasLookupCursors ())
+    {
+        KeyHashTable::Key key;
+        BuildRowKey (insertedRowId, key);
+        UpdateLookupCursors (insertedRowId, &key);
+    }
+
+    return result;
+}
+
+std::size_t Index::FindOrderPosition (AnyDataId rowId) const
+{
+    // Values of deleted rows are erased, so absent rows could not be searched for.
+    if (info_.type_ != IndexType::ORDERED || !table_->rows_.Contains (rowId))
+    {
+        return order_.size ();
+    }
+
+    auto iterator = std::lower_bound (order_.begin (), order_.end (), rowId,
                                       [this] (AnyDataId firstRow, AnyDataId secondRow)
                                       {
                                           return IsRowLess (firstRow, secondRow);
                                       });
 
-    if (iterator != order_.end () && *iterator == insertedRowId)
+    return iterator != order_.end () && *iterator == rowId ?
+           std::distance (order_.begin (), iterator) : order_.size ();
+}
+
+ResultCode Index::OnUpdate (AnyDataId updatedRowId, std::size_t oldPosition)
+{
+    // We don't lock cursor management guard here, because deletion callback could only be called by
+    // thread with table write access. I hope, this uncheckable from here invariant won't be broken.
+
+    if (info_.type_ == IndexType::HASH)
     {
-        Evan::Logger::Get ().Log (
-            Evan::LogLevel::ERROR,
-            "Caught attempt to inform index \"" + info_.name_ + "\" about insertion of item \"" +
-            std::to_string (insertedRowId) + ", but there is already item with such id in order vector!");
-        assert (false);
+        KeyHashTable::Key newKey;
+        BuildRowKey (updatedRowId, newKey);
 
-        // As fallback behaviour, treat such inserts as updates.
-        return OnUpdate (insertedRowId);
+        auto iterator = rowKeys_.find (updatedRowId);
+        if (iterator == rowKeys_.end ())
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Caught attempt to inform index \"" + info_.name_ + "\" about update of item \"" +
+                std::to_string (updatedRowId) + ", but there is no such item in hash table!");
+            assert (false);
+
+            rowKeys_.emplace (updatedRowId, newKey);
+            hashTable_.Insert (newKey, updatedRowId);
+        }
+        else if (iterator->second != newKey)
+        {
+            hashTable_.Erase (iterator->second, updatedRowId);
+            hashTable_.Insert (newKey, updatedRowId);
+            iterator->second = newKey;
+        }
+
+        UpdateLookupCursors (updatedRowId, &newKey);
+        return ResultCode::OK;
     }
-    else
+
+    // Row keeps its place if it is still between its neighbours, so order vector is not shifted at all.
+    const bool isPositionValid = oldPosition < order_.size () && order_[oldPosition] == updatedRowId;
+    ResultCode insertResult = ResultCode::OK;
+
+    if (!isPositionValid ||
+        (oldPosition > 0u && !IsRowLess (order_[oldPosition - 1u], updatedRowId)) ||
+        (oldPosition + 1u < order_.size () && !IsRowLess (updatedRowId, order_[oldPosition + 1u])))
     {
-        uint64_t position = std::distance (order_.begin (), iterator);
-        for (IndexCursor *cursor : managedCursors_)
+        ResultCode deleteResult = RemoveFromOrder (updatedRowId, oldPosition);
+        if (deleteResult != ResultCode::OK)
         {
-            assert (cursor);
-            if (cursor && cursor->position_ >= position)
-            {
-                ++cursor->position_;
-            }
+            return deleteResult;
         }
 
-        order_.insert (iterator, insertedRowId);
-        return ResultCode::OK;
+        insertResult = AddToOrder (updatedRowId);
     }
+    else
+    {
+        UpdateCoveredValues (oldPosition, updatedRowId);
+    }
+
+    if (HasLookupCursors ())
+    {
+        KeyHashTable::Key key;
+        BuildRowKey (updatedRowId, key);
+        UpdateLookupCursors (updatedRowId, &key);
+    }
+
+    return insertResult;
 }
 
-ResultCode Index::OnUpdate (AnyDataId updatedRowId)
+ResultCode Index::OnDelete (AnyDataId deletedRowId, std::size_t oldPosition)
 {
     // We don't lock cursor management guard here, because deletion callback could only be called by
     // thread with table write access. I hope, this uncheckable from here invariant won't be broken.
 
-    // Simplest strategy for update processing is delete-insert combination.
-    // And there is no better without explicit list of updated columns.
-    ResultCode deleteResult = OnDelete (updatedRowId);
-    if (deleteResult != ResultCode::OK)
+    UpdateLookupCursors (deletedRowId, nullptr);
+    if (info_.type_ == IndexType::HASH)
     {
-        return deleteResult;
+        auto iterator = rowKeys_.find (deletedRowId);
+        if (iterator == rowKeys_.end () || !hashTable_.Erase (iterator->second, deletedRowId))
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Caught attempt to inform index \"" + info_.name_ + "\" about deletion of item \"" +
+                std::to_string (deletedRowId) + ", but there is no such item in hash table!");
+            assert (false);
+        }
+
+        if (iterator != rowKeys_.end ())
+        {
+            rowKeys_.erase (iterator);
+        }
+
+        // Return OK, because formally deletion succeeds if there were already no element to delete.
+        return ResultCode::OK;
+    }
+
+    return RemoveFromOrder (deletedRowId, oldPosition);
+}
+
+ResultCode Index::AddToOrder (AnyDataId insertedRowId)
+{
+    auto iterator = std::lower_bound (order_.begin (), order_.end (), insertedRowId,
+                                      [this] (AnyDataId firstRow, AnyDataId secondRow)
+                                      {
+                                          return IsRowLess (firstRow, secondRow);
+                                      });
+
+    if (iterator != order_.end () && *iterator == insertedRowId)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR,
+            "Caught attempt to inform index \"" + info_.name_ + "\" about insertion of item \"" +
+            std::to_string (insertedRowId) + ", but there is already item with such id in order vector!");
+        assert (false);
+
+        // As fallback behaviour, treat such inserts as updates.
+        RemoveFromOrder (insertedRowId, std::distance (order_.begin (), iterator));
+        return AddToOrder (insertedRowId);
     }
     else
     {
-        return OnInsert (updatedRowId);
+        uint64_t position = std::distance (order_.begin (), iterator);
+        RecordOrderShift (position, true);
+        order_.insert (iterator, insertedRowId);
+        InsertCoveredValues (position, insertedRowId);
+        return ResultCode::OK;
     }
 }
 
-ResultCode Index::OnDelete (AnyDataId deletedRowId)
+ResultCode Index::RemoveFromOrder (AnyDataId deletedRowId, std::size_t expectedPosition)
 {
-    // We don't lock cursor management guard here, because deletion callback could only be called by
-    // thread with table write access. I hope, this uncheckable from here invariant won't be broken.
-
-    // TODO: Plain id search through vector is quite bad, but there is no other way with current update implementation
-    //       (delete CHANGED row and then reinsert). Other way of doing this is value based search, but it could
-    //       be quite long too (because values are not always small) and it requires serious change in how we handle
-    //       update. Think about this again later.
-    auto iterator = std::find (order_.begin (), order_.end (), deletedRowId);
+    // Table captures positions before changing values, so scan is needed only if position was not captured.
+    auto iterator = expectedPosition < order_.size () && order_[expectedPosition] == deletedRowId ?
+                    order_.begin () + expectedPosition :
+                    std::find (order_.begin (), order_.end (), deletedRowId);
 
     if (iterator == order_.end ())
     {
@@ -236,16 +512,9 @@ ResultCode Index::OnDelete (AnyDataId deletedRowId)
     else
     {
         uint64_t position = std::distance (order_.begin (), iterator);
-        for (IndexCursor *cursor : managedCursors_)
-        {
-            assert (cursor);
-            if (cursor && cursor->position_ > position)
-            {
-                --cursor->position_;
-            }
-        }
-
+        RecordOrderShift (position, false);
         auto nextIterator = order_.erase (iterator);
+        EraseCoveredValues (position);
         if (nextIterator != order_.end () && *nextIterator == deletedRowId)
         {
             Evan::Logger::Get ().Log (
@@ -258,7 +527,9 @@ ResultCode Index::OnDelete (AnyDataId deletedRowId)
             // As fallback behaviour, remove all duplicates.
             while (nextIterator != order_.end () && *nextIterator == deletedRowId)
             {
+                RecordOrderShift (position, false);
                 nextIterator = order_.erase (nextIterator);
+                EraseCoveredValues (position);
             }
         }
 
@@ -276,11 +547,66 @@ const IndexInfo &Index::GetIndexInfo () const
     return info_;
 }
 
+bool Index::UsesColumn (AnyDataId columnId) const
+{
+    return std::find (info_.columns_.begin (), info_.columns_.end (), columnId) != info_.columns_.end () ||
+           std::find (info_.includedColumns_.begin (), info_.includedColumns_.end (), columnId) !=
+           info_.includedColumns_.end ();
+}
+
 IndexCursor *Index::OpenCursor ()
 {
+    if (info_.type_ != IndexType::ORDERED)
+    {
+        return nullptr;
+    }
+
     std::unique_lock <std::mutex> lock (cursorManagementGuard_);
     auto *cursor = new IndexCursor (this, 0);
-    managedCursors_.emplace_back (cursor);
+    orderCursors_.emplace (cursor);
+    return cursor;
+}
+
+IndexCursor *Index::OpenLookupCursor (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> &key)
+{
+    KeyHashTable::Key normalizedKey;
+    BuildKey (key, normalizedKey);
+    std::vector <AnyDataId> result;
+
+    if (info_.type_ == IndexType::HASH)
+    {
+        const std::vector <AnyDataId> *rows = hashTable_.Find (normalizedKey);
+        if (rows)
+        {
+            result = *rows;
+        }
+    }
+    else
+    {
+        // Ordered indices do not store keys, so lookup over them is a full scan.
+        // It's still useful, because it returns rows in index order.
+        KeyHashTable::Key rowKey;
+        for (AnyDataId rowId : order_)
+        {
+            rowKey.clear ();
+            BuildRowKey (rowId, rowKey);
+
+            if (rowKey == normalizedKey)
+            {
+                result.emplace_back (rowId);
+            }
+        }
+    }
+
+    std::unique_lock <std::mutex> lock (cursorManagementGuard_);
+    auto *cursor = new IndexCursor (this, std::move (normalizedKey), std::move (result));
+    lookupCursors_[cursor->lookupKey_].emplace_back (cursor);
+
+    for (AnyDataId rowId : cursor->lookupResult_)
+    {
+        lookupRowCursors_[rowId].emplace_back (cursor);
+    }
+
     return cursor;
 }
 
@@ -288,81 +614,452 @@ void Index::CloseCursor (IndexCursor *cursor)
 {
     assert (cursor);
     std::unique_lock <std::mutex> lock (cursorManagementGuard_);
-    auto iterator = std::find (managedCursors_.begin (), managedCursors_.end (), cursor);
 
-    if (iterator == managedCursors_.end ())
+    if (!cursor->isLookup_)
     {
-        assert (false);
+        if (orderCursors_.erase (cursor) == 0u)
+        {
+            assert (false);
+        }
+
+        return;
     }
-    else
+
+    auto eraseCursor = [cursor] (std::vector <IndexCursor *> &cursors)
+    {
+        auto iterator = std::find (cursors.begin (), cursors.end (), cursor);
+        assert (iterator != cursors.end ());
+
+        if (iterator != cursors.end ())
+        {
+            *iterator = cursors.back ();
+            cursors.pop_back ();
+        }
+
+        return cursors.empty ();
+    };
+
+    auto keyIterator = lookupCursors_.find (cursor->lookupKey_);
+    assert (keyIterator != lookupCursors_.end ());
+
+    if (keyIterator != lookupCursors_.end () && eraseCursor (keyIterator->second))
     {
-        managedCursors_.erase (iterator);
+        lookupCursors_.erase (keyIterator);
+    }
+
+    for (AnyDataId rowId : cursor->lookupResult_)
+    {
+        auto rowIterator = lookupRowCursors_.find (rowId);
+        assert (rowIterator != lookupRowCursors_.end ());
+
+        if (rowIterator != lookupRowCursors_.end () && eraseCursor (rowIterator->second))
+        {
+            lookupRowCursors_.erase (rowIterator);
+        }
     }
 }
 
 bool Index::IsSafeToRemoveInternal () const
 {
-    return managedCursors_.empty ();
+    return orderCursors_.empty () && lookupCursors_.empty ();
+}
+
+std::shared_ptr <const std::vector <AnyDataId>> Index::ShareOrder ()
+{
+    std::unique_lock <std::mutex> lock (cursorManagementGuard_);
+    if (!sharedOrder_ || sharedOrderVersion_ != orderVersion_)
+    {
+        sharedOrder_ = std::make_shared <const std::vector <AnyDataId>> (order_);
+        sharedOrderVersion_ = orderVersion_;
+    }
+
+    return sharedOrder_;
+}
+
+void Index::RecordOrderShift (uint64_t position, bool isInsertion)
+{
+    // Cursors, opened after this change, start from current version, so there is no need to journal it.
+    if (orderCursors_.empty ())
+    {
+        orderShifts_.clear ();
+        ++orderVersion_;
+        return;
+    }
+
+    orderShifts_.push_back ({position, isInsertion});
+    ++orderVersion_;
+
+    // Journal is bounded, so replay cost of every access is limited and cursors, that are not accessed,
+    // do not hold journal forever. Cursors, that missed dropped shifts, search for their rows instead.
+    static constexpr std::size_t MAX_SHIFTS = 256u;
+    if (orderShifts_.size () > MAX_SHIFTS)
+    {
+        orderShifts_.erase (orderShifts_.begin (), orderShifts_.begin () + orderShifts_.size () / 2u);
+    }
+}
+
+bool Index::GetCoveredValue (std::size_t position, AnyDataId columnId, const AnyDataContainer *&output) const
+{
+    auto iterator = std::find (coveredColumns_.begin (), coveredColumns_.end (), columnId);
+    if (iterator == coveredColumns_.end ())
+    {
+        return false;
+    }
+
+    assert (position < order_.size ());
+    const std::size_t slot = position * coveredColumns_.size () + std::distance (coveredColumns_.begin (), iterator);
+    output = coveredNulls_[slot] ? nullptr : &coveredValues_[slot];
+    return true;
+}
+
+void Index::InsertCoveredValues (std::size_t position, AnyDataId rowId)
+{
+    if (!coveredColumns_.empty ())
+    {
+        const std::size_t offset = position * coveredColumns_.size ();
+        for (std::size_t index = 0u; index < coveredColumns_.size (); ++index)
+        {
+            // Containers are not copy assignable, therefore they are emplaced one by one.
+            coveredValues_.emplace (coveredValues_.begin () + offset);
+        }
+
+        coveredNulls_.insert (coveredNulls_.begin () + offset, coveredColumns_.size (), 0u);
+        UpdateCoveredValues (position, rowId);
+    }
+}
+
+void Index::UpdateCoveredValues (std::size_t position, AnyDataId rowId)
+{
+    AnyDataContainer buffer;
+    const std::size_t offset = position * coveredColumns_.size ();
+
+    for (std::size_t index = 0u; index < coveredColumns_.size (); ++index)
+    {
+        const AnyDataContainer *value = GetRowValue (rowId, coveredColumns_[index], buffer);
+        coveredNulls_[offset + index] = value == nullptr;
+        coveredValues_[offset + index] = value ? AnyDataContainer (*value) : AnyDataContainer ();
+    }
+}
+
+void Index::EraseCoveredValues (std::size_t position)
+{
+    if (!coveredColumns_.empty ())
+    {
+        const std::size_t offset = position * coveredColumns_.size ();
+        coveredValues_.erase (coveredValues_.begin () + offset,
+                              coveredValues_.begin () + offset + coveredColumns_.size ());
+        coveredNulls_.erase (coveredNulls_.begin () + offset,
+                             coveredNulls_.begin () + offset + coveredColumns_.size ());
+    }
 }
 
 bool Index::IsRowLess (AnyDataId firstRow, AnyDataId secondRow) const
+{
+    const int comparison = CompareRows (firstRow, secondRow);
+    return comparison < 0 || (comparison == 0 && firstRow < secondRow);
+}
+
+int Index::CompareRows (AnyDataId firstRow, AnyDataId secondRow) const
 {
     assert(!info_.columns_.empty ());
     assert(table_);
 
     if (table_)
     {
+        AnyDataContainer firstBuffer;
+        AnyDataContainer secondBuffer;
+
         for (AnyDataId columnId : info_.columns_)
         {
-            const AnyDataContainer *firstValue = nullptr;
-            ResultCode result = table_->GetColumnValue (columnId, firstRow, firstValue);
-
-            static const auto logGetterError = [] (AnyDataId row, AnyDataId column, Table *table)
-            {
-                Evan::Logger::Get ().Log (
-                    Evan::LogLevel::ERROR,
-                    "Unable to get value of row with id " + std::to_string (row) +
-                    " from column with id " + std::to_string (column) + " from table \"" + table->name_ +
-                    "\", considering that this value is null.");
-            };
-
-            if (result != ResultCode::OK)
+            int comparison = CompareValues (GetRowValue (firstRow, columnId, firstBuffer),
+                                            GetRowValue (secondRow, columnId, secondBuffer));
+            // Next column must be checked only if values of current column are equal.
+            if (comparison != 0)
             {
-                logGetterError (firstRow, columnId, table_);
-                assert(false);
+                return comparison;
             }
+        }
+    }
 
-            const AnyDataContainer *secondValue = nullptr;
-            result = table_->GetColumnValue (columnId, secondRow, secondValue);
+    return 0;
+}
 
-            if (result != ResultCode::OK)
-            {
-                logGetterError (secondRow, columnId, table_);
-                assert(false);
-            }
+const AnyDataContainer *Index::GetRowValue (AnyDataId rowId, AnyDataId columnId, AnyDataContainer &buffer) const
+{
+    const AnyDataContainer *value = nullptr;
+    if (table_->GetColumnValue (columnId, rowId, value, buffer) != ResultCode::OK)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR,
+            "Unable to get value of row with id " + std::to_string (rowId) +
+            " from column with id " + std::to_string (columnId) + " from table \"" + table_->name_ +
+            "\", considering that this value is null.");
+        assert (false);
+        return nullptr;
+    }
+
+    return value;
+}
+
+int Index::CompareValues (const AnyDataContainer *first, const AnyDataContainer *second)
+{
+    // Equal values of dictionary encoded columns share storage, so they are compared without touching the data.
+    if (first == second)
+    {
+        return 0;
+    }
+    else if (first == nullptr || second == nullptr)
+    {
+        return (first != nullptr) - (second != nullptr);
+    }
+
+    assert (first->GetType () == second->GetType ());
+    if (*first < *second)
+    {
+        return -1;
+    }
+    else if (*second < *first)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+int Index::CompareRowWithKey (AnyDataId rowId, const std::vector <const AnyDataContainer *> &key) const
+{
+    assert (key.size () == info_.columns_.size ());
+    AnyDataContainer buffer;
+
+    for (std::size_t index = 0; index < info_.columns_.size (); ++index)
+    {
+        int comparison = CompareValues (GetRowValue (rowId, info_.columns_[index], buffer), key[index]);
+        if (comparison != 0)
+        {
+            return comparison;
+        }
+    }
 
-            // Null is less than anything.
-            if (firstValue == nullptr && secondValue != nullptr)
+    return 0;
+}
+
+void Index::FindRange (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> *lowerBound,
+                       const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> *upperBound,
+                       std::size_t &begin, std::size_t &end) const
+{
+    assert (info_.type_ == IndexType::ORDERED);
+    auto search = [this] (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> &bound)
+    {
+        std::vector <const AnyDataContainer *> key;
+        for (AnyDataId columnId : info_.columns_)
+        {
+            auto iterator = bound.find (columnId);
+            key.emplace_back (iterator == bound.end () ? nullptr : &iterator->second);
+        }
+
+        return static_cast <std::size_t> (
+            std::lower_bound (order_.begin (), order_.end (), key,
+                              [this] (AnyDataId rowId, const std::vector <const AnyDataContainer *> &key)
+                              {
+                                  return CompareRowWithKey (rowId, key) < 0;
+                              }) - order_.begin ());
+    };
+
+    begin = lowerBound ? search (*lowerBound) : 0u;
+    end = std::max (begin, upperBound ? search (*upperBound) : order_.size ());
+}
+
+bool Index::HasKeyConflict (const std::vector <const AnyDataContainer *> &key, AnyDataId ignoredRowId) const
+{
+    assert (key.size () == info_.columns_.size ());
+    if (info_.type_ == IndexType::HASH)
+    {
+        KeyHashTable::Key normalizedKey;
+        for (const AnyDataContainer *value : key)
+        {
+            AppendToKey (value, normalizedKey);
+        }
+
+        const std::vector <AnyDataId> *rows = hashTable_.Find (normalizedKey);
+        return rows && std::any_of (rows->begin (), rows->end (),
+                                    [ignoredRowId] (AnyDataId rowId)
+                                    {
+                                        return rowId != ignoredRowId;
+                                    });
+    }
+
+    auto iterator = std::lower_bound (order_.begin (), order_.end (), key,
+                                      [this] (AnyDataId rowId, const std::vector <const AnyDataContainer *> &key)
+                                      {
+                                          return CompareRowWithKey (rowId, key) < 0;
+                                      });
+
+    // Unique index contains at most one row with given key, but
+    // ignored row could also have this key, so we need to check two rows.
+    for (int checked = 0; checked < 2 && iterator != order_.end (); ++checked, ++iterator)
+    {
+        if (CompareRowWithKey (*iterator, key) != 0)
+        {
+            return false;
+        }
+        else if (*iterator != ignoredRowId)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Index::HasDuplicates () const
+{
+    auto hasNull = [this] (AnyDataId rowId)
+    {
+        return std::any_of (info_.columns_.begin (), info_.columns_.end (),
+                            [this, rowId] (AnyDataId columnId)
+                            {
+                                AnyDataContainer buffer;
+                                return GetRowValue (rowId, columnId, buffer) == nullptr;
+                            });
+    };
+
+    if (info_.type_ == IndexType::HASH)
+    {
+        for (const auto &rowKeyPair : rowKeys_)
+        {
+            const std::vector <AnyDataId> *rows = hashTable_.Find (rowKeyPair.second);
+            if (rows && rows->size () > 1u && !hasNull (rowKeyPair.first))
             {
                 return true;
             }
-            else if (firstValue != nullptr && secondValue == nullptr)
-            {
-                return false;
-            }
-            else if (firstValue != nullptr)
-            {
-                assert(firstValue->GetType () == secondValue->GetType ());
-                bool less = *firstValue < *secondValue;
+        }
+
+        return false;
+    }
 
-                if (less)
+    for (std::size_t index = 1; index < order_.size (); ++index)
+    {
+        if (CompareRows (order_[index - 1], order_[index]) == 0 && !hasNull (order_[index]))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Index::BuildRowKey (AnyDataId rowId, KeyHashTable::Key &output) const
+{
+    assert (table_);
+    AnyDataContainer buffer;
+
+    for (AnyDataId columnId : info_.columns_)
+    {
+        AppendToKey (GetRowValue (rowId, columnId, buffer), output);
+    }
+}
+
+void Index::BuildKey (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> &values,
+                      KeyHashTable::Key &output) const
+{
+    for (AnyDataId columnId : info_.columns_)
+    {
+        auto iterator = values.find (columnId);
+        AppendToKey (iterator == values.end () ? nullptr : &iterator->second, output);
+    }
+}
+
+void Index::AppendToKey (const AnyDataContainer *value, KeyHashTable::Key &output)
+{
+    if (value == nullptr)
+    {
+        output.emplace_back (0u);
+    }
+    else
+    {
+        output.emplace_back (1u);
+        const uint32_t size = value->GetDataSize ();
+
+        if (IsVariableSizeDataType (value->GetType ()))
+        {
+            // Size prefix is required to separate variable size values of multi column keys.
+            const auto *sizeBegin = reinterpret_cast <const uint8_t *> (&size);
+            output.insert (output.end (), sizeBegin, sizeBegin + sizeof (size));
+        }
+
+        const auto *begin = static_cast <const uint8_t *> (value->GetDataStartPointer ());
+        output.insert (output.end (), begin, begin + size);
+    }
+}
+
+void Index::UpdateLookupCursors (AnyDataId rowId, const KeyHashTable::Key *newKey)
+{
+    if (!HasLookupCursors ())
+    {
+        return;
+    }
+
+    auto rowIterator = lookupRowCursors_.find (rowId);
+    std::vector <IndexCursor *> holders;
+
+    if (rowIterator != lookupRowCursors_.end ())
+    {
+        holders = std::move (rowIterator->second);
+        lookupRowCursors_.erase (rowIterator);
+    }
+
+    // Cursors with other keys lose the row, cursors with new key keep it or receive it.
+    for (auto iterator = holders.begin (); iterator != holders.end ();)
+    {
+        IndexCursor *cursor = *iterator;
+        assert (cursor);
+
+        if (newKey && *newKey == cursor->lookupKey_)
+        {
+            ++iterator;
+            continue;
+        }
+
+        auto resultIterator = std::find (cursor->lookupResult_.begin (), cursor->lookupResult_.end (), rowId);
+        assert (resultIterator != cursor->lookupResult_.end ());
+
+        uint64_t position = std::distance (cursor->lookupResult_.begin (), resultIterator);
+        if (cursor->position_ > position)
+        {
+            --cursor->position_;
+        }
+
+        cursor->lookupResult_.erase (resultIterator);
+        *iterator = holders.back ();
+        holders.pop_back ();
+    }
+
+    if (newKey)
+    {
+        auto keyIterator = lookupCursors_.find (*newKey);
+        if (keyIterator != lookupCursors_.end ())
+        {
+            for (IndexCursor *cursor : keyIterator->second)
+            {
+                if (std::find (holders.begin (), holders.end (), cursor) == holders.end ())
                 {
-                    return true;
+                    cursor->lookupResult_.emplace_back (rowId);
+                    holders.emplace_back (cursor);
                 }
             }
         }
     }
 
-    return false;
+    if (!holders.empty ())
+    {
+        lookupRowCursors_.emplace (rowId, std::move (holders));
+    }
+}
+
+bool Index::HasLookupCursors () const
+{
+    return !lookupCursors_.empty ();
 }
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 
@@ -9,16 +12,39 @@
 
 #include <Miami/Disco/Variants.hpp>
 
+#include <Miami/Janitor/FlatHashMap.hpp>
+#include <Miami/Janitor/FlatHashSet.hpp>
+
 #include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/KeyHashTable.hpp>
 #include <Miami/Richard/ResultCode.hpp>
 
 namespace Miami::Richard
 {
+enum class IndexType
+{
+    /// Keeps rows sorted by indexed columns values, supports ordered iteration.
+    ORDERED = 0,
+
+    /// Keeps rows in hash table by indexed columns values, supports only equality lookups.
+    HASH
+};
+
+const char *GetIndexTypeName (IndexType indexType);
+
 struct IndexInfo
 {
     AnyDataId id_;
     std::string name_;
     std::vector <AnyDataId> columns_;
+    IndexType type_ = IndexType::ORDERED;
+
+    /// Unique indices do not allow several rows with equal keys. Keys with null values are not checked.
+    bool unique_ = false;
+
+    /// Values of included columns are stored in ordered index entries together with indexed values, so cursor
+    /// reads of these columns are served from index without column lookups. Not supported by hash indices.
+    std::vector <AnyDataId> includedColumns_ {};
 };
 
 class Index;
@@ -34,15 +60,44 @@ public:
 
     free_call ResultCode GetCurrent (AnyDataId &output) const;
 
+    /// Returns false if cursor is a lookup one, is at the end or given column is not covered by index.
+    /// Output is nullptr if value is null.
+    free_call bool GetCoveredValue (AnyDataId columnId, const AnyDataContainer *&output) const;
+
 private:
     free_call IndexCursor (Index *sourceIndex, uint64_t position);
 
+    /// Creates lookup cursor, that iterates only over rows with given key.
+    free_call IndexCursor (Index *sourceIndex, KeyHashTable::Key lookupKey, std::vector <AnyDataId> lookupResult);
+
     free_call void AssertPosition () const;
 
-    uint64_t position_;
+    /// Replays order shifts, that were made since last access, so writes never touch cursors. If journal was
+    /// trimmed since last access, cursor is moved to current position of row, that it pointed to.
+    free_call void Synchronize () const;
+
+    /// Must be called on synchronized cursor, captures row at given position for ::Synchronize.
+    void SetPosition (uint64_t position) const;
+
+    /// Returns index order for usual cursors and list of matching rows for lookup cursors.
+    free_call const std::vector <AnyDataId> &GetSequence () const;
+
+    // Position is shifted lazily, when cursor is accessed, so it is updated even by const methods.
+    mutable uint64_t position_;
+    mutable uint64_t orderVersion_;
+
+    /// Row at ::position_ in order of ::orderVersion_ version, if cursor is not at the end.
+    mutable AnyDataId anchorRowId_;
+    mutable bool hasAnchor_;
     Index *sourceIndex_;
 
+    const bool isLookup_;
+    const KeyHashTable::Key lookupKey_;
+    std::vector <AnyDataId> lookupResult_;
+
     friend class Index;
+
+    friend class TableReadCursor;
 };
 
 class Index final
@@ -50,36 +105,157 @@ class Index final
 public:
     Index (Table *table, IndexInfo info);
 
-    Index (const std::pair <Table *, IndexInfo> &initializer);
-
     ~Index ();
 
     free_call bool IsSafeToRemove (const std::shared_ptr <Disco::SafeLockGuard> &tableWriteGuard) const;
 
     free_call const IndexInfo &GetIndexInfo () const;
 
+    /// Checks both indexed and included columns.
+    free_call bool UsesColumn (AnyDataId columnId) const;
+
+    /// Returns nullptr if index does not support ordered iteration.
     IndexCursor *OpenCursor ();
 
+    /// Opens cursor over rows, which indexed columns values are equal to given ones. Absent values are
+    /// treated as nulls. Key must be previously validated by table. Rows, that start or stop matching
+    /// given key after cursor creation, are added to the end of cursor sequence or removed from it.
+    IndexCursor *OpenLookupCursor (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> &key);
+
 private:
     // On* methods do not check guards, because they could be called from implicitly guarded contexts like cursors.
     // Because of it, they are marked private, so they could be called only from safe context.
 
     free_call ResultCode OnInsert (AnyDataId insertedRowId);
 
-    free_call ResultCode OnUpdate (AnyDataId updatedRowId);
+    /// Must be called before row values are changed. Returned position is passed to ::OnUpdate or ::OnDelete,
+    /// so old entry is found without scanning. Hash indices and absent rows give order vector size.
+    free_call std::size_t FindOrderPosition (AnyDataId rowId) const;
+
+    free_call ResultCode OnUpdate (AnyDataId updatedRowId, std::size_t oldPosition);
 
-    free_call ResultCode OnDelete (AnyDataId deletedRowId);
+    free_call ResultCode OnDelete (AnyDataId deletedRowId, std::size_t oldPosition);
+
+    free_call ResultCode AddToOrder (AnyDataId insertedRowId);
+
+    /// Falls back to scan by row id if given position does not point to given row.
+    free_call ResultCode RemoveFromOrder (AnyDataId deletedRowId, std::size_t expectedPosition);
 
     void CloseCursor (IndexCursor *cursor);
 
+    /// Returns immutable copy of ::order_, that is shared by all snapshots until order changes.
+    std::shared_ptr <const std::vector <AnyDataId>> ShareOrder ();
+
     free_call bool IsSafeToRemoveInternal () const;
 
+    /// Journals insertion or removal of ::order_ entry at given position for cursors. Cursors are never visited,
+    /// when journal grows too big, its oldest half is dropped and lagging cursors search for their rows.
+    void RecordOrderShift (uint64_t position, bool isInsertion);
+
+    /// Rows with equal values are ordered by ids, so every row has exactly one place in order vector.
     free_call bool IsRowLess (AnyDataId firstRow, AnyDataId secondRow) const;
 
+    /// Compares only indexed values of given rows, see ::CompareValues.
+    free_call int CompareRows (AnyDataId firstRow, AnyDataId secondRow) const;
+
+    /// Returns value of given column of given row or nullptr, if value is null.
+    /// Buffer is used for decoding of compressed values.
+    free_call const AnyDataContainer *GetRowValue (AnyDataId rowId, AnyDataId columnId,
+                                                   AnyDataContainer &buffer) const;
+
+    /// Null is less than anything. Returns negative value if first is less, positive if
+    /// second is less and zero if values are equal.
+    free_call static int CompareValues (const AnyDataContainer *first, const AnyDataContainer *second);
+
+    /// Compares indexed values of given row with given key, which contains values for all indexed columns.
+    free_call int CompareRowWithKey (AnyDataId rowId, const std::vector <const AnyDataContainer *> &key) const;
+
+    /// Finds range of ordered index, which keys are not less than lower bound and less than upper bound.
+    /// Absent bound values are treated as nulls, nullptr bound means that range is not limited from that side.
+    free_call void FindRange (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> *lowerBound,
+                              const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> *upperBound,
+                              std::size_t &begin, std::size_t &end) const;
+
+    /// Checks whether there is row other than ::ignoredRowId with given key.
+    /// Uses binary search for ordered indices and hash table search for hash indices.
+    free_call bool HasKeyConflict (const std::vector <const AnyDataContainer *> &key, AnyDataId ignoredRowId) const;
+
+    /// Checks whether there are several rows with equal non-null keys.
+    free_call bool HasDuplicates () const;
+
+    /// Normalized key is a concatenation of null flag and raw value bytes for every indexed column.
+    free_call void BuildRowKey (AnyDataId rowId, KeyHashTable::Key &output) const;
+
+    free_call void BuildKey (const Janitor::FlatHashMap <AnyDataId, AnyDataContainer> &values,
+                             KeyHashTable::Key &output) const;
+
+    free_call static void AppendToKey (const AnyDataContainer *value, KeyHashTable::Key &output);
+
+    /// Adds row to lookup cursors, which key is equal to given one, and removes it from other lookup cursors.
+    /// If ::newKey is nullptr, row is removed from all lookup cursors. Only cursors, that hold the row or
+    /// are opened with given key, are visited.
+    void UpdateLookupCursors (AnyDataId rowId, const KeyHashTable::Key *newKey);
+
+    free_call bool HasLookupCursors () const;
+
+    /// Returns false if given column is not covered. Output is nullptr if value is null.
+    free_call bool GetCoveredValue (std::size_t position, AnyDataId columnId, const AnyDataContainer *&output) const;
+
+    /// Inserts covered values of given row for new entry of ::order_ at given position.
+    void InsertCoveredValues (std::size_t position, AnyDataId rowId);
+
+    /// Rewrites covered values of entry at given position with current values of given row.
+    void UpdateCoveredValues (std::size_t position, AnyDataId rowId);
+
+    void EraseCoveredValues (std::size_t position);
+
     IndexInfo info_;
+
+    /// Used only by ordered indices.
     std::vector <AnyDataId> order_;
+
+    /// Indexed columns followed by included columns. Empty if index has no included columns.
+    std::vector <AnyDataId> coveredColumns_;
+
+    /// Values of covered columns for every entry of ::order_, stored entry after entry,
+    /// so index-only scans read memory sequentially. Null values are marked in ::coveredNulls_.
+    std::vector <AnyDataContainer> coveredValues_;
+    std::vector <uint8_t> coveredNulls_;
+
+    /// Used only by hash indices. Normalized keys of rows are stored, because on update and
+    /// deletion row values are already changed, but old key is needed to find row in hash table.
+    KeyHashTable hashTable_;
+    std::unordered_map <AnyDataId, KeyHashTable::Key> rowKeys_;
+
+    struct OrderShift
+    {
+        uint64_t position_;
+        bool isInsertion_;
+    };
+
+    /// Latest order changes, last shift has ::orderVersion_ version. Cursors replay them on access.
+    std::deque <OrderShift> orderShifts_;
+    uint64_t orderVersion_;
+
+    /// Copy of ::order_ at ::sharedOrderVersion_, guarded by ::cursorManagementGuard_.
+    std::shared_ptr <const std::vector <AnyDataId>> sharedOrder_;
+    uint64_t sharedOrderVersion_;
+
+    struct LookupKeyHash final
+    {
+        free_call std::size_t operator () (const KeyHashTable::Key &key) const
+        {
+            return static_cast <std::size_t> (KeyHashTable::Hash (key));
+        }
+    };
+
     std::mutex cursorManagementGuard_;
-    std::vector <IndexCursor *> managedCursors_;
+    Janitor::FlatHashSet <IndexCursor *> orderCursors_;
+
+    /// Lookup cursors grouped by their keys and by rows in their results, so every write
+    /// visits only cursors, which results could be changed by this write.
+    Janitor::FlatHashMap <KeyHashTable::Key, std::vector <IndexCursor *>, LookupKeyHash> lookupCursors_;
+    Janitor::FlatHashMap <AnyDataId, std::vector <IndexCursor *>> lookupRowCursors_;
     Table *table_;
 
     // TODO: Add persistence (save/load from file).
@@ -88,5 +264,9 @@ private:
 
     // TODO: Too many friend classes, too many private methods, reexamine decisions and maybe add proxies.
     friend class Table;
+
+    friend class HashJoin;
+
+    friend class ConduitBackup;
 };
 }
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Index.hpp>
+#include <Miami/Richard/Join.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+ResultCode HashJoin::Execute (const Table *left, const std::shared_ptr <Disco::SafeLockGuard> &leftGuard,
+                              const Table *right, const std::shared_ptr <Disco::SafeLockGuard> &rightGuard,
+                              const JoinPlan &plan, Disco::Context *workers, const QueryConsumer &consumer)
+{
+    assert (left && right);
+    if (!left->CheckReadOrWriteGuard (leftGuard) || !right->CheckReadOrWriteGuard (rightGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    ResultCode result = ValidateInput (left, plan.left_);
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    result = ValidateInput (right, plan.right_);
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (plan.left_.keyColumns_.size () != plan.right_.keyColumns_.size ())
+    {
+        return ResultCode::JOIN_KEY_COLUMNS_COUNT_MISMATCH;
+    }
+
+    // Keys are compared as normalized bytes, so values of different types never match.
+    for (std::size_t index = 0u; index < plan.left_.keyColumns_.size (); ++index)
+    {
+        if (left->columns_.at (plan.left_.keyColumns_[index]).GetColumnInfo ().dataType_ !=
+            right->columns_.at (plan.right_.keyColumns_[index]).GetColumnInfo ().dataType_)
+        {
+            return ResultCode::JOIN_KEY_COLUMN_TYPES_MISMATCH;
+        }
+    }
+
+    if (plan.left_.projection_.empty () && plan.right_.projection_.empty ())
+    {
+        return ResultCode::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN;
+    }
+
+    if (plan.limit_ > 0u)
+    {
+        HashJoin join (left, right, plan, workers);
+        join.Build ();
+        join.Probe (consumer);
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode HashJoin::ValidateInput (const Table *table, const JoinInput &input)
+{
+    if (input.keyColumns_.empty ())
+    {
+        return ResultCode::JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN;
+    }
+
+    for (const std::vector <AnyDataId> *columns : {&input.keyColumns_, &input.projection_})
+    {
+        for (AnyDataId columnId : *columns)
+        {
+            if (table->columns_.count (columnId) == 0)
+            {
+                return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+            }
+        }
+    }
+
+    return input.filter_.GetNodes ().empty () ? ResultCode::OK : input.filter_.Validate (table);
+}
+
+HashJoin::HashJoin (const Table *left, const Table *right, const JoinPlan &plan, Disco::Context *workers)
+    : left_ {left, &plan.left_, {}, {}},
+      right_ {right, &plan.right_, {}, {}},
+      // Right input is built on ties, so self joins probe in left order.
+      isLeftBuilt_ (left->rows_.GetSize () < right->rows_.GetSize ()),
+      limit_ (plan.limit_),
+      workers_ (workers),
+      partitions_ (),
+      probeRows_ (),
+      emitted_ (0u)
+{
+    for (Input *input : {&left_, &right_})
+    {
+        for (AnyDataId columnId : input->plan_->keyColumns_)
+        {
+            input->keyColumns_.emplace_back (&input->table_->columns_.at (columnId));
+        }
+
+        for (AnyDataId columnId : input->plan_->projection_)
+        {
+            input->projection_.emplace_back (&input->table_->columns_.at (columnId));
+        }
+    }
+}
+
+void HashJoin::Build ()
+{
+    const Input &input = isLeftBuilt_ ? left_ : right_;
+    std::vector <AnyDataId> rows;
+    rows.reserve (input.table_->rows_.GetSize ());
+
+    for (AnyDataId rowId : input.table_->rows_)
+    {
+        rows.emplace_back (rowId);
+    }
+
+    // Small inputs are not worth splitting: one partition is built faster than tasks are scheduled.
+    const std::size_t morselsCount = (rows.size () + MORSEL_SIZE - 1u) / MORSEL_SIZE;
+    partitions_.resize (workers_ && morselsCount > 1u ? workers_->GetWorkersCount () + 1u : 1u);
+
+    // Each morsel scatters its keyed rows by partitions, so every partition is then built by one task without locks.
+    std::vector <std::vector <KeyedRow>> scattered (morselsCount * partitions_.size ());
+    ForEach (morselsCount,
+             [this, &input, &rows, &scattered] (std::size_t morsel)
+             {
+                 const std::size_t begin = morsel * MORSEL_SIZE;
+                 std::vector <KeyedRow> keyedRows;
+                 CollectKeys (input, rows.data () + begin, std::min (MORSEL_SIZE, rows.size () - begin), keyedRows);
+
+                 for (KeyedRow &keyedRow : keyedRows)
+                 {
+                     scattered[morsel * partitions_.size () + GetPartition (keyedRow.hash_)].emplace_back (
+                         std::move (keyedRow));
+                 }
+             });
+
+    ForEach (partitions_.size (),
+             [this, &scattered, morselsCount] (std::size_t partition)
+             {
+                 for (std::size_t morsel = 0u; morsel < morselsCount; ++morsel)
+                 {
+                     for (const KeyedRow &keyedRow : scattered[morsel * partitions_.size () + partition])
+                     {
+                         partitions_[partition].Insert (keyedRow.key_, keyedRow.rowId_);
+                     }
+                 }
+             });
+}
+
+void HashJoin::Probe (const QueryConsumer &consumer)
+{
+    const Input &input = isLeftBuilt_ ? right_ : left_;
+    probeRows_.reserve (input.table_->rows_.GetSize ());
+
+    for (AnyDataId rowId : input.table_->rows_)
+    {
+        probeRows_.emplace_back (rowId);
+    }
+
+    const std::size_t morselsCount = (probeRows_.size () + MORSEL_SIZE - 1u) / MORSEL_SIZE;
+    const std::size_t waveSize = 2u * ((workers_ ? workers_->GetWorkersCount () : 0u) + 1u);
+    std::vector <QueryBatch> morsels;
+
+    for (std::size_t firstMorsel = 0u; firstMorsel < morselsCount; firstMorsel += waveSize)
+    {
+        morsels.clear ();
+        morsels.resize (std::min (waveSize, morselsCount - firstMorsel));
+
+        ForEach (morsels.size (),
+                 [this, &morsels, firstMorsel] (std::size_t index)
+                 {
+                     const std::size_t begin = (firstMorsel + index) * MORSEL_SIZE;
+                     ProbeMorsel (probeRows_.data () + begin, std::min (MORSEL_SIZE, probeRows_.size () - begin),
+                                  morsels[index]);
+                 });
+
+        for (QueryBatch &morsel : morsels)
+        {
+            const uint64_t rowsCount = morsel.GetRowsCount ();
+            if (rowsCount == 0u)
+            {
+                continue;
+            }
+
+            const uint64_t take = std::min (rowsCount, limit_ - emitted_);
+            if (take < rowsCount)
+            {
+                morsel.values_.erase (morsel.values_.begin () + take * morsel.columnsCount_, morsel.values_.end ());
+                morsel.nulls_.resize (take * morsel.columnsCount_);
+            }
+
+            emitted_ += take;
+            if (!consumer (morsel) || emitted_ >= limit_)
+            {
+                return;
+            }
+        }
+    }
+}
+
+void HashJoin::CollectKeys (const Input &input, const AnyDataId *rows, std::size_t count,
+                            std::vector <KeyedRow> &output) const
+{
+    uint8_t mask[Predicate::BATCH_SIZE];
+    Predicate::EvaluationStack stack;
+    AnyDataContainer buffer;
+
+    for (std::size_t batchBegin = 0u; batchBegin < count; batchBegin += Predicate::BATCH_SIZE)
+    {
+        const std::size_t batchSize = std::min (Predicate::BATCH_SIZE, count - batchBegin);
+        if (input.plan_->filter_.GetNodes ().empty ())
+        {
+            memset (mask, 1, batchSize);
+        }
+        else
+        {
+            input.plan_->filter_.Evaluate (input.table_, rows + batchBegin, batchSize, stack, mask);
+        }
+
+        for (std::size_t index = 0u; index < batchSize; ++index)
+        {
+            if (!mask[index])
+            {
+                continue;
+            }
+
+            const AnyDataId rowId = rows[batchBegin + index];
+            KeyHashTable::Key key;
+            bool hasNulls = false;
+
+            for (const Column *column : input.keyColumns_)
+            {
+                const AnyDataContainer *value = column->GetValue (rowId, buffer);
+                if (!value)
+                {
+                    hasNulls = true;
+                    break;
+                }
+
+                Index::AppendToKey (value, key);
+            }
+
+            if (!hasNulls)
+            {
+                const uint64_t hash = KeyHashTable::Hash (key);
+                output.emplace_back (KeyedRow {std::move (key), hash, rowId});
+            }
+        }
+    }
+}
+
+void HashJoin::ProbeMorsel (const AnyDataId *rows, std::size_t count, QueryBatch &output) const
+{
+    std::vector <KeyedRow> keyedRows;
+    CollectKeys (isLeftBuilt_ ? right_ : left_, rows, count, keyedRows);
+    output.columnsCount_ = left_.projection_.size () + right_.projection_.size ();
+
+    for (const KeyedRow &keyedRow : keyedRows)
+    {
+        const std::vector <AnyDataId> *matches = partitions_[GetPartition (keyedRow.hash_)].Find (keyedRow.key_);
+        if (!matches)
+        {
+            continue;
+        }
+
+        for (AnyDataId builtRowId : *matches)
+        {
+            AppendProjection (left_, isLeftBuilt_ ? builtRowId : keyedRow.rowId_, output);
+            AppendProjection (right_, isLeftBuilt_ ? keyedRow.rowId_ : builtRowId, output);
+        }
+    }
+}
+
+void HashJoin::AppendProjection (const Input &input, AnyDataId rowId, QueryBatch &output) const
+{
+    AnyDataContainer buffer;
+    for (const Column *column : input.projection_)
+    {
+        const AnyDataContainer *value = column->GetValue (rowId, buffer);
+        if (value)
+        {
+            output.values_.emplace_back (*value);
+            output.nulls_.emplace_back (0u);
+        }
+        else
+        {
+            output.values_.emplace_back ();
+            output.nulls_.emplace_back (1u);
+        }
+    }
+}
+
+void HashJoin::ForEach (std::size_t count, const std::function <void (std::size_t)> &function) const
+{
+    if (workers_ && count > 1u)
+    {
+        Disco::ParallelFor (workers_, count, function);
+    }
+    else
+    {
+        for (std::size_t index = 0u; index < count; ++index)
+        {
+            function (index);
+        }
+    }
+}
+
+std::size_t HashJoin::GetPartition (uint64_t hash) const
+{
+    // Low bits of hash select slots inside partition, so partition is selected by high bits.
+    return (hash >> 32u) % partitions_.size ();
+}
+}
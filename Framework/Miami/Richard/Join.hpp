@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/KeyHashTable.hpp>
+#include <Miami/Richard/Predicate.hpp>
+#include <Miami/Richard/Query.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+
+namespace Miami::Richard
+{
+class Column;
+
+class Table;
+
+/// One input of hash join.
+struct JoinInput
+{
+    /// Rows of inputs are matched if values of all their key columns are equal. Null keys never match.
+    std::vector <AnyDataId> keyColumns_;
+
+    /// Predicate without nodes matches all rows.
+    Predicate filter_;
+
+    std::vector <AnyDataId> projection_;
+};
+
+/// Inner equality join of two tables. Each output row is projection of left row followed by projection of right row.
+struct JoinPlan
+{
+    JoinInput left_;
+    JoinInput right_;
+    uint64_t limit_ = std::numeric_limits <uint64_t>::max ();
+};
+
+/// Builds hash table on smaller input and probes it with rows of bigger input. Hash table is split into partitions
+/// by key hash, so partitions are built by different Disco workers. Probe rows are split into morsels, that are
+/// processed in waves like in QueryExecutor, therefore output is streamed and execution stops at limit.
+class HashJoin final
+{
+public:
+    static constexpr std::size_t MORSEL_SIZE = QueryExecutor::MORSEL_SIZE;
+
+    /// Guards are usually captured together by one lock group. Table could be joined with itself using one guard.
+    /// If workers context is given, join is executed by its workers, but consumer is always called by calling thread.
+    free_call static ResultCode Execute (const Table *left, const std::shared_ptr <Disco::SafeLockGuard> &leftGuard,
+                                         const Table *right, const std::shared_ptr <Disco::SafeLockGuard> &rightGuard,
+                                         const JoinPlan &plan, Disco::Context *workers,
+                                         const QueryConsumer &consumer);
+
+private:
+    struct Input
+    {
+        const Table *table_;
+        const JoinInput *plan_;
+        std::vector <const Column *> keyColumns_;
+        std::vector <const Column *> projection_;
+    };
+
+    /// Normalized key of input row, see Index::BuildRowKey.
+    struct KeyedRow
+    {
+        KeyHashTable::Key key_;
+        uint64_t hash_;
+        AnyDataId rowId_;
+    };
+
+    free_call static ResultCode ValidateInput (const Table *table, const JoinInput &input);
+
+    /// Plan must be validated and must outlive join.
+    HashJoin (const Table *left, const Table *right, const JoinPlan &plan, Disco::Context *workers);
+
+    void Build ();
+
+    void Probe (const QueryConsumer &consumer);
+
+    /// Filters given rows and appends rows with non null keys to the output.
+    void CollectKeys (const Input &input, const AnyDataId *rows, std::size_t count,
+                      std::vector <KeyedRow> &output) const;
+
+    void ProbeMorsel (const AnyDataId *rows, std::size_t count, QueryBatch &output) const;
+
+    void AppendProjection (const Input &input, AnyDataId rowId, QueryBatch &output) const;
+
+    /// Calls function for each index in [0, count), using workers if they are available.
+    void ForEach (std::size_t count, const std::function <void (std::size_t)> &function) const;
+
+    free_call std::size_t GetPartition (uint64_t hash) const;
+
+    Input left_;
+    Input right_;
+    bool isLeftBuilt_;
+    uint64_t limit_;
+    Disco::Context *workers_;
+
+    std::vector <KeyHashTable> partitions_;
+    std::vector <AnyDataId> probeRows_;
+    uint64_t emitted_;
+};
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+
+#include <Miami/Richard/KeyHashTable.hpp>
+
+namespace Miami::Richard
+{
+KeyHashTable::KeyHashTable ()
+    : rows_ ()
+{
+}
+
+void KeyHashTable::Insert (const Key &key, AnyDataId rowId)
+{
+    rows_[key].emplace_back (rowId);
+}
+
+bool KeyHashTable::Erase (const Key &key, AnyDataId rowId)
+{
+    auto keyIterator = rows_.find (key);
+    if (keyIterator == rows_.end ())
+    {
+        return false;
+    }
+
+    std::vector <AnyDataId> &rows = keyIterator->second;
+    auto iterator = std::find (rows.begin (), rows.end (), rowId);
+
+    if (iterator == rows.end ())
+    {
+        return false;
+    }
+
+    // Order of rows inside one key is not important, so we can use cheap unordered erase.
+    *iterator = rows.back ();
+    rows.pop_back ();
+
+    if (rows.empty ())
+    {
+        rows_.erase (keyIterator);
+    }
+
+    return true;
+}
+
+const std::vector <AnyDataId> *KeyHashTable::Find (const Key &key) const
+{
+    auto iterator = rows_.find (key);
+    return iterator == rows_.end () ? nullptr : &iterator->second;
+}
+
+std::size_t KeyHashTable::GetKeyCount () const
+{
+    return rows_.size ();
+}
+
+void KeyHashTable::Clear ()
+{
+    rows_.clear ();
+}
+
+uint64_t KeyHashTable::Hash (const Key &key)
+{
+    // FNV-1a, keys are short and already normalized, so there is no need for something heavier.
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (uint8_t byte : key)
+    {
+        hash ^= byte;
+        hash *= 0x100000001b3u;
+    }
+
+    return hash;
+}
+}
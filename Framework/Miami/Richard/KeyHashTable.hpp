@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Data.hpp>
+
+namespace Miami::Richard
+{
+/// Maps normalized key bytes to ids of rows with this key. Used as storage for hash indices and hash joins,
+/// therefore one key could be shared by several rows. Keys are stored in Janitor flat map, this class only adds
+/// multimap semantics and hash function, that does not depend on standard library.
+class KeyHashTable final
+{
+public:
+    using Key = std::vector <uint8_t>;
+
+    KeyHashTable ();
+
+    ~KeyHashTable () = default;
+
+    void Insert (const Key &key, AnyDataId rowId);
+
+    /// Returns false if there is no given row with given key.
+    bool Erase (const Key &key, AnyDataId rowId);
+
+    /// Returns nullptr if there is no rows with given key.
+    free_call const std::vector <AnyDataId> *Find (const Key &key) const;
+
+    free_call std::size_t GetKeyCount () const;
+
+    void Clear ();
+
+    /// Stable across platforms and runs, therefore it is also used to place rows into partitions and shards.
+    free_call static uint64_t Hash (const Key &key);
+
+private:
+    struct KeyHash final
+    {
+        free_call std::size_t operator () (const Key &key) const
+        {
+            return static_cast <std::size_t> (Hash (key));
+        }
+    };
+
+    Janitor::FlatHashMap <Key, std::vector <AnyDataId>, KeyHash> rows_;
+};
+}
@@ -0,0 +1,658 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Richard/KeyHashTable.hpp>
+#include <Miami/Richard/Partitioning.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+/// Shared by insertion tasks of all partitions, last finished task passes result to callback.
+struct InsertRowsState
+{
+    std::vector <std::vector <Table::Row>> rows_;
+    std::atomic <std::size_t> tasksLeft_ {0u};
+
+    std::mutex resultGuard_;
+    ResultCode result_ = ResultCode::OK;
+    PartitionedTable::InsertCallback callback_;
+};
+
+int CompareValues (const AnyDataContainer *first, const AnyDataContainer *second)
+{
+    if (first == nullptr || second == nullptr)
+    {
+        return (first != nullptr) - (second != nullptr);
+    }
+    else if (*first < *second)
+    {
+        return -1;
+    }
+    else
+    {
+        return *second < *first ? 1 : 0;
+    }
+}
+}
+
+const char *GetPartitioningTypeName (PartitioningType partitioningType)
+{
+    switch (partitioningType)
+    {
+        case PartitioningType::HASH:
+            return "hash";
+        case PartitioningType::RANGE:
+            return "range";
+    }
+
+    return "unknown";
+}
+
+ResultCode PartitionedTable::Create (Disco::Context *multithreadingContext, std::string name,
+                                     PartitioningInfo &info, PartitionedTable *&output)
+{
+    if (name.empty ())
+    {
+        return ResultCode::TABLE_NAME_SHOULD_NOT_BE_EMPTY;
+    }
+
+    if (info.type_ == PartitioningType::HASH ? info.partitionsCount_ < 2u : info.rangeBounds_.empty ())
+    {
+        return ResultCode::PARTITIONS_COUNT_MUST_BE_AT_LEAST_TWO;
+    }
+
+    if (info.type_ == PartitioningType::RANGE)
+    {
+        for (std::size_t index = 0u; index < info.rangeBounds_.size (); ++index)
+        {
+            if (info.rangeBounds_[index].GetType () != info.keyColumn_.dataType_)
+            {
+                return ResultCode::PARTITION_RANGE_BOUND_TYPE_MISMATCH;
+            }
+
+            if (index > 0u && info.rangeBounds_[index] <= info.rangeBounds_[index - 1u])
+            {
+                return ResultCode::PARTITION_RANGE_BOUNDS_MUST_BE_ASCENDING;
+            }
+        }
+
+        info.partitionsCount_ = info.rangeBounds_.size () + 1u;
+    }
+
+    std::unique_ptr <PartitionedTable> table (new PartitionedTable (multithreadingContext, std::move (name), info));
+    for (std::unique_ptr <Table> &partition : table->partitions_)
+    {
+        // Partitions are not visible to other threads yet, so there is no need to capture their guards.
+        ResultCode result = partition->AddColumnInternal (table->info_.keyColumn_, table->keyColumnId_);
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+    }
+
+    output = table.release ();
+    return ResultCode::OK;
+}
+
+const std::string &PartitionedTable::GetName () const
+{
+    return name_;
+}
+
+const PartitioningInfo &PartitionedTable::GetPartitioningInfo () const
+{
+    return info_;
+}
+
+AnyDataId PartitionedTable::GetKeyColumnId () const
+{
+    return keyColumnId_;
+}
+
+std::size_t PartitionedTable::GetPartitionsCount () const
+{
+    return partitions_.size ();
+}
+
+Table *PartitionedTable::GetPartition (std::size_t index)
+{
+    assert (index < partitions_.size ());
+    return partitions_[index].get ();
+}
+
+ResultCode PartitionedTable::FindPartition (const Table::Row &row, std::size_t &output) const
+{
+    auto iterator = row.find (keyColumnId_);
+    if (iterator == row.end ())
+    {
+        output = FindPartition (nullptr);
+        return ResultCode::OK;
+    }
+
+    if (iterator->second.GetType () != info_.keyColumn_.dataType_)
+    {
+        return ResultCode::NEW_COLUMN_VALUE_TYPE_MISMATCH;
+    }
+
+    output = FindPartition (&iterator->second);
+    return ResultCode::OK;
+}
+
+void PartitionedTable::CollectReadLocks (std::vector <Disco::AnyLockPointer> &outputLocks)
+{
+    for (std::unique_ptr <Table> &partition : partitions_)
+    {
+        outputLocks.emplace_back (&partition->ReadWriteGuard ().Read ());
+    }
+}
+
+void PartitionedTable::CollectWriteLocks (std::vector <Disco::AnyLockPointer> &outputLocks)
+{
+    for (std::unique_ptr <Table> &partition : partitions_)
+    {
+        outputLocks.emplace_back (&partition->ReadWriteGuard ().Write ());
+    }
+}
+
+ResultCode PartitionedTable::AddColumn (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards,
+    const ColumnInfo &info, AnyDataId &outputId)
+{
+    if (!CheckWriteGuards (partitionWriteGuards))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    // Column validation does not depend on partition content, so column is either added to all partitions
+    // or rejected by the first one. Ids are generated in the same way, therefore they are equal too.
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        ResultCode result = partitions_[index]->AddColumn (partitionWriteGuards[index], info, outputId);
+        if (result != ResultCode::OK)
+        {
+            assert (index == 0u);
+            return result;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode PartitionedTable::RemoveColumn (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards, AnyDataId id)
+{
+    if (!CheckWriteGuards (partitionWriteGuards))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (id == keyColumnId_)
+    {
+        return ResultCode::PARTITION_KEY_COLUMN_REMOVAL_BLOCKED;
+    }
+
+    // Removal is checked for every partition first, so column is never removed only from some partitions.
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        if (partitions_[index]->columns_.count (id) == 0u)
+        {
+            return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        for (auto &idIndexPair : partitions_[index]->indices_)
+        {
+            if (idIndexPair.second->UsesColumn (id) &&
+                !idIndexPair.second->IsSafeToRemove (partitionWriteGuards[index]))
+            {
+                return ResultCode::COLUMN_REMOVAL_BLOCKED_BY_DEPENDANT_INDEX;
+            }
+        }
+    }
+
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        ResultCode result = partitions_[index]->RemoveColumn (partitionWriteGuards[index], id);
+        if (result != ResultCode::OK)
+        {
+            assert (false);
+            return result;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode PartitionedTable::AddIndex (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards,
+    const IndexInfo &info, AnyDataId &outputId)
+{
+    if (!CheckWriteGuards (partitionWriteGuards))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        ResultCode result = partitions_[index]->AddIndex (partitionWriteGuards[index], info, outputId);
+        if (result != ResultCode::OK)
+        {
+            // Index was just created, so there are no cursors, that could block its removal.
+            for (std::size_t revertIndex = 0u; revertIndex < index; ++revertIndex)
+            {
+                if (partitions_[revertIndex]->RemoveIndex (partitionWriteGuards[revertIndex], outputId) !=
+                    ResultCode::OK)
+                {
+                    assert (false);
+                }
+            }
+
+            // Failed partition could have already used generated id, so id generators are synchronized.
+            for (std::unique_ptr <Table> &partition : partitions_)
+            {
+                partition->nextIndexId_ = partitions_[index]->nextIndexId_;
+            }
+
+            return result;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode PartitionedTable::RemoveIndex (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards, AnyDataId id)
+{
+    if (!CheckWriteGuards (partitionWriteGuards))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        auto iterator = partitions_[index]->indices_.find (id);
+        if (iterator == partitions_[index]->indices_.end ())
+        {
+            return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        if (!iterator->second->IsSafeToRemove (partitionWriteGuards[index]))
+        {
+            return ResultCode::INDEX_REMOVAL_BLOCKED_BY_DEPENDANT_CURSORS;
+        }
+    }
+
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        ResultCode result = partitions_[index]->RemoveIndex (partitionWriteGuards[index], id);
+        if (result != ResultCode::OK)
+        {
+            assert (false);
+            return result;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+void PartitionedTable::InsertRows (std::vector <Table::Row> &rows, InsertCallback callback)
+{
+    auto state = std::make_shared <InsertRowsState> ();
+    state->rows_.resize (partitions_.size ());
+    state->callback_ = std::move (callback);
+
+    // Partitions of all rows are found before any row is moved, so rejected batch leaves given rows unchanged.
+    std::vector <std::size_t> partitions (rows.size ());
+    for (std::size_t index = 0u; index < rows.size (); ++index)
+    {
+        ResultCode result = FindPartition (rows[index], partitions[index]);
+        if (result != ResultCode::OK)
+        {
+            state->callback_ (result);
+            return;
+        }
+    }
+
+    for (std::size_t index = 0u; index < rows.size (); ++index)
+    {
+        state->rows_[partitions[index]].emplace_back (std::move (rows[index]));
+    }
+
+    state->tasksLeft_ = static_cast <std::size_t> (
+        std::count_if (state->rows_.begin (), state->rows_.end (),
+                       [] (const std::vector <Table::Row> &partitionRows)
+                       {
+                           return !partitionRows.empty ();
+                       }));
+
+    if (state->tasksLeft_ == 0u)
+    {
+        state->callback_ (ResultCode::OK);
+        return;
+    }
+
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        if (state->rows_[index].empty ())
+        {
+            continue;
+        }
+
+        Table *partition = partitions_[index].get ();
+        Disco::After (
+            &partition->ReadWriteGuard ().Intent (),
+            [state, partition, index] (std::shared_ptr <Disco::SafeLockGuard> guard)
+            {
+                for (Table::Row &row : state->rows_[index])
+                {
+                    ResultCode result = partition->InsertRow (guard, row);
+                    if (result != ResultCode::OK)
+                    {
+                        std::unique_lock <std::mutex> lock (state->resultGuard_);
+                        if (state->result_ == ResultCode::OK)
+                        {
+                            state->result_ = result;
+                        }
+
+                        break;
+                    }
+                }
+
+                // Guard is released before callback, so callback could capture partitions again.
+                state->rows_[index].clear ();
+                guard.reset ();
+
+                if (--state->tasksLeft_ == 0u)
+                {
+                    state->callback_ (state->result_);
+                }
+            });
+    }
+}
+
+ResultCode PartitionedTable::CreateReadCursor (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards, AnyDataId indexId,
+    PartitionedReadCursor *&output)
+{
+    if (!CheckReadOrWriteGuards (partitionGuards))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    IndexInfo indexInfo;
+    ResultCode result = partitions_[0u]->GetIndexInfo (partitionGuards[0u], indexId, indexInfo);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    std::vector <std::unique_ptr <TableReadCursor>> cursors;
+    cursors.reserve (partitions_.size ());
+
+    for (std::size_t index = 0u; index < partitions_.size (); ++index)
+    {
+        TableReadCursor *cursor = nullptr;
+        result = partitions_[index]->CreateReadCursor (partitionGuards[index], indexId, cursor);
+
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        cursors.emplace_back (cursor);
+    }
+
+    std::unique_ptr <PartitionedReadCursor> cursor (
+        new PartitionedReadCursor (std::move (cursors), std::move (indexInfo.columns_)));
+    result = cursor->SelectCurrent (partitionGuards);
+
+    if (result == ResultCode::OK)
+    {
+        output = cursor.release ();
+    }
+
+    return result;
+}
+
+PartitionedTable::PartitionedTable (Disco::Context *multithreadingContext, std::string name, PartitioningInfo &info)
+    : name_ (std::move (name)),
+      info_ (std::move (info)),
+      keyColumnId_ (0),
+      partitions_ ()
+{
+    partitions_.reserve (info_.partitionsCount_);
+    for (std::size_t index = 0u; index < info_.partitionsCount_; ++index)
+    {
+        partitions_.emplace_back (std::make_unique <Table> (
+            multithreadingContext, static_cast <AnyDataId> (index), name_ + "#" + std::to_string (index)));
+    }
+}
+
+bool PartitionedTable::CheckReadOrWriteGuards (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards) const
+{
+    if (partitionGuards.size () == partitions_.size ())
+    {
+        for (std::size_t index = 0u; index < partitions_.size (); ++index)
+        {
+            if (!partitions_[index]->CheckReadOrWriteGuard (partitionGuards[index]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    else
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught attempt to read partitioned table \"" + name_ +
+                                                         "\" data without guards of all partitions!");
+        assert (false);
+        return false;
+    }
+}
+
+bool PartitionedTable::CheckWriteGuards (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards) const
+{
+    if (partitionWriteGuards.size () == partitions_.size ())
+    {
+        for (std::size_t index = 0u; index < partitions_.size (); ++index)
+        {
+            if (!partitions_[index]->CheckWriteGuard (partitionWriteGuards[index]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    else
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught attempt to edit partitioned table \"" + name_ +
+                                                         "\" data without write guards of all partitions!");
+        assert (false);
+        return false;
+    }
+}
+
+std::size_t PartitionedTable::FindPartition (const AnyDataContainer *key) const
+{
+    if (key == nullptr)
+    {
+        return 0u;
+    }
+
+    if (info_.type_ == PartitioningType::HASH)
+    {
+        const auto *begin = static_cast <const uint8_t *> (key->GetDataStartPointer ());
+        KeyHashTable::Key bytes (begin, begin + key->GetDataSize ());
+        return static_cast <std::size_t> (KeyHashTable::Hash (bytes) % partitions_.size ());
+    }
+    else
+    {
+        return static_cast <std::size_t> (
+            std::upper_bound (info_.rangeBounds_.begin (), info_.rangeBounds_.end (), *key) -
+            info_.rangeBounds_.begin ());
+    }
+}
+
+ResultCode PartitionedReadCursor::Advance (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards, uint64_t step)
+{
+    if (partitionGuards.size () != cursors_.size ())
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                  "Caught attempt to advance partitioned cursor without guards of all partitions!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    for (uint64_t stepIndex = 0u; stepIndex < step; ++stepIndex)
+    {
+        if (current_ == cursors_.size ())
+        {
+            return ResultCode::CURSOR_ADVANCE_STOPPED_AT_END;
+        }
+
+        ResultCode result = cursors_[current_]->Advance (partitionGuards[current_], 1);
+        if (result != ResultCode::OK && result != ResultCode::CURSOR_ADVANCE_STOPPED_AT_END)
+        {
+            return result;
+        }
+
+        result = SelectCurrent (partitionGuards);
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode PartitionedReadCursor::Get (const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards,
+                                      AnyDataId columnId, const AnyDataContainer *&output) const
+{
+    if (current_ == cursors_.size ())
+    {
+        return ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END;
+    }
+
+    if (partitionGuards.size () != cursors_.size ())
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                  "Caught attempt to read partitioned cursor without guards of all partitions!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    return cursors_[current_]->Get (partitionGuards[current_], columnId, output);
+}
+
+ResultCode PartitionedReadCursor::GetPartition (std::size_t &output) const
+{
+    if (current_ == cursors_.size ())
+    {
+        return ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END;
+    }
+
+    output = current_;
+    return ResultCode::OK;
+}
+
+PartitionedReadCursor::PartitionedReadCursor (std::vector <std::unique_ptr <TableReadCursor>> cursors,
+                                              std::vector <AnyDataId> keyColumns)
+    : cursors_ (std::move (cursors)),
+      keyColumns_ (std::move (keyColumns)),
+      active_ (),
+      current_ (cursors_.size ())
+{
+    active_.reserve (cursors_.size ());
+    for (std::size_t index = 0u; index < cursors_.size (); ++index)
+    {
+        active_.emplace_back (index);
+    }
+}
+
+ResultCode PartitionedReadCursor::SelectCurrent (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards)
+{
+    current_ = cursors_.size ();
+    auto iterator = active_.begin ();
+
+    while (iterator != active_.end ())
+    {
+        const AnyDataContainer *value;
+        ResultCode result = cursors_[*iterator]->Get (partitionGuards[*iterator], keyColumns_.front (), value);
+
+        if (result == ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END)
+        {
+            iterator = active_.erase (iterator);
+            continue;
+        }
+        else if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        // Active partitions are sorted by index, so strict comparison orders equal keys by partition index.
+        int comparison = -1;
+        if (current_ != cursors_.size ())
+        {
+            result = CompareCurrent (partitionGuards, *iterator, current_, comparison);
+            if (result != ResultCode::OK)
+            {
+                return result;
+            }
+        }
+
+        if (comparison < 0)
+        {
+            current_ = *iterator;
+        }
+
+        ++iterator;
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode PartitionedReadCursor::CompareCurrent (
+    const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards, std::size_t first,
+    std::size_t second, int &output) const
+{
+    for (AnyDataId columnId : keyColumns_)
+    {
+        const AnyDataContainer *firstValue;
+        ResultCode result = cursors_[first]->Get (partitionGuards[first], columnId, firstValue);
+
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        const AnyDataContainer *secondValue;
+        result = cursors_[second]->Get (partitionGuards[second], columnId, secondValue);
+
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        output = CompareValues (firstValue, secondValue);
+        if (output != 0)
+        {
+            return ResultCode::OK;
+        }
+    }
+
+    output = 0;
+    return ResultCode::OK;
+}
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Index.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+enum class PartitioningType
+{
+    /// Rows are distributed by hash of key value. Rows with null key are stored in first partition.
+    HASH = 0,
+
+    /// Every partition stores continuous range of key values. Rows with null key are stored in first partition.
+    RANGE
+};
+
+const char *GetPartitioningTypeName (PartitioningType partitioningType);
+
+struct PartitioningInfo
+{
+    PartitioningType type_ = PartitioningType::HASH;
+
+    /// Key column is added to every partition on creation and could not be removed.
+    ColumnInfo keyColumn_;
+
+    /// Used only by hash partitioning.
+    std::size_t partitionsCount_ = 0u;
+
+    /// Used only by range partitioning. Partition with index i stores keys, that are not less than bound i - 1
+    /// and less than bound i, therefore there is one more partition than bounds. Bounds must be strictly ascending.
+    std::vector <AnyDataContainer> rangeBounds_ {};
+};
+
+class PartitionedReadCursor;
+
+/// Table, which rows are split by partitioning key into several usual tables. Every partition has its own
+/// columns, indices and guard, so writers of different partitions do not block each other. Schema changes are
+/// applied to every partition under write guards of all partitions, therefore column and index ids are equal
+/// in all partitions. Unique indices are checked per partition, so they are global only if they cover key column.
+class PartitionedTable final
+{
+public:
+    using InsertCallback = std::function <void (ResultCode)>;
+
+    free_call static ResultCode Create (Disco::Context *multithreadingContext, std::string name,
+                                        moved_in PartitioningInfo &info, PartitionedTable *&output);
+
+    PartitionedTable (const PartitionedTable &another) = delete;
+
+    PartitionedTable (PartitionedTable &&another) = delete;
+
+    ~PartitionedTable () = default;
+
+    free_call const std::string &GetName () const;
+
+    free_call const PartitioningInfo &GetPartitioningInfo () const;
+
+    free_call AnyDataId GetKeyColumnId () const;
+
+    free_call std::size_t GetPartitionsCount () const;
+
+    /// Partition is accessed as usual table under its own guard.
+    free_call Table *GetPartition (std::size_t index);
+
+    /// Finds partition, to which given row belongs. Absent key value is treated as null.
+    free_call ResultCode FindPartition (const Table::Row &row, std::size_t &output) const;
+
+    /// Collect locks of all partitions in order of partitions. They should be captured together by one lock
+    /// group and passed to methods, that require guards of all partitions, in the same order.
+    void CollectReadLocks (std::vector <Disco::AnyLockPointer> &outputLocks);
+
+    void CollectWriteLocks (std::vector <Disco::AnyLockPointer> &outputLocks);
+
+    free_call ResultCode AddColumn (const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards,
+                                    const ColumnInfo &info, AnyDataId &outputId);
+
+    free_call ResultCode RemoveColumn (
+        const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards, AnyDataId id);
+
+    /// If index could not be added to some partition, for example because of unique constraint violation,
+    /// it is removed from partitions, to which it was already added.
+    free_call ResultCode AddIndex (const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards,
+                                   const IndexInfo &info, AnyDataId &outputId);
+
+    free_call ResultCode RemoveIndex (
+        const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards, AnyDataId id);
+
+    /// Routes rows to partitions and inserts them by context workers. Every partition captures only its own intent
+    /// guard, therefore inserts into different partitions are executed in parallel and concurrent inserts into the
+    /// same partition do not wait for each other. Rows of every partition are inserted in order until first failure
+    /// and successful inserts are not reverted. If partition of any row could not be found, callback is called with
+    /// this error right away and given rows are left unchanged. Otherwise callback is called exactly once, by worker
+    /// that finishes last, with first failure code or with OK.
+    void InsertRows (moved_in std::vector <Table::Row> &rows, InsertCallback callback);
+
+    /// Creates cursor, that merges cursors of all partitions over ordered index with given id, so rows of
+    /// all partitions are visited in index order. Rows with equal keys are ordered by partition index.
+    free_call ResultCode CreateReadCursor (
+        const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards, AnyDataId indexId,
+        PartitionedReadCursor *&output);
+
+private:
+    PartitionedTable (Disco::Context *multithreadingContext, std::string name, moved_in PartitioningInfo &info);
+
+    free_call bool CheckReadOrWriteGuards (
+        const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards) const;
+
+    free_call bool CheckWriteGuards (
+        const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionWriteGuards) const;
+
+    free_call std::size_t FindPartition (const AnyDataContainer *key) const;
+
+    const std::string name_;
+    const PartitioningInfo info_;
+    AnyDataId keyColumnId_;
+
+    // Unique pointers because moving structures with Disco locks is unsafe for now.
+    std::vector <std::unique_ptr <Table>> partitions_;
+};
+
+class PartitionedReadCursor final
+{
+public:
+    /// Merged cursor moves only forward. Step, that passes the last row, stops cursor at end.
+    free_call ResultCode Advance (const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards,
+                                  uint64_t step);
+
+    /// Returns value of current row, see TableReadCursor::Get.
+    free_call ResultCode Get (const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards,
+                              AnyDataId columnId, const AnyDataContainer *&output) const;
+
+    /// Returns index of partition, to which current row belongs.
+    free_call ResultCode GetPartition (std::size_t &output) const;
+
+private:
+    PartitionedReadCursor (std::vector <std::unique_ptr <TableReadCursor>> cursors,
+                           std::vector <AnyDataId> keyColumns);
+
+    /// Selects partition with the least current key. Partition cursors are never moved by this call.
+    free_call ResultCode SelectCurrent (const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards);
+
+    /// Null is less than anything. Returns negative value if first is less, positive if second is less.
+    free_call ResultCode CompareCurrent (
+        const std::vector <std::shared_ptr <Disco::SafeLockGuard>> &partitionGuards, std::size_t first,
+        std::size_t second, int &output) const;
+
+    std::vector <std::unique_ptr <TableReadCursor>> cursors_;
+    const std::vector <AnyDataId> keyColumns_;
+
+    /// Partitions, which cursors are not at end yet.
+    std::vector <std::size_t> active_;
+
+    /// Index of current partition or cursors count if cursor is at end.
+    std::size_t current_;
+
+    friend class PartitionedTable;
+};
+}
\ No newline at end of file
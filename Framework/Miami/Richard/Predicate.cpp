@@ -0,0 +1,448 @@
+#include <cassert>
+#include <cstring>
+
+#include <Miami/Richard/Predicate.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+/// Comparison loops are branchless, so compiler is able to vectorize them.
+template <typename Type>
+void CompareGathered (PredicateOperation operation, const Type *gathered, const uint8_t *present,
+                      std::size_t count, Type constant, uint8_t *output)
+{
+    switch (operation)
+    {
+        case PredicateOperation::EQUAL:
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = present[index] & (gathered[index] == constant);
+            }
+
+            break;
+
+        case PredicateOperation::NOT_EQUAL:
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = present[index] & (gathered[index] != constant);
+            }
+
+            break;
+
+        case PredicateOperation::LESS:
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = present[index] & (gathered[index] < constant);
+            }
+
+            break;
+
+        case PredicateOperation::LESS_OR_EQUAL:
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = present[index] & (gathered[index] <= constant);
+            }
+
+            break;
+
+        case PredicateOperation::GREATER:
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = present[index] & (gathered[index] > constant);
+            }
+
+            break;
+
+        case PredicateOperation::GREATER_OR_EQUAL:
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = present[index] & (gathered[index] >= constant);
+            }
+
+            break;
+
+        default:
+            assert (false);
+            memset (output, 0, count);
+            break;
+    }
+}
+
+template <typename Type>
+void CompareFixedWidth (PredicateOperation operation, const AnyDataContainer *const *values,
+                        std::size_t count, Type constant, uint8_t *output)
+{
+    // Gathering is separated from comparison, so comparison loops are branchless and could be vectorized.
+    Type gathered[Predicate::BATCH_SIZE];
+    uint8_t present[Predicate::BATCH_SIZE];
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        present[index] = values[index] != nullptr;
+        gathered[index] = present[index] ?
+                          *static_cast <const Type *> (values[index]->GetDataStartPointer ()) : Type {};
+    }
+
+    CompareGathered (operation, gathered, present, count, constant, output);
+}
+
+/// Compressed values are decoded by blocks directly into plain array, so they are never wrapped into containers.
+void EvaluateCompressed (const PredicateNode &node, const CompressedIntegerStorage &storage,
+                         const AnyDataId *rows, std::size_t count, Predicate::BatchResult &output)
+{
+    int64_t gathered[Predicate::BATCH_SIZE];
+    uint8_t present[Predicate::BATCH_SIZE];
+    storage.Gather (rows, count, gathered, present);
+
+    if (node.operation_ == PredicateOperation::IS_NULL)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            output.true_[index] = present[index] ^ 1u;
+        }
+
+        memset (output.unknown_, 0, count);
+    }
+    else if (node.operation_ == PredicateOperation::IS_NOT_NULL)
+    {
+        memcpy (output.true_, present, count);
+        memset (output.unknown_, 0, count);
+    }
+    else
+    {
+        CompareGathered (node.operation_, gathered, present, count, ReadIntegerValue (node.value_), output.true_);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            output.unknown_[index] = present[index] ^ 1u;
+        }
+    }
+}
+
+bool CompareScalar (PredicateOperation operation, const AnyDataContainer &value, const AnyDataContainer &constant)
+{
+    switch (operation)
+    {
+        case PredicateOperation::EQUAL:
+            return value == constant;
+
+        case PredicateOperation::NOT_EQUAL:
+            return value != constant;
+
+        case PredicateOperation::LESS:
+            return value < constant;
+
+        case PredicateOperation::LESS_OR_EQUAL:
+            return value <= constant;
+
+        case PredicateOperation::GREATER:
+            return value > constant;
+
+        case PredicateOperation::GREATER_OR_EQUAL:
+            return value >= constant;
+
+        default:
+            assert (false);
+            return false;
+    }
+}
+
+/// Equal values of encoded column share storage with dictionary entry, so equality is checked by pointers.
+void CompareEncoded (PredicateOperation operation, const AnyDataContainer *const *values,
+                     std::size_t count, const AnyDataContainer *entry, uint8_t *output)
+{
+    if (operation == PredicateOperation::EQUAL)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            // Entry is nullptr if there is no such value in dictionary, therefore it never matches null values.
+            output[index] = entry != nullptr && values[index] == entry;
+        }
+    }
+    else
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            output[index] = values[index] != nullptr && values[index] != entry;
+        }
+    }
+}
+
+bool IsComparison (PredicateOperation operation)
+{
+    return operation <= PredicateOperation::GREATER_OR_EQUAL;
+}
+}
+
+Predicate::Predicate (std::vector <PredicateNode> nodes)
+    : nodes_ (std::move (nodes))
+{
+}
+
+const std::vector <PredicateNode> &Predicate::GetNodes () const
+{
+    return nodes_;
+}
+
+ResultCode Predicate::Validate (const Table *table) const
+{
+    assert (table);
+    std::size_t stackSize = 0;
+
+    for (const PredicateNode &node : nodes_)
+    {
+        switch (node.operation_)
+        {
+            case PredicateOperation::AND:
+            case PredicateOperation::OR:
+                if (stackSize < 2u)
+                {
+                    return ResultCode::PREDICATE_IS_MALFORMED;
+                }
+
+                --stackSize;
+                break;
+
+            case PredicateOperation::NOT:
+                if (stackSize < 1u)
+                {
+                    return ResultCode::PREDICATE_IS_MALFORMED;
+                }
+
+                break;
+
+            case PredicateOperation::IS_NULL:
+            case PredicateOperation::IS_NOT_NULL:
+                if (table->columns_.count (node.columnId_) == 0)
+                {
+                    return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+                }
+
+                ++stackSize;
+                break;
+
+            default:
+            {
+                if (!IsComparison (node.operation_))
+                {
+                    return ResultCode::PREDICATE_IS_MALFORMED;
+                }
+
+                auto iterator = table->columns_.find (node.columnId_);
+                if (iterator == table->columns_.end ())
+                {
+                    return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+                }
+
+                if (iterator->second.GetColumnInfo ().dataType_ != node.value_.GetType ())
+                {
+                    return ResultCode::PREDICATE_VALUE_TYPE_MISMATCH;
+                }
+
+                ++stackSize;
+                break;
+            }
+        }
+    }
+
+    return stackSize == 1u ? ResultCode::OK : ResultCode::PREDICATE_IS_MALFORMED;
+}
+
+void Predicate::Evaluate (const Table *table, const AnyDataId *rows, std::size_t count, EvaluationStack &stack,
+                          uint8_t *output) const
+{
+    assert (table);
+    assert (count <= BATCH_SIZE);
+
+    // Capacity is kept between calls, so only first batch of scan allocates.
+    stack.clear ();
+    stack.reserve (nodes_.size ());
+    const AnyDataContainer *values[BATCH_SIZE];
+
+    // Buffer is required only by compressed columns, but they are evaluated separately.
+    AnyDataContainer unusedBuffer;
+
+    for (const PredicateNode &node : nodes_)
+    {
+        switch (node.operation_)
+        {
+            case PredicateOperation::AND:
+            case PredicateOperation::OR:
+            {
+                assert (stack.size () >= 2u);
+                const BatchResult &right = stack.back ();
+                BatchResult &left = stack[stack.size () - 2u];
+
+                if (node.operation_ == PredicateOperation::AND)
+                {
+                    // Unknown if any operand is unknown and no operand is false.
+                    for (std::size_t index = 0; index < count; ++index)
+                    {
+                        left.unknown_[index] = (left.unknown_[index] | right.unknown_[index]) &
+                                               (left.true_[index] | left.unknown_[index]) &
+                                               (right.true_[index] | right.unknown_[index]);
+                        left.true_[index] &= right.true_[index];
+                    }
+                }
+                else
+                {
+                    // Unknown if any operand is unknown and no operand is true.
+                    for (std::size_t index = 0; index < count; ++index)
+                    {
+                        left.true_[index] |= right.true_[index];
+                        left.unknown_[index] = (left.unknown_[index] | right.unknown_[index]) &
+                                               (left.true_[index] ^ 1u);
+                    }
+                }
+
+                stack.pop_back ();
+                break;
+            }
+
+            case PredicateOperation::NOT:
+            {
+                assert (!stack.empty ());
+                BatchResult &operand = stack.back ();
+
+                // Negation of unknown result is still unknown.
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    operand.true_[index] = (operand.true_[index] | operand.unknown_[index]) ^ 1u;
+                }
+
+                break;
+            }
+
+            default:
+            {
+                auto columnIterator = table->columns_.find (node.columnId_);
+                const Column *column = columnIterator == table->columns_.end () ? nullptr : &columnIterator->second;
+                BatchResult &result = stack.emplace_back ();
+
+                if (column && column->GetCompressedValues ())
+                {
+                    EvaluateCompressed (node, *column->GetCompressedValues (), rows, count, result);
+                    break;
+                }
+
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    values[index] = column ? column->GetValue (rows[index], unusedBuffer) : nullptr;
+                }
+
+                if (node.operation_ == PredicateOperation::IS_NULL)
+                {
+                    for (std::size_t index = 0; index < count; ++index)
+                    {
+                        result.true_[index] = values[index] == nullptr;
+                    }
+
+                    memset (result.unknown_, 0, count);
+                }
+                else if (node.operation_ == PredicateOperation::IS_NOT_NULL)
+                {
+                    for (std::size_t index = 0; index < count; ++index)
+                    {
+                        result.true_[index] = values[index] != nullptr;
+                    }
+
+                    memset (result.unknown_, 0, count);
+                }
+                else
+                {
+                    EvaluateComparison (node, column ? column->GetDictionary () : nullptr, values, count, result);
+                }
+
+                break;
+            }
+        }
+    }
+
+    assert (stack.size () == 1u);
+    if (stack.size () == 1u)
+    {
+        memcpy (output, stack.back ().true_, count);
+    }
+    else
+    {
+        memset (output, 0, count);
+    }
+}
+
+void Predicate::Filter (const Table *table, const RowSet &rows, RowSet &output) const
+{
+    AnyDataId batch[BATCH_SIZE];
+    uint8_t mask[BATCH_SIZE];
+    EvaluationStack stack;
+    std::size_t batchSize = 0u;
+
+    for (AnyDataId rowId : rows)
+    {
+        batch[batchSize++] = rowId;
+        if (batchSize == BATCH_SIZE)
+        {
+            Evaluate (table, batch, batchSize, stack, mask);
+            output.InsertMasked (batch, batchSize, mask);
+            batchSize = 0u;
+        }
+    }
+
+    if (batchSize > 0u)
+    {
+        Evaluate (table, batch, batchSize, stack, mask);
+        output.InsertMasked (batch, batchSize, mask);
+    }
+}
+
+void Predicate::EvaluateComparison (const PredicateNode &node, const ColumnDictionary *dictionary,
+                                    const AnyDataContainer *const *values, std::size_t count,
+                                    BatchResult &result) const
+{
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        result.unknown_[index] = values[index] == nullptr;
+    }
+
+    uint8_t *output = result.true_;
+    // Order of dictionary codes is not related to order of values, so only equality checks could use them.
+    if (dictionary && (node.operation_ == PredicateOperation::EQUAL ||
+                       node.operation_ == PredicateOperation::NOT_EQUAL))
+    {
+        ColumnDictionary::Code code;
+        CompareEncoded (node.operation_, values, count,
+                        dictionary->Find (node.value_, code) ? &dictionary->Get (code) : nullptr, output);
+        return;
+    }
+
+    const void *constant = node.value_.GetDataStartPointer ();
+    switch (node.value_.GetType ())
+    {
+        case DataType::INT8:
+            CompareFixedWidth (node.operation_, values, count, *static_cast <const int8_t *> (constant), output);
+            break;
+
+        case DataType::INT16:
+            CompareFixedWidth (node.operation_, values, count, *static_cast <const int16_t *> (constant), output);
+            break;
+
+        case DataType::INT32:
+            CompareFixedWidth (node.operation_, values, count, *static_cast <const int32_t *> (constant), output);
+            break;
+
+        case DataType::INT64:
+            CompareFixedWidth (node.operation_, values, count, *static_cast <const int64_t *> (constant), output);
+            break;
+
+        default:
+            // Strings and blobs are too big for gathering, so they are compared one by one.
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                output[index] = values[index] != nullptr &&
+                                CompareScalar (node.operation_, *values[index], node.value_);
+            }
+
+            break;
+    }
+}
+}
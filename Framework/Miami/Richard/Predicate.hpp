@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+#include <Miami/Richard/RowSet.hpp>
+
+namespace Miami::Richard
+{
+class ColumnDictionary;
+
+class Table;
+
+enum class PredicateOperation : uint8_t
+{
+    // Column comparisons: compare value of node column with node value.
+    // Comparison with null value is unknown: row does not match, even if result is negated.
+    EQUAL = 0,
+    NOT_EQUAL,
+    LESS,
+    LESS_OR_EQUAL,
+    GREATER,
+    GREATER_OR_EQUAL,
+
+    // Column checks: node value is ignored.
+    IS_NULL,
+    IS_NOT_NULL,
+
+    // Logical operations over results of previous nodes.
+    AND,
+    OR,
+    NOT
+};
+
+struct PredicateNode
+{
+    PredicateOperation operation_;
+    AnyDataId columnId_ = 0;
+    AnyDataContainer value_ {};
+};
+
+/// Boolean expression over row values in postfix notation: comparisons and checks push their
+/// results to stack, logical operations pop their operands from stack and push result back.
+/// Predicate is evaluated for batches of rows: values of each column are gathered into plain
+/// arrays and compared by tight loops, that compiler is able to vectorize. Logical operations
+/// follow three-valued logic, so predicate and its negation never match the same row.
+class Predicate final
+{
+public:
+    /// Maximum count of rows, that are evaluated by one ::Evaluate call.
+    static constexpr std::size_t BATCH_SIZE = 64u;
+
+    /// Result of one node for batch of rows. Unknown result is neither true nor false.
+    struct BatchResult
+    {
+        uint8_t true_[BATCH_SIZE];
+        uint8_t unknown_[BATCH_SIZE];
+    };
+
+    /// Memory for results of nodes, that is reused by all batches of one scan.
+    using EvaluationStack = std::vector <BatchResult>;
+
+    Predicate () = default;
+
+    explicit Predicate (std::vector <PredicateNode> nodes);
+
+    free_call const std::vector <PredicateNode> &GetNodes () const;
+
+    /// Checks that predicate is well formed and that it is compatible with given table.
+    free_call ResultCode Validate (const Table *table) const;
+
+    /// Evaluates predicate for given rows. Rows count must not be greater than ::BATCH_SIZE.
+    /// Result for each row is written to output as 0 or 1, unknown results are written as 0.
+    void Evaluate (const Table *table, const AnyDataId *rows, std::size_t count, EvaluationStack &stack,
+                   uint8_t *output) const;
+
+    /// Evaluates predicate for all rows of given set and inserts matching rows into output.
+    void Filter (const Table *table, const RowSet &rows, RowSet &output) const;
+
+private:
+    void EvaluateComparison (const PredicateNode &node, const ColumnDictionary *dictionary,
+                             const AnyDataContainer *const *values, std::size_t count, BatchResult &output) const;
+
+    std::vector <PredicateNode> nodes_;
+};
+}
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/CompressedIntegerStorage.hpp>
+#include <Miami/Richard/Query.hpp>
+#include <Miami/Richard/Sorting.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+bool IsAggregated (const QueryPlan &plan)
+{
+    return !plan.aggregates_.empty () || !plan.groupColumns_.empty ();
+}
+
+void AppendValue (const AnyDataContainer *value, QueryBatch &output)
+{
+    if (value)
+    {
+        output.values_.emplace_back (*value);
+        output.nulls_.emplace_back (0u);
+    }
+    else
+    {
+        output.values_.emplace_back ();
+        output.nulls_.emplace_back (1u);
+    }
+}
+}
+
+std::size_t QueryBatch::GetRowsCount () const
+{
+    return columnsCount_ > 0u ? values_.size () / columnsCount_ : 0u;
+}
+
+void QueryBatch::MoveRowsTo (std::size_t firstRow, std::size_t rowsCount, QueryBatch &output)
+{
+    const std::size_t begin = firstRow * columnsCount_;
+    const std::size_t end = begin + rowsCount * columnsCount_;
+
+    for (std::size_t index = begin; index < end; ++index)
+    {
+        output.values_.emplace_back (std::move (values_[index]));
+        output.nulls_.emplace_back (nulls_[index]);
+    }
+}
+
+ResultCode QueryExecutor::Validate (const Table *table, const QueryPlan &plan)
+{
+    assert (table);
+    std::size_t outputColumnsCount;
+
+    if (IsAggregated (plan))
+    {
+        AggregationQuery aggregation;
+        aggregation.groupColumns_ = plan.groupColumns_;
+        aggregation.aggregates_ = plan.aggregates_;
+
+        ResultCode result = Aggregator::Validate (table, aggregation);
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        outputColumnsCount = plan.groupColumns_.size () + plan.aggregates_.size ();
+    }
+    else
+    {
+        for (AnyDataId columnId : plan.projection_)
+        {
+            if (table->columns_.count (columnId) == 0)
+            {
+                return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+            }
+        }
+
+        outputColumnsCount = plan.projection_.size ();
+    }
+
+    if (outputColumnsCount == 0u)
+    {
+        return ResultCode::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN;
+    }
+
+    for (const QueryOrder &order : plan.order_)
+    {
+        if (order.outputColumn_ >= outputColumnsCount)
+        {
+            return ResultCode::QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE;
+        }
+    }
+
+    return plan.filter_.GetNodes ().empty () ? ResultCode::OK : plan.filter_.Validate (table);
+}
+
+QueryExecutor::QueryExecutor (const Table *table, const QueryPlan &plan, Disco::Context *workers)
+    : table_ (table),
+      plan_ (plan),
+      workers_ (workers),
+      projection_ (),
+      skipped_ (0u),
+      emitted_ (0u)
+{
+    assert (table_);
+    if (!IsAggregated (plan_))
+    {
+        for (AnyDataId columnId : plan_.projection_)
+        {
+            projection_.emplace_back (&table_->columns_.at (columnId));
+        }
+    }
+}
+
+void QueryExecutor::Execute (const std::vector <AnyDataId> &sourceRows, const QueryConsumer &consumer)
+{
+    skipped_ = 0u;
+    emitted_ = 0u;
+
+    if (plan_.limit_ == 0u)
+    {
+        return;
+    }
+
+    const std::size_t morselsCount = (sourceRows.size () + MORSEL_SIZE - 1u) / MORSEL_SIZE;
+    std::vector <QueryBatch> morsels;
+
+    // Every worker and calling thread get a couple of morsels per wave, so waves are short enough
+    // to stop soon after limit is reached and long enough to keep all workers busy.
+    const std::size_t waveSize = 2u * ((workers_ ? workers_->GetWorkersCount () : 0u) + 1u);
+
+    if (IsAggregated (plan_) || !plan_.order_.empty ())
+    {
+        // Rows before offset are sorted too, but rows after limit are never needed.
+        const uint64_t rowsNeeded = plan_.limit_ > std::numeric_limits <uint64_t>::max () - plan_.offset_ ?
+                                    std::numeric_limits <uint64_t>::max () : plan_.offset_ + plan_.limit_;
+
+        const std::size_t columnsCount = IsAggregated (plan_) ?
+                                         plan_.groupColumns_.size () + plan_.aggregates_.size () : projection_.size ();
+
+        QuerySorter sorter (plan_.order_, columnsCount, rowsNeeded, plan_.sortMemoryBudget_, workers_);
+        if (IsAggregated (plan_))
+        {
+            morsels.resize (1u);
+            Aggregate (sourceRows, morsels.front ());
+            sorter.Add (morsels);
+        }
+        else
+        {
+            for (std::size_t firstMorsel = 0u; firstMorsel < morselsCount; firstMorsel += waveSize)
+            {
+                ProcessMorsels (sourceRows, firstMorsel, std::min (waveSize, morselsCount - firstMorsel), morsels);
+                sorter.Add (morsels);
+            }
+        }
+
+        sorter.Finish (OUTPUT_BATCH_SIZE,
+                       [this, &consumer] (QueryBatch &batch)
+                       {
+                           return Emit (batch, consumer);
+                       });
+        return;
+    }
+
+    for (std::size_t firstMorsel = 0u; firstMorsel < morselsCount; firstMorsel += waveSize)
+    {
+        ProcessMorsels (sourceRows, firstMorsel, std::min (waveSize, morselsCount - firstMorsel), morsels);
+        for (QueryBatch &morsel : morsels)
+        {
+            if (!Emit (morsel, consumer))
+            {
+                return;
+            }
+        }
+    }
+}
+
+void QueryExecutor::ProcessMorsel (const AnyDataId *rows, std::size_t count, QueryBatch &output) const
+{
+    uint8_t mask[Predicate::BATCH_SIZE];
+    Predicate::EvaluationStack stack;
+    AnyDataContainer buffer;
+    output.columnsCount_ = projection_.size ();
+
+    for (std::size_t batchBegin = 0u; batchBegin < count; batchBegin += Predicate::BATCH_SIZE)
+    {
+        const std::size_t batchSize = std::min (Predicate::BATCH_SIZE, count - batchBegin);
+        if (plan_.filter_.GetNodes ().empty ())
+        {
+            memset (mask, 1, batchSize);
+        }
+        else
+        {
+            plan_.filter_.Evaluate (table_, rows + batchBegin, batchSize, stack, mask);
+        }
+
+        for (std::size_t index = 0u; index < batchSize; ++index)
+        {
+            if (mask[index])
+            {
+                for (const Column *column : projection_)
+                {
+                    AppendValue (column->GetValue (rows[batchBegin + index], buffer), output);
+                }
+            }
+        }
+    }
+}
+
+void QueryExecutor::ProcessMorsels (const std::vector <AnyDataId> &sourceRows, std::size_t firstMorsel,
+                                    std::size_t morselsCount, std::vector <QueryBatch> &output) const
+{
+    output.clear ();
+    output.resize (morselsCount);
+
+    auto process = [this, &sourceRows, &output, firstMorsel] (std::size_t index)
+    {
+        const std::size_t begin = (firstMorsel + index) * MORSEL_SIZE;
+        ProcessMorsel (sourceRows.data () + begin, std::min (MORSEL_SIZE, sourceRows.size () - begin), output[index]);
+    };
+
+    if (workers_ && morselsCount > 1u)
+    {
+        Disco::ParallelFor (workers_, morselsCount, process);
+    }
+    else
+    {
+        for (std::size_t index = 0u; index < morselsCount; ++index)
+        {
+            process (index);
+        }
+    }
+}
+
+void QueryExecutor::Aggregate (const std::vector <AnyDataId> &sourceRows, QueryBatch &output) const
+{
+    // Groups are merged by key, so aggregation is done by one thread and only predicate is evaluated in batches.
+    AggregationQuery query;
+    query.groupColumns_ = plan_.groupColumns_;
+    query.aggregates_ = plan_.aggregates_;
+    query.predicate_ = Predicate (std::vector <PredicateNode> (plan_.filter_.GetNodes ()));
+
+    Aggregator aggregator (table_, query);
+    for (std::size_t begin = 0u; begin < sourceRows.size (); begin += Aggregator::BATCH_SIZE)
+    {
+        aggregator.Process (sourceRows.data () + begin, std::min (Aggregator::BATCH_SIZE, sourceRows.size () - begin));
+    }
+
+    std::vector <AggregateGroup> groups;
+    aggregator.Finish (groups);
+    output.columnsCount_ = plan_.groupColumns_.size () + plan_.aggregates_.size ();
+
+    for (AggregateGroup &group : groups)
+    {
+        for (AnyDataId columnId : plan_.groupColumns_)
+        {
+            auto iterator = group.key_.find (columnId);
+            AppendValue (iterator == group.key_.end () ? nullptr : &iterator->second, output);
+        }
+
+        for (std::size_t index = 0u; index < plan_.aggregates_.size (); ++index)
+        {
+            const AggregateResult &result = group.results_[index];
+            int64_t value = result.value_;
+
+            switch (plan_.aggregates_[index].function_)
+            {
+                case AggregateFunction::COUNT_ROWS:
+                case AggregateFunction::COUNT:
+                    value = static_cast <int64_t> (result.count_);
+                    break;
+
+                case AggregateFunction::AVG:
+                    value = result.count_ > 0u ? result.value_ / static_cast <int64_t> (result.count_) : 0;
+                    break;
+
+                default:
+                    break;
+            }
+
+            const bool isNull = result.count_ == 0u &&
+                                plan_.aggregates_[index].function_ != AggregateFunction::COUNT_ROWS &&
+                                plan_.aggregates_[index].function_ != AggregateFunction::COUNT &&
+                                plan_.aggregates_[index].function_ != AggregateFunction::SUM;
+
+            if (isNull)
+            {
+                AppendValue (nullptr, output);
+            }
+            else
+            {
+                AnyDataContainer container;
+                WriteIntegerValue (DataType::INT64, value, container);
+                AppendValue (&container, output);
+            }
+        }
+    }
+}
+
+bool QueryExecutor::Emit (QueryBatch &batch, const QueryConsumer &consumer)
+{
+    const uint64_t rowsCount = batch.GetRowsCount ();
+    const uint64_t skip = std::min (rowsCount, plan_.offset_ - skipped_);
+    const uint64_t take = std::min (rowsCount - skip, plan_.limit_ - emitted_);
+
+    skipped_ += skip;
+    emitted_ += take;
+
+    if (take > 0u)
+    {
+        if (skip > 0u || take < rowsCount)
+        {
+            QueryBatch trimmed;
+            trimmed.columnsCount_ = batch.columnsCount_;
+            batch.MoveRowsTo (skip, take, trimmed);
+
+            if (!consumer (trimmed))
+            {
+                return false;
+            }
+        }
+        else if (!consumer (batch))
+        {
+            return false;
+        }
+    }
+
+    return emitted_ < plan_.limit_;
+}
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Aggregation.hpp>
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Predicate.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+
+namespace Miami::Richard
+{
+class Column;
+
+class Table;
+
+struct QueryOrder
+{
+    /// Index of column in query output, not column id, so aggregated output could be sorted too.
+    uint32_t outputColumn_ = 0u;
+    bool descending_ = false;
+};
+
+/// Declarative query over one table. Stages are always executed in the same order: rows are taken from source,
+/// filtered, then either projected or aggregated, sorted and finally limited.
+struct QueryPlan
+{
+    /// Source is a range of ordered index, if plan has any bound, otherwise all table rows in order of their ids.
+    /// Key columns, that are absent in bound, are treated as nulls.
+    bool hasLowerBound_ = false;
+    bool hasUpperBound_ = false;
+    AnyDataId indexId_ = 0;
+    Janitor::FlatHashMap <AnyDataId, AnyDataContainer> lowerBound_;
+    Janitor::FlatHashMap <AnyDataId, AnyDataContainer> upperBound_;
+
+    /// Predicate without nodes matches all rows.
+    Predicate filter_;
+
+    /// Output columns of plans without aggregates.
+    std::vector <AnyDataId> projection_;
+
+    /// If there are aggregates, output has one row per group: values of group columns followed by aggregate
+    /// values as INT64. AVG is already divided by count. MIN, MAX and AVG over zero values are null.
+    std::vector <AnyDataId> groupColumns_;
+    std::vector <AggregateInfo> aggregates_;
+
+    /// Null values are less than any other values. Rows with equal sort keys keep their source order.
+    std::vector <QueryOrder> order_;
+
+    uint64_t offset_ = 0u;
+    uint64_t limit_ = std::numeric_limits <uint64_t>::max ();
+
+    /// Sorted rows, that exceed this size in bytes, are spilled to temporary files.
+    uint64_t sortMemoryBudget_ = uint64_t (64u) << 20u;
+};
+
+/// Rows of query output, stored value after value. Null values are marked by ::nulls_.
+struct QueryBatch
+{
+    std::size_t columnsCount_ = 0u;
+    std::vector <AnyDataContainer> values_;
+    std::vector <uint8_t> nulls_;
+
+    free_call std::size_t GetRowsCount () const;
+
+    /// Moves given rows to the end of output batch. Moved values are left empty.
+    void MoveRowsTo (std::size_t firstRow, std::size_t rowsCount, QueryBatch &output);
+};
+
+/// Receives query output batch by batch. Returns false to stop query execution.
+using QueryConsumer = std::function <bool (QueryBatch &)>;
+
+/// Executes query plans batch at a time. Source rows are split into morsels, that are filtered and projected
+/// independently, so morsels are distributed between Disco workers. Plans without sorting and aggregation are
+/// executed in waves of morsels and stop as soon as limit is reached, so their output is streamed. Sorted plans
+/// pass waves to QuerySorter, that keeps only offset plus limit rows if plan is limited.
+class QueryExecutor final
+{
+public:
+    /// Count of source rows, that are processed by one task.
+    static constexpr std::size_t MORSEL_SIZE = Predicate::BATCH_SIZE * 16u;
+
+    /// Maximum count of rows in batches of sorted or aggregated output.
+    static constexpr std::size_t OUTPUT_BATCH_SIZE = 1024u;
+
+    /// Checks that plan is compatible with given table. Index range is checked by table.
+    free_call static ResultCode Validate (const Table *table, const QueryPlan &plan);
+
+    /// Plan must be validated and must outlive executor. Without workers context plan is executed by calling thread.
+    QueryExecutor (const Table *table, const QueryPlan &plan, Disco::Context *workers);
+
+    /// Source rows are collected by table, because only it could check index ranges.
+    void Execute (const std::vector <AnyDataId> &sourceRows, const QueryConsumer &consumer);
+
+private:
+    /// Filters and projects given rows, appending matching rows to output.
+    void ProcessMorsel (const AnyDataId *rows, std::size_t count, QueryBatch &output) const;
+
+    /// Processes morsels with given indices, using workers if they are available.
+    void ProcessMorsels (const std::vector <AnyDataId> &sourceRows, std::size_t firstMorsel,
+                         std::size_t morselsCount, std::vector <QueryBatch> &output) const;
+
+    void Aggregate (const std::vector <AnyDataId> &sourceRows, QueryBatch &output) const;
+
+    /// Applies offset and limit to given batch and passes it to consumer.
+    /// Returns false if execution should be stopped.
+    bool Emit (QueryBatch &batch, const QueryConsumer &consumer);
+
+    const Table *table_;
+    const QueryPlan &plan_;
+    Disco::Context *workers_;
+    std::vector <const Column *> projection_;
+
+    uint64_t skipped_;
+    uint64_t emitted_;
+};
+}
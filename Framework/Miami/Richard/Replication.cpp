@@ -0,0 +1,609 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <limits>
+
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Richard/Conduit.hpp>
+#include <Miami/Richard/Encoding.hpp>
+#include <Miami/Richard/Replication.hpp>
+
+namespace Miami::Richard
+{
+using namespace Encoding;
+
+const char *GetMutationTypeName (MutationType mutationType)
+{
+    switch (mutationType)
+    {
+        case MutationType::ADD_TABLE:
+            return "add table";
+        case MutationType::REMOVE_TABLE:
+            return "remove table";
+        case MutationType::SET_TABLE_NAME:
+            return "set table name";
+        case MutationType::ADD_COLUMN:
+            return "add column";
+        case MutationType::REMOVE_COLUMN:
+            return "remove column";
+        case MutationType::ADD_INDEX:
+            return "add index";
+        case MutationType::REMOVE_INDEX:
+            return "remove index";
+        case MutationType::INSERT_ROW:
+            return "insert row";
+        case MutationType::UPDATE_ROW:
+            return "update row";
+        case MutationType::ERASE_ROW_VALUES:
+            return "erase row values";
+        case MutationType::DELETE_ROW:
+            return "delete row";
+    }
+
+    return "unknown";
+}
+
+MutationLog::MutationLog (std::size_t maxRecordsSize)
+    : guard_ (),
+      records_ (),
+      trimmedSequence_ (0u),
+      recordsSize_ (0u),
+      maxRecordsSize_ (maxRecordsSize),
+      replicaSequences_ (),
+      nextReplicaId_ (0u)
+{
+}
+
+static int64_t GetTimestamp ()
+{
+    return std::chrono::duration_cast <std::chrono::milliseconds> (
+        std::chrono::system_clock::now ().time_since_epoch ()).count ();
+}
+
+void MutationLog::Append (MutationType type, AnyDataId tableId, AnyDataId partId,
+                          const std::vector <uint8_t> &payload)
+{
+    int64_t timestamp = GetTimestamp ();
+    std::unique_lock <std::mutex> lock (guard_);
+    AppendRecord (timestamp, type, tableId, partId, payload);
+    Trim ();
+}
+
+void MutationLog::Append (const std::vector <PendingMutation> &mutations)
+{
+    int64_t timestamp = GetTimestamp ();
+    std::unique_lock <std::mutex> lock (guard_);
+
+    for (const PendingMutation &mutation : mutations)
+    {
+        AppendRecord (timestamp, mutation.type_, mutation.tableId_, mutation.partId_, mutation.payload_);
+    }
+
+    Trim ();
+}
+
+void MutationLog::EncodeRow (const Table::Row &row, std::vector <uint8_t> &output)
+{
+    AppendPod (static_cast <uint32_t> (row.size ()), output);
+    for (const auto &columnValuePair : row)
+    {
+        AppendPod (columnValuePair.first, output);
+        AppendValue (columnValuePair.second, output);
+    }
+}
+
+void MutationLog::AppendRecord (int64_t timestamp, MutationType type, AnyDataId tableId, AnyDataId partId,
+                                const std::vector <uint8_t> &payload)
+{
+    std::vector <uint8_t> record;
+    record.reserve (sizeof (uint64_t) + sizeof (int64_t) + sizeof (uint8_t) + sizeof (AnyDataId) * 2u +
+                    sizeof (uint32_t) + payload.size ());
+
+    AppendPod (static_cast <uint64_t> (trimmedSequence_ + records_.size () + 1u), record);
+    AppendPod (timestamp, record);
+    AppendPod (static_cast <uint8_t> (type), record);
+    AppendPod (tableId, record);
+    AppendPod (partId, record);
+    AppendPod (static_cast <uint32_t> (payload.size ()), record);
+    record.insert (record.end (), payload.begin (), payload.end ());
+    recordsSize_ += record.size ();
+    records_.emplace_back (std::move (record));
+}
+
+void MutationLog::Trim ()
+{
+    uint64_t acknowledgedSequence = trimmedSequence_;
+    if (!replicaSequences_.empty ())
+    {
+        acknowledgedSequence = std::numeric_limits <uint64_t>::max ();
+        for (const auto &idSequencePair : replicaSequences_)
+        {
+            acknowledgedSequence = std::min (acknowledgedSequence, idSequencePair.second);
+        }
+    }
+
+    while (!records_.empty () && (recordsSize_ > maxRecordsSize_ || trimmedSequence_ < acknowledgedSequence))
+    {
+        recordsSize_ -= records_.front ().size ();
+        records_.pop_front ();
+        ++trimmedSequence_;
+    }
+}
+
+uint64_t MutationLog::GetLastSequence () const
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    return trimmedSequence_ + records_.size ();
+}
+
+uint64_t MutationLog::GetTrimmedSequence () const
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    return trimmedSequence_;
+}
+
+uint64_t MutationLog::RegisterReplica ()
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    const uint64_t replicaId = nextReplicaId_++;
+    replicaSequences_.emplace (replicaId, trimmedSequence_);
+    return replicaId;
+}
+
+void MutationLog::Acknowledge (uint64_t replicaId, uint64_t appliedSequence)
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    auto iterator = replicaSequences_.find (replicaId);
+
+    if (iterator == replicaSequences_.end ())
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                  "Caught acknowledgement from unknown replica " + std::to_string (replicaId) + "!");
+        assert (false);
+        return;
+    }
+
+    // Replica, that is ahead of log, must not trim records, that are not logged yet.
+    iterator->second = std::min <uint64_t> (appliedSequence, trimmedSequence_ + records_.size ());
+    Trim ();
+}
+
+void MutationLog::UnregisterReplica (uint64_t replicaId)
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    replicaSequences_.erase (replicaId);
+    Trim ();
+}
+
+ResultCode MutationLog::Read (uint64_t afterSequence, std::size_t maxBatchSize, std::vector <uint8_t> &output) const
+{
+    std::unique_lock <std::mutex> lock (guard_);
+    if (afterSequence > trimmedSequence_ + records_.size ())
+    {
+        return ResultCode::REPLICATION_SEQUENCE_IS_AHEAD;
+    }
+
+    if (afterSequence < trimmedSequence_)
+    {
+        return ResultCode::REPLICATION_RESYNC_IS_NEEDED;
+    }
+
+    std::size_t batchSize = 0u;
+    for (auto iterator = records_.begin () + (afterSequence - trimmedSequence_); iterator != records_.end ();
+         ++iterator)
+    {
+        if (batchSize > 0u && batchSize + iterator->size () > maxBatchSize)
+        {
+            break;
+        }
+
+        output.insert (output.end (), iterator->begin (), iterator->end ());
+        batchSize += iterator->size ();
+    }
+
+    return ResultCode::OK;
+}
+
+static bool DecodePayload (const std::vector <uint8_t> &payload, Mutation &mutation)
+{
+    ByteReader reader (payload);
+    switch (mutation.type_)
+    {
+        case MutationType::ADD_TABLE:
+        case MutationType::SET_TABLE_NAME:
+            if (!reader.ReadString (mutation.name_))
+            {
+                return false;
+            }
+
+            break;
+
+        case MutationType::ADD_COLUMN:
+            if (!reader.ReadColumnInfo (mutation.column_))
+            {
+                return false;
+            }
+
+            break;
+
+        case MutationType::ADD_INDEX:
+            if (!reader.ReadIndexInfo (mutation.index_))
+            {
+                return false;
+            }
+
+            break;
+
+        case MutationType::INSERT_ROW:
+        case MutationType::UPDATE_ROW:
+        {
+            uint32_t valuesCount;
+            if (!reader.Read (valuesCount))
+            {
+                return false;
+            }
+
+            for (uint32_t index = 0u; index < valuesCount; ++index)
+            {
+                AnyDataId columnId;
+                AnyDataContainer value;
+
+                if (!reader.Read (columnId) || !reader.ReadValue (value) ||
+                    !mutation.values_.emplace (columnId, std::move (value)).second)
+                {
+                    return false;
+                }
+            }
+
+            break;
+        }
+
+        case MutationType::ERASE_ROW_VALUES:
+            if (!reader.ReadIds (mutation.columns_))
+            {
+                return false;
+            }
+
+            break;
+
+        case MutationType::REMOVE_TABLE:
+        case MutationType::REMOVE_COLUMN:
+        case MutationType::REMOVE_INDEX:
+        case MutationType::DELETE_ROW:
+            break;
+    }
+
+    return reader.IsFinished ();
+}
+
+ResultCode MutationLog::Decode (const std::vector <uint8_t> &batch, std::vector <Mutation> &output)
+{
+    ByteReader reader (batch);
+    std::vector <Mutation> mutations;
+
+    while (!reader.IsFinished ())
+    {
+        Mutation mutation;
+        uint8_t type;
+        uint32_t payloadSize;
+
+        if (!reader.Read (mutation.sequence_) || !reader.Read (mutation.timestamp_) || !reader.Read (type) ||
+            !reader.Read (mutation.tableId_) || !reader.Read (mutation.partId_) || !reader.Read (payloadSize) ||
+            type > static_cast <uint8_t> (MutationType::DELETE_ROW) || payloadSize > batch.size ())
+        {
+            return ResultCode::REPLICATION_BATCH_IS_MALFORMED;
+        }
+
+        mutation.type_ = static_cast <MutationType> (type);
+        std::vector <uint8_t> payload (payloadSize);
+
+        if (!reader.ReadBytes (payload.data (), payloadSize) || !DecodePayload (payload, mutation))
+        {
+            return ResultCode::REPLICATION_BATCH_IS_MALFORMED;
+        }
+
+        // Sequences inside one batch are always continuous, so gap means broken batch, not replica lag.
+        if (!mutations.empty () && mutation.sequence_ != mutations.back ().sequence_ + 1u)
+        {
+            return ResultCode::REPLICATION_BATCH_IS_MALFORMED;
+        }
+
+        mutations.emplace_back (std::move (mutation));
+    }
+
+    output.insert (output.end (), std::make_move_iterator (mutations.begin ()),
+                   std::make_move_iterator (mutations.end ()));
+    return ResultCode::OK;
+}
+
+MutationApplier::MutationApplier (Conduit *conduit)
+    : conduit_ (conduit),
+      appliedSequence_ (0u),
+      appliedTimestamp_ (0)
+{
+    assert (conduit_);
+}
+
+uint64_t MutationApplier::GetAppliedSequence () const
+{
+    return appliedSequence_.load ();
+}
+
+int64_t MutationApplier::GetAppliedTimestamp () const
+{
+    return appliedTimestamp_.load ();
+}
+
+void MutationApplier::Apply (std::vector <Mutation> &mutations, ApplyCallback callback)
+{
+    auto batch = std::make_shared <Batch> ();
+    batch->mutations_ = std::move (mutations);
+    batch->callback_ = std::move (callback);
+    ApplyNext (batch);
+}
+
+void MutationApplier::ApplyNext (const std::shared_ptr <Batch> &batch)
+{
+    if (batch->next_ >= batch->mutations_.size ())
+    {
+        batch->callback_ (ResultCode::OK);
+        return;
+    }
+
+    const Mutation &mutation = batch->mutations_[batch->next_];
+    ResultCode sequenceResult = CheckSequence (mutation);
+
+    if (sequenceResult != ResultCode::OK)
+    {
+        batch->callback_ (sequenceResult);
+        return;
+    }
+
+    if (mutation.type_ == MutationType::ADD_TABLE)
+    {
+        Disco::After (
+            &conduit_->ReadWriteGuard ().Write (),
+            [this, batch] (std::shared_ptr <Disco::SafeLockGuard> conduitWriteGuard)
+            {
+                ResultCode result = ApplyToConduit (conduitWriteGuard, nullptr, batch->mutations_[batch->next_]);
+                conduitWriteGuard.reset ();
+                Continue (batch, result);
+            });
+    }
+    else if (mutation.type_ == MutationType::REMOVE_TABLE)
+    {
+        Disco::After (
+            &conduit_->ReadWriteGuard ().Write (),
+            [this, batch] (std::shared_ptr <Disco::SafeLockGuard> conduitWriteGuard)
+            {
+                Table *table = nullptr;
+                ResultCode result = conduit_->GetTable (
+                    conduitWriteGuard, batch->mutations_[batch->next_].tableId_, table);
+
+                if (result != ResultCode::OK)
+                {
+                    conduitWriteGuard.reset ();
+                    Continue (batch, result);
+                    return;
+                }
+
+                Disco::After (
+                    &table->ReadWriteGuard ().Write (),
+                    [this, batch, conduitWriteGuard] (std::shared_ptr <Disco::SafeLockGuard> tableWriteGuard) mutable
+                    {
+                        ResultCode result = ApplyToConduit (conduitWriteGuard, tableWriteGuard,
+                                                            batch->mutations_[batch->next_]);
+                        tableWriteGuard.reset ();
+                        conduitWriteGuard.reset ();
+                        Continue (batch, result);
+                    });
+            });
+    }
+    else
+    {
+        ApplyTableRun (batch);
+    }
+}
+
+void MutationApplier::ApplyTableRun (const std::shared_ptr <Batch> &batch)
+{
+    Disco::After (
+        &conduit_->ReadWriteGuard ().Read (),
+        [this, batch] (std::shared_ptr <Disco::SafeLockGuard> conduitReadGuard)
+        {
+            const AnyDataId tableId = batch->mutations_[batch->next_].tableId_;
+            Table *table = nullptr;
+            ResultCode result = conduit_->GetTable (conduitReadGuard, tableId, table);
+
+            if (result != ResultCode::OK)
+            {
+                conduitReadGuard.reset ();
+                batch->callback_ (result);
+                return;
+            }
+
+            Disco::After (
+                &table->ReadWriteGuard ().Write (),
+                [this, batch, conduitReadGuard, table, tableId] (
+                    std::shared_ptr <Disco::SafeLockGuard> tableWriteGuard) mutable
+                {
+                    ResultCode result = ResultCode::OK;
+                    while (batch->next_ < batch->mutations_.size ())
+                    {
+                        Mutation &mutation = batch->mutations_[batch->next_];
+                        if (mutation.tableId_ != tableId || mutation.type_ == MutationType::ADD_TABLE ||
+                            mutation.type_ == MutationType::REMOVE_TABLE)
+                        {
+                            break;
+                        }
+
+                        result = CheckSequence (mutation);
+                        if (result == ResultCode::OK)
+                        {
+                            result = ApplyToTable (tableWriteGuard, table, mutation);
+                        }
+
+                        if (result != ResultCode::OK)
+                        {
+                            break;
+                        }
+
+                        MarkApplied (mutation);
+                        ++batch->next_;
+                    }
+
+                    tableWriteGuard.reset ();
+                    conduitReadGuard.reset ();
+
+                    if (result == ResultCode::OK)
+                    {
+                        ApplyNext (batch);
+                    }
+                    else
+                    {
+                        batch->callback_ (result);
+                    }
+                });
+        });
+}
+
+void MutationApplier::Continue (const std::shared_ptr <Batch> &batch, ResultCode result)
+{
+    if (result == ResultCode::OK)
+    {
+        MarkApplied (batch->mutations_[batch->next_]);
+        ++batch->next_;
+        ApplyNext (batch);
+    }
+    else
+    {
+        batch->callback_ (result);
+    }
+}
+
+ResultCode MutationApplier::CheckSequence (const Mutation &mutation) const
+{
+    if (mutation.sequence_ != appliedSequence_.load () + 1u)
+    {
+        Evan::Logger::Get ().Log (
+            Evan::LogLevel::ERROR,
+            "Unable to apply mutation " + std::to_string (mutation.sequence_) + ", because last applied mutation is " +
+            std::to_string (appliedSequence_.load ()) + "!");
+        return ResultCode::REPLICATION_SEQUENCE_GAP;
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode MutationApplier::ApplyToConduit (const std::shared_ptr <Disco::SafeLockGuard> &conduitWriteGuard,
+                                            const std::shared_ptr <Disco::SafeLockGuard> &tableWriteGuard,
+                                            Mutation &mutation)
+{
+    if (mutation.type_ == MutationType::REMOVE_TABLE)
+    {
+        return conduit_->RemoveTable (conduitWriteGuard, tableWriteGuard, mutation.tableId_);
+    }
+
+    if (conduit_->tables_.count (mutation.tableId_) > 0)
+    {
+        return ResultCode::REPLICATION_ID_MISMATCH;
+    }
+
+    // Ids are generated sequentially, so replica generates the same id, that was generated by primary.
+    conduit_->nextTableId_ = mutation.tableId_;
+    AnyDataId tableId;
+    ResultCode result = conduit_->AddTable (conduitWriteGuard, mutation.name_, tableId);
+
+    if (result == ResultCode::OK && tableId != mutation.tableId_)
+    {
+        return ResultCode::REPLICATION_ID_MISMATCH;
+    }
+
+    return result;
+}
+
+ResultCode MutationApplier::ApplyToTable (const std::shared_ptr <Disco::SafeLockGuard> &tableWriteGuard,
+                                          Table *table, Mutation &mutation)
+{
+    AnyDataId outputId = 0u;
+    ResultCode result = ResultCode::OK;
+
+    switch (mutation.type_)
+    {
+        case MutationType::SET_TABLE_NAME:
+            return table->SetName (tableWriteGuard, mutation.name_);
+
+        case MutationType::ADD_COLUMN:
+            if (table->columns_.count (mutation.partId_) > 0)
+            {
+                return ResultCode::REPLICATION_ID_MISMATCH;
+            }
+
+            table->nextColumnId_ = mutation.partId_;
+            result = table->AddColumn (tableWriteGuard, mutation.column_, outputId);
+            break;
+
+        case MutationType::REMOVE_COLUMN:
+            return table->RemoveColumn (tableWriteGuard, mutation.partId_);
+
+        case MutationType::ADD_INDEX:
+            if (table->indices_.count (mutation.partId_) > 0)
+            {
+                return ResultCode::REPLICATION_ID_MISMATCH;
+            }
+
+            table->nextIndexId_ = mutation.partId_;
+            result = table->AddIndex (tableWriteGuard, mutation.index_, outputId);
+            break;
+
+        case MutationType::REMOVE_INDEX:
+            return table->RemoveIndex (tableWriteGuard, mutation.partId_);
+
+        case MutationType::INSERT_ROW:
+            if (!table->CheckWriteGuard (tableWriteGuard))
+            {
+                return ResultCode::INVARIANTS_VIOLATED;
+            }
+
+            if (table->rows_.Contains (mutation.partId_))
+            {
+                return ResultCode::REPLICATION_ID_MISMATCH;
+            }
+
+            // Reverted deletions insert rows with old ids, therefore next id is never decreased.
+            table->nextRowId_ = std::max (table->nextRowId_, mutation.partId_ + 1u);
+            return table->InsertRowWithId (mutation.partId_, mutation.values_);
+
+        case MutationType::UPDATE_ROW:
+            return table->UpdateRow (tableWriteGuard, mutation.partId_, mutation.values_);
+
+        case MutationType::ERASE_ROW_VALUES:
+            return table->EraseRowValues (tableWriteGuard, mutation.partId_, mutation.columns_);
+
+        case MutationType::DELETE_ROW:
+            return table->DeleteRow (tableWriteGuard, mutation.partId_);
+
+        case MutationType::ADD_TABLE:
+        case MutationType::REMOVE_TABLE:
+            Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                      "Caught attempt to apply conduit mutation " +
+                                      std::to_string (mutation.sequence_) + " to table!");
+            assert (false);
+            return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (result == ResultCode::OK && outputId != mutation.partId_)
+    {
+        return ResultCode::REPLICATION_ID_MISMATCH;
+    }
+
+    return result;
+}
+
+void MutationApplier::MarkApplied (const Mutation &mutation)
+{
+    appliedTimestamp_.store (mutation.timestamp_);
+    appliedSequence_.store (mutation.sequence_);
+}
+}
\ No newline at end of file
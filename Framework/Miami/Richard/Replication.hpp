@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Column.hpp>
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/Index.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+class Conduit;
+
+enum class MutationType : uint8_t
+{
+    ADD_TABLE = 0,
+    REMOVE_TABLE,
+    SET_TABLE_NAME,
+    ADD_COLUMN,
+    REMOVE_COLUMN,
+    ADD_INDEX,
+    REMOVE_INDEX,
+
+    /// Row is inserted with logged id, so reverted deletions are replicated as insertions too.
+    INSERT_ROW,
+    UPDATE_ROW,
+
+    /// Sets given columns of row to null.
+    ERASE_ROW_VALUES,
+    DELETE_ROW
+};
+
+const char *GetMutationTypeName (MutationType mutationType);
+
+/// Decoded record of mutation log. Only fields, that are used by mutation type, are filled.
+struct Mutation
+{
+    uint64_t sequence_ = 0u;
+
+    /// Milliseconds since Unix epoch by system clock of primary, when mutation was logged.
+    int64_t timestamp_ = 0;
+
+    MutationType type_ = MutationType::ADD_TABLE;
+    AnyDataId tableId_ = 0u;
+
+    /// Id of added or removed column or index or id of changed row.
+    AnyDataId partId_ = 0u;
+
+    std::string name_ {};
+    ColumnInfo column_ {};
+    IndexInfo index_ {};
+    Table::Row values_ {};
+    std::vector <AnyDataId> columns_ {};
+};
+
+/// Change, that is buffered by transaction until commit succeeds, see MutationLog::Append.
+struct PendingMutation
+{
+    MutationType type_;
+    AnyDataId tableId_;
+    AnyDataId partId_;
+    std::vector <uint8_t> payload_;
+};
+
+/// Ordered log of successful changes of conduit and its tables. Records are encoded when they are appended, so
+/// readers never access table data. Sequences start from one and have no gaps. Log is kept in memory: records,
+/// that are acknowledged by all registered replicas, are trimmed and total size of records never exceeds limit.
+/// Replicas must start from the same backup as primary and must be resynced if records they need were trimmed.
+class MutationLog final
+{
+public:
+    static constexpr std::size_t DEFAULT_MAX_RECORDS_SIZE = 256u * 1024u * 1024u;
+
+    explicit MutationLog (std::size_t maxRecordsSize = DEFAULT_MAX_RECORDS_SIZE);
+
+    MutationLog (const MutationLog &another) = delete;
+
+    MutationLog (MutationLog &&another) = delete;
+
+    ~MutationLog () = default;
+
+    /// Must be called under guard of changed object, so records of every object are ordered like changes.
+    /// Payload format depends on mutation type, see ::Decode.
+    void Append (MutationType type, AnyDataId tableId, AnyDataId partId, const std::vector <uint8_t> &payload);
+
+    /// Appends all changes of committed transaction at once, so readers never see only part of them.
+    void Append (const std::vector <PendingMutation> &mutations);
+
+    /// Row payload must be encoded before row is moved into table.
+    static void EncodeRow (const Table::Row &row, std::vector <uint8_t> &output);
+
+    free_call uint64_t GetLastSequence () const;
+
+    /// Returns sequence of the last trimmed record or zero if nothing was trimmed.
+    free_call uint64_t GetTrimmedSequence () const;
+
+    /// Registered replica keeps records, that follow its acknowledged sequence, from trimming by acknowledgements.
+    /// Replica acknowledges nothing until the first ::Acknowledge call.
+    free_call uint64_t RegisterReplica ();
+
+    /// Marks records up to given sequence as applied by replica and trims records, applied by all replicas.
+    void Acknowledge (uint64_t replicaId, uint64_t appliedSequence);
+
+    void UnregisterReplica (uint64_t replicaId);
+
+    /// Copies records, that follow given sequence, into one batch. The first record is always copied,
+    /// next ones are copied while batch size does not exceed given limit. Returns REPLICATION_RESYNC_IS_NEEDED
+    /// if some of these records were already trimmed.
+    free_call ResultCode Read (uint64_t afterSequence, std::size_t maxBatchSize, std::vector <uint8_t> &output) const;
+
+    free_call static ResultCode Decode (const std::vector <uint8_t> &batch, std::vector <Mutation> &output);
+
+private:
+    /// Must be called under ::guard_.
+    void AppendRecord (int64_t timestamp, MutationType type, AnyDataId tableId, AnyDataId partId,
+                       const std::vector <uint8_t> &payload);
+
+    /// Must be called under ::guard_.
+    void Trim ();
+
+    mutable std::mutex guard_;
+
+    /// Record with sequence N is stored at index N - ::trimmedSequence_ - 1.
+    std::deque <std::vector <uint8_t>> records_;
+    uint64_t trimmedSequence_;
+    std::size_t recordsSize_;
+    std::size_t maxRecordsSize_;
+
+    /// Acknowledged sequences of registered replicas by their ids.
+    Janitor::FlatHashMap <uint64_t, uint64_t> replicaSequences_;
+    uint64_t nextReplicaId_;
+};
+
+/// Applies mutations, read from primary log, to replica conduit in log order. Added tables, columns, indices and
+/// rows get ids from log, so they are equal on primary and replica. Consecutive mutations of one table are applied
+/// under one table write guard, table additions and removals are applied under conduit write guard.
+class MutationApplier final
+{
+public:
+    using ApplyCallback = std::function <void (ResultCode)>;
+
+    explicit MutationApplier (Conduit *conduit);
+
+    MutationApplier (const MutationApplier &another) = delete;
+
+    MutationApplier (MutationApplier &&another) = delete;
+
+    ~MutationApplier () = default;
+
+    /// Returns zero if nothing was applied yet.
+    free_call uint64_t GetAppliedSequence () const;
+
+    /// Returns log timestamp of the last applied mutation or zero if nothing was applied yet.
+    free_call int64_t GetAppliedTimestamp () const;
+
+    /// Applies mutations by context workers and calls callback with the first failure or with OK. Mutations
+    /// before failure stay applied. Next batch must not be passed until callback is called.
+    void Apply (moved_in std::vector <Mutation> &mutations, ApplyCallback callback);
+
+private:
+    struct Batch
+    {
+        std::vector <Mutation> mutations_;
+        std::size_t next_ = 0u;
+        ApplyCallback callback_;
+    };
+
+    void ApplyNext (const std::shared_ptr <Batch> &batch);
+
+    void ApplyTableRun (const std::shared_ptr <Batch> &batch);
+
+    void Continue (const std::shared_ptr <Batch> &batch, ResultCode result);
+
+    free_call ResultCode CheckSequence (const Mutation &mutation) const;
+
+    free_call ResultCode ApplyToConduit (const std::shared_ptr <Disco::SafeLockGuard> &conduitWriteGuard,
+                                         const std::shared_ptr <Disco::SafeLockGuard> &tableWriteGuard,
+                                         moved_in Mutation &mutation);
+
+    free_call ResultCode ApplyToTable (const std::shared_ptr <Disco::SafeLockGuard> &tableWriteGuard, Table *table,
+                                       moved_in Mutation &mutation);
+
+    void MarkApplied (const Mutation &mutation);
+
+    Conduit *conduit_;
+    std::atomic <uint64_t> appliedSequence_;
+    std::atomic <int64_t> appliedTimestamp_;
+};
+}
\ No newline at end of file
@@ -19,13 +19,61 @@ enum class ResultCode
 
     TABLE_NAME_SHOULD_NOT_BE_EMPTY,
     COLUMN_NAME_SHOULD_NOT_BE_EMPTY,
+    COLUMN_MAX_SIZE_IS_TOO_BIG,
+    DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE,
+    COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE,
 
     INDEX_NAME_SHOULD_NOT_BE_EMPTY,
     INDEX_MUST_DEPEND_ON_AT_LEAST_ONE_COLUMN,
+    INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX,
 
     COLUMN_REMOVAL_BLOCKED_BY_DEPENDANT_INDEX,
     INDEX_REMOVAL_BLOCKED_BY_DEPENDANT_CURSORS,
     TABLE_REMOVAL_BLOCKED,
     NEW_COLUMN_VALUE_TYPE_MISMATCH,
+    NEW_COLUMN_VALUE_IS_TOO_BIG,
+
+    TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE,
+    TRANSACTION_TABLES_MUST_BE_UNIQUE,
+    TABLE_IS_NOT_COVERED_BY_TRANSACTION,
+
+    INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION,
+    LOOKUP_KEY_COLUMN_IS_NOT_INDEXED,
+    LOOKUP_KEY_VALUE_TYPE_MISMATCH,
+
+    UNIQUE_INDEX_CONSTRAINT_VIOLATED,
+
+    PREDICATE_IS_MALFORMED,
+    PREDICATE_VALUE_TYPE_MISMATCH,
+
+    AGGREGATE_FUNCTION_IS_UNKNOWN,
+    AGGREGATE_COLUMN_MUST_BE_INTEGER,
+
+    QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN,
+    QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE,
+
+    JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN,
+    JOIN_KEY_COLUMNS_COUNT_MISMATCH,
+    JOIN_KEY_COLUMN_TYPES_MISMATCH,
+
+    BACKUP_MUST_COVER_ALL_TABLES,
+    BACKUP_INTERRUPTED_BY_COLUMN_REMOVAL,
+    BACKUP_FILE_WRITE_FAILED,
+    BACKUP_FILE_READ_FAILED,
+    BACKUP_FILE_IS_MALFORMED,
+    BACKUP_RESTORE_REQUIRES_EMPTY_CONDUIT,
+
+    PARTITIONS_COUNT_MUST_BE_AT_LEAST_TWO,
+    PARTITION_RANGE_BOUNDS_MUST_BE_ASCENDING,
+    PARTITION_RANGE_BOUND_TYPE_MISMATCH,
+    PARTITION_KEY_COLUMN_REMOVAL_BLOCKED,
+
+    ROW_LOCK_DOES_NOT_COVER_CURRENT_ROW,
+
+    REPLICATION_BATCH_IS_MALFORMED,
+    REPLICATION_SEQUENCE_GAP,
+    REPLICATION_SEQUENCE_IS_AHEAD,
+    REPLICATION_ID_MISMATCH,
+    REPLICATION_RESYNC_IS_NEEDED,
 };
 }
\ No newline at end of file
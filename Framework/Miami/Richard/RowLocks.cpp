@@ -0,0 +1,47 @@
+#include <Miami/Richard/RowLocks.hpp>
+
+namespace Miami::Richard
+{
+RowLockTable::RowLockTable (Disco::Context *multithreadingContext)
+    : multithreadingContext_ (multithreadingContext),
+      stripes_ ()
+{
+}
+
+Disco::Lock &RowLockTable::GetLock (AnyDataId rowId)
+{
+    Stripe &stripe = GetStripe (rowId);
+    std::unique_lock <std::mutex> lock (stripe.guard_);
+    std::unique_ptr <Disco::Lock> &rowLock = stripe.locks_[GetIndexInStripe (rowId)];
+
+    if (!rowLock)
+    {
+        rowLock = std::make_unique <Disco::Lock> (multithreadingContext_);
+    }
+
+    return *rowLock;
+}
+
+bool RowLockTable::IsCaptured (const std::shared_ptr <Disco::SafeLockGuard> &rowGuard, AnyDataId rowId) const
+{
+    if (rowGuard == nullptr)
+    {
+        return false;
+    }
+
+    Stripe &stripe = GetStripe (rowId);
+    std::unique_lock <std::mutex> lock (stripe.guard_);
+    const std::unique_ptr <Disco::Lock> &rowLock = stripe.locks_[GetIndexInStripe (rowId)];
+    return rowLock && rowGuard->Is (rowLock.get ());
+}
+
+RowLockTable::Stripe &RowLockTable::GetStripe (AnyDataId rowId) const
+{
+    return stripes_[rowId % STRIPES_COUNT];
+}
+
+std::size_t RowLockTable::GetIndexInStripe (AnyDataId rowId)
+{
+    return (rowId % LOCKS_COUNT) / STRIPES_COUNT;
+}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Richard/Data.hpp>
+
+namespace Miami::Richard
+{
+/// Fixed pool of Disco locks, that cover table rows: row uses lock with index equal to its id modulo pool size, so
+/// memory does not grow with count of rows. Locks are created lazily and kept until table destruction, because
+/// Disco lock could not be destroyed while some lock group waits for it. Pool is split into stripes with their own
+/// mutexes, so threads, that request locks of different rows, rarely contend.
+class RowLockTable final
+{
+public:
+    static constexpr std::size_t STRIPES_COUNT = 64u;
+
+    /// Rows, that share lock, are changed only one by one, so pool is big enough to make it rare.
+    static constexpr std::size_t LOCKS_COUNT = 4096u;
+
+    static_assert (LOCKS_COUNT % STRIPES_COUNT == 0u);
+
+    explicit RowLockTable (Disco::Context *multithreadingContext);
+
+    RowLockTable (const RowLockTable &another) = delete;
+
+    RowLockTable (RowLockTable &&another) = delete;
+
+    ~RowLockTable () = default;
+
+    free_call Disco::Lock &GetLock (AnyDataId rowId);
+
+    /// Returns false if lock of given row was never requested or given guard does not capture it. Guard, that
+    /// captures lock of another row with the same lock, covers given row too.
+    free_call bool IsCaptured (const std::shared_ptr <Disco::SafeLockGuard> &rowGuard, AnyDataId rowId) const;
+
+private:
+    struct Stripe
+    {
+        mutable std::mutex guard_;
+        std::array <std::unique_ptr <Disco::Lock>, LOCKS_COUNT / STRIPES_COUNT> locks_;
+    };
+
+    free_call Stripe &GetStripe (AnyDataId rowId) const;
+
+    free_call static std::size_t GetIndexInStripe (AnyDataId rowId);
+
+    Disco::Context *multithreadingContext_;
+    mutable std::array <Stripe, STRIPES_COUNT> stripes_;
+};
+}
\ No newline at end of file
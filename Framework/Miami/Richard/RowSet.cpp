@@ -0,0 +1,616 @@
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <iterator>
+
+#include <Miami/Richard/RowSet.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+constexpr uint32_t LOW_BITS = 16u;
+
+uint64_t GetKey (AnyDataId rowId)
+{
+    return rowId >> LOW_BITS;
+}
+
+uint16_t GetLow (AnyDataId rowId)
+{
+    return static_cast <uint16_t> (rowId);
+}
+
+uint32_t CountBits (uint64_t word)
+{
+    return static_cast <uint32_t> (std::bitset <64> (word).count ());
+}
+
+/// Returns index of lowest set bit, word must not be zero.
+uint32_t GetLowestBit (uint64_t word)
+{
+    assert (word != 0u);
+    return CountBits ((word & (~word + 1u)) - 1u);
+}
+}
+
+AnyDataId RowSet::Iterator::operator * () const
+{
+    assert (containerIndex_ < set_->containers_.size ());
+    const Container &container = set_->containers_[containerIndex_];
+    return (container.key_ << LOW_BITS) | (IsBitmap (container) ? position_ : container.array_[position_]);
+}
+
+RowSet::Iterator &RowSet::Iterator::operator ++ ()
+{
+    assert (containerIndex_ < set_->containers_.size ());
+    ++position_;
+    SkipAbsent ();
+    return *this;
+}
+
+bool RowSet::Iterator::operator == (const RowSet::Iterator &other) const
+{
+    return set_ == other.set_ && containerIndex_ == other.containerIndex_ && position_ == other.position_;
+}
+
+bool RowSet::Iterator::operator != (const RowSet::Iterator &other) const
+{
+    return !(*this == other);
+}
+
+RowSet::Iterator::Iterator (const RowSet *set, std::size_t containerIndex, uint32_t position)
+    : set_ (set),
+      containerIndex_ (containerIndex),
+      position_ (position)
+{
+    assert (set_);
+    SkipAbsent ();
+}
+
+void RowSet::Iterator::SkipAbsent ()
+{
+    while (containerIndex_ < set_->containers_.size ())
+    {
+        const Container &container = set_->containers_[containerIndex_];
+        if (IsBitmap (container))
+        {
+            // Whole words are skipped, so dense and sparse bitmaps are iterated equally fast.
+            for (uint32_t word = position_ / 64u; word < BITMAP_WORDS; ++word)
+            {
+                uint64_t bits = container.bitmap_[word];
+                if (word == position_ / 64u)
+                {
+                    bits &= ~uint64_t (0u) << (position_ % 64u);
+                }
+
+                if (bits != 0u)
+                {
+                    position_ = word * 64u + GetLowestBit (bits);
+                    return;
+                }
+            }
+        }
+        else if (position_ < container.array_.size ())
+        {
+            return;
+        }
+
+        ++containerIndex_;
+        position_ = 0u;
+    }
+
+    position_ = 0u;
+}
+
+RowSet::RowSet ()
+    : containers_ (),
+      size_ (0u)
+{
+}
+
+bool RowSet::Insert (AnyDataId rowId)
+{
+    const uint64_t key = GetKey (rowId);
+    const uint16_t low = GetLow (rowId);
+    std::size_t index = FindContainer (key);
+
+    if (index == containers_.size () || containers_[index].key_ != key)
+    {
+        containers_.emplace (containers_.begin () + index)->key_ = key;
+    }
+
+    Container &container = containers_[index];
+    if (IsBitmap (container))
+    {
+        uint64_t &word = container.bitmap_[low / 64u];
+        const uint64_t bit = uint64_t (1u) << (low % 64u);
+
+        if (word & bit)
+        {
+            return false;
+        }
+
+        word |= bit;
+    }
+    else
+    {
+        auto iterator = std::lower_bound (container.array_.begin (), container.array_.end (), low);
+        if (iterator != container.array_.end () && *iterator == low)
+        {
+            return false;
+        }
+
+        container.array_.insert (iterator, low);
+    }
+
+    ++container.count_;
+    ++size_;
+
+    if (!IsBitmap (container) && container.count_ > ARRAY_LIMIT)
+    {
+        ConvertToBitmap (container);
+    }
+
+    return true;
+}
+
+bool RowSet::Erase (AnyDataId rowId)
+{
+    const uint64_t key = GetKey (rowId);
+    const uint16_t low = GetLow (rowId);
+    std::size_t index = FindContainer (key);
+
+    if (index == containers_.size () || containers_[index].key_ != key)
+    {
+        return false;
+    }
+
+    Container &container = containers_[index];
+    if (IsBitmap (container))
+    {
+        uint64_t &word = container.bitmap_[low / 64u];
+        const uint64_t bit = uint64_t (1u) << (low % 64u);
+
+        if (!(word & bit))
+        {
+            return false;
+        }
+
+        word &= ~bit;
+    }
+    else
+    {
+        auto iterator = std::lower_bound (container.array_.begin (), container.array_.end (), low);
+        if (iterator == container.array_.end () || *iterator != low)
+        {
+            return false;
+        }
+
+        container.array_.erase (iterator);
+    }
+
+    --container.count_;
+    --size_;
+
+    if (container.count_ == 0u)
+    {
+        containers_.erase (containers_.begin () + index);
+    }
+    else if (IsBitmap (container) && container.count_ <= ARRAY_LIMIT / 2u)
+    {
+        ConvertToArray (container);
+    }
+
+    return true;
+}
+
+void RowSet::InsertMasked (const AnyDataId *rows, std::size_t count, const uint8_t *mask)
+{
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        if (mask[index])
+        {
+            Insert (rows[index]);
+        }
+    }
+}
+
+void RowSet::Clear ()
+{
+    containers_.clear ();
+    size_ = 0u;
+}
+
+bool RowSet::Contains (AnyDataId rowId) const
+{
+    const uint64_t key = GetKey (rowId);
+    std::size_t index = FindContainer (key);
+    return index < containers_.size () && containers_[index].key_ == key &&
+           ContainsLow (containers_[index], GetLow (rowId));
+}
+
+std::size_t RowSet::GetSize () const
+{
+    return size_;
+}
+
+bool RowSet::IsEmpty () const
+{
+    return size_ == 0u;
+}
+
+std::size_t RowSet::Rank (AnyDataId rowId) const
+{
+    const uint64_t key = GetKey (rowId);
+    const uint16_t low = GetLow (rowId);
+    std::size_t rank = 0u;
+
+    for (const Container &container : containers_)
+    {
+        if (container.key_ < key)
+        {
+            rank += container.count_;
+        }
+        else
+        {
+            if (container.key_ == key)
+            {
+                if (IsBitmap (container))
+                {
+                    for (uint32_t word = 0u; word < low / 64u; ++word)
+                    {
+                        rank += CountBits (container.bitmap_[word]);
+                    }
+
+                    rank += CountBits (container.bitmap_[low / 64u] & ((uint64_t (1u) << (low % 64u)) - 1u));
+                }
+                else
+                {
+                    rank += std::lower_bound (container.array_.begin (), container.array_.end (), low) -
+                            container.array_.begin ();
+                }
+            }
+
+            break;
+        }
+    }
+
+    return rank;
+}
+
+bool RowSet::Select (std::size_t position, AnyDataId &output) const
+{
+    for (const Container &container : containers_)
+    {
+        if (position >= container.count_)
+        {
+            position -= container.count_;
+            continue;
+        }
+
+        if (!IsBitmap (container))
+        {
+            output = (container.key_ << LOW_BITS) | container.array_[position];
+            return true;
+        }
+
+        for (uint32_t word = 0u; word < BITMAP_WORDS; ++word)
+        {
+            uint64_t bits = container.bitmap_[word];
+            const uint32_t count = CountBits (bits);
+
+            if (position >= count)
+            {
+                position -= count;
+                continue;
+            }
+
+            while (position--)
+            {
+                // Clears lowest set bit.
+                bits &= bits - 1u;
+            }
+
+            output = (container.key_ << LOW_BITS) | (word * 64u + GetLowestBit (bits));
+            return true;
+        }
+
+        assert (false);
+        return false;
+    }
+
+    return false;
+}
+
+void RowSet::IntersectWith (const RowSet &other)
+{
+    std::size_t otherIndex = 0u;
+    for (Container &container : containers_)
+    {
+        while (otherIndex < other.containers_.size () && other.containers_[otherIndex].key_ < container.key_)
+        {
+            ++otherIndex;
+        }
+
+        if (otherIndex == other.containers_.size () || other.containers_[otherIndex].key_ != container.key_)
+        {
+            container.array_.clear ();
+            container.bitmap_.clear ();
+            container.count_ = 0u;
+            continue;
+        }
+
+        const Container &otherContainer = other.containers_[otherIndex];
+        if (IsBitmap (container) && IsBitmap (otherContainer))
+        {
+            for (uint32_t word = 0u; word < BITMAP_WORDS; ++word)
+            {
+                container.bitmap_[word] &= otherContainer.bitmap_[word];
+            }
+        }
+        else if (IsBitmap (container))
+        {
+            // Result is a subset of sparse container, so it is built from that container.
+            std::vector <uint16_t> result;
+            std::copy_if (otherContainer.array_.begin (), otherContainer.array_.end (), std::back_inserter (result),
+                          [&container] (uint16_t low)
+                          {
+                              return ContainsLow (container, low);
+                          });
+
+            container.bitmap_.clear ();
+            container.array_ = std::move (result);
+        }
+        else
+        {
+            container.array_.erase (
+                std::remove_if (container.array_.begin (), container.array_.end (),
+                                [&otherContainer] (uint16_t low)
+                                {
+                                    return !ContainsLow (otherContainer, low);
+                                }),
+                container.array_.end ());
+        }
+
+        Normalize (container);
+    }
+
+    RemoveEmptyContainers ();
+}
+
+void RowSet::UniteWith (const RowSet &other)
+{
+    std::vector <Container> result;
+    result.reserve (std::max (containers_.size (), other.containers_.size ()));
+
+    std::size_t index = 0u;
+    std::size_t otherIndex = 0u;
+
+    while (index < containers_.size () || otherIndex < other.containers_.size ())
+    {
+        if (otherIndex == other.containers_.size () ||
+            (index < containers_.size () && containers_[index].key_ < other.containers_[otherIndex].key_))
+        {
+            result.emplace_back (std::move (containers_[index++]));
+            continue;
+        }
+
+        if (index == containers_.size () || other.containers_[otherIndex].key_ < containers_[index].key_)
+        {
+            result.emplace_back (other.containers_[otherIndex++]);
+            continue;
+        }
+
+        Container &container = result.emplace_back (std::move (containers_[index++]));
+        const Container &otherContainer = other.containers_[otherIndex++];
+
+        if (!IsBitmap (container) && !IsBitmap (otherContainer))
+        {
+            std::vector <uint16_t> merged;
+            merged.reserve (container.array_.size () + otherContainer.array_.size ());
+            std::set_union (container.array_.begin (), container.array_.end (), otherContainer.array_.begin (),
+                            otherContainer.array_.end (), std::back_inserter (merged));
+            container.array_ = std::move (merged);
+        }
+        else
+        {
+            ConvertToBitmap (container);
+            if (IsBitmap (otherContainer))
+            {
+                for (uint32_t word = 0u; word < BITMAP_WORDS; ++word)
+                {
+                    container.bitmap_[word] |= otherContainer.bitmap_[word];
+                }
+            }
+            else
+            {
+                for (uint16_t low : otherContainer.array_)
+                {
+                    container.bitmap_[low / 64u] |= uint64_t (1u) << (low % 64u);
+                }
+            }
+        }
+
+        Normalize (container);
+    }
+
+    containers_ = std::move (result);
+    RemoveEmptyContainers ();
+}
+
+void RowSet::Subtract (const RowSet &other)
+{
+    std::size_t otherIndex = 0u;
+    for (Container &container : containers_)
+    {
+        while (otherIndex < other.containers_.size () && other.containers_[otherIndex].key_ < container.key_)
+        {
+            ++otherIndex;
+        }
+
+        if (otherIndex == other.containers_.size () || other.containers_[otherIndex].key_ != container.key_)
+        {
+            continue;
+        }
+
+        const Container &otherContainer = other.containers_[otherIndex];
+        if (!IsBitmap (container))
+        {
+            container.array_.erase (
+                std::remove_if (container.array_.begin (), container.array_.end (),
+                                [&otherContainer] (uint16_t low)
+                                {
+                                    return ContainsLow (otherContainer, low);
+                                }),
+                container.array_.end ());
+        }
+        else if (IsBitmap (otherContainer))
+        {
+            for (uint32_t word = 0u; word < BITMAP_WORDS; ++word)
+            {
+                container.bitmap_[word] &= ~otherContainer.bitmap_[word];
+            }
+        }
+        else
+        {
+            for (uint16_t low : otherContainer.array_)
+            {
+                container.bitmap_[low / 64u] &= ~(uint64_t (1u) << (low % 64u));
+            }
+        }
+
+        Normalize (container);
+    }
+
+    RemoveEmptyContainers ();
+}
+
+std::size_t RowSet::GetMemoryUsage () const
+{
+    std::size_t usage = containers_.capacity () * sizeof (Container);
+    for (const Container &container : containers_)
+    {
+        usage += container.array_.capacity () * sizeof (uint16_t) + container.bitmap_.capacity () * sizeof (uint64_t);
+    }
+
+    return usage;
+}
+
+RowSet::Iterator RowSet::begin () const
+{
+    return Iterator (this, 0u, 0u);
+}
+
+RowSet::Iterator RowSet::end () const
+{
+    return Iterator (this, containers_.size (), 0u);
+}
+
+bool RowSet::IsBitmap (const Container &container)
+{
+    return !container.bitmap_.empty ();
+}
+
+bool RowSet::ContainsLow (const Container &container, uint16_t low)
+{
+    if (IsBitmap (container))
+    {
+        return (container.bitmap_[low / 64u] >> (low % 64u)) & 1u;
+    }
+
+    return std::binary_search (container.array_.begin (), container.array_.end (), low);
+}
+
+void RowSet::Normalize (Container &container)
+{
+    if (IsBitmap (container))
+    {
+        container.count_ = 0u;
+        for (uint64_t word : container.bitmap_)
+        {
+            container.count_ += CountBits (word);
+        }
+
+        if (container.count_ <= ARRAY_LIMIT / 2u)
+        {
+            ConvertToArray (container);
+        }
+    }
+    else
+    {
+        container.count_ = static_cast <uint32_t> (container.array_.size ());
+        if (container.count_ > ARRAY_LIMIT)
+        {
+            ConvertToBitmap (container);
+        }
+    }
+}
+
+void RowSet::ConvertToBitmap (Container &container)
+{
+    if (IsBitmap (container))
+    {
+        return;
+    }
+
+    container.bitmap_.assign (BITMAP_WORDS, 0u);
+    for (uint16_t low : container.array_)
+    {
+        container.bitmap_[low / 64u] |= uint64_t (1u) << (low % 64u);
+    }
+
+    container.array_.clear ();
+    container.array_.shrink_to_fit ();
+}
+
+void RowSet::ConvertToArray (Container &container)
+{
+    assert (IsBitmap (container));
+    container.array_.clear ();
+    container.array_.reserve (container.count_);
+
+    for (uint32_t word = 0u; word < BITMAP_WORDS; ++word)
+    {
+        uint64_t bits = container.bitmap_[word];
+        while (bits != 0u)
+        {
+            container.array_.emplace_back (static_cast <uint16_t> (word * 64u + GetLowestBit (bits)));
+            bits &= bits - 1u;
+        }
+    }
+
+    container.bitmap_.clear ();
+    container.bitmap_.shrink_to_fit ();
+}
+
+std::size_t RowSet::FindContainer (uint64_t key) const
+{
+    // Ids are allocated sequentially, so the last container is the most probable target.
+    if (!containers_.empty () && containers_.back ().key_ == key)
+    {
+        return containers_.size () - 1u;
+    }
+
+    return std::lower_bound (containers_.begin (), containers_.end (), key,
+                             [] (const Container &container, uint64_t key)
+                             {
+                                 return container.key_ < key;
+                             }) - containers_.begin ();
+}
+
+void RowSet::RemoveEmptyContainers ()
+{
+    containers_.erase (std::remove_if (containers_.begin (), containers_.end (),
+                                       [] (const Container &container)
+                                       {
+                                           return container.count_ == 0u;
+                                       }), containers_.end ());
+
+    size_ = 0u;
+    for (const Container &container : containers_)
+    {
+        size_ += container.count_;
+    }
+}
+}
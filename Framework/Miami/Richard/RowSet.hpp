@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/Data.hpp>
+
+namespace Miami::Richard
+{
+/// Compressed set of row ids in roaring bitmap style. Ids are split into containers by their high bits. Sparse
+/// containers store sorted low bits of ids, dense containers store bitmap of all possible low bits. Row ids are
+/// allocated sequentially, so live rows of a table usually cost a few bits per row.
+class RowSet final
+{
+public:
+    /// Count of ids, covered by one container.
+    static constexpr uint32_t CONTAINER_CAPACITY = 65536u;
+
+    /// Sparse container is converted to bitmap when it exceeds this count. Bitmap is converted back
+    /// when its count drops to a half of this limit, so alternating changes do not convert it every time.
+    static constexpr uint32_t ARRAY_LIMIT = 4096u;
+
+    /// Iterates over ids in ascending order.
+    class Iterator final
+    {
+    public:
+        free_call AnyDataId operator * () const;
+
+        Iterator &operator ++ ();
+
+        free_call bool operator == (const Iterator &other) const;
+
+        free_call bool operator != (const Iterator &other) const;
+
+    private:
+        Iterator (const RowSet *set, std::size_t containerIndex, uint32_t position);
+
+        /// Moves to first present id, that is not less than current position.
+        void SkipAbsent ();
+
+        const RowSet *set_;
+        std::size_t containerIndex_;
+
+        /// Index in array for sparse containers and low bits of id for bitmap containers.
+        uint32_t position_;
+
+        friend class RowSet;
+    };
+
+    RowSet ();
+
+    /// Returns false if id is already present.
+    bool Insert (AnyDataId rowId);
+
+    /// Returns false if there is no such id.
+    bool Erase (AnyDataId rowId);
+
+    /// Inserts rows, which mask values are not zero. Mask has the same format as predicate evaluation results.
+    void InsertMasked (const AnyDataId *rows, std::size_t count, const uint8_t *mask);
+
+    void Clear ();
+
+    free_call bool Contains (AnyDataId rowId) const;
+
+    free_call std::size_t GetSize () const;
+
+    free_call bool IsEmpty () const;
+
+    /// Returns count of ids, that are less than given one.
+    free_call std::size_t Rank (AnyDataId rowId) const;
+
+    /// Finds id with given position in ascending order. Returns false if position is out of bounds.
+    free_call bool Select (std::size_t position, AnyDataId &output) const;
+
+    void IntersectWith (const RowSet &other);
+
+    void UniteWith (const RowSet &other);
+
+    void Subtract (const RowSet &other);
+
+    /// Returns count of bytes, used by containers.
+    free_call std::size_t GetMemoryUsage () const;
+
+    free_call Iterator begin () const;
+
+    free_call Iterator end () const;
+
+private:
+    struct Container
+    {
+        uint64_t key_ = 0u;
+        uint32_t count_ = 0u;
+
+        /// Sorted low bits of ids. Used only if bitmap is empty.
+        std::vector <uint16_t> array_ {};
+        std::vector <uint64_t> bitmap_ {};
+    };
+
+    static constexpr uint32_t BITMAP_WORDS = CONTAINER_CAPACITY / 64u;
+
+    free_call static bool IsBitmap (const Container &container);
+
+    free_call static bool ContainsLow (const Container &container, uint16_t low);
+
+    /// Recalculates count of bitmap container and converts container to the most suitable representation.
+    static void Normalize (Container &container);
+
+    static void ConvertToBitmap (Container &container);
+
+    static void ConvertToArray (Container &container);
+
+    /// Returns index of container with given key or index, where such container should be inserted.
+    free_call std::size_t FindContainer (uint64_t key) const;
+
+    /// Removes containers without ids and recalculates total size.
+    void RemoveEmptyContainers ();
+
+    std::vector <Container> containers_;
+    std::size_t size_;
+};
+}
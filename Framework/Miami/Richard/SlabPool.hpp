@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+namespace Miami::Richard
+{
+/// Pool of fixed size memory blocks, that are cut from big slabs. Every thread has its own cache of free
+/// blocks, therefore shared state is accessed only when cache is empty or overfilled and blocks are
+/// transferred in batches. Slabs, all blocks of which are in shared free list, are returned to system by ::Trim,
+/// that is also called automatically when shared free list grows twice since previous trim.
+template <std::size_t blockSize>
+class SlabPool final
+{
+public:
+    static constexpr std::size_t SLAB_SIZE = 256u * 1024u;
+    static constexpr std::size_t BLOCKS_PER_SLAB = std::max <std::size_t> (1u, SLAB_SIZE / blockSize);
+    static constexpr std::size_t CACHE_CAPACITY = std::max <std::size_t> (2u, BLOCKS_PER_SLAB);
+
+    /// Pool is never destructed, because blocks could be released from destructors of static objects.
+    static SlabPool &Instance ()
+    {
+        static auto *instance = new SlabPool ();
+        return *instance;
+    }
+
+    free_call void *Acquire ()
+    {
+        ThreadCache &cache = GetThreadCache ();
+        if (!cache.head_)
+        {
+            Refill (cache);
+        }
+
+        FreeBlock *block = cache.head_;
+        assert (block);
+        cache.head_ = block->next_;
+        --cache.count_;
+        return block;
+    }
+
+    void Release (void *block)
+    {
+        assert (block);
+        ThreadCache &cache = GetThreadCache ();
+        auto *freeBlock = static_cast <FreeBlock *> (block);
+        freeBlock->next_ = cache.head_;
+        cache.head_ = freeBlock;
+
+        if (++cache.count_ > CACHE_CAPACITY)
+        {
+            Drain (cache, CACHE_CAPACITY / 2u);
+        }
+    }
+
+    /// Moves blocks from cache of calling thread to shared free list and frees slabs, all blocks of which are free.
+    /// Blocks, that are cached by other threads, keep their slabs alive.
+    void Trim ()
+    {
+        ThreadCache &cache = GetThreadCache ();
+        Drain (cache, cache.count_);
+
+        std::unique_lock <std::mutex> lock (mutex_);
+        TrimLocked ();
+    }
+
+    /// Returns count of blocks, that were cut from slabs. Used for diagnostics only.
+    free_call std::size_t GetCapacity () const
+    {
+        std::unique_lock <std::mutex> lock (mutex_);
+        return slabs_.size () * BLOCKS_PER_SLAB;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next_;
+    };
+
+    static_assert (blockSize >= sizeof (FreeBlock));
+    static_assert (blockSize % alignof (FreeBlock) == 0u);
+
+    struct ThreadCache
+    {
+        ~ThreadCache ()
+        {
+            SlabPool::Instance ().Drain (*this, count_);
+        }
+
+        FreeBlock *head_ = nullptr;
+        std::size_t count_ = 0u;
+    };
+
+    SlabPool () = default;
+
+    static ThreadCache &GetThreadCache ()
+    {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    void Refill (ThreadCache &cache)
+    {
+        std::unique_lock <std::mutex> lock (mutex_);
+        if (!freeBlocks_)
+        {
+            AllocateSlab ();
+        }
+
+        // Take half of cache capacity at once, so next acquisitions will not lock the mutex.
+        while (freeBlocks_ && cache.count_ < CACHE_CAPACITY / 2u)
+        {
+            FreeBlock *block = freeBlocks_;
+            freeBlocks_ = block->next_;
+            block->next_ = cache.head_;
+            cache.head_ = block;
+            ++cache.count_;
+            --freeCount_;
+        }
+    }
+
+    void Drain (ThreadCache &cache, std::size_t count)
+    {
+        std::unique_lock <std::mutex> lock (mutex_);
+        while (count-- && cache.head_)
+        {
+            FreeBlock *block = cache.head_;
+            cache.head_ = block->next_;
+            block->next_ = freeBlocks_;
+            freeBlocks_ = block;
+            --cache.count_;
+            ++freeCount_;
+        }
+
+        if (freeCount_ >= trimThreshold_)
+        {
+            TrimLocked ();
+        }
+    }
+
+    void TrimLocked ()
+    {
+        // Slabs are sorted by address, so owner of every free block is found by binary search.
+        std::sort (slabs_.begin (), slabs_.end ());
+        std::vector <std::size_t> freeInSlab (slabs_.size (), 0u);
+
+        for (FreeBlock *block = freeBlocks_; block; block = block->next_)
+        {
+            ++freeInSlab[FindSlab (block)];
+        }
+
+        FreeBlock *keptBlocks = nullptr;
+        while (freeBlocks_)
+        {
+            FreeBlock *block = freeBlocks_;
+            freeBlocks_ = block->next_;
+
+            if (freeInSlab[FindSlab (block)] == BLOCKS_PER_SLAB)
+            {
+                --freeCount_;
+            }
+            else
+            {
+                block->next_ = keptBlocks;
+                keptBlocks = block;
+            }
+        }
+
+        freeBlocks_ = keptBlocks;
+        std::size_t keptSlabs = 0u;
+
+        for (std::size_t index = 0u; index < slabs_.size (); ++index)
+        {
+            if (freeInSlab[index] != BLOCKS_PER_SLAB)
+            {
+                slabs_[keptSlabs++] = std::move (slabs_[index]);
+            }
+        }
+
+        slabs_.resize (keptSlabs);
+        trimThreshold_ = std::max (2u * freeCount_, MIN_TRIM_THRESHOLD);
+    }
+
+    std::size_t FindSlab (const FreeBlock *block) const
+    {
+        auto iterator = std::upper_bound (
+            slabs_.begin (), slabs_.end (), reinterpret_cast <const uint8_t *> (block),
+            [] (const uint8_t *address, const std::unique_ptr <uint8_t[]> &slab)
+            {
+                return std::less <const uint8_t *> () (address, slab.get ());
+            });
+
+        assert (iterator != slabs_.begin ());
+        return iterator - slabs_.begin () - 1u;
+    }
+
+    void AllocateSlab ()
+    {
+        uint8_t *slab = slabs_.emplace_back (new uint8_t[BLOCKS_PER_SLAB * blockSize]).get ();
+        for (std::size_t index = BLOCKS_PER_SLAB; index > 0u; --index)
+        {
+            auto *block = reinterpret_cast <FreeBlock *> (slab + (index - 1u) * blockSize);
+            block->next_ = freeBlocks_;
+            freeBlocks_ = block;
+        }
+
+        freeCount_ += BLOCKS_PER_SLAB;
+    }
+
+    static constexpr std::size_t MIN_TRIM_THRESHOLD = 4u * BLOCKS_PER_SLAB;
+
+    mutable std::mutex mutex_;
+    FreeBlock *freeBlocks_ = nullptr;
+    std::size_t freeCount_ = 0u;
+    std::size_t trimThreshold_ = MIN_TRIM_THRESHOLD;
+
+    std::vector <std::unique_ptr <uint8_t[]>> slabs_;
+};
+
+/// Deleter for objects, that were allocated by ::MakeSlabUnique.
+template <typename Type>
+struct SlabDeleter
+{
+    void operator () (Type *value) const
+    {
+        value->~Type ();
+        SlabPool <sizeof (Type)>::Instance ().Release (value);
+    }
+};
+
+template <typename Type>
+using SlabUniquePointer = std::unique_ptr <Type, SlabDeleter <Type>>;
+
+template <typename Type>
+SlabUniquePointer <Type> MakeSlabUnique ()
+{
+    return SlabUniquePointer <Type> (new (SlabPool <sizeof (Type)>::Instance ().Acquire ()) Type ());
+}
+}
@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Richard/Sorting.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+bool WriteRow (std::FILE *file, const QueryBatch &batch, std::size_t row)
+{
+    for (std::size_t index = row * batch.columnsCount_; index < (row + 1u) * batch.columnsCount_; ++index)
+    {
+        const uint8_t isNull = batch.nulls_[index];
+        if (std::fwrite (&isNull, sizeof (isNull), 1u, file) != 1u)
+        {
+            return false;
+        }
+
+        if (!isNull)
+        {
+            const AnyDataContainer &value = batch.values_[index];
+            const DataType type = value.GetType ();
+            const uint32_t size = value.GetDataSize ();
+
+            if (std::fwrite (&type, sizeof (type), 1u, file) != 1u ||
+                std::fwrite (&size, sizeof (size), 1u, file) != 1u ||
+                (size > 0u && std::fwrite (value.GetDataStartPointer (), size, 1u, file) != 1u))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ReadRows (std::FILE *file, uint64_t rowsCount, QueryBatch &output)
+{
+    for (uint64_t index = 0u; index < rowsCount * output.columnsCount_; ++index)
+    {
+        uint8_t isNull;
+        if (std::fread (&isNull, sizeof (isNull), 1u, file) != 1u)
+        {
+            return false;
+        }
+
+        if (isNull)
+        {
+            output.values_.emplace_back ();
+            output.nulls_.emplace_back (1u);
+            continue;
+        }
+
+        DataType type;
+        uint32_t size;
+
+        if (std::fread (&type, sizeof (type), 1u, file) != 1u || std::fread (&size, sizeof (size), 1u, file) != 1u)
+        {
+            return false;
+        }
+
+        AnyDataContainer value (type);
+        if (IsVariableSizeDataType (type))
+        {
+            value.ResizeData (size);
+        }
+        else if (size != value.GetDataSize ())
+        {
+            return false;
+        }
+
+        if (size > 0u && std::fread (value.GetDataStartPointer (), size, 1u, file) != 1u)
+        {
+            return false;
+        }
+
+        output.values_.emplace_back (std::move (value));
+        output.nulls_.emplace_back (0u);
+    }
+
+    return true;
+}
+}
+
+QuerySorter::QuerySorter (const std::vector <QueryOrder> &order, std::size_t columnsCount, uint64_t rowsNeeded,
+                          uint64_t memoryBudget, Disco::Context *workers)
+    : order_ (order),
+      columnsCount_ (columnsCount),
+      rowsNeeded_ (rowsNeeded),
+      memoryBudget_ (memoryBudget),
+      workers_ (workers),
+      runs_ (),
+      runsRowsCount_ (0u),
+      runsSize_ (0u),
+      spilledRuns_ (),
+      isSpillBroken_ (false)
+{
+    assert (columnsCount_ > 0u);
+}
+
+QuerySorter::~QuerySorter ()
+{
+    for (SpilledRun &run : spilledRuns_)
+    {
+        std::fclose (run.file_);
+    }
+}
+
+void QuerySorter::Add (std::vector <QueryBatch> &batches)
+{
+    std::vector <QueryBatch> parts;
+    for (QueryBatch &batch : batches)
+    {
+        const std::size_t rowsCount = batch.GetRowsCount ();
+        if (rowsCount <= MAX_RUN_SIZE)
+        {
+            if (rowsCount > 0u)
+            {
+                parts.emplace_back (std::move (batch));
+            }
+
+            continue;
+        }
+
+        for (std::size_t begin = 0u; begin < rowsCount; begin += MAX_RUN_SIZE)
+        {
+            QueryBatch &part = parts.emplace_back ();
+            part.columnsCount_ = columnsCount_;
+            batch.MoveRowsTo (begin, std::min (MAX_RUN_SIZE, rowsCount - begin), part);
+        }
+    }
+
+    batches.clear ();
+    auto sort = [this, &parts] (std::size_t index)
+    {
+        SortRun (parts[index]);
+    };
+
+    if (workers_ && parts.size () > 1u)
+    {
+        Disco::ParallelFor (workers_, parts.size (), sort);
+    }
+    else
+    {
+        for (std::size_t index = 0u; index < parts.size (); ++index)
+        {
+            sort (index);
+        }
+    }
+
+    for (QueryBatch &part : parts)
+    {
+        runsRowsCount_ += part.GetRowsCount ();
+        runsSize_ += EstimateSize (part);
+        runs_.emplace_back (std::move (part));
+    }
+
+    // Top-K runs are merged as soon as they contain twice more rows than needed, so memory usage depends on K.
+    if (runs_.size () > 1u && runsRowsCount_ / 2u > rowsNeeded_)
+    {
+        Compact ();
+    }
+
+    if (runsSize_ > memoryBudget_ && !runs_.empty () && !isSpillBroken_ && !Spill ())
+    {
+        // Query could still be finished in memory, so spilling is just disabled.
+        isSpillBroken_ = true;
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR,
+                                  "Unable to spill sorted rows to temporary file, sort memory budget is ignored.");
+    }
+}
+
+void QuerySorter::Finish (std::size_t batchSize, const std::function <bool (QueryBatch &)> &output)
+{
+    assert (batchSize > 0u);
+    std::vector <MergeSource> sources;
+    sources.reserve (spilledRuns_.size () + runs_.size ());
+
+    for (SpilledRun &run : spilledRuns_)
+    {
+        AddSpilledSource (run, sources);
+    }
+
+    for (QueryBatch &run : runs_)
+    {
+        sources.emplace_back (MergeSource {&run, 0u, nullptr, 0u, {}});
+    }
+
+    QueryBatch batch;
+    batch.columnsCount_ = columnsCount_;
+    bool isStopped = false;
+
+    Merge (sources,
+           [&batch, &output, &isStopped, batchSize] (QueryBatch &source, std::size_t row)
+           {
+               source.MoveRowsTo (row, 1u, batch);
+               if (batch.GetRowsCount () == batchSize)
+               {
+                   if (!output (batch))
+                   {
+                       isStopped = true;
+                       return false;
+                   }
+
+                   batch.values_.clear ();
+                   batch.nulls_.clear ();
+               }
+
+               return true;
+           });
+
+    if (!isStopped && batch.GetRowsCount () > 0u)
+    {
+        output (batch);
+    }
+}
+
+std::size_t QuerySorter::GetSpilledRunsCount () const
+{
+    return spilledRuns_.size ();
+}
+
+bool QuerySorter::Less (const QueryBatch &first, std::size_t firstRow,
+                        const QueryBatch &second, std::size_t secondRow) const
+{
+    for (const QueryOrder &order : order_)
+    {
+        const std::size_t firstIndex = firstRow * columnsCount_ + order.outputColumn_;
+        const std::size_t secondIndex = secondRow * columnsCount_ + order.outputColumn_;
+
+        // Nulls are less than any value, like in indices.
+        const bool firstIsNull = first.nulls_[firstIndex];
+        const bool secondIsNull = second.nulls_[secondIndex];
+
+        const bool firstLess = firstIsNull ? !secondIsNull :
+                               !secondIsNull && first.values_[firstIndex] < second.values_[secondIndex];
+
+        const bool secondLess = secondIsNull ? !firstIsNull :
+                                !firstIsNull && second.values_[secondIndex] < first.values_[firstIndex];
+
+        if (firstLess != secondLess)
+        {
+            return order.descending_ ? secondLess : firstLess;
+        }
+    }
+
+    return false;
+}
+
+void QuerySorter::SortRun (QueryBatch &batch) const
+{
+    const std::size_t rowsCount = batch.GetRowsCount ();
+    const auto keep = static_cast <std::size_t> (std::min <uint64_t> (rowsCount, rowsNeeded_));
+
+    if (order_.empty ())
+    {
+        batch.values_.erase (batch.values_.begin () + keep * columnsCount_, batch.values_.end ());
+        batch.nulls_.resize (keep * columnsCount_);
+        return;
+    }
+
+    std::vector <std::size_t> permutation (rowsCount);
+    std::iota (permutation.begin (), permutation.end (), 0u);
+
+    // Ties are broken by row index, so heap selection keeps the same rows, as stable sort would keep.
+    auto less = [this, &batch] (std::size_t first, std::size_t second)
+    {
+        if (Less (batch, first, batch, second))
+        {
+            return true;
+        }
+
+        return !Less (batch, second, batch, first) && first < second;
+    };
+
+    if (keep < rowsCount)
+    {
+        std::partial_sort (permutation.begin (), permutation.begin () + keep, permutation.end (), less);
+    }
+    else
+    {
+        std::sort (permutation.begin (), permutation.end (), less);
+    }
+
+    QueryBatch sorted;
+    sorted.columnsCount_ = columnsCount_;
+    sorted.values_.reserve (keep * columnsCount_);
+    sorted.nulls_.reserve (keep * columnsCount_);
+
+    for (std::size_t index = 0u; index < keep; ++index)
+    {
+        batch.MoveRowsTo (permutation[index], 1u, sorted);
+    }
+
+    batch = std::move (sorted);
+}
+
+void QuerySorter::Compact ()
+{
+    std::vector <MergeSource> sources;
+    sources.reserve (runs_.size ());
+
+    for (QueryBatch &run : runs_)
+    {
+        sources.emplace_back (MergeSource {&run, 0u, nullptr, 0u, {}});
+    }
+
+    QueryBatch merged;
+    merged.columnsCount_ = columnsCount_;
+
+    Merge (sources,
+           [&merged] (QueryBatch &source, std::size_t row)
+           {
+               source.MoveRowsTo (row, 1u, merged);
+               return true;
+           });
+
+    runs_.clear ();
+    runsRowsCount_ = merged.GetRowsCount ();
+    runsSize_ = EstimateSize (merged);
+    runs_.emplace_back (std::move (merged));
+}
+
+bool QuerySorter::Spill ()
+{
+    std::vector <MergeSource> sources;
+    sources.reserve (runs_.size ());
+
+    for (QueryBatch &run : runs_)
+    {
+        sources.emplace_back (MergeSource {&run, 0u, nullptr, 0u, {}});
+    }
+
+    // Rows are only copied to file, so runs are still valid if writing fails.
+    uint64_t rowsCount = 0u;
+    std::FILE *file = WriteRun (sources, rowsCount);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    spilledRuns_.emplace_back (SpilledRun {file, rowsCount, 0u});
+    runs_.clear ();
+    runsRowsCount_ = 0u;
+    runsSize_ = 0u;
+
+    MergeSpilledRuns ();
+    return true;
+}
+
+void QuerySorter::MergeSpilledRuns ()
+{
+    while (spilledRuns_.size () >= SPILL_MERGE_FAN_IN)
+    {
+        const auto first = spilledRuns_.end () - SPILL_MERGE_FAN_IN;
+        const std::size_t level = first->level_;
+
+        if (!std::all_of (first, spilledRuns_.end (),
+                          [level] (const SpilledRun &run)
+                          {
+                              return run.level_ == level;
+                          }))
+        {
+            return;
+        }
+
+        // Merged runs are the last ones, so rows with equal keys still follow each other in order of addition.
+        std::vector <MergeSource> sources;
+        sources.reserve (SPILL_MERGE_FAN_IN);
+
+        for (auto run = first; run != spilledRuns_.end (); ++run)
+        {
+            AddSpilledSource (*run, sources);
+        }
+
+        uint64_t rowsCount = 0u;
+        std::FILE *file = WriteRun (sources, rowsCount);
+
+        if (!file)
+        {
+            // Merged runs are only read, so they are still valid and will be rewound by the final merge.
+            Evan::Logger::Get ().Log (Evan::LogLevel::WARNING,
+                                      "Unable to merge spilled sorted runs, they are kept as separate files.");
+            return;
+        }
+
+        for (auto run = first; run != spilledRuns_.end (); ++run)
+        {
+            std::fclose (run->file_);
+        }
+
+        spilledRuns_.erase (first, spilledRuns_.end ());
+        spilledRuns_.emplace_back (SpilledRun {file, rowsCount, level + 1u});
+    }
+}
+
+void QuerySorter::AddSpilledSource (SpilledRun &run, std::vector <MergeSource> &sources) const
+{
+    assert (sources.size () < sources.capacity ());
+    std::rewind (run.file_);
+
+    MergeSource &source = sources.emplace_back (MergeSource {nullptr, 0u, &run, run.rowsCount_, {}});
+    source.rows_ = &source.buffer_;
+    source.buffer_.columnsCount_ = columnsCount_;
+
+    // Position is moved before the first row, so advance reads the first part of run.
+    source.position_ = std::numeric_limits <std::size_t>::max ();
+    Advance (source);
+}
+
+std::FILE *QuerySorter::WriteRun (std::vector <MergeSource> &sources, uint64_t &rowsCount)
+{
+    // Temporary file is removed by system as soon as it is closed, even if server crashes.
+    std::FILE *file = std::tmpfile ();
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    bool isWritten = true;
+    Merge (sources,
+           [file, &rowsCount, &isWritten] (QueryBatch &source, std::size_t row)
+           {
+               isWritten = WriteRow (file, source, row);
+               rowsCount += isWritten;
+               return isWritten;
+           });
+
+    if (!isWritten || std::fflush (file) != 0)
+    {
+        std::fclose (file);
+        return nullptr;
+    }
+
+    return file;
+}
+
+void QuerySorter::Merge (std::vector <MergeSource> &sources,
+                         const std::function <bool (QueryBatch &, std::size_t)> &sink)
+{
+    // Heap top is the smallest row. Equal rows are taken from earlier sources first, so merge is stable.
+    auto greater = [this, &sources] (std::size_t first, std::size_t second)
+    {
+        const MergeSource &firstSource = sources[first];
+        const MergeSource &secondSource = sources[second];
+
+        if (Less (*secondSource.rows_, secondSource.position_, *firstSource.rows_, firstSource.position_))
+        {
+            return true;
+        }
+
+        return !Less (*firstSource.rows_, firstSource.position_, *secondSource.rows_, secondSource.position_) &&
+               first > second;
+    };
+
+    std::vector <std::size_t> heap;
+    for (std::size_t index = 0u; index < sources.size (); ++index)
+    {
+        if (sources[index].position_ < sources[index].rows_->GetRowsCount ())
+        {
+            heap.emplace_back (index);
+        }
+    }
+
+    std::make_heap (heap.begin (), heap.end (), greater);
+    uint64_t mergedCount = 0u;
+
+    while (!heap.empty () && mergedCount < rowsNeeded_)
+    {
+        std::pop_heap (heap.begin (), heap.end (), greater);
+        MergeSource &source = sources[heap.back ()];
+
+        if (!sink (*source.rows_, source.position_))
+        {
+            return;
+        }
+
+        ++mergedCount;
+        if (Advance (source))
+        {
+            std::push_heap (heap.begin (), heap.end (), greater);
+        }
+        else
+        {
+            heap.pop_back ();
+        }
+    }
+}
+
+bool QuerySorter::Advance (MergeSource &source) const
+{
+    ++source.position_;
+    if (source.position_ < source.rows_->GetRowsCount ())
+    {
+        return true;
+    }
+
+    if (!source.spilled_ || source.spilledRowsLeft_ == 0u)
+    {
+        return false;
+    }
+
+    const uint64_t rowsCount = std::min <uint64_t> (SPILL_READ_ROWS, source.spilledRowsLeft_);
+    source.buffer_.values_.clear ();
+    source.buffer_.nulls_.clear ();
+    source.position_ = 0u;
+
+    if (!ReadRows (source.spilled_->file_, rowsCount, source.buffer_))
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to read sorted rows from temporary file!");
+        assert (false);
+
+        source.spilledRowsLeft_ = 0u;
+        return false;
+    }
+
+    source.spilledRowsLeft_ -= rowsCount;
+    return true;
+}
+
+uint64_t QuerySorter::EstimateSize (const QueryBatch &batch)
+{
+    uint64_t size = batch.nulls_.size () * (sizeof (AnyDataContainer) + sizeof (uint8_t));
+    for (const AnyDataContainer &value : batch.values_)
+    {
+        size += value.GetDataSize ();
+    }
+
+    return size;
+}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Context.hpp>
+
+#include <Miami/Richard/Query.hpp>
+
+namespace Miami::Richard
+{
+/// Sorts query output rows. Added batches are sorted in parallel and become sorted runs. If only first rows are
+/// needed, runs are selected by heap and truncated to these rows, so top-K queries keep only K rows per run.
+/// Runs, that exceed memory budget, are merged and spilled to temporary files. Spilled runs are merged level by
+/// level, so count of open temporary files stays small. Output is produced by k-way merge of all runs. Sort is stable: rows with equal keys keep order, in which they were added.
+class QuerySorter final
+{
+public:
+    /// Count of rows, that are read from spilled run at once during merge.
+    static constexpr std::size_t SPILL_READ_ROWS = 256u;
+
+    /// Count of spilled runs of the same level, that are merged into one run of the next level.
+    static constexpr std::size_t SPILL_MERGE_FAN_IN = 8u;
+
+    /// Added batches, that are bigger than this count of rows, are split, so their parts are sorted in parallel.
+    static constexpr std::size_t MAX_RUN_SIZE = QueryExecutor::MORSEL_SIZE;
+
+    QuerySorter (const std::vector <QueryOrder> &order, std::size_t columnsCount, uint64_t rowsNeeded,
+                 uint64_t memoryBudget, Disco::Context *workers);
+
+    QuerySorter (const QuerySorter &another) = delete;
+
+    QuerySorter (QuerySorter &&another) = delete;
+
+    /// Closes spilled runs, their temporary files are removed by system.
+    ~QuerySorter ();
+
+    /// Sorts given batches and adds them as runs. Batches are consumed.
+    void Add (std::vector <QueryBatch> &batches);
+
+    /// Merges all runs and passes first needed rows to output in batches of given size. Stops if output returns false.
+    void Finish (std::size_t batchSize, const std::function <bool (QueryBatch &)> &output);
+
+    free_call std::size_t GetSpilledRunsCount () const;
+
+private:
+    struct SpilledRun
+    {
+        std::FILE *file_;
+        uint64_t rowsCount_;
+
+        /// Count of spilled run merges, that produced this run.
+        std::size_t level_;
+    };
+
+    /// Current row of run during merge. Rows of spilled runs are read into ::buffer_ part by part.
+    struct MergeSource
+    {
+        QueryBatch *rows_;
+        std::size_t position_;
+        SpilledRun *spilled_;
+        uint64_t spilledRowsLeft_;
+        QueryBatch buffer_;
+    };
+
+    free_call bool Less (const QueryBatch &first, std::size_t firstRow,
+                         const QueryBatch &second, std::size_t secondRow) const;
+
+    /// Reorders rows of given batch and truncates it to needed rows.
+    void SortRun (QueryBatch &batch) const;
+
+    /// Merges in-memory runs into one run, that contains only needed rows.
+    void Compact ();
+
+    /// Merges in-memory runs into temporary file. Returns false if file could not be written.
+    bool Spill ();
+
+    /// Merges last spilled runs while there are ::SPILL_MERGE_FAN_IN runs of the same level at the end.
+    void MergeSpilledRuns ();
+
+    /// Rewinds spilled run and adds it to sources, that must be reserved, because source references its buffer.
+    void AddSpilledSource (SpilledRun &run, std::vector <MergeSource> &sources) const;
+
+    /// Merges given sources into new temporary file. Returns nullptr if file could not be written.
+    std::FILE *WriteRun (std::vector <MergeSource> &sources, uint64_t &rowsCount);
+
+    /// Passes needed rows of given sources in sorted order to sink, that receives batch and row. Stops if sink
+    /// returns false.
+    void Merge (std::vector <MergeSource> &sources, const std::function <bool (QueryBatch &, std::size_t)> &sink);
+
+    /// Moves to the next row of source. Returns false if source is exhausted.
+    bool Advance (MergeSource &source) const;
+
+    free_call static uint64_t EstimateSize (const QueryBatch &batch);
+
+    const std::vector <QueryOrder> &order_;
+    std::size_t columnsCount_;
+    uint64_t rowsNeeded_;
+    uint64_t memoryBudget_;
+    Disco::Context *workers_;
+
+    std::vector <QueryBatch> runs_;
+    uint64_t runsRowsCount_;
+    uint64_t runsSize_;
+
+    std::vector <SpilledRun> spilledRuns_;
+    bool isSpillBroken_;
+};
+}
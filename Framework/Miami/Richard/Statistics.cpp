@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string_view>
+
+#include <Miami/Richard/Statistics.hpp>
+
+namespace Miami::Richard
+{
+namespace
+{
+uint64_t HashValue (const AnyDataContainer &value)
+{
+    // Standard hash of bytes is not guaranteed to be well mixed, but sketch uses its bits directly.
+    uint64_t hash = std::hash <std::string_view> () (
+        std::string_view (static_cast <const char *> (value.GetDataStartPointer ()), value.GetDataSize ()));
+
+    hash ^= hash >> 30u;
+    hash *= 0xbf58476d1ce4e5b9u;
+    hash ^= hash >> 27u;
+    hash *= 0x94d049bb133111ebu;
+    return hash ^ (hash >> 31u);
+}
+}
+
+DistinctCounter::DistinctCounter ()
+    : registers_ ()
+{
+    Clear ();
+}
+
+void DistinctCounter::Add (const AnyDataContainer &value)
+{
+    const uint64_t hash = HashValue (value);
+    const auto index = static_cast <uint32_t> (hash >> (64u - PRECISION));
+
+    // Guard bit limits rank, so it is never bigger than count of remaining bits plus one.
+    uint64_t remaining = (hash << PRECISION) | (uint64_t (1u) << (PRECISION - 1u));
+    uint8_t rank = 1u;
+
+    while (!(remaining & (uint64_t (1u) << 63u)))
+    {
+        remaining <<= 1u;
+        ++rank;
+    }
+
+    registers_[index] = std::max (registers_[index], rank);
+}
+
+uint64_t DistinctCounter::Estimate () const
+{
+    constexpr double registersCount = REGISTERS_COUNT;
+    double sum = 0.0;
+    uint32_t zeros = 0u;
+
+    for (uint8_t value : registers_)
+    {
+        sum += std::ldexp (1.0, -value);
+        zeros += value == 0u;
+    }
+
+    const double alpha = 0.7213 / (1.0 + 1.079 / registersCount);
+    double estimate = alpha * registersCount * registersCount / sum;
+
+    // Linear counting is more precise for small cardinalities.
+    if (estimate <= 2.5 * registersCount && zeros > 0u)
+    {
+        estimate = registersCount * std::log (registersCount / zeros);
+    }
+
+    return static_cast <uint64_t> (std::llround (estimate));
+}
+
+void DistinctCounter::Clear ()
+{
+    registers_.fill (0u);
+}
+
+uint64_t EstimateLessCount (const ColumnStatistics &statistics, const AnyDataContainer &value)
+{
+    const auto &bounds = statistics.histogramBounds_;
+    auto iterator = std::lower_bound (bounds.begin (), bounds.end (), value);
+    const auto fullBuckets = static_cast <uint64_t> (std::distance (bounds.begin (), iterator));
+
+    // Values are considered to be uniformly distributed inside bucket, which contains given value.
+    return fullBuckets * statistics.histogramDepth_ +
+           (iterator != bounds.end () ? statistics.histogramDepth_ / 2u : 0u);
+}
+
+ColumnSketch::ColumnSketch ()
+    : distinctCounter_ (),
+      hasLimits_ (false),
+      min_ (),
+      max_ (),
+      histogramDepth_ (0u),
+      histogramBounds_ ()
+{
+
+}
+
+void ColumnSketch::Add (const AnyDataContainer &value)
+{
+    distinctCounter_.Add (value);
+    if (!hasLimits_)
+    {
+        hasLimits_ = true;
+        min_ = AnyDataContainer (value);
+        max_ = AnyDataContainer (value);
+    }
+    else if (value < min_)
+    {
+        min_ = AnyDataContainer (value);
+    }
+    else if (max_ < value)
+    {
+        max_ = AnyDataContainer (value);
+    }
+}
+
+void ColumnSketch::Rebuild (std::vector <AnyDataContainer> &values)
+{
+    std::sort (values.begin (), values.end ());
+    distinctCounter_.Clear ();
+    histogramBounds_.clear ();
+
+    for (const AnyDataContainer &value : values)
+    {
+        distinctCounter_.Add (value);
+    }
+
+    hasLimits_ = !values.empty ();
+    if (!hasLimits_)
+    {
+        min_ = AnyDataContainer ();
+        max_ = AnyDataContainer ();
+        histogramDepth_ = 0u;
+        return;
+    }
+
+    min_ = AnyDataContainer (values.front ());
+    max_ = AnyDataContainer (values.back ());
+    histogramDepth_ = (values.size () + HISTOGRAM_BUCKETS - 1u) / HISTOGRAM_BUCKETS;
+
+    for (std::size_t end = histogramDepth_; end < values.size () + histogramDepth_; end += histogramDepth_)
+    {
+        histogramBounds_.emplace_back (values[std::min (end, values.size ()) - 1u]);
+    }
+}
+
+void ColumnSketch::Fill (ColumnStatistics &output) const
+{
+    output.distinctCount_ = distinctCounter_.Estimate ();
+    output.hasLimits_ = hasLimits_;
+    output.min_ = hasLimits_ ? AnyDataContainer (min_) : AnyDataContainer ();
+    output.max_ = hasLimits_ ? AnyDataContainer (max_) : AnyDataContainer ();
+    output.histogramDepth_ = histogramDepth_;
+
+    output.histogramBounds_.clear ();
+    output.histogramBounds_.reserve (histogramBounds_.size ());
+
+    for (const AnyDataContainer &bound : histogramBounds_)
+    {
+        output.histogramBounds_.emplace_back (bound);
+    }
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Richard/Data.hpp>
+
+namespace Miami::Richard
+{
+/// HyperLogLog sketch, that estimates count of distinct values with about 1.6% standard error. Values could
+/// only be added, therefore sketch overestimates count after deletions until it is rebuilt from scratch.
+class DistinctCounter final
+{
+public:
+    static constexpr uint32_t PRECISION = 12u;
+    static constexpr uint32_t REGISTERS_COUNT = 1u << PRECISION;
+
+    DistinctCounter ();
+
+    void Add (const AnyDataContainer &value);
+
+    free_call uint64_t Estimate () const;
+
+    void Clear ();
+
+private:
+    std::array <uint8_t, REGISTERS_COUNT> registers_;
+};
+
+struct ColumnStatistics
+{
+    AnyDataId columnId_ = 0;
+    uint64_t nullCount_ = 0u;
+
+    /// Exact for dictionary encoded columns, estimated by DistinctCounter for others.
+    uint64_t distinctCount_ = 0u;
+
+    /// Minimum and maximum are widened on writes, but not narrowed on deletions until refresh.
+    /// They are absent if column had no values since last refresh.
+    bool hasLimits_ = false;
+    AnyDataContainer min_;
+    AnyDataContainer max_;
+
+    /// Upper bounds of equi-depth histogram buckets. Every bucket, except maybe the last one,
+    /// contained ::histogramDepth_ non null values at the moment of last refresh.
+    uint64_t histogramDepth_ = 0u;
+    std::vector <AnyDataContainer> histogramBounds_;
+};
+
+struct TableStatistics
+{
+    uint64_t rowCount_ = 0u;
+
+    /// Count of row changes since histograms, limits and distinct counts were rebuilt.
+    uint64_t changesSinceRefresh_ = 0u;
+    std::vector <ColumnStatistics> columns_;
+};
+
+/// Estimates count of non null values, that are less than given one, using histogram of given column.
+free_call uint64_t EstimateLessCount (const ColumnStatistics &statistics, const AnyDataContainer &value);
+
+/// Statistics of column values, that are not exact counters. Values are added on every write and the
+/// whole sketch is rebuilt from column values by table, when enough rows are changed after last rebuild.
+class ColumnSketch final
+{
+public:
+    static constexpr uint32_t HISTOGRAM_BUCKETS = 32u;
+
+    ColumnSketch ();
+
+    void Add (const AnyDataContainer &value);
+
+    /// Rebuilds sketch from all non null values of column. Values are sorted in place.
+    void Rebuild (std::vector <AnyDataContainer> &values);
+
+    /// Fills everything except column id, null count and exact distinct counts.
+    void Fill (ColumnStatistics &output) const;
+
+private:
+    DistinctCounter distinctCounter_;
+    bool hasLimits_;
+    AnyDataContainer min_;
+    AnyDataContainer max_;
+
+    uint64_t histogramDepth_;
+    std::vector <AnyDataContainer> histogramBounds_;
+};
+}
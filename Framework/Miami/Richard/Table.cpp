@@ -1,7 +1,12 @@
+#include <algorithm>
 #include <cassert>
 
 #include <Miami/Evan/Logger.hpp>
 
+#include <Miami/Janitor/FlatHashSet.hpp>
+
+#include <Miami/Richard/Encoding.hpp>
+#include <Miami/Richard/Replication.hpp>
 #include <Miami/Richard/Table.hpp>
 
 namespace Miami::Richard
@@ -11,13 +16,25 @@ Table::Table (Disco::Context *multithreadingContext, AnyDataId id, std::string n
       guard_ (multithreadingContext),
       name_ (std::move (name)),
 
+      rowLocks_ (multithreadingContext),
+      intentLatch_ (),
+
       columns_ (),
       indices_ (),
       rows_ (),
 
       nextColumnId_ (0),
       nextIndexId_ (0),
-      nextRowId_ (0)
+      nextRowId_ (0),
+
+      version_ (0),
+      snapshotsGuard_ (),
+      snapshotVersions_ (),
+      statisticsGuard_ (),
+      statisticsVersion_ (0),
+
+      mutationLog_ (nullptr),
+      pendingMutations_ (nullptr)
 {
 }
 
@@ -61,7 +78,192 @@ ResultCode Table::CreateReadCursor (const std::shared_ptr <Disco::SafeLockGuard>
         return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
     }
 
-    output = new TableReadCursor (this, iterator->second.OpenCursor ());
+    IndexCursor *indexCursor = iterator->second->OpenCursor ();
+    if (indexCursor == nullptr)
+    {
+        return ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION;
+    }
+
+    output = new TableReadCursor (this, indexCursor);
+    return ResultCode::OK;
+}
+
+ResultCode Table::CreateLookupCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                      AnyDataId indexId, const Row &key, TableReadCursor *&output)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    auto iterator = indices_.find (indexId);
+    if (iterator == indices_.end ())
+    {
+        return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    ResultCode validationResult = ValidateLookupKey (iterator->second->GetIndexInfo (), key);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    output = new TableReadCursor (this, iterator->second->OpenLookupCursor (key));
+    return ResultCode::OK;
+}
+
+ResultCode Table::CreateFilteredReadCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                            AnyDataId indexId, const Predicate &predicate, TableReadCursor *&output)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    ResultCode validationResult = predicate.Validate (this);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    ResultCode result = CreateReadCursor (readOrWriteGuard, indexId, output);
+    if (result == ResultCode::OK)
+    {
+        output->predicate_ = std::make_unique <Predicate> (predicate);
+        output->SkipNotMatching ();
+    }
+
+    return result;
+}
+
+ResultCode Table::Aggregate (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                             const AggregationQuery &query, std::vector <AggregateGroup> &output) const
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    ResultCode validationResult = Aggregator::Validate (this, query);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    Aggregator aggregator (this, query);
+    AnyDataId batch[Aggregator::BATCH_SIZE];
+    std::size_t batchSize = 0u;
+
+    auto add = [&aggregator, &batch, &batchSize] (AnyDataId rowId)
+    {
+        batch[batchSize++] = rowId;
+        if (batchSize == Aggregator::BATCH_SIZE)
+        {
+            aggregator.Process (batch, batchSize);
+            batchSize = 0u;
+        }
+    };
+
+    if (query.hasLowerBound_ || query.hasUpperBound_)
+    {
+        const Index *index;
+        std::size_t begin;
+        std::size_t end;
+
+        validationResult = FindIndexRange (query.indexId_, query.hasLowerBound_ ? &query.lowerBound_ : nullptr,
+                                           query.hasUpperBound_ ? &query.upperBound_ : nullptr, index, begin, end);
+
+        if (validationResult != ResultCode::OK)
+        {
+            return validationResult;
+        }
+
+        for (std::size_t position = begin; position < end; ++position)
+        {
+            add (index->order_[position]);
+        }
+    }
+    else
+    {
+        for (AnyDataId rowId : rows_)
+        {
+            add (rowId);
+        }
+    }
+
+    if (batchSize > 0u)
+    {
+        aggregator.Process (batch, batchSize);
+    }
+
+    aggregator.Finish (output);
+    return ResultCode::OK;
+}
+
+ResultCode Table::ExecuteQuery (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                const QueryPlan &plan, Disco::Context *workers, const QueryConsumer &consumer) const
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    ResultCode result = QueryExecutor::Validate (this, plan);
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    std::vector <AnyDataId> sourceRows;
+    if (plan.hasLowerBound_ || plan.hasUpperBound_)
+    {
+        const Index *index;
+        std::size_t begin;
+        std::size_t end;
+
+        result = FindIndexRange (plan.indexId_, plan.hasLowerBound_ ? &plan.lowerBound_ : nullptr,
+                                 plan.hasUpperBound_ ? &plan.upperBound_ : nullptr, index, begin, end);
+
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+
+        sourceRows.assign (index->order_.begin () + begin, index->order_.begin () + end);
+    }
+    else
+    {
+        sourceRows.reserve (rows_.GetSize ());
+        for (AnyDataId rowId : rows_)
+        {
+            sourceRows.emplace_back (rowId);
+        }
+    }
+
+    QueryExecutor (this, plan, workers).Execute (sourceRows, consumer);
+    return ResultCode::OK;
+}
+
+ResultCode Table::CreateSnapshotCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                        AnyDataId indexId, TableSnapshotCursor *&output)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    auto iterator = indices_.find (indexId);
+    if (iterator == indices_.end ())
+    {
+        return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    if (iterator->second->GetIndexInfo ().type_ != IndexType::ORDERED)
+    {
+        return ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION;
+    }
+
+    output = new TableSnapshotCursor (this, OpenSnapshot (), iterator->second->ShareOrder ());
     return ResultCode::OK;
 }
 
@@ -102,6 +304,25 @@ ResultCode Table::GetColumnInfo (const std::shared_ptr <Disco::SafeLockGuard> &r
     }
 }
 
+ResultCode Table::GetColumnDictionarySize (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                           AnyDataId id, std::size_t &output) const
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    auto iterator = columns_.find (id);
+    if (iterator == columns_.end ())
+    {
+        return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    const ColumnDictionary *dictionary = iterator->second.GetDictionary ();
+    output = dictionary ? dictionary->GetSize () : 0u;
+    return ResultCode::OK;
+}
+
 ResultCode Table::GetIndicesIds (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                  std::vector <AnyDataId> &output) const
 {
@@ -118,6 +339,52 @@ ResultCode Table::GetIndicesIds (const std::shared_ptr <Disco::SafeLockGuard> &r
     return ResultCode::OK;
 }
 
+ResultCode Table::GetStatistics (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                 TableStatistics &output)
+{
+    if (!CheckReadOrWriteGuard (readOrWriteGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    std::unique_lock <std::mutex> lock (statisticsGuard_);
+    const uint64_t rowCount = rows_.GetSize ();
+
+    if (version_ - statisticsVersion_ > rowCount / STALE_STATISTICS_DIVISOR)
+    {
+        RebuildColumnSketches ();
+        statisticsVersion_ = version_;
+    }
+
+    output.rowCount_ = rowCount;
+    output.changesSinceRefresh_ = version_ - statisticsVersion_;
+    output.columns_.clear ();
+    output.columns_.reserve (columns_.size ());
+
+    for (const auto &idColumnPair : columns_)
+    {
+        const Column &column = idColumnPair.second;
+        const uint64_t valuesCount = column.GetValuesCount ();
+
+        ColumnStatistics &statistics = output.columns_.emplace_back ();
+        statistics.columnId_ = idColumnPair.first;
+        statistics.nullCount_ = rowCount - valuesCount;
+        column.sketch_.Fill (statistics);
+
+        const ColumnDictionary *dictionary = column.GetDictionary ();
+        statistics.distinctCount_ = dictionary ? dictionary->GetSize () :
+                                    std::min (statistics.distinctCount_, valuesCount);
+    }
+
+    std::sort (output.columns_.begin (), output.columns_.end (),
+               [] (const ColumnStatistics &first, const ColumnStatistics &second)
+               {
+                   return first.columnId_ < second.columnId_;
+               });
+
+    return ResultCode::OK;
+}
+
 ResultCode Table::GetIndexInfo (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                 AnyDataId id, IndexInfo &output) const
 {
@@ -133,7 +400,7 @@ ResultCode Table::GetIndexInfo (const std::shared_ptr <Disco::SafeLockGuard> &re
     }
     else
     {
-        output = iterator->second.GetIndexInfo ();
+        output = iterator->second->GetIndexInfo ();
         return ResultCode::OK;
     }
 }
@@ -152,14 +419,62 @@ ResultCode Table::SetName (const std::shared_ptr <Disco::SafeLockGuard> &writeGu
     else
     {
         name_ = name;
+        if (mutationLog_)
+        {
+            std::vector <uint8_t> payload;
+            Encoding::AppendString (name_, payload);
+            LogMutation (MutationType::SET_TABLE_NAME, id_, payload);
+        }
+
         return ResultCode::OK;
     }
 }
 
-ResultCode Table::CreateEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, AnyDataId indexId,
-                                    TableEditCursor *&output)
+ResultCode Table::GetRowLock (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard, AnyDataId rowId,
+                              Disco::Lock *&output)
 {
-    if (!CheckWriteGuard (writeGuard))
+    if (!Disco::IsIntentCaptured (intentGuard, guard_))
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught attempt to request row lock of table \"" + name_ +
+                                                         "\" without intent guard!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    output = &rowLocks_.GetLock (rowId);
+    return ResultCode::OK;
+}
+
+ResultCode Table::CreateEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                    AnyDataId indexId, TableEditCursor *&output)
+{
+    if (!CheckWriteOrIntentGuard (writeOrIntentGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    auto iterator = indices_.find (indexId);
+    if (iterator == indices_.end ())
+    {
+        return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    std::unique_lock <std::mutex> latch = LatchForIntent (writeOrIntentGuard);
+    IndexCursor *indexCursor = iterator->second->OpenCursor ();
+
+    if (indexCursor == nullptr)
+    {
+        return ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION;
+    }
+
+    output = new TableEditCursor (this, indexCursor);
+    return ResultCode::OK;
+}
+
+ResultCode Table::CreateLookupEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                          AnyDataId indexId, const Row &key, TableEditCursor *&output)
+{
+    if (!CheckWriteOrIntentGuard (writeOrIntentGuard))
     {
         return ResultCode::INVARIANTS_VIOLATED;
     }
@@ -170,10 +485,43 @@ ResultCode Table::CreateEditCursor (const std::shared_ptr <Disco::SafeLockGuard>
         return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
     }
 
-    output = new TableEditCursor (this, iterator->second.OpenCursor ());
+    ResultCode validationResult = ValidateLookupKey (iterator->second->GetIndexInfo (), key);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    std::unique_lock <std::mutex> latch = LatchForIntent (writeOrIntentGuard);
+    output = new TableEditCursor (this, iterator->second->OpenLookupCursor (key));
     return ResultCode::OK;
 }
 
+ResultCode Table::CreateFilteredEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                            AnyDataId indexId, const Predicate &predicate, TableEditCursor *&output)
+{
+    if (!CheckWriteOrIntentGuard (writeOrIntentGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    // Predicate is validated against schema, which could be changed only under write guard.
+    ResultCode validationResult = predicate.Validate (this);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    ResultCode result = CreateEditCursor (writeOrIntentGuard, indexId, output);
+    if (result == ResultCode::OK)
+    {
+        std::unique_lock <std::mutex> latch = LatchForIntent (writeOrIntentGuard);
+        output->predicate_ = std::make_unique <Predicate> (predicate);
+        output->SkipNotMatching ();
+    }
+
+    return result;
+}
+
 ResultCode Table::AddColumn (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
                              const ColumnInfo &info, AnyDataId &outputId)
 {
@@ -182,11 +530,38 @@ ResultCode Table::AddColumn (const std::shared_ptr <Disco::SafeLockGuard> &write
         return ResultCode::INVARIANTS_VIOLATED;
     }
 
+    return AddColumnInternal (info, outputId);
+}
+
+ResultCode Table::AddColumnInternal (const ColumnInfo &info, AnyDataId &outputId)
+{
     if (info.name_.empty ())
     {
         return ResultCode::COLUMN_NAME_SHOULD_NOT_BE_EMPTY;
     }
 
+    uint32_t maxSize = GetDataTypeSize (info.dataType_);
+    if (IsVariableSizeDataType (info.dataType_))
+    {
+        if (info.maxSize_ > MAX_VARIABLE_DATA_SIZE)
+        {
+            return ResultCode::COLUMN_MAX_SIZE_IS_TOO_BIG;
+        }
+
+        maxSize = info.maxSize_ == 0u ? MAX_VARIABLE_DATA_SIZE : info.maxSize_;
+    }
+
+    // Integer values are not bigger than codes, therefore there is nothing to gain from encoding.
+    if (info.dictionaryEncoded_ && IsIntegerDataType (info.dataType_))
+    {
+        return ResultCode::DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE;
+    }
+
+    if (info.compressed_ && !IsIntegerDataType (info.dataType_))
+    {
+        return ResultCode::COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE;
+    }
+
     AnyDataId columnId = nextColumnId_++;
     if (columns_.count (columnId) > 0)
     {
@@ -198,10 +573,20 @@ ResultCode Table::AddColumn (const std::shared_ptr <Disco::SafeLockGuard> &write
     else
     {
         outputId = columnId;
-        auto result = columns_.emplace (columnId, ColumnInfo {columnId, info.dataType_, info.name_});
+        std::unique_lock <std::mutex> lock (snapshotsGuard_);
+        auto result = columns_.emplace (
+            columnId, ColumnInfo {columnId, info.dataType_, info.name_, maxSize,
+                                  info.dictionaryEncoded_, info.compressed_});
 
         if (result.second)
         {
+            if (mutationLog_)
+            {
+                std::vector <uint8_t> payload;
+                Encoding::AppendColumnInfo (result.first->second.GetColumnInfo (), payload);
+                LogMutation (MutationType::ADD_COLUMN, columnId, payload);
+            }
+
             return ResultCode::OK;
         }
         else
@@ -233,12 +618,9 @@ ResultCode Table::RemoveColumn (const std::shared_ptr <Disco::SafeLockGuard> &wr
 
         for (auto &idIndexPair : indices_)
         {
-            auto columnIdInIndex = std::find (idIndexPair.second.GetIndexInfo ().columns_.begin (),
-                                              idIndexPair.second.GetIndexInfo ().columns_.end (), id);
-
-            if (columnIdInIndex != idIndexPair.second.GetIndexInfo ().columns_.end ())
+            if (idIndexPair.second->UsesColumn (id))
             {
-                if (!idIndexPair.second.IsSafeToRemove (writeGuard))
+                if (!idIndexPair.second->IsSafeToRemove (writeGuard))
                 {
                     return ResultCode::COLUMN_REMOVAL_BLOCKED_BY_DEPENDANT_INDEX;
                 }
@@ -247,12 +629,18 @@ ResultCode Table::RemoveColumn (const std::shared_ptr <Disco::SafeLockGuard> &wr
             }
         }
 
-        columns_.erase (iterator);
+        {
+            std::unique_lock <std::mutex> lock (snapshotsGuard_);
+            columns_.erase (iterator);
+        }
+
         for (AnyDataId indexId : cascadeIndices)
         {
             indices_.erase (indexId);
         }
 
+        // Replica removes dependant indices by itself, because it follows the same rules.
+        LogMutation (MutationType::REMOVE_COLUMN, id, {});
         return ResultCode::OK;
     }
 }
@@ -275,15 +663,23 @@ ResultCode Table::AddIndex (const std::shared_ptr <Disco::SafeLockGuard> &writeG
         return ResultCode::INDEX_MUST_DEPEND_ON_AT_LEAST_ONE_COLUMN;
     }
 
-    for (AnyDataId columnId : info.columns_)
+    if (!info.includedColumns_.empty () && info.type_ != IndexType::ORDERED)
+    {
+        return ResultCode::INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX;
+    }
+
+    for (const std::vector <AnyDataId> *columns : {&info.columns_, &info.includedColumns_})
     {
-        if (columns_.count (columnId) == 0)
+        for (AnyDataId columnId : *columns)
         {
-            Evan::Logger::Get ().Log (
-                Evan::LogLevel::ERROR,
-                "Unable to add index to table \"" + name_ + "\", because column with requested id " +
-                std::to_string (columnId) + " is not found!");
-            return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+            if (columns_.count (columnId) == 0)
+            {
+                Evan::Logger::Get ().Log (
+                    Evan::LogLevel::ERROR,
+                    "Unable to add index to table \"" + name_ + "\", because column with requested id " +
+                    std::to_string (columnId) + " is not found!");
+                return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+            }
         }
     }
 
@@ -298,11 +694,25 @@ ResultCode Table::AddIndex (const std::shared_ptr <Disco::SafeLockGuard> &writeG
     else
     {
         outputId = indexId;
-        auto result = indices_.emplace (
-            indexId, std::make_pair (this, IndexInfo {indexId, info.name_, info.columns_}));
+        IndexInfo indexInfo = info;
+        indexInfo.id_ = indexId;
+        auto result = indices_.emplace (indexId, std::make_unique <Index> (this, std::move (indexInfo)));
 
         if (result.second)
         {
+            if (info.unique_ && result.first->second->HasDuplicates ())
+            {
+                indices_.erase (result.first);
+                return ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED;
+            }
+
+            if (mutationLog_)
+            {
+                std::vector <uint8_t> payload;
+                Encoding::AppendIndexInfo (result.first->second->GetIndexInfo (), payload);
+                LogMutation (MutationType::ADD_INDEX, indexId, payload);
+            }
+
             return ResultCode::OK;
         }
         else
@@ -329,9 +739,10 @@ ResultCode Table::RemoveIndex (const std::shared_ptr <Disco::SafeLockGuard> &wri
     }
     else
     {
-        if (iterator->second.IsSafeToRemove (writeGuard))
+        if (iterator->second->IsSafeToRemove (writeGuard))
         {
             indices_.erase (iterator);
+            LogMutation (MutationType::REMOVE_INDEX, id, {});
             return ResultCode::OK;
         }
         else
@@ -341,57 +752,12 @@ ResultCode Table::RemoveIndex (const std::shared_ptr <Disco::SafeLockGuard> &wri
     }
 }
 
-ResultCode Table::InsertRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, Row &row)
+ResultCode Table::InsertRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard, Row &row)
 {
-    if (!CheckWriteGuard (writeGuard))
-    {
-        return ResultCode::INVARIANTS_VIOLATED;
-    }
-
-    AnyDataId rowId = nextRowId_++;
-    if (rows_.count (rowId) > 0)
-    {
-        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to add row to table \"" + name_ +
-                                                         "\", because autogenerated row id is already used!");
-        assert (false);
-        return ResultCode::INVARIANTS_VIOLATED;
-    }
-
-    ResultCode validationResult = ValidateRowChanged (row);
-    if (validationResult != ResultCode::OK)
-    {
-        --nextRowId_;
-        return validationResult;
-    }
-
-    auto emplaceResult = rows_.emplace (rowId);
-    if (emplaceResult.second)
-    {
-        ApplyValidRowChanges (rowId, row);
-        for (auto &idIndexPair : indices_)
-        {
-            ResultCode resultCode = idIndexPair.second.OnInsert (rowId);
-            if (resultCode != ResultCode::OK)
-            {
-                Evan::Logger::Get ().Log (
-                    Evan::LogLevel::ERROR,
-                    "Index \"" + idIndexPair.second.GetIndexInfo ().name_ + "\" of table \"" + name_ +
-                    "\" is unable to process insertion of row " + std::to_string (rowId) + ", error " +
-                    std::to_string (static_cast<uint64_t>(resultCode)) + "!");
-                assert (false);
-            }
-        }
-
-        return ResultCode::OK;
-    }
-    else
-    {
-        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to add row to table \"" + name_ +
-                                                         "\", because emplace operation failed!");
-        assert (false);
-        return ResultCode::INVARIANTS_VIOLATED;
-    }
-}
+    std::unique_lock <std::mutex> latch = LatchForIntent (writeOrIntentGuard);
+    AnyDataId rowId;
+    return InsertRow (writeOrIntentGuard, row, rowId);
+}
 
 bool Table::IsSafeToRemove (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard) const
 {
@@ -428,11 +794,61 @@ bool Table::CheckWriteGuard (const std::shared_ptr <Disco::SafeLockGuard> &write
     }
 }
 
+bool Table::CheckWriteOrIntentGuard (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard) const
+{
+    if (Disco::IsWriteCaptured (writeOrIntentGuard, guard_) || Disco::IsIntentCaptured (writeOrIntentGuard, guard_))
+    {
+        return true;
+    }
+    else
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught attempt to edit table \"" + name_ +
+                                                         "\" data without proper write or intent guard!");
+        assert (false);
+        return false;
+    }
+}
+
+bool Table::CheckAnyGuard (const std::shared_ptr <Disco::SafeLockGuard> &anyGuard) const
+{
+    if (Disco::IsReadOrWriteCaptured (anyGuard, guard_) || Disco::IsIntentCaptured (anyGuard, guard_))
+    {
+        return true;
+    }
+    else
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught attempt to access table \"" + name_ +
+                                                         "\" data without any guard!");
+        assert (false);
+        return false;
+    }
+}
+
+std::unique_lock <std::mutex> Table::LatchForIntent (const std::shared_ptr <Disco::SafeLockGuard> &guard) const
+{
+    if (Disco::IsIntentCaptured (guard, guard_))
+    {
+        return std::unique_lock <std::mutex> (intentLatch_);
+    }
+    else
+    {
+        return std::unique_lock <std::mutex> (intentLatch_, std::defer_lock);
+    }
+}
+
 bool Table::IsSafeToRemoveInternal () const
 {
+    {
+        std::unique_lock <std::mutex> lock (snapshotsGuard_);
+        if (!snapshotVersions_.empty ())
+        {
+            return false;
+        }
+    }
+
     for (auto &idIndexPair : indices_)
     {
-        if (!idIndexPair.second.IsSafeToRemoveInternal ())
+        if (!idIndexPair.second->IsSafeToRemoveInternal ())
         {
             return false;
         }
@@ -463,6 +879,114 @@ ResultCode Table::ValidateRowChanged (const Table::Row &row) const
                 std::to_string (columnDataPair.first) + " type is not equal to provided value type!");
             return ResultCode::NEW_COLUMN_VALUE_TYPE_MISMATCH;
         }
+
+        if (columnDataPair.second.GetDataSize () > columnIterator->second.GetColumnInfo ().maxSize_)
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Unable to add row to table \"" + name_ + "\", because value for column with requested id " +
+                std::to_string (columnDataPair.first) + " exceeds column max size!");
+            return ResultCode::NEW_COLUMN_VALUE_IS_TOO_BIG;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode Table::ValidateLookupKey (const IndexInfo &indexInfo, const Table::Row &key) const
+{
+    for (const auto &columnDataPair : key)
+    {
+        if (std::find (indexInfo.columns_.begin (), indexInfo.columns_.end (), columnDataPair.first) ==
+            indexInfo.columns_.end ())
+        {
+            return ResultCode::LOOKUP_KEY_COLUMN_IS_NOT_INDEXED;
+        }
+
+        auto columnIterator = columns_.find (columnDataPair.first);
+        if (columnIterator == columns_.end ())
+        {
+            return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        if (columnIterator->second.GetColumnInfo ().dataType_ != columnDataPair.second.GetType ())
+        {
+            return ResultCode::LOOKUP_KEY_VALUE_TYPE_MISMATCH;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode Table::FindIndexRange (AnyDataId indexId, const Table::Row *lowerBound, const Table::Row *upperBound,
+                                  const Index *&index, std::size_t &begin, std::size_t &end) const
+{
+    auto iterator = indices_.find (indexId);
+    if (iterator == indices_.end ())
+    {
+        return ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    index = iterator->second.get ();
+    if (index->GetIndexInfo ().type_ != IndexType::ORDERED)
+    {
+        return ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION;
+    }
+
+    for (const Row *bound : {lowerBound, upperBound})
+    {
+        ResultCode result = bound ? ValidateLookupKey (index->GetIndexInfo (), *bound) : ResultCode::OK;
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+    }
+
+    index->FindRange (lowerBound, upperBound, begin, end);
+    return ResultCode::OK;
+}
+
+ResultCode Table::CheckUniqueIndices (AnyDataId rowId, const Table::Row &values, bool isUpdate) const
+{
+    std::vector <const AnyDataContainer *> key;
+    std::vector <AnyDataContainer> buffers;
+
+    for (const auto &idIndexPair : indices_)
+    {
+        const IndexInfo &info = idIndexPair.second->GetIndexInfo ();
+        if (!info.unique_)
+        {
+            continue;
+        }
+
+        key.clear ();
+        buffers.resize (info.columns_.size ());
+        bool anyChanged = false;
+        bool anyNull = false;
+
+        for (AnyDataId columnId : info.columns_)
+        {
+            auto iterator = values.find (columnId);
+            const AnyDataContainer *value = nullptr;
+
+            if (iterator != values.end ())
+            {
+                value = &iterator->second;
+                anyChanged = true;
+            }
+            else if (isUpdate)
+            {
+                GetColumnValue (columnId, rowId, value, buffers[key.size ()]);
+            }
+
+            anyNull |= value == nullptr;
+            key.emplace_back (value);
+        }
+
+        if (anyChanged && !anyNull && idIndexPair.second->HasKeyConflict (key, rowId))
+        {
+            return ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED;
+        }
     }
 
     return ResultCode::OK;
@@ -474,7 +998,7 @@ void Table::ApplyValidRowChanges (AnyDataId rowId, Table::Row &row)
     {
         try
         {
-            columns_.at (columnDataPair.first).values_[rowId] = std::move (columnDataPair.second);
+            columns_.at (columnDataPair.first).SetValue (rowId, columnDataPair.second);
         }
         catch (std::out_of_range &exception)
         {
@@ -489,7 +1013,27 @@ void Table::ApplyValidRowChanges (AnyDataId rowId, Table::Row &row)
     row.clear ();
 }
 
-ResultCode Table::GetColumnValue (AnyDataId columnId, AnyDataId rowId, const AnyDataContainer *&output) const
+template <typename ColumnFilter>
+std::vector <std::pair <Index *, std::size_t>> Table::FindAffectedIndices (
+    AnyDataId rowId, const ColumnFilter &filter) const
+{
+    std::vector <std::pair <Index *, std::size_t>> affectedIndices;
+    for (const auto &idIndexPair : indices_)
+    {
+        // Included columns are affected too, because their values are stored in index.
+        const IndexInfo &info = idIndexPair.second->GetIndexInfo ();
+        if (std::any_of (info.columns_.begin (), info.columns_.end (), filter) ||
+            std::any_of (info.includedColumns_.begin (), info.includedColumns_.end (), filter))
+        {
+            affectedIndices.emplace_back (idIndexPair.second.get (), idIndexPair.second->FindOrderPosition (rowId));
+        }
+    }
+
+    return affectedIndices;
+}
+
+ResultCode Table::GetColumnValue (AnyDataId columnId, AnyDataId rowId, const AnyDataContainer *&output,
+                                  AnyDataContainer &buffer) const
 {
     auto columnIterator = columns_.find (columnId);
     if (columnIterator == columns_.end ())
@@ -497,156 +1041,564 @@ ResultCode Table::GetColumnValue (AnyDataId columnId, AnyDataId rowId, const Any
         return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
     }
 
-    auto rowIterator = columnIterator->second.values_.find (rowId);
-    if (rowIterator == columnIterator->second.values_.end ())
+    // Absence of value is not an error.
+    output = columnIterator->second.GetValue (rowId, buffer);
+    return ResultCode::OK;
+}
+
+ResultCode Table::InsertRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard, Row &row,
+                             AnyDataId &outputRowId)
+{
+    if (!CheckWriteOrIntentGuard (writeOrIntentGuard))
     {
-        // Absence of value is not an error.
-        output = nullptr;
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    AnyDataId rowId = nextRowId_++;
+    if (rows_.Contains (rowId))
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to add row to table \"" + name_ +
+                                                         "\", because autogenerated row id is already used!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    ResultCode result = InsertRowWithId (rowId, row);
+    if (result == ResultCode::OK)
+    {
+        outputRowId = rowId;
     }
     else
     {
-        output = &rowIterator->second;
+        --nextRowId_;
     }
 
-    return ResultCode::OK;
+    return result;
 }
 
-ResultCode Table::UpdateRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
-                             AnyDataId rowId, Table::Row &changedValues)
+ResultCode Table::RestoreRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, AnyDataId rowId, Row &row)
 {
     if (!CheckWriteGuard (writeGuard))
     {
         return ResultCode::INVARIANTS_VIOLATED;
     }
 
-    auto rowIterator = rows_.find (rowId);
-    if (rowIterator == rows_.end ())
+    if (rowId >= nextRowId_ || rows_.Contains (rowId))
     {
-        return ResultCode::ROW_WITH_GIVEN_ID_NOT_FOUND;
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to restore row " + std::to_string (rowId) +
+                                                         " of table \"" + name_ + "\", because its id is invalid!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
     }
 
-    ResultCode validationResult = ValidateRowChanged (changedValues);
+    return InsertRowWithId (rowId, row);
+}
+
+ResultCode Table::InsertRowWithId (AnyDataId rowId, Row &row)
+{
+    ResultCode validationResult = ValidateRowChanged (row);
     if (validationResult != ResultCode::OK)
     {
         return validationResult;
     }
 
-    std::unordered_set <AnyDataId> changedColumns;
-    for (auto &idValuePair : changedValues)
+    ResultCode uniquenessResult = CheckUniqueIndices (rowId, row, false);
+    if (uniquenessResult != ResultCode::OK)
     {
-        changedColumns.emplace (idValuePair.first);
+        return uniquenessResult;
     }
 
-    ApplyValidRowChanges (rowId, changedValues);
-    for (auto &idIndexPair : indices_)
+    // Values are moved into columns, therefore they are encoded before insertion.
+    std::vector <uint8_t> payload;
+    if (mutationLog_)
     {
-        bool anyIntersects = false;
+        MutationLog::EncodeRow (row, payload);
+    }
 
-        // Inform only indices, which use this column.
-        for (auto columnId : idIndexPair.second.GetIndexInfo ().columns_)
+    if (rows_.Insert (rowId))
+    {
         {
-            if (changedColumns.count (columnId) > 0)
-            {
-                anyIntersects = true;
-                break;
-            }
+            // Inserted row is not visible to existing snapshots, therefore there is nothing to preserve.
+            std::unique_lock <std::mutex> lock (snapshotsGuard_);
+            ++version_;
+            ApplyValidRowChanges (rowId, row);
         }
 
-        if (anyIntersects)
+        for (auto &idIndexPair : indices_)
         {
-            ResultCode result = idIndexPair.second.OnUpdate (rowId);
-            if (result != ResultCode::OK)
+            ResultCode resultCode = idIndexPair.second->OnInsert (rowId);
+            if (resultCode != ResultCode::OK)
             {
                 Evan::Logger::Get ().Log (
                     Evan::LogLevel::ERROR,
-                    "Index \"" + idIndexPair.second.GetIndexInfo ().name_ + "\" of table \"" + name_ +
-                    "\" unable to successfully process update of row " + std::to_string (rowId) + ", error " +
-                    std::to_string (static_cast<uint64_t>(result)) + "!");
+                    "Index \"" + idIndexPair.second->GetIndexInfo ().name_ + "\" of table \"" + name_ +
+                    "\" is unable to process insertion of row " + std::to_string (rowId) + ", error " +
+                    std::to_string (static_cast<uint64_t>(resultCode)) + "!");
                 assert (false);
-
-                // TODO: For now, index OnInsert/OnUpdate/OnDelete failures are logger
-                //       and skipped. Any thoughts about how to do it better?
             }
         }
-    }
 
-    return ResultCode::OK;
+        LogMutation (MutationType::INSERT_ROW, rowId, payload);
+        return ResultCode::OK;
+    }
+    else
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Unable to add row to table \"" + name_ +
+                                                         "\", because emplace operation failed!");
+        assert (false);
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
 }
 
-ResultCode Table::DeleteRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, AnyDataId rowId)
+ResultCode Table::UpdateRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                             AnyDataId rowId, Table::Row &changedValues)
 {
-    if (!CheckWriteGuard (writeGuard))
+    if (!CheckWriteOrIntentGuard (writeOrIntentGuard))
     {
         return ResultCode::INVARIANTS_VIOLATED;
     }
 
-    auto rowIterator = rows_.find (rowId);
-    if (rowIterator == rows_.end ())
+    if (!rows_.Contains (rowId))
     {
         return ResultCode::ROW_WITH_GIVEN_ID_NOT_FOUND;
     }
 
-    rows_.erase (rowIterator);
-    for (auto &idColumnPair : columns_)
+    ResultCode validationResult = ValidateRowChanged (changedValues);
+    if (validationResult != ResultCode::OK)
     {
-        idColumnPair.second.values_.erase (rowId);
+        return validationResult;
     }
 
-    for (auto &idIndexPair : indices_)
+    ResultCode uniquenessResult = CheckUniqueIndices (rowId, changedValues, true);
+    if (uniquenessResult != ResultCode::OK)
+    {
+        return uniquenessResult;
+    }
+
+    std::vector <uint8_t> payload;
+    if (mutationLog_)
+    {
+        MutationLog::EncodeRow (changedValues, payload);
+    }
+
+    Janitor::FlatHashSet <AnyDataId> changedColumns;
+    changedColumns.reserve (changedValues.size ());
+
+    for (auto &idValuePair : changedValues)
+    {
+        changedColumns.emplace (idValuePair.first);
+    }
+
+    // Inform only indices, which use changed columns. Their positions are found before values are changed,
+    // because only old values lead to old index entries.
+    std::vector <std::pair <Index *, std::size_t>> affectedIndices = FindAffectedIndices (
+        rowId, [&changedColumns] (AnyDataId columnId)
+        {
+            return changedColumns.count (columnId) > 0;
+        });
+
     {
-        ResultCode result = idIndexPair.second.OnDelete (rowId);
+        std::unique_lock <std::mutex> lock (snapshotsGuard_);
+        ++version_;
+        PreserveValuesForSnapshots (rowId, &changedValues);
+        ApplyValidRowChanges (rowId, changedValues);
+    }
+
+    for (auto &[index, oldPosition] : affectedIndices)
+    {
+        ResultCode result = index->OnUpdate (rowId, oldPosition);
         if (result != ResultCode::OK)
         {
             Evan::Logger::Get ().Log (
                 Evan::LogLevel::ERROR,
-                "Index \"" + idIndexPair.second.GetIndexInfo ().name_ + "\" of table \"" + name_ +
-                "\" unable to successfully process deletion of row " + std::to_string (rowId) + ", error " +
+                "Index \"" + index->GetIndexInfo ().name_ + "\" of table \"" + name_ +
+                "\" unable to successfully process update of row " + std::to_string (rowId) + ", error " +
                 std::to_string (static_cast<uint64_t>(result)) + "!");
             assert (false);
+
+            // TODO: For now, index OnInsert/OnUpdate/OnDelete failures are logger
+            //       and skipped. Any thoughts about how to do it better?
         }
     }
 
+    LogMutation (MutationType::UPDATE_ROW, rowId, payload);
     return ResultCode::OK;
 }
 
-ResultCode TableReadCursor::Advance (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard, int64_t step)
+ResultCode Table::EraseRowValues (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, AnyDataId rowId,
+                                  const std::vector <AnyDataId> &columnIds)
 {
-    assert(baseCursor_);
-    if (baseCursor_ && table_->CheckReadOrWriteGuard (readOrWriteGuard))
-    {
-        return baseCursor_->Advance (step);
-    }
-    else
+    if (!CheckWriteGuard (writeGuard))
     {
         return ResultCode::INVARIANTS_VIOLATED;
     }
-}
 
-ResultCode TableReadCursor::Get (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
-                                 AnyDataId columnId, const AnyDataContainer *&output) const
-{
-    // If table was deleted, index deletion will invalidate base cursor, but there is no invalidation mechanism
-    // for table cursors. Because of it, we should get current row id from base cursor to check if it is valid.
-    AnyDataId currentId;
-    ResultCode result = GetCurrentId (currentId);
+    if (columnIds.empty ())
+    {
+        return ResultCode::OK;
+    }
 
-    if (result != ResultCode::OK)
+    if (!rows_.Contains (rowId))
     {
-        return result;
+        return ResultCode::ROW_WITH_GIVEN_ID_NOT_FOUND;
     }
 
-    if (!table_->CheckReadOrWriteGuard (readOrWriteGuard))
+    Row erasedValues;
+    for (AnyDataId columnId : columnIds)
     {
-        return ResultCode::INVARIANTS_VIOLATED;
+        if (columns_.find (columnId) == columns_.end ())
+        {
+            return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+        }
+
+        // Preservation only needs ids of changed columns, so any value works as placeholder.
+        erasedValues.emplace (columnId, AnyDataContainer ());
     }
 
-    return table_->GetColumnValue (columnId, currentId, output);
-}
+    std::vector <std::pair <Index *, std::size_t>> affectedIndices = FindAffectedIndices (
+        rowId, [&columnIds] (AnyDataId columnId)
+        {
+            return std::find (columnIds.begin (), columnIds.end (), columnId) != columnIds.end ();
+        });
 
-TableReadCursor::TableReadCursor (Table *table, IndexCursor *indexCursor)
-    : baseCursor_ (indexCursor),
-      table_ (table)
-{
+    {
+        std::unique_lock <std::mutex> lock (snapshotsGuard_);
+        ++version_;
+        PreserveValuesForSnapshots (rowId, &erasedValues);
+        for (AnyDataId columnId : columnIds)
+        {
+            columns_.at (columnId).EraseValue (rowId);
+        }
+    }
+
+    for (auto &[index, oldPosition] : affectedIndices)
+    {
+        ResultCode result = index->OnUpdate (rowId, oldPosition);
+        if (result != ResultCode::OK)
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Index \"" + index->GetIndexInfo ().name_ + "\" of table \"" + name_ +
+                "\" unable to successfully process erasure of row " + std::to_string (rowId) +
+                " values, error " + std::to_string (static_cast<uint64_t>(result)) + "!");
+            assert (false);
+        }
+    }
+
+    if (mutationLog_)
+    {
+        std::vector <uint8_t> payload;
+        Encoding::AppendIds (columnIds, payload);
+        LogMutation (MutationType::ERASE_ROW_VALUES, rowId, payload);
+    }
+
+    return ResultCode::OK;
+}
+
+ResultCode Table::DeleteRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard, AnyDataId rowId)
+{
+    if (!CheckWriteOrIntentGuard (writeOrIntentGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    if (!rows_.Erase (rowId))
+    {
+        return ResultCode::ROW_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    std::vector <std::pair <Index *, std::size_t>> affectedIndices = FindAffectedIndices (
+        rowId, [] (AnyDataId)
+        {
+            return true;
+        });
+
+    {
+        std::unique_lock <std::mutex> lock (snapshotsGuard_);
+        ++version_;
+        PreserveValuesForSnapshots (rowId, nullptr);
+
+        for (auto &idColumnPair : columns_)
+        {
+            idColumnPair.second.EraseValue (rowId);
+        }
+    }
+
+    for (auto &[index, oldPosition] : affectedIndices)
+    {
+        ResultCode result = index->OnDelete (rowId, oldPosition);
+        if (result != ResultCode::OK)
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Index \"" + index->GetIndexInfo ().name_ + "\" of table \"" + name_ +
+                "\" unable to successfully process deletion of row " + std::to_string (rowId) + ", error " +
+                std::to_string (static_cast<uint64_t>(result)) + "!");
+            assert (false);
+        }
+    }
+
+    LogMutation (MutationType::DELETE_ROW, rowId, {});
+    return ResultCode::OK;
+}
+
+void Table::LogMutation (MutationType type, AnyDataId partId, const std::vector <uint8_t> &payload)
+{
+    if (mutationLog_ && pendingMutations_)
+    {
+        pendingMutations_->emplace_back (PendingMutation {type, id_, partId, payload});
+    }
+    else if (mutationLog_)
+    {
+        mutationLog_->Append (type, id_, partId, payload);
+    }
+}
+
+void Table::PreserveValuesForSnapshots (AnyDataId rowId, const Row *changedValues)
+{
+    if (snapshotVersions_.empty ())
+    {
+        return;
+    }
+
+    auto preserve = [this, rowId] (Column &column)
+    {
+        ColumnValueVersion valueVersion {version_, true, AnyDataContainer ()};
+        valueVersion.isNull_ = !column.ExtractValue (rowId, valueVersion.value_);
+        column.history_[rowId].emplace_back (std::move (valueVersion));
+    };
+
+    if (changedValues)
+    {
+        for (const auto &idValuePair : *changedValues)
+        {
+            auto columnIterator = columns_.find (idValuePair.first);
+            if (columnIterator != columns_.end ())
+            {
+                preserve (columnIterator->second);
+            }
+        }
+    }
+    else
+    {
+        for (auto &idColumnPair : columns_)
+        {
+            // Null values of deleted rows are left implicit: absence of both value and history means null.
+            if (idColumnPair.second.HasValue (rowId))
+            {
+                preserve (idColumnPair.second);
+            }
+        }
+    }
+}
+
+ResultCode Table::GetSnapshotValue (AnyDataId columnId, AnyDataId rowId, uint64_t version,
+                                    AnyDataContainer &output, bool &isNull)
+{
+    std::unique_lock <std::mutex> lock (snapshotsGuard_);
+    auto columnIterator = columns_.find (columnId);
+
+    if (columnIterator == columns_.end ())
+    {
+        return ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND;
+    }
+
+    ReadSnapshotValue (columnIterator->second, rowId, version, output, isNull);
+    return ResultCode::OK;
+}
+
+void Table::ReadSnapshotValue (const Column &column, AnyDataId rowId, uint64_t version,
+                               AnyDataContainer &output, bool &isNull)
+{
+    auto historyIterator = column.history_.find (rowId);
+    if (historyIterator != column.history_.end ())
+    {
+        // First version, that was superseded after snapshot creation, is the one that snapshot should see.
+        for (const ColumnValueVersion &valueVersion : historyIterator->second)
+        {
+            if (valueVersion.supersededAt_ > version)
+            {
+                isNull = valueVersion.isNull_;
+                if (!isNull)
+                {
+                    output.CopyFrom (valueVersion.value_);
+                }
+
+                return;
+            }
+        }
+    }
+
+    const AnyDataContainer *value = column.GetValue (rowId, output);
+    isNull = value == nullptr;
+
+    // Compressed values are decoded directly into output.
+    if (!isNull && value != &output)
+    {
+        output.CopyFrom (*value);
+    }
+}
+
+uint64_t Table::OpenSnapshot ()
+{
+    // Writers are blocked by guard, so version can not change until snapshot registration.
+    std::unique_lock <std::mutex> lock (snapshotsGuard_);
+    snapshotVersions_.emplace (version_);
+    return version_;
+}
+
+void Table::RebuildColumnSketches ()
+{
+    std::vector <AnyDataContainer> values;
+    AnyDataContainer buffer;
+
+    for (auto &idColumnPair : columns_)
+    {
+        Column &column = idColumnPair.second;
+        values.clear ();
+        values.reserve (column.GetValuesCount ());
+
+        for (AnyDataId rowId : rows_)
+        {
+            const AnyDataContainer *value = column.GetValue (rowId, buffer);
+            if (value)
+            {
+                values.emplace_back (*value);
+            }
+        }
+
+        column.sketch_.Rebuild (values);
+    }
+}
+
+void Table::CloseSnapshot (uint64_t version)
+{
+    std::unique_lock <std::mutex> lock (snapshotsGuard_);
+    auto iterator = snapshotVersions_.find (version);
+
+    if (iterator == snapshotVersions_.end ())
+    {
+        Evan::Logger::Get ().Log (Evan::LogLevel::ERROR, "Caught attempt to close unknown snapshot of table \"" +
+                                                         name_ + "\" with version " + std::to_string (version) + "!");
+        assert (false);
+        return;
+    }
+
+    snapshotVersions_.erase (iterator);
+
+    // Versions, that were superseded before or right at oldest alive snapshot creation, are no longer visible.
+    // Closing snapshot is rare operation comparing to row changes, so collecting garbage here is ok.
+    const bool noSnapshots = snapshotVersions_.empty ();
+    const uint64_t oldestVersion = noSnapshots ? 0u : *snapshotVersions_.begin ();
+
+    for (auto &idColumnPair : columns_)
+    {
+        auto &history = idColumnPair.second.history_;
+        if (noSnapshots)
+        {
+            history.clear ();
+            continue;
+        }
+
+        for (auto rowIterator = history.begin (); rowIterator != history.end ();)
+        {
+            auto &versions = rowIterator->second;
+            auto firstVisible = std::find_if (versions.begin (), versions.end (),
+                                              [oldestVersion] (const ColumnValueVersion &valueVersion)
+                                              {
+                                                  return valueVersion.supersededAt_ > oldestVersion;
+                                              });
+
+            versions.erase (versions.begin (), firstVisible);
+            if (versions.empty ())
+            {
+                rowIterator = history.erase (rowIterator);
+            }
+            else
+            {
+                ++rowIterator;
+            }
+        }
+    }
+}
+
+ResultCode TableReadCursor::Advance (const std::shared_ptr <Disco::SafeLockGuard> &anyGuard, int64_t step)
+{
+    assert(baseCursor_);
+    if (baseCursor_ && table_->CheckAnyGuard (anyGuard))
+    {
+        std::unique_lock <std::mutex> latch = table_->LatchForIntent (anyGuard);
+        return predicate_ ? AdvanceFiltered (step) : baseCursor_->Advance (step);
+    }
+    else
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+}
+
+ResultCode TableReadCursor::Get (const std::shared_ptr <Disco::SafeLockGuard> &anyGuard,
+                                 AnyDataId columnId, const AnyDataContainer *&output) const
+{
+    if (!table_->CheckAnyGuard (anyGuard))
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    std::unique_lock <std::mutex> latch = table_->LatchForIntent (anyGuard);
+
+    // If table was deleted, index deletion will invalidate base cursor, but there is no invalidation mechanism
+    // for table cursors. Because of it, we should get current row id from base cursor to check if it is valid.
+    AnyDataId currentId;
+    ResultCode result = GetCurrentId (currentId);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (!latch.owns_lock ())
+    {
+        // Covering indices serve values of indexed and included columns without column lookups.
+        if (baseCursor_->GetCoveredValue (columnId, output))
+        {
+            return ResultCode::OK;
+        }
+
+        return table_->GetColumnValue (columnId, currentId, output, decodedValues_[columnId]);
+    }
+
+    const AnyDataContainer *value = nullptr;
+    AnyDataContainer buffer;
+
+    if (!baseCursor_->GetCoveredValue (columnId, value))
+    {
+        result = table_->GetColumnValue (columnId, currentId, value, buffer);
+        if (result != ResultCode::OK)
+        {
+            return result;
+        }
+    }
+
+    if (value)
+    {
+        AnyDataContainer &copy = decodedValues_[columnId];
+        copy.CopyFrom (*value);
+        output = &copy;
+    }
+    else
+    {
+        output = nullptr;
+    }
+
+    return ResultCode::OK;
+}
+
+TableReadCursor::TableReadCursor (Table *table, IndexCursor *indexCursor)
+    : table_ (table),
+      baseCursor_ (indexCursor),
+      predicate_ (),
+      decodedValues_ ()
+{
     assert(baseCursor_);
     assert(table);
 }
@@ -664,35 +1616,261 @@ ResultCode TableReadCursor::GetCurrentId (AnyDataId &output) const
     }
 }
 
+void TableReadCursor::SkipNotMatching ()
+{
+    assert (baseCursor_);
+    if (predicate_ && baseCursor_ && baseCursor_->sourceIndex_)
+    {
+        baseCursor_->Synchronize ();
+        uint64_t number = 1u;
+        baseCursor_->SetPosition (ScanForward (baseCursor_->position_, number));
+    }
+}
+
+ResultCode TableReadCursor::AdvanceFiltered (int64_t step)
+{
+    assert (predicate_);
+    if (!baseCursor_->sourceIndex_)
+    {
+        return ResultCode::INVARIANTS_VIOLATED;
+    }
+
+    baseCursor_->Synchronize ();
+    baseCursor_->AssertPosition ();
+    const uint64_t sequenceSize = baseCursor_->GetSequence ().size ();
+
+    if (step > 0)
+    {
+        if (baseCursor_->position_ >= sequenceSize)
+        {
+            return ResultCode::CURSOR_ADVANCE_STOPPED_AT_END;
+        }
+
+        uint64_t number = step;
+        baseCursor_->SetPosition (ScanForward (baseCursor_->position_ + 1u, number));
+        return baseCursor_->position_ < sequenceSize ? ResultCode::OK : ResultCode::CURSOR_ADVANCE_STOPPED_AT_END;
+    }
+    else if (step < 0)
+    {
+        // Step is negated after increment, because negation of minimal step overflows.
+        uint64_t number = static_cast <uint64_t> (-(step + 1)) + 1u;
+        uint64_t position = ScanBackward (baseCursor_->position_, number);
+
+        if (position < sequenceSize)
+        {
+            baseCursor_->SetPosition (position);
+            return ResultCode::OK;
+        }
+        else
+        {
+            baseCursor_->SetPosition (0u);
+            SkipNotMatching ();
+            return ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN;
+        }
+    }
+
+    return ResultCode::OK;
+}
+
+uint64_t TableReadCursor::ScanForward (uint64_t position, uint64_t &number) const
+{
+    const std::vector <AnyDataId> &sequence = baseCursor_->GetSequence ();
+    uint8_t matches[Predicate::BATCH_SIZE];
+    Predicate::EvaluationStack stack;
+
+    while (position < sequence.size ())
+    {
+        const std::size_t count = std::min <std::size_t> (Predicate::BATCH_SIZE, sequence.size () - position);
+        predicate_->Evaluate (table_, &sequence[position], count, stack, matches);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            if (matches[index] && --number == 0u)
+            {
+                return position + index;
+            }
+        }
+
+        position += count;
+    }
+
+    return sequence.size ();
+}
+
+uint64_t TableReadCursor::ScanBackward (uint64_t position, uint64_t &number) const
+{
+    const std::vector <AnyDataId> &sequence = baseCursor_->GetSequence ();
+    uint8_t matches[Predicate::BATCH_SIZE];
+    Predicate::EvaluationStack stack;
+    position = std::min <uint64_t> (position, sequence.size ());
+
+    while (position > 0u)
+    {
+        const std::size_t count = std::min <std::size_t> (Predicate::BATCH_SIZE, position);
+        position -= count;
+        predicate_->Evaluate (table_, &sequence[position], count, stack, matches);
+
+        for (std::size_t index = count; index > 0u; --index)
+        {
+            if (matches[index - 1u] && --number == 0u)
+            {
+                return position + index - 1u;
+            }
+        }
+    }
+
+    return sequence.size ();
+}
+
 ResultCode TableEditCursor::Update (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
                                     Table::Row &changedValues)
+{
+    return Update (writeGuard, nullptr, changedValues);
+}
+
+ResultCode TableEditCursor::DeleteCurrent (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard)
+{
+    return DeleteCurrent (writeGuard, nullptr);
+}
+
+ResultCode TableEditCursor::GetCurrentRowLock (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                               Disco::Lock *&output) const
 {
     AnyDataId currentId;
-    ResultCode result = GetCurrentId (currentId);
+    ResultCode result;
+    {
+        std::unique_lock <std::mutex> latch = table_->LatchForIntent (intentGuard);
+        result = GetCurrentId (currentId);
+    }
+
+    return result == ResultCode::OK ? table_->GetRowLock (intentGuard, currentId, output) : result;
+}
+
+ResultCode TableEditCursor::Update (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                    const std::shared_ptr <Disco::SafeLockGuard> &rowGuard,
+                                    Table::Row &changedValues)
+{
+    std::unique_lock <std::mutex> latch = table_->LatchForIntent (intentGuard);
+    AnyDataId currentId;
+    ResultCode result = CheckCurrentRowAccess (intentGuard, rowGuard, currentId);
 
     if (result != ResultCode::OK)
     {
         return result;
     }
 
-    return table_->UpdateRow (writeGuard, currentId, changedValues);
+    result = table_->UpdateRow (intentGuard, currentId, changedValues);
+    if (result == ResultCode::OK)
+    {
+        SkipNotMatching ();
+    }
+
+    return result;
 }
 
-ResultCode TableEditCursor::DeleteCurrent (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard)
+ResultCode TableEditCursor::DeleteCurrent (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                           const std::shared_ptr <Disco::SafeLockGuard> &rowGuard)
 {
+    std::unique_lock <std::mutex> latch = table_->LatchForIntent (intentGuard);
     AnyDataId currentId;
-    ResultCode result = GetCurrentId (currentId);
+    ResultCode result = CheckCurrentRowAccess (intentGuard, rowGuard, currentId);
 
     if (result != ResultCode::OK)
     {
         return result;
     }
 
-    return table_->DeleteRow (writeGuard, currentId);
+    result = table_->DeleteRow (intentGuard, currentId);
+    if (result == ResultCode::OK)
+    {
+        SkipNotMatching ();
+    }
+
+    return result;
 }
 
 TableEditCursor::TableEditCursor (Table *table, IndexCursor *indexCursor)
     : TableReadCursor (table, indexCursor)
 {
 }
+
+ResultCode TableEditCursor::CheckCurrentRowAccess (const std::shared_ptr <Disco::SafeLockGuard> &tableGuard,
+                                                   const std::shared_ptr <Disco::SafeLockGuard> &rowGuard,
+                                                   AnyDataId &currentId) const
+{
+    ResultCode result = GetCurrentId (currentId);
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    if (Disco::IsIntentCaptured (tableGuard, table_->guard_) && !table_->rowLocks_.IsCaptured (rowGuard, currentId))
+    {
+        return ResultCode::ROW_LOCK_DOES_NOT_COVER_CURRENT_ROW;
+    }
+
+    return ResultCode::OK;
+}
+
+TableSnapshotCursor::~TableSnapshotCursor ()
+{
+    table_->CloseSnapshot (version_);
+}
+
+ResultCode TableSnapshotCursor::Advance (int64_t step)
+{
+    assert (position_ <= order_->size ());
+    if (step < 0)
+    {
+        // Step is negated after increment, because negation of minimal step overflows.
+        if (static_cast <uint64_t> (-(step + 1)) >= position_)
+        {
+            position_ = 0;
+            return ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN;
+        }
+        else
+        {
+            position_ += step;
+            return ResultCode::OK;
+        }
+    }
+    else
+    {
+        position_ += step;
+        if (position_ > order_->size ())
+        {
+            position_ = order_->size ();
+            return ResultCode::CURSOR_ADVANCE_STOPPED_AT_END;
+        }
+        else
+        {
+            return ResultCode::OK;
+        }
+    }
+}
+
+ResultCode TableSnapshotCursor::Get (AnyDataId columnId, AnyDataContainer &output, bool &isNull) const
+{
+    if (position_ >= order_->size ())
+    {
+        return ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END;
+    }
+
+    return table_->GetSnapshotValue (columnId, (*order_)[position_], version_, output, isNull);
+}
+
+uint64_t TableSnapshotCursor::GetVersion () const
+{
+    return version_;
+}
+
+TableSnapshotCursor::TableSnapshotCursor (Table *table, uint64_t version,
+                                          std::shared_ptr <const std::vector <AnyDataId>> order)
+    : table_ (table),
+      version_ (version),
+      order_ (std::move (order)),
+      position_ (0)
+{
+    assert (table);
+}
 }
\ No newline at end of file
@@ -4,15 +4,24 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 
 #include <Miami/Annotations.hpp>
 
 #include <Miami/Disco/Disco.hpp>
 
+#include <Miami/Janitor/FlatHashMap.hpp>
+
+#include <Miami/Richard/Aggregation.hpp>
 #include <Miami/Richard/Column.hpp>
 #include <Miami/Richard/Data.hpp>
 #include <Miami/Richard/Index.hpp>
+#include <Miami/Richard/Predicate.hpp>
+#include <Miami/Richard/Query.hpp>
 #include <Miami/Richard/ResultCode.hpp>
+#include <Miami/Richard/RowLocks.hpp>
+#include <Miami/Richard/RowSet.hpp>
+#include <Miami/Richard/Statistics.hpp>
 
 namespace Miami::Richard
 {
@@ -20,11 +29,24 @@ class TableReadCursor;
 
 class TableEditCursor;
 
+class TableSnapshotCursor;
+
+class MutationLog;
+
+struct PendingMutation;
+
+enum class MutationType : uint8_t;
+
+/// Table could be edited either under write guard, that gives exclusive access to the whole table, or under intent
+/// guard (see Disco::IntentLock). Intent guards are held by several writers at once, so every writer changes only
+/// rows, which locks it has captured (see ::GetRowLock), and only through edit cursors and ::InsertRow. Intent
+/// writers change table structures under short internal latch, so they never wait for each other's sessions.
 class Table final
 {
 public:
-    // TODO: Replace with flat hash map.
-    using Row = std::unordered_map <AnyDataId, AnyDataContainer>;
+    using Row = Janitor::FlatHashMap <AnyDataId, AnyDataContainer>;
+
+    static constexpr uint64_t STALE_STATISTICS_DIVISOR = 5u;
 
     Table (Disco::Context *multithreadingContext, AnyDataId id, std::string name);
 
@@ -40,23 +62,77 @@ public:
     free_call ResultCode CreateReadCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                            AnyDataId indexId, TableReadCursor *&output);
 
+    /// Creates cursor, that iterates only over rows, which values of index columns are equal to given key.
+    /// Key columns, that are absent in given key, are treated as nulls. Works with any index type.
+    free_call ResultCode CreateLookupCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                             AnyDataId indexId, const Row &key, TableReadCursor *&output);
+
+    /// Creates cursor, that visits only rows, which match given predicate. Cursor steps are counted in matching
+    /// rows and cursor is positioned on first matching row right after creation.
+    free_call ResultCode CreateFilteredReadCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                                   AnyDataId indexId, const Predicate &predicate,
+                                                   TableReadCursor *&output);
+
+    /// Calculates aggregates over rows, that match query predicate. If query has bounds, only rows from given
+    /// range of ordered index are visited, otherwise all table rows are visited in order of their ids.
+    free_call ResultCode Aggregate (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                    const AggregationQuery &query, std::vector <AggregateGroup> &output) const;
+
+    /// Executes query plan and passes its output to consumer batch by batch. If workers context is given, source
+    /// rows are filtered and projected by its workers in parallel, but consumer is always called by calling thread.
+    free_call ResultCode ExecuteQuery (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                       const QueryPlan &plan, Disco::Context *workers,
+                                       const QueryConsumer &consumer) const;
+
+    /// Creates cursor, that iterates over index order and row values, captured at the moment of creation.
+    /// Guard is needed only for creation: snapshot cursor could be used after guard release, so readers,
+    /// that use snapshots, do not block writers. Table could not be removed while there are alive snapshots.
+    free_call ResultCode CreateSnapshotCursor (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                               AnyDataId indexId, TableSnapshotCursor *&output);
+
     free_call ResultCode GetColumnsIds (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                         std::vector <AnyDataId> &output) const;
 
     free_call ResultCode GetColumnInfo (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                         AnyDataId id, ColumnInfo &output) const;
 
+    /// Returns count of distinct values of dictionary encoded column or zero for other columns.
+    free_call ResultCode GetColumnDictionarySize (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                                  AnyDataId id, std::size_t &output) const;
+
     free_call ResultCode GetIndicesIds (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                         std::vector <AnyDataId> &output) const;
 
+    /// Row and null counts are always exact. Histograms, limits and distinct counts are rebuilt from column
+    /// values during this call, if more than ::STALE_STATISTICS_DIVISOR-th part of rows was changed since last
+    /// rebuild, otherwise values, written after rebuild, are added to them incrementally. Columns are sorted by id.
+    free_call ResultCode GetStatistics (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+                                        TableStatistics &output);
+
     free_call ResultCode GetIndexInfo (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
                                        AnyDataId id, IndexInfo &output) const;
 
     free_call ResultCode SetName (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, const std::string &name);
 
-    free_call ResultCode CreateEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
+    /// Returns lock, that must be captured to change given row under intent guard. Lock could be shared with other
+    /// rows, see RowLockTable.
+    free_call ResultCode GetRowLock (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard, AnyDataId rowId,
+                                     Disco::Lock *&output);
+
+    /// Edit cursors could be created under write or intent guard.
+    free_call ResultCode CreateEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
                                            AnyDataId indexId, TableEditCursor *&output);
 
+    /// Edit version of ::CreateLookupCursor.
+    free_call ResultCode CreateLookupEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                                 AnyDataId indexId, const Row &key, TableEditCursor *&output);
+
+    /// Edit version of ::CreateFilteredReadCursor. If current row stops matching predicate after update,
+    /// cursor moves to the next matching row.
+    free_call ResultCode CreateFilteredEditCursor (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                                   AnyDataId indexId, const Predicate &predicate,
+                                                   TableEditCursor *&output);
+
     free_call ResultCode AddColumn (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
                                     const ColumnInfo &info, AnyDataId &outputId);
 
@@ -67,7 +143,9 @@ public:
 
     free_call ResultCode RemoveIndex (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, AnyDataId id);
 
-    free_call ResultCode InsertRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, moved_in Row &row);
+    /// Inserted row gets new id, which is not known to other writers, so insertion does not need row locks.
+    free_call ResultCode InsertRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                    moved_in Row &row);
 
     free_call bool IsSafeToRemove (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard) const;
 
@@ -76,48 +154,165 @@ private:
 
     free_call bool CheckWriteGuard (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard) const;
 
+    free_call bool CheckWriteOrIntentGuard (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard) const;
+
+    /// Cursors could be advanced and read under any guard, because edit cursors are used by intent writers.
+    free_call bool CheckAnyGuard (const std::shared_ptr <Disco::SafeLockGuard> &anyGuard) const;
+
+    /// Captures ::intentLatch_ if given guard is intent one. Write guard gives exclusive access without latch.
+    free_call std::unique_lock <std::mutex> LatchForIntent (const std::shared_ptr <Disco::SafeLockGuard> &guard) const;
+
     free_call bool IsSafeToRemoveInternal () const;
 
+    /// Adds column without guard check. Used to add columns to tables, that are not yet visible to other threads.
+    free_call ResultCode AddColumnInternal (const ColumnInfo &info, AnyDataId &outputId);
+
+    /// Appends successful change to ::mutationLog_ if table is attached to log. If ::pendingMutations_ is set,
+    /// change is buffered there instead.
+    void LogMutation (MutationType type, AnyDataId partId, const std::vector <uint8_t> &payload);
+
     free_call ResultCode ValidateRowChanged (const Row &row) const;
 
+    free_call ResultCode ValidateLookupKey (const IndexInfo &indexInfo, const Row &key) const;
+
+    /// Checks given bounds and finds range of ordered index with given id, see Index::FindRange.
+    free_call ResultCode FindIndexRange (AnyDataId indexId, const Row *lowerBound, const Row *upperBound,
+                                         const Index *&index, std::size_t &begin, std::size_t &end) const;
+
+    /// Checks that given row values do not break any unique index. For updates, ::values contains only
+    /// changed values and other values are taken from row with given id. That row is not treated as conflict.
+    free_call ResultCode CheckUniqueIndices (AnyDataId rowId, const Row &values, bool isUpdate) const;
+
     /// Applies row data, which must be previously validated by ::ValidateRowChanges.
     /// TODO: Extracted only because of code duplication, might be pure design decision.
     free_call void ApplyValidRowChanges (AnyDataId rowId, moved_in Row &row);
 
+    /// Returns indices, which use any column accepted by given filter, with positions of given row in them.
+    /// Must be called before row values are changed, see Index::FindOrderPosition.
+    template <typename ColumnFilter>
+    free_call std::vector <std::pair <Index *, std::size_t>> FindAffectedIndices (
+        AnyDataId rowId, const ColumnFilter &filter) const;
+
     /// TODO: Temporary helper method for column value accessors. Will be reworked with memory mapping support.
-    free_call ResultCode GetColumnValue (AnyDataId columnId, AnyDataId rowId, const AnyDataContainer *&output) const;
+    /// Buffer is used to store decoded values of compressed columns, see Column::GetValue.
+    free_call ResultCode GetColumnValue (AnyDataId columnId, AnyDataId rowId, const AnyDataContainer *&output,
+                                         AnyDataContainer &buffer) const;
+
+    /// Row changing methods accept intent guard too, but in this case they must be called under ::intentLatch_.
+    free_call ResultCode InsertRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                    moved_in Row &row, AnyDataId &outputRowId);
+
+    /// Inserts previously deleted row with its old id. Used to revert deletions.
+    free_call ResultCode RestoreRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
+                                     AnyDataId rowId, moved_in Row &row);
+
+    free_call ResultCode InsertRowWithId (AnyDataId rowId, moved_in Row &row);
 
-    free_call ResultCode UpdateRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
+    free_call ResultCode UpdateRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
                                     AnyDataId rowId, moved_in Row &changedValues);
 
-    free_call ResultCode DeleteRow (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard, AnyDataId rowId);
+    /// Sets given columns of given row to null. Used to revert updates of null values.
+    free_call ResultCode EraseRowValues (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard,
+                                         AnyDataId rowId, const std::vector <AnyDataId> &columnIds);
+
+    free_call ResultCode DeleteRow (const std::shared_ptr <Disco::SafeLockGuard> &writeOrIntentGuard,
+                                    AnyDataId rowId);
+
+    /// Moves current values of given row into columns history, if there are alive snapshots.
+    /// If ::changedValues is nullptr, preserves all row values (used for deletion).
+    /// Must be called under ::snapshotsGuard_ after ::version_ increment.
+    free_call void PreserveValuesForSnapshots (AnyDataId rowId, const Row *changedValues);
+
+    free_call ResultCode GetSnapshotValue (AnyDataId columnId, AnyDataId rowId, uint64_t version,
+                                           AnyDataContainer &output, bool &isNull);
+
+    /// Must be called under ::snapshotsGuard_, so batches of values could be read under one lock.
+    static void ReadSnapshotValue (const Column &column, AnyDataId rowId, uint64_t version,
+                                   AnyDataContainer &output, bool &isNull);
+
+    /// Registers snapshot of current version, which must be closed by ::CloseSnapshot.
+    /// Must be called under table guard, so version could not change until registration.
+    free_call uint64_t OpenSnapshot ();
+
+    free_call void CloseSnapshot (uint64_t version);
+
+    /// Must be called under ::statisticsGuard_.
+    void RebuildColumnSketches ();
 
     const AnyDataId id_;
     Disco::ReadWriteGuard guard_;
     std::string name_;
 
-    // TODO: Replace with flat maps and flat sets (from abseil, for example).
-    std::unordered_map <AnyDataId, Column> columns_;
-    std::unordered_map <AnyDataId, Index> indices_;
-    std::set <AnyDataId> rows_;
+    RowLockTable rowLocks_;
+
+    /// Serializes changes of columns, indices and row set, that are made by intent writers, and cursor
+    /// movements, that read them. Captured only for one operation, so writers wait only for each other's steps.
+    mutable std::mutex intentLatch_;
+
+    Janitor::FlatHashMap <AnyDataId, Column> columns_;
+
+    /// Indices are stored by pointers, because cursors reference them and they own mutexes, so they are not movable.
+    Janitor::FlatHashMap <AnyDataId, std::unique_ptr <Index>> indices_;
+    RowSet rows_;
 
     AnyDataId nextColumnId_;
     AnyDataId nextIndexId_;
     AnyDataId nextRowId_;
 
+    /// Incremented on every row change. Snapshots see values, that were actual at their creation version.
+    uint64_t version_;
+
+    /// Snapshot cursors are used without table guards, therefore all changes of columns and their values
+    /// are done under this mutex. It is captured only for short periods, so writers are never blocked by readers.
+    mutable std::mutex snapshotsGuard_;
+    std::multiset <uint64_t> snapshotVersions_;
+
+    /// Statistics could be requested by several readers at once, so column sketches are rebuilt under this mutex.
+    std::mutex statisticsGuard_;
+    uint64_t statisticsVersion_;
+
+    /// Log of conduit, to which table belongs, or null if changes are not replicated.
+    MutationLog *mutationLog_;
+
+    /// Set by transaction during commit, so its changes are logged only if the whole commit succeeds.
+    std::vector <PendingMutation> *pendingMutations_;
+
     friend class Index;
 
     friend class TableReadCursor;
 
     friend class TableEditCursor;
+
+    friend class TableSnapshotCursor;
+
+    friend class Transaction;
+
+    friend class Predicate;
+
+    friend class Aggregator;
+
+    friend class QueryExecutor;
+
+    friend class HashJoin;
+
+    friend class ConduitBackup;
+
+    friend class PartitionedTable;
+
+    friend class Conduit;
+
+    friend class MutationApplier;
 };
 
 class TableReadCursor
 {
 public:
-    free_call ResultCode Advance (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard, int64_t step);
+    free_call ResultCode Advance (const std::shared_ptr <Disco::SafeLockGuard> &anyGuard, int64_t step);
 
-    free_call ResultCode Get (const std::shared_ptr <Disco::SafeLockGuard> &readOrWriteGuard,
+    /// Values of compressed columns are decoded into cursor buffers, therefore
+    /// their pointers are valid only until next ::Get call for the same column.
+    /// Under intent guard all values are copied into these buffers, because other writers could move them.
+    free_call ResultCode Get (const std::shared_ptr <Disco::SafeLockGuard> &anyGuard,
                               AnyDataId columnId, const AnyDataContainer *&output) const;
 
 protected:
@@ -125,14 +320,31 @@ protected:
 
     free_call ResultCode GetCurrentId (AnyDataId &output) const;
 
+    /// Moves cursor forward to the first matching row, starting from current one. Does nothing without predicate.
+    free_call void SkipNotMatching ();
+
     // TODO: Due to how this cursor is written, it's usage even after table deletion will not lead to
     //       crashes, because base cursor will be invalidated. But maybe this mechanism is too weak.
     Table *const table_;
 
 private:
+    free_call ResultCode AdvanceFiltered (int64_t step);
+
+    /// Returns position of matching row with given number (starting from 1), that lies at or after given
+    /// position, or sequence size if there is no such row. Number is decreased by count of visited matches.
+    free_call uint64_t ScanForward (uint64_t position, uint64_t &number) const;
+
+    /// Backward version of ::ScanForward, that checks rows strictly before given position.
+    free_call uint64_t ScanBackward (uint64_t position, uint64_t &number) const;
+
     std::unique_ptr <IndexCursor> baseCursor_;
+    std::unique_ptr <Predicate> predicate_;
+    /// Node based map, because pointers to decoded values must survive decoding of other columns.
+    mutable std::unordered_map <AnyDataId, AnyDataContainer> decodedValues_;
 
     friend class Table;
+
+    friend class Transaction;
 };
 
 class TableEditCursor final : public TableReadCursor
@@ -143,9 +355,54 @@ public:
 
     free_call ResultCode DeleteCurrent (const std::shared_ptr <Disco::SafeLockGuard> &writeGuard);
 
+    /// Returns lock of current row, see Table::GetRowLock.
+    free_call ResultCode GetCurrentRowLock (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                            Disco::Lock *&output) const;
+
+    /// Intent versions of ::Update and ::DeleteCurrent. Lock of current row must be captured by given row guard,
+    /// otherwise ROW_LOCK_DOES_NOT_COVER_CURRENT_ROW is returned: it happens if other writer moved cursor to
+    /// another row by changing index order after lock request, so lock of new current row should be requested.
+    free_call ResultCode Update (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                 const std::shared_ptr <Disco::SafeLockGuard> &rowGuard,
+                                 moved_in Table::Row &changedValues);
+
+    free_call ResultCode DeleteCurrent (const std::shared_ptr <Disco::SafeLockGuard> &intentGuard,
+                                        const std::shared_ptr <Disco::SafeLockGuard> &rowGuard);
+
 private:
     TableEditCursor (Table *table, IndexCursor *indexCursor);
 
+    /// Checks, that row guard captures lock of current row, if table guard is intent one.
+    free_call ResultCode CheckCurrentRowAccess (const std::shared_ptr <Disco::SafeLockGuard> &tableGuard,
+                                                const std::shared_ptr <Disco::SafeLockGuard> &rowGuard,
+                                                AnyDataId &currentId) const;
+
+    friend class Table;
+};
+
+class TableSnapshotCursor final
+{
+public:
+    ~TableSnapshotCursor ();
+
+    free_call ResultCode Advance (int64_t step);
+
+    /// Copies value of given column for current row. Copy is required, because
+    /// actual value storage could be changed by writer right after this call.
+    free_call ResultCode Get (AnyDataId columnId, AnyDataContainer &output, bool &isNull) const;
+
+    free_call uint64_t GetVersion () const;
+
+private:
+    TableSnapshotCursor (Table *table, uint64_t version, std::shared_ptr <const std::vector <AnyDataId>> order);
+
+    Table *const table_;
+    const uint64_t version_;
+
+    /// Shared with other snapshots, that were created while index order was the same.
+    const std::shared_ptr <const std::vector <AnyDataId>> order_;
+    uint64_t position_;
+
     friend class Table;
 };
 }
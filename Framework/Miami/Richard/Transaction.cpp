@@ -0,0 +1,291 @@
+#include <cassert>
+
+#include <Miami/Evan/Logger.hpp>
+
+#include <Miami/Richard/Replication.hpp>
+#include <Miami/Richard/Transaction.hpp>
+
+namespace Miami::Richard
+{
+const std::vector <AnyDataId> &Transaction::GetTableIds () const
+{
+    return tableIds_;
+}
+
+std::shared_ptr <Disco::SafeLockGuard> Transaction::GetTableWriteGuard (AnyDataId tableId) const
+{
+    const TableData *tableData = FindTableData (tableId);
+    return tableData ? tableData->writeGuard_ : nullptr;
+}
+
+ResultCode Transaction::InsertRow (AnyDataId tableId, Table::Row &row)
+{
+    const TableData *tableData = FindTableData (tableId);
+    if (!tableData)
+    {
+        return ResultCode::TABLE_IS_NOT_COVERED_BY_TRANSACTION;
+    }
+
+    // Validate early, so client receives error right after sending incorrect change.
+    ResultCode validationResult = tableData->table_->ValidateRowChanged (row);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    std::unique_lock <std::mutex> lock (operationsGuard_);
+    operations_.emplace_back (Operation {OperationType::INSERT_ROW, tableData, 0u, std::move (row)});
+    row.clear ();
+    return ResultCode::OK;
+}
+
+ResultCode Transaction::UpdateCurrent (const TableEditCursor *cursor, Table::Row &changedValues)
+{
+    const TableData *tableData = nullptr;
+    AnyDataId rowId;
+    ResultCode result = ExtractCursorTarget (cursor, tableData, rowId);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    ResultCode validationResult = tableData->table_->ValidateRowChanged (changedValues);
+    if (validationResult != ResultCode::OK)
+    {
+        return validationResult;
+    }
+
+    std::unique_lock <std::mutex> lock (operationsGuard_);
+    operations_.emplace_back (Operation {OperationType::UPDATE_ROW, tableData, rowId, std::move (changedValues)});
+    changedValues.clear ();
+    return ResultCode::OK;
+}
+
+ResultCode Transaction::DeleteCurrent (const TableEditCursor *cursor)
+{
+    const TableData *tableData = nullptr;
+    AnyDataId rowId;
+    ResultCode result = ExtractCursorTarget (cursor, tableData, rowId);
+
+    if (result != ResultCode::OK)
+    {
+        return result;
+    }
+
+    std::unique_lock <std::mutex> lock (operationsGuard_);
+    operations_.emplace_back (Operation {OperationType::DELETE_ROW, tableData, rowId, {}});
+    return ResultCode::OK;
+}
+
+ResultCode Transaction::Commit ()
+{
+    std::unique_lock <std::mutex> lock (operationsGuard_);
+    std::vector <UndoRecord> undo;
+    undo.reserve (operations_.size ());
+
+    std::vector <PendingMutation> pendingMutations;
+    SetPendingMutations (&pendingMutations);
+
+    for (Operation &operation : operations_)
+    {
+        ResultCode result = Apply (operation, undo);
+        if (result != ResultCode::OK)
+        {
+            // Reverting changes are buffered too and are dropped together with applied ones.
+            Revert (undo);
+            SetPendingMutations (nullptr);
+            operations_.clear ();
+            return result;
+        }
+    }
+
+    SetPendingMutations (nullptr);
+    operations_.clear ();
+
+    // Tables of one transaction belong to one conduit, therefore they share mutation log.
+    MutationLog *mutationLog = tables_.empty () ? nullptr : tables_.front ().table_->mutationLog_;
+    if (mutationLog && !pendingMutations.empty ())
+    {
+        mutationLog->Append (pendingMutations);
+    }
+
+    return ResultCode::OK;
+}
+
+void Transaction::Rollback ()
+{
+    std::unique_lock <std::mutex> lock (operationsGuard_);
+    operations_.clear ();
+}
+
+Transaction::Transaction (std::vector <TableData> tables)
+    : tables_ (std::move (tables)),
+      tableIds_ (),
+      operationsGuard_ (),
+      operations_ ()
+{
+    tableIds_.reserve (tables_.size ());
+    for (const TableData &tableData : tables_)
+    {
+        assert (tableData.table_);
+        assert (tableData.table_->CheckWriteGuard (tableData.writeGuard_));
+        tableIds_.emplace_back (tableData.table_->GetId ());
+    }
+}
+
+const Transaction::TableData *Transaction::FindTableData (AnyDataId tableId) const
+{
+    // Transactions usually cover only several tables, so linear search is faster than any map.
+    for (const TableData &tableData : tables_)
+    {
+        if (tableData.table_->GetId () == tableId)
+        {
+            return &tableData;
+        }
+    }
+
+    return nullptr;
+}
+
+ResultCode Transaction::ExtractCursorTarget (const TableEditCursor *cursor, const TableData *&tableData,
+                                             AnyDataId &rowId) const
+{
+    assert (cursor);
+    const auto *baseCursor = static_cast <const TableReadCursor *> (cursor);
+    tableData = FindTableData (baseCursor->table_->GetId ());
+
+    if (!tableData)
+    {
+        return ResultCode::TABLE_IS_NOT_COVERED_BY_TRANSACTION;
+    }
+
+    return baseCursor->GetCurrentId (rowId);
+}
+
+ResultCode Transaction::Apply (Transaction::Operation &operation, std::vector <UndoRecord> &undo)
+{
+    Table *table = operation.tableData_->table_;
+    const std::shared_ptr <Disco::SafeLockGuard> &guard = operation.tableData_->writeGuard_;
+    UndoRecord record {operation.type_, operation.tableData_, operation.rowId_, {}, {}};
+
+    switch (operation.type_)
+    {
+        case OperationType::INSERT_ROW:
+        {
+            ResultCode result = table->InsertRow (guard, operation.values_, record.rowId_);
+            if (result != ResultCode::OK)
+            {
+                return result;
+            }
+
+            break;
+        }
+
+        case OperationType::UPDATE_ROW:
+        {
+            for (const auto &columnValuePair : operation.values_)
+            {
+                const AnyDataContainer *oldValue = nullptr;
+                AnyDataContainer buffer;
+
+                if (table->GetColumnValue (columnValuePair.first, operation.rowId_, oldValue, buffer) ==
+                    ResultCode::OK)
+                {
+                    if (oldValue)
+                    {
+                        record.values_.emplace (columnValuePair.first, *oldValue);
+                    }
+                    else
+                    {
+                        record.nullColumns_.emplace_back (columnValuePair.first);
+                    }
+                }
+            }
+
+            ResultCode result = table->UpdateRow (guard, operation.rowId_, operation.values_);
+            if (result != ResultCode::OK)
+            {
+                return result;
+            }
+
+            break;
+        }
+
+        case OperationType::DELETE_ROW:
+        {
+            for (const auto &idColumnPair : table->columns_)
+            {
+                const AnyDataContainer *oldValue = nullptr;
+                AnyDataContainer buffer;
+
+                if (table->GetColumnValue (idColumnPair.first, operation.rowId_, oldValue, buffer) ==
+                    ResultCode::OK && oldValue)
+                {
+                    record.values_.emplace (idColumnPair.first, *oldValue);
+                }
+            }
+
+            ResultCode result = table->DeleteRow (guard, operation.rowId_);
+            if (result != ResultCode::OK)
+            {
+                return result;
+            }
+
+            break;
+        }
+    }
+
+    undo.emplace_back (std::move (record));
+    return ResultCode::OK;
+}
+
+void Transaction::Revert (std::vector <UndoRecord> &undo)
+{
+    for (auto iterator = undo.rbegin (); iterator != undo.rend (); ++iterator)
+    {
+        Table *table = iterator->tableData_->table_;
+        const std::shared_ptr <Disco::SafeLockGuard> &guard = iterator->tableData_->writeGuard_;
+        ResultCode result = ResultCode::OK;
+
+        switch (iterator->type_)
+        {
+            case OperationType::INSERT_ROW:
+                result = table->DeleteRow (guard, iterator->rowId_);
+                break;
+
+            case OperationType::UPDATE_ROW:
+                result = table->UpdateRow (guard, iterator->rowId_, iterator->values_);
+                if (result == ResultCode::OK)
+                {
+                    result = table->EraseRowValues (guard, iterator->rowId_, iterator->nullColumns_);
+                }
+
+                break;
+
+            case OperationType::DELETE_ROW:
+                result = table->RestoreRow (guard, iterator->rowId_, iterator->values_);
+                break;
+        }
+
+        if (result != ResultCode::OK)
+        {
+            Evan::Logger::Get ().Log (
+                Evan::LogLevel::ERROR,
+                "Unable to revert transaction change of row " + std::to_string (iterator->rowId_) + " in table " +
+                std::to_string (table->GetId ()) + ", error " + std::to_string (static_cast <uint64_t> (result)) +
+                "! Table data might be inconsistent now.");
+            assert (false);
+        }
+    }
+
+    undo.clear ();
+}
+void Transaction::SetPendingMutations (std::vector <PendingMutation> *pendingMutations) const
+{
+    for (const TableData &tableData : tables_)
+    {
+        tableData.table_->pendingMutations_ = pendingMutations;
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Miami/Annotations.hpp>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/ResultCode.hpp>
+#include <Miami/Richard/Table.hpp>
+
+namespace Miami::Richard
+{
+/// Buffers row changes for several tables and applies them on commit. Write guards for all transaction tables are
+/// captured at once before transaction creation (see Conduit::PrepareTransaction), therefore transaction holds
+/// exclusive access to its tables during its whole lifetime. If any buffered change fails during commit, all
+/// changes, that were already applied by this commit, are reverted, so commit is atomic. Changes are appended to
+/// mutation log only after successful commit, so replicas never see failed commits.
+class Transaction final
+{
+public:
+    ~Transaction () = default;
+
+    free_call const std::vector <AnyDataId> &GetTableIds () const;
+
+    free_call std::shared_ptr <Disco::SafeLockGuard> GetTableWriteGuard (AnyDataId tableId) const;
+
+    free_call ResultCode InsertRow (AnyDataId tableId, moved_in Table::Row &row);
+
+    /// Buffers update of row, to which given cursor currently points.
+    free_call ResultCode UpdateCurrent (const TableEditCursor *cursor, moved_in Table::Row &changedValues);
+
+    /// Buffers deletion of row, to which given cursor currently points.
+    free_call ResultCode DeleteCurrent (const TableEditCursor *cursor);
+
+    /// Applies all buffered changes. Buffer is cleared even if commit fails.
+    free_call ResultCode Commit ();
+
+    free_call void Rollback ();
+
+private:
+    enum class OperationType
+    {
+        INSERT_ROW = 0,
+        UPDATE_ROW,
+        DELETE_ROW
+    };
+
+    struct TableData
+    {
+        Table *table_;
+        std::shared_ptr <Disco::SafeLockGuard> writeGuard_;
+    };
+
+    struct Operation
+    {
+        OperationType type_;
+        const TableData *tableData_;
+        AnyDataId rowId_;
+        Table::Row values_;
+    };
+
+    /// Describes how to revert applied operation: for updates it contains old values and
+    /// list of columns, that were null, for deletions it contains all values of deleted row.
+    struct UndoRecord
+    {
+        OperationType type_;
+        const TableData *tableData_;
+        AnyDataId rowId_;
+        Table::Row values_;
+        std::vector <AnyDataId> nullColumns_;
+    };
+
+    explicit Transaction (std::vector <TableData> tables);
+
+    free_call const TableData *FindTableData (AnyDataId tableId) const;
+
+    free_call ResultCode ExtractCursorTarget (const TableEditCursor *cursor, const TableData *&tableData,
+                                              AnyDataId &rowId) const;
+
+    free_call ResultCode Apply (Operation &operation, std::vector <UndoRecord> &undo);
+
+    free_call void Revert (std::vector <UndoRecord> &undo);
+
+    /// Redirects logging of all transaction tables to given buffer or back to log if buffer is null.
+    void SetPendingMutations (std::vector <PendingMutation> *pendingMutations) const;
+
+    const std::vector <TableData> tables_;
+    std::vector <AnyDataId> tableIds_;
+
+    std::mutex operationsGuard_;
+    std::vector <Operation> operations_;
+
+    friend class Conduit;
+};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/format.hpp>
 
+#include <atomic>
 #include <cmath>
 #include <thread>
 #include <future>
@@ -105,4 +106,53 @@ BOOST_AUTO_TEST_CASE (LotsOfSeparateTasks)
 #undef PERMUTATION
 }
 
+BOOST_AUTO_TEST_CASE (ParallelForFromExternal)
+{
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    std::vector <std::atomic <uint32_t>> visits (4096u);
+
+    Miami::Disco::ParallelFor (&context, visits.size (), [&visits] (std::size_t index)
+    {
+        ++visits[index];
+    });
+
+    for (const std::atomic <uint32_t> &count : visits)
+    {
+        BOOST_REQUIRE (count == 1u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ParallelForFromTasks)
+{
+    // Every worker runs its own parallel loop, so task pool is always full and loops must not wait for helpers.
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    std::vector <std::vector <uint64_t>> results (TEST_WORKERS_COUNT);
+    std::vector <std::promise <void>> finishes (TEST_WORKERS_COUNT);
+
+    std::function <void (std::size_t)> taskBase = [&context, &results] (std::size_t taskIndex)
+    {
+        std::vector <uint64_t> &result = results[taskIndex];
+        result.resize (1024u, 0u);
+
+        Miami::Disco::ParallelFor (&context, result.size (), [&result, taskIndex] (std::size_t index)
+        {
+            result[index] = index * taskIndex;
+        });
+    };
+
+    for (std::size_t taskIndex = 0; taskIndex < TEST_WORKERS_COUNT; ++taskIndex)
+    {
+        context.Tasks ().Push (FabricateTestableTask (taskBase, finishes[taskIndex], taskIndex));
+    }
+
+    for (std::size_t taskIndex = 0; taskIndex < TEST_WORKERS_COUNT; ++taskIndex)
+    {
+        finishes[taskIndex].get_future ().wait ();
+        for (std::size_t index = 0; index < results[taskIndex].size (); ++index)
+        {
+            BOOST_REQUIRE (results[taskIndex][index] == index * taskIndex);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
\ No newline at end of file
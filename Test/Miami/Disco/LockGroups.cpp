@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/format.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <future>
@@ -208,6 +209,45 @@ BOOST_AUTO_TEST_CASE (ReadAfterWrite)
     }
 }
 
+BOOST_AUTO_TEST_CASE (ReadAfterIntent)
+{
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    {
+        Miami::Disco::ReadWriteGuard readWriteGuard {&context};
+        std::promise <void> intentsAcquired;
+        std::promise <int> readFinished;
+        std::atomic <int> intentsCount {0};
+        std::atomic <int> intentsFinished {0};
+
+        // Second intent is captured while first one is still held, so intents do not block each other.
+        std::function < void (std::shared_ptr <Miami::Disco::SafeLockGuard>) > doIntent =
+            [&intentsAcquired, &intentsCount, &intentsFinished] (const std::shared_ptr <Miami::Disco::SafeLockGuard> &)
+            {
+                using namespace std::chrono_literals;
+                if (++intentsCount == 2)
+                {
+                    intentsAcquired.set_value ();
+                }
+
+                std::this_thread::sleep_for (5ms);
+                ++intentsFinished;
+            };
+
+        Miami::Disco::After (Miami::Disco::AnyLockPointer (&readWriteGuard.Intent ()), doIntent);
+        Miami::Disco::After (Miami::Disco::AnyLockPointer (&readWriteGuard.Intent ()), doIntent);
+        intentsAcquired.get_future ().wait ();
+
+        std::function < void (std::shared_ptr <Miami::Disco::SafeLockGuard>) > doRead =
+            [&readFinished, &intentsFinished] (const std::shared_ptr <Miami::Disco::SafeLockGuard> &)
+            {
+                readFinished.set_value (intentsFinished.load ());
+            };
+
+        Miami::Disco::After (Miami::Disco::AnyLockPointer (&readWriteGuard.Read ()), doRead);
+        BOOST_REQUIRE_EQUAL(readFinished.get_future ().get (), 2);
+    }
+}
+
 BOOST_AUTO_TEST_CASE (AfterBasedReadWriteSwarm)
 {
     Miami::Disco::Context context {TEST_WORKERS_COUNT};
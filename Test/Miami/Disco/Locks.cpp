@@ -116,6 +116,37 @@ BOOST_AUTO_TEST_CASE (NoReadWhileWriting)
     }
 }
 
+BOOST_AUTO_TEST_CASE (MultipleIntentsAllowed)
+{
+    Miami::Disco::Context context {0};
+    {
+        Miami::Disco::ReadWriteGuard readWriteGuard {&context};
+        BOOST_REQUIRE_MESSAGE(readWriteGuard.Intent ().TryLock (), "First intent lock.");
+        BOOST_REQUIRE_MESSAGE(readWriteGuard.Intent ().TryLock (), "Second intent lock.");
+        BOOST_REQUIRE_MESSAGE(!readWriteGuard.Read ().TryLock (), "Read lock while intent.");
+        BOOST_REQUIRE_MESSAGE(!readWriteGuard.Write ().TryLock (), "Write lock while intent.");
+    }
+}
+
+BOOST_AUTO_TEST_CASE (NoIntentWhileReadingOrWriting)
+{
+    Miami::Disco::Context context {0};
+    {
+        Miami::Disco::ReadWriteGuard readWriteGuard {&context};
+        BOOST_REQUIRE(readWriteGuard.Read ().TryLock ());
+        BOOST_REQUIRE(!readWriteGuard.Intent ().TryLock ());
+        readWriteGuard.Read ().Unlock ();
+
+        BOOST_REQUIRE(readWriteGuard.Write ().TryLock ());
+        BOOST_REQUIRE(!readWriteGuard.Intent ().TryLock ());
+        readWriteGuard.Write ().Unlock ();
+
+        BOOST_REQUIRE(readWriteGuard.Intent ().TryLock ());
+        readWriteGuard.Intent ().Unlock ();
+        BOOST_REQUIRE(readWriteGuard.Write ().TryLock ());
+    }
+}
+
 BOOST_AUTO_TEST_CASE (ReadWriteGuardUnlocks)
 {
     Miami::Disco::Context context {0};
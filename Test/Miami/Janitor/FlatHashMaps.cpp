@@ -0,0 +1,183 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Janitor/FlatHashMap.hpp>
+#include <Miami/Janitor/FlatHashSet.hpp>
+
+BOOST_AUTO_TEST_SUITE (FlatHashMaps)
+
+using namespace Miami::Janitor;
+
+template <typename Map, typename Expected>
+static void CheckEqual (const Map &map, const Expected &expected)
+{
+    BOOST_REQUIRE (map.size () == expected.size ());
+    std::size_t iterated = 0u;
+
+    for (const auto &[key, value] : map)
+    {
+        auto iterator = expected.find (key);
+        BOOST_REQUIRE (iterator != expected.end () && iterator->second == value);
+        ++iterated;
+    }
+
+    BOOST_REQUIRE (iterated == expected.size ());
+}
+
+BOOST_AUTO_TEST_CASE (RandomOperations)
+{
+    FlatHashMap <uint64_t, uint64_t> map;
+    std::unordered_map <uint64_t, uint64_t> expected;
+
+    BOOST_REQUIRE (map.empty () && map.begin () == map.end ());
+    BOOST_REQUIRE (map.find (0u) == map.end () && map.erase (0u) == 0u);
+
+    // Small key range gives a lot of repeated insertions and erasures, so deleted slots are reused.
+    std::mt19937_64 random (17u);
+    for (uint64_t step = 0u; step < 200000u; ++step)
+    {
+        const uint64_t key = random () % 5000u;
+        switch (random () % 4u)
+        {
+            case 0u:
+            {
+                BOOST_REQUIRE (map.emplace (key, step).second == expected.emplace (key, step).second);
+                break;
+            }
+
+            case 1u:
+            {
+                map[key] = step;
+                expected[key] = step;
+                break;
+            }
+
+            case 2u:
+            {
+                BOOST_REQUIRE (map.erase (key) == expected.erase (key));
+                break;
+            }
+
+            default:
+            {
+                auto iterator = map.find (key);
+                BOOST_REQUIRE ((iterator == map.end ()) == (expected.count (key) == 0u));
+                BOOST_REQUIRE (iterator == map.end () || iterator->second == expected.at (key));
+                break;
+            }
+        }
+    }
+
+    CheckEqual (map, expected);
+
+    // Erasure through iterators does not skip elements.
+    for (auto iterator = map.begin (); iterator != map.end ();)
+    {
+        if (iterator->first % 2u == 0u)
+        {
+            expected.erase (iterator->first);
+            iterator = map.erase (iterator);
+        }
+        else
+        {
+            ++iterator;
+        }
+    }
+
+    CheckEqual (map, expected);
+    map.clear ();
+    BOOST_REQUIRE (map.empty () && map.begin () == map.end ());
+}
+
+BOOST_AUTO_TEST_CASE (CopyMoveAndReserve)
+{
+    FlatHashMap <uint64_t, std::string> map {{1u, "one"}, {2u, "two"}, {3u, "three"}};
+    FlatHashMap <uint64_t, std::string> copy = map;
+    copy[4u] = "four";
+
+    BOOST_REQUIRE (map.size () == 3u && copy.size () == 4u);
+    BOOST_REQUIRE (copy.at (2u) == "two" && map.count (4u) == 0u);
+
+    FlatHashMap <uint64_t, std::string> moved = std::move (copy);
+    BOOST_REQUIRE (moved.size () == 4u && moved.at (4u) == "four");
+
+    map = moved;
+    BOOST_REQUIRE (map.size () == 4u && map.at (3u) == "three");
+    BOOST_CHECK_THROW (map.at (5u), std::out_of_range);
+
+    // Reserved table is not rehashed until requested count is reached.
+    FlatHashMap <uint64_t, std::unique_ptr <uint64_t>> pointers;
+    pointers.reserve (1000u);
+    const std::size_t capacity = pointers.capacity ();
+
+    for (uint64_t key = 0u; key < 1000u; ++key)
+    {
+        BOOST_REQUIRE (pointers.try_emplace (key, std::make_unique <uint64_t> (key)).second);
+        BOOST_REQUIRE (!pointers.try_emplace (key, nullptr).second);
+    }
+
+    BOOST_REQUIRE (pointers.capacity () == capacity);
+    for (const auto &[key, pointer] : pointers)
+    {
+        BOOST_REQUIRE (*pointer == key);
+    }
+}
+
+struct StringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator () (std::string_view string) const
+    {
+        return std::hash <std::string_view> () (string);
+    }
+};
+
+BOOST_AUTO_TEST_CASE (HeterogeneousLookup)
+{
+    FlatHashMap <std::string, int, StringHash, std::equal_to <>> map;
+    map.emplace ("first", 1);
+    map.emplace ("second", 2);
+
+    // Lookups by string view do not construct temporary strings.
+    std::string_view key = "second";
+    BOOST_REQUIRE (map.find (key) != map.end () && map.find (key)->second == 2);
+    BOOST_REQUIRE (map.count (std::string_view ("third")) == 0u);
+    BOOST_REQUIRE (map.at (std::string_view ("first")) == 1);
+    BOOST_REQUIRE (map.erase (key) == 1u && map.size () == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (Sets)
+{
+    FlatHashSet <const void *> set;
+    int values[100];
+
+    for (int &value : values)
+    {
+        BOOST_REQUIRE (set.insert (&value).second);
+    }
+
+    BOOST_REQUIRE (!set.insert (&values[10]).second);
+    BOOST_REQUIRE (set.size () == 100u && set.contains (&values[99]));
+
+    for (int index = 0; index < 100; index += 2)
+    {
+        BOOST_REQUIRE (set.erase (&values[index]) == 1u);
+    }
+
+    std::size_t count = 0u;
+    for (const void *pointer : set)
+    {
+        BOOST_REQUIRE ((static_cast <const int *> (pointer) - values) % 2 == 1);
+        ++count;
+    }
+
+    BOOST_REQUIRE (count == 50u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,182 @@
+#include <cstring>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Aggregations)
+
+using namespace Miami::Richard;
+
+static AggregationQuery MakeQuery (std::vector <AnyDataId> groupColumns, std::vector <AggregateInfo> aggregates)
+{
+    AggregationQuery query;
+    query.groupColumns_ = std::move (groupColumns);
+    query.aggregates_ = std::move (aggregates);
+    return query;
+}
+
+BOOST_FIXTURE_TEST_CASE (AggregatesWithoutGrouping, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    AnyDataId compressedColumn;
+    BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT32, "compressed", 0u, false, true}, compressedColumn) ==
+                   ResultCode::OK);
+
+    AggregationQuery query = MakeQuery (
+        {}, {{AggregateFunction::COUNT_ROWS}, {AggregateFunction::COUNT, valueColumn},
+             {AggregateFunction::SUM, valueColumn}, {AggregateFunction::MIN, valueColumn},
+             {AggregateFunction::MAX, compressedColumn}, {AggregateFunction::AVG, compressedColumn}});
+
+    // Table without rows still has one group, but MIN, MAX and AVG are null.
+    std::vector <AggregateGroup> groups;
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups.size () == 1u && groups[0].key_.empty ());
+    for (const AggregateResult &result : groups[0].results_)
+    {
+        BOOST_REQUIRE (result.count_ == 0u);
+    }
+
+    // Several batches: values are -key, every fifth row has null value and compressed value is key * 2.
+    for (int64_t key = 0; key < 300; ++key)
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        if (key % 5 != 0)
+        {
+            row.emplace (valueColumn, MakeInt64 (-key));
+        }
+
+        AnyDataContainer compressed (DataType::INT32);
+        *static_cast <int32_t *> (compressed.GetDataStartPointer ()) = static_cast <int32_t> (key * 2);
+        row.emplace (compressedColumn, std::move (compressed));
+        BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups.size () == 1u);
+
+    const std::vector <AggregateResult> &results = groups[0].results_;
+    BOOST_REQUIRE (results[0].count_ == 300u);
+    BOOST_REQUIRE (results[1].count_ == 240u);
+
+    // Sum of all keys minus sum of keys, divisible by five.
+    BOOST_REQUIRE (results[2].count_ == 240u && results[2].value_ == -(44850 - 8850));
+    BOOST_REQUIRE (results[3].count_ == 240u && results[3].value_ == -299);
+    BOOST_REQUIRE (results[4].count_ == 300u && results[4].value_ == 598);
+    BOOST_REQUIRE (results[5].count_ == 300u && results[5].value_ == 89700);
+
+    // Predicate is applied before aggregation.
+    query.predicate_ = Predicate ({{PredicateOperation::GREATER_OR_EQUAL, keyColumn, MakeInt64 (290)}});
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups[0].results_[0].count_ == 10u);
+    BOOST_REQUIRE (groups[0].results_[2].count_ == 8u && groups[0].results_[2].value_ == -(2945 - 585));
+    BOOST_REQUIRE (groups[0].results_[3].value_ == -299);
+    BOOST_REQUIRE (groups[0].results_[4].value_ == 598);
+}
+
+BOOST_FIXTURE_TEST_CASE (GroupBy, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    AnyDataId groupColumn;
+    BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::VARCHAR, "group", 0u, true}, groupColumn) ==
+                   ResultCode::OK);
+
+    const char *names[] {"even", "odd"};
+    for (int64_t key = 0; key < 200; ++key)
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        row.emplace (valueColumn, MakeInt64 (key));
+
+        // Every tenth row belongs to null group.
+        if (key % 10 != 0)
+        {
+            AnyDataContainer name (DataType::VARCHAR);
+            name.ResizeData (static_cast <uint32_t> (strlen (names[key % 2])));
+            memcpy (name.GetDataStartPointer (), names[key % 2], name.GetDataSize ());
+            row.emplace (groupColumn, std::move (name));
+        }
+
+        BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    std::vector <AggregateGroup> groups;
+    BOOST_REQUIRE (table->Aggregate (
+        guard, MakeQuery ({groupColumn}, {{AggregateFunction::COUNT_ROWS}, {AggregateFunction::MAX, valueColumn}}),
+        groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups.size () == 3u);
+
+    bool found[3] {false, false, false};
+    for (const AggregateGroup &group : groups)
+    {
+        auto iterator = group.key_.find (groupColumn);
+        if (iterator == group.key_.end ())
+        {
+            found[2] = true;
+            BOOST_REQUIRE (group.results_[0].count_ == 20u && group.results_[1].value_ == 190);
+            continue;
+        }
+
+        std::string name (static_cast <const char *> (iterator->second.GetDataStartPointer ()),
+                          iterator->second.GetDataSize ());
+        const std::size_t nameIndex = name == names[0] ? 0u : 1u;
+
+        BOOST_REQUIRE (name == names[nameIndex] && !found[nameIndex]);
+        BOOST_REQUIRE (group.results_[0].count_ == (nameIndex == 0u ? 80u : 100u));
+        BOOST_REQUIRE (group.results_[1].value_ == (nameIndex == 0u ? 198 : 199));
+        found[nameIndex] = true;
+    }
+
+    BOOST_REQUIRE (found[0] && found[1] && found[2]);
+
+    // Aggregates over values are supported only by integer columns.
+    BOOST_REQUIRE (table->Aggregate (guard, MakeQuery ({}, {{AggregateFunction::SUM, groupColumn}}), groups) ==
+                   ResultCode::AGGREGATE_COLUMN_MUST_BE_INTEGER);
+    BOOST_REQUIRE (table->Aggregate (guard, MakeQuery ({}, {{AggregateFunction::COUNT, groupColumn}}), groups) ==
+                   ResultCode::OK);
+    BOOST_REQUIRE (groups[0].results_[0].count_ == 180u);
+}
+
+BOOST_FIXTURE_TEST_CASE (IndexRange, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 500; ++key)
+    {
+        InsertRow (guard, key, 1);
+    }
+
+    AggregationQuery query = MakeQuery (
+        {}, {{AggregateFunction::SUM, valueColumn}, {AggregateFunction::MIN, keyColumn}});
+    query.indexId_ = keyIndex;
+    query.hasLowerBound_ = true;
+    query.lowerBound_.emplace (keyColumn, MakeInt64 (100));
+    query.hasUpperBound_ = true;
+    query.upperBound_.emplace (keyColumn, MakeInt64 (250));
+
+    std::vector <AggregateGroup> groups;
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups[0].results_[0].value_ == 150 && groups[0].results_[1].value_ == 100);
+
+    // Only lower bound: range continues to the end of index.
+    query.hasUpperBound_ = false;
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups[0].results_[0].value_ == 400);
+
+    // Upper bound, that is less than lower bound, gives empty range.
+    query.hasUpperBound_ = true;
+    query.upperBound_[keyColumn] = MakeInt64 (50);
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::OK);
+    BOOST_REQUIRE (groups[0].results_[0].count_ == 0u);
+
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "hash", {keyColumn}, IndexType::HASH}, hashIndex) == ResultCode::OK);
+    query.indexId_ = hashIndex;
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION);
+
+    query.indexId_ = keyIndex;
+    query.upperBound_.emplace (valueColumn, MakeInt64 (0));
+    BOOST_REQUIRE (table->Aggregate (guard, query, groups) == ResultCode::LOOKUP_KEY_COLUMN_IS_NOT_INDEXED);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
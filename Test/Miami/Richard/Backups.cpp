@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Richard/Backup.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Backups)
+
+using namespace Miami::Richard;
+
+static AnyDataContainer MakeString (DataType type, const std::string &value)
+{
+    AnyDataContainer container (type);
+    if (IsVariableSizeDataType (type))
+    {
+        container.ResizeData (static_cast <uint32_t> (value.size ()));
+    }
+
+    memcpy (container.GetDataStartPointer (), value.data (), value.size ());
+    return container;
+}
+
+static Table *GetTable (Conduit &conduit, const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard,
+                        AnyDataId tableId)
+{
+    Table *table = nullptr;
+    BOOST_REQUIRE (conduit.GetTable (guard, tableId, table) == ResultCode::OK);
+    return table;
+}
+
+/// Describes schemas and rows of all tables in order of their ids, so conduits could be compared.
+static std::string Dump (Conduit &conduit)
+{
+    auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Read ()));
+    std::vector <AnyDataId> tableIds;
+    BOOST_REQUIRE (conduit.GetTableIds (conduitGuard, tableIds) == ResultCode::OK);
+    std::sort (tableIds.begin (), tableIds.end ());
+    std::string output;
+
+    for (AnyDataId tableId : tableIds)
+    {
+        Table *table = GetTable (conduit, conduitGuard, tableId);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()));
+
+        std::string name;
+        BOOST_REQUIRE (table->GetName (guard, name) == ResultCode::OK);
+        output += "table " + std::to_string (tableId) + " " + name + "\n";
+
+        std::vector <AnyDataId> columnIds;
+        BOOST_REQUIRE (table->GetColumnsIds (guard, columnIds) == ResultCode::OK);
+        std::sort (columnIds.begin (), columnIds.end ());
+
+        for (AnyDataId columnId : columnIds)
+        {
+            ColumnInfo info;
+            BOOST_REQUIRE (table->GetColumnInfo (guard, columnId, info) == ResultCode::OK);
+            output += "column " + std::to_string (info.id_) + " " + info.name_ + " " +
+                      GetDataTypeName (info.dataType_) + " " + std::to_string (info.maxSize_) + " " +
+                      std::to_string (info.dictionaryEncoded_) + std::to_string (info.compressed_) + "\n";
+        }
+
+        std::vector <AnyDataId> indexIds;
+        BOOST_REQUIRE (table->GetIndicesIds (guard, indexIds) == ResultCode::OK);
+        std::sort (indexIds.begin (), indexIds.end ());
+
+        for (AnyDataId indexId : indexIds)
+        {
+            IndexInfo info;
+            BOOST_REQUIRE (table->GetIndexInfo (guard, indexId, info) == ResultCode::OK);
+            output += "index " + std::to_string (info.id_) + " " + info.name_ + " " +
+                      GetIndexTypeName (info.type_) + " " + std::to_string (info.unique_);
+
+            for (AnyDataId columnId : info.columns_)
+            {
+                output += " " + std::to_string (columnId);
+            }
+
+            output += "\n";
+        }
+
+        if (columnIds.empty ())
+        {
+            continue;
+        }
+
+        QueryPlan plan;
+        plan.projection_ = columnIds;
+
+        BOOST_REQUIRE (table->ExecuteQuery (
+            guard, plan, nullptr,
+            [&output] (QueryBatch &batch)
+            {
+                for (std::size_t index = 0u; index < batch.values_.size (); ++index)
+                {
+                    const AnyDataContainer &value = batch.values_[index];
+                    output += batch.nulls_[index] ? std::string ("null") : std::string (
+                        static_cast <const char *> (value.GetDataStartPointer ()), value.GetDataSize ());
+                    output += (index + 1u) % batch.columnsCount_ == 0u ? "\n" : "|";
+                }
+
+                return true;
+            }) == ResultCode::OK);
+    }
+
+    return output;
+}
+
+/// Conduit with two tables. First one has INT64 key, VARCHAR name, dictionary encoded code and compressed INT32
+/// amount columns, unique ordered index over key and hash index over code. Second one has no rows.
+class BackupCheckCommons
+{
+public:
+    BackupCheckCommons ()
+        : conduit (&context),
+          path ((std::filesystem::temp_directory_path () / "MiamiBackupTest.bin").string ())
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (conduit.AddTable (conduitGuard, "Facts", tableIds[0]) == ResultCode::OK);
+        BOOST_REQUIRE (conduit.AddTable (conduitGuard, "Empty", tableIds[1]) == ResultCode::OK);
+
+        Table *facts = GetTable (conduit, conduitGuard, tableIds[0]);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&facts->ReadWriteGuard ().Write ()));
+
+        // Removed column leaves gap in column ids, that must be kept by restore.
+        AnyDataId removedColumn = 0;
+        BOOST_REQUIRE (facts->AddColumn (guard, {0, DataType::INT8, "removed"}, removedColumn) == ResultCode::OK);
+        BOOST_REQUIRE (facts->RemoveColumn (guard, removedColumn) == ResultCode::OK);
+
+        ColumnInfo codeInfo {0, DataType::SHORT_STRING, "code"};
+        codeInfo.dictionaryEncoded_ = true;
+        ColumnInfo amountInfo {0, DataType::INT32, "amount"};
+        amountInfo.compressed_ = true;
+
+        BOOST_REQUIRE (facts->AddColumn (guard, {0, DataType::INT64, "key"}, keyColumn) == ResultCode::OK);
+        BOOST_REQUIRE (facts->AddColumn (guard, {0, DataType::VARCHAR, "name", 32u}, nameColumn) == ResultCode::OK);
+        BOOST_REQUIRE (facts->AddColumn (guard, codeInfo, codeColumn) == ResultCode::OK);
+        BOOST_REQUIRE (facts->AddColumn (guard, amountInfo, amountColumn) == ResultCode::OK);
+
+        BOOST_REQUIRE (facts->AddIndex (guard, {0, "key", {keyColumn}, IndexType::ORDERED, true}, keyIndex) ==
+                       ResultCode::OK);
+        BOOST_REQUIRE (facts->AddIndex (guard, {0, "code", {codeColumn}, IndexType::HASH}, codeIndex) ==
+                       ResultCode::OK);
+
+        for (int64_t key = 0; key < 3000; ++key)
+        {
+            Table::Row row;
+            row.emplace (keyColumn, MakeInt64 (key));
+            row.emplace (codeColumn, MakeString (DataType::SHORT_STRING, "c" + std::to_string (key % 7)));
+
+            if (key % 5 != 0)
+            {
+                row.emplace (nameColumn, MakeString (DataType::VARCHAR, "name-" + std::to_string (key)));
+            }
+
+            if (key % 4 != 0)
+            {
+                AnyDataContainer amount (DataType::INT32);
+                *static_cast <int32_t *> (amount.GetDataStartPointer ()) = static_cast <int32_t> (key * 3);
+                row.emplace (amountColumn, std::move (amount));
+            }
+
+            BOOST_REQUIRE (facts->InsertRow (guard, row) == ResultCode::OK);
+        }
+
+        guard = CaptureGuard (
+            Miami::Disco::AnyLockPointer (&GetTable (conduit, conduitGuard, tableIds[1])->ReadWriteGuard ().Write ()));
+        AnyDataId flagColumn = 0;
+        BOOST_REQUIRE (GetTable (conduit, conduitGuard, tableIds[1])->AddColumn (
+            guard, {0, DataType::INT8, "flag"}, flagColumn) == ResultCode::OK);
+    }
+
+    ~BackupCheckCommons ()
+    {
+        std::remove (path.c_str ());
+    }
+
+    std::unique_ptr <ConduitBackup> BeginBackup ()
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Read ()));
+        std::vector <AnyDataId> ids;
+        std::vector <Miami::Disco::AnyLockPointer> locks;
+
+        BOOST_REQUIRE (conduit.PrepareBackup (conduitGuard, ids, locks) == ResultCode::OK);
+        BOOST_REQUIRE (ids.size () == 2u && locks.size () == 2u);
+
+        ConduitBackup *backup = nullptr;
+        BOOST_REQUIRE (conduit.BeginBackup (conduitGuard, ids, CaptureGuards (locks), backup) == ResultCode::OK);
+        return std::unique_ptr <ConduitBackup> (backup);
+    }
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    Conduit conduit;
+    std::string path;
+
+    AnyDataId tableIds[2] {};
+    AnyDataId keyColumn = 0;
+    AnyDataId nameColumn = 0;
+    AnyDataId codeColumn = 0;
+    AnyDataId amountColumn = 0;
+    AnyDataId keyIndex = 0;
+    AnyDataId codeIndex = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE (ImageIgnoresLaterChanges, BackupCheckCommons)
+{
+    const std::string expected = Dump (conduit);
+    std::unique_ptr <ConduitBackup> backup = BeginBackup ();
+
+    {
+        // Tables are writable, because backup does not hold any guard.
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Read ()));
+        Table *facts = GetTable (conduit, conduitGuard, tableIds[0]);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&facts->ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (!facts->IsSafeToRemove (guard));
+
+        TableEditCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (facts->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+        std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+        Table::Row changes;
+        changes.emplace (nameColumn, MakeString (DataType::VARCHAR, "changed"));
+        changes.emplace (amountColumn, AnyDataContainer (DataType::INT32));
+        BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+
+        BOOST_REQUIRE (cursor->Advance (guard, 1) == ResultCode::OK);
+        BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (5000));
+        BOOST_REQUIRE (facts->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    BOOST_REQUIRE (Dump (conduit) != expected);
+    BOOST_REQUIRE (backup->WriteToFile (path, &context) == ResultCode::OK);
+    backup.reset ();
+
+    for (Miami::Disco::Context *workers : {static_cast <Miami::Disco::Context *> (nullptr), &context})
+    {
+        Conduit restored (&context);
+        {
+            auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&restored.ReadWriteGuard ().Write ()));
+            BOOST_REQUIRE (restored.RestoreBackup (guard, path, workers) == ResultCode::OK);
+            BOOST_REQUIRE (restored.RestoreBackup (guard, path, workers) ==
+                           ResultCode::BACKUP_RESTORE_REQUIRES_EMPTY_CONDUIT);
+        }
+
+        BOOST_REQUIRE (Dump (restored) == expected);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE (RestoredTablesAreUsable, BackupCheckCommons)
+{
+    BOOST_REQUIRE (BeginBackup ()->WriteToFile (path, &context) == ResultCode::OK);
+    Conduit restored (&context);
+
+    auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&restored.ReadWriteGuard ().Write ()));
+    BOOST_REQUIRE (restored.RestoreBackup (conduitGuard, path, &context) == ResultCode::OK);
+
+    AnyDataId tableId = 0;
+    BOOST_REQUIRE (restored.AddTable (conduitGuard, "New", tableId) == ResultCode::OK);
+    BOOST_REQUIRE (tableId == 2u);
+
+    Table *facts = GetTable (restored, conduitGuard, tableIds[0]);
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&facts->ReadWriteGuard ().Write ()));
+
+    // Hash index is rebuilt from restored rows.
+    Table::Row key;
+    key.emplace (codeColumn, MakeString (DataType::SHORT_STRING, "c3"));
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (facts->CreateLookupCursor (guard, codeIndex, key, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    int64_t count = 0;
+    const AnyDataContainer *value = nullptr;
+
+    while (cursor->Get (guard, keyColumn, value) == ResultCode::OK)
+    {
+        BOOST_REQUIRE (value && ReadInt64 (*value) % 7 == 3);
+        cursor->Advance (guard, 1);
+        ++count;
+    }
+
+    BOOST_REQUIRE (count == 429);
+    cursor.reset ();
+
+    // Unique index is still checked and ids continue after restored ones.
+    Table::Row row;
+    row.emplace (keyColumn, MakeInt64 (10));
+    BOOST_REQUIRE (facts->InsertRow (guard, row) == ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+
+    Table::Row newRow;
+    newRow.emplace (keyColumn, MakeInt64 (3000));
+    BOOST_REQUIRE (facts->InsertRow (guard, newRow) == ResultCode::OK);
+
+    AnyDataId columnId = 0;
+    BOOST_REQUIRE (facts->AddColumn (guard, {0, DataType::INT8, "new"}, columnId) == ResultCode::OK);
+    BOOST_REQUIRE (columnId == amountColumn + 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE (BrokenFiles, BackupCheckCommons)
+{
+    Conduit restored (&context);
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&restored.ReadWriteGuard ().Write ()));
+    BOOST_REQUIRE (restored.RestoreBackup (guard, path, &context) == ResultCode::BACKUP_FILE_READ_FAILED);
+
+    BOOST_REQUIRE (BeginBackup ()->WriteToFile (path, &context) == ResultCode::OK);
+    std::string content;
+    {
+        std::ifstream input (path, std::ios::binary);
+        content.assign (std::istreambuf_iterator <char> (input), std::istreambuf_iterator <char> ());
+    }
+
+    auto check = [&restored, &guard, this] (const std::string &brokenContent)
+    {
+        {
+            std::ofstream output (path, std::ios::binary | std::ios::trunc);
+            output.write (brokenContent.data (), static_cast <std::streamsize> (brokenContent.size ()));
+        }
+
+        BOOST_REQUIRE (restored.RestoreBackup (guard, path, &context) == ResultCode::BACKUP_FILE_IS_MALFORMED);
+
+        // Nothing is added to conduit from broken file.
+        std::vector <AnyDataId> tableIds;
+        BOOST_REQUIRE (restored.GetTableIds (guard, tableIds) == ResultCode::OK);
+        BOOST_REQUIRE (tableIds.empty ());
+    };
+
+    check (content.substr (0u, content.size () / 2u));
+    check (content + "x");
+    check ("X" + content.substr (1u));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,194 @@
+#include <cstring>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (DictionaryEncoding)
+
+using namespace Miami::Richard;
+
+static AnyDataContainer MakeVarchar (const std::string &value)
+{
+    AnyDataContainer container (DataType::VARCHAR);
+    container.ResizeData (static_cast <uint32_t> (value.size ()));
+    memcpy (container.GetDataStartPointer (), value.data (), value.size ());
+    return container;
+}
+
+static std::string ReadVarchar (const AnyDataContainer &container)
+{
+    return std::string (static_cast <const char *> (container.GetDataStartPointer ()), container.GetDataSize ());
+}
+
+/// Table with encoded "city" column, plain INT64 "id" column and ordered index over "city".
+class EncodedTableCommons
+{
+public:
+    EncodedTableCommons ()
+    {
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table.ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::VARCHAR, "city", 0u, true}, cityColumn) ==
+                       ResultCode::OK);
+        BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::INT64, "id"}, idColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table.AddIndex (guard, {0, "city", {cityColumn}}, cityIndex) == ResultCode::OK);
+    }
+
+    void InsertRow (const std::shared_ptr <Miami::Disco::SafeLockGuard> &writeGuard,
+                    const std::string &city, int64_t id)
+    {
+        Table::Row row;
+        row.emplace (cityColumn, MakeVarchar (city));
+        row.emplace (idColumn, MakeInt64 (id));
+        BOOST_REQUIRE (table.InsertRow (writeGuard, row) == ResultCode::OK);
+    }
+
+    std::size_t GetDictionarySize (const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard)
+    {
+        std::size_t size = 0u;
+        BOOST_REQUIRE (table.GetColumnDictionarySize (guard, cityColumn, size) == ResultCode::OK);
+        return size;
+    }
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    Table table {&context, 0, "Test"};
+
+    AnyDataId cityColumn = 0;
+    AnyDataId idColumn = 0;
+    AnyDataId cityIndex = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE (SharedValues, EncodedTableCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table.ReadWriteGuard ().Write ()));
+    AnyDataId column;
+    BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::INT32, "encoded", 0u, true}, column) ==
+                   ResultCode::DICTIONARY_ENCODING_IS_NOT_SUPPORTED_BY_TYPE);
+
+    InsertRow (guard, "Paris", 1);
+    InsertRow (guard, "Berlin", 2);
+    InsertRow (guard, "Paris", 3);
+    BOOST_REQUIRE (GetDictionarySize (guard) == 2u);
+
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table.CreateEditCursor (guard, cityIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+    // Cursor is on "Berlin" now, next two rows are "Paris" and must share value storage.
+    BOOST_REQUIRE (cursor->Advance (guard, 1) == ResultCode::OK);
+    const AnyDataContainer *first = nullptr;
+    BOOST_REQUIRE (cursor->Get (guard, cityColumn, first) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->Advance (guard, 1) == ResultCode::OK);
+    const AnyDataContainer *second = nullptr;
+    BOOST_REQUIRE (cursor->Get (guard, cityColumn, second) == ResultCode::OK);
+    BOOST_REQUIRE (first == second && ReadVarchar (*first) == "Paris");
+
+    // Value is removed from dictionary only after its last usage.
+    BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+    BOOST_REQUIRE (GetDictionarySize (guard) == 2u);
+    BOOST_REQUIRE (cursor->Advance (guard, -1) == ResultCode::OK);
+
+    Table::Row changes;
+    changes.emplace (cityColumn, MakeVarchar ("Berlin"));
+    BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+    BOOST_REQUIRE (GetDictionarySize (guard) == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE (EqualityPredicates, EncodedTableCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table.ReadWriteGuard ().Write ()));
+    InsertRow (guard, "Paris", 1);
+    InsertRow (guard, "Berlin", 2);
+    InsertRow (guard, "Paris", 3);
+
+    Table::Row nullCity;
+    nullCity.emplace (idColumn, MakeInt64 (4));
+    BOOST_REQUIRE (table.InsertRow (guard, nullCity) == ResultCode::OK);
+
+    auto count = [this, &guard] (PredicateOperation operation, const std::string &city)
+    {
+        TableReadCursor *rawCursor = nullptr;
+        Predicate predicate ({{operation, cityColumn, MakeVarchar (city)}});
+        BOOST_REQUIRE (table.CreateFilteredReadCursor (guard, cityIndex, predicate, rawCursor) == ResultCode::OK);
+        std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+        std::size_t matched = 0u;
+        const AnyDataContainer *id = nullptr;
+
+        while (cursor->Get (guard, idColumn, id) == ResultCode::OK)
+        {
+            ++matched;
+            cursor->Advance (guard, 1);
+        }
+
+        return matched;
+    };
+
+    BOOST_REQUIRE (count (PredicateOperation::EQUAL, "Paris") == 2u);
+    BOOST_REQUIRE (count (PredicateOperation::NOT_EQUAL, "Paris") == 1u);
+    BOOST_REQUIRE (count (PredicateOperation::EQUAL, "Rome") == 0u);
+    BOOST_REQUIRE (count (PredicateOperation::NOT_EQUAL, "Rome") == 3u);
+    BOOST_REQUIRE (count (PredicateOperation::LESS, "Paris") == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE (IndicesAndSnapshots, EncodedTableCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table.ReadWriteGuard ().Write ()));
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table.AddIndex (guard, {0, "hash", {cityColumn}, IndexType::HASH}, hashIndex) == ResultCode::OK);
+
+    InsertRow (guard, "Rome", 1);
+    InsertRow (guard, "Berlin", 2);
+    InsertRow (guard, "Paris", 3);
+    InsertRow (guard, "Berlin", 4);
+
+    Table::Row key;
+    key.emplace (cityColumn, MakeVarchar ("Berlin"));
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table.CreateLookupCursor (guard, hashIndex, key, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> lookup (rawCursor);
+
+    TableSnapshotCursor *rawSnapshot = nullptr;
+    BOOST_REQUIRE (table.CreateSnapshotCursor (guard, cityIndex, rawSnapshot) == ResultCode::OK);
+    std::unique_ptr <TableSnapshotCursor> snapshot (rawSnapshot);
+
+    // Ordered index compares values, not codes.
+    const std::string expectedOrder[] {"Berlin", "Berlin", "Paris", "Rome"};
+    TableEditCursor *rawEditCursor = nullptr;
+    BOOST_REQUIRE (table.CreateEditCursor (guard, cityIndex, rawEditCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawEditCursor);
+
+    for (const std::string &expected : expectedOrder)
+    {
+        const AnyDataContainer *value = nullptr;
+        BOOST_REQUIRE (cursor->Get (guard, cityColumn, value) == ResultCode::OK);
+        BOOST_REQUIRE (value && ReadVarchar (*value) == expected);
+        cursor->Advance (guard, 1);
+    }
+
+    // Last row is removed, so "Rome" disappears from dictionary, but snapshot still sees it.
+    BOOST_REQUIRE (cursor->Advance (guard, -1) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+    BOOST_REQUIRE (GetDictionarySize (guard) == 2u);
+
+    AnyDataContainer value;
+    bool isNull = true;
+    BOOST_REQUIRE (snapshot->Advance (3) == ResultCode::OK);
+    BOOST_REQUIRE (snapshot->Get (cityColumn, value, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && ReadVarchar (value) == "Rome");
+
+    std::size_t found = 0u;
+    const AnyDataContainer *city = nullptr;
+
+    while (lookup->Get (guard, cityColumn, city) == ResultCode::OK)
+    {
+        BOOST_REQUIRE (city && ReadVarchar (*city) == "Berlin");
+        ++found;
+        lookup->Advance (guard, 1);
+    }
+
+    BOOST_REQUIRE (found == 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,170 @@
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (HashIndices)
+
+using namespace Miami::Richard;
+
+/// Collects values of given column for all rows, returned by lookup over given index.
+static std::vector <int64_t> Lookup (Table *table, const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard,
+                                     AnyDataId indexId, AnyDataId keyColumn, int64_t key, AnyDataId valueColumn)
+{
+    Table::Row lookupKey;
+    lookupKey.emplace (keyColumn, MakeInt64 (key));
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateLookupCursor (guard, indexId, lookupKey, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    std::vector <int64_t> values;
+    const AnyDataContainer *value = nullptr;
+
+    while (cursor->Get (guard, valueColumn, value) == ResultCode::OK)
+    {
+        BOOST_REQUIRE (value);
+        values.push_back (ReadInt64 (*value));
+        cursor->Advance (guard, 1);
+    }
+
+    std::sort (values.begin (), values.end ());
+    return values;
+}
+
+BOOST_FIXTURE_TEST_CASE (LookupFollowsRowChanges, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    InsertRow (guard, 1, 10);
+    InsertRow (guard, 2, 20);
+
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "keyHash", {keyColumn}, IndexType::HASH}, hashIndex) ==
+                   ResultCode::OK);
+
+    InsertRow (guard, 1, 11);
+    BOOST_REQUIRE ((Lookup (table.get (), guard, hashIndex, keyColumn, 1, valueColumn) ==
+                    std::vector <int64_t> {10, 11}));
+    BOOST_REQUIRE ((Lookup (table.get (), guard, hashIndex, keyColumn, 3, valueColumn).empty ()));
+
+    Table::Row lookupKey;
+    lookupKey.emplace (keyColumn, MakeInt64 (2));
+    TableEditCursor *rawEditCursor = nullptr;
+    BOOST_REQUIRE (table->CreateLookupEditCursor (guard, hashIndex, lookupKey, rawEditCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> editCursor (rawEditCursor);
+
+    // Row stops matching cursor key after update, so cursor reaches its end.
+    Table::Row changes;
+    changes.emplace (keyColumn, MakeInt64 (1));
+    BOOST_REQUIRE (editCursor->Update (guard, changes) == ResultCode::OK);
+
+    const AnyDataContainer *value = nullptr;
+    BOOST_REQUIRE (editCursor->Get (guard, valueColumn, value) == ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END);
+    editCursor.reset ();
+
+    BOOST_REQUIRE ((Lookup (table.get (), guard, hashIndex, keyColumn, 1, valueColumn) ==
+                    std::vector <int64_t> {10, 11, 20}));
+    BOOST_REQUIRE ((Lookup (table.get (), guard, hashIndex, keyColumn, 2, valueColumn).empty ()));
+
+    lookupKey.clear ();
+    lookupKey.emplace (keyColumn, MakeInt64 (1));
+    BOOST_REQUIRE (table->CreateLookupEditCursor (guard, hashIndex, lookupKey, rawEditCursor) == ResultCode::OK);
+    editCursor.reset (rawEditCursor);
+    BOOST_REQUIRE (editCursor->DeleteCurrent (guard) == ResultCode::OK);
+    BOOST_REQUIRE (editCursor->DeleteCurrent (guard) == ResultCode::OK);
+    editCursor.reset ();
+
+    BOOST_REQUIRE (Lookup (table.get (), guard, hashIndex, keyColumn, 1, valueColumn).size () == 1u);
+    // Ordered indices support lookups too, but through full scan.
+    BOOST_REQUIRE (Lookup (table.get (), guard, keyIndex, keyColumn, 1, valueColumn).size () == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE (OpenLookupCursorsOfDifferentKeys, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "keyHash", {keyColumn}, IndexType::HASH}, hashIndex) ==
+                   ResultCode::OK);
+
+    std::vector <std::unique_ptr <TableReadCursor>> cursors;
+    for (int64_t key = 0; key < 3; ++key)
+    {
+        Table::Row lookupKey;
+        lookupKey.emplace (keyColumn, MakeInt64 (key));
+
+        TableReadCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (table->CreateLookupCursor (guard, hashIndex, lookupKey, rawCursor) == ResultCode::OK);
+        cursors.emplace_back (rawCursor);
+    }
+
+    // Rows are added to cursors with equal keys only, then moved between cursors by update.
+    InsertRow (guard, 0, 10);
+    InsertRow (guard, 1, 20);
+    InsertRow (guard, 5, 30);
+
+    Table::Row lookupKey;
+    lookupKey.emplace (keyColumn, MakeInt64 (1));
+    TableEditCursor *rawEditCursor = nullptr;
+    BOOST_REQUIRE (table->CreateLookupEditCursor (guard, hashIndex, lookupKey, rawEditCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> editCursor (rawEditCursor);
+
+    Table::Row changes;
+    changes.emplace (keyColumn, MakeInt64 (2));
+    BOOST_REQUIRE (editCursor->Update (guard, changes) == ResultCode::OK);
+    editCursor.reset ();
+
+    const std::vector <int64_t> expected[] = {{10}, {}, {20}};
+    for (int64_t key = 0; key < 3; ++key)
+    {
+        std::vector <int64_t> values;
+        const AnyDataContainer *value = nullptr;
+
+        while (cursors[key]->Get (guard, valueColumn, value) == ResultCode::OK)
+        {
+            values.push_back (ReadInt64 (*value));
+            cursors[key]->Advance (guard, 1);
+        }
+
+        BOOST_REQUIRE (values == expected[key]);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE (ManyKeys, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "keyHash", {keyColumn}, IndexType::HASH}, hashIndex) ==
+                   ResultCode::OK);
+
+    constexpr int64_t COUNT = 1000;
+    for (int64_t key = 0; key < COUNT; ++key)
+    {
+        InsertRow (guard, key, key * 2);
+    }
+
+    for (int64_t key = 0; key < COUNT; ++key)
+    {
+        BOOST_REQUIRE ((Lookup (table.get (), guard, hashIndex, keyColumn, key, valueColumn) ==
+                        std::vector <int64_t> {key * 2}));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE (HashIndexHasNoOrder, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "keyHash", {keyColumn}, IndexType::HASH}, hashIndex) ==
+                   ResultCode::OK);
+
+    TableReadCursor *cursor = nullptr;
+    BOOST_REQUIRE (table->CreateReadCursor (guard, hashIndex, cursor) ==
+                   ResultCode::INDEX_DOES_NOT_SUPPORT_ORDERED_ITERATION);
+
+    Table::Row wrongKey;
+    wrongKey.emplace (valueColumn, MakeInt64 (1));
+    BOOST_REQUIRE (table->CreateLookupCursor (guard, hashIndex, wrongKey, cursor) ==
+                   ResultCode::LOOKUP_KEY_COLUMN_IS_NOT_INDEXED);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
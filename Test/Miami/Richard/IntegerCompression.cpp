@@ -0,0 +1,203 @@
+#include <iterator>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (IntegerCompression)
+
+using namespace Miami::Richard;
+
+static constexpr uint32_t BLOCK = CompressedIntegerStorage::BLOCK_SIZE;
+
+static int64_t GetExpectedValue (AnyDataId rowId)
+{
+    const uint64_t slot = rowId % BLOCK;
+    switch (rowId / BLOCK)
+    {
+        case 0:
+            // Counter with constant step.
+            return 1000000000000 + static_cast <int64_t> (slot) * 1000;
+
+        case 1:
+            // Small values without any order.
+            return static_cast <int64_t> ((slot * 7u) % 13u);
+
+        case 2:
+            // Long runs of big values.
+            return (slot / 32u) % 2u == 0u ? -4000000000000000 : 4000000000000000;
+
+        default:
+            return static_cast <int64_t> (rowId);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (BlockEncodings)
+{
+    CompressedIntegerStorage storage;
+    for (AnyDataId rowId = 0u; rowId < BLOCK * 3u; ++rowId)
+    {
+        storage.Set (rowId, GetExpectedValue (rowId));
+    }
+
+    // Sparse block: only few values are present.
+    const AnyDataId sparseRows[] {BLOCK * 3u + 5u, BLOCK * 3u + 70u, BLOCK * 3u + 127u};
+    for (AnyDataId rowId : sparseRows)
+    {
+        storage.Set (rowId, GetExpectedValue (rowId));
+    }
+
+    // Write to next block, so all previous blocks are encoded.
+    storage.Set (BLOCK * 10u, 0);
+
+    CompressedIntegerStorage::Encoding encoding;
+    BOOST_REQUIRE (storage.GetBlockEncoding (0u, encoding) && encoding == CompressedIntegerStorage::Encoding::DELTA);
+    BOOST_REQUIRE (storage.GetBlockEncoding (1u, encoding) &&
+                   encoding == CompressedIntegerStorage::Encoding::FRAME_OF_REFERENCE);
+    BOOST_REQUIRE (storage.GetBlockEncoding (2u, encoding) &&
+                   encoding == CompressedIntegerStorage::Encoding::RUN_LENGTH);
+    BOOST_REQUIRE (!storage.GetBlockEncoding (4u, encoding));
+    BOOST_REQUIRE (storage.GetEncodedSize () < (BLOCK * 3u + 3u) * sizeof (int64_t));
+
+    for (AnyDataId rowId = 0u; rowId < BLOCK * 4u; ++rowId)
+    {
+        int64_t value;
+        const bool present = rowId < BLOCK * 3u || rowId == sparseRows[0] ||
+                             rowId == sparseRows[1] || rowId == sparseRows[2];
+
+        BOOST_REQUIRE (storage.Get (rowId, value) == present);
+        BOOST_REQUIRE (!present || value == GetExpectedValue (rowId));
+    }
+
+    // Gather must return the same values in any order of rows.
+    const AnyDataId rows[] {3u, BLOCK * 2u + 40u, BLOCK + 1u, 2u, BLOCK * 3u + 6u, sparseRows[1], BLOCK * 10u};
+    int64_t values[std::size (rows)];
+    uint8_t present[std::size (rows)];
+    storage.Gather (rows, std::size (rows), values, present);
+
+    for (std::size_t index = 0u; index < std::size (rows); ++index)
+    {
+        int64_t value = 0;
+        BOOST_REQUIRE (storage.Get (rows[index], value) == static_cast <bool> (present[index]));
+        BOOST_REQUIRE (values[index] == value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ChangesOfEncodedBlocks)
+{
+    CompressedIntegerStorage storage;
+    for (AnyDataId rowId = 0u; rowId < BLOCK * 2u; ++rowId)
+    {
+        storage.Set (rowId, GetExpectedValue (rowId));
+    }
+
+    // Block is decoded for changes and encoded again, possibly with another encoding.
+    storage.Set (10u, -1);
+    storage.Erase (11u);
+    storage.Erase (BLOCK * 5u);
+    storage.Set (BLOCK, 0);
+
+    int64_t value;
+    BOOST_REQUIRE (storage.Get (10u, value) && value == -1);
+    BOOST_REQUIRE (!storage.Has (11u));
+    BOOST_REQUIRE (storage.Get (12u, value) && value == GetExpectedValue (12u));
+    BOOST_REQUIRE (storage.Get (BLOCK - 1u, value) && value == GetExpectedValue (BLOCK - 1u));
+
+    // Block without values is not stored.
+    for (AnyDataId rowId = 0u; rowId < BLOCK; ++rowId)
+    {
+        storage.Erase (rowId);
+    }
+
+    storage.Set (BLOCK * 2u, 0);
+    CompressedIntegerStorage::Encoding encoding;
+    BOOST_REQUIRE (!storage.GetBlockEncoding (0u, encoding));
+    BOOST_REQUIRE (storage.GetBlockEncoding (1u, encoding));
+}
+
+BOOST_FIXTURE_TEST_CASE (CompressedColumn, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    AnyDataId column;
+    BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::VARCHAR, "compressed", 0u, false, true}, column) ==
+                   ResultCode::COMPRESSION_IS_NOT_SUPPORTED_BY_TYPE);
+    BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT32, "compressed", 0u, false, true}, column) ==
+                   ResultCode::OK);
+
+    AnyDataId index;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "compressed", {column}}, index) == ResultCode::OK);
+
+    for (int64_t key = 0; key < 300; ++key)
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+
+        // Every third row has null in compressed column.
+        if (key % 3 != 0)
+        {
+            AnyDataContainer value (DataType::INT32);
+            *static_cast <int32_t *> (value.GetDataStartPointer ()) = static_cast <int32_t> (1000 - key);
+            row.emplace (column, std::move (value));
+        }
+
+        BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    TableSnapshotCursor *rawSnapshot = nullptr;
+    BOOST_REQUIRE (table->CreateSnapshotCursor (guard, keyIndex, rawSnapshot) == ResultCode::OK);
+    std::unique_ptr <TableSnapshotCursor> snapshot (rawSnapshot);
+
+    // Nulls are first, then values in ascending order, so key 299 goes first.
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateEditCursor (guard, index, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+    BOOST_REQUIRE (cursor->Advance (guard, 100) == ResultCode::OK);
+
+    const AnyDataContainer *value = nullptr;
+    const AnyDataContainer *key = nullptr;
+    BOOST_REQUIRE (cursor->Get (guard, column, value) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (value && value->GetType () == DataType::INT32);
+    BOOST_REQUIRE (*static_cast <const int32_t *> (value->GetDataStartPointer ()) == 701);
+    BOOST_REQUIRE (ReadInt64 (*key) == 299);
+
+    Table::Row changes;
+    AnyDataContainer newValue (DataType::INT32);
+    *static_cast <int32_t *> (newValue.GetDataStartPointer ()) = -5;
+    changes.emplace (column, std::move (newValue));
+    BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+    cursor.reset ();
+
+    AnyDataContainer constant (DataType::INT32);
+    *static_cast <int32_t *> (constant.GetDataStartPointer ()) = 800;
+
+    auto count = [this, &guard, index] (const Predicate &predicate)
+    {
+        TableReadCursor *rawReadCursor = nullptr;
+        BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, index, predicate, rawReadCursor) == ResultCode::OK);
+        std::unique_ptr <TableReadCursor> readCursor (rawReadCursor);
+
+        std::size_t matched = 0u;
+        const AnyDataContainer *current = nullptr;
+
+        while (readCursor->Get (guard, keyColumn, current) == ResultCode::OK)
+        {
+            ++matched;
+            readCursor->Advance (guard, 1);
+        }
+
+        return matched;
+    };
+
+    // Keys 200..299 without nulls, updated value -5 is also less than constant.
+    BOOST_REQUIRE (count (Predicate ({{PredicateOperation::LESS_OR_EQUAL, column, constant}})) == 67u);
+    BOOST_REQUIRE (count (Predicate ({{PredicateOperation::IS_NULL, column}})) == 100u);
+
+    AnyDataContainer snapshotValue;
+    bool isNull = true;
+    BOOST_REQUIRE (snapshot->Advance (299) == ResultCode::OK);
+    BOOST_REQUIRE (snapshot->Get (column, snapshotValue, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && *static_cast <const int32_t *> (snapshotValue.GetDataStartPointer ()) == 701);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
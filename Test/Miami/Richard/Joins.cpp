@@ -0,0 +1,181 @@
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Richard/Join.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Joins)
+
+using namespace Miami::Richard;
+
+/// Adds dimension table with "id" and "weight" INT64 columns and "code" INT32 column, weight is id * 100.
+class JoinCheckCommons : public TableCheckCommons
+{
+public:
+    JoinCheckCommons ()
+        : dimension (std::make_unique <Table> (&context, 1, "Dimension"))
+    {
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&dimension->ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (dimension->AddColumn (guard, {0, DataType::INT64, "id"}, idColumn) == ResultCode::OK);
+        BOOST_REQUIRE (dimension->AddColumn (guard, {0, DataType::INT64, "weight"}, weightColumn) == ResultCode::OK);
+        BOOST_REQUIRE (dimension->AddColumn (guard, {0, DataType::INT32, "code"}, codeColumn) == ResultCode::OK);
+
+        for (int64_t id = 0; id < 10; ++id)
+        {
+            Table::Row row;
+            row.emplace (idColumn, MakeInt64 (id));
+            row.emplace (weightColumn, MakeInt64 (id * 100));
+            BOOST_REQUIRE (dimension->InsertRow (guard, row) == ResultCode::OK);
+        }
+
+        // Null keys never match, even with other null keys.
+        Table::Row row;
+        row.emplace (weightColumn, MakeInt64 (-100));
+        BOOST_REQUIRE (dimension->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    std::unique_ptr <Table> dimension;
+    AnyDataId idColumn = 0;
+    AnyDataId weightColumn = 0;
+    AnyDataId codeColumn = 0;
+};
+
+/// Executes join and returns output rows sorted by their values.
+static std::vector <std::vector <int64_t>> Execute (
+    const Table *left, const std::shared_ptr <Miami::Disco::SafeLockGuard> &leftGuard,
+    const Table *right, const std::shared_ptr <Miami::Disco::SafeLockGuard> &rightGuard,
+    const JoinPlan &plan, Miami::Disco::Context *workers)
+{
+    std::vector <std::vector <int64_t>> rows;
+    BOOST_REQUIRE (HashJoin::Execute (
+        left, leftGuard, right, rightGuard, plan, workers,
+        [&rows] (QueryBatch &batch)
+        {
+            for (std::size_t row = 0u; row < batch.GetRowsCount (); ++row)
+            {
+                std::vector <int64_t> &values = rows.emplace_back ();
+                for (std::size_t column = 0u; column < batch.columnsCount_; ++column)
+                {
+                    const std::size_t index = row * batch.columnsCount_ + column;
+                    BOOST_REQUIRE (!batch.nulls_[index]);
+                    values.emplace_back (ReadInt64 (batch.values_[index]));
+                }
+            }
+
+            return true;
+        }) == ResultCode::OK);
+
+    std::sort (rows.begin (), rows.end ());
+    return rows;
+}
+
+BOOST_FIXTURE_TEST_CASE (FactWithDimension, JoinCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 5000; ++key)
+    {
+        InsertRow (guard, key, key % 12);
+    }
+
+    Table::Row nullValueRow;
+    nullValueRow.emplace (keyColumn, MakeInt64 (-1));
+    BOOST_REQUIRE (table->InsertRow (guard, nullValueRow) == ResultCode::OK);
+    guard.reset ();
+
+    auto guards = CaptureGuards ({Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()),
+                                  Miami::Disco::AnyLockPointer (&dimension->ReadWriteGuard ().Read ())});
+
+    JoinPlan plan;
+    plan.left_.keyColumns_ = {valueColumn};
+    plan.left_.filter_ = Predicate ({{PredicateOperation::LESS, keyColumn, MakeInt64 (3000)}});
+    plan.left_.projection_ = {keyColumn};
+    plan.right_.keyColumns_ = {idColumn};
+    plan.right_.projection_ = {weightColumn};
+
+    // Keys with remainders 10 and 11 have no dimension rows.
+    for (Miami::Disco::Context *workers : {static_cast <Miami::Disco::Context *> (nullptr), &context})
+    {
+        std::vector <std::vector <int64_t>> rows =
+            Execute (table.get (), guards[0], dimension.get (), guards[1], plan, workers);
+        BOOST_REQUIRE (rows.size () == 2500u);
+
+        for (const std::vector <int64_t> &row : rows)
+        {
+            BOOST_REQUIRE (row[0] < 3000 && row[0] % 12 < 10);
+            BOOST_REQUIRE (row[1] == row[0] % 12 * 100);
+        }
+    }
+
+    // Smaller left input is built, output order of columns is the same.
+    std::swap (plan.left_, plan.right_);
+    std::vector <std::vector <int64_t>> rows =
+        Execute (dimension.get (), guards[1], table.get (), guards[0], plan, &context);
+    BOOST_REQUIRE (rows.size () == 2500u);
+    BOOST_REQUIRE (rows.front ()[0] == 0 && rows.front ()[1] == 0);
+    BOOST_REQUIRE (rows.back ()[0] == 900 && rows.back ()[1] % 12 == 9);
+
+    plan.limit_ = 7u;
+    rows = Execute (dimension.get (), guards[1], table.get (), guards[0], plan, &context);
+    BOOST_REQUIRE (rows.size () == 7u);
+}
+
+BOOST_FIXTURE_TEST_CASE (SelfJoin, JoinCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 3000; ++key)
+    {
+        InsertRow (guard, key, 2999 - key);
+    }
+
+    JoinPlan plan;
+    plan.left_.keyColumns_ = {keyColumn};
+    plan.left_.projection_ = {keyColumn};
+    plan.right_.keyColumns_ = {valueColumn};
+    plan.right_.projection_ = {keyColumn};
+
+    std::vector <std::vector <int64_t>> rows = Execute (table.get (), guard, table.get (), guard, plan, &context);
+    BOOST_REQUIRE (rows.size () == 3000u);
+
+    for (const std::vector <int64_t> &row : rows)
+    {
+        BOOST_REQUIRE (row[0] + row[1] == 2999);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE (Validation, JoinCheckCommons)
+{
+    auto guards = CaptureGuards ({Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()),
+                                  Miami::Disco::AnyLockPointer (&dimension->ReadWriteGuard ().Read ())});
+
+    auto check = [this, &guards] (const JoinPlan &plan, ResultCode expected)
+    {
+        BOOST_REQUIRE (HashJoin::Execute (table.get (), guards[0], dimension.get (), guards[1], plan, nullptr,
+                                          [] (QueryBatch &)
+                                          {
+                                              return true;
+                                          }) == expected);
+    };
+
+    JoinPlan plan;
+    plan.left_.projection_ = {keyColumn};
+    plan.right_.keyColumns_ = {idColumn};
+    check (plan, ResultCode::JOIN_MUST_HAVE_AT_LEAST_ONE_KEY_COLUMN);
+
+    plan.left_.keyColumns_ = {valueColumn, keyColumn};
+    check (plan, ResultCode::JOIN_KEY_COLUMNS_COUNT_MISMATCH);
+
+    plan.left_.keyColumns_ = {valueColumn};
+    plan.right_.keyColumns_ = {codeColumn};
+    check (plan, ResultCode::JOIN_KEY_COLUMN_TYPES_MISMATCH);
+
+    plan.right_.keyColumns_ = {idColumn};
+    plan.left_.projection_.clear ();
+    check (plan, ResultCode::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN);
+
+    plan.right_.projection_ = {weightColumn};
+    check (plan, ResultCode::OK);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
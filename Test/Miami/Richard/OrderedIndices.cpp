@@ -0,0 +1,295 @@
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (OrderedIndices)
+
+using namespace Miami::Richard;
+
+/// Collects key and value pairs in key index order.
+static std::vector <std::pair <int64_t, int64_t>> ReadInOrder (
+    TableCheckCommons &commons, const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard)
+{
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (commons.table->CreateReadCursor (guard, commons.keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    std::vector <std::pair <int64_t, int64_t>> rows;
+    const AnyDataContainer *key = nullptr;
+    const AnyDataContainer *value = nullptr;
+
+    while (cursor->Get (guard, commons.keyColumn, key) == ResultCode::OK)
+    {
+        BOOST_REQUIRE (cursor->Get (guard, commons.valueColumn, value) == ResultCode::OK);
+        BOOST_REQUIRE (key && value);
+        rows.emplace_back (ReadInt64 (*key), ReadInt64 (*value));
+        cursor->Advance (guard, 1);
+    }
+
+    return rows;
+}
+
+BOOST_FIXTURE_TEST_CASE (UpdatesKeepOrder, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t index = 0; index < 100; ++index)
+    {
+        InsertRow (guard, index % 10, index);
+    }
+
+    // Rows with equal keys are ordered by ids, therefore by insertion order.
+    std::vector <std::pair <int64_t, int64_t>> rows = ReadInOrder (*this, guard);
+    BOOST_REQUIRE (rows.size () == 100u);
+    for (std::size_t index = 0u; index < rows.size (); ++index)
+    {
+        BOOST_REQUIRE (rows[index].first == static_cast <int64_t> (index / 10u));
+        BOOST_REQUIRE (rows[index].second == static_cast <int64_t> (index % 10u * 10u + index / 10u));
+    }
+
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+    // Updates, that rewrite key with the same value, do not move rows, so cursor visits every row once.
+    int visited = 0;
+    const AnyDataContainer *key = nullptr;
+
+    while (cursor->Get (guard, keyColumn, key) == ResultCode::OK)
+    {
+        Table::Row changes;
+        changes.emplace (keyColumn, MakeInt64 (ReadInt64 (*key)));
+        changes.emplace (valueColumn, MakeInt64 (-1));
+        BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+
+        cursor->Advance (guard, 1);
+        ++visited;
+    }
+
+    BOOST_REQUIRE (visited == 100);
+    cursor.reset ();
+
+    // Every third row is moved to the other end of index, some rows stay between the same neighbours.
+    for (int64_t iteration = 0; iteration < 100; iteration += 3)
+    {
+        BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+        cursor.reset (rawCursor);
+        BOOST_REQUIRE (cursor->Advance (guard, iteration) == ResultCode::OK);
+        BOOST_REQUIRE (cursor->Get (guard, keyColumn, key) == ResultCode::OK);
+
+        Table::Row changes;
+        changes.emplace (keyColumn, MakeInt64 (iteration % 2 == 0 ? 100 - ReadInt64 (*key) : ReadInt64 (*key)));
+        BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+    }
+
+    cursor.reset ();
+    rows = ReadInOrder (*this, guard);
+    BOOST_REQUIRE (rows.size () == 100u);
+
+    for (std::size_t index = 1u; index < rows.size (); ++index)
+    {
+        BOOST_REQUIRE (rows[index - 1u].first <= rows[index].first);
+    }
+
+    // Deleted row is found by position, that is captured before its values are erased.
+    BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+    BOOST_REQUIRE (cursor->Advance (guard, 50) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+    cursor.reset ();
+
+    BOOST_REQUIRE (ReadInOrder (*this, guard).size () == 99u);
+}
+
+BOOST_FIXTURE_TEST_CASE (ManyCursorsFollowWrites, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 400; key += 2)
+    {
+        InsertRow (guard, key, key);
+    }
+
+    // Every cursor points to its own row, so shifts of all of them are checked.
+    std::vector <std::unique_ptr <TableReadCursor>> cursors;
+    for (int64_t index = 0; index < 200; ++index)
+    {
+        TableReadCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (table->CreateReadCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+        cursors.emplace_back (rawCursor);
+        BOOST_REQUIRE (rawCursor->Advance (guard, index) == ResultCode::OK);
+    }
+
+    // Writes are enough to clear order shifts journal several times, while some cursors are never accessed.
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        for (int64_t key = 1; key < 400; key += 2)
+        {
+            InsertRow (guard, key, key);
+        }
+
+        const AnyDataContainer *key = nullptr;
+        BOOST_REQUIRE (cursors[iteration]->Get (guard, keyColumn, key) == ResultCode::OK);
+        BOOST_REQUIRE (ReadInt64 (*key) == iteration * 2);
+
+        if (iteration == 2)
+        {
+            break;
+        }
+
+        TableEditCursor *rawEditCursor = nullptr;
+        BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawEditCursor) == ResultCode::OK);
+        std::unique_ptr <TableEditCursor> editCursor (rawEditCursor);
+
+        while (editCursor->Get (guard, keyColumn, key) == ResultCode::OK)
+        {
+            if (ReadInt64 (*key) % 2 == 1)
+            {
+                BOOST_REQUIRE (editCursor->DeleteCurrent (guard) == ResultCode::OK);
+            }
+            else
+            {
+                editCursor->Advance (guard, 1);
+            }
+        }
+    }
+
+    for (int64_t index = 0; index < 200; ++index)
+    {
+        const AnyDataContainer *key = nullptr;
+        BOOST_REQUIRE (cursors[index]->Get (guard, keyColumn, key) == ResultCode::OK);
+        BOOST_REQUIRE (ReadInt64 (*key) == index * 2);
+
+        BOOST_REQUIRE (cursors[index]->Advance (guard, 1) == ResultCode::OK);
+        BOOST_REQUIRE (cursors[index]->Get (guard, keyColumn, key) == ResultCode::OK);
+        BOOST_REQUIRE (ReadInt64 (*key) == index * 2 + 1);
+    }
+
+    const AnyDataContainer *key = nullptr;
+    BOOST_REQUIRE (cursors[100]->Advance (guard, std::numeric_limits <int64_t>::min ()) ==
+                   ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN);
+    BOOST_REQUIRE (cursors[100]->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (ReadInt64 (*key) == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE (IdleCursorsSearchForTheirRows, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 10; ++key)
+    {
+        InsertRow (guard, key, key);
+    }
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateReadCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> movedRowCursor (rawCursor);
+    BOOST_REQUIRE (movedRowCursor->Advance (guard, 5) == ResultCode::OK);
+
+    BOOST_REQUIRE (table->CreateReadCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> deletedRowCursor (rawCursor);
+    BOOST_REQUIRE (deletedRowCursor->Advance (guard, 7) == ResultCode::OK);
+
+    // Shifts, that are made after last access of cursors, are dropped from journal.
+    for (int64_t key = -1; key > -1000; --key)
+    {
+        InsertRow (guard, key, key);
+    }
+
+    TableEditCursor *rawEditCursor = nullptr;
+    BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawEditCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> editCursor (rawEditCursor);
+    BOOST_REQUIRE (editCursor->Advance (guard, 999 + 5) == ResultCode::OK);
+
+    Table::Row changes;
+    changes.emplace (keyColumn, MakeInt64 (50));
+    BOOST_REQUIRE (editCursor->Update (guard, changes) == ResultCode::OK);
+
+    editCursor.reset ();
+    BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawEditCursor) == ResultCode::OK);
+    editCursor.reset (rawEditCursor);
+    BOOST_REQUIRE (editCursor->Advance (guard, 999 + 6) == ResultCode::OK);
+
+    const AnyDataContainer *key = nullptr;
+    BOOST_REQUIRE (editCursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (ReadInt64 (*key) == 7);
+    BOOST_REQUIRE (editCursor->DeleteCurrent (guard) == ResultCode::OK);
+    editCursor.reset ();
+
+    // Cursor follows its row to the new place, cursor of deleted row stays valid.
+    BOOST_REQUIRE (movedRowCursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (ReadInt64 (*key) == 50);
+    BOOST_REQUIRE (movedRowCursor->Advance (guard, -1) == ResultCode::OK);
+    BOOST_REQUIRE (movedRowCursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (ReadInt64 (*key) == 9);
+
+    BOOST_REQUIRE (deletedRowCursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (deletedRowCursor->Advance (guard, 2000) == ResultCode::CURSOR_ADVANCE_STOPPED_AT_END);
+}
+
+BOOST_FIXTURE_TEST_CASE (CoveringIndex, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 50; ++key)
+    {
+        InsertRow (guard, key, key * 10);
+    }
+
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "hash", {keyColumn}, IndexType::HASH, false, {valueColumn}},
+                                    hashIndex) == ResultCode::INCLUDED_COLUMNS_REQUIRE_ORDERED_INDEX);
+
+    AnyDataId coveringIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "covering", {keyColumn}, IndexType::ORDERED, false, {valueColumn}},
+                                    coveringIndex) == ResultCode::OK);
+
+    // Rows are changed after index creation, so included values must follow them.
+    InsertRow (guard, -1, -10);
+    TableEditCursor *rawEditCursor = nullptr;
+    BOOST_REQUIRE (table->CreateEditCursor (guard, coveringIndex, rawEditCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> editCursor (rawEditCursor);
+
+    BOOST_REQUIRE (editCursor->Advance (guard, 10) == ResultCode::OK);
+    Table::Row changes;
+    changes.emplace (valueColumn, MakeInt64 (1000));
+    BOOST_REQUIRE (editCursor->Update (guard, changes) == ResultCode::OK);
+    BOOST_REQUIRE (editCursor->Advance (guard, 1) == ResultCode::OK);
+    BOOST_REQUIRE (editCursor->DeleteCurrent (guard) == ResultCode::OK);
+    editCursor.reset ();
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateReadCursor (guard, coveringIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> coveringCursor (rawCursor);
+    BOOST_REQUIRE (table->CreateReadCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> plainCursor (rawCursor);
+
+    int64_t expectedKey = -1;
+    const AnyDataContainer *coveredValue = nullptr;
+
+    while (coveringCursor->Get (guard, valueColumn, coveredValue) == ResultCode::OK)
+    {
+        const AnyDataContainer *key = nullptr;
+        const AnyDataContainer *value = nullptr;
+        BOOST_REQUIRE (coveringCursor->Get (guard, keyColumn, key) == ResultCode::OK);
+        BOOST_REQUIRE (plainCursor->Get (guard, valueColumn, value) == ResultCode::OK);
+
+        // Covered values are copies, stored in index, therefore they are not taken from column.
+        BOOST_REQUIRE (coveredValue && value && coveredValue != value && *coveredValue == *value);
+        BOOST_REQUIRE (ReadInt64 (*key) == expectedKey);
+        BOOST_REQUIRE (ReadInt64 (*coveredValue) == (expectedKey == 9 ? 1000 : expectedKey * 10));
+
+        expectedKey += expectedKey == 9 ? 2 : 1;
+        coveringCursor->Advance (guard, 1);
+        plainCursor->Advance (guard, 1);
+    }
+
+    BOOST_REQUIRE (expectedKey == 50);
+    coveringCursor.reset ();
+    plainCursor.reset ();
+
+    // Removal of included column removes index too, like removal of indexed column.
+    BOOST_REQUIRE (table->RemoveColumn (guard, valueColumn) == ResultCode::OK);
+    IndexInfo info;
+    BOOST_REQUIRE (table->GetIndexInfo (guard, coveringIndex, info) == ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
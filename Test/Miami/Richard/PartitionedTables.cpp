@@ -0,0 +1,290 @@
+#include <algorithm>
+#include <future>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Richard/Partitioning.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (PartitionedTables)
+
+using namespace Miami::Richard;
+
+/// Partitioned table with INT64 key column, INT64 "value" column and ordered index over key.
+class PartitionedTableCheckCommons
+{
+public:
+    explicit PartitionedTableCheckCommons (PartitioningInfo info)
+    {
+        PartitionedTable *rawTable = nullptr;
+        BOOST_REQUIRE (PartitionedTable::Create (&context, "Test", info, rawTable) == ResultCode::OK);
+        table.reset (rawTable);
+        keyColumn = table->GetKeyColumnId ();
+
+        auto guards = CaptureWriteGuards ();
+        BOOST_REQUIRE (table->AddColumn (guards, {0, DataType::INT64, "value"}, valueColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table->AddIndex (guards, {0, "key", {keyColumn}}, keyIndex) == ResultCode::OK);
+    }
+
+    std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>> CaptureReadGuards ()
+    {
+        std::vector <Miami::Disco::AnyLockPointer> locks;
+        table->CollectReadLocks (locks);
+        return CaptureGuards (locks);
+    }
+
+    std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>> CaptureWriteGuards ()
+    {
+        std::vector <Miami::Disco::AnyLockPointer> locks;
+        table->CollectWriteLocks (locks);
+        return CaptureGuards (locks);
+    }
+
+    Table::Row MakeRow (int64_t key, int64_t value) const
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        row.emplace (valueColumn, MakeInt64 (value));
+        return row;
+    }
+
+    ResultCode Insert (std::vector <Table::Row> rows)
+    {
+        std::promise <ResultCode> inserted;
+        table->InsertRows (rows,
+                           [&inserted] (ResultCode result)
+                           {
+                               inserted.set_value (result);
+                           });
+
+        return inserted.get_future ().get ();
+    }
+
+    /// Reads keys of all rows through merged cursor and checks, that every row is stored in proper partition.
+    std::vector <int64_t> ReadKeys ()
+    {
+        auto guards = CaptureReadGuards ();
+        PartitionedReadCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (table->CreateReadCursor (guards, keyIndex, rawCursor) == ResultCode::OK);
+        std::unique_ptr <PartitionedReadCursor> cursor (rawCursor);
+
+        std::vector <int64_t> keys;
+        const AnyDataContainer *value = nullptr;
+
+        while (cursor->Get (guards, keyColumn, value) == ResultCode::OK)
+        {
+            BOOST_REQUIRE (value);
+            keys.push_back (ReadInt64 (*value));
+
+            std::size_t partition;
+            std::size_t expectedPartition;
+            BOOST_REQUIRE (cursor->GetPartition (partition) == ResultCode::OK);
+            BOOST_REQUIRE (table->FindPartition (MakeRow (keys.back (), 0), expectedPartition) == ResultCode::OK);
+            BOOST_CHECK_EQUAL (partition, expectedPartition);
+
+            BOOST_REQUIRE (cursor->Advance (guards, 1u) == ResultCode::OK);
+        }
+
+        BOOST_CHECK (cursor->Advance (guards, 1u) == ResultCode::CURSOR_ADVANCE_STOPPED_AT_END);
+        return keys;
+    }
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    std::unique_ptr <PartitionedTable> table;
+
+    AnyDataId keyColumn = 0;
+    AnyDataId valueColumn = 0;
+    AnyDataId keyIndex = 0;
+};
+
+static PartitioningInfo MakeHashPartitioning (std::size_t partitionsCount)
+{
+    PartitioningInfo info;
+    info.type_ = PartitioningType::HASH;
+    info.keyColumn_ = {0, DataType::INT64, "key"};
+    info.partitionsCount_ = partitionsCount;
+    return info;
+}
+
+static PartitioningInfo MakeRangePartitioning (const std::vector <int64_t> &bounds)
+{
+    PartitioningInfo info;
+    info.type_ = PartitioningType::RANGE;
+    info.keyColumn_ = {0, DataType::INT64, "key"};
+
+    for (int64_t bound : bounds)
+    {
+        info.rangeBounds_.emplace_back (MakeInt64 (bound));
+    }
+
+    return info;
+}
+
+BOOST_AUTO_TEST_CASE (HashPartitionsAreMergedInIndexOrder)
+{
+    PartitionedTableCheckCommons commons (MakeHashPartitioning (4u));
+    std::vector <int64_t> keys;
+    std::vector <Table::Row> rows;
+
+    for (int64_t key = 0; key < 1000; ++key)
+    {
+        keys.push_back (key);
+    }
+
+    std::shuffle (keys.begin (), keys.end (), std::mt19937 (42u));
+    for (int64_t key : keys)
+    {
+        rows.emplace_back (commons.MakeRow (key, key * 2));
+    }
+
+    BOOST_REQUIRE (commons.Insert (std::move (rows)) == ResultCode::OK);
+    auto guards = commons.CaptureReadGuards ();
+
+    for (std::size_t index = 0u; index < commons.table->GetPartitionsCount (); ++index)
+    {
+        TableStatistics statistics;
+        BOOST_REQUIRE (commons.table->GetPartition (index)->GetStatistics (guards[index], statistics) ==
+                       ResultCode::OK);
+        BOOST_CHECK (statistics.rowCount_ > 0u);
+    }
+
+    guards.clear ();
+    std::sort (keys.begin (), keys.end ());
+    BOOST_CHECK (commons.ReadKeys () == keys);
+}
+
+BOOST_AUTO_TEST_CASE (RangePartitionsFollowBounds)
+{
+    PartitionedTableCheckCommons commons (MakeRangePartitioning ({100, 200}));
+    BOOST_REQUIRE_EQUAL (commons.table->GetPartitionsCount (), 3u);
+
+    std::size_t partition;
+    BOOST_REQUIRE (commons.table->FindPartition (commons.MakeRow (99, 0), partition) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (partition, 0u);
+    BOOST_REQUIRE (commons.table->FindPartition (commons.MakeRow (100, 0), partition) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (partition, 1u);
+    BOOST_REQUIRE (commons.table->FindPartition (commons.MakeRow (250, 0), partition) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (partition, 2u);
+    BOOST_REQUIRE (commons.table->FindPartition (Table::Row {}, partition) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (partition, 0u);
+
+    Table::Row malformed;
+    malformed.emplace (commons.keyColumn, AnyDataContainer (DataType::INT32));
+    BOOST_CHECK (commons.table->FindPartition (malformed, partition) == ResultCode::NEW_COLUMN_VALUE_TYPE_MISMATCH);
+
+    std::vector <Table::Row> rows;
+    for (int64_t key : {250, 5, 100, 199, 200, 0, 150, 99})
+    {
+        rows.emplace_back (commons.MakeRow (key, 0));
+    }
+
+    BOOST_REQUIRE (commons.Insert (std::move (rows)) == ResultCode::OK);
+    BOOST_CHECK (commons.ReadKeys () == (std::vector <int64_t> {0, 5, 99, 100, 150, 199, 200, 250}));
+}
+
+BOOST_AUTO_TEST_CASE (UnroutableRowRejectsWholeBatch)
+{
+    PartitionedTableCheckCommons commons (MakeRangePartitioning ({100}));
+    std::vector <Table::Row> rows;
+    rows.emplace_back (commons.MakeRow (1, 1));
+    rows.emplace_back (commons.MakeRow (101, 2));
+
+    Table::Row malformed;
+    malformed.emplace (commons.keyColumn, AnyDataContainer (DataType::INT32));
+    rows.emplace_back (std::move (malformed));
+
+    std::promise <ResultCode> inserted;
+    commons.table->InsertRows (rows,
+                               [&inserted] (ResultCode result)
+                               {
+                                   inserted.set_value (result);
+                               });
+
+    BOOST_REQUIRE (inserted.get_future ().get () == ResultCode::NEW_COLUMN_VALUE_TYPE_MISMATCH);
+    BOOST_REQUIRE_EQUAL (rows.size (), 3u);
+
+    for (std::size_t index = 0u; index < 2u; ++index)
+    {
+        BOOST_REQUIRE_EQUAL (rows[index].size (), 2u);
+        BOOST_CHECK_EQUAL (ReadInt64 (rows[index].at (commons.keyColumn)), index == 0u ? 1 : 101);
+        BOOST_CHECK_EQUAL (ReadInt64 (rows[index].at (commons.valueColumn)), static_cast <int64_t> (index) + 1);
+    }
+
+    BOOST_CHECK (commons.ReadKeys ().empty ());
+}
+
+BOOST_AUTO_TEST_CASE (WritersOfDifferentPartitionsDoNotBlockEachOther)
+{
+    PartitionedTableCheckCommons commons (MakeRangePartitioning ({100}));
+    auto firstPartitionGuard = CaptureGuard (
+        Miami::Disco::AnyLockPointer (&commons.table->GetPartition (0u)->ReadWriteGuard ().Write ()));
+
+    std::vector <Table::Row> rows;
+    rows.emplace_back (commons.MakeRow (100, 1));
+    rows.emplace_back (commons.MakeRow (101, 2));
+    BOOST_REQUIRE (commons.Insert (std::move (rows)) == ResultCode::OK);
+
+    Table::Row row = commons.MakeRow (1, 3);
+    BOOST_REQUIRE (commons.table->GetPartition (0u)->InsertRow (firstPartitionGuard, row) == ResultCode::OK);
+    firstPartitionGuard.reset ();
+
+    BOOST_CHECK (commons.ReadKeys () == (std::vector <int64_t> {1, 100, 101}));
+}
+
+BOOST_AUTO_TEST_CASE (SchemaIsEqualInAllPartitions)
+{
+    PartitionedTableCheckCommons commons (MakeRangePartitioning ({100}));
+    std::vector <Table::Row> rows;
+    rows.emplace_back (commons.MakeRow (1, 7));
+    rows.emplace_back (commons.MakeRow (101, 7));
+    rows.emplace_back (commons.MakeRow (102, 7));
+    BOOST_REQUIRE (commons.Insert (std::move (rows)) == ResultCode::OK);
+
+    auto guards = commons.CaptureWriteGuards ();
+    AnyDataId indexId;
+
+    // Second partition has duplicate values, therefore index is removed from the first one too.
+    BOOST_CHECK (commons.table->AddIndex (guards, {0, "value", {commons.valueColumn}, IndexType::HASH, true},
+                                          indexId) == ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+
+    AnyDataId secondIndexId;
+    BOOST_REQUIRE (commons.table->AddIndex (guards, {0, "value", {commons.valueColumn}}, secondIndexId) ==
+                   ResultCode::OK);
+
+    for (std::size_t index = 0u; index < commons.table->GetPartitionsCount (); ++index)
+    {
+        std::vector <AnyDataId> indices;
+        BOOST_REQUIRE (commons.table->GetPartition (index)->GetIndicesIds (guards[index], indices) ==
+                       ResultCode::OK);
+        std::sort (indices.begin (), indices.end ());
+        BOOST_CHECK (indices == (std::vector <AnyDataId> {commons.keyIndex, secondIndexId}));
+    }
+
+    BOOST_CHECK (commons.table->RemoveColumn (guards, commons.keyColumn) ==
+                 ResultCode::PARTITION_KEY_COLUMN_REMOVAL_BLOCKED);
+    BOOST_CHECK (commons.table->RemoveColumn (guards, commons.valueColumn) == ResultCode::OK);
+    BOOST_CHECK (commons.table->RemoveIndex (guards, secondIndexId) == ResultCode::INDEX_WITH_GIVEN_ID_NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_CASE (MalformedPartitioning)
+{
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    PartitionedTable *table = nullptr;
+
+    PartitioningInfo info = MakeHashPartitioning (1u);
+    BOOST_CHECK (PartitionedTable::Create (&context, "Test", info, table) ==
+                 ResultCode::PARTITIONS_COUNT_MUST_BE_AT_LEAST_TWO);
+
+    info = MakeRangePartitioning ({10, 10});
+    BOOST_CHECK (PartitionedTable::Create (&context, "Test", info, table) ==
+                 ResultCode::PARTITION_RANGE_BOUNDS_MUST_BE_ASCENDING);
+
+    info = MakeRangePartitioning ({10});
+    info.keyColumn_.dataType_ = DataType::INT32;
+    BOOST_CHECK (PartitionedTable::Create (&context, "Test", info, table) ==
+                 ResultCode::PARTITION_RANGE_BOUND_TYPE_MISMATCH);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,217 @@
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Predicates)
+
+using namespace Miami::Richard;
+
+/// Collects keys of all rows, visited by given cursor from its current position.
+static std::vector <int64_t> CollectKeys (TableReadCursor *cursor,
+                                          const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard,
+                                          AnyDataId keyColumn)
+{
+    std::vector <int64_t> keys;
+    const AnyDataContainer *key = nullptr;
+
+    while (cursor->Get (guard, keyColumn, key) == ResultCode::OK)
+    {
+        BOOST_REQUIRE (key);
+        keys.push_back (ReadInt64 (*key));
+        cursor->Advance (guard, 1);
+    }
+
+    return keys;
+}
+
+BOOST_FIXTURE_TEST_CASE (FilterAcrossBatches, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 200; ++key)
+    {
+        InsertRow (guard, key, key % 3);
+    }
+
+    // value == 0 AND key >= 10.
+    Predicate predicate ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (0)},
+                          {PredicateOperation::GREATER_OR_EQUAL, keyColumn, MakeInt64 (10)},
+                          {PredicateOperation::AND}});
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, predicate, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    std::vector <int64_t> expected;
+    for (int64_t key = 12; key < 200; key += 3)
+    {
+        expected.push_back (key);
+    }
+
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == expected);
+
+    // Steps are counted in matching rows.
+    BOOST_REQUIRE (cursor->Advance (guard, -3) == ResultCode::OK);
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == (std::vector <int64_t> {192, 195, 198}));
+
+    BOOST_REQUIRE (cursor->Advance (guard, -1000) == ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN);
+    const AnyDataContainer *key = nullptr;
+    BOOST_REQUIRE (cursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (ReadInt64 (*key) == 12);
+
+    BOOST_REQUIRE (cursor->Advance (guard, 2) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_REQUIRE (ReadInt64 (*key) == 18);
+    BOOST_REQUIRE (cursor->Advance (guard, 1000) == ResultCode::CURSOR_ADVANCE_STOPPED_AT_END);
+}
+
+BOOST_FIXTURE_TEST_CASE (FilteredAdvanceByMinimalStep, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 10; ++key)
+    {
+        InsertRow (guard, key, key % 2);
+    }
+
+    Predicate predicate ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (1)}});
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, predicate, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    BOOST_REQUIRE (cursor->Advance (guard, 3) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->Advance (guard, std::numeric_limits <int64_t>::min ()) ==
+                   ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN);
+
+    const AnyDataContainer *key = nullptr;
+    BOOST_REQUIRE (cursor->Get (guard, keyColumn, key) == ResultCode::OK);
+    BOOST_CHECK (ReadInt64 (*key) == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE (LogicalOperationsAndNulls, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 6; ++key)
+    {
+        InsertRow (guard, key, key);
+    }
+
+    Table::Row nullValue;
+    nullValue.emplace (keyColumn, MakeInt64 (6));
+    BOOST_REQUIRE (table->InsertRow (guard, nullValue) == ResultCode::OK);
+
+    // NOT (value < 2 OR value > 3) OR value IS NULL.
+    Predicate predicate ({{PredicateOperation::LESS, valueColumn, MakeInt64 (2)},
+                          {PredicateOperation::GREATER, valueColumn, MakeInt64 (3)},
+                          {PredicateOperation::OR},
+                          {PredicateOperation::NOT},
+                          {PredicateOperation::IS_NULL, valueColumn},
+                          {PredicateOperation::OR}});
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, predicate, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == (std::vector <int64_t> {2, 3, 6}));
+
+    // Comparison with null never matches, even for NOT_EQUAL.
+    Predicate notEqual ({{PredicateOperation::NOT_EQUAL, valueColumn, MakeInt64 (0)}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, notEqual, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == (std::vector <int64_t> {1, 2, 3, 4, 5}));
+}
+
+BOOST_FIXTURE_TEST_CASE (NegationOfUnknownIsUnknown, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 3; ++key)
+    {
+        InsertRow (guard, key, key);
+    }
+
+    Table::Row nullValue;
+    nullValue.emplace (keyColumn, MakeInt64 (3));
+    BOOST_REQUIRE (table->InsertRow (guard, nullValue) == ResultCode::OK);
+
+    TableReadCursor *rawCursor = nullptr;
+    std::unique_ptr <TableReadCursor> cursor;
+
+    // NOT (value = 0) and value != 0 both skip row with null value.
+    Predicate negatedEqual ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (0)},
+                             {PredicateOperation::NOT}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, negatedEqual, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+    const std::vector <int64_t> negatedKeys = CollectKeys (cursor.get (), guard, keyColumn);
+
+    Predicate notEqual ({{PredicateOperation::NOT_EQUAL, valueColumn, MakeInt64 (0)}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, notEqual, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+
+    BOOST_REQUIRE (negatedKeys == (std::vector <int64_t> {1, 2}));
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == negatedKeys);
+
+    // Unknown AND false is false, therefore its negation matches null row.
+    Predicate negatedAnd ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (0)},
+                           {PredicateOperation::GREATER, keyColumn, MakeInt64 (100)},
+                           {PredicateOperation::AND},
+                           {PredicateOperation::NOT}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, negatedAnd, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == (std::vector <int64_t> {0, 1, 2, 3}));
+
+    // Unknown OR false is unknown, therefore its negation does not match null row.
+    Predicate negatedOr ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (0)},
+                          {PredicateOperation::GREATER, keyColumn, MakeInt64 (100)},
+                          {PredicateOperation::OR},
+                          {PredicateOperation::NOT}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, negatedOr, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == (std::vector <int64_t> {1, 2}));
+}
+
+BOOST_FIXTURE_TEST_CASE (EditCursorSkipsChangedRows, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 10; ++key)
+    {
+        InsertRow (guard, key, key % 2);
+    }
+
+    Predicate predicate ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (1)}});
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateFilteredEditCursor (guard, keyIndex, predicate, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+    // Updated row stops matching predicate, so cursor moves to the next matching row.
+    Table::Row changes;
+    changes.emplace (valueColumn, MakeInt64 (0));
+    BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+    BOOST_REQUIRE (CollectKeys (cursor.get (), guard, keyColumn) == (std::vector <int64_t> {5, 7, 9}));
+}
+
+BOOST_FIXTURE_TEST_CASE (Validation, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()));
+    TableReadCursor *cursor = nullptr;
+
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, Predicate (), cursor) ==
+                   ResultCode::PREDICATE_IS_MALFORMED);
+
+    Predicate missingOperand ({{PredicateOperation::IS_NULL, keyColumn}, {PredicateOperation::AND}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, missingOperand, cursor) ==
+                   ResultCode::PREDICATE_IS_MALFORMED);
+
+    Predicate extraOperand ({{PredicateOperation::IS_NULL, keyColumn}, {PredicateOperation::IS_NULL, valueColumn}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, extraOperand, cursor) ==
+                   ResultCode::PREDICATE_IS_MALFORMED);
+
+    Predicate wrongType ({{PredicateOperation::EQUAL, keyColumn, AnyDataContainer (DataType::INT32)}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, wrongType, cursor) ==
+                   ResultCode::PREDICATE_VALUE_TYPE_MISMATCH);
+
+    Predicate unknownColumn ({{PredicateOperation::IS_NOT_NULL, 100}});
+    BOOST_REQUIRE (table->CreateFilteredReadCursor (guard, keyIndex, unknownColumn, cursor) ==
+                   ResultCode::COLUMN_WITH_GIVEN_ID_NOT_FOUND);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
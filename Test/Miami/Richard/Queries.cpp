@@ -0,0 +1,309 @@
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Richard/Sorting.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Queries)
+
+using namespace Miami::Richard;
+
+/// Executes query and collects all output rows, null values are read as -1.
+static std::vector <std::vector <int64_t>> Execute (
+    TableCheckCommons &commons, const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard,
+    const QueryPlan &plan, Miami::Disco::Context *workers)
+{
+    std::vector <std::vector <int64_t>> rows;
+    BOOST_REQUIRE (commons.table->ExecuteQuery (
+        guard, plan, workers,
+        [&rows] (QueryBatch &batch)
+        {
+            BOOST_REQUIRE (batch.GetRowsCount () > 0u);
+            for (std::size_t row = 0u; row < batch.GetRowsCount (); ++row)
+            {
+                std::vector <int64_t> &values = rows.emplace_back ();
+                for (std::size_t column = 0u; column < batch.columnsCount_; ++column)
+                {
+                    const std::size_t index = row * batch.columnsCount_ + column;
+                    values.emplace_back (batch.nulls_[index] ? -1 : ReadInt64 (batch.values_[index]));
+                }
+            }
+
+            return true;
+        }) == ResultCode::OK);
+
+    return rows;
+}
+
+BOOST_FIXTURE_TEST_CASE (FilterProjectAndLimit, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 5000; ++key)
+    {
+        InsertRow (guard, key, key % 7);
+    }
+
+    QueryPlan plan;
+    plan.filter_ = Predicate ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (3)}});
+    plan.projection_ = {keyColumn, valueColumn};
+    plan.offset_ = 2u;
+    plan.limit_ = 100u;
+
+    // Result must not depend on whether morsels are processed by workers.
+    for (Miami::Disco::Context *workers : {static_cast <Miami::Disco::Context *> (nullptr), &context})
+    {
+        std::vector <std::vector <int64_t>> rows = Execute (*this, guard, plan, workers);
+        BOOST_REQUIRE (rows.size () == 100u);
+
+        for (std::size_t index = 0u; index < rows.size (); ++index)
+        {
+            BOOST_REQUIRE (rows[index][0] == static_cast <int64_t> (3u + 7u * (index + 2u)));
+            BOOST_REQUIRE (rows[index][1] == 3);
+        }
+    }
+
+    // Consumer could stop execution before limit is reached.
+    int calls = 0;
+    plan.limit_ = std::numeric_limits <uint64_t>::max ();
+    BOOST_REQUIRE (table->ExecuteQuery (guard, plan, &context,
+                                        [&calls] (QueryBatch &)
+                                        {
+                                            ++calls;
+                                            return false;
+                                        }) == ResultCode::OK);
+    BOOST_REQUIRE (calls == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE (IndexRangeAndSort, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 3000; ++key)
+    {
+        InsertRow (guard, key, key % 10);
+    }
+
+    Table::Row nullValueRow;
+    nullValueRow.emplace (keyColumn, MakeInt64 (150));
+    BOOST_REQUIRE (table->InsertRow (guard, nullValueRow) == ResultCode::OK);
+
+    QueryPlan plan;
+    plan.indexId_ = keyIndex;
+    plan.hasLowerBound_ = true;
+    plan.hasUpperBound_ = true;
+    plan.lowerBound_.emplace (keyColumn, MakeInt64 (100));
+    plan.upperBound_.emplace (keyColumn, MakeInt64 (200));
+    plan.projection_ = {valueColumn, keyColumn};
+    plan.order_ = {{0u, true}, {1u, false}};
+    plan.limit_ = 12u;
+
+    std::vector <std::vector <int64_t>> rows = Execute (*this, guard, plan, &context);
+    BOOST_REQUIRE (rows.size () == 12u);
+
+    for (std::size_t index = 0u; index < 10u; ++index)
+    {
+        BOOST_REQUIRE (rows[index][0] == 9);
+        BOOST_REQUIRE (rows[index][1] == static_cast <int64_t> (109u + index * 10u));
+    }
+
+    BOOST_REQUIRE (rows[10][0] == 8 && rows[10][1] == 108);
+
+    // Nulls are the smallest values, so they are the first in ascending order.
+    plan.order_ = {{0u, false}};
+    plan.limit_ = 1u;
+    rows = Execute (*this, guard, plan, nullptr);
+    BOOST_REQUIRE (rows.size () == 1u && rows[0][0] == -1 && rows[0][1] == 150);
+
+    plan.order_ = {{2u, false}};
+    BOOST_REQUIRE (table->ExecuteQuery (guard, plan, nullptr,
+                                        [] (QueryBatch &)
+                                        {
+                                            return true;
+                                        }) == ResultCode::QUERY_ORDER_COLUMN_IS_OUT_OF_RANGE);
+
+    plan.order_.clear ();
+    plan.projection_.clear ();
+    BOOST_REQUIRE (table->ExecuteQuery (guard, plan, nullptr,
+                                        [] (QueryBatch &)
+                                        {
+                                            return true;
+                                        }) == ResultCode::QUERY_OUTPUT_MUST_HAVE_AT_LEAST_ONE_COLUMN);
+}
+
+BOOST_FIXTURE_TEST_CASE (AggregateAndSort, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 1000; ++key)
+    {
+        InsertRow (guard, key, key % 4);
+    }
+
+    QueryPlan plan;
+    plan.filter_ = Predicate ({{PredicateOperation::LESS, keyColumn, MakeInt64 (100)}});
+    plan.groupColumns_ = {valueColumn};
+    plan.aggregates_ = {{AggregateFunction::COUNT_ROWS}, {AggregateFunction::SUM, keyColumn},
+                        {AggregateFunction::AVG, keyColumn}};
+    plan.order_ = {{0u, true}};
+
+    std::vector <std::vector <int64_t>> rows = Execute (*this, guard, plan, &context);
+    BOOST_REQUIRE (rows.size () == 4u);
+
+    for (std::size_t index = 0u; index < rows.size (); ++index)
+    {
+        const auto group = static_cast <int64_t> (3u - index);
+        BOOST_REQUIRE (rows[index][0] == group);
+        BOOST_REQUIRE (rows[index][1] == 25);
+
+        // Keys of group are group, group + 4, ..., group + 96.
+        BOOST_REQUIRE (rows[index][2] == 25 * group + 4 * 300);
+        BOOST_REQUIRE (rows[index][3] == group + 48);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE (TopKAndSpill, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 20000; ++key)
+    {
+        InsertRow (guard, key, key * 7919 % 1000);
+    }
+
+    QueryPlan plan;
+    plan.projection_ = {valueColumn, keyColumn};
+    plan.order_ = {{0u, true}};
+
+    std::vector <std::vector <int64_t>> sorted = Execute (*this, guard, plan, &context);
+    BOOST_REQUIRE (sorted.size () == 20000u);
+
+    // Rows with equal values keep source order.
+    for (std::size_t index = 1u; index < sorted.size (); ++index)
+    {
+        BOOST_REQUIRE (sorted[index - 1u][0] > sorted[index][0] ||
+                       (sorted[index - 1u][0] == sorted[index][0] && sorted[index - 1u][1] < sorted[index][1]));
+    }
+
+    plan.offset_ = 15u;
+    plan.limit_ = 50u;
+
+    for (Miami::Disco::Context *workers : {static_cast <Miami::Disco::Context *> (nullptr), &context})
+    {
+        std::vector <std::vector <int64_t>> rows = Execute (*this, guard, plan, workers);
+        BOOST_REQUIRE (std::equal (rows.begin (), rows.end (), sorted.begin () + 15u, sorted.begin () + 65u));
+    }
+
+    // Every added wave exceeds budget, so output is merged from temporary files.
+    plan.offset_ = 0u;
+    plan.limit_ = std::numeric_limits <uint64_t>::max ();
+    plan.sortMemoryBudget_ = 1u;
+    BOOST_REQUIRE (Execute (*this, guard, plan, &context) == sorted);
+
+    plan.limit_ = 1000u;
+    std::vector <std::vector <int64_t>> rows = Execute (*this, guard, plan, &context);
+    BOOST_REQUIRE (std::equal (rows.begin (), rows.end (), sorted.begin (), sorted.begin () + 1000u));
+}
+
+BOOST_AUTO_TEST_CASE (SorterSpill)
+{
+    const std::vector <QueryOrder> order {{0u, false}};
+    QuerySorter sorter (order, 2u, 300u, 1u, nullptr);
+    std::vector <std::pair <int64_t, int64_t>> expected;
+
+    for (int64_t run = 0; run < 4; ++run)
+    {
+        std::vector <QueryBatch> batches (1u);
+        batches[0].columnsCount_ = 2u;
+
+        for (int64_t row = 0; row < 100; ++row)
+        {
+            batches[0].values_.emplace_back (MakeInt64 ((row * 37 + run) % 50));
+            batches[0].nulls_.emplace_back (0u);
+
+            // Second column is null in every tenth row, nulls must survive spilling.
+            batches[0].values_.emplace_back (row % 10 == 0 ? AnyDataContainer () : MakeInt64 (run * 100 + row));
+            batches[0].nulls_.emplace_back (row % 10 == 0);
+            expected.emplace_back ((row * 37 + run) % 50, row % 10 == 0 ? -1 : run * 100 + row);
+        }
+
+        sorter.Add (batches);
+    }
+
+    BOOST_REQUIRE (sorter.GetSpilledRunsCount () == 4u);
+    std::vector <std::pair <int64_t, int64_t>> rows;
+
+    sorter.Finish (64u,
+                   [&rows] (QueryBatch &batch)
+                   {
+                       BOOST_REQUIRE (batch.GetRowsCount () <= 64u);
+                       for (std::size_t row = 0u; row < batch.GetRowsCount (); ++row)
+                       {
+                           const std::size_t index = row * 2u;
+                           rows.emplace_back (ReadInt64 (batch.values_[index]),
+                                              batch.nulls_[index + 1u] ? -1 : ReadInt64 (batch.values_[index + 1u]));
+                       }
+
+                       return true;
+                   });
+
+    std::stable_sort (expected.begin (), expected.end (),
+                      [] (const std::pair <int64_t, int64_t> &first, const std::pair <int64_t, int64_t> &second)
+                      {
+                          return first.first < second.first;
+                      });
+
+    expected.resize (300u);
+    BOOST_REQUIRE (rows == expected);
+}
+
+BOOST_AUTO_TEST_CASE (SorterManySpills)
+{
+    const std::vector <QueryOrder> order {{0u, true}};
+    QuerySorter sorter (order, 2u, std::numeric_limits <uint64_t>::max (), 1u, nullptr);
+    std::vector <std::pair <int64_t, int64_t>> expected;
+
+    // Every added run is spilled, so spilled runs are merged by several levels.
+    constexpr int64_t RUNS_COUNT = QuerySorter::SPILL_MERGE_FAN_IN * QuerySorter::SPILL_MERGE_FAN_IN + 5;
+    for (int64_t run = 0; run < RUNS_COUNT; ++run)
+    {
+        std::vector <QueryBatch> batches (1u);
+        batches[0].columnsCount_ = 2u;
+
+        for (int64_t row = 0; row < 20; ++row)
+        {
+            batches[0].values_.emplace_back (MakeInt64 ((row * 13 + run * 7) % 30));
+            batches[0].nulls_.emplace_back (0u);
+            batches[0].values_.emplace_back (MakeInt64 (run * 20 + row));
+            batches[0].nulls_.emplace_back (0u);
+            expected.emplace_back ((row * 13 + run * 7) % 30, run * 20 + row);
+        }
+
+        sorter.Add (batches);
+        BOOST_REQUIRE (sorter.GetSpilledRunsCount () < QuerySorter::SPILL_MERGE_FAN_IN * 2u);
+    }
+
+    // One run of the second level, that contains 64 runs, and five runs, that are not merged yet.
+    BOOST_REQUIRE (sorter.GetSpilledRunsCount () == 6u);
+    std::vector <std::pair <int64_t, int64_t>> rows;
+
+    sorter.Finish (100u,
+                   [&rows] (QueryBatch &batch)
+                   {
+                       for (std::size_t row = 0u; row < batch.GetRowsCount (); ++row)
+                       {
+                           rows.emplace_back (ReadInt64 (batch.values_[row * 2u]),
+                                              ReadInt64 (batch.values_[row * 2u + 1u]));
+                       }
+
+                       return true;
+                   });
+
+    std::stable_sort (expected.begin (), expected.end (),
+                      [] (const std::pair <int64_t, int64_t> &first, const std::pair <int64_t, int64_t> &second)
+                      {
+                          return first.first > second.first;
+                      });
+
+    BOOST_REQUIRE (rows == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
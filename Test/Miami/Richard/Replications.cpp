@@ -0,0 +1,391 @@
+#include <algorithm>
+#include <future>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Richard/Replication.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Replications)
+
+using namespace Miami::Richard;
+
+static Table *GetTable (Conduit &conduit, const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard,
+                        AnyDataId tableId)
+{
+    Table *table = nullptr;
+    BOOST_REQUIRE (conduit.GetTable (guard, tableId, table) == ResultCode::OK);
+    return table;
+}
+
+/// Describes schemas and INT64 values of all tables in order of their ids, so conduits could be compared.
+static std::string Dump (Conduit &conduit)
+{
+    auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Read ()));
+    std::vector <AnyDataId> tableIds;
+    BOOST_REQUIRE (conduit.GetTableIds (conduitGuard, tableIds) == ResultCode::OK);
+    std::sort (tableIds.begin (), tableIds.end ());
+    std::string output;
+
+    for (AnyDataId tableId : tableIds)
+    {
+        Table *table = GetTable (conduit, conduitGuard, tableId);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()));
+
+        std::string name;
+        BOOST_REQUIRE (table->GetName (guard, name) == ResultCode::OK);
+        output += "table " + std::to_string (tableId) + " " + name + "\n";
+
+        std::vector <AnyDataId> columnIds;
+        BOOST_REQUIRE (table->GetColumnsIds (guard, columnIds) == ResultCode::OK);
+        std::sort (columnIds.begin (), columnIds.end ());
+
+        for (AnyDataId columnId : columnIds)
+        {
+            ColumnInfo info;
+            BOOST_REQUIRE (table->GetColumnInfo (guard, columnId, info) == ResultCode::OK);
+            output += "column " + std::to_string (info.id_) + " " + info.name_ + "\n";
+        }
+
+        std::vector <AnyDataId> indexIds;
+        BOOST_REQUIRE (table->GetIndicesIds (guard, indexIds) == ResultCode::OK);
+        std::sort (indexIds.begin (), indexIds.end ());
+
+        for (AnyDataId indexId : indexIds)
+        {
+            IndexInfo info;
+            BOOST_REQUIRE (table->GetIndexInfo (guard, indexId, info) == ResultCode::OK);
+            output += "index " + std::to_string (info.id_) + " " + info.name_ + "\n";
+        }
+
+        if (columnIds.empty ())
+        {
+            continue;
+        }
+
+        QueryPlan plan;
+        plan.projection_ = columnIds;
+
+        BOOST_REQUIRE (table->ExecuteQuery (
+            guard, plan, nullptr,
+            [&output] (QueryBatch &batch)
+            {
+                for (std::size_t index = 0u; index < batch.values_.size (); ++index)
+                {
+                    output += batch.nulls_[index] ? std::string ("null") :
+                              std::to_string (ReadInt64 (batch.values_[index]));
+                    output += (index + 1u) % batch.columnsCount_ == 0u ? "\n" : "|";
+                }
+
+                return true;
+            }) == ResultCode::OK);
+    }
+
+    return output;
+}
+
+/// Primary conduit, which changes are logged, and replica conduit, to which they are applied.
+class ReplicationCheckCommons
+{
+public:
+    ReplicationCheckCommons ()
+        : primary (&context, &log),
+          replica (&context),
+          applier (&replica)
+    {
+    }
+
+    ResultCode Apply (std::vector <Mutation> mutations)
+    {
+        std::promise <ResultCode> applied;
+        applier.Apply (mutations,
+                       [&applied] (ResultCode result)
+                       {
+                           applied.set_value (result);
+                       });
+
+        return applied.get_future ().get ();
+    }
+
+    /// Ships the whole log to replica in batches of given size.
+    void Replicate (std::size_t maxBatchSize)
+    {
+        while (applier.GetAppliedSequence () < log.GetLastSequence ())
+        {
+            std::vector <uint8_t> batch;
+            std::vector <Mutation> mutations;
+
+            BOOST_REQUIRE (log.Read (applier.GetAppliedSequence (), maxBatchSize, batch) == ResultCode::OK);
+            BOOST_REQUIRE (MutationLog::Decode (batch, mutations) == ResultCode::OK);
+            BOOST_REQUIRE (!mutations.empty ());
+            BOOST_REQUIRE (Apply (std::move (mutations)) == ResultCode::OK);
+        }
+    }
+
+    Table::Row MakeRow (int64_t key, int64_t value) const
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        row.emplace (valueColumn, MakeInt64 (value));
+        return row;
+    }
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    MutationLog log;
+    Conduit primary;
+    Conduit replica;
+    MutationApplier applier;
+
+    AnyDataId keyColumn = 0;
+    AnyDataId valueColumn = 0;
+    AnyDataId keyIndex = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE (ReplicaFollowsPrimary, ReplicationCheckCommons)
+{
+    AnyDataId tableIds[3] {};
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&primary.ReadWriteGuard ().Write ()));
+        for (AnyDataId &tableId : tableIds)
+        {
+            BOOST_REQUIRE (primary.AddTable (conduitGuard, "Test", tableId) == ResultCode::OK);
+        }
+
+        Table *removed = GetTable (primary, conduitGuard, tableIds[2]);
+        auto removedGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&removed->ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (primary.RemoveTable (conduitGuard, removedGuard, tableIds[2]) == ResultCode::OK);
+
+        Table *table = GetTable (primary, conduitGuard, tableIds[0]);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (table->SetName (guard, "Renamed") == ResultCode::OK);
+
+        // Removed column and failed unique index leave gaps in ids, that must be equal on replica.
+        AnyDataId removedColumn = 0;
+        BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT8, "removed"}, removedColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table->RemoveColumn (guard, removedColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT64, "key"}, keyColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT64, "value"}, valueColumn) == ResultCode::OK);
+
+        for (int64_t key = 0; key < 100; ++key)
+        {
+            Table::Row row = MakeRow (key, key % 10);
+            BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+        }
+
+        AnyDataId failedIndex = 0;
+        BOOST_REQUIRE (table->AddIndex (guard, {0, "value", {valueColumn}, IndexType::HASH, true}, failedIndex) ==
+                       ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+        BOOST_REQUIRE (table->AddIndex (guard, {0, "key", {keyColumn}, IndexType::ORDERED, true}, keyIndex) ==
+                       ResultCode::OK);
+    }
+
+    // Replica catches up in several batches, while primary continues to change.
+    Replicate (256u);
+    BOOST_REQUIRE (Dump (replica) == Dump (primary));
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&primary.ReadWriteGuard ().Read ()));
+        Table *table = GetTable (primary, conduitGuard, tableIds[0]);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+
+        TableEditCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+        std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+        Table::Row changes;
+        changes.emplace (valueColumn, MakeInt64 (1000));
+        BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+        BOOST_REQUIRE (cursor->Advance (guard, 1) == ResultCode::OK);
+        BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+        cursor.reset ();
+
+        Table::Row keyOnly;
+        keyOnly.emplace (keyColumn, MakeInt64 (-1));
+        BOOST_REQUIRE (table->InsertRow (guard, keyOnly) == ResultCode::OK);
+    }
+
+    const std::string expected = Dump (primary);
+    const uint64_t lastSequence = log.GetLastSequence ();
+    {
+        // Failed commit is not logged, so neither its changes nor their reverts reach replica.
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&primary.ReadWriteGuard ().Read ()));
+        Table *table = GetTable (primary, conduitGuard, tableIds[0]);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+
+        Transaction *rawTransaction = nullptr;
+        BOOST_REQUIRE (primary.BeginTransaction (conduitGuard, {tableIds[0]}, {guard}, rawTransaction) ==
+                       ResultCode::OK);
+        std::unique_ptr <Transaction> transaction (rawTransaction);
+
+        TableEditCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+        std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+        Table::Row changes;
+        changes.emplace (valueColumn, MakeInt64 (7));
+        BOOST_REQUIRE (transaction->UpdateCurrent (cursor.get (), changes) == ResultCode::OK);
+        BOOST_REQUIRE (transaction->DeleteCurrent (cursor.get ()) == ResultCode::OK);
+        BOOST_REQUIRE (transaction->DeleteCurrent (cursor.get ()) == ResultCode::OK);
+        BOOST_REQUIRE (transaction->Commit () != ResultCode::OK);
+    }
+
+    BOOST_REQUIRE (log.GetLastSequence () == lastSequence);
+
+    BOOST_REQUIRE (Dump (primary) == expected);
+
+    Replicate (1024u);
+    BOOST_REQUIRE (Dump (replica) == Dump (primary));
+    BOOST_REQUIRE (applier.GetAppliedTimestamp () > 0);
+
+    // Ids continue after replicated ones, because replica generates them by the same counters.
+    auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&replica.ReadWriteGuard ().Write ()));
+    AnyDataId tableId = 0;
+    BOOST_REQUIRE (replica.AddTable (conduitGuard, "New", tableId) == ResultCode::OK);
+    BOOST_REQUIRE (tableId == 3u);
+}
+
+BOOST_FIXTURE_TEST_CASE (FailedCommitIsNotReplicated, ReplicationCheckCommons)
+{
+    AnyDataId tableId = 0;
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&primary.ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (primary.AddTable (conduitGuard, "Test", tableId) == ResultCode::OK);
+
+        Table *table = GetTable (primary, conduitGuard, tableId);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT64, "key"}, keyColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT64, "value"}, valueColumn) == ResultCode::OK);
+        BOOST_REQUIRE (table->AddIndex (guard, {0, "key", {keyColumn}, IndexType::HASH, true}, keyIndex) ==
+                       ResultCode::OK);
+
+        Table::Row row = MakeRow (1, 10);
+        BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    Replicate (1024u);
+    const uint64_t lastSequence = log.GetLastSequence ();
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&primary.ReadWriteGuard ().Read ()));
+        Table *table = GetTable (primary, conduitGuard, tableId);
+        auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+
+        Transaction *rawTransaction = nullptr;
+        BOOST_REQUIRE (primary.BeginTransaction (conduitGuard, {tableId}, {guard}, rawTransaction) ==
+                       ResultCode::OK);
+        std::unique_ptr <Transaction> transaction (rawTransaction);
+
+        // The first insertion is applied and then reverted, because the second one breaks unique index.
+        Table::Row inserted = MakeRow (2, 20);
+        Table::Row duplicate = MakeRow (1, 30);
+        BOOST_REQUIRE (transaction->InsertRow (tableId, inserted) == ResultCode::OK);
+        BOOST_REQUIRE (transaction->InsertRow (tableId, duplicate) == ResultCode::OK);
+        BOOST_REQUIRE (transaction->Commit () == ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+
+        std::vector <uint8_t> batch;
+        BOOST_REQUIRE (log.GetLastSequence () == lastSequence);
+        BOOST_REQUIRE (log.Read (lastSequence, 1024u, batch) == ResultCode::OK);
+        BOOST_REQUIRE (batch.empty ());
+
+        inserted = MakeRow (2, 20);
+        BOOST_REQUIRE (transaction->InsertRow (tableId, inserted) == ResultCode::OK);
+        BOOST_REQUIRE (transaction->Commit () == ResultCode::OK);
+        BOOST_REQUIRE (log.GetLastSequence () == lastSequence + 1u);
+    }
+
+    Replicate (1024u);
+    BOOST_REQUIRE (Dump (replica) == Dump (primary));
+}
+
+BOOST_FIXTURE_TEST_CASE (SequencesMustBeContinuous, ReplicationCheckCommons)
+{
+    {
+        auto conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&primary.ReadWriteGuard ().Write ()));
+        AnyDataId tableId = 0;
+        BOOST_REQUIRE (primary.AddTable (conduitGuard, "First", tableId) == ResultCode::OK);
+        BOOST_REQUIRE (primary.AddTable (conduitGuard, "Second", tableId) == ResultCode::OK);
+    }
+
+    std::vector <uint8_t> batch;
+    BOOST_REQUIRE (log.Read (3u, 1024u, batch) == ResultCode::REPLICATION_SEQUENCE_IS_AHEAD);
+    BOOST_REQUIRE (log.Read (2u, 1024u, batch) == ResultCode::OK);
+    BOOST_REQUIRE (batch.empty ());
+
+    // The first record is read even if it exceeds batch size.
+    BOOST_REQUIRE (log.Read (1u, 1u, batch) == ResultCode::OK);
+    std::vector <Mutation> mutations;
+    BOOST_REQUIRE (MutationLog::Decode (batch, mutations) == ResultCode::OK);
+    BOOST_REQUIRE (mutations.size () == 1u && mutations[0].sequence_ == 2u && mutations[0].name_ == "Second");
+    BOOST_REQUIRE (Apply (mutations) == ResultCode::REPLICATION_SEQUENCE_GAP);
+    BOOST_REQUIRE (applier.GetAppliedSequence () == 0u);
+
+    batch.clear ();
+    BOOST_REQUIRE (log.Read (0u, 1024u, batch) == ResultCode::OK);
+    // Cuts inside header, inside payload and inside the last record.
+    for (std::size_t size : {std::size_t (1u), std::size_t (40u), batch.size () - 1u})
+    {
+        mutations.clear ();
+        BOOST_REQUIRE (MutationLog::Decode (std::vector <uint8_t> (batch.begin (), batch.begin () + size),
+                                            mutations) == ResultCode::REPLICATION_BATCH_IS_MALFORMED);
+        BOOST_REQUIRE (mutations.empty ());
+    }
+
+    BOOST_REQUIRE (MutationLog::Decode (batch, mutations) == ResultCode::OK);
+    BOOST_REQUIRE (Apply (mutations) == ResultCode::OK);
+    BOOST_REQUIRE (applier.GetAppliedSequence () == 2u);
+
+    // Already applied mutations are never applied twice.
+    mutations.clear ();
+    BOOST_REQUIRE (MutationLog::Decode (batch, mutations) == ResultCode::OK);
+    BOOST_REQUIRE (Apply (mutations) == ResultCode::REPLICATION_SEQUENCE_GAP);
+    BOOST_REQUIRE (Dump (replica) == Dump (primary));
+}
+
+BOOST_AUTO_TEST_CASE (LogIsTrimmed)
+{
+    MutationLog log;
+    for (AnyDataId tableId = 1u; tableId <= 5u; ++tableId)
+    {
+        log.Append (MutationType::REMOVE_TABLE, tableId, tableId, {});
+    }
+
+    // Records are trimmed only when all registered replicas have applied them.
+    const uint64_t firstReplica = log.RegisterReplica ();
+    const uint64_t secondReplica = log.RegisterReplica ();
+    log.Acknowledge (firstReplica, 4u);
+    BOOST_REQUIRE (log.GetTrimmedSequence () == 0u);
+
+    log.Acknowledge (secondReplica, 2u);
+    BOOST_REQUIRE (log.GetTrimmedSequence () == 2u);
+    BOOST_REQUIRE (log.GetLastSequence () == 5u);
+
+    std::vector <uint8_t> batch;
+    BOOST_REQUIRE (log.Read (1u, 1024u, batch) == ResultCode::REPLICATION_RESYNC_IS_NEEDED);
+    BOOST_REQUIRE (log.Read (2u, 1024u, batch) == ResultCode::OK);
+
+    std::vector <Mutation> mutations;
+    BOOST_REQUIRE (MutationLog::Decode (batch, mutations) == ResultCode::OK);
+    BOOST_REQUIRE (mutations.size () == 3u && mutations[0].sequence_ == 3u && mutations[0].tableId_ == 3u);
+
+    log.UnregisterReplica (secondReplica);
+    BOOST_REQUIRE (log.GetTrimmedSequence () == 4u);
+    log.UnregisterReplica (firstReplica);
+
+    // Without replicas records are trimmed only by size limit, that fits two records here.
+    MutationLog limited (batch.size () / 3u * 2u);
+    for (AnyDataId tableId = 1u; tableId <= 5u; ++tableId)
+    {
+        limited.Append (MutationType::REMOVE_TABLE, tableId, tableId, {});
+    }
+
+    BOOST_REQUIRE (limited.GetTrimmedSequence () == 3u);
+    BOOST_REQUIRE (limited.GetLastSequence () == 5u);
+    batch.clear ();
+    BOOST_REQUIRE (limited.Read (3u, 1024u, batch) == ResultCode::OK);
+
+    mutations.clear ();
+    BOOST_REQUIRE (MutationLog::Decode (batch, mutations) == ResultCode::OK);
+    BOOST_REQUIRE (mutations.size () == 2u && mutations[0].sequence_ == 4u && mutations[1].sequence_ == 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,166 @@
+#include <chrono>
+#include <future>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (RowLocks)
+
+using namespace Miami::Richard;
+
+static std::shared_ptr <Miami::Disco::SafeLockGuard> CaptureIntent (TableCheckCommons &commons)
+{
+    return CaptureGuard (Miami::Disco::AnyLockPointer (&commons.table->ReadWriteGuard ().Intent ()));
+}
+
+static std::unique_ptr <TableEditCursor> LookupKey (TableCheckCommons &commons,
+                                                    const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard,
+                                                    int64_t key)
+{
+    Table::Row lookup;
+    lookup.emplace (commons.keyColumn, MakeInt64 (key));
+
+    TableEditCursor *cursor = nullptr;
+    BOOST_REQUIRE (commons.table->CreateLookupEditCursor (guard, commons.keyIndex, lookup, cursor) ==
+                   ResultCode::OK);
+    return std::unique_ptr <TableEditCursor> (cursor);
+}
+
+static int64_t ReadValue (TableCheckCommons &commons, const std::shared_ptr <Miami::Disco::SafeLockGuard> &readGuard,
+                          int64_t key)
+{
+    Table::Row lookup;
+    lookup.emplace (commons.keyColumn, MakeInt64 (key));
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (commons.table->CreateLookupCursor (readGuard, commons.keyIndex, lookup, rawCursor) ==
+                   ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    const AnyDataContainer *value = nullptr;
+    BOOST_REQUIRE (cursor->Get (readGuard, commons.valueColumn, value) == ResultCode::OK);
+    BOOST_REQUIRE (value);
+    return ReadInt64 (*value);
+}
+
+BOOST_FIXTURE_TEST_CASE (WritersOfDifferentRowsDoNotBlockEachOther, TableCheckCommons)
+{
+    {
+        auto writeGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        InsertRow (writeGuard, 1, 10);
+        InsertRow (writeGuard, 2, 20);
+    }
+
+    auto firstIntent = CaptureIntent (*this);
+    auto secondIntent = CaptureIntent (*this);
+
+    std::unique_ptr <TableEditCursor> firstCursor = LookupKey (*this, firstIntent, 1);
+    std::unique_ptr <TableEditCursor> secondCursor = LookupKey (*this, secondIntent, 2);
+
+    Miami::Disco::Lock *firstLock = nullptr;
+    Miami::Disco::Lock *secondLock = nullptr;
+    BOOST_REQUIRE (firstCursor->GetCurrentRowLock (firstIntent, firstLock) == ResultCode::OK);
+    BOOST_REQUIRE (secondCursor->GetCurrentRowLock (secondIntent, secondLock) == ResultCode::OK);
+    BOOST_REQUIRE (firstLock != secondLock);
+
+    auto firstRowGuard = CaptureGuard (Miami::Disco::AnyLockPointer (firstLock));
+    auto secondRowGuard = CaptureGuard (Miami::Disco::AnyLockPointer (secondLock));
+
+    Table::Row firstChange;
+    firstChange.emplace (valueColumn, MakeInt64 (11));
+    BOOST_CHECK (firstCursor->Update (firstIntent, firstRowGuard, firstChange) == ResultCode::OK);
+
+    Table::Row secondChange;
+    secondChange.emplace (valueColumn, MakeInt64 (21));
+    BOOST_CHECK (secondCursor->Update (secondIntent, secondRowGuard, secondChange) == ResultCode::OK);
+
+    Table::Row inserted;
+    inserted.emplace (keyColumn, MakeInt64 (3));
+    inserted.emplace (valueColumn, MakeInt64 (30));
+    BOOST_CHECK (table->InsertRow (firstIntent, inserted) == ResultCode::OK);
+
+    firstCursor.reset ();
+    secondCursor.reset ();
+    firstIntent.reset ();
+    secondIntent.reset ();
+
+    auto readGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()));
+    BOOST_CHECK_EQUAL (ReadValue (*this, readGuard, 1), 11);
+    BOOST_CHECK_EQUAL (ReadValue (*this, readGuard, 2), 21);
+    BOOST_CHECK_EQUAL (ReadValue (*this, readGuard, 3), 30);
+}
+
+BOOST_FIXTURE_TEST_CASE (RowLockMustCoverCurrentRow, TableCheckCommons)
+{
+    {
+        auto writeGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        InsertRow (writeGuard, 1, 10);
+        InsertRow (writeGuard, 2, 20);
+    }
+
+    auto intent = CaptureIntent (*this);
+    std::unique_ptr <TableEditCursor> firstCursor = LookupKey (*this, intent, 1);
+    std::unique_ptr <TableEditCursor> secondCursor = LookupKey (*this, intent, 2);
+
+    Miami::Disco::Lock *firstLock = nullptr;
+    BOOST_REQUIRE (firstCursor->GetCurrentRowLock (intent, firstLock) == ResultCode::OK);
+    auto firstRowGuard = CaptureGuard (Miami::Disco::AnyLockPointer (firstLock));
+
+    Table::Row change;
+    change.emplace (valueColumn, MakeInt64 (0));
+    BOOST_CHECK (secondCursor->Update (intent, firstRowGuard, change) ==
+                 ResultCode::ROW_LOCK_DOES_NOT_COVER_CURRENT_ROW);
+    BOOST_CHECK (secondCursor->DeleteCurrent (intent, firstRowGuard) ==
+                 ResultCode::ROW_LOCK_DOES_NOT_COVER_CURRENT_ROW);
+    BOOST_CHECK (firstCursor->DeleteCurrent (intent, firstRowGuard) == ResultCode::OK);
+
+    firstCursor.reset ();
+    secondCursor.reset ();
+    intent.reset ();
+
+    auto readGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Read ()));
+    TableStatistics statistics;
+    BOOST_REQUIRE (table->GetStatistics (readGuard, statistics) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (statistics.rowCount_, 1u);
+    BOOST_CHECK_EQUAL (ReadValue (*this, readGuard, 2), 20);
+}
+
+BOOST_FIXTURE_TEST_CASE (RowLocksArePooled, TableCheckCommons)
+{
+    RowLockTable locks (&context);
+    Miami::Disco::Lock &firstLock = locks.GetLock (1u);
+
+    BOOST_CHECK (&locks.GetLock (1u + RowLockTable::LOCKS_COUNT) == &firstLock);
+    BOOST_CHECK (&locks.GetLock (1u + RowLockTable::STRIPES_COUNT) != &firstLock);
+    BOOST_CHECK (&locks.GetLock (2u) != &firstLock);
+
+    auto rowGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&firstLock));
+    BOOST_CHECK (locks.IsCaptured (rowGuard, 1u + 3u * RowLockTable::LOCKS_COUNT));
+    BOOST_CHECK (!locks.IsCaptured (rowGuard, 2u));
+}
+
+BOOST_FIXTURE_TEST_CASE (ReadersWaitForIntents, TableCheckCommons)
+{
+    auto intent = CaptureIntent (*this);
+    std::promise <void> captured;
+    std::shared_ptr <Miami::Disco::SafeLockGuard> readGuard;
+
+    Miami::Disco::After (
+        &table->ReadWriteGuard ().Read (),
+        [&captured, &readGuard] (std::shared_ptr <Miami::Disco::SafeLockGuard> guard)
+        {
+            readGuard = guard;
+            captured.set_value ();
+        });
+
+    std::future <void> capturedFuture = captured.get_future ();
+    BOOST_CHECK (capturedFuture.wait_for (std::chrono::milliseconds (50)) == std::future_status::timeout);
+
+    intent.reset ();
+    capturedFuture.get ();
+    BOOST_CHECK (Miami::Disco::IsReadOrWriteCaptured (readGuard, table->ReadWriteGuard ()));
+    BOOST_CHECK (!Miami::Disco::IsIntentCaptured (readGuard, table->ReadWriteGuard ()));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
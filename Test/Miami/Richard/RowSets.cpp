@@ -0,0 +1,182 @@
+#include <set>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (RowSets)
+
+using namespace Miami::Richard;
+
+static void CheckEqual (const RowSet &rowSet, const std::set <AnyDataId> &expected)
+{
+    BOOST_REQUIRE (rowSet.GetSize () == expected.size ());
+    auto expectedIterator = expected.begin ();
+
+    for (AnyDataId rowId : rowSet)
+    {
+        BOOST_REQUIRE (expectedIterator != expected.end () && rowId == *expectedIterator);
+        ++expectedIterator;
+    }
+
+    BOOST_REQUIRE (expectedIterator == expected.end ());
+}
+
+/// Dense run in first container, sparse ids in second container and some ids far away.
+static void Fill (RowSet &rowSet, std::set <AnyDataId> &expected, AnyDataId offset)
+{
+    for (AnyDataId rowId = offset; rowId < offset + 10000u; ++rowId)
+    {
+        BOOST_REQUIRE (rowSet.Insert (rowId));
+        expected.emplace (rowId);
+    }
+
+    for (AnyDataId rowId = RowSet::CONTAINER_CAPACITY + offset; rowId < RowSet::CONTAINER_CAPACITY * 2u;
+         rowId += 97u)
+    {
+        BOOST_REQUIRE (rowSet.Insert (rowId));
+        expected.emplace (rowId);
+    }
+
+    for (AnyDataId rowId : {AnyDataId (1u) << 40u, (AnyDataId (1u) << 40u) + offset + 1u})
+    {
+        BOOST_REQUIRE (rowSet.Insert (rowId));
+        expected.emplace (rowId);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (InsertEraseAndIterate)
+{
+    RowSet rowSet;
+    std::set <AnyDataId> expected;
+    BOOST_REQUIRE (rowSet.begin () == rowSet.end ());
+
+    Fill (rowSet, expected, 0u);
+    CheckEqual (rowSet, expected);
+    BOOST_REQUIRE (!rowSet.Insert (5u));
+
+    // Dense container is stored as bitmap, which is much smaller than tree.
+    BOOST_REQUIRE (rowSet.GetMemoryUsage () < expected.size () * 4u);
+
+    // Remove most of dense ids, so bitmap is converted back to array.
+    for (AnyDataId rowId = 0u; rowId < 9000u; ++rowId)
+    {
+        BOOST_REQUIRE (rowSet.Erase (rowId));
+        expected.erase (rowId);
+    }
+
+    BOOST_REQUIRE (!rowSet.Erase (0u));
+    BOOST_REQUIRE (!rowSet.Erase (RowSet::CONTAINER_CAPACITY + 1u));
+    BOOST_REQUIRE (!rowSet.Contains (8999u));
+    BOOST_REQUIRE (rowSet.Contains (9000u));
+    CheckEqual (rowSet, expected);
+
+    rowSet.Clear ();
+    BOOST_REQUIRE (rowSet.IsEmpty () && rowSet.begin () == rowSet.end ());
+}
+
+BOOST_AUTO_TEST_CASE (RankAndSelect)
+{
+    RowSet rowSet;
+    std::set <AnyDataId> expected;
+    Fill (rowSet, expected, 3u);
+
+    std::size_t position = 0u;
+    for (AnyDataId rowId : expected)
+    {
+        AnyDataId selected;
+        BOOST_REQUIRE (rowSet.Rank (rowId) == position);
+        BOOST_REQUIRE (rowSet.Select (position, selected) && selected == rowId);
+        ++position;
+    }
+
+    AnyDataId selected;
+    BOOST_REQUIRE (!rowSet.Select (expected.size (), selected));
+    BOOST_REQUIRE (rowSet.Rank (0u) == 0u);
+    BOOST_REQUIRE (rowSet.Rank (RowSet::CONTAINER_CAPACITY) == 10000u);
+    BOOST_REQUIRE (rowSet.Rank (~AnyDataId (0u)) == expected.size ());
+}
+
+BOOST_AUTO_TEST_CASE (SetOperations)
+{
+    RowSet first;
+    RowSet second;
+    std::set <AnyDataId> firstExpected;
+    std::set <AnyDataId> secondExpected;
+
+    Fill (first, firstExpected, 0u);
+    Fill (second, secondExpected, 5000u);
+
+    // Every third id of first set, so bitmap containers are combined with sparse ones.
+    RowSet third;
+    std::set <AnyDataId> thirdExpected;
+    for (AnyDataId rowId = 0u; rowId < RowSet::CONTAINER_CAPACITY * 2u; rowId += 3u)
+    {
+        third.Insert (rowId);
+        thirdExpected.emplace (rowId);
+    }
+
+    auto check = [] (RowSet result, const RowSet &other, const std::set <AnyDataId> &leftExpected,
+                     const std::set <AnyDataId> &rightExpected)
+    {
+        RowSet intersection = result;
+        intersection.IntersectWith (other);
+
+        RowSet difference = result;
+        difference.Subtract (other);
+
+        result.UniteWith (other);
+
+        std::set <AnyDataId> expectedIntersection;
+        std::set <AnyDataId> expectedDifference;
+        std::set <AnyDataId> expectedUnion = rightExpected;
+
+        for (AnyDataId rowId : leftExpected)
+        {
+            (rightExpected.count (rowId) ? expectedIntersection : expectedDifference).emplace (rowId);
+            expectedUnion.emplace (rowId);
+        }
+
+        CheckEqual (intersection, expectedIntersection);
+        CheckEqual (difference, expectedDifference);
+        CheckEqual (result, expectedUnion);
+    };
+
+    check (first, second, firstExpected, secondExpected);
+    check (second, third, secondExpected, thirdExpected);
+    check (third, first, thirdExpected, firstExpected);
+    check (first, RowSet (), firstExpected, {});
+}
+
+BOOST_FIXTURE_TEST_CASE (PredicateFilter, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    RowSet rows;
+
+    for (int64_t key = 0; key < 1000; ++key)
+    {
+        InsertRow (guard, key, key % 7);
+        rows.Insert (static_cast <AnyDataId> (key));
+    }
+
+    RowSet matched;
+    Predicate ({{PredicateOperation::EQUAL, valueColumn, MakeInt64 (3)}}).Filter (table.get (), rows, matched);
+    BOOST_REQUIRE (matched.GetSize () == 143u);
+
+    RowSet odd;
+    for (AnyDataId rowId = 1u; rowId < 1000u; rowId += 2u)
+    {
+        odd.Insert (rowId);
+    }
+
+    // Filtered sets could be combined without another predicate evaluation.
+    matched.IntersectWith (odd);
+    for (AnyDataId rowId : matched)
+    {
+        BOOST_REQUIRE (rowId % 7u == 3u && rowId % 2u == 1u);
+    }
+
+    BOOST_REQUIRE (matched.GetSize () == 72u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,132 @@
+#include <set>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Miami/Richard/Data.hpp>
+#include <Miami/Richard/SlabPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (SlabPools)
+
+using namespace Miami::Richard;
+
+BOOST_AUTO_TEST_CASE (BlocksAreReused)
+{
+    using Pool = SlabPool <128u>;
+    std::set <void *> blocks;
+
+    for (std::size_t index = 0; index < Pool::BLOCKS_PER_SLAB; ++index)
+    {
+        BOOST_REQUIRE (blocks.emplace (Pool::Instance ().Acquire ()).second);
+    }
+
+    const std::size_t capacity = Pool::Instance ().GetCapacity ();
+    for (void *block : blocks)
+    {
+        Pool::Instance ().Release (block);
+    }
+
+    for (std::size_t index = 0; index < Pool::BLOCKS_PER_SLAB; ++index)
+    {
+        Pool::Instance ().Release (Pool::Instance ().Acquire ());
+    }
+
+    BOOST_REQUIRE (Pool::Instance ().GetCapacity () == capacity);
+}
+
+BOOST_AUTO_TEST_CASE (BlocksTravelBetweenThreads)
+{
+    using Pool = SlabPool <256u>;
+    constexpr std::size_t COUNT = Pool::BLOCKS_PER_SLAB * 4u;
+    std::vector <void *> blocks;
+
+    std::thread producer (
+        [&blocks] ()
+        {
+            for (std::size_t index = 0; index < COUNT; ++index)
+            {
+                blocks.emplace_back (Pool::Instance ().Acquire ());
+            }
+        });
+
+    producer.join ();
+    BOOST_REQUIRE (std::set <void *> (blocks.begin (), blocks.end ()).size () == COUNT);
+    const std::size_t capacity = Pool::Instance ().GetCapacity ();
+
+    // Blocks, released by another thread, go to its cache and then to shared free list.
+    std::thread consumer (
+        [&blocks] ()
+        {
+            for (void *block : blocks)
+            {
+                Pool::Instance ().Release (block);
+            }
+        });
+
+    // Slabs could be trimmed after consumer exit, but reacquisition never needs more slabs than producer.
+    consumer.join ();
+
+    for (std::size_t index = 0; index < COUNT; ++index)
+    {
+        blocks[index] = Pool::Instance ().Acquire ();
+    }
+
+    for (void *block : blocks)
+    {
+        Pool::Instance ().Release (block);
+    }
+
+    BOOST_REQUIRE (Pool::Instance ().GetCapacity () <= capacity);
+}
+
+BOOST_AUTO_TEST_CASE (TrimReleasesFreeSlabs)
+{
+    using Pool = SlabPool <512u>;
+    constexpr std::size_t COUNT = Pool::BLOCKS_PER_SLAB * 4u;
+    std::vector <void *> blocks;
+
+    for (std::size_t index = 0; index < COUNT; ++index)
+    {
+        blocks.emplace_back (Pool::Instance ().Acquire ());
+    }
+
+    const std::size_t capacity = Pool::Instance ().GetCapacity ();
+    BOOST_REQUIRE (capacity >= COUNT);
+
+    // Every slab still has acquired blocks, therefore none of them could be freed.
+    for (std::size_t index = 0; index < COUNT; index += 2u)
+    {
+        Pool::Instance ().Release (blocks[index]);
+    }
+
+    Pool::Instance ().Trim ();
+    BOOST_REQUIRE (Pool::Instance ().GetCapacity () == capacity);
+
+    for (std::size_t index = 1u; index < COUNT; index += 2u)
+    {
+        Pool::Instance ().Release (blocks[index]);
+    }
+
+    Pool::Instance ().Trim ();
+    BOOST_REQUIRE (Pool::Instance ().GetCapacity () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (ContainerMoveKeepsStorage)
+{
+    AnyDataContainer source (DataType::BLOB_16KB);
+    static_cast <uint8_t *> (source.GetDataStartPointer ())[100] = 42u;
+    const void *storage = source.GetDataStartPointer ();
+
+    AnyDataContainer moved (std::move (source));
+    BOOST_REQUIRE (moved.GetDataStartPointer () == storage);
+
+    AnyDataContainer copy (DataType::BLOB_16KB);
+    const void *copyStorage = copy.GetDataStartPointer ();
+    copy.CopyFrom (moved);
+
+    BOOST_REQUIRE (copy.GetDataStartPointer () == copyStorage);
+    BOOST_REQUIRE (static_cast <const uint8_t *> (copy.GetDataStartPointer ())[100] == 42u);
+    BOOST_REQUIRE (copy == moved);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,105 @@
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Snapshots)
+
+using namespace Miami::Richard;
+
+BOOST_FIXTURE_TEST_CASE (SnapshotIgnoresLaterChanges, TableCheckCommons)
+{
+    TableSnapshotCursor *rawSnapshot = nullptr;
+    {
+        auto writeGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        InsertRow (writeGuard, 1, 10);
+        InsertRow (writeGuard, 2, 20);
+        BOOST_REQUIRE (table->CreateSnapshotCursor (writeGuard, keyIndex, rawSnapshot) == ResultCode::OK);
+    }
+
+    std::unique_ptr <TableSnapshotCursor> snapshot (rawSnapshot);
+    {
+        // Writer is not blocked by snapshot, because snapshot does not hold any guard.
+        auto writeGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+        InsertRow (writeGuard, 0, 0);
+
+        TableEditCursor *rawEditCursor = nullptr;
+        BOOST_REQUIRE (table->CreateEditCursor (writeGuard, keyIndex, rawEditCursor) == ResultCode::OK);
+        std::unique_ptr <TableEditCursor> editCursor (rawEditCursor);
+
+        BOOST_REQUIRE (editCursor->Advance (writeGuard, 1) == ResultCode::OK);
+        Table::Row changes;
+        changes.emplace (valueColumn, MakeInt64 (100));
+        BOOST_REQUIRE (editCursor->Update (writeGuard, changes) == ResultCode::OK);
+
+        BOOST_REQUIRE (editCursor->Advance (writeGuard, 1) == ResultCode::OK);
+        BOOST_REQUIRE (editCursor->DeleteCurrent (writeGuard) == ResultCode::OK);
+    }
+
+    AnyDataContainer value;
+    bool isNull = true;
+
+    BOOST_REQUIRE (snapshot->Get (keyColumn, value, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && ReadInt64 (value) == 1);
+    BOOST_REQUIRE (snapshot->Get (valueColumn, value, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && ReadInt64 (value) == 10);
+
+    BOOST_REQUIRE (snapshot->Advance (1) == ResultCode::OK);
+    BOOST_REQUIRE (snapshot->Get (valueColumn, value, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && ReadInt64 (value) == 20);
+
+    BOOST_REQUIRE (snapshot->Advance (1) == ResultCode::OK);
+    BOOST_REQUIRE (snapshot->Get (valueColumn, value, isNull) == ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END);
+}
+
+BOOST_FIXTURE_TEST_CASE (SnapshotBlocksTableRemoval, TableCheckCommons)
+{
+    auto writeGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    InsertRow (writeGuard, 1, 10);
+
+    TableSnapshotCursor *rawSnapshot = nullptr;
+    BOOST_REQUIRE (table->CreateSnapshotCursor (writeGuard, keyIndex, rawSnapshot) == ResultCode::OK);
+    BOOST_REQUIRE (!table->IsSafeToRemove (writeGuard));
+
+    delete rawSnapshot;
+    BOOST_REQUIRE (table->IsSafeToRemove (writeGuard));
+}
+
+BOOST_FIXTURE_TEST_CASE (SnapshotsOfDifferentOrdersAreIndependent, TableCheckCommons)
+{
+    auto writeGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    InsertRow (writeGuard, 1, 10);
+    InsertRow (writeGuard, 2, 20);
+
+    TableSnapshotCursor *rawSnapshot = nullptr;
+    BOOST_REQUIRE (table->CreateSnapshotCursor (writeGuard, keyIndex, rawSnapshot) == ResultCode::OK);
+    std::unique_ptr <TableSnapshotCursor> first (rawSnapshot);
+    BOOST_REQUIRE (table->CreateSnapshotCursor (writeGuard, keyIndex, rawSnapshot) == ResultCode::OK);
+    std::unique_ptr <TableSnapshotCursor> second (rawSnapshot);
+
+    InsertRow (writeGuard, 0, 0);
+    BOOST_REQUIRE (table->CreateSnapshotCursor (writeGuard, keyIndex, rawSnapshot) == ResultCode::OK);
+    std::unique_ptr <TableSnapshotCursor> third (rawSnapshot);
+
+    BOOST_REQUIRE (first->Advance (2) == ResultCode::OK);
+    BOOST_REQUIRE (second->Advance (3) == ResultCode::CURSOR_ADVANCE_STOPPED_AT_END);
+    BOOST_REQUIRE (third->Advance (3) == ResultCode::OK);
+
+    AnyDataContainer value;
+    bool isNull = true;
+
+    BOOST_REQUIRE (first->Advance (-1) == ResultCode::OK);
+    BOOST_REQUIRE (first->Get (keyColumn, value, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && ReadInt64 (value) == 2);
+
+    BOOST_REQUIRE (first->Advance (-1) == ResultCode::OK);
+    BOOST_REQUIRE (first->Advance (-1) == ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN);
+    BOOST_REQUIRE (third->Advance (std::numeric_limits <int64_t>::min ()) ==
+                   ResultCode::CURSOR_ADVANCE_STOPPED_AT_BEGIN);
+
+    BOOST_REQUIRE (third->Get (keyColumn, value, isNull) == ResultCode::OK);
+    BOOST_REQUIRE (!isNull && ReadInt64 (value) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,104 @@
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Statistics)
+
+using namespace Miami::Richard;
+
+static TableStatistics RequestStatistics (TableCheckCommons &commons,
+                                          const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard)
+{
+    TableStatistics statistics;
+    BOOST_REQUIRE (commons.table->GetStatistics (guard, statistics) == ResultCode::OK);
+    BOOST_REQUIRE (statistics.columns_.size () == 2u);
+    BOOST_REQUIRE (statistics.columns_[0].columnId_ == commons.keyColumn);
+    BOOST_REQUIRE (statistics.columns_[1].columnId_ == commons.valueColumn);
+    return statistics;
+}
+
+BOOST_FIXTURE_TEST_CASE (CountsLimitsAndHistograms, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 1000; ++key)
+    {
+        InsertRow (guard, key, key % 50);
+    }
+
+    for (int64_t key = 1000; key < 1100; ++key)
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    TableStatistics statistics = RequestStatistics (*this, guard);
+    BOOST_REQUIRE (statistics.rowCount_ == 1100u);
+    BOOST_REQUIRE (statistics.changesSinceRefresh_ == 0u);
+
+    const ColumnStatistics &key = statistics.columns_[0];
+    BOOST_REQUIRE (key.nullCount_ == 0u);
+    BOOST_REQUIRE (key.distinctCount_ > 1050u && key.distinctCount_ <= 1100u);
+    BOOST_REQUIRE (key.hasLimits_ && ReadInt64 (key.min_) == 0 && ReadInt64 (key.max_) == 1099);
+    BOOST_REQUIRE (key.histogramDepth_ == 35u);
+    BOOST_REQUIRE (key.histogramBounds_.size () == 32u);
+    BOOST_REQUIRE (ReadInt64 (key.histogramBounds_.back ()) == 1099);
+
+    const uint64_t estimate = EstimateLessCount (key, MakeInt64 (550));
+    BOOST_REQUIRE (estimate + key.histogramDepth_ >= 550u && estimate <= 550u + key.histogramDepth_);
+
+    const ColumnStatistics &value = statistics.columns_[1];
+    BOOST_REQUIRE (value.nullCount_ == 100u);
+    BOOST_REQUIRE (value.distinctCount_ >= 49u && value.distinctCount_ <= 51u);
+    BOOST_REQUIRE (value.hasLimits_ && ReadInt64 (value.min_) == 0 && ReadInt64 (value.max_) == 49);
+}
+
+BOOST_FIXTURE_TEST_CASE (RefreshAfterChanges, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    for (int64_t key = 0; key < 1000; ++key)
+    {
+        InsertRow (guard, key, key);
+    }
+
+    RequestStatistics (*this, guard);
+
+    // Small change count is applied incrementally: limits are widened, exact counters follow rows.
+    for (int64_t key = 5000; key < 5010; ++key)
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        BOOST_REQUIRE (table->InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    TableStatistics statistics = RequestStatistics (*this, guard);
+    BOOST_REQUIRE (statistics.rowCount_ == 1010u);
+    BOOST_REQUIRE (statistics.changesSinceRefresh_ == 10u);
+    BOOST_REQUIRE (ReadInt64 (statistics.columns_[0].max_) == 5009);
+    BOOST_REQUIRE (ReadInt64 (statistics.columns_[0].histogramBounds_.back ()) == 999);
+    BOOST_REQUIRE (statistics.columns_[1].nullCount_ == 10u);
+
+    // Deletion of half of rows makes statistics stale, so they are rebuilt.
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateEditCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+    BOOST_REQUIRE (cursor->Advance (guard, 500) == ResultCode::OK);
+
+    const AnyDataContainer *value = nullptr;
+    while (cursor->Get (guard, keyColumn, value) == ResultCode::OK)
+    {
+        BOOST_REQUIRE (cursor->DeleteCurrent (guard) == ResultCode::OK);
+    }
+
+    cursor.reset ();
+    statistics = RequestStatistics (*this, guard);
+    BOOST_REQUIRE (statistics.rowCount_ == 500u);
+    BOOST_REQUIRE (statistics.changesSinceRefresh_ == 0u);
+
+    const ColumnStatistics &key = statistics.columns_[0];
+    BOOST_REQUIRE (ReadInt64 (key.min_) == 0 && ReadInt64 (key.max_) == 499);
+    BOOST_REQUIRE (key.distinctCount_ > 475u && key.distinctCount_ <= 500u);
+    BOOST_REQUIRE (statistics.columns_[1].nullCount_ == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
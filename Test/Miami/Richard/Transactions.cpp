@@ -0,0 +1,157 @@
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (Transactions)
+
+using namespace Miami::Richard;
+
+/// Conduit with two tables, each has two INT64 columns and one ordered index over first column.
+class TransactionCheckCommons
+{
+public:
+    TransactionCheckCommons ()
+        : conduit (&context)
+    {
+        auto conduitWriteGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Write ()));
+        for (AnyDataId &tableId : tableIds)
+        {
+            BOOST_REQUIRE (conduit.AddTable (conduitWriteGuard, "Test", tableId) == ResultCode::OK);
+            Table *table = nullptr;
+            BOOST_REQUIRE (conduit.GetTable (conduitWriteGuard, tableId, table) == ResultCode::OK);
+
+            auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+            BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT64, "key"}, keyColumn) == ResultCode::OK);
+            BOOST_REQUIRE (table->AddColumn (guard, {0, DataType::INT64, "value"}, valueColumn) == ResultCode::OK);
+            BOOST_REQUIRE (table->AddIndex (guard, {0, "key", {keyColumn}}, keyIndex) == ResultCode::OK);
+        }
+
+        conduitWriteGuard.reset ();
+        conduitGuard = CaptureGuard (Miami::Disco::AnyLockPointer (&conduit.ReadWriteGuard ().Read ()));
+    }
+
+    std::unique_ptr <Transaction> Begin ()
+    {
+        std::vector <Miami::Disco::AnyLockPointer> locks;
+        BOOST_REQUIRE (conduit.PrepareTransaction (conduitGuard, {tableIds[0], tableIds[1]}, locks) ==
+                       ResultCode::OK);
+
+        tableGuards = CaptureGuards (locks);
+        Transaction *transaction = nullptr;
+        BOOST_REQUIRE (conduit.BeginTransaction (conduitGuard, {tableIds[0], tableIds[1]}, tableGuards,
+                                                 transaction) == ResultCode::OK);
+        return std::unique_ptr <Transaction> (transaction);
+    }
+
+    Table *GetTable (std::size_t index)
+    {
+        Table *table = nullptr;
+        BOOST_REQUIRE (conduit.GetTable (conduitGuard, tableIds[index], table) == ResultCode::OK);
+        return table;
+    }
+
+    /// Collects values of given table in key order.
+    std::vector <int64_t> ReadValues (std::size_t index, const std::shared_ptr <Miami::Disco::SafeLockGuard> &guard)
+    {
+        TableReadCursor *rawCursor = nullptr;
+        BOOST_REQUIRE (GetTable (index)->CreateReadCursor (guard, keyIndex, rawCursor) == ResultCode::OK);
+        std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+        std::vector <int64_t> values;
+        const AnyDataContainer *value = nullptr;
+
+        while (cursor->Get (guard, valueColumn, value) == ResultCode::OK)
+        {
+            BOOST_REQUIRE (value);
+            values.push_back (ReadInt64 (*value));
+            cursor->Advance (guard, 1);
+        }
+
+        return values;
+    }
+
+    Table::Row MakeRow (int64_t key, int64_t value) const
+    {
+        Table::Row row;
+        row.emplace (keyColumn, MakeInt64 (key));
+        row.emplace (valueColumn, MakeInt64 (value));
+        return row;
+    }
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    Conduit conduit;
+    std::shared_ptr <Miami::Disco::SafeLockGuard> conduitGuard;
+    std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>> tableGuards;
+
+    AnyDataId tableIds[2] {0, 0};
+    AnyDataId keyColumn = 0;
+    AnyDataId valueColumn = 0;
+    AnyDataId keyIndex = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE (CommitAppliesChangesToAllTables, TransactionCheckCommons)
+{
+    std::unique_ptr <Transaction> transaction = Begin ();
+    Table::Row first = MakeRow (1, 10);
+    Table::Row second = MakeRow (2, 20);
+
+    BOOST_REQUIRE (transaction->InsertRow (tableIds[0], first) == ResultCode::OK);
+    BOOST_REQUIRE (transaction->InsertRow (tableIds[1], second) == ResultCode::OK);
+
+    // Changes are buffered until commit.
+    BOOST_REQUIRE (ReadValues (0, tableGuards[0]).empty ());
+    BOOST_REQUIRE (transaction->Commit () == ResultCode::OK);
+
+    BOOST_REQUIRE (ReadValues (0, tableGuards[0]) == std::vector <int64_t> {10});
+    BOOST_REQUIRE (ReadValues (1, tableGuards[1]) == std::vector <int64_t> {20});
+}
+
+BOOST_FIXTURE_TEST_CASE (FailedCommitRevertsAppliedChanges, TransactionCheckCommons)
+{
+    std::unique_ptr <Transaction> transaction = Begin ();
+    {
+        Table::Row row = MakeRow (1, 10);
+        BOOST_REQUIRE (GetTable (0)->InsertRow (tableGuards[0], row) == ResultCode::OK);
+    }
+
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (GetTable (0)->CreateEditCursor (tableGuards[0], keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+    Table::Row inserted = MakeRow (2, 20);
+    Table::Row changes;
+    changes.emplace (valueColumn, MakeInt64 (100));
+
+    BOOST_REQUIRE (transaction->InsertRow (tableIds[1], inserted) == ResultCode::OK);
+    BOOST_REQUIRE (transaction->UpdateCurrent (cursor.get (), changes) == ResultCode::OK);
+    BOOST_REQUIRE (transaction->DeleteCurrent (cursor.get ()) == ResultCode::OK);
+
+    // Second deletion of the same row fails during commit, so every previous change must be reverted.
+    BOOST_REQUIRE (transaction->DeleteCurrent (cursor.get ()) == ResultCode::OK);
+    BOOST_REQUIRE (transaction->Commit () != ResultCode::OK);
+
+    BOOST_REQUIRE (ReadValues (0, tableGuards[0]) == std::vector <int64_t> {10});
+    BOOST_REQUIRE (ReadValues (1, tableGuards[1]).empty ());
+}
+
+BOOST_FIXTURE_TEST_CASE (RollbackDiscardsChanges, TransactionCheckCommons)
+{
+    std::unique_ptr <Transaction> transaction = Begin ();
+    Table::Row row = MakeRow (1, 10);
+
+    BOOST_REQUIRE (transaction->InsertRow (tableIds[0], row) == ResultCode::OK);
+    transaction->Rollback ();
+    BOOST_REQUIRE (transaction->Commit () == ResultCode::OK);
+    BOOST_REQUIRE (ReadValues (0, tableGuards[0]).empty ());
+}
+
+BOOST_FIXTURE_TEST_CASE (TablesMustBeUnique, TransactionCheckCommons)
+{
+    std::vector <Miami::Disco::AnyLockPointer> locks;
+    BOOST_REQUIRE (conduit.PrepareTransaction (conduitGuard, {tableIds[0], tableIds[0]}, locks) ==
+                   ResultCode::TRANSACTION_TABLES_MUST_BE_UNIQUE);
+    BOOST_REQUIRE (conduit.PrepareTransaction (conduitGuard, {}, locks) ==
+                   ResultCode::TRANSACTION_MUST_COVER_AT_LEAST_ONE_TABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
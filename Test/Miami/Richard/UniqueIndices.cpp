@@ -0,0 +1,115 @@
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (UniqueIndices)
+
+using namespace Miami::Richard;
+
+static void CheckUniqueness (TableCheckCommons &commons, IndexType indexType)
+{
+    Table *table = commons.table.get ();
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+
+    AnyDataId uniqueIndex;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "unique", {commons.keyColumn}, indexType, true}, uniqueIndex) ==
+                   ResultCode::OK);
+
+    commons.InsertRow (guard, 1, 10);
+    commons.InsertRow (guard, 2, 20);
+
+    Table::Row duplicate;
+    duplicate.emplace (commons.keyColumn, MakeInt64 (1));
+    BOOST_REQUIRE (table->InsertRow (guard, duplicate) == ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+
+    // Null keys are not checked.
+    for (int iteration = 0; iteration < 2; ++iteration)
+    {
+        Table::Row nullKey;
+        nullKey.emplace (commons.valueColumn, MakeInt64 (0));
+        BOOST_REQUIRE (table->InsertRow (guard, nullKey) == ResultCode::OK);
+    }
+
+    TableEditCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateEditCursor (guard, commons.keyIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableEditCursor> cursor (rawCursor);
+
+    // Skip null keys, they are less than anything.
+    BOOST_REQUIRE (cursor->Advance (guard, 3) == ResultCode::OK);
+
+    Table::Row changes;
+    changes.emplace (commons.keyColumn, MakeInt64 (1));
+    BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+
+    // Update, that does not change key, must not conflict with updated row itself.
+    changes.clear ();
+    changes.emplace (commons.keyColumn, MakeInt64 (2));
+    changes.emplace (commons.valueColumn, MakeInt64 (21));
+    BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+    cursor.reset ();
+
+    // Cursor is reopened, so it does not depend on whether updated row was moved in key index order.
+    BOOST_REQUIRE (table->CreateEditCursor (guard, commons.keyIndex, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+    BOOST_REQUIRE (cursor->Advance (guard, 3) == ResultCode::OK);
+
+    changes.clear ();
+    changes.emplace (commons.keyColumn, MakeInt64 (3));
+    BOOST_REQUIRE (cursor->Update (guard, changes) == ResultCode::OK);
+    commons.InsertRow (guard, 2, 22);
+}
+
+BOOST_FIXTURE_TEST_CASE (OrderedIndexUniqueness, TableCheckCommons)
+{
+    CheckUniqueness (*this, IndexType::ORDERED);
+}
+
+BOOST_FIXTURE_TEST_CASE (HashIndexUniqueness, TableCheckCommons)
+{
+    CheckUniqueness (*this, IndexType::HASH);
+}
+
+BOOST_FIXTURE_TEST_CASE (UniqueIndexOverDuplicates, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    InsertRow (guard, 1, 10);
+    InsertRow (guard, 1, 20);
+
+    AnyDataId indexId;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "unique", {keyColumn}, IndexType::ORDERED, true}, indexId) ==
+                   ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "unique", {keyColumn}, IndexType::HASH, true}, indexId) ==
+                   ResultCode::UNIQUE_INDEX_CONSTRAINT_VIOLATED);
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "unique", {keyColumn, valueColumn}, IndexType::ORDERED, true},
+                                    indexId) == ResultCode::OK);
+}
+
+BOOST_FIXTURE_TEST_CASE (MultiColumnOrder, TableCheckCommons)
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    InsertRow (guard, 2, 1);
+    InsertRow (guard, 1, 2);
+    InsertRow (guard, 1, 1);
+
+    AnyDataId indexId;
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "pair", {keyColumn, valueColumn}}, indexId) == ResultCode::OK);
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table->CreateReadCursor (guard, indexId, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    // Second column must be compared only if first column values are equal.
+    const std::pair <int64_t, int64_t> expected[] {{1, 1}, {1, 2}, {2, 1}};
+    for (const auto &pair : expected)
+    {
+        const AnyDataContainer *key = nullptr;
+        const AnyDataContainer *value = nullptr;
+
+        BOOST_REQUIRE (cursor->Get (guard, keyColumn, key) == ResultCode::OK);
+        BOOST_REQUIRE (cursor->Get (guard, valueColumn, value) == ResultCode::OK);
+        BOOST_REQUIRE (ReadInt64 (*key) == pair.first && ReadInt64 (*value) == pair.second);
+        cursor->Advance (guard, 1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
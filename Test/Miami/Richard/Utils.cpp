@@ -0,0 +1,72 @@
+#include "Utils.hpp"
+
+#include <future>
+
+#include <boost/test/unit_test.hpp>
+
+std::shared_ptr <Miami::Disco::SafeLockGuard> CaptureGuard (const Miami::Disco::AnyLockPointer &lock)
+{
+    std::promise <std::shared_ptr <Miami::Disco::SafeLockGuard>> captured;
+    Miami::Disco::After (
+        lock,
+        [&captured] (std::shared_ptr <Miami::Disco::SafeLockGuard> guard)
+        {
+            captured.set_value (guard);
+        });
+
+    return captured.get_future ().get ();
+}
+
+std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>> CaptureGuards (
+    const std::vector <Miami::Disco::AnyLockPointer> &locks)
+{
+    std::promise <std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>>> captured;
+    Miami::Disco::After (
+        locks,
+        [&captured] (std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>> guards)
+        {
+            captured.set_value (guards);
+        });
+
+    return captured.get_future ().get ();
+}
+
+Miami::Richard::AnyDataContainer MakeInt64 (int64_t value)
+{
+    Miami::Richard::AnyDataContainer container (Miami::Richard::DataType::INT64);
+    *static_cast <int64_t *> (container.GetDataStartPointer ()) = value;
+    return container;
+}
+
+int64_t ReadInt64 (const Miami::Richard::AnyDataContainer &container)
+{
+    BOOST_REQUIRE (container.GetType () == Miami::Richard::DataType::INT64);
+    return *static_cast <const int64_t *> (container.GetDataStartPointer ());
+}
+
+TableCheckCommons::TableCheckCommons ()
+    : table (std::make_unique <Miami::Richard::Table> (&context, 0, "Test"))
+{
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table->ReadWriteGuard ().Write ()));
+    BOOST_REQUIRE (table->AddColumn (guard, {0, Miami::Richard::DataType::INT64, "key"}, keyColumn) ==
+                   Miami::Richard::ResultCode::OK);
+
+    BOOST_REQUIRE (table->AddColumn (guard, {0, Miami::Richard::DataType::INT64, "value"}, valueColumn) ==
+                   Miami::Richard::ResultCode::OK);
+
+    BOOST_REQUIRE (table->AddIndex (guard, {0, "key", {keyColumn}}, keyIndex) == Miami::Richard::ResultCode::OK);
+}
+
+TableCheckCommons::~TableCheckCommons ()
+{
+    table.reset ();
+}
+
+void TableCheckCommons::InsertRow (const std::shared_ptr <Miami::Disco::SafeLockGuard> &writeGuard,
+                                   int64_t key, int64_t value)
+{
+    Miami::Richard::Table::Row row;
+    row.emplace (keyColumn, MakeInt64 (key));
+    row.emplace (valueColumn, MakeInt64 (value));
+    BOOST_REQUIRE (table->InsertRow (writeGuard, row) == Miami::Richard::ResultCode::OK);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Miami/Disco/Disco.hpp>
+
+#include <Miami/Richard/Conduit.hpp>
+#include <Miami/Richard/Table.hpp>
+
+#define TEST_WORKERS_COUNT 4
+
+std::shared_ptr <Miami::Disco::SafeLockGuard> CaptureGuard (const Miami::Disco::AnyLockPointer &lock);
+
+std::vector <std::shared_ptr <Miami::Disco::SafeLockGuard>> CaptureGuards (
+    const std::vector <Miami::Disco::AnyLockPointer> &locks);
+
+Miami::Richard::AnyDataContainer MakeInt64 (int64_t value);
+
+int64_t ReadInt64 (const Miami::Richard::AnyDataContainer &container);
+
+/// Table with two INT64 columns ("key" and "value") and ordered index over "key".
+class TableCheckCommons
+{
+public:
+    TableCheckCommons ();
+
+    ~TableCheckCommons ();
+
+    void InsertRow (const std::shared_ptr <Miami::Disco::SafeLockGuard> &writeGuard, int64_t key, int64_t value);
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    std::unique_ptr <Miami::Richard::Table> table;
+
+    Miami::Richard::AnyDataId keyColumn = 0;
+    Miami::Richard::AnyDataId valueColumn = 0;
+    Miami::Richard::AnyDataId keyIndex = 0;
+};
@@ -0,0 +1,134 @@
+#include <cstring>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Utils.hpp"
+
+BOOST_AUTO_TEST_SUITE (VariableSizeData)
+
+using namespace Miami::Richard;
+
+static AnyDataContainer MakeVarchar (const std::string &value)
+{
+    AnyDataContainer container (DataType::VARCHAR);
+    container.ResizeData (static_cast <uint32_t> (value.size ()));
+    memcpy (container.GetDataStartPointer (), value.data (), value.size ());
+    return container;
+}
+
+static std::string ReadVarchar (const AnyDataContainer &container)
+{
+    return std::string (static_cast <const char *> (container.GetDataStartPointer ()), container.GetDataSize ());
+}
+
+BOOST_AUTO_TEST_CASE (InlineAndExternalValues)
+{
+    const std::string shortValue = "abc";
+    const std::string longValue (200u, 'x');
+
+    AnyDataContainer shortContainer = MakeVarchar (shortValue);
+    AnyDataContainer longContainer = MakeVarchar (longValue);
+    BOOST_REQUIRE (shortContainer.GetDataSize () == 3u);
+    BOOST_REQUIRE (longContainer.GetDataSize () == 200u);
+
+    AnyDataContainer copy (longContainer);
+    BOOST_REQUIRE (copy == longContainer);
+    BOOST_REQUIRE (copy.GetDataStartPointer () != longContainer.GetDataStartPointer ());
+
+    // Move must transfer external buffer instead of copying it.
+    const void *buffer = copy.GetDataStartPointer ();
+    AnyDataContainer moved;
+    moved = std::move (copy);
+    BOOST_REQUIRE (moved.GetDataStartPointer () == buffer);
+    BOOST_REQUIRE (ReadVarchar (moved) == longValue);
+
+    // Order is lexicographical: shorter prefix is less than longer sequence.
+    BOOST_REQUIRE (MakeVarchar ("ab") < MakeVarchar ("abc"));
+    BOOST_REQUIRE (MakeVarchar ("abc") < MakeVarchar ("b"));
+    BOOST_REQUIRE (MakeVarchar ("") < MakeVarchar ("a"));
+    BOOST_REQUIRE (MakeVarchar ("abc") != MakeVarchar ("abd"));
+    BOOST_REQUIRE (MakeVarchar (longValue) == longContainer);
+}
+
+BOOST_AUTO_TEST_CASE (ColumnMaxSize)
+{
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    Table table (&context, 0, "Test");
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table.ReadWriteGuard ().Write ()));
+
+    AnyDataId columnId;
+    BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::VARCHAR, "name", MAX_VARIABLE_DATA_SIZE + 1u}, columnId) ==
+                   ResultCode::COLUMN_MAX_SIZE_IS_TOO_BIG);
+
+    BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::VARCHAR, "any"}, columnId) == ResultCode::OK);
+    ColumnInfo info;
+    BOOST_REQUIRE (table.GetColumnInfo (guard, columnId, info) == ResultCode::OK);
+    BOOST_REQUIRE (info.maxSize_ == MAX_VARIABLE_DATA_SIZE);
+
+    BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::VARCHAR, "name", 8u}, columnId) == ResultCode::OK);
+    Table::Row row;
+    row.emplace (columnId, MakeVarchar ("12345678"));
+    BOOST_REQUIRE (table.InsertRow (guard, row) == ResultCode::OK);
+
+    row.clear ();
+    row.emplace (columnId, MakeVarchar ("123456789"));
+    BOOST_REQUIRE (table.InsertRow (guard, row) == ResultCode::NEW_COLUMN_VALUE_IS_TOO_BIG);
+}
+
+BOOST_AUTO_TEST_CASE (Indices)
+{
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    Table table (&context, 0, "Test");
+    auto guard = CaptureGuard (Miami::Disco::AnyLockPointer (&table.ReadWriteGuard ().Write ()));
+
+    AnyDataId firstColumn;
+    AnyDataId secondColumn;
+    BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::VARCHAR, "first"}, firstColumn) == ResultCode::OK);
+    BOOST_REQUIRE (table.AddColumn (guard, {0, DataType::VARCHAR, "second"}, secondColumn) == ResultCode::OK);
+
+    AnyDataId orderedIndex;
+    AnyDataId hashIndex;
+    BOOST_REQUIRE (table.AddIndex (guard, {0, "ordered", {firstColumn}}, orderedIndex) == ResultCode::OK);
+    BOOST_REQUIRE (table.AddIndex (guard, {0, "hash", {firstColumn, secondColumn}, IndexType::HASH},
+                                   hashIndex) == ResultCode::OK);
+
+    // Pairs ("ab", "c") and ("a", "bc") have equal concatenations, but must have different hash keys.
+    const std::pair <std::string, std::string> values[] {
+        {"b", "1"}, {"ab", "c"}, {"a", "bc"}, {std::string (100u, 'a'), "2"}};
+
+    for (const auto &pair : values)
+    {
+        Table::Row row;
+        row.emplace (firstColumn, MakeVarchar (pair.first));
+        row.emplace (secondColumn, MakeVarchar (pair.second));
+        BOOST_REQUIRE (table.InsertRow (guard, row) == ResultCode::OK);
+    }
+
+    TableReadCursor *rawCursor = nullptr;
+    BOOST_REQUIRE (table.CreateReadCursor (guard, orderedIndex, rawCursor) == ResultCode::OK);
+    std::unique_ptr <TableReadCursor> cursor (rawCursor);
+
+    const std::string expectedOrder[] {"a", std::string (100u, 'a'), "ab", "b"};
+    for (const std::string &expected : expectedOrder)
+    {
+        const AnyDataContainer *value = nullptr;
+        BOOST_REQUIRE (cursor->Get (guard, firstColumn, value) == ResultCode::OK);
+        BOOST_REQUIRE (value && ReadVarchar (*value) == expected);
+        cursor->Advance (guard, 1);
+    }
+
+    Table::Row key;
+    key.emplace (firstColumn, MakeVarchar ("ab"));
+    key.emplace (secondColumn, MakeVarchar ("c"));
+    BOOST_REQUIRE (table.CreateLookupCursor (guard, hashIndex, key, rawCursor) == ResultCode::OK);
+    cursor.reset (rawCursor);
+
+    const AnyDataContainer *value = nullptr;
+    BOOST_REQUIRE (cursor->Get (guard, firstColumn, value) == ResultCode::OK);
+    BOOST_REQUIRE (value && ReadVarchar (*value) == "ab");
+    BOOST_REQUIRE (cursor->Advance (guard, 1) == ResultCode::OK);
+    BOOST_REQUIRE (cursor->Get (guard, firstColumn, value) == ResultCode::CURSOR_GET_CURRENT_UNABLE_TO_GET_FROM_END);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,227 @@
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <App/Miami/Server/Context.hpp>
+#include <App/Miami/Sharding/Connection.hpp>
+
+BOOST_AUTO_TEST_SUITE (EditSessions)
+
+using namespace Miami::App::Messaging;
+using Miami::App::Sharding::Connection;
+using Miami::App::Sharding::Response;
+using Miami::Richard::AnyDataContainer;
+using Miami::Richard::DataType;
+
+#define TEST_WORKERS_COUNT 4
+
+static AnyDataContainer MakeInt64 (int64_t value)
+{
+    AnyDataContainer container (DataType::INT64);
+    *static_cast <int64_t *> (container.GetDataStartPointer ()) = value;
+    return container;
+}
+
+static int64_t ReadInt64 (const Response &response, std::size_t row, std::size_t column)
+{
+    const std::size_t index = row * response.rows_.columnsCount_ + column;
+    BOOST_REQUIRE (!response.rows_.nulls_[index]);
+    return *static_cast <const int64_t *> (response.rows_.values_[index].GetDataStartPointer ());
+}
+
+/// Starts one server inside test process and opens several sessions to it.
+class ServerCheckCommons
+{
+public:
+    ServerCheckCommons ()
+        : port (nextPort++),
+          server (std::make_unique <Miami::App::Server::Context> (TEST_WORKERS_COUNT)),
+          thread ([this] ()
+                  {
+                      result = server->Execute (port);
+                  })
+    {
+    }
+
+    ~ServerCheckCommons ()
+    {
+        sessions.clear ();
+        server->RequestAbort ();
+        thread.join ();
+        BOOST_CHECK (result == Miami::App::Server::ResultCode::OK);
+    }
+
+    /// Server is started asynchronously, so connection is retried until it listens.
+    Connection &Connect ()
+    {
+        sessions.emplace_back (std::make_unique <Connection> (&context));
+        for (std::size_t attempt = 0u; attempt < 100u; ++attempt)
+        {
+            if (sessions.back ()->Connect ("127.0.0.1", std::to_string (port)))
+            {
+                return *sessions.back ();
+            }
+
+            sessions.back () = std::make_unique <Connection> (&context);
+            std::this_thread::sleep_for (std::chrono::milliseconds (20));
+        }
+
+        BOOST_FAIL ("Unable to connect to server!");
+        return *sessions.back ();
+    }
+
+    static uint16_t nextPort;
+
+    uint16_t port;
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    Miami::App::Server::ResultCode result = Miami::App::Server::ResultCode::OK;
+    std::unique_ptr <Miami::App::Server::Context> server;
+    std::thread thread;
+    std::vector <std::unique_ptr <Connection>> sessions;
+};
+
+uint16_t ServerCheckCommons::nextPort = 27630u;
+
+BOOST_FIXTURE_TEST_CASE (SessionsEditDisjointRowsAtOnce, ServerCheckCommons)
+{
+    Connection &first = Connect ();
+    Connection &second = Connect ();
+
+    ConduitVoidActionRequest conduitRequest {};
+    BOOST_REQUIRE (first.Execute (Message::GET_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest, "get conduit"));
+
+    AddTableRequest addTable {};
+    addTable.tableName_ = "Edited";
+    ResourceId tableId;
+    BOOST_REQUIRE (first.Execute (Message::ADD_TABLE_REQUEST, addTable, "add table", &tableId));
+
+    TableOperationRequest tableRequest {};
+    tableRequest.tableId_ = tableId;
+    BOOST_REQUIRE (first.Execute (Message::GET_TABLE_WRITE_ACCESS_REQUEST, tableRequest, "get table write"));
+
+    AddColumnRequest addColumn {};
+    addColumn.tableId_ = tableId;
+    addColumn.dataType_ = DataType::INT64;
+    ResourceId keyColumn;
+    ResourceId valueColumn;
+
+    addColumn.name_ = "key";
+    BOOST_REQUIRE (first.Execute (Message::ADD_COLUMN_REQUEST, addColumn, "add key column", &keyColumn));
+    addColumn.name_ = "value";
+    BOOST_REQUIRE (first.Execute (Message::ADD_COLUMN_REQUEST, addColumn, "add value column", &valueColumn));
+
+    AddIndexRequest addIndex {};
+    addIndex.tableId_ = tableId;
+    addIndex.type_ = Miami::Richard::IndexType::ORDERED;
+    addIndex.unique_ = true;
+    addIndex.name_ = "keys";
+    addIndex.columns_ = {keyColumn};
+    ResourceId keyIndex;
+    BOOST_REQUIRE (first.Execute (Message::ADD_INDEX_REQUEST, addIndex, "add index", &keyIndex));
+
+    for (int64_t key = 1; key <= 2; ++key)
+    {
+        AddRowRequest addRow {};
+        addRow.tableId_ = tableId;
+        addRow.values_.emplace_back (keyColumn, MakeInt64 (key));
+        addRow.values_.emplace_back (valueColumn, MakeInt64 (key * 10));
+        BOOST_REQUIRE (first.Execute (Message::ADD_ROW_REQUEST, addRow, "add row"));
+    }
+
+    BOOST_REQUIRE (first.Execute (Message::CLOSE_TABLE_WRITE_ACCESS_REQUEST, tableRequest, "close table write"));
+    BOOST_REQUIRE (first.Execute (Message::CLOSE_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest, "close conduit"));
+
+    // Both sessions hold edit access to the same table at once.
+    BOOST_REQUIRE (first.Execute (Message::GET_CONDUIT_READ_ACCESS_REQUEST, conduitRequest, "get conduit"));
+    BOOST_REQUIRE (second.Execute (Message::GET_CONDUIT_READ_ACCESS_REQUEST, conduitRequest, "get conduit"));
+    BOOST_REQUIRE (first.Execute (Message::GET_TABLE_EDIT_ACCESS_REQUEST, tableRequest, "get table edit"));
+    BOOST_REQUIRE (second.Execute (Message::GET_TABLE_EDIT_ACCESS_REQUEST, tableRequest, "get table edit"));
+
+    // Edit access does not allow structural changes and could not be mixed with other accesses.
+    addColumn.name_ = "forbidden";
+    std::future <Response> rejected = first.Send (Message::ADD_COLUMN_REQUEST, addColumn);
+    BOOST_CHECK (rejected.get ().result_ == OperationResult::TABLE_WRITE_ACCESS_REQUIRED);
+
+    rejected = first.Send (Message::GET_TABLE_WRITE_ACCESS_REQUEST, tableRequest);
+    BOOST_CHECK (rejected.get ().result_ == OperationResult::ALREADY_HAS_EDIT_ACCESS);
+
+    std::vector <Connection *> editors {&first, &second};
+    std::vector <ResourceId> cursors;
+
+    for (std::size_t index = 0u; index < editors.size (); ++index)
+    {
+        CreateLookupCursorRequest lookup {};
+        lookup.tableId_ = tableId;
+        lookup.indexId_ = keyIndex;
+        lookup.values_.emplace_back (keyColumn, MakeInt64 (static_cast <int64_t> (index) + 1));
+
+        ResourceId cursorId;
+        BOOST_REQUIRE (editors[index]->Execute (
+            Message::CREATE_LOOKUP_EDIT_CURSOR_REQUEST, lookup, "create lookup edit cursor", &cursorId));
+        cursors.emplace_back (cursorId);
+    }
+
+    // Requests are sent before any response is awaited, so sessions edit their rows concurrently.
+    std::vector <std::future <Response>> responses;
+    for (int64_t round = 1; round <= 100; ++round)
+    {
+        for (std::size_t index = 0u; index < editors.size (); ++index)
+        {
+            const int64_t key = static_cast <int64_t> (index) + 1;
+            CursorUpdateRequest update {};
+            update.cursorId_ = cursors[index];
+            update.values_.emplace_back (valueColumn, MakeInt64 (key * 1000 + round));
+            responses.emplace_back (editors[index]->Send (Message::CURSOR_UPDATE_REQUEST, update));
+
+            AddRowRequest addRow {};
+            addRow.tableId_ = tableId;
+            addRow.values_.emplace_back (keyColumn, MakeInt64 (round * 10 + key));
+            responses.emplace_back (editors[index]->Send (Message::ADD_ROW_REQUEST, addRow));
+        }
+    }
+
+    for (std::future <Response> &response : responses)
+    {
+        BOOST_CHECK (response.get ().result_ == OperationResult::OK);
+    }
+
+    CursorVoidActionRequest deleteRequest {};
+    deleteRequest.cursorId_ = cursors[1];
+    BOOST_REQUIRE (second.Execute (Message::CURSOR_DELETE_REQUEST, deleteRequest, "delete row"));
+
+    for (std::size_t index = 0u; index < editors.size (); ++index)
+    {
+        CursorVoidActionRequest closeCursor {};
+        closeCursor.cursorId_ = cursors[index];
+        BOOST_REQUIRE (editors[index]->Execute (Message::CLOSE_CURSOR_REQUEST, closeCursor, "close cursor"));
+    }
+
+    rejected = first.Send (Message::CLOSE_TABLE_WRITE_ACCESS_REQUEST, tableRequest);
+    BOOST_CHECK (rejected.get ().result_ == OperationResult::TABLE_WRITE_ACCESS_REQUIRED);
+
+    BOOST_REQUIRE (first.Execute (Message::CLOSE_TABLE_EDIT_ACCESS_REQUEST, tableRequest, "close table edit"));
+    BOOST_REQUIRE (second.Execute (Message::CLOSE_TABLE_EDIT_ACCESS_REQUEST, tableRequest, "close table edit"));
+    BOOST_REQUIRE (first.Execute (Message::GET_TABLE_READ_ACCESS_REQUEST, tableRequest, "get table read"));
+
+    ExecuteQueryRequest query {};
+    query.tableId_ = tableId;
+    query.projection_ = {keyColumn, valueColumn};
+    query.order_.push_back ({0u, false});
+    query.limit_ = std::numeric_limits <uint64_t>::max ();
+
+    Response output;
+    BOOST_REQUIRE (first.Execute (Message::EXECUTE_QUERY_REQUEST, query, "execute query", output));
+
+    // Second row was deleted and 200 rows were inserted under edit access.
+    BOOST_REQUIRE_EQUAL (output.rows_.GetRowsCount (), 201u);
+    BOOST_CHECK_EQUAL (ReadInt64 (output, 0u, 0u), 1);
+    // Requests of one session are not ordered, so only owner of the last update is checked.
+    BOOST_CHECK_EQUAL (ReadInt64 (output, 0u, 1u) / 1000, 1);
+    BOOST_CHECK_EQUAL (ReadInt64 (output, 1u, 0u), 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
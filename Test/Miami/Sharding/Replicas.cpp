@@ -0,0 +1,113 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include <App/Miami/Server/Context.hpp>
+#include <App/Miami/Sharding/Connection.hpp>
+
+BOOST_AUTO_TEST_SUITE (Replicas)
+
+using namespace Miami::App::Messaging;
+using Miami::App::Sharding::Connection;
+using Miami::App::Sharding::Response;
+
+#define TEST_WORKERS_COUNT 2
+
+/// Server, started inside test process, with connection to it.
+struct RunningServer
+{
+    RunningServer (std::unique_ptr <Miami::App::Server::Context> context, uint16_t port)
+        : server (std::move (context)),
+          thread ([this, port] ()
+                  {
+                      result = server->Execute (port);
+                  })
+    {
+    }
+
+    ~RunningServer ()
+    {
+        connection.reset ();
+        server->RequestAbort ();
+        thread.join ();
+        BOOST_CHECK (result == Miami::App::Server::ResultCode::OK);
+    }
+
+    /// Server is started asynchronously, so connection is retried until it listens.
+    Connection &Connect (Miami::Disco::Context *context, uint16_t port)
+    {
+        for (std::size_t attempt = 0u; attempt < 100u; ++attempt)
+        {
+            connection = std::make_unique <Connection> (context);
+            if (connection->Connect ("127.0.0.1", std::to_string (port)))
+            {
+                return *connection;
+            }
+
+            std::this_thread::sleep_for (std::chrono::milliseconds (20));
+        }
+
+        BOOST_FAIL ("Unable to connect to server!");
+        return *connection;
+    }
+
+    Miami::App::Server::ResultCode result = Miami::App::Server::ResultCode::OK;
+    std::unique_ptr <Miami::App::Server::Context> server;
+    std::thread thread;
+    std::unique_ptr <Connection> connection;
+};
+
+static uint16_t nextPort = 27730u;
+
+BOOST_AUTO_TEST_CASE (ReplicaBehindTrimmedLogNeedsResync)
+{
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    const uint16_t primaryPort = nextPort++;
+    const uint16_t replicaPort = nextPort++;
+
+    // Every record exceeds one byte limit, so primary trims all records right after they are logged.
+    RunningServer primary (std::make_unique <Miami::App::Server::Context> (TEST_WORKERS_COUNT, true, 1u),
+                           primaryPort);
+    Connection &primaryConnection = primary.Connect (&context, primaryPort);
+
+    ConduitVoidActionRequest conduitRequest {};
+    BOOST_REQUIRE (primaryConnection.Execute (
+        Message::GET_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest, "get conduit write access"));
+
+    for (const char *name : {"First", "Second"})
+    {
+        AddTableRequest addTable {};
+        addTable.tableName_ = name;
+        BOOST_REQUIRE (primaryConnection.Execute (Message::ADD_TABLE_REQUEST, addTable, "add table"));
+    }
+
+    BOOST_REQUIRE (primaryConnection.Execute (
+        Message::CLOSE_CONDUIT_WRITE_ACCESS_REQUEST, conduitRequest, "close conduit write access"));
+
+    Response status;
+    BOOST_REQUIRE (primaryConnection.Execute (
+        Message::REPLICATION_STATUS_REQUEST, conduitRequest, "get replication status", status));
+    BOOST_REQUIRE_EQUAL (status.replicationStatus_.lastSequence_, 2u);
+
+    auto replicaContext = std::make_unique <Miami::App::Server::Context> (TEST_WORKERS_COUNT);
+    BOOST_REQUIRE (replicaContext->FollowPrimary ("127.0.0.1", std::to_string (primaryPort)) ==
+                   Miami::App::Server::ResultCode::OK);
+
+    RunningServer replica (std::move (replicaContext), replicaPort);
+    Connection &replicaConnection = replica.Connect (&context, replicaPort);
+
+    for (std::size_t attempt = 0u; attempt < 250u && !status.replicationStatus_.resyncNeeded_; ++attempt)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (20));
+        BOOST_REQUIRE (replicaConnection.Execute (
+            Message::REPLICATION_STATUS_REQUEST, conduitRequest, "get replication status", status));
+    }
+
+    BOOST_CHECK (status.replicationStatus_.isReplica_);
+    BOOST_CHECK (status.replicationStatus_.resyncNeeded_);
+    BOOST_CHECK_EQUAL (status.replicationStatus_.appliedSequence_, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
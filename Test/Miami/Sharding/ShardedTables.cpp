@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <App/Miami/Server/Context.hpp>
+#include <App/Miami/Sharding/ShardedClient.hpp>
+
+BOOST_AUTO_TEST_SUITE (ShardedTables)
+
+using namespace Miami::App::Sharding;
+using Miami::Richard::AnyDataContainer;
+using Miami::Richard::AnyDataId;
+using Miami::Richard::DataType;
+using Miami::Richard::QueryBatch;
+
+#define TEST_WORKERS_COUNT 2
+
+static AnyDataContainer MakeInt64 (int64_t value)
+{
+    AnyDataContainer container (DataType::INT64);
+    *static_cast <int64_t *> (container.GetDataStartPointer ()) = value;
+    return container;
+}
+
+static int64_t ReadInt64 (const QueryBatch &batch, std::size_t row, std::size_t column)
+{
+    const std::size_t index = row * batch.columnsCount_ + column;
+    BOOST_REQUIRE (!batch.nulls_[index]);
+    BOOST_REQUIRE (batch.values_[index].GetType () == DataType::INT64);
+    return *static_cast <const int64_t *> (batch.values_[index].GetDataStartPointer ());
+}
+
+static QueryBatch MakeRows (const std::vector <std::pair <int64_t, int64_t>> &rows)
+{
+    QueryBatch batch;
+    batch.columnsCount_ = 2u;
+
+    for (const auto &row : rows)
+    {
+        batch.values_.emplace_back (MakeInt64 (row.first));
+        batch.values_.emplace_back (MakeInt64 (row.second));
+        batch.nulls_.insert (batch.nulls_.end (), {0u, 0u});
+    }
+
+    return batch;
+}
+
+static Miami::App::Messaging::ExecuteQueryRequest MakeScan (const std::vector <AnyDataId> &projection)
+{
+    Miami::App::Messaging::ExecuteQueryRequest query {};
+    query.projection_ = projection;
+    query.limit_ = std::numeric_limits <uint64_t>::max ();
+    return query;
+}
+
+static ShardedTableInfo MakeKeyedTable (ShardingType type, const std::vector <int64_t> &bounds = {})
+{
+    ShardedTableInfo info;
+    info.type_ = type;
+    info.keyColumn_ = {0, DataType::INT64, "key"};
+
+    for (int64_t bound : bounds)
+    {
+        info.rangeBounds_.emplace_back (MakeInt64 (bound));
+    }
+
+    return info;
+}
+
+/// Starts servers on localhost inside test process. Every cluster uses its own ports, so clusters of different
+/// test cases never share servers.
+class ShardedClusterCheckCommons
+{
+public:
+    explicit ShardedClusterCheckCommons (std::size_t serversCount)
+    {
+        // Boost checks are not thread safe, therefore server results are checked after join.
+        results.resize (serversCount, Miami::App::Server::ResultCode::OK);
+        for (std::size_t index = 0u; index < serversCount; ++index)
+        {
+            const uint16_t port = nextPort++;
+            servers.emplace_back (std::make_unique <Miami::App::Server::Context> (TEST_WORKERS_COUNT));
+            ports.emplace_back (port);
+
+            Miami::App::Server::Context *server = servers.back ().get ();
+            Miami::App::Server::ResultCode *result = &results[index];
+            threads.emplace_back (
+                [server, port, result] ()
+                {
+                    *result = server->Execute (port);
+                });
+        }
+    }
+
+    ~ShardedClusterCheckCommons ()
+    {
+        // Clients close their connections first, so servers could be stopped without waiting for them.
+        clients.clear ();
+        for (std::size_t index = 0u; index < servers.size (); ++index)
+        {
+            servers[index]->RequestAbort ();
+            threads[index].join ();
+            BOOST_CHECK (results[index] == Miami::App::Server::ResultCode::OK);
+        }
+    }
+
+    ShardMap MakeMap () const
+    {
+        ShardMap map;
+        for (uint16_t port : ports)
+        {
+            map.AddShard ("127.0.0.1", std::to_string (port));
+        }
+
+        return map;
+    }
+
+    /// Servers are started asynchronously, so connection is retried until they listen.
+    ShardedClient &Connect (ShardMap map)
+    {
+        clients.emplace_back (std::make_unique <ShardedClient> (&context, map));
+        for (std::size_t attempt = 0u; attempt < 100u; ++attempt)
+        {
+            if (clients.back ()->Connect () == ResultCode::OK)
+            {
+                return *clients.back ();
+            }
+
+            std::this_thread::sleep_for (std::chrono::milliseconds (20));
+        }
+
+        BOOST_FAIL ("Unable to connect to sharded cluster!");
+        return *clients.back ();
+    }
+
+    static uint16_t nextPort;
+
+    Miami::Disco::Context context {TEST_WORKERS_COUNT};
+    std::vector <std::unique_ptr <Miami::App::Server::Context>> servers;
+    std::vector <uint16_t> ports;
+    std::vector <std::thread> threads;
+    std::vector <Miami::App::Server::ResultCode> results;
+    std::vector <std::unique_ptr <ShardedClient>> clients;
+};
+
+uint16_t ShardedClusterCheckCommons::nextPort = 27430u;
+
+BOOST_AUTO_TEST_CASE (HashShardedRowsAreMergedInOrder)
+{
+    ShardedClusterCheckCommons cluster (3u);
+    ShardMap map = cluster.MakeMap ();
+    ShardedTableInfo info = MakeKeyedTable (ShardingType::HASH);
+    BOOST_REQUIRE (map.AddTable ("Hashed", info) == ResultCode::OK);
+
+    ShardedClient &client = cluster.Connect (std::move (map));
+    std::vector <AnyDataId> columns;
+    AnyDataId keyColumn;
+
+    BOOST_REQUIRE (client.CreateTable ("Hashed", {{0, DataType::INT64, "value"}}, columns) == ResultCode::OK);
+    BOOST_REQUIRE (client.GetKeyColumnId ("Hashed", keyColumn) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (columns.size (), 1u);
+
+    std::vector <std::pair <int64_t, int64_t>> rows;
+    std::vector <std::size_t> rowsPerShard (3u, 0u);
+
+    for (int64_t key = 0; key < 3000; ++key)
+    {
+        rows.emplace_back (key, key * 2);
+        AnyDataContainer value = MakeInt64 (key);
+        std::size_t shard;
+
+        BOOST_REQUIRE (client.GetShardMap ().FindShard ("Hashed", &value, shard) == ResultCode::OK);
+        ++rowsPerShard[shard];
+    }
+
+    for (std::size_t count : rowsPerShard)
+    {
+        BOOST_CHECK (count > 0u);
+    }
+
+    std::shuffle (rows.begin (), rows.end (), std::mt19937 (42u));
+    QueryBatch batch = MakeRows (rows);
+    BOOST_REQUIRE (client.InsertRows ("Hashed", {keyColumn, columns[0]}, batch) == ResultCode::OK);
+
+    auto query = MakeScan ({keyColumn, columns[0]});
+    query.order_.push_back ({0u, false});
+    query.offset_ = 1000u;
+    query.limit_ = 1500u;
+
+    QueryBatch output;
+    BOOST_REQUIRE (client.Scan ("Hashed", query, output) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (output.GetRowsCount (), 1500u);
+
+    for (std::size_t row = 0u; row < output.GetRowsCount (); ++row)
+    {
+        BOOST_CHECK_EQUAL (ReadInt64 (output, row, 0u), static_cast <int64_t> (row) + 1000);
+        BOOST_CHECK_EQUAL (ReadInt64 (output, row, 1u), (static_cast <int64_t> (row) + 1000) * 2);
+    }
+
+    // Unsorted outputs are concatenated, so only set of rows is checked.
+    query = MakeScan ({keyColumn});
+    BOOST_REQUIRE (client.Scan ("Hashed", query, output) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (output.GetRowsCount (), 3000u);
+
+    std::vector <int64_t> keys;
+    for (std::size_t row = 0u; row < output.GetRowsCount (); ++row)
+    {
+        keys.emplace_back (ReadInt64 (output, row, 0u));
+    }
+
+    std::sort (keys.begin (), keys.end ());
+    for (std::size_t index = 0u; index < keys.size (); ++index)
+    {
+        BOOST_CHECK_EQUAL (keys[index], static_cast <int64_t> (index));
+    }
+
+    query = MakeScan ({});
+    query.groupColumns_.push_back (keyColumn);
+    BOOST_CHECK (client.Scan ("Hashed", query, output) == ResultCode::SHARDED_AGGREGATION_IS_NOT_SUPPORTED);
+}
+
+BOOST_AUTO_TEST_CASE (TablesAreOpenedByAnotherClient)
+{
+    ShardedClusterCheckCommons cluster (2u);
+    ShardMap map = cluster.MakeMap ();
+    ShardedTableInfo rangeInfo = MakeKeyedTable (ShardingType::RANGE, {100});
+    ShardedTableInfo singleInfo;
+    singleInfo.shard_ = 1u;
+
+    BOOST_REQUIRE (map.AddTable ("Ranged", rangeInfo) == ResultCode::OK);
+    BOOST_REQUIRE (map.AddTable ("Single", singleInfo) == ResultCode::OK);
+
+    ShardedClient &writer = cluster.Connect (std::move (map));
+    std::vector <AnyDataId> rangeColumns;
+    std::vector <AnyDataId> singleColumns;
+    AnyDataId keyColumn;
+
+    BOOST_REQUIRE (writer.CreateTable ("Ranged", {{0, DataType::INT64, "value"}}, rangeColumns) == ResultCode::OK);
+    BOOST_REQUIRE (writer.GetKeyColumnId ("Ranged", keyColumn) == ResultCode::OK);
+    BOOST_REQUIRE (writer.CreateTable ("Single", {{0, DataType::INT64, "a"}, {0, DataType::INT64, "b"}},
+                                       singleColumns) == ResultCode::OK);
+    BOOST_CHECK (writer.GetKeyColumnId ("Single", keyColumn) == ResultCode::TABLE_HAS_NO_SHARD_KEY);
+
+    QueryBatch batch = MakeRows ({{250, 1}, {5, 2}, {100, 3}, {99, 4}, {150, 5}});
+    BOOST_REQUIRE (writer.InsertRows ("Ranged", {keyColumn, rangeColumns[0]}, batch) == ResultCode::OK);
+
+    batch = MakeRows ({{1, 10}, {2, 20}});
+    BOOST_REQUIRE (writer.InsertRows ("Single", singleColumns, batch) == ResultCode::OK);
+
+    batch.columnsCount_ = 1u;
+    batch.values_.clear ();
+    batch.values_.emplace_back (DataType::INT32);
+    batch.nulls_ = {0u};
+    BOOST_CHECK (writer.InsertRows ("Ranged", {keyColumn}, batch) == ResultCode::SHARD_KEY_VALUE_TYPE_MISMATCH);
+
+    ShardMap readerMap = cluster.MakeMap ();
+    rangeInfo = MakeKeyedTable (ShardingType::RANGE, {100});
+    singleInfo.shard_ = 1u;
+    BOOST_REQUIRE (readerMap.AddTable ("Ranged", rangeInfo) == ResultCode::OK);
+    BOOST_REQUIRE (readerMap.AddTable ("Single", singleInfo) == ResultCode::OK);
+
+    ShardedClient &reader = cluster.Connect (std::move (readerMap));
+    std::vector <Miami::Richard::ColumnInfo> openedColumns;
+    auto query = MakeScan ({keyColumn, rangeColumns[0]});
+    QueryBatch output;
+
+    BOOST_CHECK (reader.Scan ("Ranged", query, output) == ResultCode::TABLE_IS_NOT_OPENED);
+    BOOST_REQUIRE (reader.OpenTable ("Ranged", openedColumns) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (openedColumns.size (), 2u);
+
+    AnyDataId openedKeyColumn;
+    BOOST_REQUIRE (reader.GetKeyColumnId ("Ranged", openedKeyColumn) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (openedKeyColumn, keyColumn);
+
+    query.order_.push_back ({0u, true});
+    query.limit_ = 4u;
+
+    BOOST_REQUIRE (reader.Scan ("Ranged", query, output) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (output.GetRowsCount (), 4u);
+
+    const std::vector <int64_t> expectedKeys {250, 150, 100, 99};
+    for (std::size_t row = 0u; row < expectedKeys.size (); ++row)
+    {
+        BOOST_CHECK_EQUAL (ReadInt64 (output, row, 0u), expectedKeys[row]);
+    }
+
+    BOOST_REQUIRE (reader.OpenTable ("Single", openedColumns) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (openedColumns.size (), 2u);
+    BOOST_CHECK_EQUAL (openedColumns[1].name_, "b");
+
+    query = MakeScan (singleColumns);
+    BOOST_REQUIRE (reader.Scan ("Single", query, output) == ResultCode::OK);
+    BOOST_REQUIRE_EQUAL (output.GetRowsCount (), 2u);
+    BOOST_CHECK_EQUAL (ReadInt64 (output, 1u, 1u), 20);
+}
+
+BOOST_AUTO_TEST_CASE (MalformedShardMap)
+{
+    ShardMap map;
+    ShardedTableInfo info;
+    BOOST_CHECK (map.AddTable ("Empty", info) == ResultCode::SHARD_WITH_GIVEN_INDEX_NOT_FOUND);
+
+    map.AddShard ("127.0.0.1", "1");
+    map.AddShard ("127.0.0.1", "2");
+    map.AddShard ("127.0.0.1", "3");
+
+    info.shard_ = 3u;
+    BOOST_CHECK (map.AddTable ("Single", info) == ResultCode::SHARD_WITH_GIVEN_INDEX_NOT_FOUND);
+
+    info = MakeKeyedTable (ShardingType::RANGE, {10});
+    BOOST_CHECK (map.AddTable ("Range", info) == ResultCode::SHARD_RANGE_BOUNDS_COUNT_MISMATCH);
+
+    info = MakeKeyedTable (ShardingType::RANGE, {10, 10});
+    BOOST_CHECK (map.AddTable ("Range", info) == ResultCode::SHARD_RANGE_BOUNDS_MUST_BE_ASCENDING);
+
+    info = MakeKeyedTable (ShardingType::RANGE, {10, 20});
+    info.keyColumn_.dataType_ = DataType::INT32;
+    BOOST_CHECK (map.AddTable ("Range", info) == ResultCode::SHARD_RANGE_BOUND_TYPE_MISMATCH);
+
+    info = MakeKeyedTable (ShardingType::RANGE, {10, 20});
+    BOOST_REQUIRE (map.AddTable ("Range", info) == ResultCode::OK);
+
+    info = MakeKeyedTable (ShardingType::HASH);
+    BOOST_CHECK (map.AddTable ("Range", info) == ResultCode::TABLE_IS_ALREADY_IN_SHARD_MAP);
+
+    std::size_t shard;
+    AnyDataContainer key = MakeInt64 (20);
+    BOOST_REQUIRE (map.FindShard ("Range", &key, shard) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (shard, 2u);
+    BOOST_REQUIRE (map.FindShard ("Range", nullptr, shard) == ResultCode::OK);
+    BOOST_CHECK_EQUAL (shard, 0u);
+    BOOST_CHECK (map.FindShard ("Unknown", &key, shard) == ResultCode::TABLE_IS_NOT_IN_SHARD_MAP);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,3 @@
+#define BOOST_TEST_MODULE Sharding Tests
+
+#include <boost/test/unit_test.hpp>
\ No newline at end of file